@@ -164,6 +164,14 @@ def main():
         help="Protobuf branch to be used for the Windows build",
         action="store",
         default='v3.18.1')
+
+    parser.add_argument(
+        '--max_vlog_level',
+        help="Highest OPENVINO_TF_VLOG_LEVEL compiled in, the logs above it "
+        "are compiled out. Use 0 or 1 for builds where logging must cost "
+        "nothing",
+        action="store",
+        default='5')
     # Done with the options. Now parse the commandline
     arguments = parser.parse_args()
 
@@ -640,6 +648,9 @@ def main():
         openvino_tf_cmake_flags.extend(
             ["-DTensorFlow_VERSION=" + tf_version.replace("v", "")])
 
+    openvino_tf_cmake_flags.extend(
+        ["-DOPENVINO_TF_MAX_VLOG_LEVEL=" + str(arguments.max_vlog_level)])
+
     # add openvino build version as compile time definition
     openvino_tf_cmake_flags.extend(
         ["-DOPENVINO_BUILD_VERSION=%s" % str(arguments.openvino_version)])
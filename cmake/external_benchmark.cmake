@@ -0,0 +1,65 @@
+# ******************************************************************************
+# Copyright (C) 2021-2022 Intel Corporation
+ 
+# SPDX-License-Identifier: Apache-2.0
+# ******************************************************************************
+
+# Enable ExternalProject CMake module
+include(ExternalProject)
+
+#------------------------------------------------------------------------------
+# Download and build Google Benchmark ...
+#------------------------------------------------------------------------------
+
+SET(BENCHMARK_GIT_REPO_URL https://github.com/google/benchmark.git)
+SET(BENCHMARK_GIT_LABEL v1.6.1)
+
+set(BENCHMARK_OUTPUT_DIR ${EXTERNAL_PROJECTS_ROOT}/benchmark/build/src)
+
+if(CMAKE_BUILD_TYPE)
+    list(APPEND BENCHMARK_CMAKE_ARGS
+        -DCMAKE_BUILD_TYPE=${CMAKE_BUILD_TYPE}
+    )
+endif()
+
+if(UNIX)
+    set(BENCHMARK_CXX_FLAGS "${CMAKE_ORIGINAL_CXX_FLAGS} -D_GLIBCXX_USE_CXX11_ABI=${OPENVINO_TF_CXX11_ABI}")
+else()
+    set(BENCHMARK_CXX_FLAGS ${CMAKE_ORIGINAL_CXX_FLAGS})
+endif()
+
+SET(BENCHMARK_PATHS
+    ${BENCHMARK_OUTPUT_DIR}/${CMAKE_STATIC_LIBRARY_PREFIX}benchmark${CMAKE_STATIC_LIBRARY_SUFFIX})
+
+ExternalProject_Add(
+    ext_benchmark
+    PREFIX benchmark
+    GIT_REPOSITORY ${BENCHMARK_GIT_REPO_URL}
+    GIT_TAG ${BENCHMARK_GIT_LABEL}
+    # Disable install step
+    INSTALL_COMMAND ""
+    UPDATE_COMMAND ""
+    CMAKE_GENERATOR ${CMAKE_GENERATOR}
+    CMAKE_GENERATOR_PLATFORM ${CMAKE_GENERATOR_PLATFORM}
+    CMAKE_GENERATOR_TOOLSET ${CMAKE_GENERATOR_TOOLSET}
+    CMAKE_ARGS
+        ${NGRAPH_FORWARD_CMAKE_ARGS}
+        -DCMAKE_CXX_FLAGS=${BENCHMARK_CXX_FLAGS}
+        -DBENCHMARK_ENABLE_TESTING=OFF
+        -DBENCHMARK_ENABLE_GTEST_TESTS=OFF
+        -DBENCHMARK_ENABLE_INSTALL=OFF
+        ${BENCHMARK_CMAKE_ARGS}
+    BINARY_DIR "${EXTERNAL_PROJECTS_ROOT}/benchmark/build"
+    EXCLUDE_FROM_ALL TRUE
+    BUILD_BYPRODUCTS ${BENCHMARK_PATHS}
+    )
+
+#------------------------------------------------------------------------------
+
+ExternalProject_Get_Property(ext_benchmark SOURCE_DIR)
+
+add_library(libbenchmark INTERFACE)
+add_dependencies(libbenchmark ext_benchmark)
+target_include_directories(libbenchmark SYSTEM INTERFACE
+    ${SOURCE_DIR}/include)
+target_link_libraries(libbenchmark INTERFACE ${BENCHMARK_PATHS})
@@ -0,0 +1,294 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+// A load generator measuring the throughput and latency of a frozen model,
+// on native TensorFlow and on the OpenVINO backends.
+//
+// The main thread produces numbered requests into a bounded ThreadSafeQueue,
+// and concurrency worker threads run them on a session they all share.
+// Every backend is benchmarked in turn with a new session: first the
+// warmup requests, which include the compilation, then the timed ones until
+// the duration elapsed. The throughput and the latency percentiles of every
+// backend are reported at the end.
+//
+// The input is the image given with --image resized to the input size, or
+// random values, repeated batch_size times.
+
+// Added this macro as getting compilation error with LOG(ERROR) usage
+#define NOGDI
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/init_main.h"
+#include "tensorflow/core/public/session.h"
+#include "tensorflow/core/util/command_line_flags.h"
+
+#include "openvino_tensorflow/api.h"
+#include "thread_safe_queue.h"
+
+using namespace std;
+using tensorflow::Flag;
+using tensorflow::Status;
+using tensorflow::Tensor;
+using Clock = std::chrono::steady_clock;
+
+extern tensorflow::Status LoadGraph(
+    const string& graph_file_name,
+    std::unique_ptr<tensorflow::Session>* session);
+
+extern tensorflow::Status ReadTensorFromImageFile(
+    const string& file_name, const int input_height, const int input_width,
+    const float input_mean, const float input_std,
+    std::vector<tensorflow::Tensor>* out_tensors);
+
+struct BenchmarkConfig {
+  string graph;
+  string input_layer;
+  string output_layer;
+  int concurrency;
+  int warmup;
+  double duration_s;
+};
+
+struct BenchmarkResult {
+  string backend;
+  int64_t requests = 0;
+  double seconds = 0;
+  // The latencies of the requests in ms, sorted
+  vector<double> latencies_ms;
+};
+
+// Repeats the single image of image batch_size times
+static Tensor MakeBatch(const Tensor& image, int batch_size) {
+  tensorflow::TensorShape shape = image.shape();
+  shape.set_dim(0, batch_size);
+  Tensor batch(image.dtype(), shape);
+  const size_t bytes = image.TotalBytes();
+  char* dst = const_cast<char*>(batch.tensor_data().data());
+  for (int i = 0; i < batch_size; i++) {
+    std::memcpy(dst + i * bytes, image.tensor_data().data(), bytes);
+  }
+  return batch;
+}
+
+static Status RunBackend(const string& backend, const BenchmarkConfig& config,
+                         const Tensor& input, BenchmarkResult* result) {
+  result->backend = backend;
+  if (backend == "TF") {
+    tensorflow::openvino_tensorflow::api::disable();
+  } else {
+    tensorflow::openvino_tensorflow::api::enable();
+    tensorflow::openvino_tensorflow::api::SetBackend(backend);
+  }
+
+  // The graph is rewritten for the backend on the first run of a new
+  // session
+  std::unique_ptr<tensorflow::Session> session;
+  TF_RETURN_IF_ERROR(LoadGraph(config.graph, &session));
+  auto run = [&]() {
+    std::vector<Tensor> outputs;
+    return session->Run({{config.input_layer, input}}, {config.output_layer},
+                        {}, &outputs);
+  };
+
+  benchmark::ThreadSafeQueue<int64_t> queue(2 * config.concurrency);
+  std::atomic<bool> stop{false};
+  std::mutex mutex;
+  std::condition_variable warmup_done;
+  Status status;
+  int64_t num_done = 0;
+  vector<double> latencies_ms;
+
+  auto worker = [&]() {
+    int64_t request;
+    while (queue.GetNextAvailable(&request)) {
+      auto start = Clock::now();
+      Status run_status = run();
+      auto end = Clock::now();
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!run_status.ok()) {
+        if (status.ok()) status = run_status;
+        stop = true;
+      } else if (request >= config.warmup) {
+        // The warmup requests are not timed
+        latencies_ms.push_back(
+            std::chrono::duration<double, std::milli>(end - start).count());
+      }
+      if (++num_done >= config.warmup) warmup_done.notify_all();
+    }
+  };
+
+  // The first request compiles the clusters, the other warmup requests
+  // run concurrently with it
+  cout << "[" << backend << "] Warming up with " << config.warmup
+       << " requests" << endl;
+  vector<std::thread> workers;
+  for (int i = 0; i < config.concurrency; i++) {
+    workers.emplace_back(worker);
+  }
+  int64_t id = 0;
+  for (; id < config.warmup && !stop; id++) {
+    queue.Add(id);
+  }
+  {
+    // The timing starts once the warmup requests are done
+    std::unique_lock<std::mutex> lock(mutex);
+    warmup_done.wait(lock,
+                     [&]() { return stop || num_done >= config.warmup; });
+  }
+
+  cout << "[" << backend << "] Running for " << config.duration_s
+       << " s with " << config.concurrency << " concurrent requests" << endl;
+  auto timed_start = Clock::now();
+  auto deadline =
+      timed_start + std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double>(config.duration_s));
+  while (!stop && Clock::now() < deadline) {
+    if (!queue.Add(id++)) break;
+  }
+  queue.Terminate();
+  for (auto& thread : workers) {
+    thread.join();
+  }
+  auto timed_end = Clock::now();
+  TF_RETURN_IF_ERROR(status);
+
+  result->seconds =
+      std::chrono::duration<double>(timed_end - timed_start).count();
+  result->latencies_ms = std::move(latencies_ms);
+  result->requests = result->latencies_ms.size();
+  std::sort(result->latencies_ms.begin(), result->latencies_ms.end());
+  return Status::OK();
+}
+
+static double Percentile(const vector<double>& sorted, double q) {
+  if (sorted.empty()) return 0;
+  size_t index = std::min(sorted.size() - 1,
+                          static_cast<size_t>(q * (sorted.size() - 1) + 0.5));
+  return sorted[index];
+}
+
+static void PrintResults(const vector<BenchmarkResult>& results,
+                         int batch_size) {
+  cout << endl
+       << std::left << std::setw(10) << "Backend" << std::right
+       << std::setw(10) << "Requests" << std::setw(14) << "Throughput"
+       << std::setw(10) << "p50 ms" << std::setw(10) << "p90 ms"
+       << std::setw(10) << "p99 ms" << std::setw(10) << "max ms" << endl;
+  for (const auto& result : results) {
+    double fps =
+        result.seconds > 0 ? result.requests * batch_size / result.seconds : 0;
+    cout << std::left << std::setw(10) << result.backend << std::right
+         << std::setw(10) << result.requests << std::fixed
+         << std::setprecision(2) << std::setw(10) << fps << " FPS"
+         << std::setw(10) << Percentile(result.latencies_ms, 0.5)
+         << std::setw(10) << Percentile(result.latencies_ms, 0.9)
+         << std::setw(10) << Percentile(result.latencies_ms, 0.99)
+         << std::setw(10) << Percentile(result.latencies_ms, 1.0) << endl;
+  }
+}
+
+int main(int argc, char** argv) {
+  string image_file = "";
+  string graph = "examples/data/inception_v3_2016_08_28_frozen.pb";
+  int input_width = 299;
+  int input_height = 299;
+  float input_mean = 0;
+  float input_std = 255;
+  string input_layer = "input";
+  string output_layer = "InceptionV3/Predictions/Reshape_1";
+  string backends = "TF,CPU";
+  int batch_size = 1;
+  int concurrency = 1;
+  int warmup = 0;
+  float duration = 10;
+
+  std::vector<tensorflow::Flag> flag_list = {
+      Flag("graph", &graph, "graph to be executed"),
+      Flag("image", &image_file,
+           "image fed to the graph, random values if empty"),
+      Flag("input_width", &input_width, "resize image to this width in pixels"),
+      Flag("input_height", &input_height,
+           "resize image to this height in pixels"),
+      Flag("input_mean", &input_mean, "scale pixel values to this mean"),
+      Flag("input_std", &input_std, "scale pixel values to this std deviation"),
+      Flag("input_layer", &input_layer, "name of input layer"),
+      Flag("output_layer", &output_layer, "name of output layer"),
+      Flag("backends", &backends,
+           "comma separated backends to benchmark, TF for native TensorFlow. "
+           "Default is TF,CPU"),
+      Flag("batch_size", &batch_size, "batch size of every request"),
+      Flag("concurrency", &concurrency, "number of concurrent requests"),
+      Flag("warmup", &warmup,
+           "untimed requests run first, default is the concurrency"),
+      Flag("duration", &duration, "seconds the requests are timed for")};
+
+  string usage = tensorflow::Flags::Usage(argv[0], flag_list);
+  const bool parse_result = tensorflow::Flags::Parse(&argc, argv, flag_list);
+  if (!parse_result || batch_size < 1 || concurrency < 1 || duration <= 0) {
+    std::cout << usage;
+    return -1;
+  }
+
+  // We need to call this to set up global state for TensorFlow.
+  tensorflow::port::InitMain(argv[0], &argc, &argv);
+  if (argc > 1) {
+    std::cout << "Error: Unknown argument " << argv[1] << "\n" << usage;
+    return -1;
+  }
+
+  Tensor image;
+  if (!image_file.empty()) {
+    std::vector<Tensor> resized_tensors;
+    Status read_tensor_status =
+        ReadTensorFromImageFile(image_file, input_height, input_width,
+                                input_mean, input_std, &resized_tensors);
+    if (!read_tensor_status.ok()) {
+      LOG(ERROR) << read_tensor_status;
+      return -1;
+    }
+    image = resized_tensors[0];
+  } else {
+    image = Tensor(tensorflow::DT_FLOAT,
+                   tensorflow::TensorShape({1, input_height, input_width, 3}));
+    image.flat<float>().setRandom();
+  }
+  Tensor input = MakeBatch(image, batch_size);
+
+  BenchmarkConfig config;
+  config.graph = graph;
+  config.input_layer = input_layer;
+  config.output_layer = output_layer;
+  config.concurrency = concurrency;
+  config.warmup = warmup > 0 ? warmup : concurrency;
+  config.duration_s = duration;
+
+  vector<BenchmarkResult> results;
+  for (const string& backend : tensorflow::str_util::Split(
+           backends, ',', tensorflow::str_util::SkipEmpty())) {
+    BenchmarkResult result;
+    Status status = RunBackend(backend, config, input, &result);
+    if (!status.ok()) {
+      LOG(ERROR) << "Benchmarking " << backend << " failed: " << status;
+      return -1;
+    }
+    results.push_back(std::move(result));
+  }
+  PrintResults(results, batch_size);
+  return 0;
+}
@@ -0,0 +1,453 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+// A pipelined object detection sample, the reference architecture of a
+// camera ingest service running a frozen detection model on OpenVINO.
+//
+// Every frame goes through four stages connected by bounded queues:
+//  1. decode:      reads an image file and decodes it to uint8 pixels
+//  2. preprocess:  resizes and normalizes the pixels into the model input
+//  3. infer:       runs the model in a session shared by the workers
+//  4. postprocess: filters the boxes by score and suppresses overlapping
+//                  boxes of a class (non maximum suppression)
+// Each stage runs on threads of its own, so several frames are in flight,
+// and a full queue holds the stages before it back. The frames are the
+// images given with --input, a file or a directory, repeated until --frames
+// frames were processed. The end to end throughput and the latency of every
+// stage are reported at the end.
+//
+// The model reads a batch of one NHWC float image and outputs its boxes as
+// [1, N, 4] (y1, x1, y2, x2) and their scores as [1, N, classes].
+
+// Added this macro as getting compilation error with LOG(ERROR) usage
+#define NOGDI
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "absl/strings/match.h"
+#include "tensorflow/cc/ops/const_op.h"
+#include "tensorflow/cc/ops/image_ops.h"
+#include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/init_main.h"
+#include "tensorflow/core/public/session.h"
+#include "tensorflow/core/util/command_line_flags.h"
+
+#include "openvino_tensorflow/api.h"
+#include "thread_safe_queue.h"
+
+using namespace std;
+using tensorflow::Flag;
+using tensorflow::Status;
+using tensorflow::Tensor;
+using Clock = std::chrono::steady_clock;
+
+extern tensorflow::Status LoadGraph(
+    const string& graph_file_name,
+    std::unique_ptr<tensorflow::Session>* session);
+
+enum Stage { DECODE = 0, PREPROCESS, INFER, POSTPROCESS, NUM_STAGES };
+static const char* kStageNames[NUM_STAGES] = {"decode", "preprocess", "infer",
+                                              "postprocess"};
+
+struct Frame {
+  int64_t id;
+  string file;
+  Tensor image;
+  Tensor input;
+  std::vector<Tensor> outputs;
+  int detections = 0;
+  Clock::time_point start;
+  std::array<double, NUM_STAGES> stage_ms;
+};
+
+using FrameQueue = benchmark::ThreadSafeQueue<std::unique_ptr<Frame>>;
+
+struct Box {
+  float y1, x1, y2, x2;
+  float score;
+  int label;
+};
+
+static float IoU(const Box& a, const Box& b) {
+  float h = std::min(a.y2, b.y2) - std::max(a.y1, b.y1);
+  float w = std::min(a.x2, b.x2) - std::max(a.x1, b.x1);
+  if (h <= 0 || w <= 0) return 0;
+  float intersection = h * w;
+  float area_a = (a.y2 - a.y1) * (a.x2 - a.x1);
+  float area_b = (b.y2 - b.y1) * (b.x2 - b.x1);
+  return intersection / (area_a + area_b - intersection);
+}
+
+// Greedy non maximum suppression of the boxes of every class above
+// conf_threshold
+static std::vector<Box> SuppressBoxes(const Tensor& boxes,
+                                      const Tensor& scores,
+                                      float conf_threshold,
+                                      float iou_threshold) {
+  const int64_t num_boxes = boxes.dim_size(1);
+  const int64_t num_classes = scores.dim_size(2);
+  auto box_values = boxes.flat<float>();
+  auto score_values = scores.flat<float>();
+  std::vector<Box> candidates;
+  for (int64_t i = 0; i < num_boxes; i++) {
+    for (int64_t c = 0; c < num_classes; c++) {
+      float score = score_values(i * num_classes + c);
+      if (score < conf_threshold) continue;
+      candidates.push_back({box_values(i * 4), box_values(i * 4 + 1),
+                            box_values(i * 4 + 2), box_values(i * 4 + 3),
+                            score, static_cast<int>(c)});
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Box& a, const Box& b) { return a.score > b.score; });
+  std::vector<Box> selected;
+  for (const auto& candidate : candidates) {
+    bool suppressed = false;
+    for (const auto& box : selected) {
+      if (box.label == candidate.label &&
+          IoU(box, candidate) > iou_threshold) {
+        suppressed = true;
+        break;
+      }
+    }
+    if (!suppressed) selected.push_back(candidate);
+  }
+  return selected;
+}
+
+// The sessions of the decode and preprocess stages, small TF graphs of their
+// own
+static Status BuildDecodeSession(
+    std::unique_ptr<tensorflow::Session>* session) {
+  auto root = tensorflow::Scope::NewRootScope();
+  using namespace ::tensorflow::ops;  // NOLINT(build/namespaces)
+  auto encoded = Placeholder(root.WithOpName("encoded"), tensorflow::DT_STRING);
+  DecodeJpeg(root.WithOpName("jpeg"), encoded, DecodeJpeg::Channels(3));
+  DecodePng(root.WithOpName("png"), encoded, DecodePng::Channels(3));
+  tensorflow::GraphDef graph;
+  TF_RETURN_IF_ERROR(root.ToGraphDef(&graph));
+  session->reset(tensorflow::NewSession(tensorflow::SessionOptions()));
+  return (*session)->Create(graph);
+}
+
+static Status BuildPreprocessSession(
+    int input_height, int input_width, float input_mean, float input_std,
+    std::unique_ptr<tensorflow::Session>* session) {
+  auto root = tensorflow::Scope::NewRootScope();
+  using namespace ::tensorflow::ops;  // NOLINT(build/namespaces)
+  auto image = Placeholder(root.WithOpName("image"), tensorflow::DT_UINT8);
+  auto batch = ExpandDims(root, Cast(root, image, tensorflow::DT_FLOAT), 0);
+  auto resized =
+      ResizeBilinear(root, batch, Const(root, {input_height, input_width}));
+  Div(root.WithOpName("input"), Sub(root, resized, {input_mean}),
+      {input_std});
+  tensorflow::GraphDef graph;
+  TF_RETURN_IF_ERROR(root.ToGraphDef(&graph));
+  session->reset(tensorflow::NewSession(tensorflow::SessionOptions()));
+  return (*session)->Create(graph);
+}
+
+// The images of input, a file or a directory
+static Status ListImages(const string& input, std::vector<string>* files) {
+  tensorflow::Env* env = tensorflow::Env::Default();
+  if (!env->IsDirectory(input).ok()) {
+    files->push_back(input);
+    return Status::OK();
+  }
+  std::vector<string> children;
+  TF_RETURN_IF_ERROR(env->GetChildren(input, &children));
+  std::sort(children.begin(), children.end());
+  for (const auto& child : children) {
+    if (absl::EndsWith(child, ".jpg") || absl::EndsWith(child, ".jpeg") ||
+        absl::EndsWith(child, ".png")) {
+      files->push_back(tensorflow::io::JoinPath(input, child));
+    }
+  }
+  if (files->empty()) {
+    return tensorflow::errors::NotFound("No image found in ", input);
+  }
+  return Status::OK();
+}
+
+// The state shared by the stages: the first error, which stops the
+// pipeline, and the latencies of the frames done
+class Pipeline {
+ public:
+  explicit Pipeline(size_t queue_size) {
+    for (auto& queue : m_queues) queue.reset(new FrameQueue(queue_size));
+  }
+
+  FrameQueue& Queue(int stage) { return *m_queues[stage]; }
+
+  // Starts threads workers of stage, which take the frames from the queue
+  // of the stage, process them and pass them on to the next stage
+  template <typename Fn>
+  void StartStage(int stage, int threads, Fn process) {
+    for (int t = 0; t < threads; t++) {
+      m_workers[stage].emplace_back([this, stage, process]() {
+        std::unique_ptr<Frame> frame;
+        while (Queue(stage).GetNextAvailable(&frame)) {
+          auto start = Clock::now();
+          Status status = process(*frame);
+          frame->stage_ms[stage] =
+              std::chrono::duration<double, std::milli>(Clock::now() - start)
+                  .count();
+          if (!status.ok()) {
+            Fail(status);
+            return;
+          }
+          if (stage + 1 < NUM_STAGES) {
+            if (!Queue(stage + 1).Add(std::move(frame))) return;
+          } else {
+            Done(*frame);
+          }
+        }
+      });
+    }
+  }
+
+  // Waits for the stages in order, each one once the stage before it
+  // terminated its queue
+  void Join() {
+    for (int s = 0; s < NUM_STAGES; s++) {
+      Queue(s).Terminate();
+      for (auto& thread : m_workers[s]) thread.join();
+    }
+  }
+
+  void Fail(const Status& status) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_status.ok()) m_status = status;
+    }
+    for (int s = 0; s < NUM_STAGES; s++) Queue(s).Terminate();
+  }
+
+  Status status() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_status;
+  }
+
+  void Report(double seconds) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const size_t frames = m_end_to_end_ms.size();
+    cout << endl
+         << frames << " frames in " << std::fixed << std::setprecision(2)
+         << seconds << " s: " << (seconds > 0 ? frames / seconds : 0)
+         << " FPS, " << m_detections << " detections" << endl
+         << std::left << std::setw(14) << "Stage" << std::right
+         << std::setw(10) << "mean ms" << std::setw(10) << "p50 ms"
+         << std::setw(10) << "p99 ms" << endl;
+    for (int s = 0; s <= NUM_STAGES; s++) {
+      auto& latencies = s < NUM_STAGES ? m_stage_ms[s] : m_end_to_end_ms;
+      std::sort(latencies.begin(), latencies.end());
+      double mean = 0;
+      for (double latency : latencies) mean += latency;
+      if (!latencies.empty()) mean /= latencies.size();
+      cout << std::left << std::setw(14)
+           << (s < NUM_STAGES ? kStageNames[s] : "end to end") << std::right
+           << std::setw(10) << mean << std::setw(10)
+           << Percentile(latencies, 0.5) << std::setw(10)
+           << Percentile(latencies, 0.99) << endl;
+    }
+  }
+
+ private:
+  static double Percentile(const vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0;
+    size_t index = std::min(sorted.size() - 1,
+                            static_cast<size_t>(q * (sorted.size() - 1) + 0.5));
+    return sorted[index];
+  }
+
+  void Done(const Frame& frame) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (int s = 0; s < NUM_STAGES; s++) {
+      m_stage_ms[s].push_back(frame.stage_ms[s]);
+    }
+    // Including the time the frame waited in the queues
+    m_end_to_end_ms.push_back(
+        std::chrono::duration<double, std::milli>(Clock::now() - frame.start)
+            .count());
+    m_detections += frame.detections;
+  }
+
+  std::array<std::unique_ptr<FrameQueue>, NUM_STAGES> m_queues;
+  std::array<std::vector<std::thread>, NUM_STAGES> m_workers;
+  std::mutex m_mutex;
+  Status m_status;
+  std::array<std::vector<double>, NUM_STAGES> m_stage_ms;
+  std::vector<double> m_end_to_end_ms;
+  int64_t m_detections = 0;
+};
+
+int main(int argc, char** argv) {
+  string graph = "";
+  string input = "examples/data/grace_hopper.jpg";
+  string input_layer = "input";
+  string boxes_layer = "boxes";
+  string scores_layer = "scores";
+  string backend = "CPU";
+  int input_width = 416;
+  int input_height = 416;
+  float input_mean = 0;
+  float input_std = 255;
+  float conf_threshold = 0.6;
+  float iou_threshold = 0.5;
+  int frames = 200;
+  int decode_threads = 1;
+  int preprocess_threads = 1;
+  int infer_requests = 2;
+  int queue_size = 4;
+
+  std::vector<tensorflow::Flag> flag_list = {
+      Flag("graph", &graph, "frozen detection graph to be executed"),
+      Flag("input", &input, "image, or directory of images, to be processed"),
+      Flag("input_layer", &input_layer, "name of the input layer"),
+      Flag("boxes_layer", &boxes_layer, "name of the [1, N, 4] boxes output"),
+      Flag("scores_layer", &scores_layer,
+           "name of the [1, N, classes] scores output"),
+      Flag("backend", &backend, "OpenVINO backend, TF for native TensorFlow"),
+      Flag("input_width", &input_width, "resize image to this width in pixels"),
+      Flag("input_height", &input_height,
+           "resize image to this height in pixels"),
+      Flag("input_mean", &input_mean, "scale pixel values to this mean"),
+      Flag("input_std", &input_std, "scale pixel values to this std deviation"),
+      Flag("conf_threshold", &conf_threshold, "minimum score of a box"),
+      Flag("iou_threshold", &iou_threshold,
+           "overlap above which the box of lower score is suppressed"),
+      Flag("frames", &frames, "number of frames processed"),
+      Flag("decode_threads", &decode_threads, "threads decoding the images"),
+      Flag("preprocess_threads", &preprocess_threads,
+           "threads resizing the images"),
+      Flag("infer_requests", &infer_requests,
+           "frames inferred concurrently"),
+      Flag("queue_size", &queue_size, "frames waiting between two stages")};
+
+  string usage = tensorflow::Flags::Usage(argv[0], flag_list);
+  const bool parse_result = tensorflow::Flags::Parse(&argc, argv, flag_list);
+  if (!parse_result || graph.empty() || frames < 1 || decode_threads < 1 ||
+      preprocess_threads < 1 || infer_requests < 1 || queue_size < 1) {
+    std::cout << usage;
+    return -1;
+  }
+
+  // We need to call this to set up global state for TensorFlow.
+  tensorflow::port::InitMain(argv[0], &argc, &argv);
+  if (argc > 1) {
+    std::cout << "Error: Unknown argument " << argv[1] << "\n" << usage;
+    return -1;
+  }
+
+  std::vector<string> files;
+  std::unique_ptr<tensorflow::Session> decode_session, preprocess_session,
+      session;
+  Status status = ListImages(input, &files);
+  if (status.ok()) status = BuildDecodeSession(&decode_session);
+  if (status.ok()) {
+    status = BuildPreprocessSession(input_height, input_width, input_mean,
+                                    input_std, &preprocess_session);
+  }
+  if (status.ok()) {
+    if (backend == "TF") {
+      tensorflow::openvino_tensorflow::api::disable();
+    } else {
+      tensorflow::openvino_tensorflow::api::SetBackend(backend);
+    }
+    status = LoadGraph(graph, &session);
+  }
+  if (!status.ok()) {
+    LOG(ERROR) << status;
+    return -1;
+  }
+
+  Pipeline pipeline(queue_size);
+  pipeline.StartStage(DECODE, decode_threads, [&](Frame& frame) {
+    string contents;
+    TF_RETURN_IF_ERROR(tensorflow::ReadFileToString(
+        tensorflow::Env::Default(), frame.file, &contents));
+    Tensor encoded(tensorflow::DT_STRING, tensorflow::TensorShape());
+    encoded.scalar<tensorflow::tstring>()() = contents;
+    std::vector<Tensor> outputs;
+    TF_RETURN_IF_ERROR(decode_session->Run(
+        {{"encoded", encoded}},
+        {absl::EndsWith(frame.file, ".png") ? "png" : "jpeg"}, {}, &outputs));
+    frame.image = outputs[0];
+    return Status::OK();
+  });
+  pipeline.StartStage(PREPROCESS, preprocess_threads, [&](Frame& frame) {
+    std::vector<Tensor> outputs;
+    TF_RETURN_IF_ERROR(preprocess_session->Run({{"image", frame.image}},
+                                               {"input"}, {}, &outputs));
+    frame.input = outputs[0];
+    frame.image = Tensor();
+    return Status::OK();
+  });
+  pipeline.StartStage(INFER, infer_requests, [&](Frame& frame) {
+    TF_RETURN_IF_ERROR(session->Run({{input_layer, frame.input}},
+                                    {boxes_layer, scores_layer}, {},
+                                    &frame.outputs));
+    frame.input = Tensor();
+    return Status::OK();
+  });
+  pipeline.StartStage(POSTPROCESS, 1, [&](Frame& frame) {
+    const Tensor& boxes = frame.outputs[0];
+    const Tensor& scores = frame.outputs[1];
+    if (boxes.dims() != 3 || boxes.dim_size(2) != 4 || scores.dims() != 3 ||
+        scores.dim_size(1) != boxes.dim_size(1)) {
+      return tensorflow::errors::InvalidArgument(
+          "Expected [1, N, 4] boxes and [1, N, classes] scores, got ",
+          boxes.shape().DebugString(), " and ", scores.shape().DebugString());
+    }
+    auto detections =
+        SuppressBoxes(boxes, scores, conf_threshold, iou_threshold);
+    frame.detections = detections.size();
+    if (frame.id == 0) {
+      cout << frame.file << ": " << detections.size() << " detections" << endl;
+      for (const auto& box : detections) {
+        cout << "  class " << box.label << " (" << box.score << "): ["
+             << box.y1 << ", " << box.x1 << ", " << box.y2 << ", " << box.x2
+             << "]" << endl;
+      }
+    }
+    frame.outputs.clear();
+    return Status::OK();
+  });
+
+  // The frames enter the pipeline as fast as the decode queue takes them
+  cout << "Processing " << frames << " frames of " << files.size()
+       << " images on " << backend << endl;
+  auto start = Clock::now();
+  for (int64_t id = 0; id < frames; id++) {
+    std::unique_ptr<Frame> frame(new Frame());
+    frame->id = id;
+    frame->file = files[id % files.size()];
+    frame->start = Clock::now();
+    if (!pipeline.Queue(DECODE).Add(std::move(frame))) break;
+  }
+  pipeline.Join();
+  double seconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+
+  status = pipeline.status();
+  if (!status.ok()) {
+    LOG(ERROR) << "Pipeline failed: " << status;
+    return -1;
+  }
+  pipeline.Report(seconds);
+  return 0;
+}
@@ -8,47 +8,147 @@
 #define THREAD_SAFE_QUEUE_H_
 #pragma once
 
+#include <cstddef>
 #include <queue>
+#include <vector>
 
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 
 using namespace std;
 
 namespace benchmark {
 
+// A FIFO queue shared by producer and consumer threads. A non zero capacity
+// blocks the producers while the queue is full. Once terminated, the queue
+// accepts no new items and the consumers get the remaining ones, after
+// which they are not blocked anymore.
+//
+// The producers and the consumers wait on conditions of their own, and
+// every item added or taken wakes a single thread of the other side, so
+// that a busy queue does not wake all its waiters at every step.
 template <typename T>
 class ThreadSafeQueue {
  public:
-  // Return T and a status thing so that in case or termination,
-  // caller can check
-  // TODO
+  explicit ThreadSafeQueue(size_t capacity = 0) : m_capacity(capacity) {}
+
+  // Waits for the next item. Returns a default constructed item once the
+  // queue is terminated and empty.
   T GetNextAvailable() {
-    m_mutex.Lock();
-    while (m_queue.empty()) {
-      m_cv.Wait(&m_mutex);
+    T next{};
+    GetNextAvailable(&next);
+    return next;
+  }
+
+  // Waits for the next item, false once the queue is terminated and empty
+  bool GetNextAvailable(T* next) {
+    absl::MutexLock lock(&m_mutex);
+    while (m_queue.empty() && !m_terminated) {
+      m_not_empty.Wait(&m_mutex);
     }
+    return PopLocked(next);
+  }
 
-    T next = std::move(m_queue.front());
-    m_queue.pop();
-    m_mutex.Unlock();
-    return next;
+  // Takes the next item if there is one, without waiting
+  bool TryGetNext(T* next) {
+    absl::MutexLock lock(&m_mutex);
+    return PopLocked(next);
   }
 
-  void Add(T item) {
-    m_mutex.Lock();
-    m_queue.push(std::move(item));
-    m_cv.SignalAll();
-    m_mutex.Unlock();
+  // Waits for a first item, then up to timeout for more items to arrive
+  // until there are max_n of them, and appends them to batch. False once
+  // the queue is terminated and empty.
+  bool PopBatch(size_t max_n, absl::Duration timeout, std::vector<T>* batch) {
+    absl::MutexLock lock(&m_mutex);
+    while (m_queue.empty() && !m_terminated) {
+      m_not_empty.Wait(&m_mutex);
+    }
+    if (m_queue.empty()) return false;
+
+    const absl::Time deadline = absl::Now() + timeout;
+    size_t taken = 0;
+    while (taken < max_n) {
+      if (m_queue.empty()) {
+        // An item may still have arrived along with the timeout
+        if (m_terminated ||
+            (m_not_empty.WaitWithDeadline(&m_mutex, deadline) &&
+             m_queue.empty())) {
+          break;
+        }
+        continue;
+      }
+      batch->push_back(std::move(m_queue.front()));
+      m_queue.pop();
+      taken++;
+    }
+    if (taken > 1) {
+      m_not_full.SignalAll();
+    } else {
+      m_not_full.Signal();
+    }
+    // The items left are passed on to the other consumers
+    if (!m_queue.empty()) m_not_empty.Signal();
+    return true;
   }
 
+  // Waits for space in the queue, false if it is terminated and the item
+  // was dropped
+  bool Add(T item) {
+    absl::MutexLock lock(&m_mutex);
+    while (FullLocked() && !m_terminated) {
+      m_not_full.Wait(&m_mutex);
+    }
+    if (m_terminated) return false;
+    PushLocked(std::move(item));
+    return true;
+  }
+
+  // Adds item if there is space in the queue, without waiting. The item is
+  // left as it is otherwise.
+  bool TryAdd(T& item) {
+    absl::MutexLock lock(&m_mutex);
+    if (FullLocked() || m_terminated) return false;
+    PushLocked(std::move(item));
+    return true;
+  }
+
+  size_t Size() {
+    absl::MutexLock lock(&m_mutex);
+    return m_queue.size();
+  }
+
+  // Wakes up all the waiting producers and consumers
   void Terminate() {
-    // TODO
-    //
+    absl::MutexLock lock(&m_mutex);
+    m_terminated = true;
+    m_not_empty.SignalAll();
+    m_not_full.SignalAll();
   }
 
  private:
+  bool FullLocked() const {
+    return m_capacity > 0 && m_queue.size() >= m_capacity;
+  }
+
+  void PushLocked(T&& item) {
+    m_queue.push(std::move(item));
+    m_not_empty.Signal();
+  }
+
+  bool PopLocked(T* next) {
+    if (m_queue.empty()) return false;
+    *next = std::move(m_queue.front());
+    m_queue.pop();
+    m_not_full.Signal();
+    return true;
+  }
+
+  const size_t m_capacity;
+  bool m_terminated = false;
   queue<T> m_queue;
-  absl::CondVar m_cv;
+  absl::CondVar m_not_empty;
+  absl::CondVar m_not_full;
   absl::Mutex m_mutex;
 };
 
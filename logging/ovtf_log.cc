@@ -5,7 +5,9 @@
  *******************************************************************************/
 
 #include "ovtf_log.h"
+#include <algorithm>
 #include <cstdlib>
+#include <sstream>
 
 using namespace std;
 
@@ -31,9 +33,15 @@ tensorflow::int64 LogLevelStrToInt(const char* tf_env_var_val) {
 }
 }  // namespace
 
-tensorflow::int64 NGraphLogMessage::MinNGraphVLogLevel() {
+std::atomic<tensorflow::int64> NGraphLogMessage::s_min_vlog_level{-1};
+
+tensorflow::int64 NGraphLogMessage::ReadMinNGraphVLogLevel() {
   const char* tf_env_var_val = std::getenv("OPENVINO_TF_VLOG_LEVEL");
-  return LogLevelStrToInt(tf_env_var_val);
+  // A negative level logs nothing, like 0
+  tensorflow::int64 level =
+      std::max<tensorflow::int64>(0, LogLevelStrToInt(tf_env_var_val));
+  s_min_vlog_level.store(level, std::memory_order_relaxed);
+  return level;
 }
 
 std::string NGraphLogMessage::GetTimeStampForLogging() {
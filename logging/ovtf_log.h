@@ -7,6 +7,7 @@
 #ifndef NGRAPH_LOG_H_
 #define NGRAPH_LOG_H_
 
+#include <atomic>
 #include <string>
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/default/logging.h"
@@ -14,16 +15,37 @@
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/public/version.h"
 
+// The highest OVTF_VLOG level compiled in. The logs above it are compiled
+// out, and cost nothing whatever OPENVINO_TF_VLOG_LEVEL is.
+#ifndef OPENVINO_TF_MAX_VLOG_LEVEL
+#define OPENVINO_TF_MAX_VLOG_LEVEL 5
+#endif
+
 class NGraphLogMessage : public tensorflow::internal::LogMessage {
  public:
-  static tensorflow::int64 MinNGraphVLogLevel();
+  // OPENVINO_TF_VLOG_LEVEL, read once
+  static tensorflow::int64 MinNGraphVLogLevel() {
+    tensorflow::int64 level = s_min_vlog_level.load(std::memory_order_relaxed);
+    if (TF_PREDICT_FALSE(level < 0)) level = ReadMinNGraphVLogLevel();
+    return level;
+  }
+  // Reads OPENVINO_TF_VLOG_LEVEL again, after it was changed
+  static tensorflow::int64 ReadMinNGraphVLogLevel();
   static std::string GetTimeStampForLogging();
+
+ private:
+  // Negative until OPENVINO_TF_VLOG_LEVEL is read
+  static std::atomic<tensorflow::int64> s_min_vlog_level;
 };
 
-#define OVTF_VLOG_IS_ON(lvl) ((lvl) <= NGraphLogMessage::MinNGraphVLogLevel())
+#define OVTF_VLOG_IS_ON(lvl)             \
+  ((lvl) <= OPENVINO_TF_MAX_VLOG_LEVEL && \
+   (lvl) <= NGraphLogMessage::MinNGraphVLogLevel())
 
-#define OVTF_VLOG(lvl)      \
-  if (OVTF_VLOG_IS_ON(lvl)) \
-  ::tensorflow::internal::LogMessage(__FILE__, __LINE__, tensorflow::INFO)
+// The arguments are only evaluated when the log is on
+#define OVTF_VLOG(lvl)                          \
+  if (TF_PREDICT_TRUE(!OVTF_VLOG_IS_ON(lvl))) { \
+  } else                                        \
+    ::tensorflow::internal::LogMessage(__FILE__, __LINE__, tensorflow::INFO)
 
 #endif  // NGRAPH_LOG_H_
@@ -0,0 +1,182 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "absl/strings/match.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
+#include "tensorflow/core/platform/fingerprint.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/aot_bundle.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+std::mutex AOTBundle::s_mutex;
+bool AOTBundle::s_configured = false;
+AOTBundle::Mode AOTBundle::s_mode = AOTBundle::Mode::kDisabled;
+std::string AOTBundle::s_dir;
+
+static bool IsDirectory(const string& dir) {
+  struct stat st;
+  return stat(dir.c_str(), &st) == 0 && (st.st_mode & S_IFDIR);
+}
+
+static string ToHex(uint64 value) {
+  stringstream ss;
+  ss << hex << value;
+  return ss.str();
+}
+
+Status AOTBundle::Configure(const string& dir, bool export_bundle) {
+  if (!dir.empty() && !IsDirectory(dir)) {
+    return errors::InvalidArgument("Directory \"", dir, "\" does not exist.");
+  }
+  lock_guard<mutex> lock(s_mutex);
+  s_configured = !dir.empty();
+  s_dir = dir;
+  s_mode = dir.empty() ? Mode::kDisabled
+                       : (export_bundle ? Mode::kExport : Mode::kLoad);
+  return Status::OK();
+}
+
+void AOTBundle::GetSettings(Mode& mode, string& dir) {
+  {
+    lock_guard<mutex> lock(s_mutex);
+    if (s_configured) {
+      mode = s_mode;
+      dir = s_dir;
+      return;
+    }
+  }
+  mode = Mode::kDisabled;
+  dir = util::GetEnv("OPENVINO_TF_AOT_BUNDLE_EXPORT");
+  if (!dir.empty()) {
+    mode = Mode::kExport;
+  } else {
+    dir = util::GetEnv("OPENVINO_TF_AOT_BUNDLE");
+    if (!dir.empty()) mode = Mode::kLoad;
+  }
+  if (mode != Mode::kDisabled && !IsDirectory(dir)) {
+    OVTF_VLOG(0) << "AOT bundle directory \"" << dir
+                 << "\" does not exist, the bundle is disabled";
+    mode = Mode::kDisabled;
+  }
+}
+
+AOTBundle::Mode AOTBundle::GetMode() {
+  Mode mode;
+  string dir;
+  GetSettings(mode, dir);
+  return mode;
+}
+
+uint64 AOTBundle::FingerprintGraph(const GraphDef& graph) {
+  GraphDef stripped = graph;
+  for (auto& node : *stripped.mutable_node()) {
+    node.clear_device();
+    auto* attrs = node.mutable_attr();
+    for (auto it = attrs->begin(); it != attrs->end();) {
+      if (absl::StartsWith(it->first, "_ovtf") ||
+          absl::StartsWith(it->first, "ovtf")) {
+        it = attrs->erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  string serialized;
+  SerializeToStringDeterministic(stripped, &serialized);
+  return Fingerprint64(serialized);
+}
+
+string AOTBundle::EntryName(uint64 graph_fingerprint,
+                            const CompilationKey& signature,
+                            const string& device_type,
+                            const ov::AnyMap& compile_config,
+                            const string& model_settings) {
+  stringstream ss;
+  ss << signature.DebugString() << "|" << device_type << "|"
+     << model_settings;
+  for (const auto& property : compile_config) {
+    ss << "|" << property.first << "=";
+    try {
+      ss << property.second.as<string>();
+    } catch (const std::exception&) {
+      // Properties which can not be printed only have their key taken in
+    }
+  }
+  return ToHex(graph_fingerprint) + "-" + ToHex(Fingerprint64(ss.str())) +
+         ".blob";
+}
+
+string AOTBundle::FindEntry(const string& entry) {
+  Mode mode;
+  string dir;
+  GetSettings(mode, dir);
+  if (mode != Mode::kLoad) return "";
+  string path = dir + "/" + entry;
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0 || !(st.st_mode & S_IFREG)) return "";
+  return path;
+}
+
+Status AOTBundle::ExportEntry(const string& entry, const string& cluster_name,
+                              const CompilationKey& signature,
+                              Executable& executable) {
+  Mode mode;
+  string dir;
+  GetSettings(mode, dir);
+  if (mode != Mode::kExport) return Status::OK();
+
+  // Written under a temporary name so that a loading process never sees a
+  // partial blob
+  string path = dir + "/" + entry;
+  string tmp_path = path + ".tmp";
+  {
+    ofstream blob(tmp_path, ios::binary);
+    if (!blob) {
+      return errors::Internal("Failed to create ", tmp_path);
+    }
+    try {
+      executable.ExportCompiled(blob);
+    } catch (const std::exception& e) {
+      blob.close();
+      remove(tmp_path.c_str());
+      return errors::Internal("Failed to export ", cluster_name, ": ",
+                              e.what());
+    }
+    if (!blob.good()) {
+      blob.close();
+      remove(tmp_path.c_str());
+      return errors::Internal("Failed to write ", tmp_path);
+    }
+  }
+  if (rename(tmp_path.c_str(), path.c_str()) != 0) {
+    remove(tmp_path.c_str());
+    return errors::Internal("Failed to write ", path);
+  }
+
+  lock_guard<mutex> lock(s_mutex);
+  ofstream manifest(dir + "/manifest.txt", ios::app);
+  manifest << entry << " " << executable.GetDeviceType() << " "
+           << cluster_name << " " << signature.DebugString() << "\n";
+  OVTF_VLOG(1) << "Exported " << cluster_name << " to " << path;
+  return Status::OK();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
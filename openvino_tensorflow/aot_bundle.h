@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_AOT_BUNDLE_H_
+#define OPENVINO_TF_AOT_BUNDLE_H_
+
+#include <mutex>
+#include <string>
+
+#include "openvino/openvino.hpp"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/lib/core/status.h"
+
+#include "openvino_tensorflow/compilation_key.h"
+#include "openvino_tensorflow/executable.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Bundle of compiled models, written ahead of time so that a deployed model
+// never compiles its clusters. The bundle is a directory with one blob per
+// cluster and input signature, named after the fingerprints of the cluster
+// graph, the signature and the device configuration, and a manifest
+// describing every blob.
+//
+// The bundle is exported by running the model with its input signatures
+// once, every compiled model is then written to the bundle. When a bundle
+// is loaded, the executables found in it import their compiled model
+// instead of compiling it; the others are compiled as usual.
+//
+// The bundle is set through the api, OPENVINO_TF_AOT_BUNDLE_EXPORT or
+// OPENVINO_TF_AOT_BUNDLE.
+class AOTBundle {
+ public:
+  enum class Mode { kDisabled, kLoad, kExport };
+
+  // Sets the bundle directory, which must exist. An empty directory
+  // restores the bundle of the environment.
+  static Status Configure(const std::string& dir, bool export_bundle);
+
+  static Mode GetMode();
+
+  // Fingerprint of a cluster graph. The openvino_tensorflow attributes and
+  // the devices are left out, they depend on the order the clusters were
+  // created in and on the devices of the machine.
+  static uint64 FingerprintGraph(const GraphDef& graph);
+
+  // The name of the blob of an executable. model_settings describes the
+  // settings the model was translated and transformed with, beyond the
+  // cluster graph, the signature and the compile properties.
+  static std::string EntryName(uint64 graph_fingerprint,
+                               const CompilationKey& signature,
+                               const std::string& device_type,
+                               const ov::AnyMap& compile_config,
+                               const std::string& model_settings);
+
+  // The path of the blob in the bundle, empty if the bundle does not hold
+  // it
+  static std::string FindEntry(const std::string& entry);
+
+  // Compiles the executable if needed and writes its compiled model to the
+  // bundle
+  static Status ExportEntry(const std::string& entry,
+                            const std::string& cluster_name,
+                            const CompilationKey& signature,
+                            Executable& executable);
+
+ private:
+  static void GetSettings(Mode& mode, std::string& dir);
+
+  static std::mutex s_mutex;
+  static bool s_configured;
+  static Mode s_mode;
+  static std::string s_dir;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_AOT_BUNDLE_H_
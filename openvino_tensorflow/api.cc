@@ -12,7 +12,17 @@
 #include "tensorflow/core/lib/core/errors.h"
 
 #include "api.h"
+#include "aot_bundle.h"
 #include "backend_manager.h"
+#include "cluster_manager.h"
+#include "cluster_placement.h"
+#include "cluster_profile.h"
+#include "cluster_topology.h"
+#include "compile_properties.h"
+#include "kv_cache.h"
+#include "memory_budget.h"
+#include "metrics.h"
+#include "usm_host_allocator.h"
 
 namespace tensorflow {
 namespace openvino_tensorflow {
@@ -25,6 +35,8 @@ static char* backendName = nullptr;
 static char* backendList[4];
 static char* clusterInfo = nullptr;
 static char* errMsg = nullptr;
+static char* clusterStats = nullptr;
+static char* clusterTopology = nullptr;
 
 extern "C" {
 void enable() { Enable(); }
@@ -36,7 +48,8 @@ bool CheckBackend(const char* backend) {
   for (int i = 0; i < 5; i++) {
     if (strcmp(backend, devices[i]) == 0) return true;
   }
-  return false;
+  // The GPUs are numbered when there are several of them
+  return strncmp(backend, "GPU.", 4) == 0;
 }
 size_t backends_len() {
   const auto ovtf_backends = ListBackends();
@@ -89,6 +102,8 @@ void stop_logging_placement() { StopLoggingPlacement(); }
 bool is_logging_placement() { return IsLoggingPlacement(); }
 void EXPORT_SYMBOL freeClusterInfo() { free(clusterInfo); }
 void EXPORT_SYMBOL freeErrMsg() { free(errMsg); }
+void EXPORT_SYMBOL freeClusterStats() { free(clusterStats); }
+void EXPORT_SYMBOL freeClusterTopology() { free(clusterTopology); }
 
 extern void set_disabled_ops(const char* op_type_list) {
   SetDisabledOps(std::string(op_type_list));
@@ -113,6 +128,80 @@ bool export_ir(const char* output_dir, char** cluster_info, char** err_msg) {
   *cluster_info = clusterInfo;
   return true;
 }
+
+bool set_compile_property(const char* key, const char* value,
+                          char** err_msg) {
+  string str_err_msg("");
+  if (!SetCompileProperty(string(key), string(value), str_err_msg)) {
+    errMsg = strdup(str_err_msg.c_str());
+    *err_msg = errMsg;
+    return false;
+  }
+  return true;
+}
+void clear_compile_properties() { ClearCompileProperties(); }
+
+bool set_cluster_placement(const char* rules, char** err_msg) {
+  string str_err_msg("");
+  if (!SetClusterPlacement(string(rules), str_err_msg)) {
+    errMsg = strdup(str_err_msg.c_str());
+    *err_msg = errMsg;
+    return false;
+  }
+  return true;
+}
+
+bool set_pipeline_stages(const char* stages, char** err_msg) {
+  string str_err_msg("");
+  if (!SetPipelineStages(string(stages), str_err_msg)) {
+    errMsg = strdup(str_err_msg.c_str());
+    *err_msg = errMsg;
+    return false;
+  }
+  return true;
+}
+
+bool set_aot_bundle(const char* bundle_dir, bool export_bundle,
+                    char** err_msg) {
+  string str_err_msg("");
+  if (!SetAOTBundle(string(bundle_dir), export_bundle, str_err_msg)) {
+    errMsg = strdup(str_err_msg.c_str());
+    *err_msg = errMsg;
+    return false;
+  }
+  return true;
+}
+
+void start_warmup() { StartWarmup(); }
+void finish_warmup() { FinishWarmup(); }
+
+void get_cluster_stats(char** stats) {
+  clusterStats = strdup(GetClusterStats().c_str());
+  *stats = clusterStats;
+}
+void reset_cluster_stats() { ResetClusterStats(); }
+
+void get_cluster_topology(char** topology) {
+  clusterTopology = strdup(GetClusterTopology().c_str());
+  *topology = clusterTopology;
+}
+void clear_cluster_topology() { ClearClusterTopology(); }
+
+void reset_kv_cache() { ResetKVCache(); }
+
+void set_memory_budget(const char* device, size_t bytes) {
+  SetMemoryBudget(string(device), bytes);
+}
+
+bool save_cluster_profile(const char* path, char** err_msg) {
+  string str_err_msg("");
+  if (!SaveClusterProfile(string(path), str_err_msg)) {
+    errMsg = strdup(str_err_msg.c_str());
+    *err_msg = errMsg;
+    return false;
+  }
+  return true;
+}
 }
 
 // note that TensorFlow always uses camel case for the C++ API, but not for
@@ -192,6 +281,60 @@ bool ExportIR(const string& output_dir, string& cluster_info, string& err_msg) {
   return true;
 }
 
+bool SetCompileProperty(const string& key, const string& value,
+                        string& err_msg) {
+  Status status = CompileProperties::SetDefault(key, value);
+  err_msg = status.ok() ? "" : status.error_message();
+  return status.ok();
+}
+
+void ClearCompileProperties() { CompileProperties::ClearDefaults(); }
+
+bool SetClusterPlacement(const string& rules, string& err_msg) {
+  Status status = ClusterPlacement::SetRules(rules);
+  err_msg = status.ok() ? "" : status.error_message();
+  return status.ok();
+}
+
+bool SetPipelineStages(const string& stages, string& err_msg) {
+  Status status = ClusterPlacement::SetStages(stages);
+  err_msg = status.ok() ? "" : status.error_message();
+  return status.ok();
+}
+
+bool SetAOTBundle(const string& bundle_dir, bool export_bundle,
+                  string& err_msg) {
+  Status status = AOTBundle::Configure(bundle_dir, export_bundle);
+  err_msg = status.ok() ? "" : status.error_message();
+  return status.ok();
+}
+
+void StartWarmup() { NGraphClusterManager::StartWarmup(); }
+void FinishWarmup() { NGraphClusterManager::FinishWarmup(); }
+
+string GetClusterStats() { return Metrics::ToJson(); }
+void ResetClusterStats() { Metrics::Reset(); }
+
+string GetClusterTopology() { return ClusterTopology::GetReports(); }
+void ClearClusterTopology() { ClusterTopology::Clear(); }
+
+void ResetKVCache() { KVCacheState::Reset(); }
+
+void SetMemoryBudget(const string& device, size_t bytes) {
+  MemoryBudget::Set(device, bytes);
+  // The executables still used by the kernels can not be evicted, the next
+  // compilations on the device make room again
+  NGraphClusterManager::ReserveDeviceMemory(device, 0).IgnoreError();
+}
+
+bool SaveClusterProfile(const string& path, string& err_msg) {
+  Status status = ClusterProfile::SaveCollected(path);
+  err_msg = status.ok() ? "" : status.error_message();
+  return status.ok();
+}
+
+Allocator* GetUSMHostAllocator() { return USMHostAllocator::Get(); }
+
 }  // namespace api
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
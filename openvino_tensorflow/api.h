@@ -25,6 +25,8 @@
 using namespace std;
 
 namespace tensorflow {
+class Allocator;
+
 namespace openvino_tensorflow {
 namespace api {
 
@@ -51,6 +53,36 @@ extern EXPORT_SYMBOL void disable_dynamic_fallback();
 
 extern EXPORT_SYMBOL bool export_ir(const char* output_dir, char** cluster_info,
                                     char** err_msg);
+
+extern EXPORT_SYMBOL bool set_compile_property(const char* key,
+                                               const char* value,
+                                               char** err_msg);
+extern EXPORT_SYMBOL void clear_compile_properties();
+
+extern EXPORT_SYMBOL bool set_cluster_placement(const char* rules,
+                                                char** err_msg);
+
+extern EXPORT_SYMBOL bool set_pipeline_stages(const char* stages,
+                                              char** err_msg);
+
+extern EXPORT_SYMBOL bool set_aot_bundle(const char* bundle_dir,
+                                         bool export_bundle, char** err_msg);
+
+extern EXPORT_SYMBOL void start_warmup();
+extern EXPORT_SYMBOL void finish_warmup();
+
+extern EXPORT_SYMBOL void get_cluster_stats(char** stats);
+extern EXPORT_SYMBOL void reset_cluster_stats();
+
+extern EXPORT_SYMBOL void get_cluster_topology(char** topology);
+extern EXPORT_SYMBOL void clear_cluster_topology();
+
+extern EXPORT_SYMBOL void reset_kv_cache();
+
+extern EXPORT_SYMBOL void set_memory_budget(const char* device, size_t bytes);
+
+extern EXPORT_SYMBOL bool save_cluster_profile(const char* path,
+                                               char** err_msg);
 }
 
 extern void Enable();
@@ -75,6 +107,57 @@ extern void DisableDynamicFallback();
 
 extern bool ExportIR(const string& output_dir, string& cluster_info,
                      string& err_msg);
+
+// Sets the default OpenVINO property the clusters are compiled with, see
+// CompileProperties for the keys. An empty value removes the default.
+extern bool SetCompileProperty(const string& key, const string& value,
+                               string& err_msg);
+extern void ClearCompileProperties();
+
+// Sets the rules placing clusters on other devices than the backend's, see
+// ClusterPlacement. An empty string removes them.
+extern bool SetClusterPlacement(const string& rules, string& err_msg);
+
+// Sets the devices of the pipeline stages the clusters are split into, see
+// ClusterPlacement. An empty string removes them.
+extern bool SetPipelineStages(const string& stages, string& err_msg);
+
+// Sets the directory of the AOT bundle the compiled clusters are loaded
+// from, or exported to, see AOTBundle. An empty directory restores the
+// bundle of the environment.
+extern bool SetAOTBundle(const string& bundle_dir, bool export_bundle,
+                         string& err_msg);
+
+// While warming up, the clusters compile their cache misses in parallel
+// and run on TF meanwhile. FinishWarmup waits for the compilations.
+extern void StartWarmup();
+extern void FinishWarmup();
+
+// The metrics of every cluster as a JSON document
+extern string GetClusterStats();
+extern void ResetClusterStats();
+
+// The JSON reports of the clusters of the last rewritten graphs, see
+// ClusterTopology
+extern string GetClusterTopology();
+extern void ClearClusterTopology();
+
+// Makes the clusters holding their KV-caches in variables, see
+// OPENVINO_TF_KV_CACHE, set them from their TF inputs on their next step
+extern void ResetKVCache();
+
+// Sets the memory budget of device, see MemoryBudget, and evicts the cached
+// executables of the device beyond it. A budget of 0 removes it.
+extern void SetMemoryBudget(const string& device, size_t bytes);
+
+// Merges the metrics of the clusters into the profile at path, see
+// ClusterProfile. An empty path saves to OPENVINO_TF_CLUSTER_PROFILE.
+extern bool SaveClusterProfile(const string& path, string& err_msg);
+
+// The allocator of USM host memory for the tensors fed to GPU clusters,
+// which the device reads without copying them, see USMHostAllocator.
+// nullptr without a GPU.
+extern EXPORT_SYMBOL Allocator* GetUSMHostAllocator();
 }  // namespace api
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -4,9 +4,13 @@
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
 #include <algorithm>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 #include "tensorflow/core/framework/attr_value_util.h"
 #include "tensorflow/core/framework/graph.pb.h"
@@ -81,44 +85,54 @@ namespace openvino_tensorflow {
 namespace {
 struct Cluster {
   int index;
-  std::set<tensorflow::Node*> nodes;
-  std::string predicate_string;
-  std::set<const Edge*> outgoing_edges;
+  std::vector<tensorflow::Node*> nodes;
+  // The interned predicate of the cluster
+  int predicate;
+  // The edges leaving the nodes of the cluster. The edges which became
+  // internal to the cluster are dropped lazily.
+  std::vector<const Edge*> outgoing_edges;
 };
 
+// The cluster of every node, by node id
+using ClusterMap = std::vector<std::shared_ptr<Cluster>>;
+
+inline bool IsTruePred(int predicate) {
+  return predicate == DeadnessAnalysis::kTruePredId;
+}
+
+inline bool IsControlFlowPred(int predicate) {
+  return predicate == DeadnessAnalysis::kControlFlowPredId;
+}
+
 // Returns the predicate of the merged cluster
 // If Src Predicate is TRUE then merged cluster gets the dst predicate
 // WARNING : This function does not do any checks
 // Use this function when ready to merge
-inline string GetMergedClusterPred(const string& src_predicate,
-                                   const string& dst_predicate) {
-  return DeadnessAnalysis::IsTruePredString(src_predicate) ? dst_predicate
-                                                           : src_predicate;
+inline int GetMergedClusterPred(int src_predicate, int dst_predicate) {
+  return IsTruePred(src_predicate) ? dst_predicate : src_predicate;
 }
 
 // Checks whether it's ok to contract the edge as far as deadness is concerned
 // Source and Dst Predicates of the edge should match
-Status CanContractEdgeDeadnessCheck(
-    Edge* edge, const std::map<Node*, std::shared_ptr<Cluster>>& cluster_map,
-    bool& is_deadness_ok) {
+Status CanContractEdgeDeadnessCheck(const Edge* edge, ClusterMap& cluster_map,
+                                    bool& is_deadness_ok) {
   Node* src = edge->src();
   Node* dst = edge->dst();
 
-  string src_predicate = cluster_map.at(src)->predicate_string;
-  string dst_predicate = cluster_map.at(dst)->predicate_string;
+  const auto& src_cluster = cluster_map[src->id()];
+  int src_predicate = src_cluster->predicate;
+  int dst_predicate = cluster_map[dst->id()]->predicate;
 
   // If the node marked for clustering has CONTROL_FLOW_PRED_STRING, it
   // breaks our assumption that all supported ops are data flow ops
-  if (DeadnessAnalysis::IsControlFlowPredString(src_predicate) ||
-      DeadnessAnalysis::IsControlFlowPredString(dst_predicate)) {
+  if (IsControlFlowPred(src_predicate) || IsControlFlowPred(dst_predicate)) {
     return errors::Internal(
         "Attempting to contract edge with control flow ops : ",
         edge->DebugString());
   }
 
   // Case src X , dst Y , X!=Y // cannot be contracted
-  if (!DeadnessAnalysis::IsTruePredString(src_predicate) &&
-      !DeadnessAnalysis::IsTruePredString(dst_predicate) &&
+  if (!IsTruePred(src_predicate) && !IsTruePred(dst_predicate) &&
       src_predicate != dst_predicate) {
     is_deadness_ok = false;
     return Status::OK();
@@ -127,8 +141,7 @@ Status CanContractEdgeDeadnessCheck(
   // Case src X , dst True // invalid scenario
   // If src has Non-True Predicate and dst has True Predicate, it implies that
   // the dst node is control flow
-  if (!DeadnessAnalysis::IsTruePredString(src_predicate) &&
-      DeadnessAnalysis::IsTruePredString(dst_predicate)) {
+  if (!IsTruePred(src_predicate) && IsTruePred(dst_predicate)) {
     return errors::Internal("Attempting to cluster control-flow node ",
                             dst->name(), "[", dst->type_string(), "]");
   }
@@ -138,28 +151,31 @@ Status CanContractEdgeDeadnessCheck(
   // have the predicate Y (True & Y = Y). Hence contraction is possible only
   // when, all outputs of the src cluster (other than the current edge) have the
   // predicate Y
-  if (DeadnessAnalysis::IsTruePredString(src_predicate)) {
-    auto src_cluster_out_edges = cluster_map.at(src)->outgoing_edges;
+  if (IsTruePred(src_predicate)) {
+    auto& src_cluster_out_edges = src_cluster->outgoing_edges;
     bool found_same_out_preds = true;
-    std::string pred_check = dst_predicate;
-
+    // The edges which became internal to the src cluster are dropped on the
+    // way, they do not leave it anymore
+    size_t num_out_edges = 0;
     for (const Edge* src_cluster_edge : src_cluster_out_edges) {
+      const auto& src_cluster_dst = cluster_map[src_cluster_edge->dst()->id()];
+      if (src_cluster_dst == src_cluster) {
+        continue;
+      }
+      src_cluster_out_edges[num_out_edges++] = src_cluster_edge;
       if (src_cluster_edge == edge) {
         continue;
       }
-      Node* src_cluster_dst = src_cluster_edge->dst();
-      std::string src_cluster_dst_pred =
-          cluster_map.at(src_cluster_dst)->predicate_string;
       // Note that if dst predicate is True, then it does not matter what the
-      // src_cluster_dst_pred is; After merge the merged cluster will always
-      // have a less strict predicate, True (since True is the least strict
-      // predicate)
-      if (!DeadnessAnalysis::IsTruePredString(pred_check) &&
-          pred_check != src_cluster_dst_pred) {
+      // src_cluster_dst predicate is; After merge the merged cluster will
+      // always have a less strict predicate, True (since True is the least
+      // strict predicate)
+      if (!IsTruePred(dst_predicate) &&
+          dst_predicate != src_cluster_dst->predicate) {
         found_same_out_preds = false;
-        break;
       }
     }
+    src_cluster_out_edges.resize(num_out_edges);
     // Cannot contract this edge
     if (!found_same_out_preds) {
       is_deadness_ok = false;
@@ -177,52 +193,43 @@ Status CanContractEdgeDeadnessCheck(
 
 // Some sanity checks for Node's cluster assignment wrt Deadness
 Status CheckNodeClusterAssignmentWRTDeadness(
-    Node* node, const std::map<Node*, string>& nodes_predicate_map,
-    const std::map<Node*, std::shared_ptr<Cluster>>& cluster_map) {
-  auto itr = nodes_predicate_map.find(node);
-  if (itr == nodes_predicate_map.end()) {
-    return errors::Internal("Node ", node->name(), " [", node->type_string(),
-                            "]", " not found in predicate map");
-  }
-  std::string node_pred_string = itr->second;
-
-  if (DeadnessAnalysis::IsControlFlowPredString(node_pred_string)) {
+    Node* node, const std::vector<int>& nodes_predicate_map,
+    const ClusterMap& cluster_map, const DeadnessAnalysis& deadness) {
+  int node_pred = nodes_predicate_map[node->id()];
+  if (IsControlFlowPred(node_pred)) {
     return errors::Internal(
         "Node ", node->name(), " [", node->type_string(), "]",
         " should not be clustered as it is a control flow op");
   }
 
-  std::string cluster_pred_string = cluster_map.at(node)->predicate_string;
-  int node_cluster_index = cluster_map.at(node)->index;
+  int cluster_pred = cluster_map[node->id()]->predicate;
+  int node_cluster_index = cluster_map[node->id()]->index;
 
   // If the node has Non-True Pred (P1) it can only be placed in a cluster with
   // the same pred
-  if (!DeadnessAnalysis::IsTruePredString(node_pred_string) &&
-      node_pred_string != cluster_pred_string) {
+  if (!IsTruePred(node_pred) && node_pred != cluster_pred) {
     return errors::Internal(
         "Node ", node->name(), " [", node->type_string(), "]", " Predicate : ",
-        node_pred_string, "should not be clustered in cluster with predicate ",
-        cluster_pred_string);
+        deadness.GetPredicateString(node_pred),
+        "should not be clustered in cluster with predicate ",
+        deadness.GetPredicateString(cluster_pred));
   }
 
   // If the node has True Pred (T1) and its cluster pred is non-true (P1)
   // Then all outgoing edges from node which are not in the same cluster should
   // be connected to clusters with pred P1
-  if (DeadnessAnalysis::IsTruePredString(node_pred_string) &&
-      !DeadnessAnalysis::IsTruePredString(cluster_pred_string)) {
+  if (IsTruePred(node_pred) && !IsTruePred(cluster_pred)) {
     for (auto e : node->out_edges()) {
-      Node* e_dst = e->dst();
-      if (cluster_map.at(e_dst)->index != node_cluster_index) {
-        string e_dst_cluster_pred = cluster_map.at(e_dst)->predicate_string;
-        if (e_dst_cluster_pred != cluster_pred_string) {
-          return errors::Internal(
-              "Node ", node->name(), " [", node->type_string(), "]",
-              " Predicate : ", node_pred_string,
-              " cannot not be clustered in cluster with predicate ",
-              cluster_pred_string,
-              " as it has outgoing edge to a cluster with predicate ",
-              e_dst_cluster_pred);
-        }
+      const auto& e_dst_cluster = cluster_map[e->dst()->id()];
+      if (e_dst_cluster->index != node_cluster_index &&
+          e_dst_cluster->predicate != cluster_pred) {
+        return errors::Internal(
+            "Node ", node->name(), " [", node->type_string(), "]",
+            " Predicate : ", deadness.GetPredicateString(node_pred),
+            " cannot not be clustered in cluster with predicate ",
+            deadness.GetPredicateString(cluster_pred),
+            " as it has outgoing edge to a cluster with predicate ",
+            deadness.GetPredicateString(e_dst_cluster->predicate));
       }
     }
   }
@@ -232,43 +239,49 @@ Status CheckNodeClusterAssignmentWRTDeadness(
 
 // Merges src and dst clusters of the edge
 // This function does not do any checks for merging, but rather implements the
-// merge, i.e. updates the properties of the merged cluster
+// merge, i.e. updates the properties of the merged cluster. The merged cluster
+// keeps the index of the src cluster, the nodes of the smaller of the two
+// clusters being moved to the larger one. Returns whether the predicate of
+// the merged cluster differs from the one of either cluster.
 // WARNING : Use this function when ready to merge
-void MergeClusters(Edge* edge,
-                   std::map<Node*, std::shared_ptr<Cluster>>& cluster_map) {
+bool MergeClusters(const Edge* edge, ClusterMap& cluster_map,
+                   const DeadnessAnalysis& deadness) {
   Node* src = edge->src();
   Node* dst = edge->dst();
-  int src_index = cluster_map[src]->index;
-  int dst_index = cluster_map[dst]->index;
+  auto src_cluster = cluster_map[src->id()];
+  auto dst_cluster = cluster_map[dst->id()];
 
   // Merge dst cluster into src cluster
   OVTF_VLOG(5) << "Contracting: " << src->name() << "[" << src->type_string()
-               << " , " << edge->src_output() << "]@" << src_index << " -> "
-               << dst->name() << "[" << dst->type_string() << " , "
-               << edge->dst_input() << "]@" << dst_index;
-
-  string src_predicate = cluster_map[src]->predicate_string;
-  string dst_predicate = cluster_map[dst]->predicate_string;
-  OVTF_VLOG(5) << "Src pred: " << src_predicate
-               << ", Dst pred: " << dst_predicate;
-
-  std::string cluster_pred = GetMergedClusterPred(src_predicate, dst_predicate);
-
-  cluster_map[src]->predicate_string = cluster_pred;
+               << " , " << edge->src_output() << "]@" << src_cluster->index
+               << " -> " << dst->name() << "[" << dst->type_string() << " , "
+               << edge->dst_input() << "]@" << dst_cluster->index;
+  OVTF_VLOG(5) << "Src pred: "
+               << deadness.GetPredicateString(src_cluster->predicate)
+               << ", Dst pred: "
+               << deadness.GetPredicateString(dst_cluster->predicate);
+
+  int index = src_cluster->index;
+  int cluster_pred = GetMergedClusterPred(src_cluster->predicate,
+                                          dst_cluster->predicate);
+  bool predicate_changed = src_cluster->predicate != dst_cluster->predicate;
+
+  auto merged = src_cluster;
+  auto absorbed = dst_cluster;
+  if (merged->nodes.size() < absorbed->nodes.size()) {
+    std::swap(merged, absorbed);
+  }
+  merged->index = index;
+  merged->predicate = cluster_pred;
   // Update outgoing edges of the merged cluster
-  cluster_map[src]->outgoing_edges.insert(
-      cluster_map[dst]->outgoing_edges.begin(),
-      cluster_map[dst]->outgoing_edges.end());
-  cluster_map[src]->outgoing_edges.erase(edge);
-
-  auto cluster_dst = cluster_map[dst];
-  // using cluster_map[dst]->nodes in the loop directly appears to
-  // invalidate the iterator when `node` == `dst`
-  // this happens with clang but not gcc
-  for (auto node : cluster_dst->nodes) {
-    cluster_map[src]->nodes.insert(node);
-    cluster_map[node] = cluster_map[src];
+  merged->outgoing_edges.insert(merged->outgoing_edges.end(),
+                                absorbed->outgoing_edges.begin(),
+                                absorbed->outgoing_edges.end());
+  for (auto node : absorbed->nodes) {
+    merged->nodes.push_back(node);
+    cluster_map[node->id()] = merged;
   }
+  return predicate_changed;
 }
 
 }  // namespace
@@ -277,34 +290,36 @@ void MergeClusters(Edge* edge,
 // Adds an attribute "_ovtf_cluster" (cluster_id) to each Node that can be
 // encapsulated
 Status AssignClusters(Graph* graph) {
-  std::map<Node*, std::shared_ptr<Cluster>> cluster_map;
+  ClusterMap cluster_map(graph->num_node_ids());
 
   std::unique_ptr<DeadnessAnalysis> deadness_analyzer;
   TF_RETURN_IF_ERROR(DeadnessAnalysis::Run(*graph, &deadness_analyzer));
-  // This map is used only for error checking
-  std::map<Node*, std::string> nodes_predicate_map;
+  const DeadnessAnalysis& deadness = *deadness_analyzer;
+  // The predicate of every node, by node id. Used only for error checking
+  std::vector<int> nodes_predicate_map(graph->num_node_ids());
 
   GraphCycles gc;
 
   // Initial Step: Each node is a cluster of its own
   for (auto node : graph->nodes()) {
     int new_index = gc.NewNode();
-    cluster_map[node] = std::make_shared<Cluster>();
-    cluster_map[node]->index = new_index;
-    cluster_map[node]->nodes.insert(node);
+    auto& cluster = cluster_map[node->id()];
+    cluster = std::make_shared<Cluster>();
+    cluster->index = new_index;
+    cluster->nodes.push_back(node);
     OVTF_VLOG(5) << "Creating graphcycle Node: " << new_index << " for "
                  << node->name() << "[" << node->type_string() << "]";
 
-    // get predicate string for the node
-    string pred_string;
-    TF_RETURN_IF_ERROR(deadness_analyzer->GetNodePredicate(*node, pred_string));
-    nodes_predicate_map[node] = pred_string;
-    cluster_map[node]->predicate_string = pred_string;
+    // get the interned predicate of the node
+    int predicate;
+    TF_RETURN_IF_ERROR(deadness_analyzer->GetNodePredicateId(*node, predicate));
+    nodes_predicate_map[node->id()] = predicate;
+    cluster->predicate = predicate;
 
-    cluster_map[node]->outgoing_edges = std::set<const Edge*>(
-        node->out_edges().begin(), node->out_edges().end());
+    cluster->outgoing_edges.assign(node->out_edges().begin(),
+                                   node->out_edges().end());
     OVTF_VLOG(5) << node->name() << "[" << node->type_string() << "]"
-                 << "  : Predicate " << pred_string;
+                 << "  : Predicate " << deadness.GetPredicateString(predicate);
   }
 
   // Check for existing cyclicity in the graph
@@ -322,7 +337,8 @@ Status AssignClusters(Graph* graph) {
       continue;
     }
 
-    if (!gc.InsertEdge(cluster_map[src]->index, cluster_map[dst]->index)) {
+    if (!gc.InsertEdge(cluster_map[src->id()]->index,
+                       cluster_map[dst->id()]->index)) {
       OVTF_VLOG(5) << "Failing due to cycle";
       return errors::Unimplemented(
           "Input graph has a cycle (inserting an edge from ",
@@ -368,9 +384,9 @@ Status AssignClusters(Graph* graph) {
         if (static_edge->src()->type_string() != "Const") {
           int shadow_node_index = gc.NewNode();
           bool gc_success = gc.InsertEdge(
-              cluster_map[static_edge->src()]->index, shadow_node_index);
-          gc_success &= gc.InsertEdge(shadow_node_index,
-                                      cluster_map[static_edge->dst()]->index);
+              cluster_map[static_edge->src()->id()]->index, shadow_node_index);
+          gc_success &= gc.InsertEdge(
+              shadow_node_index, cluster_map[static_edge->dst()->id()]->index);
           if (!gc_success)
             return errors::Internal(
                 "Unable to create shadow edges in GraphCycles");
@@ -380,8 +396,6 @@ Status AssignClusters(Graph* graph) {
   }
 
   OVTF_VLOG(2) << "Starting contraction";
-  bool changed;
-  bool collect_non_contracting_edge_info = false;  // Must init with false
 
   // 6 exhaustive reasons why edges might non contract
   // The reasons are not mutually exclusive, but there is an order of priority
@@ -392,25 +406,21 @@ Status AssignClusters(Graph* graph) {
     DEADNESS,     // deadness criteria not met
     SAMECLUSTER,  // both ends lie in the same cluster
     STATICINPUT,  // static input in dst (not fed by const)
-    PATHEXISTS    // base case reason. contraction causes cycles
+    PATHEXISTS,   // base case reason. contraction causes cycles
+    CONTRACTED    // not a reason, the edge was contracted
   };
   static std::vector<string> reason_string(  // to convert the enum to string
       {"NOTANOP", "UNSUPPORTED", "DEADNESS", "SAMECLUSTER", "STATICINPUT",
        "PATHEXISTS"});
-  // a cluster pair is the string "cluster1_id, cluster2_id"
-  // Using string, because a pair won't hash unless implemented
+  // a cluster pair is (cluster1_id, cluster2_id)
   // Note that we store a vector of "reasons", because there could be multiple
   // reasons
-  using ClusterPairToReason =
-      std::unordered_map<std::string, std::vector<EdgeNonContractionReasons>>;
-  ClusterPairToReason cluster_separation_reason;
-  auto get_string_key = [](int x, int y) {
-    return to_string(x) + "," + to_string(y);
-  };
+  using ClusterPair = std::pair<int, int>;
+  std::map<ClusterPair, std::vector<EdgeNonContractionReasons>>
+      cluster_separation_reason;
   // (src id, dst id) -> (src predicate, dst predicate, other neighbours
   // predicates)
-  std::unordered_map<std::string, tuple<string, string, vector<string>>>
-      deadness_info;
+  std::map<ClusterPair, tuple<string, string, vector<string>>> deadness_info;
 
   string device;
   BackendManager::GetBackendName(device);
@@ -437,8 +447,8 @@ Status AssignClusters(Graph* graph) {
         continue;
       }
       bool is_deadness_ok = false;
-      TF_RETURN_IF_ERROR(
-          CanContractEdgeDeadnessCheck(edge, cluster_map, is_deadness_ok));
+      TF_RETURN_IF_ERROR(CanContractEdgeDeadnessCheck(
+          edge, cluster_map, is_deadness_ok));
       if (!is_deadness_ok) {
         if (src->type_string() == "Const" && dst->type_string() == "Sub") {
           dst->ClearAttr("_ovtf_marked_for_clustering");
@@ -448,8 +458,8 @@ Status AssignClusters(Graph* graph) {
         }
         continue;
       }
-      int src_index = cluster_map[src]->index;
-      int dst_index = cluster_map[dst]->index;
+      int src_index = cluster_map[src->id()]->index;
+      int dst_index = cluster_map[dst->id()]->index;
       if (!(gc.HasEdge(src_index, dst_index) &&
             gc.CanContractEdge(src_index, dst_index))) {
         if (src->type_string() == "Const" && dst->type_string() == "Sub") {
@@ -478,16 +488,16 @@ Status AssignClusters(Graph* graph) {
         continue;
       }
       bool is_deadness_ok = false;
-      TF_RETURN_IF_ERROR(
-          CanContractEdgeDeadnessCheck(edge, cluster_map, is_deadness_ok));
+      TF_RETURN_IF_ERROR(CanContractEdgeDeadnessCheck(
+          edge, cluster_map, is_deadness_ok));
       if (!is_deadness_ok) {
         if (src->type_string() == "Greater") {
           src->ClearAttr("_ovtf_marked_for_clustering");
         }
         continue;
       }
-      int src_index = cluster_map[src]->index;
-      int dst_index = cluster_map[dst]->index;
+      int src_index = cluster_map[src->id()]->index;
+      int dst_index = cluster_map[dst->id()]->index;
       if (!(gc.HasEdge(src_index, dst_index) &&
             gc.CanContractEdge(src_index, dst_index))) {
         if (src->type_string() == "Greater") {
@@ -497,133 +507,175 @@ Status AssignClusters(Graph* graph) {
     }
   }
 
-  do {
-    changed = false;
-
-    auto log_reason = [](EdgeNonContractionReasons reason, Edge* edge) {
-      OVTF_VLOG(0) << "NONCONTRACTION: " << reason_string[reason] << ": "
-                   << edge->src()->name() << "<" << edge->src()->type_string()
-                   << ">"
-                   << "[" << edge->src_output() << "] -> "
-                   << edge->dst()->name() << "<" << edge->dst()->type_string()
-                   << ">"
-                   << "[" << edge->dst_input() << "]";
-    };
-
-    for (auto edge : graph->edges()) {
-      Node* src = edge->src();
-      Node* dst = edge->dst();
-
-      int src_index = cluster_map[src]->index;
-      int dst_index = cluster_map[dst]->index;
+  auto log_reason = [](EdgeNonContractionReasons reason, const Edge* edge) {
+    OVTF_VLOG(0) << "NONCONTRACTION: " << reason_string[reason] << ": "
+                 << edge->src()->name() << "<" << edge->src()->type_string()
+                 << ">"
+                 << "[" << edge->src_output() << "] -> " << edge->dst()->name()
+                 << "<" << edge->dst()->type_string() << ">"
+                 << "[" << edge->dst_input() << "]";
+  };
 
-      if (!src->IsOp() || !dst->IsOp()) {
-        if (collect_non_contracting_edge_info) {
-          log_reason(EdgeNonContractionReasons::NOTANOP, edge);
-          cluster_separation_reason[get_string_key(src_index, dst_index)]
-              .push_back(EdgeNonContractionReasons::NOTANOP);
-        }
-        continue;
-      }
+  // Contracts edge if possible, else sets reason to why it was not. If
+  // collect_non_contracting_edge_info is set, the reason is logged and
+  // recorded for the placement summary. predicate_changed is set when the
+  // predicate of the merged cluster differs from the one of either cluster.
+  auto contract_edge = [&](const Edge* edge,
+                           bool collect_non_contracting_edge_info,
+                           EdgeNonContractionReasons& reason,
+                           bool& predicate_changed) -> Status {
+    Node* src = edge->src();
+    Node* dst = edge->dst();
 
-      if (!NodeIsMarkedForClustering(src) || !NodeIsMarkedForClustering(dst)) {
-        OVTF_VLOG(5) << "Skipping (not marked): " << src->name() << "["
-                     << edge->src_output() << "]@" << src_index << " -> "
-                     << dst->name() << "[" << edge->dst_input() << "]@"
-                     << dst_index;
-        if (collect_non_contracting_edge_info) {
-          log_reason(EdgeNonContractionReasons::UNSUPPORTED, edge);
-          cluster_separation_reason[get_string_key(src_index, dst_index)]
-              .push_back(EdgeNonContractionReasons::UNSUPPORTED);
-        }
-        continue;
-      }
+    int src_index = cluster_map[src->id()]->index;
+    int dst_index = cluster_map[dst->id()]->index;
+    ClusterPair key(src_index, dst_index);
+    predicate_changed = false;
 
+    if (!src->IsOp() || !dst->IsOp()) {
+      reason = EdgeNonContractionReasons::NOTANOP;
+    } else if (!NodeIsMarkedForClustering(src) ||
+               !NodeIsMarkedForClustering(dst)) {
+      OVTF_VLOG(5) << "Skipping (not marked): " << src->name() << "["
+                   << edge->src_output() << "]@" << src_index << " -> "
+                   << dst->name() << "[" << edge->dst_input() << "]@"
+                   << dst_index;
+      reason = EdgeNonContractionReasons::UNSUPPORTED;
+    } else {
       // check if the edge can be contracted with respect to deadness
       bool is_deadness_ok = false;
-      TF_RETURN_IF_ERROR(
-          CanContractEdgeDeadnessCheck(edge, cluster_map, is_deadness_ok));
+      TF_RETURN_IF_ERROR(CanContractEdgeDeadnessCheck(
+          edge, cluster_map, is_deadness_ok));
       if (!is_deadness_ok) {
         // do not contract, src and dst node cannot be in the same cluster
         OVTF_VLOG(5) << "Skipping (deadness not ok): " << src->name() << "["
                      << edge->src_output() << "]@" << src_index << " -> "
                      << dst->name() << "[" << edge->dst_input() << "]@"
                      << dst_index;
+        reason = EdgeNonContractionReasons::DEADNESS;
         if (collect_non_contracting_edge_info) {
-          log_reason(EdgeNonContractionReasons::DEADNESS, edge);
-          cluster_separation_reason[get_string_key(src_index, dst_index)]
-              .push_back(EdgeNonContractionReasons::DEADNESS);
-
-          auto src_cluster = cluster_map[src];
-          auto dst_cluster = cluster_map[dst];
+          const auto& src_cluster = cluster_map[src->id()];
           vector<string> neighbours_predicate;
           // Collect predicates of src's neighbours (except dst)
           for (const Edge* src_cluster_edge : src_cluster->outgoing_edges) {
             if (src_cluster_edge != edge) {
-              neighbours_predicate.push_back(
-                  cluster_map[src_cluster_edge->dst()]->predicate_string);
+              neighbours_predicate.push_back(deadness.GetPredicateString(
+                  cluster_map[src_cluster_edge->dst()->id()]->predicate));
             }
           }
-          deadness_info[get_string_key(src_index, dst_index)] = make_tuple(
-              cluster_map.at(src)->predicate_string,
-              cluster_map.at(dst)->predicate_string, neighbours_predicate);
+          deadness_info[key] =
+              make_tuple(deadness.GetPredicateString(src_cluster->predicate),
+                         deadness.GetPredicateString(
+                             cluster_map[dst->id()]->predicate),
+                         neighbours_predicate);
         }
-        continue;
-      }
-
-      // Check if contracting the edge will lead to cycles
-      // if not, MergeClusters
-      if (gc.HasEdge(src_index, dst_index) &&
-          gc.ContractEdge(src_index, dst_index)) {
-        MergeClusters(edge, cluster_map);
-        // something changed
-        changed = true;
+      } else if (gc.HasEdge(src_index, dst_index) &&
+                 gc.ContractEdge(src_index, dst_index)) {
+        // Contracting the edge does not lead to cycles
+        predicate_changed = MergeClusters(edge, cluster_map, deadness);
+        reason = EdgeNonContractionReasons::CONTRACTED;
+        return Status::OK();
       } else {
-        if (collect_non_contracting_edge_info) {
-          // either static input
-          // or there exists a longer path, so contracting this edge causes
-          // cycles
-          std::vector<int32> static_inputs;
-          GetStaticInputs(dst, &static_inputs);
-          bool is_static = std::find(static_inputs.begin(), static_inputs.end(),
-                                     edge->dst_input()) != static_inputs.end();
-          bool is_not_const = src->type_string() != "Const";
-          // 3 possible reasons here:
-          // src dst lies in same cluster, so nothing to do (trivial cycle
-          // induced in graphcycles)
-          // dst has static input
-          // a longer irreducible path exists
-          auto reason = (src_index == dst_index
-                             ? EdgeNonContractionReasons::SAMECLUSTER
-                             : ((is_not_const && is_static)
-                                    ? EdgeNonContractionReasons::STATICINPUT
-                                    : EdgeNonContractionReasons::PATHEXISTS));
-          log_reason(reason, edge);
-          cluster_separation_reason[get_string_key(src_index, dst_index)]
-              .push_back(reason);
-        }
+        // either static input
+        // or there exists a longer path, so contracting this edge causes
+        // cycles
+        std::vector<int32> static_inputs;
+        GetStaticInputs(dst, &static_inputs);
+        bool is_static = std::find(static_inputs.begin(), static_inputs.end(),
+                                   edge->dst_input()) != static_inputs.end();
+        bool is_not_const = src->type_string() != "Const";
+        // 3 possible reasons here:
+        // src dst lies in same cluster, so nothing to do (trivial cycle
+        // induced in graphcycles)
+        // dst has static input
+        // a longer irreducible path exists
+        reason = (src_index == dst_index
+                      ? EdgeNonContractionReasons::SAMECLUSTER
+                      : ((is_not_const && is_static)
+                             ? EdgeNonContractionReasons::STATICINPUT
+                             : EdgeNonContractionReasons::PATHEXISTS));
       }
     }
+    if (collect_non_contracting_edge_info) {
+      log_reason(reason, edge);
+      cluster_separation_reason[key].push_back(reason);
+    }
+    return Status::OK();
+  };
 
-    if (!changed && api::IsLoggingPlacement()) {
-      // This will be entered only once if logging is enabled
-      // When entered, it will force the do-while to run one last time,
-      // collecting information
-      if (!collect_non_contracting_edge_info) {
-        changed = true;
-        collect_non_contracting_edge_info = true;
+  // The edges are contracted from a worklist. An edge which can not be
+  // contracted because of a path between its clusters, or because of their
+  // predicates, waits on its clusters: it is only attempted again once one
+  // of them is merged. The edges which failed on deadness are also attempted
+  // again whenever a merge changes the predicate of a cluster, which changes
+  // the predicates seen by the neighbours of the cluster. The other edges
+  // can never be contracted.
+  std::deque<const Edge*> worklist;
+  std::vector<bool> queued(graph->num_edge_ids(), false);
+  auto enqueue = [&worklist, &queued](const Edge* edge) {
+    if (!queued[edge->id()]) {
+      queued[edge->id()] = true;
+      worklist.push_back(edge);
+    }
+  };
+  for (auto edge : graph->edges()) {
+    enqueue(edge);
+  }
+  // The edges waiting on each cluster, by cluster index
+  std::unordered_map<int, std::vector<const Edge*>> waiting_edges;
+  std::vector<const Edge*> waiting_on_predicates;
+  auto wake_edges = [&waiting_edges, &enqueue](int cluster_index) {
+    auto it = waiting_edges.find(cluster_index);
+    if (it == waiting_edges.end()) return;
+    for (auto edge : it->second) enqueue(edge);
+    waiting_edges.erase(it);
+  };
+
+  while (!worklist.empty()) {
+    const Edge* edge = worklist.front();
+    worklist.pop_front();
+    queued[edge->id()] = false;
+
+    int src_index = cluster_map[edge->src()->id()]->index;
+    int dst_index = cluster_map[edge->dst()->id()]->index;
+    EdgeNonContractionReasons reason;
+    bool predicate_changed;
+    TF_RETURN_IF_ERROR(contract_edge(edge, false, reason, predicate_changed));
+
+    if (reason == EdgeNonContractionReasons::CONTRACTED) {
+      wake_edges(src_index);
+      wake_edges(dst_index);
+      if (predicate_changed) {
+        for (auto waiting : waiting_on_predicates) enqueue(waiting);
+        waiting_on_predicates.clear();
+      }
+    } else if (reason == EdgeNonContractionReasons::DEADNESS ||
+               reason == EdgeNonContractionReasons::PATHEXISTS) {
+      waiting_edges[src_index].push_back(edge);
+      waiting_edges[dst_index].push_back(edge);
+      if (reason == EdgeNonContractionReasons::DEADNESS) {
+        waiting_on_predicates.push_back(edge);
       }
     }
-  } while (changed);
+  }
 
+  if (api::IsLoggingPlacement()) {
+    // One last pass collecting why every edge was not contracted
+    for (auto edge : graph->edges()) {
+      EdgeNonContractionReasons reason;
+      bool predicate_changed;
+      TF_RETURN_IF_ERROR(contract_edge(edge, true, reason, predicate_changed));
+    }
+  }
   OVTF_VLOG(2) << "Contraction done";
 
   OVTF_VLOG(2) << "Starting tagging";
   std::set<Cluster*> seen;
   unordered_map<int, int> cluster_to_encapsulate;
-  for (auto kv : cluster_map) {
-    auto cluster = kv.second.get();
-    if (seen.count(cluster) != 0) {
+  for (const auto& node_cluster : cluster_map) {
+    auto cluster = node_cluster.get();
+    // The ids of the removed nodes have no cluster
+    if (cluster == nullptr || seen.count(cluster) != 0) {
       continue;
     }
 
@@ -636,7 +688,7 @@ Status AssignClusters(Graph* graph) {
 
         // Some sanity checks for deadness
         TF_RETURN_IF_ERROR(CheckNodeClusterAssignmentWRTDeadness(
-            node, nodes_predicate_map, cluster_map));
+            node, nodes_predicate_map, cluster_map, deadness));
       } else {
         has_non_ovtf_ops = true;
       }
@@ -711,15 +763,14 @@ Status AssignClusters(Graph* graph) {
            "assigned an encapsulate)\n";
     for (auto it : cluster_separation_reason) {
       num_non_contracted += it.second.size();
-      auto cluster_id_vector = ngraph::split(it.first, ',');
       // function to find if this cluster became an ovtf_cluster
       // returns ovtf_cluster id if yes, else returns -1
-      auto find_in_map = [&cluster_to_encapsulate, &cluster_id_vector](int x) {
-        auto itr = cluster_to_encapsulate.find(stoi(cluster_id_vector[x]));
+      auto find_in_map = [&cluster_to_encapsulate](int cluster_id) {
+        auto itr = cluster_to_encapsulate.find(cluster_id);
         return itr == cluster_to_encapsulate.end() ? -1 : itr->second;
       };
-      int src_encapsulate = find_in_map(0);
-      int dst_encapsulate = find_in_map(1);
+      int src_encapsulate = find_in_map(it.first.first);
+      int dst_encapsulate = find_in_map(it.first.second);
       bool both_src_dst_are_encapsulates =
           src_encapsulate >= 0 && dst_encapsulate >= 0;
       bool src_dst_are_distinct = src_encapsulate != dst_encapsulate;
@@ -6,8 +6,16 @@
 
 #include "backend.h"
 
+#include <mutex>
+
+#include "tensorflow/core/lib/core/errors.h"
+
 #include "contexts.h"
+#include "logging/ovtf_log.h"
 #include "openvino/opsets/opset.hpp"
+#include "openvino_tensorflow/model_cache.h"
+#include "openvino_tensorflow/op_support.h"
+#include "openvino_tensorflow/ovtf_utils.h"
 
 using namespace std;
 
@@ -16,14 +24,105 @@ namespace openvino_tensorflow {
 
 static unique_ptr<GlobalContext> g_global_context;
 
+// The devices of each plugin and of all of them, listed once. They outlive
+// the global context, which is released with the backend.
+static mutex g_devices_mutex;
+static map<string, vector<string>> g_plugin_devices;
+static unique_ptr<vector<string>> g_all_devices;
+
+vector<string> Backend::GetAvailableDevices(const string& plugin) {
+  lock_guard<mutex> lock(g_devices_mutex);
+  auto it = g_plugin_devices.find(plugin);
+  if (it != g_plugin_devices.end()) return it->second;
+  vector<string> devices;
+  if (g_all_devices) {
+    for (const auto& dev : *g_all_devices) {
+      if (dev == plugin || dev.compare(0, plugin.size() + 1, plugin + ".") == 0)
+        devices.push_back(dev);
+    }
+  } else {
+    // Only loads the plugin of the device
+    vector<string> ids;
+    try {
+      ids = GetGlobalContext().ie_core.get_property(plugin,
+                                                    ov::available_devices);
+    } catch (const std::exception& e) {
+      OVTF_VLOG(1) << "Device " << plugin << " not available: " << e.what();
+    }
+    // Named as ov::Core::get_available_devices names them, the devices are
+    // only numbered when there are several of them
+    if (ids.size() > 1) {
+      for (const auto& id : ids) devices.push_back(plugin + "." + id);
+    } else if (!ids.empty()) {
+      devices.push_back(plugin);
+    }
+  }
+  OVTF_VLOG(1) << "Found " << devices.size() << " " << plugin << " devices";
+  g_plugin_devices[plugin] = devices;
+  return devices;
+}
+
+vector<string> Backend::GetAllAvailableDevices() {
+  lock_guard<mutex> lock(g_devices_mutex);
+  if (!g_all_devices) {
+    g_all_devices.reset(
+        new vector<string>(GetGlobalContext().ie_core.get_available_devices()));
+  }
+  return *g_all_devices;
+}
+
+string Backend::GetMultiDeviceName(const string& config) {
+  for (const string& name : {"MULTI", "HETERO", "AUTO"}) {
+    if (config == name || config.rfind(name + ":", 0) == 0) return name;
+  }
+  return "";
+}
+
 Backend::Backend(const string& config) {
+  string multi_device = GetMultiDeviceName(config);
+  if (!multi_device.empty()) {
+    // The devices are listed in priority order after the colon, each may be
+    // followed by a number of requests in parentheses for MULTI
+    size_t colon = config.find(":");
+    string device_list = colon == string::npos ? "" : config.substr(colon + 1);
+    stringstream ss(device_list);
+    string item;
+    while (getline(ss, item, ',')) {
+      item = item.substr(0, item.find("("));
+      if (item.empty()) continue;
+      bool found = false;
+      auto devices = GetAvailableDevices(item.substr(0, item.find(".")));
+      for (const auto& dev : devices) {
+        found |= dev == item || (item == "MYRIAD" && dev.find(item) == 0);
+      }
+      if (!found) {
+        throw runtime_error("Device '" + item + "' of '" + config +
+                            "' not found.");
+      }
+      m_devices.push_back(item);
+    }
+    if (m_devices.empty()) {
+      if (multi_device != "AUTO") {
+        throw runtime_error("Device '" + config +
+                            "' needs a list of devices, e.g. " +
+                            multi_device + ":GPU,CPU");
+      }
+      // AUTO selects among all the available devices
+      m_devices = GetAllAvailableDevices();
+    }
+    m_device = multi_device;
+    m_device_type = config;
+    return;
+  }
+
   string device = config.substr(0, config.find("_"));
   string prec = "";
   if (config.find("_") != string::npos)
     prec = config.substr(config.find("_") + 1);
-  ov::Core core;
-  auto devices = core.get_available_devices();
-  // TODO: Handle multiple devices
+  // The devices of a kind are numbered when there are several of them,
+  // e.g. GPU.0 and GPU.1, the kind alone is the first one
+  string family = device.substr(0, device.find("."));
+  auto devices = GetAvailableDevices(family);
 
   bool dev_found = false;
   if (find(devices.begin(), devices.end(), device) == devices.end()) {
@@ -31,6 +130,10 @@ Backend::Backend(const string& config) {
       for (auto dev : devices) {
         if (dev.find(device) != std::string::npos) dev_found = true;
       }
+    } else if (device == "GPU") {
+      for (auto dev : devices) {
+        if (dev.compare(0, 4, "GPU.") == 0) dev_found = true;
+      }
     }
   } else {
     dev_found = true;
@@ -42,7 +145,7 @@ Backend::Backend(const string& config) {
     throw runtime_error(ss.str());
   }
 
-  if (device == "GPU" && prec != "" && prec != "FP16") {
+  if (family == "GPU" && prec != "" && prec != "FP16") {
     stringstream ss;
     if (prec == "FP32") {
       ss << "'GPU_FP32' is not a supported device name."
@@ -52,7 +155,23 @@ Backend::Backend(const string& config) {
       ss << "The precision '" << prec << "' is not supported on 'GPU'.";
       throw runtime_error(ss.str());
     }
-  } else if (device != "GPU" && prec != "") {
+  } else if (device == "CPU" && prec != "") {
+    // The CPU plugin only runs in BF16 or FP16 on CPUs with native support
+    // for it, e.g. AVX512-BF16 or AMX
+    if (prec != "BF16" && prec != "FP16") {
+      stringstream ss;
+      ss << "The precision '" << prec << "' is not supported on 'CPU'.";
+      throw runtime_error(ss.str());
+    }
+    auto capabilities = GetGlobalContext().ie_core.get_property(
+        "CPU", ov::device::capabilities);
+    if (find(capabilities.begin(), capabilities.end(), prec) ==
+        capabilities.end()) {
+      stringstream ss;
+      ss << "The CPU of this machine does not support '" << config << "'.";
+      throw runtime_error(ss.str());
+    }
+  } else if (family != "GPU" && prec != "") {
     stringstream ss;
     ss << "Device '" << device << "' does not support custom precisions.";
     throw runtime_error(ss.str());
@@ -64,28 +183,153 @@ Backend::Backend(const string& config) {
   } else {
     m_device = device;
   }
+  m_devices.push_back(m_device);
 }
 
-shared_ptr<Executable> Backend::Compile(shared_ptr<ov::Model> func, bool) {
-  return make_shared<Executable>(func, m_device, m_device_type);
+shared_ptr<Executable> Backend::Compile(shared_ptr<ov::Model> func,
+                                        const ov::AnyMap& compile_config) {
+  return make_shared<Executable>(func, m_device, m_device_type,
+                                 compile_config);
 }
 
 GlobalContext& Backend::GetGlobalContext() {
-  if (!g_global_context)
+  if (!g_global_context) {
     g_global_context = unique_ptr<GlobalContext>(new GlobalContext);
+    ModelCache::Configure(g_global_context->ie_core);
+  }
   return *g_global_context;
 }
 
 void Backend::ReleaseGlobalContext() { g_global_context.reset(); }
 
+shared_ptr<ov::RemoteContext> Backend::GetGPUContext() {
+  GlobalContext& global = GetGlobalContext();
+  std::call_once(global.gpu_context_once, [&global]() {
+    try {
+      global.gpu_context = make_shared<ov::RemoteContext>(
+          global.ie_core.get_default_context("GPU"));
+    } catch (const std::exception& e) {
+      OVTF_VLOG(1) << "GPU context not available: " << e.what();
+    }
+  });
+  return global.gpu_context;
+}
+
 std::string Backend::GetDeviceType() { return m_device_type; }
 
+const vector<string>& Backend::GetGPUReplicas(const string& device) {
+  static const vector<string>* s_replicas = []() {
+    vector<string>* replicas = new vector<string>();
+    string env = util::GetEnv("OPENVINO_TF_GPU_REPLICAS");
+    if (env.empty() || env == "0") return replicas;
+    vector<string> gpus = GetAvailableDevices("GPU");
+    if (env == "1") {
+      *replicas = gpus;
+    } else {
+      // A list of GPUs, e.g. "GPU.0,GPU.2"
+      stringstream ss(env);
+      string item;
+      while (getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        if (find(gpus.begin(), gpus.end(), item) == gpus.end()) {
+          OVTF_VLOG(0) << "Ignoring the GPU replica " << item
+                       << ", the device was not found";
+        } else if (find(replicas->begin(), replicas->end(), item) ==
+                   replicas->end()) {
+          replicas->push_back(item);
+        }
+      }
+    }
+    if (replicas->size() < 2) replicas->clear();
+    OVTF_VLOG(1) << "Replicating the GPU clusters on " << replicas->size()
+                 << " GPUs";
+    return replicas;
+  }();
+  static const vector<string> s_none;
+  return device == "GPU" ? *s_replicas : s_none;
+}
+
+const vector<string>& Backend::GetMyriadReplicas(const string& device) {
+  static const vector<string>* s_replicas = []() {
+    vector<string>* replicas = new vector<string>();
+    string env = util::GetEnv("OPENVINO_TF_MYRIAD_REPLICAS");
+    if (env == "0") return replicas;
+    vector<string> sticks = GetAvailableDevices("MYRIAD");
+    if (env.empty() || env == "1") {
+      *replicas = sticks;
+    } else {
+      // A list of sticks, e.g. "MYRIAD.1.1-ma2480,MYRIAD.1.2-ma2480"
+      stringstream ss(env);
+      string item;
+      while (getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        if (find(sticks.begin(), sticks.end(), item) == sticks.end()) {
+          OVTF_VLOG(0) << "Ignoring the MYRIAD replica " << item
+                       << ", the device was not found";
+        } else if (find(replicas->begin(), replicas->end(), item) ==
+                   replicas->end()) {
+          replicas->push_back(item);
+        }
+      }
+    }
+    if (replicas->size() < 2) replicas->clear();
+    OVTF_VLOG(1) << "Replicating the MYRIAD clusters on " << replicas->size()
+                 << " VPUs";
+    return replicas;
+  }();
+  static const vector<string> s_none;
+  return device == "MYRIAD" ? *s_replicas : s_none;
+}
+
+bool Backend::IsGPUFP16(const string& device_type) {
+  const string suffix = "_FP16";
+  return device_type.compare(0, 3, "GPU") == 0 &&
+         device_type.size() > suffix.size() &&
+         device_type.compare(device_type.size() - suffix.size(),
+                             suffix.size(), suffix) == 0;
+}
+
+const vector<string>& Backend::GetDevices() const { return m_devices; }
+
+bool Backend::RequiresAllDevices() const { return m_device != "HETERO"; }
+
 bool Backend::IsSupported(const ov::Node& node) const {
-  // TODO: check if the given backend/device supports the op. Right now we're
-  // assuming
-  // that the selected backend supports all opset7 ops
-  const auto& opset = ov::get_opset7();
-  return opset.contains_op_type(&node);
+  // The ops of the opsets the translation emits, unless the devices reported
+  // they do not support them
+  if (!ov::get_opset7().contains_op_type(&node) &&
+      !ov::get_opset8().contains_op_type(&node)) {
+    return false;
+  }
+  string signature = OpSupport::Signature(node);
+  size_t unsupported = 0;
+  for (const auto& device : m_devices) {
+    bool supported;
+    if (OpSupport::IsKnown(device, signature, supported) && !supported) {
+      unsupported++;
+    }
+  }
+  return RequiresAllDevices() ? unsupported == 0
+                              : unsupported < m_devices.size();
+}
+
+Status Backend::QueryUnsupportedOps(
+    const shared_ptr<ov::Model>& func,
+    map<shared_ptr<ov::Node>, vector<string>>& unsupported) {
+  unsupported.clear();
+  map<shared_ptr<ov::Node>, vector<string>> devices_of;
+  for (const auto& device : m_devices) {
+    vector<shared_ptr<ov::Node>> ops;
+    TF_RETURN_IF_ERROR(OpSupport::QueryModel(GetGlobalContext().ie_core, func,
+                                             device, ops));
+    for (const auto& op : ops) devices_of[op].push_back(device);
+  }
+  for (const auto& op : devices_of) {
+    // HETERO runs an op on any device which supports it
+    if (RequiresAllDevices() || op.second.size() == m_devices.size()) {
+      unsupported.insert(op);
+    }
+  }
+  return Status::OK();
 }
 
 }  // namespace openvino_tensorflow
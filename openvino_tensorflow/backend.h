@@ -6,8 +6,12 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
+
+#include "tensorflow/core/lib/core/status.h"
 
 #include "openvino/openvino.hpp"
 
@@ -26,23 +30,65 @@ class Backend {
   Backend(const string& configuration_string);
   ~Backend() {
     NGraphClusterManager::EvictAllClusters();
-    if (m_device != "GPU") {
+    if (m_device.compare(0, 3, "GPU") != 0) {
       NGraphClusterManager::EvictMRUClusters();
     }
     ReleaseGlobalContext();
   }
 
-  shared_ptr<Executable> Compile(shared_ptr<ov::Model> func,
-                                 bool enable_performance_data = false);
+  // compile_config holds the OpenVINO properties passed to compile_model
+  shared_ptr<Executable> Compile(
+      shared_ptr<ov::Model> func,
+      const ov::AnyMap& compile_config = ov::AnyMap());
+
+  // The devices of a plugin, e.g. {"GPU.0", "GPU.1"} for "GPU", empty when
+  // it is not available. Only loads that plugin, and lists its devices once.
+  static vector<string> GetAvailableDevices(const string& plugin);
+  // The devices of every plugin, listed once. Loads all the plugins, for
+  // list_backends and AUTO without a list of devices.
+  static vector<string> GetAllAvailableDevices();
 
   static GlobalContext& GetGlobalContext();
   static void ReleaseGlobalContext();
+  // The shared GPU context of the global context, null without a GPU
+  static shared_ptr<ov::RemoteContext> GetGPUContext();
   std::string GetDeviceType();
   bool IsSupported(const ov::Node& node) const;
+  // The ops of func the backend can not run, as reported by query_model on
+  // its devices, with the devices which do not support each of them
+  Status QueryUnsupportedOps(
+      const shared_ptr<ov::Model>& func,
+      map<shared_ptr<ov::Node>, vector<string>>& unsupported);
+
+  // The devices the backend runs on, more than one for MULTI, HETERO and
+  // AUTO, e.g. {"GPU", "CPU"} for "MULTI:GPU,CPU"
+  const vector<string>& GetDevices() const;
+  // Whether an op has to be supported by every device of the backend. A
+  // MULTI or AUTO backend may run a cluster on any of its devices, HETERO
+  // places every op on the first device which supports it.
+  bool RequiresAllDevices() const;
+
+  // "MULTI", "HETERO" or "AUTO" for a multi device configuration, empty
+  // otherwise
+  static string GetMultiDeviceName(const string& config);
+
+  // The GPUs every cluster compiled for device is replicated on with
+  // OPENVINO_TF_GPU_REPLICAS, e.g. {"GPU.0", "GPU.1"}. Empty for another
+  // device than "GPU", and without replication or a second GPU.
+  static const vector<string>& GetGPUReplicas(const string& device);
+  // The MYRIAD devices every cluster compiled for device is replicated on,
+  // all the attached sticks unless OPENVINO_TF_MYRIAD_REPLICAS is 0 or
+  // lists some of them, e.g. {"MYRIAD.1.1-ma2480", "MYRIAD.1.2-ma2480"}.
+  // Empty for another device than "MYRIAD", and with a single stick.
+  static const vector<string>& GetMyriadReplicas(const string& device);
+  // Whether device_type runs on a GPU in fp16, e.g. "GPU_FP16" or
+  // "GPU.1_FP16"
+  static bool IsGPUFP16(const string& device_type);
 
  private:
   string m_device;
   string m_device_type;
+  vector<string> m_devices;
 };
 }  // end namespace openvino_tensorflow
 }
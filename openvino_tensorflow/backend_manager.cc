@@ -14,6 +14,9 @@ namespace openvino_tensorflow {
 
 shared_ptr<Backend> BackendManager::m_backend;
 string BackendManager::m_backend_name;
+map<string, shared_ptr<Backend>> BackendManager::m_placed_backends;
+map<string, pair<shared_ptr<Backend>, string>>
+    BackendManager::m_named_backends;
 mutex BackendManager::m_backend_mutex;
 
 BackendManager::~BackendManager() {
@@ -31,19 +34,71 @@ Status BackendManager::SetBackend(const string& backend_name) {
   }
 
   lock_guard<mutex> lock(m_backend_mutex);
+  m_placed_backends.clear();
   m_backend = backend;
-  if (bname.find("MYRIAD") != string::npos) {
-    m_backend_name = "MYRIAD";
-  } else if (bname.find("GPU") != string::npos) {
-    m_backend_name = "GPU";
-  } else {
-    m_backend_name = bname;
+  m_backend_name = DeviceName(bname);
+  return Status::OK();
+}
+
+string BackendManager::DeviceName(const string& backend_name) {
+  string multi_device = Backend::GetMultiDeviceName(backend_name);
+  if (!multi_device.empty()) {
+    return multi_device;
+  } else if (backend_name.find("MYRIAD") != string::npos) {
+    return "MYRIAD";
+  } else if (backend_name.find("GPU") != string::npos) {
+    return "GPU";
+  } else if (backend_name.find("CPU") != string::npos) {
+    return "CPU";
+  }
+  return backend_name;
+}
+
+const BackendManager::ScopedBackend*& BackendManager::CurrentScope() {
+  static thread_local const ScopedBackend* scope = nullptr;
+  return scope;
+}
+
+BackendManager::ScopedBackend::ScopedBackend(shared_ptr<Backend> backend,
+                                             const string& device_name)
+    : m_backend(std::move(backend)),
+      m_device_name(device_name),
+      m_previous(CurrentScope()) {
+  CurrentScope() = this;
+}
+
+BackendManager::ScopedBackend::~ScopedBackend() {
+  CurrentScope() = m_previous;
+}
+
+Status BackendManager::GetBackend(const string& backend_name,
+                                  shared_ptr<Backend>& backend,
+                                  string& device_name) {
+  {
+    lock_guard<mutex> lock(m_backend_mutex);
+    auto it = m_named_backends.find(backend_name);
+    if (it != m_named_backends.end()) {
+      backend = it->second.first;
+      device_name = it->second.second;
+      return Status::OK();
+    }
   }
+  string bname(backend_name);
+  TF_RETURN_IF_ERROR(NewBackend(backend, bname));
+  device_name = DeviceName(bname);
+  OVTF_VLOG(1) << "BackendManager::GetBackend(" << backend_name << ")";
+  lock_guard<mutex> lock(m_backend_mutex);
+  // Keep the backend of a concurrent first use
+  auto it = m_named_backends.emplace(backend_name,
+                                     make_pair(backend, device_name));
+  backend = it.first->second.first;
   return Status::OK();
 }
 
 shared_ptr<Backend> BackendManager::GetBackend() {
   OVTF_VLOG(2) << "BackendManager::GetBackend()";
+  const ScopedBackend* scope = CurrentScope();
+  if (scope != nullptr) return scope->m_backend;
   if (m_backend == nullptr) {
     auto status = SetBackend();
     if (!status.ok()) {
@@ -57,6 +112,11 @@ shared_ptr<Backend> BackendManager::GetBackend() {
 
 Status BackendManager::GetBackendName(string& backend_name) {
   OVTF_VLOG(2) << "BackendManager::GetBackendName()";
+  const ScopedBackend* scope = CurrentScope();
+  if (scope != nullptr) {
+    backend_name = scope->m_device_name;
+    return Status::OK();
+  }
   if (m_backend == nullptr) {
     auto status = SetBackend();
     if (!status.ok()) {
@@ -70,18 +130,76 @@ Status BackendManager::GetBackendName(string& backend_name) {
   return Status::OK();
 }
 
+Status BackendManager::GetPlacedBackend(const string& device,
+                                        shared_ptr<Backend>& backend) {
+  // Makes sure the current backend exists, placed backends do not outlive
+  // it
+  GetBackend();
+  lock_guard<mutex> lock(m_backend_mutex);
+  auto it = m_placed_backends.find(device);
+  if (it != m_placed_backends.end()) {
+    backend = it->second;
+    return Status::OK();
+  }
+  try {
+    backend = make_shared<Backend>(device);
+  } catch (const std::exception& e) {
+    return errors::Internal("Could not create backend of type ", device,
+                            " for a placed cluster. Got exception: ",
+                            e.what());
+  }
+  OVTF_VLOG(2) << "BackendManager::GetPlacedBackend(): " << device;
+  m_placed_backends[device] = backend;
+  return Status::OK();
+}
+
+Status BackendManager::GetBackendDevices(vector<string>& devices,
+                                         bool& require_all) {
+  string backend_name;
+  TF_RETURN_IF_ERROR(GetBackendName(backend_name));
+  auto backend = GetBackend();
+  devices.clear();
+  require_all = backend->RequiresAllDevices();
+  if (Backend::GetMultiDeviceName(backend_name).empty()) {
+    devices.push_back(backend_name);
+    return Status::OK();
+  }
+  for (string device : backend->GetDevices()) {
+    // The same names as SetBackend gives to single device backends
+    if (device.find("MYRIAD") != string::npos) {
+      device = "MYRIAD";
+    } else if (device.find("GPU") != string::npos) {
+      device = "GPU";
+    }
+    if (find(devices.begin(), devices.end(), device) == devices.end()) {
+      devices.push_back(device);
+    }
+  }
+  return Status::OK();
+}
+
 Status BackendManager::CreateBackend(shared_ptr<Backend>& backend,
                                      string& backend_name) {
   const char* env = std::getenv("OPENVINO_TF_BACKEND");
   // Array should be of max length MYRIAD.
   char backendName[7];
 
-  if (env != nullptr) {
+  if (env != nullptr && !Backend::GetMultiDeviceName(env).empty()) {
+    // Multi device configurations list their devices
+    backend_name = env;
+  } else if (env != nullptr && std::string(env).find("MYRIAD") == 0) {
     strncpy((char*)backendName, env, sizeof(backendName));
     backendName[6] = '\0';  // null terminate to remove warnings
     backend_name = std::string(backendName);
+  } else if (env != nullptr) {
+    // Keep the precision of e.g. GPU_FP16 or CPU_BF16
+    backend_name = env;
   }
+  return NewBackend(backend, backend_name);
+}
 
+Status BackendManager::NewBackend(shared_ptr<Backend>& backend,
+                                  string& backend_name) {
   if (backend_name == "HDDL") {
     return errors::Internal("Failed to Create backend: ",
                             backend_name + " backend not available");
@@ -99,14 +217,13 @@ Status BackendManager::CreateBackend(shared_ptr<Backend>& backend,
                             " got nullptr");
   }
 
-  OVTF_VLOG(2) << "BackendManager::CreateBackend(): " << backend_name;
+  OVTF_VLOG(2) << "BackendManager::NewBackend(): " << backend_name;
   return Status::OK();
 }
 
 // Returns the supported backend names
 vector<string> BackendManager::GetSupportedBackends() {
-  ov::Core core;
-  auto devices = core.get_available_devices();
+  auto devices = Backend::GetAllAvailableDevices();
   auto pos = find(devices.begin(), devices.end(), "HDDL");
   if (pos != devices.end()) {
     devices.erase(pos);
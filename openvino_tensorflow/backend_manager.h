@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <map>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -30,21 +31,65 @@ class BackendManager {
   // Set the BackendManager backend ng_backend_name_
   static Status SetBackend(const string& backend_name = "CPU");
 
-  // Returns the currently set backend
+  // Returns the currently set backend, or the one of the enclosing
+  // ScopedBackend of the calling thread
   static shared_ptr<Backend> GetBackend();
 
+  // Returns the backend of backend_name, e.g. "GPU" or "CPU_BF16", and the
+  // name GetBackendName gives it, without changing the backend set with
+  // SetBackend. It is created on first use and shared by all the sessions
+  // asking for it.
+  static Status GetBackend(const string& backend_name,
+                           shared_ptr<Backend>& backend, string& device_name);
+
+  // Makes the calling thread use backend instead of the backend set with
+  // SetBackend while it is in scope, for the rewrite and the translation of
+  // the graphs of a session configured with a backend of its own
+  class ScopedBackend {
+   public:
+    ScopedBackend(shared_ptr<Backend> backend, const string& device_name);
+    ~ScopedBackend();
+
+   private:
+    shared_ptr<Backend> m_backend;
+    string m_device_name;
+    const ScopedBackend* m_previous;
+    friend class BackendManager;
+  };
+
   // Returns the currently set backend's name
   static Status GetBackendName(string& backend_name);
 
+  // Returns the backend of a cluster placed on a device other than the one
+  // of the current backend, created on first use and released when the
+  // backend is set again
+  static Status GetPlacedBackend(const string& device,
+                                 shared_ptr<Backend>& backend);
+
+  // Returns the names of the devices of the backend the op support is
+  // checked for, and whether an op must be supported by all of them or by
+  // any of them. A single device for everything but MULTI, HETERO and AUTO.
+  static Status GetBackendDevices(vector<string>& devices, bool& require_all);
+
   ~BackendManager();
 
  private:
-  // Creates backend of backend_name type
+  // Creates backend of backend_name type, or of the OPENVINO_TF_BACKEND
+  // type if it is set
   static Status CreateBackend(shared_ptr<Backend>& backend,
                               string& backend_name);
+  // Creates backend of backend_name type
+  static Status NewBackend(shared_ptr<Backend>& backend, string& backend_name);
+  // The name GetBackendName gives to the backend of backend_name type
+  static string DeviceName(const string& backend_name);
+  // The ScopedBackend in effect on the calling thread, null if none
+  static const ScopedBackend*& CurrentScope();
 
   static shared_ptr<Backend> m_backend;
   static string m_backend_name;
+  static map<string, shared_ptr<Backend>> m_placed_backends;
+  // The backends of the sessions configured with their own backend
+  static map<string, pair<shared_ptr<Backend>, string>> m_named_backends;
   static mutex m_backend_mutex;
 };
 
@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/backend_selector.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+BackendSelector::BackendSelector(int trial_steps, int reevaluate_interval)
+    : m_trial_steps(std::max(1, trial_steps)),
+      m_reevaluate_interval(std::max(0, reevaluate_interval)) {}
+
+unique_ptr<BackendSelector> BackendSelector::FromEnv() {
+  int trial_steps = 10;
+  int reevaluate_interval = 1000;
+  string trials_env = util::GetEnv("OPENVINO_TF_AUTO_BACKEND_TRIALS");
+  if (!trials_env.empty()) trial_steps = std::stoi(trials_env);
+  string interval_env = util::GetEnv("OPENVINO_TF_AUTO_BACKEND_INTERVAL");
+  if (!interval_env.empty()) reevaluate_interval = std::stoi(interval_env);
+  return unique_ptr<BackendSelector>(
+      new BackendSelector(trial_steps, reevaluate_interval));
+}
+
+BackendSelector::Path BackendSelector::Next(bool& timed) {
+  lock_guard<mutex> lock(m_mutex);
+  timed = false;
+  if (!m_trialing) {
+    if (m_reevaluate_interval == 0 ||
+        ++m_steps_since_decision < m_reevaluate_interval) {
+      return m_preferred;
+    }
+    // Start another round of trials, the paths are already warm
+    m_trialing = true;
+    m_ov.timed = m_tf.timed = 0;
+    m_ov.micros = m_tf.micros = 0;
+  }
+
+  PathStats& stats = m_ov.runs <= m_tf.runs ? m_ov : m_tf;
+  Path path = &stats == &m_ov ? Path::kOpenVINO : Path::kTF;
+  timed = stats.runs > 0;
+  stats.runs++;
+  return path;
+}
+
+void BackendSelector::Record(Path path, int64_t micros) {
+  lock_guard<mutex> lock(m_mutex);
+  if (!m_trialing) return;
+  PathStats& stats = path == Path::kOpenVINO ? m_ov : m_tf;
+  stats.timed++;
+  stats.micros += micros;
+  if (m_ov.timed < m_trial_steps || m_tf.timed < m_trial_steps) return;
+
+  double ov_avg = static_cast<double>(m_ov.micros) / m_ov.timed;
+  double tf_avg = static_cast<double>(m_tf.micros) / m_tf.timed;
+  m_preferred = tf_avg < ov_avg ? Path::kTF : Path::kOpenVINO;
+  m_trialing = false;
+  m_steps_since_decision = 0;
+  OVTF_VLOG(1) << "Backend selection: OpenVINO " << ov_avg << " us, TF "
+               << tf_avg << " us, using "
+               << (m_preferred == Path::kTF ? "TF" : "OpenVINO");
+}
+
+bool BackendSelector::IsTrialing() {
+  lock_guard<mutex> lock(m_mutex);
+  return m_trialing;
+}
+
+BackendSelector::Path BackendSelector::Preferred() {
+  lock_guard<mutex> lock(m_mutex);
+  return m_preferred;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
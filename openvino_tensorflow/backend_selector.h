@@ -0,0 +1,60 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_BACKEND_SELECTOR_H_
+#define OPENVINO_TF_BACKEND_SELECTOR_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Chooses between OpenVINO and native TF for the steps of one executable
+// from their measured latencies. The first trial_steps steps of each path
+// are timed, alternating between the two, after which every step takes the
+// faster path. The choice is made again every reevaluate_interval steps,
+// never if it is 0. The first step of each path is a warm-up and is not
+// timed. The selector is thread safe.
+class BackendSelector {
+ public:
+  enum class Path { kOpenVINO, kTF };
+
+  BackendSelector(int trial_steps, int reevaluate_interval);
+
+  // Reads OPENVINO_TF_AUTO_BACKEND_TRIALS and
+  // OPENVINO_TF_AUTO_BACKEND_INTERVAL
+  static std::unique_ptr<BackendSelector> FromEnv();
+
+  // The path of the next step, and whether the step should be timed
+  Path Next(bool& timed);
+  // Reports the latency of a timed step
+  void Record(Path path, int64_t micros);
+
+  bool IsTrialing();
+  Path Preferred();
+
+ private:
+  struct PathStats {
+    int runs = 0;
+    int timed = 0;
+    int64_t micros = 0;
+  };
+
+  std::mutex m_mutex;
+  int m_trial_steps;
+  int m_reevaluate_interval;
+  bool m_trialing = true;
+  int m_steps_since_decision = 0;
+  Path m_preferred = Path::kOpenVINO;
+  PathStats m_ov;
+  PathStats m_tf;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_BACKEND_SELECTOR_H_
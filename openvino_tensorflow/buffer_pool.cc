@@ -0,0 +1,171 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/buffer_pool.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// The buffers are aligned as Eigen expects, so that TF tensors can wrap them
+static const size_t kAlignment = 64;
+// The smaller buffers are cheaper to allocate than to keep
+static const size_t kMinPooledBytes = 4096;
+static const size_t kMaxPooledClass = size_t(1) << 30;
+
+class BufferPool::PoolAllocator : public ov::AllocatorImpl {
+ public:
+  explicit PoolAllocator(std::string key) : m_key(std::move(key)) {}
+
+  void* allocate(const size_t bytes, const size_t alignment) override {
+    size_t size_class = alignment <= kAlignment ? SizeClass(bytes) : 0;
+    void* buffer = size_class == 0 ? m_system.allocate(bytes, alignment)
+                                   : BufferPool::Allocate(m_key, size_class);
+    State& state = GetState();
+    lock_guard<mutex> lock(state.mutex);
+    state.allocated[buffer] = {size_class, bytes};
+    return buffer;
+  }
+
+  void deallocate(void* handle, const size_t, size_t alignment) override {
+    std::pair<size_t, size_t> allocation;
+    {
+      State& state = GetState();
+      lock_guard<mutex> lock(state.mutex);
+      auto it = state.allocated.find(handle);
+      if (it == state.allocated.end()) return;
+      allocation = it->second;
+      state.allocated.erase(it);
+    }
+    if (allocation.first == 0) {
+      m_system.deallocate(handle, allocation.second, alignment);
+    } else {
+      BufferPool::Release(m_key, allocation.first, handle);
+    }
+  }
+
+  bool is_equal(const ov::AllocatorImpl& other) const override {
+    auto pool = dynamic_cast<const PoolAllocator*>(&other);
+    return pool != nullptr && pool->m_key == m_key;
+  }
+
+ private:
+  const std::string m_key;
+  // The buffers which are not pooled
+  ov::Allocator m_system;
+};
+
+BufferPool::State& BufferPool::GetState() {
+  static State* state = new State();
+  return *state;
+}
+
+size_t BufferPool::MaxPooledBytes() {
+  static const size_t max_bytes = []() {
+    string env = util::GetEnv("OPENVINO_TF_BUFFER_POOL_MB");
+    size_t mb = 256;
+    if (!env.empty()) {
+      try {
+        mb = std::stoull(env);
+      } catch (const std::exception&) {
+        OVTF_VLOG(0) << "Ignoring OPENVINO_TF_BUFFER_POOL_MB=" << env;
+      }
+    }
+    return mb * 1024 * 1024;
+  }();
+  return max_bytes;
+}
+
+size_t BufferPool::SizeClass(size_t bytes) {
+  if (bytes < kMinPooledBytes || bytes > kMaxPooledClass) return 0;
+  size_t size_class = kMinPooledBytes;
+  while (size_class < bytes) size_class <<= 1;
+  return size_class;
+}
+
+ov::Allocator BufferPool::GetAllocator(const std::string& device) {
+  if (MaxPooledBytes() == 0) return ov::Allocator();
+  // One allocator per device and node, shared by all their tensors
+  static std::mutex mutex;
+  static auto* allocators = new std::map<string, ov::Allocator>();
+  string key = device + ":" + to_string(util::CurrentNUMANode());
+  lock_guard<std::mutex> lock(mutex);
+  auto it = allocators->find(key);
+  if (it == allocators->end()) {
+    ov::Allocator allocator(std::make_shared<PoolAllocator>(key));
+    it = allocators->emplace(key, allocator).first;
+  }
+  return it->second;
+}
+
+void* BufferPool::Allocate(const std::string& key, size_t size_class) {
+  State& state = GetState();
+  {
+    lock_guard<mutex> lock(state.mutex);
+    auto it = state.free.find({key, size_class});
+    if (it != state.free.end() && !it->second.empty()) {
+      void* buffer = it->second.back();
+      it->second.pop_back();
+      state.pooled_bytes -= size_class;
+      state.hits++;
+      return buffer;
+    }
+  }
+  state.misses++;
+  // The memory is first touched by the thread filling the tensor, which
+  // places it on the node of the pool
+  return ov::Allocator().allocate(size_class, kAlignment);
+}
+
+void BufferPool::Release(const std::string& key, size_t size_class,
+                         void* buffer) {
+  State& state = GetState();
+  {
+    lock_guard<mutex> lock(state.mutex);
+    if (state.pooled_bytes + size_class <= MaxPooledBytes()) {
+      state.free[{key, size_class}].push_back(buffer);
+      state.pooled_bytes += size_class;
+      return;
+    }
+  }
+  ov::Allocator().deallocate(buffer, size_class, kAlignment);
+}
+
+BufferPool::Stats BufferPool::GetStats() {
+  State& state = GetState();
+  Stats stats;
+  lock_guard<mutex> lock(state.mutex);
+  stats.hits = state.hits;
+  stats.misses = state.misses;
+  stats.pooled_bytes = state.pooled_bytes;
+  return stats;
+}
+
+void BufferPool::ResetStats() {
+  State& state = GetState();
+  state.hits = 0;
+  state.misses = 0;
+}
+
+void BufferPool::Clear() {
+  State& state = GetState();
+  lock_guard<mutex> lock(state.mutex);
+  for (auto& it : state.free) {
+    for (void* buffer : it.second) {
+      ov::Allocator().deallocate(buffer, it.first.second, kAlignment);
+    }
+  }
+  state.free.clear();
+  state.pooled_bytes = 0;
+  state.hits = 0;
+  state.misses = 0;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_BUFFER_POOL_H_
+#define OPENVINO_TF_BUFFER_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "openvino/runtime/allocator.hpp"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Host buffers of the tensors the engines allocate on every call, like the
+// dynamic outputs of a cluster, which are handed to TF and released when TF
+// releases its tensor. The buffers are kept by size class, a power of two,
+// per device and per NUMA node, and reused by the next allocations of their
+// class instead of being returned to the system.
+//
+// At most OPENVINO_TF_BUFFER_POOL_MB of released buffers, 256 by default,
+// are kept. 0 disables the pool.
+class BufferPool {
+ public:
+  // The allocator of the tensors of device, drawing from the buffers of the
+  // NUMA node of the calling thread. The default allocator when the pool is
+  // disabled.
+  static ov::Allocator GetAllocator(const std::string& device);
+
+  struct Stats {
+    int64_t hits = 0;
+    int64_t misses = 0;
+    // The released buffers kept for reuse
+    size_t pooled_bytes = 0;
+  };
+  static Stats GetStats();
+  static void ResetStats();
+  // Frees the pooled buffers and resets the statistics
+  static void Clear();
+
+  // The size class of an allocation of bytes, 0 if it is not pooled
+  static size_t SizeClass(size_t bytes);
+
+ private:
+  // Reads OPENVINO_TF_BUFFER_POOL_MB once
+  static size_t MaxPooledBytes();
+
+  // Returns a buffer of class size_class, pooled by key
+  static void* Allocate(const std::string& key, size_t size_class);
+  // Keeps buffer for reuse, or frees it when the pool is full
+  static void Release(const std::string& key, size_t size_class, void* buffer);
+
+  // An allocator of one device and node
+  class PoolAllocator;
+
+  // The buffers are released by the tensors TF holds, possibly after the
+  // static objects are destroyed, so the state is never destroyed
+  struct State {
+    std::mutex mutex;
+    // The released buffers by pool key and size class
+    std::map<std::pair<std::string, size_t>, std::vector<void*>> free;
+    size_t pooled_bytes = 0;
+    // The buffers handed out by address, with their size class, 0 for
+    // those which are not pooled, and their size
+    std::unordered_map<void*, std::pair<size_t, size_t>> allocated;
+    std::atomic<int64_t> hits{0};
+    std::atomic<int64_t> misses{0};
+  };
+  static State& GetState();
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_BUFFER_POOL_H_
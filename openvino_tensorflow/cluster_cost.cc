@@ -0,0 +1,224 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <sstream>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/graph/algorithm.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/cluster_cost.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+constexpr double ClusterCostModel::kTFOpSeconds;
+constexpr double ClusterCostModel::kCPUDispatchSeconds;
+constexpr double ClusterCostModel::kAcceleratorDispatchSeconds;
+constexpr double ClusterCostModel::kBoundaryTensorSeconds;
+constexpr double ClusterCostModel::kFlopsPerSecond;
+constexpr double ClusterCostModel::kBytesPerSecond;
+constexpr double ClusterCostModel::kOVSpeedup;
+
+// The ops which only move or describe data
+static const unordered_set<string> kDataMovementOps = {
+    "Const",   "Identity",    "IdentityN",  "NoOp",     "Shape",
+    "Reshape", "Squeeze",     "ExpandDims", "Snapshot", "StopGradient",
+    "Size",    "Placeholder", "_Arg",       "_Retval"};
+
+string ClusterCost::ToString() const {
+  stringstream ss;
+  ss << num_ops << " ops, " << flops / 1e6 << " MFLOPs, "
+     << num_boundary_tensors << " boundary tensors of "
+     << boundary_bytes / 1e3 << " KB, estimated " << tf_seconds * 1e6
+     << " us on TF vs " << ov_seconds * 1e6 << " us on OpenVINO";
+  return ss.str();
+}
+
+ClusterCostModel::ClusterCostModel(const Graph* graph, const string& device)
+    : m_refiner(new ShapeRefiner(graph->versions().producer(),
+                                 graph->op_registry())),
+      m_dispatch_seconds(device == "CPU" ? kCPUDispatchSeconds
+                                         : kAcceleratorDispatchSeconds) {
+  vector<Node*> order;
+  GetReversePostOrder(*graph, &order);
+  for (auto node : order) {
+    // The nodes whose shapes can not be inferred, or whose inputs are not
+    // inferred yet like the back edges of loops, have unknown shapes
+    Status status = m_refiner->AddNode(node);
+    if (!status.ok()) {
+      OVTF_VLOG(5) << "No shape for " << node->name() << ": "
+                   << status.error_message();
+    }
+  }
+}
+
+int ClusterCostModel::OutputRank(const Node* node, int index) const {
+  auto context = m_refiner->GetContext(node);
+  if (context == nullptr || index >= context->num_outputs()) return -1;
+  auto shape = context->output(index);
+  return context->RankKnown(shape) ? context->Rank(shape) : -1;
+}
+
+int64 ClusterCostModel::OutputDim(const Node* node, int index,
+                                  int dim) const {
+  int rank = OutputRank(node, index);
+  if (rank < 0) return -1;
+  if (dim < 0) dim += rank;
+  if (dim < 0 || dim >= rank) return -1;
+  auto context = m_refiner->GetContext(node);
+  return context->Value(context->Dim(context->output(index), dim));
+}
+
+double ClusterCostModel::OutputElements(const Node* node, int index) const {
+  double elements = 1;
+  int rank = OutputRank(node, index);
+  for (int i = 0; i < rank; i++) {
+    elements *= max<int64>(OutputDim(node, index, i), 1);
+  }
+  return elements;
+}
+
+double ClusterCostModel::OutputBytes(const Node* node, int index) const {
+  if (index >= node->num_outputs()) return 0;
+  int size = DataTypeSize(BaseType(node->output_type(index)));
+  return OutputElements(node, index) * (size > 0 ? size : 4);
+}
+
+string ClusterCostModel::OutputShape(const Node* node, int index,
+                                     bool* known) const {
+  int rank = OutputRank(node, index);
+  *known = rank >= 0;
+  if (rank < 0) return "?";
+  stringstream ss;
+  ss << "[";
+  for (int i = 0; i < rank; i++) {
+    int64 dim = OutputDim(node, index, i);
+    if (i > 0) ss << ",";
+    if (dim < 0) {
+      ss << "?";
+      *known = false;
+    } else {
+      ss << dim;
+    }
+  }
+  ss << "]";
+  return ss.str();
+}
+
+bool ClusterCostModel::InputOutput(const Node* node, int input,
+                                   const Node** src, int* src_index) const {
+  const Edge* edge;
+  if (!node->input_edge(input, &edge).ok()) return false;
+  *src = edge->src();
+  *src_index = edge->src_output();
+  return true;
+}
+
+double ClusterCostModel::NodeFlops(const Node* node) const {
+  const string& type = node->type_string();
+  if (kDataMovementOps.count(type) || node->num_outputs() == 0) return 0;
+  double output_elements = OutputElements(node, 0);
+  const Node* src;
+  int src_index;
+
+  if (type == "MatMul" || type == "BatchMatMul" || type == "BatchMatMulV2" ||
+      type == "BatchMatMulV3") {
+    // The reduced dimension of the first input
+    bool transpose = false;
+    if (type == "MatMul") {
+      GetNodeAttr(node->attrs(), "transpose_a", &transpose);
+    } else {
+      GetNodeAttr(node->attrs(), "adj_x", &transpose);
+    }
+    if (!InputOutput(node, 0, &src, &src_index)) return output_elements;
+    int64 k = OutputDim(src, src_index, transpose ? -2 : -1);
+    return 2 * output_elements * max<int64>(k, 1);
+  }
+  if (type == "Conv2D" || type == "Conv3D" || type == "FusedConv2D" ||
+      type == "_FusedConv2D" || type == "DepthwiseConv2dNative") {
+    // Every output is a dot product over the filter window and, except
+    // for the depthwise convolutions, the input channels
+    if (!InputOutput(node, 1, &src, &src_index)) return output_elements;
+    int filter_rank = OutputRank(src, src_index);
+    double window = 1;
+    for (int i = 0; i < filter_rank - 2; i++) {
+      window *= max<int64>(OutputDim(src, src_index, i), 1);
+    }
+    if (type != "DepthwiseConv2dNative" && filter_rank >= 2) {
+      window *= max<int64>(OutputDim(src, src_index, filter_rank - 2), 1);
+    }
+    return 2 * output_elements * window;
+  }
+  if (type == "MaxPool" || type == "AvgPool" || type == "MaxPool3D" ||
+      type == "AvgPool3D") {
+    vector<int32> ksize;
+    double window = 1;
+    if (GetNodeAttr(node->attrs(), "ksize", &ksize).ok()) {
+      for (auto size : ksize) window *= max(size, 1);
+    }
+    return output_elements * window;
+  }
+  // The elementwise ops and the reductions read each of their input
+  // elements once
+  double elements = output_elements;
+  for (int i = 0; i < node->num_inputs(); i++) {
+    if (InputOutput(node, i, &src, &src_index)) {
+      elements = max(elements, OutputElements(src, src_index));
+    }
+  }
+  return elements;
+}
+
+ClusterCost ClusterCostModel::Estimate(const set<Node*>& nodes) const {
+  ClusterCost cost;
+  double compute_seconds = 0;
+  set<pair<const Node*, int>> boundary;
+  for (auto node : nodes) {
+    cost.num_ops++;
+    double flops = NodeFlops(node);
+    cost.flops += flops;
+    double bytes = 0;
+    if (flops > 0) {
+      for (int i = 0; i < node->num_outputs(); i++) {
+        bytes += OutputBytes(node, i);
+      }
+    }
+    double seconds = max(flops / kFlopsPerSecond, bytes / kBytesPerSecond);
+    compute_seconds += seconds;
+    cost.tf_seconds += kTFOpSeconds + seconds;
+
+    for (auto edge : node->in_edges()) {
+      if (!edge->IsControlEdge() && !nodes.count(edge->src())) {
+        boundary.emplace(edge->src(), edge->src_output());
+      }
+    }
+    for (auto edge : node->out_edges()) {
+      if (!edge->IsControlEdge() && !nodes.count(edge->dst())) {
+        boundary.emplace(node, edge->src_output());
+      }
+    }
+  }
+  cost.num_boundary_tensors = boundary.size();
+  for (const auto& output : boundary) {
+    cost.boundary_bytes += OutputBytes(output.first, output.second);
+  }
+  cost.ov_seconds = m_dispatch_seconds +
+                    cost.num_boundary_tensors * kBoundaryTensorSeconds +
+                    cost.boundary_bytes / kBytesPerSecond +
+                    compute_seconds / kOVSpeedup;
+  return cost;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_CLUSTER_COST_H_
+#define OPENVINO_TF_CLUSTER_COST_H_
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include "tensorflow/core/common_runtime/shape_refiner.h"
+#include "tensorflow/core/graph/graph.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// The estimated cost of a single call of a cluster, on TF and on OpenVINO
+struct ClusterCost {
+  int num_ops = 0;
+  double flops = 0;
+  // The tensors entering or leaving the cluster
+  int num_boundary_tensors = 0;
+  double boundary_bytes = 0;
+  double tf_seconds = 0;
+  double ov_seconds = 0;
+
+  // Whether the cluster is expected to run faster on OpenVINO
+  bool Wins() const { return ov_seconds < tf_seconds; }
+  std::string ToString() const;
+};
+
+// Estimates whether offloading a cluster pays off. On TF every op costs an
+// executor dispatch plus its compute, bounded by its FLOPs or by the bytes
+// it writes. On OpenVINO the cluster costs a single dispatch, the transfer
+// of its boundary tensors, and its compute, which the fusions of the plugins
+// speed up. The shapes are inferred from the graph, the unknown dimensions
+// and shapes being taken as 1 and as a scalar.
+class ClusterCostModel {
+ public:
+  ClusterCostModel(const Graph* graph, const std::string& device);
+
+  ClusterCost Estimate(const std::set<Node*>& nodes) const;
+
+  // The FLOPs of a single node, 0 for those which only move data
+  double NodeFlops(const Node* node) const;
+  // The bytes of output index of node
+  double OutputBytes(const Node* node, int index) const;
+  // The inferred shape of output index of node, e.g. "[?,224,224,3]", "?"
+  // when its rank is not known. known is whether every dimension is.
+  std::string OutputShape(const Node* node, int index, bool* known) const;
+
+  static constexpr double kTFOpSeconds = 1e-6;
+  static constexpr double kCPUDispatchSeconds = 50e-6;
+  static constexpr double kAcceleratorDispatchSeconds = 200e-6;
+  static constexpr double kBoundaryTensorSeconds = 5e-6;
+  static constexpr double kFlopsPerSecond = 5e10;
+  static constexpr double kBytesPerSecond = 1e10;
+  static constexpr double kOVSpeedup = 1.5;
+
+ private:
+  // The number of elements of output index of node
+  double OutputElements(const Node* node, int index) const;
+  // Dimension dim of output index of node, negative if unknown
+  int64 OutputDim(const Node* node, int index, int dim) const;
+  int OutputRank(const Node* node, int index) const;
+  bool InputOutput(const Node* node, int input, const Node** src,
+                   int* src_index) const;
+
+  std::unique_ptr<ShapeRefiner> m_refiner;
+  double m_dispatch_seconds;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_CLUSTER_COST_H_
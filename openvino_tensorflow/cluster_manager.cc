@@ -3,7 +3,17 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
+#include <algorithm>
+
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
+
+#include "logging/ovtf_log.h"
 #include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/memory_budget.h"
+#include "openvino_tensorflow/ovtf_utils.h"
 
 using namespace std;
 
@@ -12,19 +22,39 @@ namespace openvino_tensorflow {
 
 // Static initializers
 std::vector<GraphDef*> NGraphClusterManager::s_cluster_graphs;
-std::vector<bool> NGraphClusterManager::s_cluster_fallback;
+std::deque<std::atomic<bool>> NGraphClusterManager::s_cluster_fallback;
+constexpr size_t NGraphClusterManager::kMaxFailedSignatures;
 std::vector<std::shared_ptr<Executable>>
     NGraphClusterManager::s_mru_executables;
 std::mutex NGraphClusterManager::s_cluster_graphs_mutex;
-bool NGraphClusterManager::s_cluster_fallback_enabled = true;
+uint64_t NGraphClusterManager::s_generation = 0;
+std::atomic<bool> NGraphClusterManager::s_cluster_fallback_enabled{true};
 std::map<size_t, std::string> NGraphClusterManager::s_cluster_info;
+bool NGraphClusterManager::s_warming_up = false;
+int NGraphClusterManager::s_background_compiles = 0;
+std::mutex NGraphClusterManager::s_compile_mutex;
+std::condition_variable NGraphClusterManager::s_compile_done_cv;
+std::mutex NGraphClusterManager::s_shared_mutex;
+std::map<size_t, NGraphClusterManager::CacheOwner>
+    NGraphClusterManager::s_cache_owners;
+size_t NGraphClusterManager::s_next_cache_owner = 1;
+std::map<size_t, uint64> NGraphClusterManager::s_cluster_fingerprints;
+std::unordered_map<string, std::weak_ptr<const ClusterGraph>>
+    NGraphClusterManager::s_parsed_graphs;
+std::unordered_map<NGraphClusterManager::SharedKey, std::weak_ptr<Executable>,
+                   NGraphClusterManager::SharedKeyHasher>
+    NGraphClusterManager::s_shared_executables;
 
 size_t NGraphClusterManager::NewCluster() {
   std::lock_guard<std::mutex> guard(s_cluster_graphs_mutex);
 
   size_t new_idx = s_cluster_graphs.size();
   s_cluster_graphs.push_back(new GraphDef());
-  s_cluster_fallback.push_back(false);
+  if (new_idx < s_cluster_fallback.size()) {
+    s_cluster_fallback[new_idx] = false;
+  } else {
+    s_cluster_fallback.emplace_back(false);
+  }
   s_mru_executables.push_back(nullptr);
   return new_idx;
 }
@@ -35,26 +65,45 @@ GraphDef* NGraphClusterManager::GetClusterGraph(size_t idx) {
 }
 
 size_t NGraphClusterManager::NumberOfClusters() {
+  std::lock_guard<std::mutex> guard(s_cluster_graphs_mutex);
   return s_cluster_graphs.size();
 }
 
 void NGraphClusterManager::EvictAllClusters() {
+  std::lock_guard<std::mutex> guard(s_cluster_graphs_mutex);
   s_cluster_graphs.clear();
-  s_cluster_fallback.clear();
+  for (auto& fallback : s_cluster_fallback) fallback = false;
+  // The ids are reused by the next clusters
+  s_cluster_info.clear();
+  s_generation++;
+}
+
+uint64_t NGraphClusterManager::Generation() {
+  std::lock_guard<std::mutex> guard(s_cluster_graphs_mutex);
+  return s_generation;
 }
 
 void NGraphClusterManager::EvictMRUClusters() { s_mru_executables.clear(); }
 
 bool NGraphClusterManager::CheckClusterFallback(const size_t idx) {
-  return (s_cluster_fallback_enabled && idx < s_cluster_fallback.size())
-             ? s_cluster_fallback[idx]
-             : false;
+  if (!s_cluster_fallback_enabled) return false;
+  return CheckClusterFallback(GetClusterFallbackFlag(idx));
+}
+
+const std::atomic<bool>* NGraphClusterManager::GetClusterFallbackFlag(
+    const size_t idx) {
+  // The flag of an unknown cluster, never set
+  static const std::atomic<bool> s_no_fallback{false};
+  std::lock_guard<std::mutex> guard(s_cluster_graphs_mutex);
+  return idx < s_cluster_fallback.size() ? &s_cluster_fallback[idx]
+                                         : &s_no_fallback;
 }
 
 void NGraphClusterManager::SetClusterFallback(const size_t idx,
                                               const bool fallback) {
-  if (s_cluster_fallback_enabled && idx < s_cluster_fallback.size())
-    s_cluster_fallback[idx] = fallback;
+  if (!s_cluster_fallback_enabled) return;
+  std::lock_guard<std::mutex> guard(s_cluster_graphs_mutex);
+  if (idx < s_cluster_fallback.size()) s_cluster_fallback[idx] = fallback;
 }
 
 void NGraphClusterManager::EnableClusterFallback() {
@@ -81,20 +130,290 @@ void NGraphClusterManager::ExportMRUIRs(const string& output_dir) {
   }
 }
 
+std::shared_ptr<const ClusterGraph> NGraphClusterManager::GetParsedGraph(
+    const string& key) {
+  std::lock_guard<std::mutex> guard(s_shared_mutex);
+  auto it = s_parsed_graphs.find(key);
+  return it == s_parsed_graphs.end() ? nullptr : it->second.lock();
+}
+
+std::shared_ptr<const ClusterGraph> NGraphClusterManager::SetParsedGraph(
+    const string& key, std::shared_ptr<const ClusterGraph> graph) {
+  std::lock_guard<std::mutex> guard(s_shared_mutex);
+  for (auto it = s_parsed_graphs.begin(); it != s_parsed_graphs.end();) {
+    if (it->second.expired()) {
+      it = s_parsed_graphs.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto& shared = s_parsed_graphs[key];
+  auto current = shared.lock();
+  if (current != nullptr) return current;
+  shared = graph;
+  return graph;
+}
+
 void NGraphClusterManager::SetClusterInfo(const size_t idx,
                                           const string cluster_info) {
+  std::lock_guard<std::mutex> guard(s_cluster_graphs_mutex);
   s_cluster_info[idx] = cluster_info;
 }
 
+string NGraphClusterManager::GetClusterInfo(const size_t idx) {
+  std::lock_guard<std::mutex> guard(s_cluster_graphs_mutex);
+  auto it = s_cluster_info.find(idx);
+  return it == s_cluster_info.end() ? string() : it->second;
+}
+
 void NGraphClusterManager::DumpClusterInfos(string& cluster_infos) {
+  std::lock_guard<std::mutex> guard(s_cluster_graphs_mutex);
   cluster_infos = "";
   for (int i = 0; i < s_mru_executables.size(); i++) {
-    if (s_mru_executables[i]) cluster_infos += s_cluster_info[i] + "\n";
+    auto it = s_cluster_info.find(i);
+    if (s_mru_executables[i] && it != s_cluster_info.end()) {
+      cluster_infos += it->second + "\n";
+    }
   }
 }
 
 void NGraphClusterManager::ClearMRUClusters() {
   s_mru_executables.assign(s_mru_executables.size(), nullptr);
 }
+
+ExecutableCache& NGraphClusterManager::GetExecutableCache() {
+  static ExecutableCache* cache = []() {
+    size_t budget_mb = 0;
+    string budget_env = util::GetEnv("OPENVINO_TF_EXECUTABLE_CACHE_SIZE_MB");
+    if (!budget_env.empty()) budget_mb = std::stoull(budget_env);
+    return new ExecutableCache(budget_mb * 1024 * 1024);
+  }();
+  return *cache;
+}
+
+size_t NGraphClusterManager::NewCacheOwner(const size_t idx) {
+  uint64_t generation = Generation();
+  std::lock_guard<std::mutex> guard(s_shared_mutex);
+  size_t owner = s_next_cache_owner++;
+  s_cache_owners[owner] = CacheOwner{idx, generation};
+  return owner;
+}
+
+void NGraphClusterManager::ReleaseCacheOwner(const size_t owner) {
+  {
+    std::lock_guard<std::mutex> guard(s_shared_mutex);
+    s_cache_owners.erase(owner);
+    s_cluster_fingerprints.erase(owner);
+  }
+  EraseClusterExecutables(owner);
+}
+
+ExecutableCache::ClusterStats NGraphClusterManager::GetClusterStats(
+    const size_t idx) {
+  std::vector<size_t> owners;
+  {
+    std::lock_guard<std::mutex> guard(s_shared_mutex);
+    for (const auto& it : s_cache_owners) {
+      if (it.second.idx == idx) owners.push_back(it.first);
+    }
+  }
+  ExecutableCache::ClusterStats stats;
+  for (size_t owner : owners) {
+    auto owner_stats = GetExecutableCache().GetClusterStats(owner);
+    stats.entries += owner_stats.entries;
+    stats.bytes += owner_stats.bytes;
+    stats.hits += owner_stats.hits;
+    stats.misses += owner_stats.misses;
+    stats.evictions += owner_stats.evictions;
+    stats.failures += owner_stats.failures;
+  }
+  return stats;
+}
+
+bool NGraphClusterManager::LookupExecutable(
+    const size_t owner, const CompilationKey& key,
+    std::shared_ptr<Executable>& executable) {
+  return GetExecutableCache().Lookup(owner, key, executable);
+}
+
+void NGraphClusterManager::InsertExecutable(
+    const size_t owner, const CompilationKey& key,
+    std::shared_ptr<Executable> executable, const size_t bytes,
+    const size_t max_cluster_items) {
+  // Destroyed once the cache is unlocked
+  std::vector<std::shared_ptr<Executable>> evicted;
+  GetExecutableCache().Insert(owner, key, executable, bytes,
+                              max_cluster_items, &evicted);
+
+  // The executables reading variables converted to constants hold the
+  // values of the variables of their own kernel
+  if (executable == nullptr || executable->HasConstantVariables()) return;
+  std::lock_guard<std::mutex> guard(s_shared_mutex);
+  auto it = s_cluster_fingerprints.find(owner);
+  if (it == s_cluster_fingerprints.end()) return;
+  for (auto shared = s_shared_executables.begin();
+       shared != s_shared_executables.end();) {
+    if (shared->second.expired()) {
+      shared = s_shared_executables.erase(shared);
+    } else {
+      ++shared;
+    }
+  }
+  s_shared_executables[SharedKey{it->second, key}] = executable;
+}
+
+void NGraphClusterManager::EraseClusterExecutables(const size_t owner) {
+  std::vector<std::shared_ptr<Executable>> evicted;
+  GetExecutableCache().EraseCluster(owner, &evicted);
+}
+
+size_t NGraphClusterManager::SetSignatureFallback(const size_t owner,
+                                                  const CompilationKey& key) {
+  static const int64 retry_micros = []() {
+    string retry_env = util::GetEnv("OPENVINO_TF_FALLBACK_RETRY_MS");
+    return retry_env.empty() ? 0 : std::stoll(retry_env) * 1000;
+  }();
+  std::vector<std::shared_ptr<Executable>> evicted;
+  size_t failures = GetExecutableCache().RecordFailure(
+      owner, key, Env::Default()->NowMicros(), retry_micros, &evicted);
+  if (failures <= kMaxFailedSignatures) return failures;
+
+  // A cluster failing for most of its inputs falls back as a whole
+  CacheOwner cluster;
+  {
+    std::lock_guard<std::mutex> guard(s_shared_mutex);
+    auto it = s_cache_owners.find(owner);
+    if (it == s_cache_owners.end()) return failures;
+    cluster = it->second;
+  }
+  if (cluster.generation != Generation()) return failures;
+  OVTF_VLOG(1) << "Cluster " << cluster.idx << " failed for " << failures
+               << " signatures, falling back to TF";
+  SetClusterFallback(cluster.idx, true);
+  return failures;
+}
+
+bool NGraphClusterManager::CheckSignatureFallback(const size_t owner,
+                                                  const CompilationKey& key) {
+  return s_cluster_fallback_enabled &&
+         GetExecutableCache().IsFailed(owner, key,
+                                       Env::Default()->NowMicros());
+}
+
+Status NGraphClusterManager::ReserveDeviceMemory(const string& device,
+                                                 const size_t bytes,
+                                                 Executable* executable) {
+  const size_t budget = MemoryBudget::Get(device);
+  if (budget == 0) return Status::OK();
+  if (bytes > budget) {
+    return errors::ResourceExhausted("The executable needs ", bytes,
+                                     " bytes, more than the memory budget of ",
+                                     budget, " bytes of ", device);
+  }
+
+  size_t reported = 0;
+  MemoryBudget::DeviceMemoryUsage(device, reported);
+  // Destroyed once the cache is unlocked
+  std::vector<std::shared_ptr<Executable>> evicted;
+  size_t used = 0;
+  bool reserved = GetExecutableCache().ReserveDevice(
+      executable, device, bytes, budget, reported, &used, &evicted);
+  if (!evicted.empty()) {
+    OVTF_VLOG(1) << "Evicted " << evicted.size() << " executables of "
+                 << device << " to fit its memory budget of " << budget
+                 << " bytes";
+  }
+  if (!reserved) {
+    return errors::ResourceExhausted(
+        "The executable needs ", bytes, " bytes, ", used,
+        " of the memory budget of ", budget, " bytes of ", device,
+        " are in use");
+  }
+  return Status::OK();
+}
+
+void NGraphClusterManager::ReleaseDeviceMemory(Executable& executable) {
+  GetExecutableCache().ReleaseDevice(executable);
+}
+
+uint64 NGraphClusterManager::CanonicalFingerprint(const GraphDef& graph,
+                                                  const string& context) {
+  GraphDef canonical = graph;
+  std::unordered_map<string, string> names;
+  for (int i = 0; i < canonical.node_size(); i++) {
+    names[canonical.node(i).name()] = "n" + to_string(i);
+  }
+  for (auto& node : *canonical.mutable_node()) {
+    node.set_name(names[node.name()]);
+    node.clear_device();
+    node.mutable_attr()->erase("_ovtf_cluster");
+    // The colocation constraints name the colocated nodes
+    node.mutable_attr()->erase("_class");
+    for (auto& input : *node.mutable_input()) {
+      bool control = !input.empty() && input[0] == '^';
+      string name = input.substr(control ? 1 : 0);
+      string port;
+      auto colon = name.find(':');
+      if (colon != string::npos) {
+        port = name.substr(colon);
+        name = name.substr(0, colon);
+      }
+      auto it = names.find(name);
+      if (it != names.end()) input = (control ? "^" : "") + it->second + port;
+    }
+  }
+  string serialized;
+  SerializeToStringDeterministic(canonical, &serialized);
+  return FingerprintCat64(Fingerprint64(serialized), Fingerprint64(context));
+}
+
+void NGraphClusterManager::SetClusterFingerprint(const size_t owner,
+                                                 const uint64 fingerprint) {
+  std::lock_guard<std::mutex> guard(s_shared_mutex);
+  if (fingerprint == 0) {
+    s_cluster_fingerprints.erase(owner);
+  } else {
+    s_cluster_fingerprints[owner] = fingerprint;
+  }
+}
+
+bool NGraphClusterManager::LookupSharedExecutable(
+    const size_t owner, const CompilationKey& key,
+    std::shared_ptr<Executable>& executable) {
+  std::lock_guard<std::mutex> guard(s_shared_mutex);
+  auto it = s_cluster_fingerprints.find(owner);
+  if (it == s_cluster_fingerprints.end()) return false;
+  auto shared = s_shared_executables.find(SharedKey{it->second, key});
+  if (shared == s_shared_executables.end()) return false;
+  executable = shared->second.lock();
+  return executable != nullptr;
+}
+
+void NGraphClusterManager::StartWarmup() {
+  std::lock_guard<std::mutex> guard(s_compile_mutex);
+  s_warming_up = true;
+}
+
+bool NGraphClusterManager::IsWarmingUp() {
+  std::lock_guard<std::mutex> guard(s_compile_mutex);
+  return s_warming_up;
+}
+
+void NGraphClusterManager::FinishWarmup() {
+  std::unique_lock<std::mutex> lock(s_compile_mutex);
+  s_compile_done_cv.wait(lock, [] { return s_background_compiles == 0; });
+  s_warming_up = false;
+}
+
+void NGraphClusterManager::BackgroundCompileStarted() {
+  std::lock_guard<std::mutex> guard(s_compile_mutex);
+  s_background_compiles++;
+}
+
+void NGraphClusterManager::BackgroundCompileDone() {
+  std::lock_guard<std::mutex> guard(s_compile_mutex);
+  s_background_compiles--;
+  s_compile_done_cv.notify_all();
+}
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
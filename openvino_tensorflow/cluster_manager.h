@@ -6,24 +6,56 @@
 #ifndef OPENVINO_TF_CLUSTER_MANAGER_H_
 #define OPENVINO_TF_CLUSTER_MANAGER_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/graph/graph.h"
 
+#include "openvino_tensorflow/compilation_key.h"
 #include "openvino_tensorflow/executable.h"
+#include "openvino_tensorflow/executable_cache.h"
 
 namespace tensorflow {
 namespace openvino_tensorflow {
 
+// The graph of a cluster parsed once, with the metadata of its inputs, and
+// shared by all the kernels of the cluster. It is never modified once
+// shared.
+struct ClusterGraph {
+  ClusterGraph() : graph(OpRegistry::Global()) {}
+  Graph graph;
+  // The inputs feeding static inputs of the cluster ops, and the inputs read
+  // from resource variables, by arg index
+  std::vector<bool> input_is_static;
+  std::vector<bool> input_is_variable;
+  bool has_variables = false;
+};
+
 class NGraphClusterManager {
  public:
   static size_t NewCluster();
   static tensorflow::GraphDef* GetClusterGraph(size_t idx);
   static void EvictAllClusters();
+  // Changes whenever the clusters are evicted and their ids may be reused
+  static uint64_t Generation();
   static void EvictMRUClusters();
   static size_t NumberOfClusters();
   static bool CheckClusterFallback(const size_t idx);
+  // The fallback flag of cluster idx. Its address stays valid for the
+  // lifetime of the process, so that the kernels check it on every step
+  // without a lock.
+  static const std::atomic<bool>* GetClusterFallbackFlag(const size_t idx);
+  static bool CheckClusterFallback(const std::atomic<bool>* flag) {
+    return s_cluster_fallback_enabled && flag->load(std::memory_order_acquire);
+  }
   static void SetClusterFallback(const size_t idx, const bool fallback);
   static void EnableClusterFallback();
   static void DisableClusterFallback();
@@ -32,16 +64,125 @@ class NGraphClusterManager {
                                std::shared_ptr<Executable> executable_ptr);
   static void ExportMRUIRs(const string& output_dir);
   static void ClearMRUClusters();
+  // The parsed cluster graph shared under key, null if no kernel holding it
+  // is alive. Setting returns the graph already shared under key if another
+  // kernel set one first.
+  static std::shared_ptr<const ClusterGraph> GetParsedGraph(const string& key);
+  static std::shared_ptr<const ClusterGraph> SetParsedGraph(
+      const string& key, std::shared_ptr<const ClusterGraph> graph);
   static void SetClusterInfo(const size_t idx, const string cluster_info);
+  static string GetClusterInfo(const size_t idx);
   static void DumpClusterInfos(string& cluster_infos);
 
+  // The executables, failed signatures and fingerprint of a kernel of
+  // cluster idx are registered under an owner token which is never reused,
+  // so that the kernels sharing a cluster id, in the same generation or
+  // after an eviction of the clusters, neither see nor erase the entries
+  // of each other. Releasing the owner erases all its entries.
+  static size_t NewCacheOwner(const size_t idx);
+  static void ReleaseCacheOwner(const size_t owner);
+  // The cache stats summed over the live owners of cluster idx
+  static ExecutableCache::ClusterStats GetClusterStats(const size_t idx);
+
+  // The compiled executables of all clusters share one cache, bounded by
+  // OPENVINO_TF_EXECUTABLE_CACHE_SIZE_MB
+  static bool LookupExecutable(const size_t owner, const CompilationKey& key,
+                               std::shared_ptr<Executable>& executable);
+  static void InsertExecutable(const size_t owner, const CompilationKey& key,
+                               std::shared_ptr<Executable> executable,
+                               const size_t bytes,
+                               const size_t max_cluster_items);
+  static void EraseClusterExecutables(const size_t owner);
+  // A signature which failed to translate, compile or execute runs on TF
+  // instead of the whole cluster, and is compiled again after the backoff
+  // of OPENVINO_TF_FALLBACK_RETRY_MS if it is set. The cluster of owner
+  // falls back as a whole once more than kMaxFailedSignatures failed,
+  // unless its id was reused since. Returns the failed signatures of owner.
+  static size_t SetSignatureFallback(const size_t owner,
+                                     const CompilationKey& key);
+  static bool CheckSignatureFallback(const size_t owner,
+                                     const CompilationKey& key);
+  static constexpr size_t kMaxFailedSignatures = 64;
+  static ExecutableCache& GetExecutableCache();
+  // Makes room for a new executable of the given bytes on device within
+  // its MemoryBudget, by evicting the least recently used executables of
+  // the device, and reserves the bytes for the executable until it is
+  // inserted. ResourceExhausted if it still does not fit. A null executable
+  // only makes room.
+  static Status ReserveDeviceMemory(const string& device, const size_t bytes,
+                                    Executable* executable = nullptr);
+  // Releases the reservation of an executable failing to compile
+  static void ReleaseDeviceMemory(Executable& executable);
+
+  // The fingerprint of a cluster graph, independent of the names of its
+  // nodes, its devices and its cluster id, combined with a context holding
+  // whatever else the compilation of the cluster depends on
+  static uint64 CanonicalFingerprint(const GraphDef& graph,
+                                     const string& context);
+  // The clusters with the same non zero fingerprint share the executables
+  // they insert, so that structurally identical clusters are translated and
+  // compiled once. A fingerprint of 0 stops sharing the executables of
+  // owner.
+  static void SetClusterFingerprint(const size_t owner,
+                                    const uint64 fingerprint);
+  // Looks key up among the live executables inserted by the owners with
+  // the fingerprint of owner
+  static bool LookupSharedExecutable(const size_t owner,
+                                     const CompilationKey& key,
+                                     std::shared_ptr<Executable>& executable);
+
+  // While warming up, the clusters compile their cache misses in parallel in
+  // the background and run on TF meanwhile
+  static void StartWarmup();
+  static bool IsWarmingUp();
+  // Waits for every background compilation to finish and ends the warm-up
+  static void FinishWarmup();
+  // Called when a background compilation is scheduled and when it is done
+  static void BackgroundCompileStarted();
+  static void BackgroundCompileDone();
+
  private:
+  struct SharedKey {
+    uint64 fingerprint;
+    CompilationKey key;
+    bool operator==(const SharedKey& other) const {
+      return fingerprint == other.fingerprint && key == other.key;
+    }
+  };
+  struct SharedKeyHasher {
+    size_t operator()(const SharedKey& k) const {
+      return k.key.Hash() ^ (k.fingerprint * 0x9e3779b97f4a7c15ULL);
+    }
+  };
+
   static std::vector<tensorflow::GraphDef*> s_cluster_graphs;
   static std::vector<std::shared_ptr<Executable>> s_mru_executables;
   static std::map<size_t, std::string> s_cluster_info;
-  static std::vector<bool> s_cluster_fallback;
-  static bool s_cluster_fallback_enabled;
+  // Grown under s_cluster_graphs_mutex and never shrunk, the ids of the
+  // evicted clusters are reused by the next ones
+  static std::deque<std::atomic<bool>> s_cluster_fallback;
+  static std::atomic<bool> s_cluster_fallback_enabled;
   static std::mutex s_cluster_graphs_mutex;
+  static uint64_t s_generation;
+  static bool s_warming_up;
+  static int s_background_compiles;
+  static std::mutex s_compile_mutex;
+  static std::condition_variable s_compile_done_cv;
+  static std::mutex s_shared_mutex;
+  static std::unordered_map<string, std::weak_ptr<const ClusterGraph>>
+      s_parsed_graphs;
+  // The cluster of every live owner, and the generation of its id
+  struct CacheOwner {
+    size_t idx;
+    uint64_t generation;
+  };
+  static std::map<size_t, CacheOwner> s_cache_owners;
+  static size_t s_next_cache_owner;
+  static std::map<size_t, uint64> s_cluster_fingerprints;
+  // The executables are owned by the cache entries of the clusters
+  static std::unordered_map<SharedKey, std::weak_ptr<Executable>,
+                            SharedKeyHasher>
+      s_shared_executables;
 };
 
 }  // namespace openvino_tensorflow
@@ -0,0 +1,262 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+
+#include "tensorflow/core/lib/core/errors.h"
+
+#include "openvino_tensorflow/backend_manager.h"
+#include "openvino_tensorflow/cluster_placement.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+std::mutex ClusterPlacement::s_mutex;
+bool ClusterPlacement::s_rules_set = false;
+ClusterPlacement::Rules ClusterPlacement::s_rules;
+bool ClusterPlacement::s_stages_set = false;
+vector<string> ClusterPlacement::s_stages;
+uint64_t ClusterPlacement::s_generation = 0;
+
+// The relative costs of the cost model, in units of a simple op
+static const int kLaunchOverhead = 4;
+static const int kDenseComputeGain = 16;
+static const int kPostProcessingPenalty = 4;
+
+static const set<string>& DenseComputeOps() {
+  static const set<string> ops{"BatchMatMul",
+                               "BatchMatMulV2",
+                               "Conv2D",
+                               "Conv2DBackpropInput",
+                               "Conv3D",
+                               "DepthwiseConv2dNative",
+                               "Einsum",
+                               "MatMul",
+                               "_FusedConv2D",
+                               "_FusedDepthwiseConv2dNative",
+                               "_FusedMatMul"};
+  return ops;
+}
+
+static const set<string>& PostProcessingOps() {
+  static const set<string> ops{"CombinedNonMaxSuppression",
+                               "GatherNd",
+                               "GatherV2",
+                               "NonMaxSuppressionV2",
+                               "NonMaxSuppressionV3",
+                               "NonMaxSuppressionV4",
+                               "NonMaxSuppressionV5",
+                               "TopKV2",
+                               "Unique",
+                               "Where"};
+  return ops;
+}
+
+// The ops which do no work of their own
+static const set<string>& FreeOps() {
+  static const set<string> ops{"_Arg", "_Retval", "Const", "Identity",
+                               "NoOp"};
+  return ops;
+}
+
+static Status CheckPlacedDevice(const string& device) {
+  if (device == "VAD-M" || device == "HDDL") {
+    return errors::InvalidArgument("Clusters cannot be placed on ", device);
+  }
+  return Status::OK();
+}
+
+Status ClusterPlacement::ParseRules(const string& rules, Rules& parsed) {
+  parsed.clear();
+  stringstream ss(rules);
+  string rule;
+  while (getline(ss, rule, ',')) {
+    if (rule.empty()) continue;
+    size_t colon = rule.find(':');
+    if (colon == string::npos || colon == 0 || colon == rule.size() - 1) {
+      return errors::InvalidArgument("Invalid cluster placement rule '", rule,
+                                     "', expected op_type:device");
+    }
+    string device = rule.substr(colon + 1);
+    TF_RETURN_IF_ERROR(CheckPlacedDevice(device));
+    parsed.emplace_back(rule.substr(0, colon), device);
+  }
+  return Status::OK();
+}
+
+Status ClusterPlacement::SetRules(const string& rules) {
+  Rules parsed;
+  TF_RETURN_IF_ERROR(ParseRules(rules, parsed));
+  lock_guard<mutex> lock(s_mutex);
+  s_rules = parsed;
+  s_rules_set = !parsed.empty();
+  s_generation++;
+  return Status::OK();
+}
+
+ClusterPlacement::Rules ClusterPlacement::GetRules() {
+  {
+    lock_guard<mutex> lock(s_mutex);
+    if (s_rules_set) return s_rules;
+  }
+  Rules rules;
+  Status status =
+      ParseRules(util::GetEnv("OPENVINO_TF_CLUSTER_PLACEMENT"), rules);
+  if (!status.ok()) {
+    OVTF_VLOG(0) << "Ignoring OPENVINO_TF_CLUSTER_PLACEMENT: "
+                 << status.error_message();
+    rules.clear();
+  }
+  return rules;
+}
+
+string ClusterPlacement::ChooseDevice(const vector<string>& op_types,
+                                      const string& backend_device,
+                                      const Rules& rules,
+                                      bool use_cost_model) {
+  // The VAD-M engine batches over its own devices
+  if (backend_device == "HDDL") return "";
+
+  string device;
+  if (!rules.empty()) {
+    // The matches of every device, in the order of the first rule for it
+    vector<pair<string, int>> votes;
+    for (const auto& rule : rules) {
+      int matches = 0;
+      for (const auto& op_type : op_types) matches += op_type == rule.first;
+      auto it = votes.begin();
+      while (it != votes.end() && it->first != rule.second) ++it;
+      if (it == votes.end()) {
+        votes.emplace_back(rule.second, matches);
+      } else {
+        it->second += matches;
+      }
+    }
+    int best = 0;
+    for (const auto& vote : votes) {
+      if (vote.second > best) {
+        best = vote.second;
+        device = vote.first;
+      }
+    }
+  }
+
+  if (device.empty() && use_cost_model && backend_device == "GPU") {
+    int gain = 0;
+    int cost = kLaunchOverhead;
+    for (const auto& op_type : op_types) {
+      if (DenseComputeOps().count(op_type)) {
+        gain += kDenseComputeGain;
+      } else if (PostProcessingOps().count(op_type)) {
+        cost += kPostProcessingPenalty;
+      } else if (!FreeOps().count(op_type)) {
+        gain++;
+      }
+    }
+    if (gain <= cost) device = "CPU";
+  }
+  return device == backend_device ? "" : device;
+}
+
+Status ClusterPlacement::PlaceCluster(const GraphDef& cluster_graph,
+                                      string& device) {
+  device.clear();
+  Rules rules = GetRules();
+  bool use_cost_model =
+      util::GetEnv("OPENVINO_TF_CLUSTER_PLACEMENT_COST_MODEL") == "1";
+  if (rules.empty() && !use_cost_model) return Status::OK();
+
+  string backend_device;
+  TF_RETURN_IF_ERROR(BackendManager::GetBackendName(backend_device));
+  vector<string> op_types;
+  for (const auto& node : cluster_graph.node()) {
+    op_types.push_back(node.op());
+  }
+  device = ChooseDevice(op_types, backend_device, rules, use_cost_model);
+  return Status::OK();
+}
+
+Status ClusterPlacement::ParseStages(const string& stages,
+                                     vector<string>& parsed) {
+  parsed.clear();
+  stringstream ss(stages);
+  string device;
+  while (getline(ss, device, ',')) {
+    if (device.empty()) continue;
+    TF_RETURN_IF_ERROR(CheckPlacedDevice(device));
+    parsed.push_back(device);
+  }
+  return Status::OK();
+}
+
+Status ClusterPlacement::SetStages(const string& stages) {
+  vector<string> parsed;
+  TF_RETURN_IF_ERROR(ParseStages(stages, parsed));
+  lock_guard<mutex> lock(s_mutex);
+  s_stages = parsed;
+  s_stages_set = !parsed.empty();
+  s_generation++;
+  return Status::OK();
+}
+
+uint64_t ClusterPlacement::Generation() {
+  lock_guard<mutex> lock(s_mutex);
+  return s_generation;
+}
+
+vector<string> ClusterPlacement::GetStages() {
+  {
+    lock_guard<mutex> lock(s_mutex);
+    if (s_stages_set) return s_stages;
+  }
+  vector<string> stages;
+  Status status =
+      ParseStages(util::GetEnv("OPENVINO_TF_PIPELINE_STAGES"), stages);
+  if (!status.ok()) {
+    OVTF_VLOG(0) << "Ignoring OPENVINO_TF_PIPELINE_STAGES: "
+                 << status.error_message();
+    stages.clear();
+  }
+  return stages;
+}
+
+int64_t ClusterPlacement::EstimateCompute(const vector<string>& op_types) {
+  int64_t compute = 0;
+  for (const auto& op_type : op_types) {
+    if (DenseComputeOps().count(op_type)) {
+      compute += kDenseComputeGain;
+    } else if (!FreeOps().count(op_type)) {
+      compute++;
+    }
+  }
+  return compute;
+}
+
+vector<int> ClusterPlacement::AssignStages(const vector<int64_t>& compute,
+                                           int num_stages) {
+  vector<int> stages(compute.size(), 0);
+  int64_t total = 0;
+  for (auto c : compute) total += c;
+  if (num_stages <= 1 || total == 0) return stages;
+  // A cluster goes to the stage its midpoint falls in, which keeps the
+  // stages consecutive
+  int64_t before = 0;
+  for (size_t i = 0; i < compute.size(); i++) {
+    int64_t midpoint = 2 * before + compute[i];
+    stages[i] = std::min<int64_t>(num_stages - 1,
+                                  midpoint * num_stages / (2 * total));
+    before += compute[i];
+  }
+  return stages;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
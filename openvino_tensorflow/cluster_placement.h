@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_CLUSTER_PLACEMENT_H_
+#define OPENVINO_TF_CLUSTER_PLACEMENT_H_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Chooses the device of every cluster, which by default runs on the device
+// of the backend. A cluster can be moved to another device by user rules,
+// "op_type:device" pairs separated by commas, e.g.
+// "NonMaxSuppressionV5:CPU,TopKV2:CPU". The cluster then runs on the device
+// of the rules matching most of its ops, the first rule winning ties.
+//
+// Without a matching rule, when the cost model is enabled, a cluster of a
+// GPU backend runs on the CPU if its estimated GPU gain does not pay for
+// the launch overhead and the post-processing ops, which are slower on the
+// GPU. Dense compute ops gain the most, which keeps the backbones on the
+// GPU while small clusters and the NMS, TopK and Gather clusters move to
+// the CPU.
+//
+// The rules are set through the api or OPENVINO_TF_CLUSTER_PLACEMENT, the
+// cost model is enabled with OPENVINO_TF_CLUSTER_PLACEMENT_COST_MODEL=1.
+//
+// A model made of a sequence of big clusters can instead be split into
+// pipeline stages, a list of devices such as "GPU,CPU": the clusters of a
+// graph, in topological order, are split into consecutive stages of about
+// the same estimated compute, the first stage running on the first device
+// and so on. The clusters of the stages run asynchronously, so that the
+// stage of one step runs while another step is in the next stage. The
+// rules win over the stages. The stages are set through the api or
+// OPENVINO_TF_PIPELINE_STAGES.
+class ClusterPlacement {
+ public:
+  using Rules = std::vector<std::pair<std::string, std::string>>;
+
+  // Parses and sets the rules, an empty string clears them and restores
+  // the ones of OPENVINO_TF_CLUSTER_PLACEMENT
+  static Status SetRules(const std::string& rules);
+  static Status ParseRules(const std::string& rules, Rules& parsed);
+
+  // The device the cluster with the given ops should run on, empty for the
+  // device of the backend
+  static std::string ChooseDevice(const std::vector<std::string>& op_types,
+                                  const std::string& backend_device,
+                                  const Rules& rules, bool use_cost_model);
+
+  // The device of the cluster graph with the current rules and settings,
+  // empty for the device of the backend
+  static Status PlaceCluster(const GraphDef& cluster_graph,
+                             std::string& device);
+
+  // Parses and sets the devices of the pipeline stages, an empty string
+  // clears them and restores the ones of OPENVINO_TF_PIPELINE_STAGES
+  static Status SetStages(const std::string& stages);
+  static Status ParseStages(const std::string& stages,
+                            std::vector<std::string>& parsed);
+  static std::vector<std::string> GetStages();
+  // Changes whenever the rules or the stages are set, and so whenever the
+  // placement of the clusters could change
+  static uint64_t Generation();
+
+  // The estimated compute of a cluster with the given ops, in units of a
+  // simple op
+  static int64_t EstimateCompute(const std::vector<std::string>& op_types);
+  // The stage of every cluster, given in topological order with their
+  // compute, when they are split into num_stages consecutive stages
+  static std::vector<int> AssignStages(const std::vector<int64_t>& compute,
+                                       int num_stages);
+
+ private:
+  static Rules GetRules();
+
+  static std::mutex s_mutex;
+  static bool s_rules_set;
+  static Rules s_rules;
+  static bool s_stages_set;
+  static std::vector<std::string> s_stages;
+  static uint64_t s_generation;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_CLUSTER_PLACEMENT_H_
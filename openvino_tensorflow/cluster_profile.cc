@@ -0,0 +1,271 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include "tensorflow/core/lib/core/errors.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/cluster_profile.h"
+#include "openvino_tensorflow/metrics.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+constexpr int64_t ClusterProfile::kMinSteps;
+constexpr int64_t ClusterProfile::kChurnCompiles;
+constexpr int64_t ClusterProfile::kChurnStepsPerCompile;
+
+static const char* kProfileHeader = "# openvino_tensorflow cluster profile";
+
+ClusterProfile::Verdict ClusterProfile::Entry::GetVerdict() const {
+  // Never ran on OpenVINO, it failed to compile or to execute. The steps
+  // run on TF while compiling, or as cold signatures, are no failures.
+  if (executions == 0 && failures >= kMinSteps) return Verdict::kLost;
+  if (executions >= kMinSteps && tf_steps >= kMinSteps &&
+      tf_micros < ov_micros) {
+    return Verdict::kLost;
+  }
+  if (compiles >= kChurnCompiles &&
+      compiles * kChurnStepsPerCompile >= executions + tf_steps) {
+    return Verdict::kChurn;
+  }
+  if (executions >= kMinSteps && tf_steps >= kMinSteps) return Verdict::kWon;
+  return Verdict::kUnknown;
+}
+
+const char* ClusterProfile::VerdictName(Verdict verdict) {
+  switch (verdict) {
+    case Verdict::kWon:
+      return "won";
+    case Verdict::kLost:
+      return "lost";
+    case Verdict::kChurn:
+      return "churn";
+    default:
+      return "unknown";
+  }
+}
+
+void ClusterProfile::Add(Entry entry) {
+  std::sort(entry.nodes.begin(), entry.nodes.end());
+  for (auto& existing : m_entries) {
+    if (existing.nodes == entry.nodes) {
+      existing = std::move(entry);
+      return;
+    }
+  }
+  m_entries.push_back(std::move(entry));
+}
+
+void ClusterProfile::Merge(const ClusterProfile& newer) {
+  for (const auto& entry : newer.m_entries) Add(entry);
+}
+
+ClusterProfile::Verdict ClusterProfile::Classify(
+    const vector<string>& nodes) const {
+  if (m_entries.empty()) return Verdict::kUnknown;
+  const Entry* best = nullptr;
+  size_t best_overlap = 0;
+  vector<string> sorted(nodes);
+  std::sort(sorted.begin(), sorted.end());
+  for (const auto& entry : m_entries) {
+    size_t overlap = 0;
+    auto it = sorted.begin();
+    for (const auto& name : entry.nodes) {
+      it = std::lower_bound(it, sorted.end(), name);
+      if (it == sorted.end()) break;
+      if (*it == name) overlap++;
+    }
+    if (overlap > best_overlap) {
+      best = &entry;
+      best_overlap = overlap;
+    }
+  }
+  if (best == nullptr || best_overlap * 2 <= best->nodes.size()) {
+    return Verdict::kUnknown;
+  }
+  Verdict verdict = best->GetVerdict();
+  if (verdict == Verdict::kLost && m_lost_expiry > 0 &&
+      std::time(nullptr) - best->updated > m_lost_expiry) {
+    return Verdict::kUnknown;
+  }
+  return verdict;
+}
+
+string ClusterProfile::Serialize() const {
+  ostringstream out;
+  out << kProfileHeader << "\n"
+      << "# executions ov_p50_us tf_steps tf_p50_us failures compiles "
+         "updated nodes...\n";
+  for (const auto& entry : m_entries) {
+    out << entry.executions << " " << entry.ov_micros << " "
+        << entry.tf_steps << " " << entry.tf_micros << " " << entry.failures
+        << " " << entry.compiles << " " << entry.updated;
+    for (const auto& name : entry.nodes) out << " " << name;
+    out << "\n";
+  }
+  return out.str();
+}
+
+Status ClusterProfile::Parse(const string& text, ClusterProfile* profile) {
+  ClusterProfile parsed;
+  istringstream in(text);
+  string line;
+  int line_number = 0;
+  while (std::getline(in, line)) {
+    line_number++;
+    if (line.empty() || line[0] == '#') continue;
+    istringstream fields(line);
+    Entry entry;
+    if (!(fields >> entry.executions >> entry.ov_micros >> entry.tf_steps >>
+          entry.tf_micros >> entry.failures >> entry.compiles >>
+          entry.updated)) {
+      return errors::InvalidArgument("Invalid cluster profile line ",
+                                     line_number, ": ", line);
+    }
+    string name;
+    while (fields >> name) entry.nodes.push_back(name);
+    if (!entry.nodes.empty()) parsed.Add(std::move(entry));
+  }
+  *profile = std::move(parsed);
+  return Status::OK();
+}
+
+Status ClusterProfile::Load(const string& path) {
+  ifstream file(path);
+  if (!file) {
+    m_entries.clear();
+    return Status::OK();
+  }
+  ostringstream text;
+  text << file.rdbuf();
+  return Parse(text.str(), this);
+}
+
+Status ClusterProfile::Save(const string& path) const {
+  // Written under a temporary name so that a loading process never sees a
+  // partial profile
+  string tmp_path = path + ".tmp";
+  {
+    ofstream file(tmp_path);
+    if (!file) return errors::Internal("Failed to create ", tmp_path);
+    file << Serialize();
+    if (!file.good()) {
+      file.close();
+      remove(tmp_path.c_str());
+      return errors::Internal("Failed to write ", tmp_path);
+    }
+  }
+  if (rename(tmp_path.c_str(), path.c_str()) != 0) {
+    remove(tmp_path.c_str());
+    return errors::Internal("Failed to write ", path);
+  }
+  return Status::OK();
+}
+
+vector<string> ClusterProfile::ClusterNodes(const GraphDef& graph) {
+  vector<string> nodes;
+  for (const auto& node : graph.node()) {
+    if (node.op() == "_Arg" || node.op() == "_Retval") continue;
+    nodes.push_back(node.name());
+  }
+  return nodes;
+}
+
+ClusterProfile ClusterProfile::Collect() {
+  vector<pair<size_t, Entry>> clusters;
+  int64_t now = std::time(nullptr);
+  Metrics::ForEachCluster([&clusters, now](size_t cluster,
+                                           const ClusterMetrics& metrics) {
+    Entry entry;
+    entry.executions = metrics.execute_latency.Count();
+    entry.ov_micros = metrics.execute_latency.Percentile(0.5);
+    entry.tf_steps = metrics.tf_latency.Count();
+    entry.tf_micros = metrics.tf_latency.Percentile(0.5);
+    entry.failures = metrics.fallbacks.load(memory_order_relaxed);
+    entry.compiles = metrics.compiles.load(memory_order_relaxed);
+    entry.updated = now;
+    if (entry.executions + entry.tf_steps > 0) {
+      clusters.emplace_back(cluster, std::move(entry));
+    }
+  });
+
+  ClusterProfile profile;
+  for (auto& it : clusters) {
+    // The graph of an evicted cluster is gone
+    GraphDef* graph = NGraphClusterManager::GetClusterGraph(it.first);
+    if (graph == nullptr) continue;
+    it.second.nodes = ClusterNodes(*graph);
+    if (!it.second.nodes.empty()) profile.Add(std::move(it.second));
+  }
+  return profile;
+}
+
+Status ClusterProfile::SaveCollected(const string& path) {
+  string profile_path =
+      path.empty() ? util::GetEnv("OPENVINO_TF_CLUSTER_PROFILE") : path;
+  if (profile_path.empty()) {
+    return errors::InvalidArgument(
+        "No cluster profile path, set OPENVINO_TF_CLUSTER_PROFILE");
+  }
+  ClusterProfile collected = Collect();
+  if (collected.empty()) return Status::OK();
+  // Keeps the clusters of the earlier runs which did not run this time
+  ClusterProfile profile;
+  TF_RETURN_IF_ERROR(profile.Load(profile_path));
+  profile.Merge(collected);
+  TF_RETURN_IF_ERROR(profile.Save(profile_path));
+  OVTF_VLOG(1) << "Saved the profile of " << collected.entries().size()
+               << " clusters to " << profile_path;
+  return Status::OK();
+}
+
+static void SaveAtExit() {
+  Status status = ClusterProfile::SaveCollected("");
+  if (!status.ok()) {
+    OVTF_VLOG(0) << "Failed to save the cluster profile: "
+                 << status.error_message();
+  }
+}
+
+const ClusterProfile& ClusterProfile::Loaded() {
+  static const ClusterProfile* s_profile = []() {
+    ClusterProfile* profile = new ClusterProfile();
+    string path = util::GetEnv("OPENVINO_TF_CLUSTER_PROFILE");
+    if (path.empty()) return profile;
+    Status status = profile->Load(path);
+    if (!status.ok()) {
+      OVTF_VLOG(0) << "Ignoring the cluster profile " << path << ": "
+                   << status.error_message();
+      *profile = ClusterProfile();
+    }
+    int64_t retry_hours = 24;
+    string retry_env = util::GetEnv("OPENVINO_TF_CLUSTER_PROFILE_RETRY_HOURS");
+    if (!retry_env.empty()) retry_hours = std::stoll(retry_env);
+    profile->SetLostExpiry(std::max<int64_t>(retry_hours, 0) * 3600);
+    OVTF_VLOG(1) << "Loaded the profile of " << profile->entries().size()
+                 << " clusters from " << path;
+    // Registered after the metrics registry was created, so that it runs
+    // before the registry is destroyed
+    std::atexit(SaveAtExit);
+    return profile;
+  }();
+  return *s_profile;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_CLUSTER_PROFILE_H_
+#define OPENVINO_TF_CLUSTER_PROFILE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// The runtime profile of the clusters of earlier runs of a model, which
+// steers the clustering of the next runs. Every entry holds the nodes of a
+// cluster, as named in the original graph, with the latencies it had on
+// OpenVINO and on native TF and its number of compilations.
+//
+// DeassignClusters busts the clusters which lost to TF and keeps those
+// which won, or which compiled for many input shapes, whatever its size
+// heuristics say. The kernels of the latter are compiled with dynamic
+// shapes when the device supports them.
+//
+// The profile of OPENVINO_TF_CLUSTER_PROFILE is loaded once, and the
+// metrics of the process are merged into it at exit, on the optimizer
+// feedback and through the api. A lost cluster is retried once its entry
+// is older than OPENVINO_TF_CLUSTER_PROFILE_RETRY_HOURS.
+class ClusterProfile {
+ public:
+  enum class Verdict { kUnknown, kWon, kLost, kChurn };
+
+  struct Entry {
+    // Sorted
+    std::vector<std::string> nodes;
+    // The steps run on OpenVINO and on TF, and their p50 latencies. The
+    // steps run on TF while a signature compiled are not counted.
+    int64_t executions = 0;
+    int64_t ov_micros = 0;
+    int64_t tf_steps = 0;
+    int64_t tf_micros = 0;
+    // The steps run on TF because the cluster or their signature failed
+    int64_t failures = 0;
+    int64_t compiles = 0;
+    // When the entry was collected, in seconds since the epoch
+    int64_t updated = 0;
+
+    Verdict GetVerdict() const;
+  };
+
+  // The steps on each side a comparison of the latencies needs
+  static constexpr int64_t kMinSteps = 3;
+  // A cluster churns when it compiled this many times, at least once every
+  // kChurnStepsPerCompile steps
+  static constexpr int64_t kChurnCompiles = 4;
+  static constexpr int64_t kChurnStepsPerCompile = 4;
+
+  // The age in seconds after which a lost entry is unknown again, so that
+  // its cluster runs on OpenVINO once more. 0 never expires.
+  void SetLostExpiry(int64_t seconds) { m_lost_expiry = seconds; }
+
+  // Replaces the entry with the same nodes
+  void Add(Entry entry);
+  // Adds the entries of newer, which replace the ones sharing their nodes
+  void Merge(const ClusterProfile& newer);
+  // The verdict of the entry sharing most nodes with a cluster, unknown if
+  // the cluster does not hold more than half of its nodes or if the entry
+  // lost and expired
+  Verdict Classify(const std::vector<std::string>& nodes) const;
+
+  const std::vector<Entry>& entries() const { return m_entries; }
+  bool empty() const { return m_entries.empty(); }
+
+  std::string Serialize() const;
+  static Status Parse(const std::string& text, ClusterProfile* profile);
+  // A missing file is an empty profile
+  Status Load(const std::string& path);
+  Status Save(const std::string& path) const;
+
+  // The names of the nodes of a cluster graph, without its arguments and
+  // return values
+  static std::vector<std::string> ClusterNodes(const GraphDef& graph);
+  // The entries of the clusters which ran in this process
+  static ClusterProfile Collect();
+  // The profile of OPENVINO_TF_CLUSTER_PROFILE, empty when unset. Loading
+  // it schedules saving the profile at exit.
+  static const ClusterProfile& Loaded();
+  // Merges the clusters of this process into the profile at path, the one
+  // of OPENVINO_TF_CLUSTER_PROFILE if empty
+  static Status SaveCollected(const std::string& path);
+
+  static const char* VerdictName(Verdict verdict);
+
+ private:
+  std::vector<Entry> m_entries;
+  int64_t m_lost_expiry = 0;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_CLUSTER_PROFILE_H_
@@ -0,0 +1,202 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <map>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/types.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/cluster_cost.h"
+#include "openvino_tensorflow/cluster_topology.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+constexpr size_t ClusterTopology::kMaxReports;
+mutex ClusterTopology::s_mutex;
+deque<string> ClusterTopology::s_reports;
+
+// The cluster of node, -1 for the nodes left to TF
+static int ClusterOf(const Node* node) {
+  int cluster;
+  return GetNodeAttr(node->attrs(), "_ovtf_cluster", &cluster).ok() ? cluster
+                                                                    : -1;
+}
+
+namespace {
+struct ClusterSummary {
+  int num_nodes = 0;
+  map<string, int> ops;
+  double flops = 0;
+  double input_bytes = 0;
+  double output_bytes = 0;
+};
+
+// A tensor crossing a border, sent once to every cluster, or to TF, which
+// reads it
+struct BoundaryTensor {
+  const Node* src;
+  int src_output;
+  int src_cluster;
+  int dst_cluster;
+  vector<string> consumers;
+};
+}  // namespace
+
+string ClusterTopology::BuildReport(const Graph* graph, int graph_id,
+                                    const string& device) {
+  map<int, ClusterSummary> clusters;
+  for (const Node* node : graph->op_nodes()) {
+    int cluster = ClusterOf(node);
+    if (cluster < 0) continue;
+    ClusterSummary& summary = clusters[cluster];
+    summary.num_nodes++;
+    summary.ops[node->type_string()]++;
+  }
+
+  ostringstream out;
+  out << "{\"graph_id\": " << graph_id << ", \"device\": ";
+  util::AppendJsonString(out, device);
+  if (clusters.empty()) {
+    out << ", \"clusters\": [], \"boundary_tensors\": [], \"totals\": {}}";
+    return out.str();
+  }
+
+  ClusterCostModel cost_model(graph, device);
+  map<tuple<const Node*, int, int>, BoundaryTensor> boundary;
+  for (const Node* node : graph->op_nodes()) {
+    int cluster = ClusterOf(node);
+    if (cluster >= 0) clusters[cluster].flops += cost_model.NodeFlops(node);
+    for (const Edge* edge : node->out_edges()) {
+      if (edge->IsControlEdge() || !edge->dst()->IsOp()) continue;
+      int dst_cluster = ClusterOf(edge->dst());
+      if (dst_cluster == cluster) continue;
+      auto key = make_tuple(node, edge->src_output(), dst_cluster);
+      auto it = boundary.find(key);
+      if (it == boundary.end()) {
+        it = boundary
+                 .emplace(key, BoundaryTensor{node, edge->src_output(),
+                                              cluster, dst_cluster, {}})
+                 .first;
+      }
+      it->second.consumers.push_back(edge->dst()->name());
+    }
+  }
+
+  double host_to_device = 0, device_to_host = 0, device_to_device = 0;
+  size_t unknown_shapes = 0;
+  ostringstream tensors;
+  bool first = true;
+  for (const auto& entry : boundary) {
+    const BoundaryTensor& tensor = entry.second;
+    bool known;
+    string shape = cost_model.OutputShape(tensor.src, tensor.src_output,
+                                          &known);
+    double bytes = cost_model.OutputBytes(tensor.src, tensor.src_output);
+    if (!known) unknown_shapes++;
+    if (tensor.src_cluster < 0) {
+      host_to_device += bytes;
+    } else if (tensor.dst_cluster < 0) {
+      device_to_host += bytes;
+    } else {
+      device_to_device += bytes;
+    }
+    if (tensor.src_cluster >= 0) {
+      clusters[tensor.src_cluster].output_bytes += bytes;
+    }
+    if (tensor.dst_cluster >= 0) {
+      clusters[tensor.dst_cluster].input_bytes += bytes;
+    }
+
+    if (!first) tensors << ", ";
+    first = false;
+    tensors << "{\"src\": ";
+    util::AppendJsonString(tensors, tensor.src->name() + ":" +
+                                        to_string(tensor.src_output));
+    tensors << ", \"src_cluster\": " << tensor.src_cluster
+            << ", \"dst_cluster\": " << tensor.dst_cluster
+            << ", \"consumers\": [";
+    for (size_t i = 0; i < tensor.consumers.size(); i++) {
+      if (i > 0) tensors << ", ";
+      util::AppendJsonString(tensors, tensor.consumers[i]);
+    }
+    tensors << "], \"dtype\": ";
+    util::AppendJsonString(
+        tensors,
+        DataTypeString(BaseType(tensor.src->output_type(tensor.src_output))));
+    tensors << ", \"shape\": ";
+    util::AppendJsonString(tensors, shape);
+    tensors << ", \"shape_known\": " << (known ? "true" : "false")
+            << ", \"bytes\": " << static_cast<int64>(bytes) << "}";
+  }
+
+  double total_flops = 0;
+  out << ", \"clusters\": [";
+  first = true;
+  for (const auto& entry : clusters) {
+    const ClusterSummary& summary = entry.second;
+    total_flops += summary.flops;
+    if (!first) out << ", ";
+    first = false;
+    out << "{\"cluster_id\": " << entry.first
+        << ", \"num_nodes\": " << summary.num_nodes << ", \"ops\": {";
+    bool first_op = true;
+    for (const auto& op : summary.ops) {
+      if (!first_op) out << ", ";
+      first_op = false;
+      util::AppendJsonString(out, op.first);
+      out << ": " << op.second;
+    }
+    out << "}, \"estimated_flops\": " << static_cast<int64>(summary.flops)
+        << ", \"input_bytes\": " << static_cast<int64>(summary.input_bytes)
+        << ", \"output_bytes\": " << static_cast<int64>(summary.output_bytes)
+        << "}";
+  }
+  out << "], \"boundary_tensors\": [" << tensors.str() << "], \"totals\": {"
+      << "\"clusters\": " << clusters.size()
+      << ", \"boundary_tensors\": " << boundary.size()
+      << ", \"unknown_shapes\": " << unknown_shapes
+      << ", \"estimated_flops\": " << static_cast<int64>(total_flops)
+      << ", \"host_to_device_bytes\": " << static_cast<int64>(host_to_device)
+      << ", \"device_to_host_bytes\": " << static_cast<int64>(device_to_host)
+      << ", \"device_to_device_bytes\": "
+      << static_cast<int64>(device_to_device) << "}}";
+  return out.str();
+}
+
+void ClusterTopology::Record(const Graph* graph, int graph_id,
+                             const string& device) {
+  string report = BuildReport(graph, graph_id, device);
+  OVTF_VLOG(3) << "Cluster topology of graph " << graph_id << ": " << report;
+  lock_guard<mutex> lock(s_mutex);
+  s_reports.push_back(report);
+  while (s_reports.size() > kMaxReports) s_reports.pop_front();
+}
+
+string ClusterTopology::GetReports() {
+  lock_guard<mutex> lock(s_mutex);
+  string reports = "{\"graphs\": [";
+  for (size_t i = 0; i < s_reports.size(); i++) {
+    if (i > 0) reports += ", ";
+    reports += s_reports[i];
+  }
+  return reports + "]}";
+}
+
+void ClusterTopology::Clear() {
+  lock_guard<mutex> lock(s_mutex);
+  s_reports.clear();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
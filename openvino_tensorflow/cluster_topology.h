@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_CLUSTER_TOPOLOGY_H_
+#define OPENVINO_TF_CLUSTER_TOPOLOGY_H_
+
+#include <deque>
+#include <mutex>
+#include <string>
+
+#include "tensorflow/core/graph/graph.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// The JSON reports of how the rewritten graphs were partitioned, for the
+// tools tuning the clustering. A report lists every cluster with its op
+// histogram and its estimated FLOPs, and every tensor crossing the border
+// of a cluster, with its type, its inferred shape and its bytes per step.
+// The totals give the traffic between TF and the clusters, and between
+// the clusters, that the partitioning implies. The unknown dimensions are
+// counted as 1, the tensors with one are marked "shape_known": false.
+class ClusterTopology {
+ public:
+  // Records the report of graph, whose nodes are assigned their final
+  // clusters, before they are encapsulated
+  static void Record(const Graph* graph, int graph_id,
+                     const std::string& device);
+
+  // The report of graph
+  static std::string BuildReport(const Graph* graph, int graph_id,
+                                 const std::string& device);
+
+  // {"graphs": [...]}, the reports of the last kMaxReports graphs
+  static std::string GetReports();
+  static void Clear();
+
+  static constexpr size_t kMaxReports = 64;
+
+ private:
+  static std::mutex s_mutex;
+  static std::deque<std::string> s_reports;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_CLUSTER_TOPOLOGY_H_
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <sstream>
+
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/hash/hash.h"
+
+#include "openvino_tensorflow/compilation_key.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Separates the shape section of the key from the static input entries
+static const int64 kStaticInputMarker = -1;
+// Takes the place of the rank of a static shape input
+static const int64 kDynamicInputMarker = -2;
+// Takes the place of the stateful dimension of a KV-cache input
+static const int64 kStatefulDimMarker = -3;
+
+void CompilationKey::Append(int64 value) {
+  m_data.push_back(value);
+  m_hash = Hash64Combine(m_hash, static_cast<uint64>(value));
+}
+
+void CompilationKey::AddInput(DataType dtype, const TensorShape& shape) {
+  Append(static_cast<int64>(dtype));
+  Append(shape.dims());
+  for (int i = 0; i < shape.dims(); i++) {
+    Append(shape.dim_size(i));
+  }
+}
+
+void CompilationKey::AddDynamicInput(DataType dtype, int rank) {
+  Append(static_cast<int64>(dtype));
+  Append(kDynamicInputMarker);
+  Append(rank);
+}
+
+void CompilationKey::AddStatefulInput(DataType dtype, const TensorShape& shape,
+                                      int axis) {
+  Append(static_cast<int64>(dtype));
+  Append(shape.dims());
+  for (int i = 0; i < shape.dims(); i++) {
+    Append(i == axis ? kStatefulDimMarker : shape.dim_size(i));
+  }
+}
+
+Status CompilationKey::AddStaticInput(int index, const Tensor& tensor) {
+  if (!DataTypeCanUseMemcpy(tensor.dtype())) {
+    return errors::Internal("CompilationKey got unsupported static input ",
+                            "data type ", DataType_Name(tensor.dtype()));
+  }
+  auto data = tensor.tensor_data();
+  Append(kStaticInputMarker);
+  Append(index);
+  Append(data.size());
+  Append(static_cast<int64>(Hash64(data.data(), data.size())));
+  return Status::OK();
+}
+
+std::string CompilationKey::DebugString() const {
+  std::stringstream ss;
+  ss << std::hex << m_hash << std::dec << ":";
+  for (auto value : m_data) {
+    ss << value << ",";
+  }
+  return ss.str();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
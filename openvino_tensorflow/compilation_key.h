@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_COMPILATION_KEY_H_
+#define OPENVINO_TF_COMPILATION_KEY_H_
+
+#include <string>
+
+#include "absl/container/inlined_vector.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Binary key identifying one compiled executable of an encapsulated
+// cluster. It holds the dtype and dimensions of every input, and a content
+// hash of every static input. The hash of the key is maintained while it is
+// being built, so a cache lookup costs a single hash probe.
+class CompilationKey {
+ public:
+  CompilationKey() : m_hash(0) {}
+
+  // Appends the dtype and shape of the next input
+  void AddInput(DataType dtype, const TensorShape& shape);
+
+  // Appends the dtype and rank of the next input, for executables compiled
+  // with dynamic dimensions
+  void AddDynamicInput(DataType dtype, int rank);
+
+  // Appends the dtype and shape of the next input but for dimension axis,
+  // for the KV-cache inputs whose length the executables do not depend on
+  void AddStatefulInput(DataType dtype, const TensorShape& shape, int axis);
+
+  // Appends the content of the static input at index. Returns an error if
+  // the tensor contents can not be hashed (e.g. string tensors).
+  Status AddStaticInput(int index, const Tensor& tensor);
+
+  size_t Hash() const { return m_hash; }
+
+  bool operator==(const CompilationKey& other) const {
+    return m_hash == other.m_hash && m_data == other.m_data;
+  }
+  bool operator!=(const CompilationKey& other) const {
+    return !(*this == other);
+  }
+
+  std::string DebugString() const;
+
+  struct Hasher {
+    size_t operator()(const CompilationKey& key) const { return key.Hash(); }
+  };
+
+ private:
+  void Append(int64 value);
+
+  // Most clusters have a handful of low rank inputs, which fit inline
+  absl::InlinedVector<int64, 32> m_data;
+  uint64 m_hash;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_COMPILATION_KEY_H_
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <string>
+
+#include "tensorflow/core/lib/core/errors.h"
+
+#include "openvino_tensorflow/compile_properties.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+std::mutex CompileProperties::s_mutex;
+CompileProperties::Map CompileProperties::s_defaults;
+
+const vector<string>& CompileProperties::Keys() {
+  static const vector<string> keys{"performance_mode", "num_streams",
+                                   "inference_num_threads",
+                                   "inference_precision", "num_requests",
+                                   "affinity", "cpu_threading",
+                                   "model_priority"};
+  return keys;
+}
+
+static bool IsCount(const string& value) {
+  return !value.empty() && value.size() < 10 &&
+         std::all_of(value.begin(), value.end(), ::isdigit);
+}
+
+Status CompileProperties::Validate(const string& key, const string& value) {
+  const vector<string>* allowed = nullptr;
+  static const vector<string> modes{"LATENCY", "THROUGHPUT",
+                                    "CUMULATIVE_THROUGHPUT"};
+  static const vector<string> precisions{"f32", "f16", "bf16"};
+  static const vector<string> streams{"AUTO", "NUMA"};
+  static const vector<string> affinities{"NONE", "CORE", "NUMA",
+                                         "HYBRID_AWARE"};
+  static const vector<string> threadings{"DEFAULT", "COOPERATIVE"};
+  static const vector<string> priorities{"LOW", "MEDIUM", "HIGH"};
+  if (key == "performance_mode") {
+    allowed = &modes;
+  } else if (key == "affinity") {
+    allowed = &affinities;
+  } else if (key == "cpu_threading") {
+    allowed = &threadings;
+  } else if (key == "model_priority") {
+    allowed = &priorities;
+  } else if (key == "inference_precision") {
+    allowed = &precisions;
+  } else if (key == "num_streams") {
+    if (IsCount(value)) return Status::OK();
+    allowed = &streams;
+  } else if (key == "inference_num_threads" || key == "num_requests") {
+    if (IsCount(value)) return Status::OK();
+    return errors::InvalidArgument("Compile property ", key,
+                                   " must be a number, got ", value);
+  } else {
+    return errors::InvalidArgument("Unknown compile property ", key);
+  }
+  if (std::find(allowed->begin(), allowed->end(), value) == allowed->end()) {
+    return errors::InvalidArgument("Invalid value ", value,
+                                   " for compile property ", key);
+  }
+  return Status::OK();
+}
+
+Status CompileProperties::SetDefault(const string& key, const string& value) {
+  lock_guard<mutex> lock(s_mutex);
+  if (value.empty()) {
+    s_defaults.erase(key);
+    return Status::OK();
+  }
+  TF_RETURN_IF_ERROR(Validate(key, value));
+  s_defaults[key] = value;
+  return Status::OK();
+}
+
+void CompileProperties::ClearDefaults() {
+  lock_guard<mutex> lock(s_mutex);
+  s_defaults.clear();
+}
+
+CompileProperties::Map CompileProperties::GetDefaults() {
+  lock_guard<mutex> lock(s_mutex);
+  return s_defaults;
+}
+
+ov::AnyMap CompileProperties::ToConfig(const Map& properties) {
+  // The plugins parse the string values of their properties
+  ov::AnyMap config;
+  for (const auto& it : properties) {
+    if (it.first == "performance_mode") {
+      config[ov::hint::performance_mode.name()] = it.second;
+    } else if (it.first == "num_streams") {
+      config[ov::num_streams.name()] = it.second;
+    } else if (it.first == "inference_num_threads") {
+      config[ov::inference_num_threads.name()] = it.second;
+    } else if (it.first == "inference_precision") {
+      config[ov::hint::inference_precision.name()] = it.second;
+    } else if (it.first == "num_requests") {
+      config[ov::hint::num_requests.name()] = it.second;
+    } else if (it.first == "affinity") {
+      config[ov::affinity.name()] = it.second;
+    } else if (it.first == "model_priority") {
+      config[ov::hint::model_priority.name()] = it.second;
+    }
+  }
+  return config;
+}
+
+void CompileProperties::ApplyCpuThreading(const Map& properties,
+                                          int tf_threads, ov::AnyMap& config) {
+  auto threading = properties.find("cpu_threading");
+  if (threading == properties.end() || threading->second != "COOPERATIVE") {
+    return;
+  }
+  if (!properties.count("inference_num_threads")) {
+    config[ov::inference_num_threads.name()] =
+        std::to_string(std::max(tf_threads, 1));
+  }
+  if (!properties.count("num_streams")) {
+    config[ov::num_streams.name()] = "1";
+  }
+  if (!properties.count("affinity")) {
+    config[ov::affinity.name()] = "NONE";
+  }
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_COMPILE_PROPERTIES_H_
+#define OPENVINO_TF_COMPILE_PROPERTIES_H_
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "openvino/openvino.hpp"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// The OpenVINO properties the clusters are compiled with. The process wide
+// defaults are set through the api, and every graph can override them with
+// parameters of the ovtf-optimizer RewriterConfig, which end up as
+// "_ovtf_<key>" attributes of its encapsulate nodes.
+//
+// The supported keys are
+//   performance_mode       ov::hint::performance_mode, LATENCY, THROUGHPUT
+//                          or CUMULATIVE_THROUGHPUT
+//   num_streams            ov::num_streams, a number, AUTO or NUMA
+//   inference_num_threads  ov::inference_num_threads
+//   inference_precision    ov::hint::inference_precision, f32, f16 or bf16
+//   num_requests           ov::hint::num_requests
+//   affinity               ov::affinity of the CPU threads, NONE, CORE, NUMA
+//                          or HYBRID_AWARE
+//   cpu_threading          DEFAULT, or COOPERATIVE to size the CPU plugin
+//                          threads from the TF intra-op pool, see
+//                          ApplyCpuThreading
+//   model_priority         ov::hint::model_priority, LOW, MEDIUM or HIGH,
+//                          also the priority of the inferences in the
+//                          DeviceScheduler
+class CompileProperties {
+ public:
+  using Map = std::map<std::string, std::string>;
+
+  static const std::vector<std::string>& Keys();
+
+  // Checks the key and value and sets the default, an empty value removes
+  // it
+  static Status SetDefault(const std::string& key, const std::string& value);
+  static void ClearDefaults();
+  static Map GetDefaults();
+
+  static Status Validate(const std::string& key, const std::string& value);
+  // The OpenVINO configuration for the properties
+  static ov::AnyMap ToConfig(const Map& properties);
+  // With a COOPERATIVE cpu_threading, makes a CPU executable run a single
+  // stream of tf_threads threads, the size of the TF intra-op pool, without
+  // pinning them, so that the clusters and the TF ops share the cores TF
+  // was configured with instead of each using all of them. The properties
+  // set explicitly are kept.
+  static void ApplyCpuThreading(const Map& properties, int tf_threads,
+                                ov::AnyMap& config);
+
+ private:
+  static std::mutex s_mutex;
+  static Map s_defaults;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_COMPILE_PROPERTIES_H_
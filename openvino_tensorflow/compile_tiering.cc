@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <string>
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/compile_tiering.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+static int64_t ReadCount(const char* env) {
+  string value = util::GetEnv(env);
+  if (value.empty()) return 0;
+  try {
+    return std::stoll(value);
+  } catch (const std::exception&) {
+    OVTF_VLOG(0) << "Ignoring " << env << "=" << value;
+    return 0;
+  }
+}
+
+CompileTiering::Options CompileTiering::Options::FromEnv() {
+  Options options;
+  options.min_steps = ReadCount("OPENVINO_TF_COMPILE_MIN_STEPS");
+  options.min_tf_micros = ReadCount("OPENVINO_TF_COMPILE_MIN_TF_MS") * 1000;
+  return options;
+}
+
+CompileTiering::CompileTiering(const Options& options) : m_options(options) {}
+
+CompileTiering::Counters& CompileTiering::Touch(
+    const CompilationKey& signature) {
+  auto it = m_counters.find(signature);
+  if (it != m_counters.end()) {
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+    return it->second;
+  }
+  while (m_counters.size() >= std::max<size_t>(m_options.max_signatures, 1)) {
+    m_counters.erase(m_lru.back());
+    m_lru.pop_back();
+  }
+  m_lru.push_front(signature);
+  Counters& counters = m_counters[signature];
+  counters.lru = m_lru.begin();
+  return counters;
+}
+
+bool CompileTiering::RecordMiss(const CompilationKey& signature) {
+  lock_guard<mutex> lock(m_mutex);
+  Counters& counters = Touch(signature);
+  counters.steps++;
+  bool hot = counters.hot ||
+             (m_options.min_steps > 0 &&
+              counters.steps >= m_options.min_steps) ||
+             (m_options.min_tf_micros > 0 &&
+              counters.tf_micros >= m_options.min_tf_micros);
+  if (!m_options.Enabled()) hot = true;
+  if (hot && !counters.hot) {
+    OVTF_VLOG(2) << "CompileTiering: signature hot after " << counters.steps
+                 << " steps and " << counters.tf_micros << " us on TF";
+  }
+  counters.hot = hot;
+  return hot;
+}
+
+void CompileTiering::RecordTFTime(const CompilationKey& signature,
+                                  int64_t micros) {
+  lock_guard<mutex> lock(m_mutex);
+  auto it = m_counters.find(signature);
+  if (it != m_counters.end()) it->second.tf_micros += micros;
+}
+
+size_t CompileTiering::Size() {
+  lock_guard<mutex> lock(m_mutex);
+  return m_counters.size();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
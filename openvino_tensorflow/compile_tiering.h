@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_COMPILE_TIERING_H_
+#define OPENVINO_TF_COMPILE_TIERING_H_
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "openvino_tensorflow/compilation_key.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Decides which signatures of a cluster are worth compiling. With highly
+// variable input shapes most signatures are only seen a few times, and each
+// compilation costs far more than running the cluster on TF and evicts a
+// useful executable from the cache. A signature missing the cache runs on
+// TF until it has been seen min_steps times, or until its steps on TF took
+// min_tf_micros in total, and is compiled from then on.
+//
+// The counters of the least recently seen signatures are dropped beyond
+// max_signatures. A signature which was compiled stays hot, so that it is
+// compiled again on its next miss once its executable was evicted. The
+// tiering is thread safe.
+class CompileTiering {
+ public:
+  struct Options {
+    int64_t min_steps = 0;
+    int64_t min_tf_micros = 0;
+    size_t max_signatures = 1024;
+
+    // Reads OPENVINO_TF_COMPILE_MIN_STEPS and OPENVINO_TF_COMPILE_MIN_TF_MS
+    static Options FromEnv();
+    // Whether some signature may run on TF instead of being compiled
+    bool Enabled() const { return min_steps > 1 || min_tf_micros > 0; }
+  };
+
+  explicit CompileTiering(const Options& options);
+
+  // Records a cache miss of signature, returns true when it is hot and
+  // should be compiled
+  bool RecordMiss(const CompilationKey& signature);
+  // Adds the time of a step of a cold signature run on TF
+  void RecordTFTime(const CompilationKey& signature, int64_t micros);
+
+  // The signatures counted
+  size_t Size();
+
+ private:
+  struct Counters {
+    int64_t steps = 0;
+    int64_t tf_micros = 0;
+    bool hot = false;
+    std::list<CompilationKey>::iterator lru;
+  };
+
+  // The counters of signature, created and moved to the front of the LRU
+  // order. Requires m_mutex.
+  Counters& Touch(const CompilationKey& signature);
+
+  Options m_options;
+  std::mutex m_mutex;
+  std::unordered_map<CompilationKey, Counters, CompilationKey::Hasher>
+      m_counters;
+  // The signatures counted, most recently seen first
+  std::list<CompilationKey> m_lru;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_COMPILE_TIERING_H_
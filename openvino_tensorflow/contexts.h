@@ -7,13 +7,25 @@
 #ifndef CONTEXTS_H
 #define CONTEXTS_H
 
+#include <memory>
+#include <mutex>
+
 #include "openvino/openvino.hpp"
 
+#include "openvino_tensorflow/weights_cache.h"
+
 namespace tensorflow {
 namespace openvino_tensorflow {
 
 struct GlobalContext {
   ov::Core ie_core;
+  // The default context of the GPU plugin, in which the outputs passed from
+  // one GPU cluster to another are allocated. Created on first use, null
+  // when there is no GPU.
+  std::once_flag gpu_context_once;
+  std::shared_ptr<ov::RemoteContext> gpu_context;
+  // The buffers of the constants of the translated models
+  WeightsCache weights_cache;
 };
 
 }  // namespace openvino_tensorflow
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <unordered_map>
 
@@ -21,6 +22,8 @@
 #include "logging/ovtf_log.h"
 #include "openvino_tensorflow/assign_clusters.h"
 #include "openvino_tensorflow/backend_manager.h"
+#include "openvino_tensorflow/cluster_cost.h"
+#include "openvino_tensorflow/cluster_profile.h"
 #include "openvino_tensorflow/deassign_clusters.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
 #include "openvino_tensorflow/ovtf_utils.h"
@@ -34,9 +37,14 @@ namespace openvino_tensorflow {
 // The clustering pass of assign_clusters.cc sometimes generates many
 // small, trivial clusters. In this pass, we simply deassign (i.e., remove the
 // _ovtf_cluster and _ovtf_marked_for_clustering attributes) any such
-// trivial clusters. For now, "trivial" just means that there are not at least
-// two non-trivial ops in the graph, where a "trivial op" means "Const" or
-// "Identity".
+// trivial clusters. "Trivial" means that the cost model of cluster_cost.h
+// does not expect the cluster to run faster on OpenVINO than on TF, given
+// its compute, its boundary tensors and the dispatch overhead of a call.
+//
+// The former heuristic, which deassigns the clusters having less than
+// OPENVINO_TF_MIN_NONTRIVIAL_NODES ops other than "Const" or "Identity", is
+// used instead when that variable is set or when
+// OPENVINO_TF_CLUSTER_COST_MODEL=0.
 //
 // For unit testing purposes, this pass can be bypassed by setting
 // OPENVINO_TF_DISABLE_DEASSIGN_CLUSTERS=1.
@@ -161,6 +169,7 @@ Status DeassignClusters(Graph* graph) {
   //
   num_nodes_marked_before_deassign = 0;  // reset for every TF graph
   deassigned_histogram.clear();          // reset the histogram
+  const ClusterProfile& profile = ClusterProfile::Loaded();
 
   if (std::getenv("OPENVINO_TF_DISABLE_DEASSIGN_CLUSTERS") != nullptr) {
     // still need to calculate num_nodes_marked_before_deassign
@@ -197,35 +206,77 @@ Status DeassignClusters(Graph* graph) {
   int max_cluster_size = 0;
   int max_cluster_idx = -1;
 
+  const char* cost_model_env = std::getenv("OPENVINO_TF_CLUSTER_COST_MODEL");
+  bool use_cost_model =
+      std::getenv("OPENVINO_TF_MIN_NONTRIVIAL_NODES") == nullptr &&
+      !(cost_model_env != nullptr && string(cost_model_env) == "0");
+  std::unique_ptr<ClusterCostModel> cost_model;
+  if (use_cost_model && !cluster_map.empty()) {
+    cost_model.reset(new ClusterCostModel(graph, device));
+  }
+
   for (auto& kv : cluster_map) {
     int cluster_idx = kv.first;
     std::set<Node*>& nodes = kv.second;
 
-    int non_trivial_count = 0;
+    // The clusters of the earlier runs decide over the heuristics
+    ClusterProfile::Verdict verdict = ClusterProfile::Verdict::kUnknown;
+    if (!profile.empty()) {
+      std::vector<string> names;
+      for (auto node : nodes) names.push_back(node->name());
+      verdict = profile.Classify(names);
+    }
 
-    std::unordered_set<std::string> trivial_ops = {"Const", "Identitiy"};
-    for (auto node : nodes) {
-      if (trivial_ops.find(node->type_string()) == trivial_ops.end()) {
-        non_trivial_count++;
+    bool trivial;
+    if (verdict != ClusterProfile::Verdict::kUnknown) {
+      trivial = verdict == ClusterProfile::Verdict::kLost;
+      OVTF_VLOG(1) << "Cluster " << cluster_idx << " "
+                   << ClusterProfile::VerdictName(verdict)
+                   << " in the profile"
+                   << (trivial ? ", deassigning it" : ", keeping it");
+      if (api::IsLoggingPlacement()) {
+        std::cout << "OVTF_SUMMARY: Profile of cluster[" << cluster_idx
+                  << "]: " << ClusterProfile::VerdictName(verdict)
+                  << (trivial ? " (deassigned)" : " (kept)") << std::endl;
       }
-    }
+    } else if (cost_model) {
+      ClusterCost cost = cost_model->Estimate(nodes);
+      trivial = !cost.Wins();
+      OVTF_VLOG(1) << "Cluster " << cluster_idx << ": " << cost.ToString()
+                   << (trivial ? ", deassigning it" : ", keeping it");
+      if (api::IsLoggingPlacement()) {
+        std::cout << "OVTF_SUMMARY: Cost of cluster[" << cluster_idx
+                  << "]: " << cost.ToString()
+                  << (trivial ? " (deassigned)" : " (kept)") << std::endl;
+      }
+    } else {
+      int non_trivial_count = 0;
 
-    int min_non_trivial_nodes = num_nodes_marked_before_deassign >> 6;
-    int avg_nodes_marked_before_deassign =
-        num_nodes_marked_before_deassign / cluster_map.size();
-    if (min_non_trivial_nodes < avg_nodes_marked_before_deassign * 2) {
-      min_non_trivial_nodes >>= 2;
-    }
-    if (min_non_trivial_nodes < 6) {
-      min_non_trivial_nodes = 6;
-    }
-    if (std::getenv("OPENVINO_TF_MIN_NONTRIVIAL_NODES") != nullptr) {
-      min_non_trivial_nodes =
-          std::stoi(std::getenv("OPENVINO_TF_MIN_NONTRIVIAL_NODES"));
+      std::unordered_set<std::string> trivial_ops = {"Const", "Identity"};
+      for (auto node : nodes) {
+        if (trivial_ops.find(node->type_string()) == trivial_ops.end()) {
+          non_trivial_count++;
+        }
+      }
+
+      int min_non_trivial_nodes = num_nodes_marked_before_deassign >> 6;
+      int avg_nodes_marked_before_deassign =
+          num_nodes_marked_before_deassign / cluster_map.size();
+      if (min_non_trivial_nodes < avg_nodes_marked_before_deassign * 2) {
+        min_non_trivial_nodes >>= 2;
+      }
+      if (min_non_trivial_nodes < 6) {
+        min_non_trivial_nodes = 6;
+      }
+      if (std::getenv("OPENVINO_TF_MIN_NONTRIVIAL_NODES") != nullptr) {
+        min_non_trivial_nodes =
+            std::stoi(std::getenv("OPENVINO_TF_MIN_NONTRIVIAL_NODES"));
+      }
+      OVTF_VLOG(1) << "MIN_NONTRIVIAL_NODES set to " << min_non_trivial_nodes;
+      trivial = non_trivial_count < min_non_trivial_nodes;
     }
-    OVTF_VLOG(1) << "MIN_NONTRIVIAL_NODES set to " << min_non_trivial_nodes;
 
-    if (non_trivial_count < min_non_trivial_nodes) {
+    if (trivial) {
       OVTF_VLOG(2) << "Busting cluster " << cluster_idx;
       for (auto node : nodes) {
         OVTF_VLOG(2) << "Busting node: " << node->name() << " ["
@@ -0,0 +1,266 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <condition_variable>
+#include <sstream>
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/device_scheduler.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+std::map<std::string, DeviceScheduler::DeviceQueue> DeviceScheduler::s_queues;
+std::map<std::string, size_t> DeviceScheduler::s_configured;
+std::map<std::string, size_t> DeviceScheduler::s_configured_low;
+bool DeviceScheduler::s_configured_read = false;
+std::mutex DeviceScheduler::s_mutex;
+
+// Parses a comma separated list of <device>:<N>, or N for every device
+static void ParseConcurrencies(const char* env,
+                               std::map<std::string, size_t>& concurrencies) {
+  stringstream ss(util::GetEnv(env));
+  string entry;
+  while (getline(ss, entry, ',')) {
+    if (entry.empty()) continue;
+    size_t colon = entry.find(':');
+    string device = colon == string::npos ? "" : entry.substr(0, colon);
+    try {
+      concurrencies[device] = std::stoull(
+          colon == string::npos ? entry : entry.substr(colon + 1));
+    } catch (const std::exception&) {
+      OVTF_VLOG(0) << "Ignoring the " << env << " entry '" << entry
+                   << "', expected device:N or N";
+    }
+  }
+}
+
+DeviceScheduler::Priority DeviceScheduler::ParsePriority(
+    const std::string& priority) {
+  if (priority == "LOW") return Priority::LOW;
+  if (priority == "HIGH") return Priority::HIGH;
+  return Priority::MEDIUM;
+}
+
+void DeviceScheduler::Configure() {
+  if (s_configured_read) return;
+  s_configured_read = true;
+  ParseConcurrencies("OPENVINO_TF_DEVICE_CONCURRENCY", s_configured);
+  ParseConcurrencies("OPENVINO_TF_LOW_PRIORITY_CONCURRENCY", s_configured_low);
+}
+
+const size_t* DeviceScheduler::FindConfigured(
+    const std::map<std::string, size_t>& configured,
+    const std::string& device) {
+  for (const string& key : {device, device.substr(0, device.find('.')),
+                            string("")}) {
+    auto it = configured.find(key);
+    if (it != configured.end()) return &it->second;
+  }
+  return nullptr;
+}
+
+DeviceScheduler::DeviceQueue& DeviceScheduler::GetQueueLocked(
+    const std::string& device) {
+  auto it = s_queues.find(device);
+  if (it != s_queues.end()) return it->second;
+  Configure();
+  DeviceQueue& queue = s_queues[device];
+  if (const size_t* concurrency = FindConfigured(s_configured, device)) {
+    queue.concurrency = *concurrency;
+    queue.configured = true;
+  }
+  if (const size_t* concurrency = FindConfigured(s_configured_low, device)) {
+    queue.low_concurrency = *concurrency;
+  }
+  return queue;
+}
+
+size_t DeviceScheduler::LowConcurrencyLocked(const DeviceQueue& queue) {
+  if (queue.low_concurrency != 0) return queue.low_concurrency;
+  if (queue.concurrency == 0) return 0;
+  return std::max<size_t>(queue.concurrency / 2, 1);
+}
+
+bool DeviceScheduler::CanStartLocked(const DeviceQueue& queue,
+                                     Priority priority) {
+  if (queue.concurrency != 0 && queue.in_flight >= queue.concurrency) {
+    return false;
+  }
+  if (priority != Priority::LOW) return true;
+  size_t low_concurrency = LowConcurrencyLocked(queue);
+  return low_concurrency == 0 || queue.low_in_flight < low_concurrency;
+}
+
+void DeviceScheduler::TakeStartsLocked(DeviceQueue& queue,
+                                       std::deque<StartFunction>& starts) {
+  bool started = true;
+  while (started) {
+    started = false;
+    for (Priority priority :
+         {Priority::HIGH, Priority::MEDIUM, Priority::LOW}) {
+      auto& waiting = queue.waiting[static_cast<int>(priority)];
+      if (waiting.empty() || !CanStartLocked(queue, priority)) continue;
+      starts.push_back(std::move(waiting.front()));
+      waiting.pop_front();
+      queue.in_flight++;
+      if (priority == Priority::LOW) queue.low_in_flight++;
+      started = true;
+      break;
+    }
+  }
+}
+
+void DeviceScheduler::Submit(const std::string& device, StartFunction start,
+                             Priority priority) {
+  {
+    lock_guard<mutex> lock(s_mutex);
+    DeviceQueue& queue = GetQueueLocked(device);
+    // The inferences of the same or a higher priority waiting go first
+    bool queued = false;
+    for (int p = static_cast<int>(priority); p <= 2; p++) {
+      queued = queued || !queue.waiting[p].empty();
+    }
+    if (queued || !CanStartLocked(queue, priority)) {
+      OVTF_VLOG(3) << "DeviceScheduler: " << device << " has "
+                   << queue.in_flight << " inferences in flight, queueing";
+      queue.waiting[static_cast<int>(priority)].push_back(std::move(start));
+      return;
+    }
+    queue.in_flight++;
+    if (priority == Priority::LOW) queue.low_in_flight++;
+  }
+  // The inference is started outside of the lock, its completion may call
+  // Complete from the same thread
+  start();
+}
+
+void DeviceScheduler::Acquire(const std::string& device, Priority priority) {
+  std::mutex mutex;
+  std::condition_variable started_cv;
+  bool started = false;
+  auto start = [&]() {
+    // Notified under the lock, the waiter returns once it is released
+    lock_guard<std::mutex> lock(mutex);
+    started = true;
+    started_cv.notify_one();
+  };
+  Submit(device, start, priority);
+  unique_lock<std::mutex> lock(mutex);
+  started_cv.wait(lock, [&started] { return started; });
+}
+
+void DeviceScheduler::Complete(const std::string& device, Priority priority) {
+  std::deque<StartFunction> starts;
+  {
+    lock_guard<mutex> lock(s_mutex);
+    DeviceQueue& queue = GetQueueLocked(device);
+    if (queue.in_flight > 0) queue.in_flight--;
+    if (priority == Priority::LOW && queue.low_in_flight > 0) {
+      queue.low_in_flight--;
+    }
+    TakeStartsLocked(queue, starts);
+  }
+  for (auto& start : starts) start();
+}
+
+void DeviceScheduler::ReportOptimalRequests(const std::string& device,
+                                            size_t num_requests) {
+  std::deque<StartFunction> starts;
+  {
+    lock_guard<mutex> lock(s_mutex);
+    DeviceQueue& queue = GetQueueLocked(device);
+    if (queue.configured || num_requests <= queue.concurrency) return;
+    OVTF_VLOG(1) << "DeviceScheduler: concurrency of " << device << " "
+                 << num_requests;
+    queue.concurrency = num_requests;
+    TakeStartsLocked(queue, starts);
+  }
+  for (auto& start : starts) start();
+}
+
+void DeviceScheduler::SetConcurrency(const std::string& device,
+                                     size_t concurrency) {
+  std::deque<StartFunction> starts;
+  {
+    lock_guard<mutex> lock(s_mutex);
+    DeviceQueue& queue = GetQueueLocked(device);
+    queue.concurrency = concurrency;
+    queue.configured = true;
+    TakeStartsLocked(queue, starts);
+  }
+  OVTF_VLOG(1) << "DeviceScheduler: concurrency of " << device << " set to "
+               << concurrency;
+  for (auto& start : starts) start();
+}
+
+size_t DeviceScheduler::GetConcurrency(const std::string& device) {
+  lock_guard<mutex> lock(s_mutex);
+  return GetQueueLocked(device).concurrency;
+}
+
+void DeviceScheduler::SetLowPriorityConcurrency(const std::string& device,
+                                                size_t concurrency) {
+  std::deque<StartFunction> starts;
+  {
+    lock_guard<mutex> lock(s_mutex);
+    DeviceQueue& queue = GetQueueLocked(device);
+    queue.low_concurrency = concurrency;
+    TakeStartsLocked(queue, starts);
+  }
+  for (auto& start : starts) start();
+}
+
+size_t DeviceScheduler::GetLowPriorityConcurrency(const std::string& device) {
+  lock_guard<mutex> lock(s_mutex);
+  return LowConcurrencyLocked(GetQueueLocked(device));
+}
+
+size_t DeviceScheduler::InFlight(const std::string& device) {
+  lock_guard<mutex> lock(s_mutex);
+  return GetQueueLocked(device).in_flight;
+}
+
+size_t DeviceScheduler::Waiting(const std::string& device) {
+  lock_guard<mutex> lock(s_mutex);
+  const DeviceQueue& queue = GetQueueLocked(device);
+  size_t waiting = 0;
+  for (const auto& priority_waiting : queue.waiting) {
+    waiting += priority_waiting.size();
+  }
+  return waiting;
+}
+
+size_t DeviceScheduler::LowPriorityInFlight(const std::string& device) {
+  lock_guard<mutex> lock(s_mutex);
+  return GetQueueLocked(device).low_in_flight;
+}
+
+void DeviceScheduler::Clear() {
+  lock_guard<mutex> lock(s_mutex);
+  for (auto it = s_queues.begin(); it != s_queues.end();) {
+    const DeviceQueue& queue = it->second;
+    bool waiting = false;
+    for (const auto& priority_waiting : queue.waiting) {
+      waiting = waiting || !priority_waiting.empty();
+    }
+    if (queue.in_flight == 0 && !waiting) {
+      it = s_queues.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  s_configured.clear();
+  s_configured_low.clear();
+  s_configured_read = false;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
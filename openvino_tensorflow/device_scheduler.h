@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_DEVICE_SCHEDULER_H_
+#define OPENVINO_TF_DEVICE_SCHEDULER_H_
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Submits the inferences of all the clusters running on a device, so that
+// the independent clusters of a step, like the towers of a model, keep
+// several inference requests in flight on the device at once. The
+// inferences beyond the concurrency of the device wait for the ones in
+// flight to complete. They start by priority, the priority of the model
+// they run, and in the order they were submitted within a priority, so that
+// the inferences of a latency critical model do not queue behind those of
+// a batch model sharing the device.
+//
+// The concurrency of a device is the largest number of inference requests
+// a model compiled for it runs in parallel, and at least 2 so that the
+// device runs one inference while the inputs of the next one are bound.
+// It is set with OPENVINO_TF_DEVICE_CONCURRENCY, a comma separated list of
+// <device>:<N>, or a single N for every device. A concurrency of 0 does not
+// bound the inferences.
+//
+// The low priority inferences in flight are further bounded, to half the
+// concurrency of their device by default, so that the device always has
+// room for the higher priority ones. The bound is set with
+// OPENVINO_TF_LOW_PRIORITY_CONCURRENCY, in the same format.
+class DeviceScheduler {
+ public:
+  using StartFunction = std::function<void()>;
+
+  enum class Priority { LOW = 0, MEDIUM = 1, HIGH = 2 };
+  // The priority of a model_priority compile property, LOW, MEDIUM or HIGH,
+  // MEDIUM for any other value
+  static Priority ParsePriority(const std::string& priority);
+
+  // Calls start, which starts an asynchronous inference on device, now if
+  // the device has fewer inferences than its concurrency in flight, and
+  // once another one completes otherwise. Complete must be called with the
+  // same priority when the started inference completes.
+  static void Submit(const std::string& device, StartFunction start,
+                     Priority priority = Priority::MEDIUM);
+  // Blocks until a synchronous inference may start on device. Complete
+  // must be called when it completes.
+  static void Acquire(const std::string& device,
+                      Priority priority = Priority::MEDIUM);
+  // Called when an inference of device completes, starts the next ones
+  // waiting. It must not hold a lock the next start functions take.
+  static void Complete(const std::string& device,
+                       Priority priority = Priority::MEDIUM);
+
+  // Counts a synchronous inference of device while in scope
+  class Slot {
+   public:
+    explicit Slot(const std::string& device,
+                  Priority priority = Priority::MEDIUM)
+        : m_device(device), m_priority(priority) {
+      Acquire(m_device, m_priority);
+    }
+    ~Slot() { Complete(m_device, m_priority); }
+
+   private:
+    Slot(const Slot&) = delete;
+    Slot& operator=(const Slot&) = delete;
+    const std::string m_device;
+    const Priority m_priority;
+  };
+
+  // Raises the default concurrency of device to the optimal number of
+  // inference requests of a model compiled for it
+  static void ReportOptimalRequests(const std::string& device,
+                                    size_t num_requests);
+  // Sets the concurrency of device, overriding the default one
+  static void SetConcurrency(const std::string& device, size_t concurrency);
+  static size_t GetConcurrency(const std::string& device);
+  // Sets the bound of the low priority inferences in flight on device, 0
+  // for the default one
+  static void SetLowPriorityConcurrency(const std::string& device,
+                                        size_t concurrency);
+  // The bound in effect, 0 if they are not bounded
+  static size_t GetLowPriorityConcurrency(const std::string& device);
+  // The inferences of device in flight and waiting to start
+  static size_t InFlight(const std::string& device);
+  static size_t Waiting(const std::string& device);
+  static size_t LowPriorityInFlight(const std::string& device);
+  // Forgets the concurrencies set and reported, once no inference is in
+  // flight. Those of OPENVINO_TF_DEVICE_CONCURRENCY and
+  // OPENVINO_TF_LOW_PRIORITY_CONCURRENCY are read again.
+  static void Clear();
+
+ private:
+  struct DeviceQueue {
+    size_t concurrency = 2;
+    // The concurrency was set, the reported optimal requests are ignored
+    bool configured = false;
+    // The bound of the low priority inferences, 0 for the default one
+    size_t low_concurrency = 0;
+    size_t in_flight = 0;
+    size_t low_in_flight = 0;
+    // The start functions waiting, by priority
+    std::deque<StartFunction> waiting[3];
+  };
+
+  // Reads OPENVINO_TF_DEVICE_CONCURRENCY and
+  // OPENVINO_TF_LOW_PRIORITY_CONCURRENCY once. Requires s_mutex.
+  static void Configure();
+  // The entry of device in configured, falling back to its device type and
+  // to the entry of every device
+  static const size_t* FindConfigured(
+      const std::map<std::string, size_t>& configured,
+      const std::string& device);
+  static size_t LowConcurrencyLocked(const DeviceQueue& queue);
+  // An inference of priority may start on queue now
+  static bool CanStartLocked(const DeviceQueue& queue, Priority priority);
+  // The queue of device, created with its configured concurrency. Requires
+  // s_mutex.
+  static DeviceQueue& GetQueueLocked(const std::string& device);
+  // Moves the waiting start functions of queue which can start now to
+  // starts. Requires s_mutex.
+  static void TakeStartsLocked(DeviceQueue& queue,
+                               std::deque<StartFunction>& starts);
+
+  static std::map<std::string, DeviceQueue> s_queues;
+  // The concurrencies read from OPENVINO_TF_DEVICE_CONCURRENCY, "" for
+  // every device
+  static std::map<std::string, size_t> s_configured;
+  static std::map<std::string, size_t> s_configured_low;
+  static bool s_configured_read;
+  static std::mutex s_mutex;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_DEVICE_SCHEDULER_H_
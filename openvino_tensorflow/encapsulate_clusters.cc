@@ -34,7 +34,9 @@
 #include "logging/ovtf_log.h"
 #include "logging/tf_graph_writer.h"
 #include "openvino_tensorflow/assign_clusters.h"
+#include "openvino_tensorflow/backend_manager.h"
 #include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/cluster_placement.h"
 #include "openvino_tensorflow/encapsulate_clusters.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
 #include "openvino_tensorflow/ovtf_builder.h"
@@ -415,6 +417,53 @@ Status Encapsulator::AnalysisPass() {
   return Status::OK();
 }
 
+// The clusters of graph in topological order. Every cluster is contracted
+// into a single vertex of the graph, the back edges of the loops are
+// ignored and the clusters caught in a cycle are left out.
+static std::vector<int> ClustersInTopologicalOrder(Graph* graph) {
+  std::unordered_map<int, int> cluster_vertex;
+  std::vector<int> node_vertex(graph->num_node_ids(), -1);
+  // The cluster of every vertex, -1 for the nodes left to TF
+  std::vector<int> vertex_cluster;
+  for (auto node : graph->nodes()) {
+    int cluster_idx;
+    if (GetNodeCluster(node, &cluster_idx) == Status::OK()) {
+      auto it = cluster_vertex.emplace(cluster_idx, vertex_cluster.size());
+      if (it.second) vertex_cluster.push_back(cluster_idx);
+      node_vertex[node->id()] = it.first->second;
+    } else {
+      node_vertex[node->id()] = vertex_cluster.size();
+      vertex_cluster.push_back(-1);
+    }
+  }
+
+  std::vector<std::vector<int>> successors(vertex_cluster.size());
+  std::vector<int> in_degree(vertex_cluster.size(), 0);
+  for (auto edge : graph->edges()) {
+    if (edge->src()->IsNextIteration()) continue;
+    int src = node_vertex[edge->src()->id()];
+    int dst = node_vertex[edge->dst()->id()];
+    if (src == dst) continue;
+    successors[src].push_back(dst);
+    in_degree[dst]++;
+  }
+
+  std::vector<int> ready;
+  for (size_t v = 0; v < vertex_cluster.size(); v++) {
+    if (in_degree[v] == 0) ready.push_back(v);
+  }
+  std::vector<int> order;
+  while (!ready.empty()) {
+    int v = ready.back();
+    ready.pop_back();
+    if (vertex_cluster[v] >= 0) order.push_back(vertex_cluster[v]);
+    for (int succ : successors[v]) {
+      if (--in_degree[succ] == 0) ready.push_back(succ);
+    }
+  }
+  return order;
+}
+
 Status Encapsulator::RewritePass(
     int graph_id,
     const std::unordered_map<std::string, std::string>& device_config) {
@@ -426,6 +475,33 @@ Status Encapsulator::RewritePass(
     return errors::Internal(
         "In Encapsulator, called RewritePass more than once");
   }
+  string backend_name;
+  TF_RETURN_IF_ERROR(BackendManager::GetBackendName(backend_name));
+
+  // With pipeline stages, the clusters are split in topological order into
+  // consecutive stages of about the same compute
+  std::vector<string> stages = ClusterPlacement::GetStages();
+  std::map<int, string> stage_devices;
+  if (!stages.empty()) {
+    std::vector<int> order = ClustersInTopologicalOrder(graph);
+    std::vector<int64_t> compute;
+    for (int cluster_idx : order) {
+      std::vector<string> op_types;
+      GraphDef* gdef = NGraphClusterManager::GetClusterGraph(cluster_idx);
+      if (gdef != nullptr) {
+        for (const auto& node : gdef->node()) op_types.push_back(node.op());
+      }
+      compute.push_back(ClusterPlacement::EstimateCompute(op_types));
+    }
+    std::vector<int> assigned =
+        ClusterPlacement::AssignStages(compute, stages.size());
+    for (size_t i = 0; i < order.size(); i++) {
+      stage_devices[order[i]] = stages[assigned[i]];
+      OVTF_VLOG(1) << "Cluster " << order[i] << " in pipeline stage "
+                   << assigned[i] << " on " << stages[assigned[i]];
+    }
+  }
+
   // Pass 3: Create encapsulation nodes for all clusters.
   for (auto& kv : device_name_map) {
     int cluster_idx = kv.first;
@@ -492,6 +568,24 @@ Status Encapsulator::RewritePass(
     nb.Attr("_ovtf_static_inputs", static_input_indexes);
 #endif
 
+    // The device of the backend unless the cluster is placed elsewhere
+    string placed_device;
+    TF_RETURN_IF_ERROR(ClusterPlacement::PlaceCluster(
+        *gdef_for_current_encapsulate, placed_device));
+    auto stage = stage_devices.find(cluster_idx);
+    if (stage != stage_devices.end()) {
+      if (placed_device.empty() && stage->second != backend_name) {
+        placed_device = stage->second;
+      }
+      // Releases the TF thread of the step while its stage runs
+      nb.Attr("_ovtf_pipeline_stage", "1");
+    }
+    if (!placed_device.empty()) {
+      OVTF_VLOG(1) << "Placing cluster " << cluster_idx << " on "
+                   << placed_device;
+      nb.Attr("_ovtf_device", placed_device);
+    }
+
     Status status = nb.Finalize(graph, &n);
     TF_RETURN_IF_ERROR(status);
     n->set_assigned_device_name(device_name_map[cluster_idx]);
@@ -576,6 +670,37 @@ Status Encapsulator::RewritePass(
     graph->RemoveNode(node);
   }
 
+  // Pass 7: On GPU, mark the cluster outputs read only by other clusters.
+  // They are allocated as host tensors of the shared GPU context, which the
+  // consuming clusters bind without uploading them again, also when they
+  // are the next pipeline stage.
+  bool gpu_stage = std::find(stages.begin(), stages.end(), "GPU") !=
+                   stages.end();
+  if ((backend_name == "GPU" || gpu_stage) &&
+      util::GetEnv("OPENVINO_TF_GPU_SHARED_TENSORS") == "1") {
+    for (auto& it : cluster_node_map) {
+      Node* node = it.second;
+      std::vector<bool> only_clusters(node->num_outputs(), true);
+      std::vector<bool> consumed(node->num_outputs(), false);
+      for (auto edge : node->out_edges()) {
+        if (edge->IsControlEdge()) continue;
+        consumed[edge->src_output()] = true;
+        if (edge->dst()->type_string() != "_nGraphEncapsulate") {
+          only_clusters[edge->src_output()] = false;
+        }
+      }
+      std::vector<int32> shared_outputs;
+      for (int i = 0; i < node->num_outputs(); i++) {
+        if (consumed[i] && only_clusters[i]) shared_outputs.push_back(i);
+      }
+      if (!shared_outputs.empty()) {
+        OVTF_VLOG(1) << "Cluster " << it.first << " shares "
+                     << shared_outputs.size() << " outputs on the GPU";
+        node->AddAttr("_ovtf_shared_outputs", shared_outputs);
+      }
+    }
+  }
+
   rewrite_done = true;
   return Status::OK();
 }
@@ -4,17 +4,28 @@
  * SPDX-License-Identifier: Apache-2.0
 *****************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
 #include "openvino/opsets/opset.hpp"
 #include "openvino/pass/convert_fp32_to_fp16.hpp"
 #include "openvino/pass/serialize.hpp"
+#include "tensorflow/core/lib/core/errors.h"
 
 #include "logging/ovtf_log.h"
+#include "openvino_tensorflow/backend.h"
+#include "openvino_tensorflow/buffer_pool.h"
 #include "openvino_tensorflow/default_opset.h"
 #include "openvino_tensorflow/executable.h"
+#include "openvino_tensorflow/host_copy.h"
 #include "openvino_tensorflow/ie_basic_engine.h"
 #include "openvino_tensorflow/ie_tensor.h"
 #include "openvino_tensorflow/ie_utils.h"
 #include "openvino_tensorflow/ie_vadm_engine.h"
+#include "openvino_tensorflow/ovtf_builder.h"
 #include "openvino_tensorflow/ovtf_utils.h"
 
 using namespace std;
@@ -22,24 +33,278 @@ using namespace std;
 namespace tensorflow {
 namespace openvino_tensorflow {
 
+// Whether dimension 0 of every parameter and result of the model is dynamic
+static bool HasDynamicBatch(const shared_ptr<ov::Model>& model) {
+  auto dynamic_batch = [](const ov::PartialShape& shape) {
+    return shape.rank().is_static() && shape.rank().get_length() > 0 &&
+           shape[0].is_dynamic();
+  };
+  for (const auto& input : model->inputs()) {
+    if (!dynamic_batch(input.get_partial_shape())) return false;
+  }
+  for (const auto& output : model->outputs()) {
+    if (!dynamic_batch(output.get_partial_shape())) return false;
+  }
+  return true;
+}
+
+// The only node reading output 0 of node, nullptr if there are several
+static shared_ptr<ov::Node> SingleConsumer(const shared_ptr<ov::Node>& node) {
+  auto inputs = node->get_output_target_inputs(0);
+  if (node->get_output_size() != 1 || inputs.size() != 1) return nullptr;
+  return inputs.begin()->get_node()->shared_from_this();
+}
+
+// The values of the constant input 1 of node, a scalar or one value per
+// channel of an NHWC input of rank 4
+static bool ChannelValues(const shared_ptr<ov::Node>& node,
+                          const ov::PartialShape& input_shape,
+                          vector<float>& values) {
+  auto constant =
+      ov::as_type_ptr<opset::Constant>(node->get_input_node_shared_ptr(1));
+  if (constant == nullptr ||
+      node->get_input_element_type(0) != ov::element::f32) {
+    return false;
+  }
+  const ov::Shape& shape = constant->get_shape();
+  const size_t size = ov::shape_size(shape);
+  if (size > 1) {
+    // Only the last dimension has more than one value
+    if (input_shape.rank() != 4 || input_shape[3].is_dynamic() ||
+        input_shape[3].get_length() != size || shape.empty() ||
+        shape.back() != size) {
+      return false;
+    }
+  }
+  values = constant->cast_vector<float>();
+  return size > 0;
+}
+
+// Folds the normalization at the head of an image model, a Convert of an
+// integer input to f32 followed by a Subtract of the mean and a Multiply
+// or Divide by the scale, into the preprocessing steps of the input. The
+// input stays in its integer type, and the plugin fuses the steps into the
+// first layer where it can.
+static void FoldInputPreprocessing(const shared_ptr<ov::Model>& model) {
+  struct Fold {
+    size_t input;
+    ov::element::Type type;
+    vector<float> mean;
+    vector<float> scale;
+  };
+  vector<Fold> folds;
+  const auto& parameters = model->get_parameters();
+  for (size_t i = 0; i < parameters.size(); i++) {
+    const auto& param = parameters[i];
+    const auto type = param->get_element_type();
+    if (type != ov::element::u8 && type != ov::element::i8 &&
+        type != ov::element::u16) {
+      continue;
+    }
+    auto convert = ov::as_type_ptr<opset::Convert>(SingleConsumer(param));
+    if (convert == nullptr ||
+        convert->get_destination_type() != ov::element::f32) {
+      continue;
+    }
+    const ov::PartialShape& shape = param->get_partial_shape();
+    Fold fold{i, type, {}, {}};
+    shared_ptr<ov::Node> last = convert;
+    auto next = SingleConsumer(last);
+    if (ov::is_type<opset::Subtract>(next) &&
+        next->get_input_node_shared_ptr(0) == last &&
+        ChannelValues(next, shape, fold.mean)) {
+      last = next;
+      next = SingleConsumer(last);
+    }
+    if (ov::is_type<opset::Multiply>(next) &&
+        next->get_input_node_shared_ptr(0) == last &&
+        ChannelValues(next, shape, fold.scale)) {
+      // The preprocessing divides by the scale
+      bool invertible = true;
+      for (auto& value : fold.scale) {
+        invertible &= value != 0;
+        value = 1 / value;
+      }
+      if (invertible) {
+        last = next;
+      } else {
+        fold.scale.clear();
+      }
+    } else if (ov::is_type<opset::Divide>(next) &&
+               next->get_input_node_shared_ptr(0) == last &&
+               ChannelValues(next, shape, fold.scale)) {
+      last = next;
+    }
+    if (last == convert) continue;
+
+    // The model reads the normalized input in f32, from which the
+    // preprocessing steps are built back
+    param->set_element_type(ov::element::f32);
+    param->validate_and_infer_types();
+    last->output(0).replace(param->output(0));
+    folds.push_back(std::move(fold));
+    OVTF_VLOG(2) << "Folding the normalization of input "
+                 << param->get_friendly_name() << " into its preprocessing";
+  }
+  if (folds.empty()) return;
+
+  auto proc = ov::preprocess::PrePostProcessor(model);
+  for (const auto& fold : folds) {
+    auto& input = proc.input(fold.input);
+    input.tensor().set_element_type(fold.type);
+    if (fold.mean.size() > 1 || fold.scale.size() > 1) {
+      input.tensor().set_layout("NHWC");
+      input.model().set_layout("NHWC");
+    }
+    input.preprocess().convert_element_type(ov::element::f32);
+    if (fold.mean.size() == 1) {
+      input.preprocess().mean(fold.mean[0]);
+    } else if (!fold.mean.empty()) {
+      input.preprocess().mean(fold.mean);
+    }
+    if (fold.scale.size() == 1) {
+      input.preprocess().scale(fold.scale[0]);
+    } else if (!fold.scale.empty()) {
+      input.preprocess().scale(fold.scale);
+    }
+  }
+  proc.build();
+}
+
+// The axis of the output channels of a weight read by consumer, -1 if the
+// weight is not quantized per channel
+static int WeightChannelAxis(const ov::Input<ov::Node>& consumer,
+                             size_t rank) {
+  const ov::Node* node = consumer.get_node();
+  if (ov::is_type<opset::MatMul>(node)) {
+    if (consumer.get_index() != 1 || rank < 2) return -1;
+    auto matmul = static_cast<const opset::MatMul*>(node);
+    return matmul->get_transpose_b() ? rank - 2 : rank - 1;
+  }
+  if (ov::is_type<opset::Convolution>(node) ||
+      ov::is_type<opset::GroupConvolution>(node)) {
+    return consumer.get_index() == 1 ? 0 : -1;
+  }
+  // The rows of an embedding table
+  if (ov::is_type<opset::Gather>(node)) {
+    return consumer.get_index() == 0 ? 0 : -1;
+  }
+  return -1;
+}
+
+// Stores the f32 constants of at least min_bytes in f16, or in i8 with a
+// scale per output channel for the weights of MatMul, Convolution and
+// Gather, and decompresses them with a Convert, and a Multiply by the
+// scales, which the plugins run on the fly where they support compressed
+// weights. The model then holds a half, or a quarter, of the weights.
+static void CompressWeights(const shared_ptr<ov::Model>& model,
+                            const string& mode, size_t min_bytes) {
+  const bool int8 = mode == "INT8";
+  size_t compressed = 0, saved_bytes = 0;
+  for (const auto& node : model->get_ops()) {
+    auto constant = ov::as_type_ptr<opset::Constant>(node);
+    if (constant == nullptr ||
+        constant->get_element_type() != ov::element::f32 ||
+        constant->get_byte_size() < min_bytes) {
+      continue;
+    }
+    const ov::Shape& shape = constant->get_shape();
+    auto consumers = constant->output(0).get_target_inputs();
+    vector<float> values = constant->cast_vector<float>();
+    ov::Output<ov::Node> decompressed;
+
+    if (int8) {
+      // Every consumer must read it as a weight of the same layout
+      int axis = -2;
+      for (const auto& consumer : consumers) {
+        int consumer_axis = WeightChannelAxis(consumer, shape.size());
+        if (consumer_axis < 0 || (axis != -2 && consumer_axis != axis)) {
+          axis = -1;
+          break;
+        }
+        axis = consumer_axis;
+      }
+      if (axis < 0) continue;
+
+      // Symmetric quantization of every channel, the elements of channel c
+      // are the ones whose index along axis is c
+      const size_t channels = shape[axis];
+      size_t inner = 1;
+      for (size_t d = axis + 1; d < shape.size(); d++) inner *= shape[d];
+      vector<float> scales(channels, 0);
+      for (size_t i = 0; i < values.size(); i++) {
+        float& scale = scales[(i / inner) % channels];
+        scale = max(scale, std::fabs(values[i]));
+      }
+      for (auto& scale : scales) scale = scale > 0 ? scale / 127 : 1;
+      vector<int8_t> quantized(values.size());
+      for (size_t i = 0; i < values.size(); i++) {
+        float q = std::round(values[i] / scales[(i / inner) % channels]);
+        quantized[i] = static_cast<int8_t>(max(-127.f, min(127.f, q)));
+      }
+      ov::Shape scale_shape(shape.size(), 1);
+      scale_shape[axis] = channels;
+      auto weights =
+          make_shared<opset::Constant>(ov::element::i8, shape, quantized);
+      auto convert = make_shared<opset::Convert>(weights, ov::element::f32);
+      convert->get_rt_info()["decompression"] = "";
+      decompressed = make_shared<opset::Multiply>(
+          convert, make_shared<opset::Constant>(ov::element::f32, scale_shape,
+                                                scales));
+    } else {
+      // The values f16 does not represent stay in f32
+      const float kMaxFloat16 = 65504;
+      if (any_of(values.begin(), values.end(),
+                 [&](float value) { return std::fabs(value) > kMaxFloat16; })) {
+        continue;
+      }
+      vector<ov::float16> halves(values.begin(), values.end());
+      auto weights =
+          make_shared<opset::Constant>(ov::element::f16, shape, halves);
+      auto convert = make_shared<opset::Convert>(weights, ov::element::f32);
+      convert->get_rt_info()["decompression"] = "";
+      decompressed = convert;
+    }
+
+    decompressed.get_node()->set_friendly_name(constant->get_friendly_name());
+    for (auto consumer : consumers) {
+      consumer.replace_source_output(decompressed);
+    }
+    compressed++;
+    saved_bytes += constant->get_byte_size() -
+                   ov::shape_size(shape) * (int8 ? 1 : 2);
+  }
+  if (compressed > 0) {
+    OVTF_VLOG(1) << "Compressed " << compressed << " weights of "
+                 << model->get_friendly_name() << " to " << mode
+                 << ", saving " << saved_bytes << " bytes";
+  }
+}
+
 Executable::Executable(shared_ptr<ov::Model> model, string device,
-                       string device_type)
+                       string device_type, const ov::AnyMap& compile_config)
     : m_device{device},
       m_device_type(device_type),
+      m_replicated(!Backend::GetGPUReplicas(device).empty()),
       m_trivial_fn{nullptr},
       m_model(model) {
   OVTF_VLOG(2) << "Checking for unsupported ops";
-  const auto& opset = ov::get_opset7();
+  // The support of the devices is queried before compiling, only the ops
+  // outside of the opsets of the translation are rejected here
+  const auto& opset7 = ov::get_opset7();
+  const auto& opset8 = ov::get_opset8();
   for (const auto& node : model->get_ops()) {
-    if (!opset.contains_op_type(node.get())) {
+    if (!opset7.contains_op_type(node.get()) &&
+        !opset8.contains_op_type(node.get())) {
       OVTF_VLOG(0) << "UNSUPPORTED OP DETECTED: " << node->get_type_info().name;
       throw runtime_error("Detected op " + node->get_name() +
-                          " not belonging to opset7!");
+                          " not belonging to opset7 or opset8!");
     }
   }
 
   OVTF_VLOG(2) << "Checking for unused parameters";
   auto parameters = model->get_parameters();
+  const size_t num_inputs = parameters.size();
   ov::ParameterVector used_parameters;
   for (int i = 0; i < parameters.size(); ++i) {
     OVTF_VLOG(3) << parameters[i];
@@ -51,8 +316,8 @@ Executable::Executable(shared_ptr<ov::Model> model, string device,
     }
   }
   if (parameters.size() != used_parameters.size()) {
-    model = make_shared<ov::Model>(model->get_results(), used_parameters,
-                                   model->get_friendly_name());
+    model = make_shared<ov::Model>(model->get_results(), model->get_sinks(),
+                                   used_parameters, model->get_friendly_name());
   }
 
   // A trivial function is one of
@@ -96,9 +361,9 @@ Executable::Executable(shared_ptr<ov::Model> model, string device,
         ov::replace_node(node, param);
         // OpenVINO doesn't provide a way to set a parameter to an existing
         // function, so we clone the function here...
-        model = make_shared<ov::Model>(model->get_results(),
-                                       ov::ParameterVector{param},
-                                       model->get_friendly_name());
+        model = make_shared<ov::Model>(
+            model->get_results(), model->get_sinks(),
+            ov::ParameterVector{param}, model->get_friendly_name());
         auto ie_tensor = make_shared<IETensor>(element_type, shape);
         ie_tensor->write(constant->get_data_ptr(),
                          shape_size(shape) * element_type.size());
@@ -118,7 +383,21 @@ Executable::Executable(shared_ptr<ov::Model> model, string device,
 
   m_model = model;
 
-  if (m_device_type == "GPU_FP16") {
+  if (util::GetEnv("OPENVINO_TF_FOLD_PREPROCESSING") != "0") {
+    FoldInputPreprocessing(model);
+  }
+
+  // GPU_FP16 converts all the weights to f16 anyway
+  const string compression = util::GetEnv("OPENVINO_TF_WEIGHT_COMPRESSION");
+  if ((compression == "FP16" || compression == "INT8") &&
+      !Backend::IsGPUFP16(m_device_type)) {
+    size_t min_kb = 1024;
+    string min_kb_env = util::GetEnv("OPENVINO_TF_WEIGHT_COMPRESSION_MIN_KB");
+    if (!min_kb_env.empty()) min_kb = std::stoi(min_kb_env);
+    CompressWeights(model, compression, min_kb * 1024);
+  }
+
+  if (Backend::IsGPUFP16(m_device_type)) {
     ov::pass::ConvertFP32ToFP16().run_on_model(model);
     model->validate_nodes_and_infer_types();
 
@@ -150,36 +429,41 @@ Executable::Executable(shared_ptr<ov::Model> model, string device,
   } else {
     m_ie_engine = make_shared<IE_Basic_Engine>(m_model, m_device);
   }
-}
-
-bool Executable::Call(const vector<shared_ptr<ov::Tensor>>& inputs,
-                      vector<shared_ptr<ov::Tensor>>& outputs,
-                      bool multi_req_execution) {
-  if (m_trivial_fn) {
-    OVTF_VLOG(2) << "Calling trivial function with inputs=" << inputs.size()
-                 << " outputs=" << outputs.size();
-    return CallTrivial(inputs, outputs);
+  m_ie_engine->set_device_type(m_device_type);
+  // CPU_BF16 and CPU_FP16 keep the model and its TF inputs and outputs in
+  // fp32, the plugin runs the inference in the lower precision
+  ov::AnyMap config = compile_config;
+  const string precision_hint = ov::hint::inference_precision.name();
+  if (m_device_type == "CPU_BF16" && config.count(precision_hint) == 0) {
+    config[precision_hint] = "bf16";
+  } else if (m_device_type == "CPU_FP16" &&
+             config.count(precision_hint) == 0) {
+    config[precision_hint] = "f16";
   }
+  m_ie_engine->set_compile_config(config);
+  BuildBindingPlan(num_inputs);
 
-  auto model = m_ie_engine->get_model();
-
-  // Check if the number of inputs that the OpenVINO model expects is equal to
-  // the
-  // sum of the
-  // inputs specified and the inputs we hoisted, if any.
-  if (model->inputs().size() > (inputs.size() + m_hoisted_params.size())) {
-    throw runtime_error("Model inputs (" + to_string(model->inputs().size()) +
-                        ") number greater than number of given inputs (" +
-                        to_string(inputs.size() + m_hoisted_params.size()) +
-                        ")");
+  // VAD-M reshapes the model to its own batch size, and the variables of a
+  // stateful model belong to a single sequence
+  if (MicroBatcher::IsEnabled() && m_device != "HDDL" &&
+      m_hoisted_params.empty() && !m_ie_engine->is_stateful() &&
+      HasDynamicBatch(m_ie_engine->get_model())) {
+    OVTF_VLOG(2) << "Enabling micro batching";
+    m_micro_batcher.reset(new MicroBatcher(
+        [this](const vector<shared_ptr<ov::Tensor>>& inputs,
+               vector<shared_ptr<ov::Tensor>>& outputs) {
+          CallEngine(inputs, outputs, false);
+        },
+        MicroBatcher::Options::FromEnv()));
   }
+}
 
-  //  Prepare input blobs
+void Executable::BuildBindingPlan(size_t num_inputs) {
+  auto model = m_ie_engine->get_model();
   auto parameters = model->get_parameters();
-  std::vector<std::shared_ptr<IETensor>> ie_inputs(inputs.size());
-  std::vector<std::string> input_names(inputs.size());
+  m_input_names.assign(num_inputs, "");
   int j = 0;
-  for (int i = 0; i < inputs.size(); i++) {
+  for (int i = 0; i < num_inputs; i++) {
     if (find(m_skipped_inputs.begin(), m_skipped_inputs.end(), i) !=
         m_skipped_inputs.end()) {
       continue;
@@ -189,55 +473,366 @@ bool Executable::Call(const vector<shared_ptr<ov::Tensor>>& inputs,
       OVTF_VLOG(1) << "Skipping unused input " << input_name;
       continue;
     }
-    ie_inputs[i] = nullptr;
-    ie_inputs[i] = static_pointer_cast<IETensor>(inputs[i]);
-    input_names[i] = input_name;
+    m_input_names[i] = input_name;
   }
 
-  std::vector<std::shared_ptr<IETensor>> ie_hoisted_params(
-      m_hoisted_params.size());
-  std::vector<std::string> param_names(m_hoisted_params.size());
-  for (const auto& it : m_hoisted_params) {
-    auto input_name = it.first;
+  m_param_names.assign(m_hoisted_params.size(), "");
+  for (int i = 0; i < m_hoisted_params.size(); i++) {
+    auto input_name = m_hoisted_params[i].first;
     if (m_ie_engine->get_input_idx(input_name) < 0) {
       OVTF_VLOG(1) << "Skipping unused hoisted param " << input_name;
       continue;
     }
-    ie_hoisted_params[j] = nullptr;
-    ie_hoisted_params[j] = static_pointer_cast<IETensor>(it.second);
-    param_names[j++] = input_name;
+    m_param_names[i] = input_name;
   }
 
-  if (outputs.size() == 0 && model->outputs().size() > 0) {
-    outputs.resize(model->outputs().size(), nullptr);
+  for (const auto& result : model->get_results()) {
+    m_output_names.push_back(result->get_friendly_name());
   }
+}
 
-  //  Prepare output blobs
-  auto results = model->get_results();
-  std::vector<std::shared_ptr<IETensor>> ie_outputs(outputs.size());
-  std::vector<std::string> output_names(outputs.size());
-  for (int i = 0; i < results.size(); i++) {
-    if (outputs[i] != nullptr) {
-      ie_outputs[i] = static_pointer_cast<IETensor>(outputs[i]);
+// The largest output allocated to its bound, a cond of Where with many
+// elements bounds its output far above what it produces
+static const size_t kMaxOutputBoundBytes = 16 * 1024 * 1024;
+
+// The bound of a dynamic result: the one recorded by the translation, and
+// the upper bounds of the dimensions of its shape, if they all have one
+static ov::Shape OutputBound(const shared_ptr<ov::op::v0::Result>& result) {
+  const ov::PartialShape& shape = result->get_output_partial_shape(0);
+  if (shape.is_static() || shape.rank().is_dynamic()) return {};
+  ov::Shape bound;
+  bool recorded = Builder::GetOutputBound(result, bound) &&
+                  bound.size() == shape.rank().get_length();
+  if (!recorded) bound.clear();
+  for (size_t i = 0; i < shape.size(); i++) {
+    const auto& interval = shape[i].get_interval();
+    if (interval.has_upper_bound()) {
+      size_t max = interval.get_max_val();
+      bound.resize(shape.size());
+      bound[i] = recorded ? std::min(bound[i], max) : max;
+    } else if (!recorded) {
+      return {};
     }
-    output_names[i] = results[i]->get_friendly_name();
+  }
+  size_t bytes = ov::shape_size(bound) * result->get_element_type().size();
+  if (bytes == 0 || bytes > kMaxOutputBoundBytes) return {};
+  return bound;
+}
+
+void Executable::SetTranslatedResults(const ov::ResultVector& ng_result_list) {
+  m_translated_results = ng_result_list;
+  m_forwardable_inputs.assign(ng_result_list.size(), vector<int>{});
+  for (size_t i = 0; i < ng_result_list.size(); i++) {
+    if (ng_result_list[i] != nullptr) {
+      Builder::GetForwardableInputs(ng_result_list[i],
+                                    m_forwardable_inputs[i]);
+    }
+  }
+  m_output_bounds.assign(ng_result_list.size(), ov::Shape{});
+  if (m_trivial_fn) return;
+  if (util::GetEnv("OPENVINO_TF_PRESIZED_OUTPUTS") == "0") return;
+  // The CPU plugin shrinks the output tensors bound by the caller to the
+  // shape it computes
+  if (m_device.compare(0, 3, "CPU") != 0) return;
+  for (size_t i = 0; i < ng_result_list.size(); i++) {
+    m_output_bounds[i] = OutputBound(ng_result_list[i]);
+    if (!m_output_bounds[i].empty()) {
+      OVTF_VLOG(2) << "Executable: result " << i << " is allocated to "
+                   << m_output_bounds[i];
+    }
+  }
+}
+
+const ov::Shape& Executable::GetOutputBound(int i) const {
+  static const ov::Shape no_bound;
+  return i < m_output_bounds.size() ? m_output_bounds[i] : no_bound;
+}
+
+const vector<int>& Executable::GetForwardableInputs(int i) const {
+  static const vector<int> none;
+  return i < m_forwardable_inputs.size() ? m_forwardable_inputs[i] : none;
+}
+
+Status Executable::BuildConstantOutputs(
+    const std::function<Status(vector<Tensor>&)>& build) {
+  std::lock_guard<std::mutex> lock(m_constant_outputs_mutex);
+  if (m_has_constant_outputs) return Status::OK();
+  vector<Tensor> outputs;
+  TF_RETURN_IF_ERROR(build(outputs));
+  m_constant_outputs = std::move(outputs);
+  m_has_constant_outputs = true;
+  return Status::OK();
+}
+
+void Executable::PrepareCall(const vector<shared_ptr<ov::Tensor>>& inputs,
+                             CallContext& call, bool multi_req_execution) {
+  auto& outputs = call.outputs;
+
+  if (inputs.size() != m_input_names.size()) {
+    throw runtime_error("Model expects " + to_string(m_input_names.size()) +
+                        " inputs, got " + to_string(inputs.size()));
+  }
+
+  //  Prepare input blobs
+  call.ie_inputs.assign(inputs.size(), nullptr);
+  for (int i = 0; i < inputs.size(); i++) {
+    if (!m_input_names[i].empty()) {
+      call.ie_inputs[i] = static_pointer_cast<IETensor>(inputs[i]);
+    }
+  }
+
+  call.ie_hoisted_params.assign(m_hoisted_params.size(), nullptr);
+  for (int i = 0; i < m_hoisted_params.size(); i++) {
+    if (!m_param_names[i].empty()) {
+      call.ie_hoisted_params[i] =
+          static_pointer_cast<IETensor>(m_hoisted_params[i].second);
+    }
+  }
+
+  if (outputs.size() == 0) {
+    outputs.resize(m_output_names.size(), nullptr);
+  }
+  if (outputs.size() != m_output_names.size()) {
+    throw runtime_error("Model produces " + to_string(m_output_names.size()) +
+                        " outputs, got " + to_string(outputs.size()));
+  }
+
+  //  Prepare output blobs
+  call.ie_outputs.resize(outputs.size());
+  for (int i = 0; i < outputs.size(); i++) {
+    call.ie_outputs[i] = static_pointer_cast<IETensor>(outputs[i]);
   }
 
   if (multi_req_execution) {
     m_ie_engine->enable_multi_req_execution();
   }
+}
 
-  m_ie_engine->infer(ie_inputs, input_names, ie_outputs, output_names,
-                     ie_hoisted_params, param_names);
+bool Executable::Call(const vector<shared_ptr<ov::Tensor>>& inputs,
+                      vector<shared_ptr<ov::Tensor>>& outputs,
+                      bool multi_req_execution) {
+  if (m_trivial_fn) {
+    OVTF_VLOG(2) << "Calling trivial function with inputs=" << inputs.size()
+                 << " outputs=" << outputs.size();
+    return CallTrivial(inputs, outputs);
+  }
+
+  if (m_micro_batcher != nullptr && !multi_req_execution) {
+    if (outputs.size() == 0) {
+      outputs.resize(m_output_names.size(), nullptr);
+    }
+    // The inputs the engine does not read, e.g. the static inputs folded
+    // into constants, need not agree on the batch dimension
+    vector<shared_ptr<ov::Tensor>> bound_inputs(inputs.size(), nullptr);
+    for (int i = 0; i < inputs.size() && i < m_input_names.size(); i++) {
+      if (!m_input_names[i].empty()) bound_inputs[i] = inputs[i];
+    }
+    m_micro_batcher->Run(bound_inputs, outputs);
+  } else {
+    CallEngine(inputs, outputs, multi_req_execution);
+  }
+  return true;
+}
+
+void Executable::CallEngine(const vector<shared_ptr<ov::Tensor>>& inputs,
+                            vector<shared_ptr<ov::Tensor>>& outputs,
+                            bool multi_req_execution) {
+  CallContext call;
+  call.outputs = outputs;
+  PrepareCall(inputs, call, multi_req_execution);
+
+  m_ie_engine->infer(call.ie_inputs, m_input_names, call.ie_outputs,
+                     m_output_names, call.ie_hoisted_params, m_param_names);
 
   // Set dynamic output blobs
-  for (int i = 0; i < results.size(); i++) {
+  outputs = call.outputs;
+  for (int i = 0; i < outputs.size(); i++) {
     if (outputs[i] == nullptr) {
-      outputs[i] = ie_outputs[i];
+      outputs[i] = call.ie_outputs[i];
     }
   }
+}
 
-  return true;
+// The chunks of a chunked call in flight at once
+static const size_t kChunksInFlight = 2;
+
+// A tensor sharing rows [start, start + rows) of dimension 0 of tensor
+static shared_ptr<IETensor> RowSlice(const shared_ptr<ov::Tensor>& tensor,
+                                     size_t start, size_t rows) {
+  ov::Shape shape = tensor->get_shape();
+  size_t row_bytes = tensor->get_byte_size() / shape[0];
+  shape[0] = rows;
+  return make_shared<IETensor>(
+      tensor->get_element_type(), shape,
+      static_cast<uint8_t*>(tensor->data()) + start * row_bytes);
+}
+
+void Executable::CallChunked(const vector<shared_ptr<ov::Tensor>>& inputs,
+                             const vector<bool>& batched, size_t chunk_rows,
+                             vector<shared_ptr<ov::Tensor>>& outputs) {
+  if (m_trivial_fn || m_device == "HDDL") {
+    throw runtime_error("The executable can not run in chunks");
+  }
+  size_t batch = 0;
+  for (int i = 0; i < inputs.size(); i++) {
+    if (i >= batched.size() || !batched[i] || inputs[i] == nullptr) continue;
+    const ov::Shape& shape = inputs[i]->get_shape();
+    if (shape.empty() || (batch != 0 && shape[0] != batch)) {
+      throw runtime_error("The batched inputs disagree on dimension 0");
+    }
+    batch = shape[0];
+  }
+  if (batch == 0 || chunk_rows == 0) {
+    throw runtime_error("No batch to run in chunks");
+  }
+  if (outputs.size() != m_output_names.size()) {
+    throw runtime_error("Model produces " + to_string(m_output_names.size()) +
+                        " outputs, got " + to_string(outputs.size()));
+  }
+  for (const auto& output : outputs) {
+    if (output == nullptr || output->get_shape().empty() ||
+        output->get_shape()[0] != batch) {
+      throw runtime_error("The outputs of a chunked call must hold the batch");
+    }
+  }
+
+  // The bindings of a chunk, and for the last one the padded tensors its
+  // rows are copied from and to
+  struct Chunk {
+    size_t start;
+    size_t rows;
+    vector<shared_ptr<ov::Tensor>> inputs;
+    CallContext call;
+  };
+  const size_t num_chunks = (batch + chunk_rows - 1) / chunk_rows;
+  vector<Chunk> chunks(num_chunks);
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t in_flight = 0;
+  std::exception_ptr error = nullptr;
+  auto chunk_done = [&](std::exception_ptr ex) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ex != nullptr && error == nullptr) error = ex;
+    in_flight--;
+    cv.notify_all();
+  };
+
+  for (size_t c = 0; c < num_chunks; c++) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&] { return in_flight < kChunksInFlight; });
+      if (error != nullptr) break;
+      in_flight++;
+    }
+    Chunk& chunk = chunks[c];
+    chunk.start = c * chunk_rows;
+    chunk.rows = std::min(chunk_rows, batch - chunk.start);
+    const bool padded = chunk.rows < chunk_rows;
+    try {
+      chunk.inputs = inputs;
+      for (int i = 0; i < inputs.size(); i++) {
+        if (i >= batched.size() || !batched[i] || inputs[i] == nullptr) {
+          continue;
+        }
+        auto rows = RowSlice(inputs[i], chunk.start, chunk.rows);
+        if (padded) {
+          // The padding rows are zeros
+          ov::Shape shape = rows->get_shape();
+          shape[0] = chunk_rows;
+          auto tensor = make_shared<IETensor>(rows->get_element_type(), shape);
+          std::memset(tensor->data(), 0, tensor->get_byte_size());
+          HostCopy::Copy(tensor->data(), rows->data(), rows->get_byte_size());
+          chunk.inputs[i] = tensor;
+        } else {
+          chunk.inputs[i] = rows;
+        }
+      }
+      chunk.call.outputs.resize(outputs.size());
+      for (int i = 0; i < outputs.size(); i++) {
+        if (padded) {
+          ov::Shape shape = outputs[i]->get_shape();
+          shape[0] = chunk_rows;
+          chunk.call.outputs[i] =
+              make_shared<IETensor>(outputs[i]->get_element_type(), shape);
+        } else {
+          chunk.call.outputs[i] =
+              RowSlice(outputs[i], chunk.start, chunk.rows);
+        }
+      }
+      PrepareCall(chunk.inputs, chunk.call, false);
+    } catch (...) {
+      chunk_done(std::current_exception());
+      break;
+    }
+    m_ie_engine->infer_async(
+        chunk.call.ie_inputs, m_input_names, chunk.call.ie_outputs,
+        m_output_names, chunk.call.ie_hoisted_params, m_param_names,
+        [&, padded, done = &chunk](std::exception_ptr ex) {
+          for (int i = 0; padded && ex == nullptr && i < outputs.size(); i++) {
+            auto rows = RowSlice(outputs[i], done->start, done->rows);
+            HostCopy::Copy(rows->data(), done->call.outputs[i]->data(),
+                           rows->get_byte_size());
+          }
+          chunk_done(ex);
+        });
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  cv.wait(lock, [&] { return in_flight == 0; });
+  if (error != nullptr) std::rethrow_exception(error);
+}
+
+void Executable::CallAsync(const vector<shared_ptr<ov::Tensor>>& inputs,
+                           vector<shared_ptr<ov::Tensor>> outputs,
+                           CallCallback callback, bool multi_req_execution) {
+  if (m_trivial_fn) {
+    std::exception_ptr ex = nullptr;
+    try {
+      CallTrivial(inputs, outputs);
+    } catch (...) {
+      ex = std::current_exception();
+    }
+    callback(ex, outputs);
+    return;
+  }
+
+  // The bindings have to outlive this call, the completion handler keeps
+  // them alive until the engine is done with them
+  auto call = make_shared<CallContext>();
+  call->outputs = std::move(outputs);
+  try {
+    PrepareCall(inputs, *call, multi_req_execution);
+    m_ie_engine->infer_async(
+        call->ie_inputs, m_input_names, call->ie_outputs, m_output_names,
+        call->ie_hoisted_params, m_param_names,
+        [call, callback](std::exception_ptr ex) {
+          // Set dynamic output blobs
+          for (int i = 0; ex == nullptr && i < call->outputs.size(); i++) {
+            if (call->outputs[i] == nullptr) {
+              call->outputs[i] = call->ie_outputs[i];
+            }
+          }
+          callback(ex, call->outputs);
+        });
+  } catch (...) {
+    callback(std::current_exception(), call->outputs);
+  }
+}
+
+int Executable::GetTrivialInputIndex(int i) const {
+  if (m_trivial_fn == nullptr) return -1;
+  auto parent =
+      m_trivial_fn->get_results()[i]->input_value(0).get_node_shared_ptr();
+  auto param = ov::as_type_ptr<opset::Parameter>(parent);
+  // The index in the translated model, which has a parameter per TF input
+  return param == nullptr ? -1 : m_model->get_parameter_index(param);
+}
+
+shared_ptr<opset::Constant> Executable::GetTrivialConstant(int i) const {
+  if (m_trivial_fn == nullptr) return nullptr;
+  auto parent =
+      m_trivial_fn->get_results()[i]->input_value(0).get_node_shared_ptr();
+  return ov::as_type_ptr<opset::Constant>(parent);
 }
 
 bool Executable::CallTrivial(const vector<shared_ptr<ov::Tensor>>& inputs,
@@ -249,11 +844,13 @@ bool Executable::CallTrivial(const vector<shared_ptr<ov::Tensor>>& inputs,
   }
 
   for (int i = 0; i < results.size(); i++) {
-    auto& shape = results[i]->get_shape();
+    auto pshape = results[i]->get_output_partial_shape(0);
+    auto shape = pshape.is_static() ? pshape.to_shape() : ov::Shape{};
     if (count(shape.begin(), shape.end(), 0)) {
       if (outputs[i] == nullptr) {
-        outputs[i] =
-            make_shared<IETensor>(results[i]->get_element_type(), shape);
+        outputs[i] = make_shared<IETensor>(results[i]->get_element_type(),
+                                           shape,
+                                           BufferPool::GetAllocator(m_device));
       }
       OVTF_VLOG(2) << "Skipping model with zero dim result...";
       continue;
@@ -268,18 +865,12 @@ bool Executable::CallTrivial(const vector<shared_ptr<ov::Tensor>>& inputs,
                             " not found in trivial function");
       }
       if (outputs[i] == nullptr) {
-        outputs[i] = make_shared<IETensor>(inputs[index]->get_element_type(),
-                                           inputs[index]->get_shape());
+        // The caller keeps the input alive as long as the output
+        outputs[i] = inputs[index];
+      } else if (outputs[i]->data() != inputs[index]->data()) {
+        auto size = inputs[index]->get_byte_size();
+        HostCopy::Copy(outputs[i]->data(), inputs[index]->data(), size);
       }
-      auto size = inputs[index]->get_byte_size();
-      unsigned char* buf_ptr = new unsigned char[size];
-      // inputs[index]->read(buf_ptr, size);
-      std::copy((uint8_t*)(inputs[index]->data()),
-                ((uint8_t*)(inputs[index]->data())) + size, buf_ptr);
-      // outputs[i]->write(buf_ptr, size);
-      std::copy((uint8_t*)buf_ptr, ((uint8_t*)buf_ptr) + size,
-                (uint8_t*)(outputs[i]->data()));
-      delete[] buf_ptr;
     } else if (ov::is_type<opset::Constant>(parent)) {
       OVTF_VLOG(2) << "Calling constant -> result function...";
       auto constant = ov::as_type_ptr<opset::Constant>(parent);
@@ -307,10 +898,35 @@ bool Executable::CallTrivial(const vector<shared_ptr<ov::Tensor>>& inputs,
 }
 
 void Executable::ExportIR(const string& output_dir) {
-  // if (!m_function || !m_ie_engine) return;
-  // auto& name = m_function->get_friendly_name();
-  // m_network.serialize(output_dir + "/" + name + ".xml",
-  //                    output_dir + "/" + name + ".bin");
+  if (!m_model) return;
+  auto model = m_ie_engine ? m_ie_engine->get_model() : m_model;
+  std::string name = output_dir + "/" + m_model->get_friendly_name();
+  ov::pass::Serialize serializer(name + ".xml", name + ".bin");
+  serializer.run_on_model(model);
+}
+
+void Executable::SetState(const string& name, const ov::Tensor& value) {
+  if (m_trivial_fn) throw runtime_error("A trivial model has no variables");
+  m_ie_engine->set_state(name, value);
+}
+
+void Executable::LoadNetwork() {
+  if (m_ie_engine && m_device != "HDDL") m_ie_engine->load();
+}
+
+size_t Executable::GetNumRequests() {
+  return m_ie_engine ? m_ie_engine->get_optimal_num_requests() : 1;
+}
+
+void Executable::ImportCompiled(const string& path) {
+  if (m_ie_engine) m_ie_engine->set_import_path(path);
+}
+
+void Executable::ExportCompiled(std::ostream& stream) {
+  if (!m_ie_engine) {
+    throw runtime_error("Trivial executables have no compiled model");
+  }
+  m_ie_engine->export_network(stream);
 }
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -6,13 +6,24 @@
 
 #pragma once
 
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "openvino/openvino.hpp"
+#include "tensorflow/core/lib/core/status.h"
 
+#include "openvino_tensorflow/backend_selector.h"
 #include "openvino_tensorflow/ie_backend_engine.h"
+#include "openvino_tensorflow/kv_cache.h"
+#include "openvino_tensorflow/micro_batcher.h"
+#include "openvino_tensorflow/shape_bucketing.h"
+#include "openvino_tensorflow/variable_state.h"
 
 using namespace std;
 
@@ -23,12 +34,37 @@ namespace openvino_tensorflow {
 // OpenVINO Model.
 class Executable {
  public:
-  Executable(shared_ptr<ov::Model> model, string device, string device_type);
+  Executable(shared_ptr<ov::Model> model, string device, string device_type,
+             const ov::AnyMap& compile_config = ov::AnyMap());
   ~Executable() {}
   bool Call(const vector<shared_ptr<ov::Tensor>>& inputs,
             vector<shared_ptr<ov::Tensor>>& outputs,
             bool multi_req_execution = false);
 
+  // Called once an asynchronous call is done, with a null exception pointer
+  // on success and the outputs of the call
+  using CallCallback = std::function<void(
+      std::exception_ptr, vector<shared_ptr<ov::Tensor>>& outputs)>;
+
+  // Starts the execution without waiting for it. The input tensors must stay
+  // alive until callback is called. callback is called exactly once, possibly
+  // from an OpenVINO thread; any error is reported through it.
+  void CallAsync(const vector<shared_ptr<ov::Tensor>>& inputs,
+                 vector<shared_ptr<ov::Tensor>> outputs, CallCallback callback,
+                 bool multi_req_execution = false);
+
+  // Runs a batch larger than the one the executable was compiled for as a
+  // sequence of chunks of chunk_rows rows along dimension 0 of the batched
+  // inputs and of every output. The other inputs are bound whole to every
+  // chunk. Two chunks are in flight on separate infer requests, so that the
+  // upload of a chunk overlaps the inference of the previous one. The
+  // outputs must be allocated to the full batch, the chunks write into
+  // their rows directly; only the last chunk, padded to chunk_rows, is
+  // copied. Blocks until every chunk is done and rethrows the first error.
+  void CallChunked(const vector<shared_ptr<ov::Tensor>>& inputs,
+                   const vector<bool>& batched, size_t chunk_rows,
+                   vector<shared_ptr<ov::Tensor>>& outputs);
+
   const ov::ResultVector& GetResults() { return m_model->get_results(); };
 
   const vector<size_t> GetOutputShape(const int i) {
@@ -43,20 +79,180 @@ class Executable {
     m_ng_output_shapes = ng_output_shapes;
   }
 
-  const vector<ov::Shape> GetOutputShapes() { return m_ng_output_shapes; }
+  // The memory held by the executable once it is loaded, in bytes
+  struct MemoryUsage {
+    // The compiled model, as reported by the device or estimated
+    size_t compiled_bytes = 0;
+    // The input and output buffers of a single infer request
+    size_t io_bytes = 0;
+    size_t num_requests = 1;
+    size_t Total() const { return compiled_bytes + io_bytes * num_requests; }
+  };
+  void SetMemoryUsage(const MemoryUsage& usage) { m_memory_usage = usage; }
+  const MemoryUsage& GetMemoryUsage() const { return m_memory_usage; }
+  // Estimated memory footprint of the executable, in bytes
+  size_t GetMemoryEstimate() const { return m_memory_usage.Total(); }
+  // The bytes reserved on the device for the executable while it compiles,
+  // see ExecutableCache::ReserveDevice. Requires the lock of the cache.
+  void SetReservedBytes(size_t bytes) { m_reserved_bytes = bytes; }
+  size_t GetReservedBytes() const { return m_reserved_bytes; }
+  // The number of infer requests the engine runs in parallel, 1 for the
+  // trivial models and before the model is loaded
+  size_t GetNumRequests();
+
+  // Chooses between this executable and native TF for the calls with its
+  // signature, null unless automatic backend selection is enabled
+  void SetBackendSelector(std::unique_ptr<BackendSelector> selector) {
+    m_backend_selector = std::move(selector);
+  }
+  BackendSelector* GetBackendSelector() { return m_backend_selector.get(); }
+
+  const vector<ov::Shape>& GetOutputShapes() const {
+    return m_ng_output_shapes;
+  }
 
+  const string& GetDevice() const { return m_device; }
+  const string& GetDeviceType() const { return m_device_type; }
+  // Replicated on several GPUs, see Backend::GetGPUReplicas. The tensors
+  // of the shared GPU context belong to the first GPU only.
+  bool IsReplicated() const { return m_replicated; }
+
+  // The results produced by the translation of the TF cluster, before any
+  // device specific transformation was applied to the model. Computes the
+  // output bounds of the dynamic ones.
+  void SetTranslatedResults(const ov::ResultVector& ng_result_list);
+
+  const ov::ResultVector& GetTranslatedResults() {
+    return m_translated_results;
+  }
+
+  // The shape the dynamic translated result i is allocated with before the
+  // inference, which the device shrinks to the shape it computes. Empty
+  // for the static results and those without a bound.
+  const ov::Shape& GetOutputBound(int i) const;
+
+  // The TF inputs whose buffers translated result i may be computed in,
+  // see Builder::GetForwardableInputs. Empty for the results which are
+  // always allocated.
+  const vector<int>& GetForwardableInputs(int i) const;
+
+  // The outputs sliced back after a call with padded inputs, see
+  // ShapeBucketing::FindOutputDims
+  void SetPaddedOutputDims(ShapeBucketing::OutputDims dims) {
+    m_padded_output_dims = std::move(dims);
+  }
+  const ShapeBucketing::OutputDims& GetPaddedOutputDims() const {
+    return m_padded_output_dims;
+  }
+
+  // The variable inputs read by the executable
+  VariableState& GetVariableState() { return m_variable_state; }
+  // Whether the variables were converted to constants of the model, which
+  // makes the executable stale once one of them is written
+  void SetHasConstantVariables(bool value) { m_constant_variables = value; }
+  bool HasConstantVariables() const { return m_constant_variables; }
+
+  // The KV-caches of the executable, null unless the cluster was translated
+  // with its KV-caches held in variables
+  void SetKVCacheState(std::unique_ptr<KVCacheState> state) {
+    m_kv_cache_state = std::move(state);
+  }
+  KVCacheState* GetKVCacheState() { return m_kv_cache_state.get(); }
+  // Sets the variable named name to value, which is copied, before the next
+  // call
+  void SetState(const string& name, const ov::Tensor& value);
+
+  // Compiles the model on the device now instead of on the first call. The
+  // VAD-M engine compiles it for the batch size of the first call.
+  void LoadNetwork();
+
+  // Serializes the model of the executable to output_dir
   void ExportIR(const string& output_dir);
 
+  // Loads the compiled model from the blob at path, written by
+  // ExportCompiled, instead of compiling the model. The model is compiled
+  // if the blob can not be imported.
+  void ImportCompiled(const string& path);
+  // Compiles the model if needed and writes the compiled model to stream.
+  // Throws if the executable has no compiled model.
+  void ExportCompiled(std::ostream& stream);
+
+  // Whether the model is trivial, every result being fed by a parameter or
+  // a constant, or having a zero dimension
+  bool IsTrivial() const { return m_trivial_fn != nullptr; }
+  // The index of the parameter feeding result i of a trivial model, -1 if
+  // it is not fed by a parameter
+  int GetTrivialInputIndex(int i) const;
+  // The constant feeding result i of a trivial model, null if it is not fed
+  // by a constant
+  shared_ptr<ov::op::v0::Constant> GetTrivialConstant(int i) const;
+
+  // The TF tensors holding the constant results of a trivial model, built
+  // once by build and shared by all the steps. The kernels sharing the
+  // executable build them under a lock, the first one to succeed wins. An
+  // uninitialized tensor for the results which are not constants.
+  Status BuildConstantOutputs(
+      const std::function<Status(vector<Tensor>&)>& build);
+  bool HasConstantOutputs() const { return m_has_constant_outputs; }
+  const vector<Tensor>& GetConstantOutputs() const {
+    return m_constant_outputs;
+  }
+
  private:
+  // The engine side bindings of a single call
+  struct CallContext {
+    vector<shared_ptr<ov::Tensor>> outputs;
+    vector<shared_ptr<IETensor>> ie_inputs;
+    vector<shared_ptr<IETensor>> ie_outputs;
+    vector<shared_ptr<IETensor>> ie_hoisted_params;
+  };
+
+  // Resolves once which engine input each of the num_inputs inputs, and
+  // each hoisted parameter, binds to
+  void BuildBindingPlan(size_t num_inputs);
+
+  // Maps the given inputs and call.outputs onto the engine's model
+  void PrepareCall(const vector<shared_ptr<ov::Tensor>>& inputs,
+                   CallContext& call, bool multi_req_execution);
+
   bool CallTrivial(const vector<shared_ptr<ov::Tensor>>& inputs,
                    vector<shared_ptr<ov::Tensor>>& outputs);
 
+  // Runs a single call on the engine, bypassing the micro batcher
+  void CallEngine(const vector<shared_ptr<ov::Tensor>>& inputs,
+                  vector<shared_ptr<ov::Tensor>>& outputs,
+                  bool multi_req_execution);
+
   string m_device;
   string m_device_type;
+  bool m_replicated;
   // This holds the parameters we insert for functions with no input parameters
   vector<pair<string, shared_ptr<ov::Tensor>>> m_hoisted_params;
   vector<int> m_skipped_inputs;
+  // The binding plan, with the engine's friendly name for every input,
+  // hoisted parameter and output. The name is empty for the inputs and
+  // hoisted parameters which are not bound.
+  vector<string> m_input_names;
+  vector<string> m_param_names;
+  vector<string> m_output_names;
   vector<ov::Shape> m_ng_output_shapes;
+  MemoryUsage m_memory_usage;
+  size_t m_reserved_bytes = 0;
+  std::unique_ptr<BackendSelector> m_backend_selector;
+  // Coalesces concurrent synchronous calls, null unless micro batching is
+  // enabled and every input and output of the model has a dynamic batch
+  // dimension
+  std::unique_ptr<MicroBatcher> m_micro_batcher;
+  ov::ResultVector m_translated_results;
+  vector<ov::Shape> m_output_bounds;
+  vector<vector<int>> m_forwardable_inputs;
+  ShapeBucketing::OutputDims m_padded_output_dims;
+  std::mutex m_constant_outputs_mutex;
+  vector<Tensor> m_constant_outputs;
+  std::atomic<bool> m_has_constant_outputs{false};
+  VariableState m_variable_state;
+  bool m_constant_variables = false;
+  std::unique_ptr<KVCacheState> m_kv_cache_state;
   // This keeps track of whether the original function was trivial: either a
   // constant function, an identity function or a zero function
   shared_ptr<ov::Model> m_trivial_fn;
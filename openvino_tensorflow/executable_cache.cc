@@ -0,0 +1,273 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/executable_cache.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+bool ExecutableCache::Lookup(size_t cluster, const CompilationKey& key,
+                             std::shared_ptr<Executable>& executable) {
+  lock_guard<mutex> lock(m_mutex);
+  auto it = m_map.find(EntryKey{cluster, key});
+  if (it == m_map.end()) {
+    m_stats[cluster].misses++;
+    return false;
+  }
+  m_stats[cluster].hits++;
+  if (it->second != m_lru.begin()) {
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+  }
+  executable = it->second->executable;
+  return true;
+}
+
+void ExecutableCache::Insert(size_t cluster, const CompilationKey& key,
+                             std::shared_ptr<Executable> executable,
+                             size_t bytes, size_t max_cluster_items,
+                             std::vector<std::shared_ptr<Executable>>* evicted) {
+  lock_guard<mutex> lock(m_mutex);
+  EntryKey entry_key{cluster, key};
+  auto found = m_map.find(entry_key);
+  if (found != m_map.end()) {
+    Remove(found->second, evicted);
+  }
+  if (executable != nullptr) Release(*executable);
+
+  m_lru.push_front(Entry{cluster, key, std::move(executable), bytes});
+  m_map[entry_key] = m_lru.begin();
+  m_bytes += bytes;
+  auto& stats = m_stats[cluster];
+  stats.entries++;
+  stats.bytes += bytes;
+  // A retried signature compiled
+  if (m_failures.erase(entry_key) > 0) stats.failures--;
+
+  // Oldest entries of this cluster beyond its item limit
+  if (max_cluster_items > 0) {
+    for (auto it = std::prev(m_lru.end());
+         stats.entries > max_cluster_items && it != m_lru.begin();) {
+      auto prev = std::prev(it);
+      if (it->cluster == cluster) Evict(it, evicted);
+      it = prev;
+    }
+  }
+  // Oldest entries of any cluster beyond the byte budget, the new entry is
+  // kept even if it does not fit on its own
+  while (m_budget_bytes > 0 && m_bytes > m_budget_bytes && m_lru.size() > 1) {
+    Evict(std::prev(m_lru.end()), evicted);
+  }
+}
+
+void ExecutableCache::Remove(
+    EntryList::iterator it, std::vector<std::shared_ptr<Executable>>* evicted) {
+  auto& stats = m_stats[it->cluster];
+  stats.entries--;
+  stats.bytes -= it->bytes;
+  m_bytes -= it->bytes;
+  if (evicted != nullptr) evicted->push_back(std::move(it->executable));
+  m_map.erase(EntryKey{it->cluster, it->key});
+  m_lru.erase(it);
+}
+
+void ExecutableCache::Evict(EntryList::iterator it,
+                            std::vector<std::shared_ptr<Executable>>* evicted) {
+  OVTF_VLOG(1) << "OPENVINO_TF_CACHE_PROFILE: Evicting executable of cluster "
+               << it->cluster << " (" << it->bytes << " bytes)";
+  m_stats[it->cluster].evictions++;
+  Remove(it, evicted);
+}
+
+size_t ExecutableCache::RecordFailure(
+    size_t cluster, const CompilationKey& key, int64 now_micros,
+    int64 retry_micros, std::vector<std::shared_ptr<Executable>>* evicted) {
+  lock_guard<mutex> lock(m_mutex);
+  EntryKey entry_key{cluster, key};
+  auto found = m_map.find(entry_key);
+  if (found != m_map.end()) Remove(found->second, evicted);
+
+  auto& stats = m_stats[cluster];
+  auto inserted = m_failures.emplace(entry_key, Failure{0, 0});
+  if (inserted.second) stats.failures++;
+  Failure& failure = inserted.first->second;
+  failure.count++;
+  if (retry_micros <= 0) {
+    failure.retry_micros = std::numeric_limits<int64>::max();
+  } else {
+    // Up to 1024 times the first backoff
+    int64 backoff = retry_micros << std::min(failure.count - 1, 10);
+    failure.retry_micros = now_micros + backoff;
+  }
+  return stats.failures;
+}
+
+bool ExecutableCache::IsFailed(size_t cluster, const CompilationKey& key,
+                               int64 now_micros) {
+  lock_guard<mutex> lock(m_mutex);
+  auto it = m_failures.find(EntryKey{cluster, key});
+  return it != m_failures.end() && now_micros < it->second.retry_micros;
+}
+
+void ExecutableCache::EraseCluster(
+    size_t cluster, std::vector<std::shared_ptr<Executable>>* evicted) {
+  lock_guard<mutex> lock(m_mutex);
+  for (auto it = m_lru.begin(); it != m_lru.end();) {
+    auto next = std::next(it);
+    if (it->cluster == cluster) Remove(it, evicted);
+    it = next;
+  }
+  for (auto it = m_failures.begin(); it != m_failures.end();) {
+    if (it->first.cluster == cluster) {
+      it = m_failures.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  m_stats.erase(cluster);
+}
+
+void ExecutableCache::Clear() {
+  EntryList entries;
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_map.clear();
+    m_failures.clear();
+    m_stats.clear();
+    m_bytes = 0;
+    entries.swap(m_lru);
+  }
+}
+
+size_t ExecutableCache::DeviceBytes(const std::string& device) {
+  lock_guard<mutex> lock(m_mutex);
+  return CachedDeviceBytes(device);
+}
+
+size_t ExecutableCache::CachedDeviceBytes(const std::string& device) {
+  size_t bytes = 0;
+  for (const auto& entry : m_lru) {
+    if (entry.executable && entry.executable->GetDevice() == device) {
+      bytes += entry.bytes;
+    }
+  }
+  return bytes;
+}
+
+size_t ExecutableCache::EvictDevice(
+    const std::string& device, size_t target_bytes,
+    std::vector<std::shared_ptr<Executable>>* evicted) {
+  lock_guard<mutex> lock(m_mutex);
+  return EvictDeviceLocked(device, target_bytes, evicted);
+}
+
+size_t ExecutableCache::EvictDeviceLocked(
+    const std::string& device, size_t target_bytes,
+    std::vector<std::shared_ptr<Executable>>* evicted) {
+  size_t bytes = CachedDeviceBytes(device);
+  // Erasing an entry leaves the iterators to the newer ones valid
+  for (auto it = m_lru.end(); bytes > target_bytes && it != m_lru.begin();) {
+    auto entry = std::prev(it);
+    if (entry->executable && entry->executable->GetDevice() == device) {
+      bytes -= entry->bytes;
+      Evict(entry, evicted);
+    } else {
+      it = entry;
+    }
+  }
+  return bytes;
+}
+
+bool ExecutableCache::ReserveDevice(
+    Executable* executable, const std::string& device, size_t bytes,
+    size_t budget_bytes, size_t reported_bytes, size_t* used_bytes,
+    std::vector<std::shared_ptr<Executable>>* evicted) {
+  lock_guard<mutex> lock(m_mutex);
+  if (executable != nullptr) Release(*executable);
+  size_t cached = CachedDeviceBytes(device);
+  auto found = m_reserved.find(device);
+  size_t reserved = found == m_reserved.end() ? 0 : found->second;
+  // The executables outside of the cache, still used by a kernel or shared
+  // by the clusters, hold the memory the device reports beyond the cache.
+  // The executables being compiled may already hold part of theirs.
+  size_t others = std::max(reported_bytes, cached + reserved) - cached;
+  if (cached + others + bytes > budget_bytes) {
+    size_t target =
+        budget_bytes > bytes + others ? budget_bytes - bytes - others : 0;
+    cached = EvictDeviceLocked(device, target, evicted);
+  }
+  *used_bytes = cached + others;
+  if (cached + others + bytes > budget_bytes) return false;
+  if (executable != nullptr && bytes > 0) {
+    m_reserved[device] += bytes;
+    executable->SetReservedBytes(bytes);
+  }
+  return true;
+}
+
+void ExecutableCache::ReleaseDevice(Executable& executable) {
+  lock_guard<mutex> lock(m_mutex);
+  Release(executable);
+}
+
+void ExecutableCache::Release(Executable& executable) {
+  size_t bytes = executable.GetReservedBytes();
+  if (bytes == 0) return;
+  executable.SetReservedBytes(0);
+  auto it = m_reserved.find(executable.GetDevice());
+  if (it == m_reserved.end()) return;
+  it->second -= std::min(it->second, bytes);
+  if (it->second == 0) m_reserved.erase(it);
+}
+
+size_t ExecutableCache::ReservedBytes(const std::string& device) {
+  lock_guard<mutex> lock(m_mutex);
+  auto it = m_reserved.find(device);
+  return it == m_reserved.end() ? 0 : it->second;
+}
+
+void ExecutableCache::SetBudget(size_t budget_bytes) {
+  lock_guard<mutex> lock(m_mutex);
+  m_budget_bytes = budget_bytes;
+}
+
+size_t ExecutableCache::Size() {
+  lock_guard<mutex> lock(m_mutex);
+  return m_lru.size();
+}
+
+size_t ExecutableCache::Bytes() {
+  lock_guard<mutex> lock(m_mutex);
+  return m_bytes;
+}
+
+ExecutableCache::ClusterStats ExecutableCache::GetClusterStats(
+    size_t cluster) {
+  lock_guard<mutex> lock(m_mutex);
+  auto it = m_stats.find(cluster);
+  return it == m_stats.end() ? ClusterStats() : it->second;
+}
+
+std::string ExecutableCache::DebugString() {
+  lock_guard<mutex> lock(m_mutex);
+  std::stringstream ss;
+  for (const auto& it : m_stats) {
+    ss << "Cluster " << it.first << ": entries " << it.second.entries
+       << " bytes " << it.second.bytes << " hits " << it.second.hits
+       << " misses " << it.second.misses << " evictions "
+       << it.second.evictions << " failures " << it.second.failures << "\n";
+  }
+  return ss.str();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
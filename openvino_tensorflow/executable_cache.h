@@ -0,0 +1,159 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_EXECUTABLE_CACHE_H_
+#define OPENVINO_TF_EXECUTABLE_CACHE_H_
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "openvino_tensorflow/compilation_key.h"
+#include "openvino_tensorflow/executable.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Process wide cache of the compiled executables of all the clusters. The
+// entries are evicted in least-recently-used order across clusters to stay
+// within a byte budget, and within a per-cluster item limit. The cache is
+// thread safe. The clusters are the cache owners of the kernels, see
+// NGraphClusterManager::NewCacheOwner.
+class ExecutableCache {
+ public:
+  struct ClusterStats {
+    size_t entries = 0;
+    size_t bytes = 0;
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+    // The signatures running on TF since they failed
+    size_t failures = 0;
+  };
+
+  // A budget_bytes of 0 means no byte limit
+  explicit ExecutableCache(size_t budget_bytes = 0)
+      : m_budget_bytes(budget_bytes) {}
+
+  bool Lookup(size_t cluster, const CompilationKey& key,
+              std::shared_ptr<Executable>& executable);
+
+  // Inserts the executable with its estimated memory footprint, then evicts
+  // the least recently used entries of the cluster beyond max_cluster_items
+  // and of all clusters beyond the byte budget. The device reservation of
+  // the executable is taken over by its entry. The evicted executables are
+  // appended to evicted, so that they are destroyed outside of the lock.
+  void Insert(size_t cluster, const CompilationKey& key,
+              std::shared_ptr<Executable> executable, size_t bytes,
+              size_t max_cluster_items,
+              std::vector<std::shared_ptr<Executable>>* evicted);
+
+  // Records that the signature key of cluster failed to translate, compile
+  // or execute, and runs on TF from now on, removing its executable. The
+  // signature is retried retry_micros after its first failure, and twice
+  // as late after every later one, never if retry_micros is 0. A signature
+  // compiled again is forgotten. Returns the failed signatures of cluster.
+  size_t RecordFailure(size_t cluster, const CompilationKey& key,
+                       int64 now_micros, int64 retry_micros,
+                       std::vector<std::shared_ptr<Executable>>* evicted);
+  // Whether the signature key of cluster failed and is not retried yet
+  bool IsFailed(size_t cluster, const CompilationKey& key, int64 now_micros);
+
+  // Removes all the executables and failures of a cluster
+  void EraseCluster(size_t cluster,
+                    std::vector<std::shared_ptr<Executable>>* evicted);
+  void Clear();
+
+  // The bytes of the cached executables compiled for device
+  size_t DeviceBytes(const std::string& device);
+  // Evicts the least recently used executables compiled for device until
+  // they hold at most target_bytes. Returns the bytes they still hold.
+  size_t EvictDevice(const std::string& device, size_t target_bytes,
+                     std::vector<std::shared_ptr<Executable>>* evicted);
+  // Reserves bytes on device for an executable being compiled for it, until
+  // the executable is inserted or ReleaseDevice is called, so that
+  // concurrent compilations do not overcommit the device. The least
+  // recently used executables of the device are evicted until the cached
+  // bytes, the reservations and the rest of the reported_bytes the device
+  // uses fit within budget_bytes together with bytes. Returns false,
+  // reserving nothing, if they do not. A null executable only makes room.
+  // Sets used_bytes to what the device uses besides bytes.
+  bool ReserveDevice(Executable* executable, const std::string& device,
+                     size_t bytes, size_t budget_bytes, size_t reported_bytes,
+                     size_t* used_bytes,
+                     std::vector<std::shared_ptr<Executable>>* evicted);
+  // Releases the reservation of an executable which failed to compile
+  void ReleaseDevice(Executable& executable);
+  // The bytes reserved on device for the executables being compiled
+  size_t ReservedBytes(const std::string& device);
+
+  void SetBudget(size_t budget_bytes);
+  size_t Size();
+  size_t Bytes();
+  ClusterStats GetClusterStats(size_t cluster);
+  // One line per cluster with its cached entries, bytes, hits, misses and
+  // evictions
+  std::string DebugString();
+
+ private:
+  struct Entry {
+    size_t cluster;
+    CompilationKey key;
+    std::shared_ptr<Executable> executable;
+    size_t bytes;
+  };
+  using EntryList = std::list<Entry>;
+
+  struct EntryKey {
+    size_t cluster;
+    CompilationKey key;
+    bool operator==(const EntryKey& other) const {
+      return cluster == other.cluster && key == other.key;
+    }
+  };
+  struct EntryKeyHasher {
+    size_t operator()(const EntryKey& k) const {
+      return k.key.Hash() ^ (k.cluster * 0x9e3779b97f4a7c15ULL);
+    }
+  };
+
+  // Remove the entry, which must be valid, with and without counting it as
+  // an eviction. Require m_mutex.
+  void Remove(EntryList::iterator it,
+              std::vector<std::shared_ptr<Executable>>* evicted);
+  void Evict(EntryList::iterator it,
+             std::vector<std::shared_ptr<Executable>>* evicted);
+  // Like DeviceBytes and EvictDevice, and releases the reservation of an
+  // executable. Require m_mutex.
+  size_t CachedDeviceBytes(const std::string& device);
+  size_t EvictDeviceLocked(const std::string& device, size_t target_bytes,
+                           std::vector<std::shared_ptr<Executable>>* evicted);
+  void Release(Executable& executable);
+
+  std::mutex m_mutex;
+  size_t m_budget_bytes;
+  size_t m_bytes = 0;
+  // Most recently used first
+  EntryList m_lru;
+  std::unordered_map<EntryKey, EntryList::iterator, EntryKeyHasher> m_map;
+  std::map<size_t, ClusterStats> m_stats;
+  // The bytes reserved on every device by the executables being compiled
+  std::map<std::string, size_t> m_reserved;
+  // The number of failures of every failed signature and when it is retried
+  struct Failure {
+    int count;
+    int64 retry_micros;
+  };
+  std::unordered_map<EntryKey, Failure, EntryKeyHasher> m_failures;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_EXECUTABLE_CACHE_H_
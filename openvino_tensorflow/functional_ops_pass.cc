@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "tensorflow/core/common_runtime/optimization_registry.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/graph/graph.h"
+
+#include "api.h"
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/mark_for_clustering.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+//
+// TensorFlow lowers the functional control flow ops to Switch and Merge ops
+// before placement, and the clusters can not span those. This pass keeps the
+// If and While ops openvino_tensorflow translates whole to an OpenVINO If or
+// Loop functional, so that the control flow can be clustered with the ops
+// around it. The ops left out of the clusters are run functional by
+// TensorFlow. It is disabled with OPENVINO_TF_FUNCTIONAL_CONTROL_FLOW=0.
+//
+class FunctionalControlFlowPass : public GraphOptimizationPass {
+ public:
+  Status Run(const GraphOptimizationPassOptions& options) override {
+    if (options.graph == nullptr || !api::IsEnabled() ||
+        util::GetEnv("OPENVINO_TF_DISABLE") == "1" ||
+        util::GetEnv("OPENVINO_TF_FUNCTIONAL_CONTROL_FLOW") == "0") {
+      return Status::OK();
+    }
+    Graph* graph = options.graph->get();
+    const FunctionLibraryDefinition& flib =
+        options.flib_def != nullptr ? *options.flib_def : graph->flib_def();
+
+    std::string ov_version;
+#if defined(OPENVINO_2022_1)
+    ov_version = "2022.1.0";
+#endif
+    std::set<std::string> disabled_ops = api::GetDisabledOps();
+    for (Node* node : graph->op_nodes()) {
+      bool lower = false;
+      if (!IsFunctionalControlFlow(node) ||
+          !GetNodeAttr(node->attrs(), "_lower_using_switch_merge", &lower)
+               .ok() ||
+          !lower) {
+        continue;
+      }
+      if (FunctionalOpIsSupported(node, flib, ov_version, disabled_ops)) {
+        OVTF_VLOG(1) << "Keeping " << node->name() << " ("
+                     << node->type_string() << ") functional";
+        node->AddAttr("_lower_using_switch_merge", false);
+      }
+    }
+    return Status::OK();
+  }
+};
+
+}  // namespace openvino_tensorflow
+
+// Before the lowering of the functional ops, registered with priority 10
+REGISTER_OPTIMIZATION(OptimizationPassRegistry::PRE_PLACEMENT, 0,
+                      openvino_tensorflow::FunctionalControlFlowPass);
+}  // namespace tensorflow
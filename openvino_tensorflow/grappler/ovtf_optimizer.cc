@@ -5,6 +5,7 @@
  *******************************************************************************/
 
 #include <iomanip>
+#include <sstream>
 
 #include "absl/synchronization/mutex.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
@@ -14,14 +15,21 @@
 #include "tensorflow/core/grappler/op_types.h"
 #include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
 #include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/protobuf.h"
 
 #include "openvino_tensorflow/api.h"
 #include "openvino_tensorflow/backend_manager.h"
 #include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/cluster_placement.h"
+#include "openvino_tensorflow/cluster_profile.h"
+#include "openvino_tensorflow/cluster_topology.h"
 #include "openvino_tensorflow/grappler/ovtf_optimizer.h"
-
-#include "ocm/include/ocm_nodes_checker.h"
+#include "openvino_tensorflow/lru_cache.h"
+#include "openvino_tensorflow/mark_for_clustering.h"
+#include "openvino_tensorflow/op_support.h"
+#include "openvino_tensorflow/resource_gather.h"
 
 #include <iostream>
 
@@ -30,6 +38,159 @@ using namespace std;
 namespace tensorflow {
 namespace openvino_tensorflow {
 
+// A rewritten graph, along with the clusters it encapsulates
+struct RewriteCacheEntry {
+  GraphDef output;
+  // The generation of the cluster manager the cluster ids belong to
+  uint64_t generation;
+  std::vector<int> cluster_ids;
+  std::vector<GraphDef> cluster_graphs;
+  std::vector<string> cluster_infos;
+};
+
+// The env variables the rewrite depends on
+static const char* const kRewriteEnvVars[] = {
+    "OPENVINO_TF_CLUSTER_COST_MODEL",
+    "OPENVINO_TF_CLUSTER_PLACEMENT",
+    "OPENVINO_TF_CLUSTER_PLACEMENT_COST_MODEL",
+    "OPENVINO_TF_CONSTANT_FOLDING",
+    "OPENVINO_TF_CONVERT_VARIABLES_TO_CONSTANTS",
+    "OPENVINO_TF_DISABLE_DEASSIGN_CLUSTERS",
+    "OPENVINO_TF_GPU_SHARED_TENSORS",
+    "OPENVINO_TF_LAYOUT_PLANNING",
+    "OPENVINO_TF_MIN_NONTRIVIAL_NODES",
+    "OPENVINO_TF_PATTERN_FUSION",
+    "OPENVINO_TF_PIPELINE_STAGES",
+    "OPENVINO_TF_TRANSPOSE_SINKING",
+};
+
+static std::mutex s_rewrite_cache_mutex;
+
+// The rewritten graphs by the fingerprint of their grappler item, bounded by
+// OPENVINO_TF_REWRITE_CACHE_SIZE
+static LRUCache<uint64, std::shared_ptr<RewriteCacheEntry>>& RewriteCache() {
+  static auto* cache = []() {
+    size_t capacity = 16;
+    string capacity_env = util::GetEnv("OPENVINO_TF_REWRITE_CACHE_SIZE");
+    if (!capacity_env.empty()) capacity = std::stoull(capacity_env);
+    return new LRUCache<uint64, std::shared_ptr<RewriteCacheEntry>>(capacity);
+  }();
+  return *cache;
+}
+
+// Fingerprints everything the rewrite of item depends on: the graph and its
+// function library, the nodes to preserve, the backend, the optimizer config,
+// the disabled ops, the env variables, the cluster placement rules and
+// pipeline stages and the ops recorded as unsupported
+static uint64 FingerprintItem(
+    const tensorflow::grappler::GrapplerItem& item, const string& device,
+    const std::unordered_map<std::string, std::string>& config_map) {
+  string serialized;
+  SerializeToStringDeterministic(item.graph, &serialized);
+  std::stringstream ss;
+  ss << "device=" << device << ";";
+  std::map<string, string> config(config_map.begin(), config_map.end());
+  for (const auto& kv : config) ss << kv.first << "=" << kv.second << ";";
+  ss << "disabled=";
+  for (const auto& op : api::GetDisabledOps()) ss << op << ",";
+  ss << ";feed=";
+  for (const auto& feed : item.feed) ss << feed.first << ",";
+  ss << ";fetch=";
+  for (const auto& fetch : item.fetch) ss << fetch << ",";
+  ss << ";keep=";
+  for (const auto& keep : item.keep_ops) ss << keep << ",";
+  ss << ";init=";
+  for (const auto& init : item.init_ops) ss << init << ",";
+  ss << ";";
+  for (const char* env : kRewriteEnvVars) {
+    ss << env << "=" << util::GetEnv(env) << ";";
+  }
+  ss << "placement=" << ClusterPlacement::Generation() << ";";
+  ss << "unsupported=" << OpSupport::TFUnsupportedGeneration();
+  return FingerprintCat64(Fingerprint64(serialized), Fingerprint64(ss.str()));
+}
+
+// Gives the encapsulate nodes of graph the cluster ids of ids, renaming them
+// and their consumers' inputs after their new id
+static void RenumberClusters(GraphDef& graph, const std::map<int, int>& ids) {
+  std::map<string, string> names;
+  for (auto& node : *graph.mutable_node()) {
+    if (node.op() != "_nGraphEncapsulate") continue;
+    auto attr = node.mutable_attr()->find("ovtf_cluster");
+    if (attr == node.mutable_attr()->end()) continue;
+    auto it = ids.find(attr->second.i());
+    if (it == ids.end()) continue;
+    attr->second.set_i(it->second);
+    string name = "ovtf_cluster_" + to_string(it->second);
+    names[node.name()] = name;
+    node.set_name(name);
+  }
+  for (auto& node : *graph.mutable_node()) {
+    for (auto& input : *node.mutable_input()) {
+      bool control = !input.empty() && input[0] == '^';
+      string name = input.substr(control ? 1 : 0);
+      string port;
+      auto colon = name.find(':');
+      if (colon != string::npos) {
+        port = name.substr(colon);
+        name = name.substr(0, colon);
+      }
+      auto it = names.find(name);
+      if (it != names.end()) input = (control ? "^" : "") + it->second + port;
+    }
+  }
+}
+
+// Sets output to the cached rewrite of the item with the given fingerprint,
+// if any. The clusters of a rewrite cached before the clusters were evicted
+// are registered again under fresh ids.
+static bool LookupRewrite(uint64 fingerprint, GraphDef* output) {
+  std::lock_guard<std::mutex> lock(s_rewrite_cache_mutex);
+  std::shared_ptr<RewriteCacheEntry> entry;
+  if (!RewriteCache().Lookup(fingerprint, entry)) return false;
+  uint64_t generation = NGraphClusterManager::Generation();
+  if (entry->generation != generation) {
+    std::map<int, int> ids;
+    for (size_t i = 0; i < entry->cluster_ids.size(); i++) {
+      int new_id = NGraphClusterManager::NewCluster();
+      *NGraphClusterManager::GetClusterGraph(new_id) =
+          entry->cluster_graphs[i];
+      NGraphClusterManager::SetClusterInfo(new_id, entry->cluster_infos[i]);
+      ids[entry->cluster_ids[i]] = new_id;
+      entry->cluster_ids[i] = new_id;
+    }
+    RenumberClusters(entry->output, ids);
+    entry->generation = generation;
+    OVTF_VLOG(1) << "Registered the " << ids.size()
+                 << " clusters of the cached rewrite again";
+  }
+  *output = entry->output;
+  return true;
+}
+
+// Caches output as the rewrite of the item with the given fingerprint
+static void InsertRewrite(uint64 fingerprint, const GraphDef& output) {
+  auto entry = std::make_shared<RewriteCacheEntry>();
+  entry->output = output;
+  entry->generation = NGraphClusterManager::Generation();
+  for (const auto& node : output.node()) {
+    if (node.op() != "_nGraphEncapsulate") continue;
+    auto attr = node.attr().find("ovtf_cluster");
+    if (attr == node.attr().end()) continue;
+    int cluster_idx = attr->second.i();
+    GraphDef* cluster_graph =
+        NGraphClusterManager::GetClusterGraph(cluster_idx);
+    if (cluster_graph == nullptr) return;
+    entry->cluster_ids.push_back(cluster_idx);
+    entry->cluster_graphs.push_back(*cluster_graph);
+    entry->cluster_infos.push_back(
+        NGraphClusterManager::GetClusterInfo(cluster_idx));
+  }
+  std::vector<std::shared_ptr<RewriteCacheEntry>> evicted;
+  std::lock_guard<std::mutex> lock(s_rewrite_cache_mutex);
+  RewriteCache().Insert(fingerprint, entry, &evicted);
+}
+
 Status OVTFOptimizer::Init(
     const tensorflow::RewriterConfig_CustomGraphOptimizer* config) {
   const auto params = config->parameter_map();
@@ -86,6 +247,37 @@ Status OVTFOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
     return Status::OK();
   }
 
+  // A session configured with the "backend" parameter is rewritten for
+  // its backend instead of the one set for the process
+  std::unique_ptr<BackendManager::ScopedBackend> scoped_backend;
+  auto backend_param = m_config_map.find("_ovtf_backend");
+  if (backend_param != m_config_map.end() && !backend_param->second.empty()) {
+    shared_ptr<Backend> backend;
+    string backend_device;
+    TF_RETURN_IF_ERROR(BackendManager::GetBackend(backend_param->second,
+                                                  backend, backend_device));
+    scoped_backend.reset(
+        new BackendManager::ScopedBackend(backend, backend_device));
+  }
+
+  std::string device;
+  Status exec_status = BackendManager::GetBackendName(device);
+  if (exec_status != Status::OK()) {
+    throw runtime_error(exec_status.error_message());
+  }
+
+  // Retracing the same function rewrites the same graph again
+  bool cache_rewrite = RewriteCache().Capacity() > 0;
+  uint64 fingerprint = 0;
+  if (cache_rewrite) {
+    fingerprint = FingerprintItem(item, device, m_config_map);
+    if (LookupRewrite(fingerprint, output)) {
+      OVTF_VLOG(1) << "Reusing the cached rewrite of grappler item "
+                   << item.id;
+      return Status::OK();
+    }
+  }
+
   // TODO: Find out a better way to preserve feed nodes, init_ops and
   // keep_ops instead of just skipping those from clustering.
   // Get nodes to be preserved/skipped
@@ -136,6 +328,9 @@ Status OVTFOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
                            nodes_to_add_identity_to.end());
   std::set<string>& skip_these_nodes = nodes_to_preserve;
 
+  // Embedding lookups of resource variables become clusterable gathers
+  TF_RETURN_IF_ERROR(SplitResourceGathers(&graph, disabled_ops_set));
+
   //
   // Encapsulation: Part that rewrites the graph for nGraph operation.
   //
@@ -153,28 +348,20 @@ Status OVTFOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
 
   // 1. Mark for clustering then, if requested, dump the graphs.
   // OCM call for marking supported nodes
-  std::string device;
-  Status exec_status = BackendManager::GetBackendName(device);
-  if (exec_status != Status::OK()) {
-    throw runtime_error(exec_status.error_message());
-  }
-  const char* device_id(device.c_str());
   std::string ov_version;
 #if defined(OPENVINO_2022_1)
   ov_version = "2022.1";
 #endif
-  ocm::Framework_Names fName = ocm::Framework_Names::TF;
-  ocm::FrameworkNodesChecker FC(fName, device_id, ov_version, &graph);
-  FC.SetDisabledOps(api::GetDisabledOps());
-  std::vector<void*> nodes_list = FC.MarkSupportedNodes();
+  std::vector<Node*> nodes_list;
+  TF_RETURN_IF_ERROR(GetNodesSupportedByBackend(
+      &graph, ov_version, api::GetDisabledOps(), nodes_list));
 
   // cast back the nodes in the TF format and mark the nodes for clustering
   // (moved out from MarkForClustering function)
   const std::map<std::string, SetAttributesFunction>& set_attributes_map =
       GetAttributeSetters();
-  for (auto void_node : nodes_list) {
+  for (auto node : nodes_list) {
     // TODO(amprocte): move attr name to a constant
-    tensorflow::Node* node = (tensorflow::Node*)void_node;
     node->AddAttr("_ovtf_marked_for_clustering", true);
     auto it = set_attributes_map.find(node->type_string());
     if (it != set_attributes_map.end()) {
@@ -189,7 +376,11 @@ Status OVTFOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
 
   // 3. Deassign trivial clusters then, if requested, dump the graphs.
   TF_RETURN_IF_ERROR(DeassignClusters(&graph));
+  TF_RETURN_IF_ERROR(MergeResourceGathers(&graph));
   util::DumpTFGraph(&graph, idx, "declustered");
+  if (util::GetEnv("OPENVINO_TF_CLUSTER_TOPOLOGY") != "0") {
+    ClusterTopology::Record(&graph, idx, device);
+  }
 
   // 4. Encapsulate clusters then, if requested, dump the graphs.
   auto status = EncapsulateClusters(&graph, idx, m_config_map);
@@ -200,13 +391,20 @@ Status OVTFOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
 
   // Convert the graph back to Graphdef
   graph.ToGraphDef(output);
+  if (cache_rewrite) InsertRewrite(fingerprint, *output);
   return Status::OK();
 }
 
 void OVTFOptimizer::Feedback(tensorflow::grappler::Cluster* cluster,
                              const tensorflow::grappler::GrapplerItem& item,
                              const GraphDef& optimize_output, double result) {
-  // no-op
+  // The clusters which ran so far steer the clustering of the next runs
+  if (util::GetEnv("OPENVINO_TF_CLUSTER_PROFILE").empty()) return;
+  Status status = ClusterProfile::SaveCollected("");
+  if (!status.ok()) {
+    OVTF_VLOG(1) << "Failed to save the cluster profile: "
+                 << status.error_message();
+  }
 }
 
 int OVTFOptimizer::FreshIndex() {
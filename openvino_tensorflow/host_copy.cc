@@ -0,0 +1,130 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/threadpool.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/host_copy.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// The copies below are not worth waking up other threads for
+static const size_t kMinParallelBytes = size_t(4) << 20;
+// Each thread copies at least a block of this size
+static const size_t kMinBlockBytes = size_t(2) << 20;
+// The copies above are larger than the last level cache of most hosts
+static const size_t kMinStreamingBytes = size_t(32) << 20;
+static const size_t kCacheLine = 64;
+
+// Copies with non-temporal stores, which write dst without reading it into
+// the cache first
+static void StreamingCopy(char* dst, const char* src, size_t bytes) {
+#if defined(__SSE2__)
+  size_t head = (16 - reinterpret_cast<uintptr_t>(dst) % 16) % 16;
+  head = std::min(head, bytes);
+  memcpy(dst, src, head);
+  dst += head;
+  src += head;
+  bytes -= head;
+  size_t vectors = bytes / 16;
+  auto out = reinterpret_cast<__m128i*>(dst);
+  auto in = reinterpret_cast<const __m128i*>(src);
+  for (size_t i = 0; i < vectors; i++) {
+    _mm_stream_si128(out + i, _mm_loadu_si128(in + i));
+  }
+  memcpy(dst + vectors * 16, src + vectors * 16, bytes % 16);
+  // The streamed stores are weakly ordered, they must be visible before the
+  // copy is reported done
+  _mm_sfence();
+#else
+  memcpy(dst, src, bytes);
+#endif
+}
+
+static void CopyBlock(char* dst, const char* src, size_t bytes,
+                      bool streaming) {
+  if (streaming) {
+    StreamingCopy(dst, src, bytes);
+  } else {
+    memcpy(dst, src, bytes);
+  }
+}
+
+int HostCopy::NumThreads() {
+  static const int num_threads = []() {
+    int threads = std::min(4, std::max(1, port::MaxParallelism() / 2));
+    string env = util::GetEnv("OPENVINO_TF_COPY_THREADS");
+    if (!env.empty()) {
+      try {
+        threads = std::max(1, std::stoi(env));
+      } catch (const std::exception&) {
+        OVTF_VLOG(0) << "Ignoring OPENVINO_TF_COPY_THREADS=" << env;
+      }
+    }
+    return threads;
+  }();
+  return num_threads;
+}
+
+// The threads helping the calling thread with the large copies. It is never
+// destroyed so that it outlives every tensor.
+static thread::ThreadPool* GetCopyThreadPool() {
+  static thread::ThreadPool* pool = []() -> thread::ThreadPool* {
+    if (HostCopy::NumThreads() <= 1) return nullptr;
+    return new thread::ThreadPool(Env::Default(), "ovtf_copy",
+                                  HostCopy::NumThreads() - 1);
+  }();
+  return pool;
+}
+
+void HostCopy::Copy(void* dst, const void* src, size_t bytes) {
+  if (bytes == 0 || dst == src) return;
+  auto out = static_cast<char*>(dst);
+  auto in = static_cast<const char*>(src);
+  bool streaming = bytes >= kMinStreamingBytes;
+  thread::ThreadPool* pool =
+      bytes >= kMinParallelBytes ? GetCopyThreadPool() : nullptr;
+  if (pool == nullptr) {
+    CopyBlock(out, in, bytes, streaming);
+    return;
+  }
+
+  // Splits the copy in blocks of whole cache lines, so that no two threads
+  // write the same line
+  size_t blocks = std::min<size_t>(NumThreads(), bytes / kMinBlockBytes);
+  size_t block_bytes = (bytes / blocks + kCacheLine - 1) / kCacheLine;
+  block_bytes *= kCacheLine;
+  blocks = (bytes + block_bytes - 1) / block_bytes;
+  BlockingCounter counter(blocks - 1);
+  for (size_t b = 1; b < blocks; b++) {
+    size_t offset = b * block_bytes;
+    size_t size = std::min(block_bytes, bytes - offset);
+    pool->Schedule([=, &counter]() {
+      CopyBlock(out + offset, in + offset, size, streaming);
+      counter.DecrementCount();
+    });
+  }
+  CopyBlock(out, in, std::min(block_bytes, bytes), streaming);
+  counter.Wait();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,36 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_HOST_COPY_H_
+#define OPENVINO_TF_HOST_COPY_H_
+
+#include <cstddef>
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// The copies between host buffers of the tensors passed between TF and
+// OpenVINO, like the outputs of an infer request copied into TF tensors.
+// A single core does not saturate the memory bandwidth, so the large copies
+// are split in blocks copied in parallel by a small thread pool and the
+// calling thread. The copies larger than the last level cache are written
+// with non-temporal stores, which do not evict the cache for data that will
+// not be read before it is evicted anyway.
+//
+// The threads are set with OPENVINO_TF_COPY_THREADS, 0 or 1 copies on the
+// calling thread only.
+class HostCopy {
+ public:
+  // Copies bytes from src to dst, which do not overlap
+  static void Copy(void* dst, const void* src, size_t bytes);
+
+  // The threads copying a large copy, including the calling thread
+  static int NumThreads();
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_HOST_COPY_H_
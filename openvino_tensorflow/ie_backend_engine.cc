@@ -4,11 +4,19 @@
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <thread>
 
 #include "backend_manager.h"
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/device_scheduler.h"
 #include "openvino_tensorflow/ie_backend_engine.h"
 #include "openvino_tensorflow/ie_utils.h"
+#include "openvino_tensorflow/model_cache.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/step_cancellation.h"
 
 namespace tensorflow {
 namespace openvino_tensorflow {
@@ -17,12 +25,18 @@ IE_Backend_Engine::IE_Backend_Engine(std::shared_ptr<ov::Model> model,
                                      std::string device)
     : m_model(model),
       m_device(device),
+      m_priority(DeviceScheduler::Priority::MEDIUM),
       m_multi_req_execution(false),
-      m_network_ready(false) {}
+      m_network_ready(false),
+      m_optimal_num_requests(1),
+      m_pool_requests(true),
+      m_balance_replicas(false),
+      m_next_replica(0) {}
 
 IE_Backend_Engine::~IE_Backend_Engine() {}
 
 void IE_Backend_Engine::load_network() {
+  std::lock_guard<std::mutex> lock(m_engine_mutex);
   if (m_network_ready) return;
 
   if (m_device == "MYRIAD") {
@@ -41,12 +55,377 @@ void IE_Backend_Engine::load_network() {
   }
 
   // Load network to the plugin (m_device)
-  auto backend = BackendManager::GetBackend();
-  auto dev_type = backend->GetDeviceType();
-  if (dev_type.find("GPU") != string::npos) dev_type = "GPU";
-  m_compiled_model =
-      Backend::GetGlobalContext().ie_core.compile_model(m_model, dev_type);
+  std::string dev_type = m_device_type.empty() ? m_device : m_device_type;
+  // GPU_FP16 and CPU_BF16 are compiled for GPU and CPU, multi device
+  // configurations are passed on as they are
+  if (Backend::GetMultiDeviceName(dev_type).empty()) {
+    dev_type = dev_type.substr(0, dev_type.find("_"));
+  }
+  auto& ie_core = Backend::GetGlobalContext().ie_core;
+  // The model priority is a hint of the GPU and of the multi device
+  // plugins, the others only schedule the inferences by it
+  if (m_compile_config.count(ov::hint::model_priority.name())) {
+    bool supported = false;
+    try {
+      auto properties =
+          ie_core.get_property(dev_type, ov::supported_properties);
+      supported = std::find(properties.begin(), properties.end(),
+                            ov::hint::model_priority.name()) !=
+                  properties.end();
+    } catch (const ov::Exception&) {
+      // Not reported, the property is dropped
+    }
+    if (!supported) m_compile_config.erase(ov::hint::model_priority.name());
+  }
+  bool imported = false;
+  if (!m_import_path.empty()) {
+    try {
+      std::ifstream blob(m_import_path, std::ios::binary);
+      if (!blob) throw std::runtime_error("the blob can not be opened");
+      m_compiled_model = ie_core.import_model(blob, dev_type, m_compile_config);
+      imported = true;
+      OVTF_VLOG(1) << "IE_Backend_Engine: imported " << m_import_path;
+    } catch (const std::exception& e) {
+      OVTF_VLOG(0) << "IE_Backend_Engine: failed to import " << m_import_path
+                   << ", compiling the model: " << e.what();
+    }
+  }
+  const auto& gpu_replicas = Backend::GetGPUReplicas(m_device);
+  const auto& myriad_replicas = Backend::GetMyriadReplicas(m_device);
+  if (!imported && dev_type == "CPU" && !is_stateful() &&
+      util::GetEnv("OPENVINO_TF_NUMA_REPLICAS") == "1" &&
+      util::NUMANodeCPUs().size() > 1) {
+    compile_numa_replicas(dev_type);
+    ModelCache::EvictIfNeeded();
+  } else if (!imported && dev_type == "GPU" && !is_stateful() &&
+             !gpu_replicas.empty()) {
+    compile_device_replicas(gpu_replicas);
+    ModelCache::EvictIfNeeded();
+  } else if (!imported && dev_type == "MYRIAD" && !is_stateful() &&
+             !myriad_replicas.empty()) {
+    // A device pinned to a stick, e.g. "MYRIAD.1.1-ma2480", is not
+    // replicated
+    compile_device_replicas(myriad_replicas);
+    ModelCache::EvictIfNeeded();
+  } else if (!imported) {
+    m_compiled_model =
+        ie_core.compile_model(m_model, dev_type, m_compile_config);
+    // A new blob may have been added to the persistent cache
+    ModelCache::EvictIfNeeded();
+  }
   m_network_ready = true;
+  m_replica_requests.assign(m_replicas.size(), 0);
+
+  try {
+    m_optimal_num_requests =
+        m_compiled_model.get_property(ov::optimal_number_of_infer_requests);
+  } catch (const ov::Exception& e) {
+    OVTF_VLOG(2) << "IE_Backend_Engine: optimal number of infer requests "
+                 << "not reported by " << dev_type << ": " << e.what();
+    m_optimal_num_requests = 1;
+  }
+  m_optimal_num_requests = std::max<size_t>(m_optimal_num_requests, 1);
+  if (is_stateful()) m_optimal_num_requests = 1;
+  OVTF_VLOG(2) << "IE_Backend_Engine: optimal number of infer requests "
+               << m_optimal_num_requests;
+  // The replicas run their requests in parallel
+  DeviceScheduler::ReportOptimalRequests(
+      m_device,
+      m_optimal_num_requests * std::max<size_t>(m_replicas.size(), 1));
+  // Creating a request allocates its buffers on the device, do it before
+  // the first inference instead of on demand
+  for (int node = 0; node < std::max<size_t>(m_replicas.size(), 1); node++) {
+    if (!m_replicas.empty() && !m_replicas[node]) continue;
+    for (size_t i = 0; m_pool_requests && i < m_optimal_num_requests; i++) {
+      m_free_req_ids.push_back(create_infer_request_locked(node));
+    }
+  }
+}
+
+void IE_Backend_Engine::compile_numa_replicas(const std::string& dev_type) {
+  auto& ie_core = Backend::GetGlobalContext().ie_core;
+  const auto& nodes = util::NUMANodeCPUs();
+  std::vector<ov::CompiledModel> replicas(nodes.size());
+  std::vector<std::exception_ptr> errors(nodes.size());
+  std::vector<std::thread> threads;
+  for (int node = 0; node < nodes.size(); node++) {
+    // The nodes without CPUs only hold memory
+    if (nodes[node].empty()) continue;
+    // The transformations of the plugin modify the model they compile
+    std::shared_ptr<ov::Model> model = m_model->clone();
+    threads.emplace_back([&, node, model]() {
+      try {
+        util::BindThreadToNUMANode(node);
+        // The streams share the cores of the node unpinned, the CPU
+        // plugin would pin them to the first cores of the system
+        ov::AnyMap config = m_compile_config;
+        if (!config.count(ov::inference_num_threads.name())) {
+          config[ov::inference_num_threads.name()] =
+              std::to_string(nodes[node].size());
+        }
+        if (!config.count(ov::affinity.name())) {
+          config[ov::affinity.name()] = "NONE";
+        }
+        replicas[node] = ie_core.compile_model(model, dev_type, config);
+      } catch (...) {
+        errors[node] = std::current_exception();
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (const auto& error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+  m_replicas = std::move(replicas);
+  for (const auto& replica : m_replicas) {
+    if (replica) {
+      m_compiled_model = replica;
+      break;
+    }
+  }
+  OVTF_VLOG(1) << "IE_Backend_Engine: compiled " << threads.size()
+               << " NUMA replicas of " << m_model->get_friendly_name();
+}
+
+void IE_Backend_Engine::compile_device_replicas(
+    const std::vector<std::string>& devices) {
+  auto& ie_core = Backend::GetGlobalContext().ie_core;
+  std::vector<ov::CompiledModel> replicas(devices.size());
+  std::vector<std::exception_ptr> errors(devices.size());
+  std::vector<std::thread> threads;
+  for (int i = 0; i < devices.size(); i++) {
+    // The transformations of the plugin modify the model they compile
+    std::shared_ptr<ov::Model> model = m_model->clone();
+    threads.emplace_back([&, i, model]() {
+      try {
+        replicas[i] =
+            ie_core.compile_model(model, devices[i], m_compile_config);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (const auto& error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+  m_replicas = std::move(replicas);
+  m_compiled_model = m_replicas[0];
+  m_balance_replicas = true;
+  OVTF_VLOG(1) << "IE_Backend_Engine: compiled " << devices.size()
+               << " " << m_device << " replicas of "
+               << m_model->get_friendly_name();
+}
+
+size_t IE_Backend_Engine::get_optimal_num_requests() {
+  std::lock_guard<std::mutex> lock(m_engine_mutex);
+  return m_optimal_num_requests;
+}
+
+void IE_Backend_Engine::init_io_indices(
+    const std::vector<std::string>& input_names,
+    const std::vector<std::string>& param_names,
+    const std::vector<std::string>& output_names) {
+  std::lock_guard<std::mutex> lock(m_engine_mutex);
+  if (m_in_idx.size() == 0) {
+    m_in_idx.resize(input_names.size(), -1);
+    for (int i = 0; i < input_names.size(); i++) {
+      if (!input_names[i].empty()) {
+        m_in_idx[i] = get_input_idx(input_names[i]);
+      }
+    }
+  }
+  if (m_param_idx.size() == 0) {
+    m_param_idx.resize(param_names.size(), -1);
+    for (int i = 0; i < param_names.size(); i++) {
+      if (!param_names[i].empty()) {
+        m_param_idx[i] = get_input_idx(param_names[i]);
+      }
+    }
+  }
+  if (m_out_idx.size() == 0) {
+    m_out_idx.resize(output_names.size(), -1);
+    for (int i = 0; i < output_names.size(); i++) {
+      m_out_idx[i] = get_output_idx(output_names[i]);
+    }
+  }
+}
+
+int IE_Backend_Engine::create_infer_request_locked(int node) {
+  OVTF_VLOG(2) << "IE_Backend_Engine: creating infer request "
+               << m_infer_reqs.size() << " on node " << node;
+  ov::CompiledModel& compiled =
+      m_replicas.empty() ? m_compiled_model : m_replicas[node];
+  m_infer_reqs.push_back(compiled.create_infer_request());
+  m_req_nodes.push_back(node);
+  int req_id = m_infer_reqs.size() - 1;
+  m_req_callbacks.emplace_back();
+  m_req_bindings.emplace_back(new StickyBindings());
+  // The request callback is set once and never replaced: replacing it
+  // while a previous completion is still running is not safe. It forwards
+  // to the per-request completion handler instead.
+  m_infer_reqs[req_id].set_callback([this, req_id](std::exception_ptr ex) {
+    InferCallback on_complete;
+    {
+      std::lock_guard<std::mutex> lock(m_engine_mutex);
+      on_complete = std::move(m_req_callbacks[req_id]);
+      m_req_callbacks[req_id] = nullptr;
+    }
+    if (on_complete) on_complete(ex);
+    release_infer_request(req_id);
+    // The requests only complete through this callback once started by
+    // start_async_request
+    DeviceScheduler::Complete(m_device, m_priority);
+  });
+  return req_id;
+}
+
+void IE_Backend_Engine::set_state(const std::string& name,
+                                  const ov::Tensor& value) {
+  load_network();
+  InferRequestGuard guard(this);
+  for (auto& state : guard.request().query_state()) {
+    if (state.get_name() == name) {
+      state.set_state(value);
+      return;
+    }
+  }
+  throw std::runtime_error("The model has no variable " + name);
+}
+
+int IE_Backend_Engine::acquire_infer_request(ov::InferRequest& request,
+                                             StickyBindings** bindings) {
+  // The replicas are only set while loading the network, which the callers
+  // did before
+  int node = 0;
+  if (!m_replicas.empty() && !m_balance_replicas) {
+    node = util::CurrentNUMANode();
+    if (node >= m_replicas.size() || !m_replicas[node]) node = 0;
+  }
+  std::lock_guard<std::mutex> lock(m_engine_mutex);
+  if (m_balance_replicas) {
+    // The GPU with the fewest requests in flight, the next one in turn
+    // among those
+    node = m_next_replica;
+    for (size_t i = 1; i < m_replicas.size(); i++) {
+      int replica = (m_next_replica + i) % m_replicas.size();
+      if (m_replica_requests[replica] < m_replica_requests[node]) {
+        node = replica;
+      }
+    }
+    m_next_replica = (node + 1) % m_replicas.size();
+  }
+  // The most recently released request of the node
+  auto free = std::find_if(
+      m_free_req_ids.rbegin(), m_free_req_ids.rend(),
+      [this, node](int req_id) { return m_req_nodes[req_id] == node; });
+  int req_id;
+  if (free == m_free_req_ids.rend()) {
+    req_id = create_infer_request_locked(m_replicas.empty() ? 0 : node);
+  } else {
+    req_id = *free;
+    m_free_req_ids.erase(std::next(free).base());
+  }
+  if (!m_replica_requests.empty()) m_replica_requests[node]++;
+  // ov::InferRequest is a handle, so the copy stays valid even if the pool
+  // grows while the caller is using it
+  request = m_infer_reqs[req_id];
+  // The bindings are heap allocated, the pointer too stays valid
+  if (bindings != nullptr) *bindings = m_req_bindings[req_id].get();
+  return req_id;
+}
+
+void IE_Backend_Engine::StickyBindings::bind_input(ov::InferRequest& request,
+                                                   const int idx,
+                                                   const ov::Tensor& tensor) {
+  if (idx >= m_bindings.size()) m_bindings.resize(idx + 1);
+  Binding& binding = m_bindings[idx];
+  // The memory of a remote tensor is not mapped, it is bound on every call
+  if (tensor.is<ov::RemoteTensor>()) {
+    request.set_input_tensor(idx, tensor);
+    binding.bound = false;
+    return;
+  }
+  if (binding.bound && binding.data == tensor.data() &&
+      binding.type == tensor.get_element_type() &&
+      binding.shape == tensor.get_shape()) {
+    return;
+  }
+  request.set_input_tensor(idx, tensor);
+  binding.bound = true;
+  binding.data = tensor.data();
+  binding.type = tensor.get_element_type();
+  binding.shape = tensor.get_shape();
+}
+
+void IE_Backend_Engine::release_infer_request(const int req_id) {
+  std::lock_guard<std::mutex> lock(m_engine_mutex);
+  m_free_req_ids.push_back(req_id);
+  if (!m_replica_requests.empty()) m_replica_requests[m_req_nodes[req_id]]--;
+}
+
+void IE_Backend_Engine::start_async_request(const int req_id,
+                                            InferCallback on_complete) {
+  ov::InferRequest request;
+  {
+    std::lock_guard<std::mutex> lock(m_engine_mutex);
+    request = m_infer_reqs[req_id];
+  }
+  // Cancelling the step of the caller cancels the request until it
+  // completes, it is not cancelled anymore once it is released
+  std::shared_ptr<StepCancellation> cancellation = StepCancellation::Current();
+  if (cancellation != nullptr) {
+    auto registration = std::make_shared<StepCancellation::Registration>(
+        cancellation, [request]() mutable { request.cancel(); });
+    on_complete = [registration, on_complete](std::exception_ptr ex) mutable {
+      registration.reset();
+      on_complete(ex);
+    };
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_engine_mutex);
+    m_req_callbacks[req_id] = std::move(on_complete);
+  }
+  // The request starts once the device has room for it, which may be from
+  // the completion callback of another cluster's request
+  auto start = [this, req_id, request, cancellation]() mutable {
+    try {
+      // Cancelled while it was waiting for the device
+      if (cancellation != nullptr && cancellation->IsCancelled()) {
+        throw StepCancellation::Cancelled();
+      }
+      request.start_async();
+    } catch (...) {
+      // The request callback will not fire, report the error from here
+      InferCallback callback;
+      {
+        std::lock_guard<std::mutex> lock(m_engine_mutex);
+        callback = std::move(m_req_callbacks[req_id]);
+        m_req_callbacks[req_id] = nullptr;
+      }
+      if (callback) callback(std::current_exception());
+      release_infer_request(req_id);
+      DeviceScheduler::Complete(m_device, m_priority);
+    }
+  };
+  DeviceScheduler::Submit(m_device, start, m_priority);
+}
+
+void IE_Backend_Engine::infer_async(
+    std::vector<std::shared_ptr<IETensor>>& inputs,
+    std::vector<std::string>& input_names,
+    std::vector<std::shared_ptr<IETensor>>& outputs,
+    std::vector<std::string>& output_names,
+    std::vector<std::shared_ptr<IETensor>>& hoisted_params,
+    std::vector<std::string>& param_names, InferCallback callback) {
+  std::exception_ptr ex = nullptr;
+  try {
+    infer(inputs, input_names, outputs, output_names, hoisted_params,
+          param_names);
+  } catch (...) {
+    ex = std::current_exception();
+  }
+  callback(ex);
 }
 
 void IE_Backend_Engine::start_async_inference(const int req_id) {
@@ -88,8 +467,31 @@ void IE_Backend_Engine::disable_multi_req_execution() {
   m_multi_req_execution = false;
 }
 
+void IE_Backend_Engine::set_compile_config(const ov::AnyMap& config) {
+  std::lock_guard<std::mutex> lock(m_engine_mutex);
+  m_compile_config = config;
+  auto priority = config.find(ov::hint::model_priority.name());
+  m_priority = DeviceScheduler::ParsePriority(
+      priority == config.end() ? "" : priority->second.as<std::string>());
+}
+
+void IE_Backend_Engine::set_device_type(const std::string& device_type) {
+  std::lock_guard<std::mutex> lock(m_engine_mutex);
+  m_device_type = device_type;
+}
+
 std::shared_ptr<ov::Model> IE_Backend_Engine::get_model() { return m_model; }
 
+void IE_Backend_Engine::set_import_path(const std::string& path) {
+  std::lock_guard<std::mutex> lock(m_engine_mutex);
+  m_import_path = path;
+}
+
+void IE_Backend_Engine::export_network(std::ostream& stream) {
+  load_network();
+  m_compiled_model.export_model(stream);
+}
+
 const int IE_Backend_Engine::get_input_idx(const std::string name) const {
   for (int i = 0; i < m_model->inputs().size(); i++) {
     if (m_model->inputs()[i].get_node()->get_friendly_name() == name) {
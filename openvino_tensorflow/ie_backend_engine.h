@@ -7,12 +7,17 @@
 #ifndef IE_BACKEND_ENGINE_H_
 #define IE_BACKEND_ENGINE_H_
 
+#include <exception>
+#include <functional>
+#include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "openvino/openvino.hpp"
 
+#include "openvino_tensorflow/device_scheduler.h"
 #include "openvino_tensorflow/ie_tensor.h"
 
 namespace tensorflow {
@@ -31,6 +36,22 @@ class IE_Backend_Engine {
                      std::vector<std::shared_ptr<IETensor>>& hoisted_params,
                      std::vector<std::string>& param_names) = 0;
 
+  // Called when an asynchronous inference completes. The exception pointer
+  // is null on success.
+  using InferCallback = std::function<void(std::exception_ptr)>;
+
+  // Starts the inference and returns without waiting for it. All the
+  // vectors must stay alive until callback is called, outputs which were
+  // null are filled in before that. The default implementation runs infer()
+  // synchronously and then calls the callback.
+  virtual void infer_async(
+      std::vector<std::shared_ptr<IETensor>>& inputs,
+      std::vector<std::string>& input_names,
+      std::vector<std::shared_ptr<IETensor>>& outputs,
+      std::vector<std::string>& output_names,
+      std::vector<std::shared_ptr<IETensor>>& hoisted_params,
+      std::vector<std::string>& param_names, InferCallback callback);
+
   // Returns output batch size based on the input batch size and the device
   // FIXME: This may not be needed
   virtual size_t get_output_batch_size(size_t inputBatchSize) const;
@@ -40,6 +61,24 @@ class IE_Backend_Engine {
   // Disables multi request execution
   void disable_multi_req_execution();
 
+  // Sets the properties the model is compiled with, before it is loaded.
+  // Its ov::hint::model_priority is also the priority its inferences are
+  // scheduled with on the device.
+  void set_compile_config(const ov::AnyMap& config);
+  // Sets the device configuration the model is compiled for, e.g.
+  // "GPU_FP16" or "MULTI:GPU,CPU", before it is loaded. The device of the
+  // engine by default.
+  void set_device_type(const std::string& device_type);
+
+  // Loads the network now instead of on the first inference
+  void load() { load_network(); }
+
+  // Imports the compiled model from the blob at path when the network is
+  // loaded, instead of compiling the model
+  void set_import_path(const std::string& path);
+  // Loads the network and writes its compiled model to stream
+  void export_network(std::ostream& stream);
+
   // Returns the OpenVINO Model from the CNNNetwork
   std::shared_ptr<ov::Model> get_model();
 
@@ -48,20 +87,138 @@ class IE_Backend_Engine {
   const int get_input_idx(const std::string name) const;
   const int get_output_idx(const std::string name) const;
 
+  // The number of infer requests the compiled model can run in parallel,
+  // as reported by the device. 1 before the network is loaded.
+  size_t get_optimal_num_requests();
+
+  // Whether the model holds variables in its infer request, which is then
+  // the only one, of a single replica, so that every inference reads the
+  // variables the previous one assigned. The callers must not run it from
+  // several threads at once.
+  bool is_stateful() const { return !m_model->get_sinks().empty(); }
+  // Sets the variable named name of the infer request to value
+  void set_state(const std::string& name, const ov::Tensor& value);
+
  protected:
   std::shared_ptr<ov::Model> m_model;
   ov::CompiledModel m_compiled_model;
+  ov::AnyMap m_compile_config;
+  std::string m_device_type;
+  std::string m_import_path;
   std::vector<ov::InferRequest> m_infer_reqs;
   std::string m_device;
+  DeviceScheduler::Priority m_priority;
   bool m_multi_req_execution;
   bool m_network_ready;
   std::vector<int> m_in_idx;
   std::vector<int> m_out_idx;
   std::vector<int> m_param_idx;
+  // Guards the network loading, the index tables above and the infer
+  // request pool so that several TF threads can run the same engine
+  std::mutex m_engine_mutex;
+  // Ids of the requests in m_infer_reqs which are not checked out
+  std::vector<int> m_free_req_ids;
+  // With OPENVINO_TF_NUMA_REPLICAS on a multi socket CPU, one replica of
+  // the compiled model per NUMA node, indexed by node, and the node of the
+  // replica every request in m_infer_reqs was created from. The requests
+  // are checked out from the replica of the node of the calling thread.
+  // With OPENVINO_TF_GPU_REPLICAS, one replica per GPU instead, or one per
+  // MYRIAD stick, and the requests are checked out from the device with
+  // the fewest requests in flight. m_compiled_model is the first replica
+  // then.
+  std::vector<ov::CompiledModel> m_replicas;
+  std::vector<int> m_req_nodes;
+  // The requests of every replica which are checked out, the replicas are
+  // balanced by them when m_balance_replicas is set, ties go round robin
+  // from m_next_replica
+  std::vector<int> m_replica_requests;
+  bool m_balance_replicas;
+  int m_next_replica;
+  // ov::optimal_number_of_infer_requests of the compiled model. When
+  // m_pool_requests is set, that many requests are created up front, for
+  // every replica.
+  size_t m_optimal_num_requests;
+  bool m_pool_requests;
+  // Completion handlers of the requests started with start_async_request,
+  // indexed by request id
+  std::vector<InferCallback> m_req_callbacks;
+
+  // The tensors last bound to the inputs of one infer request. An input is
+  // bound again only when its buffer, shape or element type changes, so
+  // the hoisted parameters and the inputs whose TF buffers stay the same
+  // from one call to the next, like variables, are bound once. Every input
+  // of the request must be bound through it for the records to hold.
+  class StickyBindings {
+   public:
+    void bind_input(ov::InferRequest& request, const int idx,
+                    const ov::Tensor& tensor);
+
+   private:
+    struct Binding {
+      bool bound = false;
+      const void* data = nullptr;
+      ov::element::Type type;
+      ov::Shape shape;
+    };
+    std::vector<Binding> m_bindings;
+  };
+  // The bindings of every request in m_infer_reqs, indexed by request id.
+  // A request's bindings are only used by the caller it is checked out to.
+  std::vector<std::unique_ptr<StickyBindings>> m_req_bindings;
 
   virtual void start_async_inference(const int req_id);
   virtual void complete_async_inference(const int req_id);
   virtual void load_network();
+
+  // Fills m_in_idx, m_param_idx and m_out_idx on the first call
+  void init_io_indices(const std::vector<std::string>& input_names,
+                       const std::vector<std::string>& param_names,
+                       const std::vector<std::string>& output_names);
+
+  // Compiles one replica of the model per NUMA node, each from a thread
+  // bound to the node so that its weights are allocated there. The caller
+  // holds m_engine_mutex.
+  void compile_numa_replicas(const std::string& dev_type);
+  // Compiles one replica of the model per device of devices, the GPUs or
+  // the MYRIAD sticks, in parallel. The caller holds m_engine_mutex.
+  void compile_device_replicas(const std::vector<std::string>& devices);
+
+  // Creates a pooled infer request from the replica of node and returns
+  // its id, the caller holds m_engine_mutex
+  int create_infer_request_locked(int node = 0);
+
+  // Checks out an idle infer request from the pool, creating a new one if
+  // every request is in use, along with its bindings. The request id must
+  // be returned with release_infer_request once the inference is complete.
+  int acquire_infer_request(ov::InferRequest& request,
+                            StickyBindings** bindings = nullptr);
+  void release_infer_request(const int req_id);
+
+  // Starts an infer request previously checked out with
+  // acquire_infer_request. When it completes on_complete is called, the
+  // request is still checked out at that point so its output tensors can be
+  // read. It is returned to the pool once on_complete returns.
+  void start_async_request(const int req_id, InferCallback on_complete);
+
+  // Checks out an infer request and returns it to the pool when it goes out
+  // of scope
+  class InferRequestGuard {
+   public:
+    InferRequestGuard(IE_Backend_Engine* engine) : m_engine(engine) {
+      m_req_id = engine->acquire_infer_request(m_request, &m_bindings);
+    }
+    ~InferRequestGuard() { m_engine->release_infer_request(m_req_id); }
+    ov::InferRequest& request() { return m_request; }
+    StickyBindings& bindings() { return *m_bindings; }
+
+   private:
+    InferRequestGuard(const InferRequestGuard&) = delete;
+    InferRequestGuard& operator=(const InferRequestGuard&) = delete;
+    IE_Backend_Engine* m_engine;
+    ov::InferRequest m_request;
+    StickyBindings* m_bindings;
+    int m_req_id;
+  };
 };
 }  // namespace openvino_tensorflow
 }  // namesoace tensorflow
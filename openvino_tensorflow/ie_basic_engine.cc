@@ -4,12 +4,21 @@
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
 
+#include <condition_variable>
+#include <cstring>
 #include <iostream>
 #include <memory>
 
+#include "tensorflow/core/platform/env_time.h"
+
 #include "logging/ovtf_log.h"
+#include "openvino_tensorflow/buffer_pool.h"
+#include "openvino_tensorflow/device_scheduler.h"
+#include "openvino_tensorflow/host_copy.h"
 #include "openvino_tensorflow/ie_basic_engine.h"
 #include "openvino_tensorflow/ie_utils.h"
+#include "openvino_tensorflow/layer_profile.h"
+#include "openvino_tensorflow/step_cancellation.h"
 
 using namespace InferenceEngine;
 
@@ -22,28 +31,15 @@ IE_Basic_Engine::IE_Basic_Engine(std::shared_ptr<ov::Model> model,
 
 IE_Basic_Engine::~IE_Basic_Engine() {}
 
-void IE_Basic_Engine::infer(
+void IE_Basic_Engine::bind_tensors(
+    ov::InferRequest& infer_req, StickyBindings& bindings,
     std::vector<std::shared_ptr<IETensor>>& inputs,
     std::vector<std::string>& input_names,
     std::vector<std::shared_ptr<IETensor>>& outputs,
     std::vector<std::string>& output_names,
     std::vector<std::shared_ptr<IETensor>>& hoisted_params,
     std::vector<std::string>& param_names) {
-  load_network();
-  if (m_infer_reqs.empty()) {
-    m_infer_reqs.push_back(m_compiled_model.create_infer_request());
-  }
-
   //  Prepare input blobs
-  auto parameters = m_model->get_parameters();
-  if (m_in_idx.size() == 0) {
-    m_in_idx.resize(inputs.size());
-    for (int i = 0; i < inputs.size(); i++) {
-      if (inputs[i] != nullptr) {
-        m_in_idx[i] = get_input_idx(input_names[i]);
-      }
-    }
-  }
   for (int i = 0; i < inputs.size(); i++) {
     if (inputs[i] != nullptr) {
       OVTF_VLOG(4) << "IE_Basic_Engine::infer() set_input_tensor() ("
@@ -53,18 +49,10 @@ void IE_Basic_Engine::infer(
         throw std::runtime_error("Input with friendly name " + input_names[i] +
                                  " not found in ov::Model");
       }
-      m_infer_reqs[0].set_input_tensor(in_idx, *(inputs[i]));
+      bindings.bind_input(infer_req, in_idx, inputs[i]->device_tensor());
     }
   }
 
-  if (m_param_idx.size() == 0) {
-    m_param_idx.resize(hoisted_params.size());
-    for (int i = 0; i < hoisted_params.size(); i++) {
-      if (hoisted_params[i] != nullptr) {
-        m_param_idx[i] = get_input_idx(param_names[i]);
-      }
-    }
-  }
   for (int i = 0; i < hoisted_params.size(); i++) {
     if (hoisted_params[i] != nullptr) {
       OVTF_VLOG(4) << "IE_Basic_Engine::infer() set_input_tensor() ("
@@ -74,18 +62,12 @@ void IE_Basic_Engine::infer(
         throw std::runtime_error("Hoisted parameter with friendly name " +
                                  param_names[i] + " not found in ov::Model");
       }
-      m_infer_reqs[0].set_input_tensor(param_idx, *(hoisted_params[i]));
+      bindings.bind_input(infer_req, param_idx, *(hoisted_params[i]));
     }
   }
 
   //  Prepare output blobs
   auto results = m_model->get_results();
-  if (m_out_idx.size() == 0) {
-    m_out_idx.resize(results.size());
-    for (int i = 0; i < results.size(); i++) {
-      m_out_idx[i] = get_output_idx(output_names[i]);
-    }
-  }
   for (int i = 0; i < results.size(); i++) {
     if (outputs[i] != nullptr) {
       OVTF_VLOG(4) << "IE_Basic_Engine::infer() set_output_tensor() ("
@@ -95,13 +77,16 @@ void IE_Basic_Engine::infer(
         throw std::runtime_error("Output with friendly name " +
                                  output_names[i] + " not found in ov::Model");
       }
-      m_infer_reqs[0].set_output_tensor(out_idx, *(outputs[i]));
+      infer_req.set_output_tensor(out_idx, *(outputs[i]));
     }
   }
+}
 
-  m_infer_reqs[0].infer();
-
-  // Set dynamic output blobs
+void IE_Basic_Engine::read_dynamic_outputs(
+    ov::InferRequest& infer_req,
+    std::vector<std::shared_ptr<IETensor>>& outputs,
+    std::vector<std::string>& output_names) {
+  auto results = m_model->get_results();
   for (int i = 0; i < results.size(); i++) {
     if (outputs[i] == nullptr) {
       OVTF_VLOG(4) << "IE_Basic_Engine::infer() get_output_tensor() ("
@@ -111,12 +96,234 @@ void IE_Basic_Engine::infer(
         throw std::runtime_error("Output with friendly name " +
                                  output_names[i] + " not found in ov::Model");
       }
-      auto tensor = m_infer_reqs[0].get_output_tensor(out_idx);
+      // The output memory is owned by the infer request, so copy it out
+      // before the request is handed to another thread
+      auto tensor = infer_req.get_output_tensor(out_idx);
       outputs[i] = std::make_shared<IETensor>(
-          tensor.get_element_type(), tensor.get_shape(), tensor.data());
+          tensor.get_element_type(), tensor.get_shape(),
+          BufferPool::GetAllocator(m_device));
+      outputs[i]->write(tensor.data(), tensor.get_byte_size());
+    }
+  }
+}
+
+// Whether dimension 0 of the shape may differ from one call to the next
+static bool HasDynamicBatch(const ov::PartialShape& shape) {
+  return shape.rank().is_dynamic() ||
+         (shape.rank().get_length() > 0 && shape[0].is_dynamic());
+}
+
+bool IE_Basic_Engine::infer_split_batch(
+    std::vector<std::shared_ptr<IETensor>>& inputs,
+    std::vector<std::shared_ptr<IETensor>>& outputs,
+    std::vector<std::shared_ptr<IETensor>>& hoisted_params) {
+  size_t max_req = get_optimal_num_requests();
+  if (!m_multi_req_execution || max_req < 2) return false;
+
+  size_t batch = 0;
+  for (int i = 0; i < inputs.size(); i++) {
+    if (inputs[i] == nullptr) continue;
+    const ov::Shape& shape = inputs[i]->get_shape();
+    if (m_in_idx[i] < 0 || shape.empty() ||
+        !HasDynamicBatch(m_model->input(m_in_idx[i]).get_partial_shape())) {
+      return false;
+    }
+    if (batch == 0) batch = shape[0];
+    if (shape[0] != batch) return false;
+  }
+  for (int i = 0; i < outputs.size(); i++) {
+    if (outputs[i] != nullptr || m_out_idx[i] < 0 ||
+        !HasDynamicBatch(m_model->output(m_out_idx[i]).get_partial_shape())) {
+      return false;
+    }
+  }
+  if (batch < 2) return false;
+
+  size_t num_req = std::min(batch, max_req);
+  size_t rows = (batch + num_req - 1) / num_req;
+  num_req = (batch + rows - 1) / rows;
+  OVTF_VLOG(4) << "IE_Basic_Engine::infer() splitting batch " << batch
+               << " across " << num_req << " requests";
+
+  // The parts may complete on OpenVINO threads in any order
+  std::mutex parts_mutex;
+  std::condition_variable parts_done;
+  size_t parts_pending = num_req;
+  std::exception_ptr parts_ex = nullptr;
+  std::vector<std::vector<std::shared_ptr<IETensor>>> part_outputs(
+      num_req, std::vector<std::shared_ptr<IETensor>>(outputs.size()));
+
+  for (size_t r = 0; r < num_req; r++) {
+    size_t first = r * rows;
+    size_t part_rows = std::min(rows, batch - first);
+    ov::InferRequest infer_req;
+    StickyBindings* bindings = nullptr;
+    const int req_id = acquire_infer_request(infer_req, &bindings);
+    try {
+      for (int i = 0; i < inputs.size(); i++) {
+        if (inputs[i] == nullptr) continue;
+        ov::Shape part_shape = inputs[i]->get_shape();
+        part_shape[0] = part_rows;
+        size_t row_bytes = inputs[i]->get_byte_size() / batch;
+        // A view into the TF input, the rows are contiguous
+        ov::Tensor part(inputs[i]->get_element_type(), part_shape,
+                        static_cast<uint8_t*>(inputs[i]->data()) +
+                            first * row_bytes);
+        bindings->bind_input(infer_req, m_in_idx[i], part);
+      }
+      for (int i = 0; i < hoisted_params.size(); i++) {
+        if (hoisted_params[i] == nullptr) continue;
+        if (m_param_idx[i] < 0) {
+          throw std::runtime_error("Hoisted parameter not found in ov::Model");
+        }
+        bindings->bind_input(infer_req, m_param_idx[i], *(hoisted_params[i]));
+      }
+    } catch (...) {
+      release_infer_request(req_id);
+      std::lock_guard<std::mutex> lock(parts_mutex);
+      parts_ex = std::current_exception();
+      parts_pending -= num_req - r;
+      break;
+    }
+
+    start_async_request(req_id, [this, r, infer_req, &outputs, &part_outputs,
+                                 &parts_mutex, &parts_done, &parts_pending,
+                                 &parts_ex](std::exception_ptr ex) mutable {
+      if (ex == nullptr) {
+        try {
+          for (int i = 0; i < outputs.size(); i++) {
+            auto tensor = infer_req.get_output_tensor(m_out_idx[i]);
+            part_outputs[r][i] = std::make_shared<IETensor>(
+                tensor.get_element_type(), tensor.get_shape(),
+                BufferPool::GetAllocator(m_device));
+            part_outputs[r][i]->write(tensor.data(), tensor.get_byte_size());
+          }
+        } catch (...) {
+          ex = std::current_exception();
+        }
+      }
+      std::lock_guard<std::mutex> lock(parts_mutex);
+      if (ex != nullptr) parts_ex = ex;
+      if (--parts_pending == 0) parts_done.notify_all();
+    });
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(parts_mutex);
+    parts_done.wait(lock, [&parts_pending] { return parts_pending == 0; });
+  }
+  if (parts_ex != nullptr) std::rethrow_exception(parts_ex);
+
+  // Concatenate the parts along the batch dimension
+  for (int i = 0; i < outputs.size(); i++) {
+    ov::Shape shape = part_outputs[0][i]->get_shape();
+    if (shape.empty()) {
+      throw std::runtime_error("Output without a batch dimension");
+    }
+    shape[0] = 0;
+    for (size_t r = 0; r < num_req; r++) {
+      ov::Shape part_shape = part_outputs[r][i]->get_shape();
+      if (part_shape.size() != shape.size() ||
+          !std::equal(part_shape.begin() + 1, part_shape.end(),
+                      shape.begin() + 1)) {
+        throw std::runtime_error("Split batch outputs can not be concatenated");
+      }
+      shape[0] += part_shape[0];
+    }
+    outputs[i] = std::make_shared<IETensor>(
+        part_outputs[0][i]->get_element_type(), shape,
+        BufferPool::GetAllocator(m_device));
+    uint8_t* dst = static_cast<uint8_t*>(outputs[i]->data());
+    for (size_t r = 0; r < num_req; r++) {
+      size_t part_bytes = part_outputs[r][i]->get_byte_size();
+      HostCopy::Copy(dst, part_outputs[r][i]->data(), part_bytes);
+      dst += part_bytes;
     }
   }
+  return true;
+}
+
+void IE_Basic_Engine::infer(
+    std::vector<std::shared_ptr<IETensor>>& inputs,
+    std::vector<std::string>& input_names,
+    std::vector<std::shared_ptr<IETensor>>& outputs,
+    std::vector<std::string>& output_names,
+    std::vector<std::shared_ptr<IETensor>>& hoisted_params,
+    std::vector<std::string>& param_names) {
+  load_network();
+  init_io_indices(input_names, param_names, output_names);
+  if (infer_split_batch(inputs, outputs, hoisted_params)) {
+    OVTF_VLOG(4) << "Inference Successful";
+    return;
+  }
+
+  // Each concurrent caller gets its own infer request from the pool
+  InferRequestGuard req_guard(this);
+  ov::InferRequest& infer_req = req_guard.request();
+
+  bind_tensors(infer_req, req_guard.bindings(), inputs, input_names, outputs,
+               output_names, hoisted_params, param_names);
+  const bool profile_layers = LayerProfile::Enabled();
+  int64_t start_ns = 0;
+  {
+    // Waits for the device to have room, the other clusters may have
+    // requests in flight on it
+    DeviceScheduler::Slot slot(m_device, m_priority);
+    // Cancelling the step stops the inference, which then throws
+    StepCancellation::Registration cancellation(
+        [&infer_req]() { infer_req.cancel(); });
+    if (cancellation.cancelled()) throw StepCancellation::Cancelled();
+    if (profile_layers) start_ns = EnvTime::NowNanos();
+    infer_req.infer();
+  }
+  if (profile_layers) {
+    LayerProfile::Record(m_model->get_friendly_name(), infer_req, start_ns,
+                         EnvTime::NowNanos());
+  }
+  read_dynamic_outputs(infer_req, outputs, output_names);
   OVTF_VLOG(4) << "Inference Successful";
 }
+
+void IE_Basic_Engine::infer_async(
+    std::vector<std::shared_ptr<IETensor>>& inputs,
+    std::vector<std::string>& input_names,
+    std::vector<std::shared_ptr<IETensor>>& outputs,
+    std::vector<std::string>& output_names,
+    std::vector<std::shared_ptr<IETensor>>& hoisted_params,
+    std::vector<std::string>& param_names, InferCallback callback) {
+  load_network();
+  init_io_indices(input_names, param_names, output_names);
+
+  ov::InferRequest infer_req;
+  StickyBindings* bindings = nullptr;
+  const int req_id = acquire_infer_request(infer_req, &bindings);
+  try {
+    bind_tensors(infer_req, *bindings, inputs, input_names, outputs,
+                 output_names, hoisted_params, param_names);
+  } catch (...) {
+    release_infer_request(req_id);
+    throw;
+  }
+
+  const bool profile_layers = LayerProfile::Enabled();
+  const int64_t start_ns = profile_layers ? EnvTime::NowNanos() : 0;
+  start_async_request(req_id, [this, infer_req, &outputs, &output_names,
+                               callback, profile_layers,
+                               start_ns](std::exception_ptr ex) mutable {
+    if (ex == nullptr) {
+      try {
+        if (profile_layers) {
+          LayerProfile::Record(m_model->get_friendly_name(), infer_req,
+                               start_ns, EnvTime::NowNanos());
+        }
+        read_dynamic_outputs(infer_req, outputs, output_names);
+        OVTF_VLOG(4) << "Async inference Successful";
+      } catch (...) {
+        ex = std::current_exception();
+      }
+    }
+    callback(ex);
+  });
+}
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
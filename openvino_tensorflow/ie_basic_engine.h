@@ -33,9 +33,44 @@ class IE_Basic_Engine : public IE_Backend_Engine {
                      std::vector<std::shared_ptr<IETensor>>& hoisted_params,
                      std::vector<std::string>& param_names);
 
+  // Starts the inference on a pooled infer request without blocking
+  virtual void infer_async(
+      std::vector<std::shared_ptr<IETensor>>& inputs,
+      std::vector<std::string>& input_names,
+      std::vector<std::shared_ptr<IETensor>>& outputs,
+      std::vector<std::string>& output_names,
+      std::vector<std::shared_ptr<IETensor>>& hoisted_params,
+      std::vector<std::string>& param_names, InferCallback callback);
+
   virtual const std::vector<size_t> get_output_shape(const int i) {
     return m_model->get_results()[i]->get_shape();
   };
+
+ private:
+  // Sets the given input, hoisted parameter and preallocated output tensors
+  // on infer_req, the inputs and parameters through its bindings
+  void bind_tensors(ov::InferRequest& infer_req, StickyBindings& bindings,
+                    std::vector<std::shared_ptr<IETensor>>& inputs,
+                    std::vector<std::string>& input_names,
+                    std::vector<std::shared_ptr<IETensor>>& outputs,
+                    std::vector<std::string>& output_names,
+                    std::vector<std::shared_ptr<IETensor>>& hoisted_params,
+                    std::vector<std::string>& param_names);
+
+  // With multi request execution, splits the inputs along their batch
+  // dimension across up to the optimal number of infer requests, runs them
+  // in parallel and concatenates their outputs. Returns false without
+  // running anything unless every input and output of the model has a
+  // dynamic batch dimension and no output is preallocated.
+  bool infer_split_batch(
+      std::vector<std::shared_ptr<IETensor>>& inputs,
+      std::vector<std::shared_ptr<IETensor>>& outputs,
+      std::vector<std::shared_ptr<IETensor>>& hoisted_params);
+
+  // Fills the outputs which were not preallocated from infer_req
+  void read_dynamic_outputs(ov::InferRequest& infer_req,
+                            std::vector<std::shared_ptr<IETensor>>& outputs,
+                            std::vector<std::string>& output_names);
 };
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
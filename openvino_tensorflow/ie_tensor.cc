@@ -8,6 +8,7 @@
 #include <memory>
 #include <utility>
 
+#include "host_copy.h"
 #include "ie_layouts.h"
 #include "ie_precision.hpp"
 #include "ie_tensor.h"
@@ -21,10 +22,17 @@ namespace openvino_tensorflow {
 
 IETensor::IETensor(const ov::element::Type& element_type, const Shape& shape_,
                    void* memory_pointer)
-    : ov::Tensor(element_type, shape_, memory_pointer) {}
+    : ov::Tensor(element_type, shape_, memory_pointer), m_owns_memory(false) {}
 
 IETensor::IETensor(const ov::element::Type& element_type, const Shape& shape)
-    : ov::Tensor(element_type, shape) {}
+    : ov::Tensor(element_type, shape), m_owns_memory(true) {}
+
+IETensor::IETensor(const ov::element::Type& element_type, const Shape& shape,
+                   const ov::Allocator& allocator)
+    : ov::Tensor(element_type, shape, allocator), m_owns_memory(true) {}
+
+IETensor::IETensor(const ov::Tensor& tensor)
+    : ov::Tensor(tensor), m_owns_memory(true) {}
 
 // IETensor::IETensor(const ov::element::Type& element_type, const PartialShape&
 // shape)
@@ -40,7 +48,7 @@ void IETensor::write(const void* src, size_t bytes) {
     return;
   }
 
-  copy(src_ptr, src_ptr + bytes, (uint8_t*)(this->data()));
+  HostCopy::Copy(this->data(), src_ptr, bytes);
 }
 
 void IETensor::read(void* dst, size_t bytes) const {
@@ -49,8 +57,27 @@ void IETensor::read(void* dst, size_t bytes) const {
     return;
   }
 
-  copy((uint8_t*)(this->data()), ((uint8_t*)(this->data())) + bytes, dst_ptr);
+  HostCopy::Copy(dst_ptr, this->data(), bytes);
+}
+
+#if TF_VERSION >= 2
+IETensorBuffer::IETensorBuffer(std::shared_ptr<IETensor> tensor)
+    : TensorBuffer(tensor->data()), m_tensor(std::move(tensor)) {}
+
+size_t IETensorBuffer::size() const { return m_tensor->get_byte_size(); }
+
+void IETensorBuffer::FillAllocationDescription(
+    AllocationDescription* proto) const {
+  proto->set_requested_bytes(static_cast<int64>(size()));
+  proto->set_allocator_name("OpenVINO");
+}
+
+bool IETensorBuffer::CanWrap(const IETensor& tensor) {
+  return tensor.owns_memory() &&
+         reinterpret_cast<uintptr_t>(tensor.data()) % EIGEN_MAX_ALIGN_BYTES ==
+             0;
 }
+#endif
 
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/framework/tensor.h"
 
@@ -19,16 +21,60 @@ class IETensor : public ov::Tensor {
   IETensor(const ov::element::Type& element_type, const ov::Shape& shape);
   IETensor(const ov::element::Type& element_type, const ov::Shape& shape,
            void* memory_pointer);
+  // Allocates the memory of the tensor with allocator, e.g. one of the
+  // BufferPool
+  IETensor(const ov::element::Type& element_type, const ov::Shape& shape,
+           const ov::Allocator& allocator);
+  // Shares the memory of tensor, e.g. a host tensor of a remote context,
+  // for as long as the IETensor lives
+  explicit IETensor(const ov::Tensor& tensor);
   ~IETensor();
 
   void write(const void* src, size_t bytes);
   void read(void* dst, size_t bytes) const;
 
+  // False if the tensor wraps memory it does not own, e.g. a TF tensor or
+  // the output of an infer request
+  bool owns_memory() const { return m_owns_memory; }
+
+  // The tensor of a device context sharing the memory of the tensor, e.g.
+  // a USM tensor of the GPU context, which the infer requests are bound to
+  // instead of the tensor
+  void set_device_tensor(const ov::Tensor& tensor) { m_device_tensor = tensor; }
+  const ov::Tensor& device_tensor() const {
+    return m_device_tensor ? m_device_tensor : *this;
+  }
+
  private:
   IETensor(const IETensor&) = delete;
   IETensor(IETensor&&) = delete;
   IETensor& operator=(const IETensor&) = delete;
+
+  bool m_owns_memory;
+  ov::Tensor m_device_tensor;
+};
+
+#if TF_VERSION >= 2
+// Hands the memory of an IETensor to a TF Tensor without copying it. The
+// buffer keeps the IETensor alive for as long as TF references it.
+class IETensorBuffer : public TensorBuffer {
+ public:
+  explicit IETensorBuffer(std::shared_ptr<IETensor> tensor);
+
+  size_t size() const override;
+  TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(AllocationDescription* proto) const override;
+
+  // Whether tensor can back a TF Tensor: it must own its memory, which must
+  // be aligned as Eigen expects
+  static bool CanWrap(const IETensor& tensor);
+
+  const std::shared_ptr<IETensor>& tensor() const { return m_tensor; }
+
+ private:
+  std::shared_ptr<IETensor> m_tensor;
 };
+#endif
 
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
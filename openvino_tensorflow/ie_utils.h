@@ -19,10 +19,10 @@
 
 class IE_Utils {
  public:
-  // Returns the maxiumum number of requests based on the device.
-  // TODO: The number of requests are hardcoded temporarly.
-  // This should dynamically look at the underlying architecture
-  // and compute the best performing number of requests.
+  // Returns the maxiumum number of requests based on the device. Only used
+  // by VAD-M, which has to reshape the model to the per request batch before
+  // it is compiled and can not ask the compiled model. The other devices use
+  // ov::optimal_number_of_infer_requests of the compiled model.
   static size_t GetMaxReq(std::string device) {
     int max_req = 1;
     if (device == "HDDL") max_req = 8;
@@ -7,6 +7,7 @@
 #include <iostream>
 #include <memory>
 
+#include "openvino_tensorflow/buffer_pool.h"
 #include "openvino_tensorflow/ie_utils.h"
 #include "openvino_tensorflow/ie_vadm_engine.h"
 
@@ -15,6 +16,9 @@ namespace openvino_tensorflow {
 
 IE_VADM_Engine::IE_VADM_Engine(std::shared_ptr<ov::Model> model)
     : IE_Backend_Engine(model, "HDDL"), m_orig_batch_size(0) {
+  // The requests are created by infer once the batch split is known, and
+  // are waited on directly instead of completing through the pool
+  m_pool_requests = false;
   // FIXME: Paremeter layouts should be set based on the
   // destination op types
   bool has_batch = false;
@@ -53,6 +57,7 @@ void IE_VADM_Engine::infer(
     std::vector<std::string>& output_names,
     std::vector<std::shared_ptr<IETensor>>& hoisted_params,
     std::vector<std::string>& param_names) {
+  std::lock_guard<std::mutex> lock(m_infer_mutex);
   // Batch size is 0 and the number of requests is 1 when
   // multi request execution is disabled.
   int num_req = 1;
@@ -103,6 +108,7 @@ void IE_VADM_Engine::infer(
   load_network();
   while (m_infer_reqs.size() < num_req) {
     m_infer_reqs.push_back(m_compiled_model.create_infer_request());
+    m_req_bindings.emplace_back(new StickyBindings());
   }
   //  Prepare input blobs
   if (m_in_idx.size() == 0) {
@@ -113,21 +119,24 @@ void IE_VADM_Engine::infer(
       }
     }
   }
+  // Each request reads its slice of the batch in place from a view over
+  // the TF input
   for (int i = 0; i < inputs.size(); i++) {
     if (inputs[i] == nullptr) continue;
-    const void* input_data_pointer = inputs[i]->data();
+    uint8_t* input_data_pointer = (uint8_t*)(inputs[i]->data());
+    const int in_idx = m_in_idx[i];
+    if (in_idx < 0) {
+      throw std::runtime_error("Input parameter with friendly name " +
+                               input_names[i] + " not found in ov::Model");
+    }
+    auto input = m_compiled_model.input(in_idx);
+    ov::Shape req_shape = input.get_shape();
+    size_t input_data_size =
+        ov::shape_size(req_shape) * input.get_element_type().size();
     for (int j = 0; j < num_req; j++) {
-      const int in_idx = m_in_idx[i];
-      if (in_idx < 0) {
-        throw std::runtime_error("Input parameter with friendly name " +
-                                 input_names[i] + " not found in ov::Model");
-      }
-      auto tensor = m_infer_reqs[j].get_input_tensor(in_idx);
-      size_t input_data_size = tensor.get_byte_size();
-      auto data_ptr =
-          (uint8_t*)((uint64_t)(input_data_pointer) + input_data_size * j);
-      std::copy((uint8_t*)(data_ptr), ((uint8_t*)(data_ptr)) + input_data_size,
-                (uint8_t*)(tensor.data()));
+      ov::Tensor tensor(input.get_element_type(), req_shape,
+                        input_data_pointer + input_data_size * j);
+      m_req_bindings[j]->bind_input(m_infer_reqs[j], in_idx, tensor);
     }
   }
   if (m_param_idx.size() == 0) {
@@ -145,11 +154,42 @@ void IE_VADM_Engine::infer(
       throw std::runtime_error("Input parameter with friendly name " +
                                param_names[i] + " not found in ov::Model");
     }
-    auto tensor = m_infer_reqs[0].get_input_tensor(in_idx);
-    size_t input_data_size = tensor.get_byte_size();
-    std::copy((uint8_t*)(hoisted_params[i]->data()),
-              ((uint8_t*)(hoisted_params[i]->data())) + input_data_size,
-              (uint8_t*)(tensor.data()));
+    m_req_bindings[0]->bind_input(m_infer_reqs[0], in_idx,
+                                  *(hoisted_params[i]));
+  }
+
+  // The outputs split along the batch are gathered in place: each request
+  // writes its slice into a view over the output handed to TF
+  if (m_out_idx.size() == 0) {
+    m_out_idx.resize(outputs.size());
+    for (int i = 0; i < outputs.size(); i++) {
+      m_out_idx[i] = get_output_idx(output_names[i]);
+    }
+  }
+  for (int i = 0; i < outputs.size() && batch_size > 0; i++) {
+    const int out_idx = m_out_idx[i];
+    if (outputs[i] != nullptr || out_idx < 0) continue;
+    auto output = m_compiled_model.output(out_idx);
+    ov::Shape out_shape = output.get_shape();
+    if (out_shape.size() < 2 || out_shape[0] != batch_size) continue;
+    size_t req_size =
+        ov::shape_size(out_shape) * output.get_element_type().size();
+    ov::Shape req_shape = out_shape;
+    out_shape[0] = m_orig_batch_size;
+    outputs[i] = std::make_shared<IETensor>(output.get_element_type(),
+                                            out_shape,
+                                            BufferPool::GetAllocator(m_device));
+    if (req_size * num_req > outputs[i]->get_byte_size()) {
+      throw std::runtime_error("Output with friendly name " +
+                               output_names[i] +
+                               " is smaller than the split batch");
+    }
+    uint8_t* out_ptr = (uint8_t*)(outputs[i]->data());
+    for (int j = 0; j < num_req; j++) {
+      ov::Tensor tensor(output.get_element_type(), req_shape,
+                        out_ptr + req_size * j);
+      m_infer_reqs[j].set_output_tensor(out_idx, tensor);
+    }
   }
 
   // Start Inference Requests
@@ -161,14 +201,7 @@ void IE_VADM_Engine::infer(
     complete_async_inference(i);
   }
 
-  // Set output tensors
-  auto results = m_model->get_results();
-  if (m_out_idx.size() == 0) {
-    m_out_idx.resize(outputs.size());
-    for (int i = 0; i < outputs.size(); i++) {
-      m_out_idx[i] = get_output_idx(output_names[i]);
-    }
-  }
+  // Set the outputs which are not split along the batch
   for (int i = 0; i < outputs.size(); i++) {
     if (outputs[i] == nullptr) {
       const int out_idx = m_out_idx[i];
@@ -177,23 +210,12 @@ void IE_VADM_Engine::infer(
                                  output_names[i] + " not found in ov::Model");
       }
       auto tensor = m_infer_reqs[0].get_output_tensor(out_idx);
-      ov::Shape out_shape = tensor.get_shape();
-      if (batch_size == 0 || out_shape.size() < 2 ||
-          out_shape[0] != batch_size) {
-        outputs[i] = std::make_shared<IETensor>(tensor.get_element_type(),
-                                                out_shape, tensor.data());
-      } else {
-        out_shape[0] = m_orig_batch_size;
-        size_t req_size = tensor.get_byte_size();
-        outputs[i] =
-            std::make_shared<IETensor>(tensor.get_element_type(), out_shape);
-        uint8_t* out_ptr = (uint8_t*)(outputs[i]->data());
-        for (int j = 0; j < num_req; j++) {
-          auto req_tensor = m_infer_reqs[j].get_output_tensor(out_idx);
-          uint8_t* req_ptr = (uint8_t*)(req_tensor.data());
-          std::copy(req_ptr, req_ptr + req_size, out_ptr + (req_size * j));
-        }
-      }
+      // The request memory is reused by the next call once the lock is
+      // released, the copy is handed to TF as is
+      outputs[i] = std::make_shared<IETensor>(
+          tensor.get_element_type(), tensor.get_shape(),
+          BufferPool::GetAllocator(m_device));
+      outputs[i]->write(tensor.data(), tensor.get_byte_size());
     }
   }
 }
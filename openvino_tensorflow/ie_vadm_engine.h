@@ -8,6 +8,7 @@
 #define IE_VADM_ENGINE_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -42,6 +43,9 @@ class IE_VADM_Engine : public IE_Backend_Engine {
 
  private:
   int m_orig_batch_size;
+  // The batch splitting reshapes m_model and reuses the first num_req
+  // requests, so calls into this engine are serialized
+  std::mutex m_infer_mutex;
 };
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
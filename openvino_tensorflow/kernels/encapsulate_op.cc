@@ -3,20 +3,39 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdlib>
+#include <cstring>
+#include <map>
 #include <mutex>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "tensorflow/core/common_runtime/dma_helper.h"
 #include "tensorflow/core/common_runtime/function.h"
 #include "tensorflow/core/common_runtime/optimization_registry.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/graph_to_functiondef.h"
 #include "tensorflow/core/framework/node_def_util.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/gtl/cleanup.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
+#include "tensorflow/core/platform/notification.h"
+#include "tensorflow/core/platform/threadpool.h"
+#include "tensorflow/core/profiler/lib/traceme.h"
+#include "tensorflow/core/profiler/lib/traceme_encode.h"
 #include "tensorflow/core/public/version.h"
 #if (TF_MAJOR_VERSION >= 2) && (TF_MINOR_VERSION > 2)
 #include "tensorflow/core/common_runtime/graph_constructor.h"
@@ -27,12 +46,30 @@
 #include "tensorflow/core/public/session.h"
 
 #include "logging/ovtf_log.h"
+#include "openvino_tensorflow/aot_bundle.h"
 #include "openvino_tensorflow/backend_manager.h"
+#include "openvino_tensorflow/buffer_pool.h"
 #include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/cluster_profile.h"
+#include "openvino_tensorflow/compilation_key.h"
+#include "openvino_tensorflow/compile_properties.h"
+#include "openvino_tensorflow/compile_tiering.h"
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/host_copy.h"
+#include "openvino_tensorflow/ie_tensor.h"
+#include "openvino_tensorflow/kv_cache.h"
+#include "openvino_tensorflow/layer_profile.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
+#include "openvino_tensorflow/memory_budget.h"
+#include "openvino_tensorflow/metrics.h"
+#include "openvino_tensorflow/op_support.h"
 #include "openvino_tensorflow/ovtf_builder.h"
 #include "openvino_tensorflow/ovtf_timer.h"
 #include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/shape_bucketing.h"
+#include "openvino_tensorflow/static_input_tracker.h"
+#include "openvino_tensorflow/step_cancellation.h"
+#include "openvino_tensorflow/usm_host_allocator.h"
 
 #ifdef _WIN32
 #define EXPAND(x) x
@@ -47,76 +84,466 @@ using namespace std;
 namespace tensorflow {
 namespace openvino_tensorflow {
 
-class NGraphEncapsulateOp : public OpKernel {
+// Thread pool shared by all the encapsulate kernels for background
+// compilation. It is never destroyed so that it outlives every kernel.
+static thread::ThreadPool* GetCompileThreadPool() {
+  static thread::ThreadPool* pool = []() {
+    int num_threads = 1;
+    string num_threads_env = util::GetEnv("OPENVINO_TF_COMPILE_THREADS");
+    if (!num_threads_env.empty()) {
+      num_threads = std::max(1, std::stoi(num_threads_env));
+    }
+    return new thread::ThreadPool(Env::Default(), "ovtf_compile",
+                                  num_threads);
+  }();
+  return pool;
+}
+
+// Compiles the cache misses of every cluster in parallel while warming up
+static thread::ThreadPool* GetWarmupThreadPool() {
+  static thread::ThreadPool* pool = []() {
+    int num_threads = std::min(4, port::MaxParallelism());
+    string num_threads_env = util::GetEnv("OPENVINO_TF_WARMUP_THREADS");
+    if (!num_threads_env.empty()) {
+      num_threads = std::max(1, std::stoi(num_threads_env));
+    }
+    return new thread::ThreadPool(Env::Default(), "ovtf_warmup",
+                                  std::max(1, num_threads));
+  }();
+  return pool;
+}
+
+// Holds one of the OPENVINO_TF_MAX_CONCURRENT_COMPILES slots of the
+// translations and compilations running at once across the clusters, so
+// that the cache misses of many signatures do not all compile together
+class CompileSlot {
+ public:
+  CompileSlot() {
+    std::unique_lock<std::mutex> lock(Mutex());
+    Released().wait(lock, [] { return Running() < Limit(); });
+    Running()++;
+  }
+  ~CompileSlot() {
+    {
+      std::lock_guard<std::mutex> lock(Mutex());
+      Running()--;
+    }
+    Released().notify_one();
+  }
+
+ private:
+  static int Limit() {
+    static const int limit = []() {
+      int limit = std::min(4, port::MaxParallelism());
+      string limit_env = util::GetEnv("OPENVINO_TF_MAX_CONCURRENT_COMPILES");
+      if (!limit_env.empty()) limit = std::stoi(limit_env);
+      return std::max(1, limit);
+    }();
+    return limit;
+  }
+  static std::mutex& Mutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+  static std::condition_variable& Released() {
+    static std::condition_variable released;
+    return released;
+  }
+  static int& Running() {
+    static int running = 0;
+    return running;
+  }
+};
+
+class NGraphEncapsulateOp : public AsyncOpKernel {
  public:
   explicit NGraphEncapsulateOp(OpKernelConstruction* ctx);
   ~NGraphEncapsulateOp() override;
   void Compute(OpKernelContext* ctx) override;
+  void ComputeAsync(OpKernelContext* ctx, DoneCallback done) override;
 
  private:
+  // The signature a lookup computed for the inputs of a step, and whether
+  // the step runs on TF since the signature failed before
+  struct SignatureLookup {
+    CompilationKey signature;
+    bool computed = false;
+    bool fell_back = false;
+  };
+
+  // The per call state shared by the phases of a Compute
+  struct ComputeState {
+    std::shared_ptr<Executable> ng_exec;
+    std::vector<shared_ptr<ov::Tensor>> ng_inputs;
+    std::vector<shared_ptr<ov::Tensor>> ng_func_outputs;
+    std::vector<int> dyn_shape_tensors;
+    std::vector<int> output_mappings;
+    std::string device;
+    bool multi_req_execution = false;
+    // Cancels the inference and the compilations of the step when TF
+    // cancels it
+    std::shared_ptr<StepCancellation> cancellation;
+    // The executable is being compiled in the background, this step runs on
+    // TF without marking its signature as failed
+    bool compile_pending = false;
+    // The backend selector picked TF for this step, and whether the step is
+    // timed for it
+    bool tf_selected = false;
+    bool timed_step = false;
+    // The outputs of a trivial executable were set without calling it
+    bool outputs_set = false;
+    // The signature is cold, this step runs on TF instead of compiling it
+    bool cold = false;
+    CompilationKey cold_signature;
+    SignatureLookup lookup;
+    int step_id = 0;
+    // Inputs padded up to their shape bucket, and the outputs computed from
+    // them which are sliced into the TF outputs once the call is done
+    ShapeBucketing::Padding padding;
+    std::vector<Tensor> padded_inputs;
+    std::vector<Tensor> padded_outputs;
+    // The rows of the batched inputs, run in chunks of chunk_rows through
+    // the executable of a chunk. chunk_rows is 0 if the call is not
+    // chunked.
+    int64 batch = 0;
+    int64 chunk_rows = 0;
+    std::vector<bool> batched_inputs;
+    // The variable buffers bound to the call
+    std::vector<Tensor> variable_inputs;
+    // Some output was forwarded from an input, which the inference writes
+    // over
+    bool inputs_forwarded = false;
+    Timer compute_time;
+    int time_func_create_or_lookup = 0;
+    int time_create_or_lookup_tensors = 0;
+    Timer execute_function;
+    // The profiler activity of an asynchronous execution
+    int64 execute_activity = 0;
+  };
+
+  // Gets the executable and binds the TF input and output tensors. Sets
+  // fallback when the cluster has to run on native TF instead.
+  Status PrepareCompute(OpKernelContext* ctx, ComputeState& state,
+                        bool& fallback);
+  // Copies the outputs which could not be preallocated into the TF outputs
+  Status FinishCompute(OpKernelContext* ctx, ComputeState& state);
+  // Builds the TF tensors of the constant outputs of a trivial executable,
+  // with m_exec_cache_lock_ held
+  Status BuildConstantOutputs(OpKernelContext* ctx, Executable& ng_exec,
+                              std::vector<Tensor>& constant_outputs);
+  // Sets the outputs of a trivial executable without calling it, forwarding
+  // the inputs and sharing the constant tensors. Sets outputs_set unless
+  // some output needs the executable.
+  Status SetTrivialOutputs(OpKernelContext* ctx, ComputeState& state);
+  // Allocates TF output i, or a temporary for it when the inputs are padded.
+  // Forwards an input of the output which is not read after the cluster
+  // instead when there is one.
+  Status AllocateOutput(OpKernelContext* ctx, ComputeState& state, int i,
+                        const TensorShape& shape, Tensor** output_tensor);
+  // Sets TF output i to a host tensor of the shared GPU context, which the
+  // GPU clusters reading it bind without uploading it. Leaves ng_output
+  // null if the context can not allocate it.
+  Status AllocateSharedOutput(OpKernelContext* ctx, int i,
+                              const ov::element::Type& type,
+                              const ov::Shape& shape,
+                              std::shared_ptr<IETensor>& ng_output);
+  // Sets TF output i from an output produced by the engine. The memory is
+  // handed to TF without a copy when it is owned by the engine tensor and
+  // suitably aligned.
+  Status SetOutput(OpKernelContext* ctx, ComputeState& state, int i,
+                   const TensorShape& shape,
+                   const std::shared_ptr<ov::Tensor>& ng_output);
+  // Sets the batch of a call to run in chunks, and the inputs of a chunk
+  // which the executable is looked up for. Returns false if the call is
+  // not chunked. Requires m_exec_cache_lock_.
+  bool SplitBatch(const std::vector<Tensor>& tf_input_tensors,
+                  ComputeState& state, std::vector<Tensor>& chunk_tensors);
+  // Handles an exception thrown by the executable, either by falling back
+  // to native TF or by returning an error
+  Status HandleCallError(OpKernelContext* ctx, ComputeState& state,
+                         std::exception_ptr ex);
+
+  // Sets the variables of the KV-caches which do not hold the past of this
+  // step from their TF inputs
+  Status SetKVCaches(const std::vector<Tensor>& tf_input_tensors,
+                     Executable& ng_exec, KVCacheState& kv_cache);
+  // Whether the next executable should be compiled with dynamic dimensions
+  // for the non-static inputs
+  bool UseDynamicShapes(const std::vector<Tensor>& tf_input_tensors);
+  // The signature of the inputs, with the values of the inputs translated
+  // as constants
+  Status ComputeSignature(const std::vector<Tensor>& tf_input_tensors,
+                          bool dynamic_shapes,
+                          const std::vector<bool>& input_is_static,
+                          CompilationKey& signature);
+  // A cold signature, see CompileTiering, is not compiled when
+  // cold_signature is given. ng_exec is left null and cold_signature set to
+  // it instead. ng_exec is left null too for a signature which fell back,
+  // lookup is given the signature and whether it did.
+  //
+  // Called with exec_cache_lock held on m_exec_cache_lock_, which is
+  // released while compiling. The concurrent misses of a signature
+  // compile it once: the first compiles it, the others wait for it.
   Status GetExecutable(const std::vector<Tensor>& tf_input_tensors,
-                       std::shared_ptr<Executable>& ng_exec);
-  Status Fallback(OpKernelContext* ctx);
-
-  std::mutex m_compute_lock_;
-  Graph m_graph;
+                       std::unique_lock<std::mutex>& exec_cache_lock,
+                       std::shared_ptr<Executable>& ng_exec,
+                       CompilationKey* cold_signature = nullptr,
+                       SignatureLookup* lookup = nullptr);
+  // Translates and compiles the cluster for the given inputs, within a
+  // CompileSlot. Does not touch the executable cache.
+  Status BuildExecutable(const std::vector<Tensor>& tf_input_tensors,
+                         bool dynamic_shapes,
+                         const std::vector<bool>& input_is_static,
+                         const CompilationKey& signature,
+                         std::shared_ptr<Executable>& ng_exec);
+  // Translates the cluster for the given inputs by reshaping the model
+  // translated once with dynamic dimensions for the non-static inputs and
+  // the same static input values. Returns false if the inputs can not reuse
+  // a translation, and the cluster has to be translated for them.
+  bool ReshapeTranslatedModel(const std::vector<Tensor>& tf_input_tensors,
+                              const std::vector<TensorShape>& input_shapes,
+                              const std::vector<const Tensor*>& static_inputs,
+                              std::shared_ptr<ov::Model>& ng_function,
+                              ov::ResultVector& ng_result_list);
+  // Fails if a device of the backend does not support an op of the model,
+  // recording the TF ops they were translated from as unsupported on it
+  Status CheckDeviceSupport(Backend& backend,
+                            const std::shared_ptr<ov::Model>& ng_function);
+  // Imports the compiled model of the executable from the AOT bundle, or
+  // exports it to the bundle, depending on the mode of the bundle
+  void UseAOTBundle(const CompilationKey& signature, Executable& ng_exec);
+  // The settings the models of the executables are translated and
+  // transformed with, which the AOT bundle entries depend on
+  string ModelSettings() const;
+  // Whether a variable converted to a constant of the cached executable was
+  // written, in which case the executables of the cluster are evicted
+  bool ConstantVariablesWritten(const std::vector<Tensor>& tf_input_tensors,
+                                Executable& ng_exec);
+  void InsertExecutable(const CompilationKey& signature,
+                        std::shared_ptr<Executable> ng_exec);
+  // Looks the signature up in the cache of the cluster, then among the
+  // executables of the structurally identical clusters
+  bool LookupExecutable(const CompilationKey& signature,
+                        std::shared_ptr<Executable>& ng_exec);
+  // Lets the identical clusters share their executables, unless the cluster
+  // reads variables
+  void ShareExecutables(OpKernelConstruction* ctx);
+  // Like GetExecutable, but a cache miss schedules the compilation on the
+  // background compile pool and sets compile_pending instead of blocking
+  Status GetExecutableOrCompileInBackground(
+      const std::vector<Tensor>& tf_input_tensors,
+      std::shared_ptr<Executable>& ng_exec, bool& compile_pending,
+      CompilationKey* cold_signature = nullptr,
+      SignatureLookup* lookup = nullptr);
+  // Whether the signature failed and its steps run on TF. Sets lookup.
+  bool SignatureFellBack(const CompilationKey& signature,
+                         SignatureLookup* lookup);
+  // Whether signature, a cache miss, is not worth compiling yet. Requires
+  // m_exec_cache_lock_.
+  bool IsColdSignature(const CompilationKey& signature,
+                       CompilationKey* cold_signature);
+  // Runs a step that PrepareCompute did not bind to the executable on TF,
+  // falling back unless the step only temporarily runs on TF
+  Status RunStepOnTF(OpKernelContext* ctx, ComputeState& state);
+  // Runs the cluster on native TF and marks the signature of the step to
+  // do so from now on, or the whole cluster if the step has no signature
+  Status Fallback(OpKernelContext* ctx, ComputeState& state);
+  // Marks the signature of the step, or the cluster, to run on TF
+  void RecordFallback(ComputeState& state);
+  // Why a step runs on native TF
+  enum class TFStep {
+    // The cluster, or the signature of the step, failed on OpenVINO
+    kFallback,
+    // The executable of the signature is compiling in the background
+    kCompilePending,
+    // A cold signature, or a step the backend selection runs on TF
+    kChosen,
+  };
+  // Runs the cluster on native TF for this step only
+  Status RunOnTF(OpKernelContext* ctx, TFStep reason);
+  // Instantiates the cluster graph as a function of the kernel's function
+  // library runtime, on first use
+  Status GetFallbackFunction(OpKernelContext* ctx,
+                             FunctionLibraryRuntime::Handle* handle);
+  // Runs the cluster in a private session, when it can not be run through
+  // the function library runtime
+  Status RunOnSession(OpKernelContext* ctx);
+  // Sets the outputs of a step run on TF, copying them into the outputs a
+  // failed attempt on OpenVINO already allocated
+  Status SetTFOutputs(OpKernelContext* ctx, const std::vector<Tensor>& rets);
+
+  // Compute may be called concurrently from several TF threads. Only the
+  // executable cache and the fallback session setup are guarded, the
+  // executables themselves hand out one infer request per caller.
+  std::mutex m_exec_cache_lock_;
+  std::mutex m_fallback_lock_;
+  // Run the executable with start_async instead of blocking the TF thread
+  bool m_async_execution;
+  // Compile cache misses on a background thread and run the step on TF
+  bool m_background_compilation;
+  // Compile cache misses on the warm-up pool, as during a warm-up, which was
+  // requested through the graph's RewriterConfig
+  bool m_warmup_compilation = false;
+  // Runs the cold signatures on TF, null unless OPENVINO_TF_COMPILE_MIN_STEPS
+  // or OPENVINO_TF_COMPILE_MIN_TF_MS is set
+  std::unique_ptr<CompileTiering> m_tiering;
+  // Compile one executable per input rank instead of one per input shape.
+  // Cleared, under m_exec_cache_lock_, if the cluster can not be translated
+  // or compiled with dynamic dimensions.
+  bool m_dynamic_shapes;
+  // OPENVINO_TF_ENABLE_BATCHING is set
+  bool m_multi_req_execution;
+  // Choose between the executable and native TF from their latencies
+  bool m_auto_backend_selection;
+  ShapeBucketing m_shape_bucketing;
+  // Set once a padded call can not be sliced back, the inputs are not
+  // padded anymore
+  std::atomic<bool> m_padding_disabled{false};
+  // OPENVINO_TF_BATCH_CHUNK_SIZE, the rows of the chunks the larger batches
+  // run in. Cleared, under m_exec_cache_lock_, if the outputs of the
+  // cluster do not follow the batch of its inputs.
+  int64 m_batch_chunk_rows = 0;
+  // Specialize the models translated with dynamic dimensions through
+  // reshape instead of translating the cluster for every input shape
+  bool m_reuse_translation;
+  // The models translated with dynamic dimensions, by their dynamic
+  // signature, null if the cluster can not be reshaped for that signature
+  std::unordered_map<CompilationKey, std::shared_ptr<ov::Model>,
+                     CompilationKey::Hasher>
+      m_translated_models;
+  std::mutex m_translated_models_lock_;
+  // Query the devices for the ops they support before compiling
+  bool m_query_op_support;
+  // The OpenVINO properties the executables are compiled with
+  ov::AnyMap m_compile_config;
+  // The backend of the session, captured at construction, and its name as
+  // given by BackendManager::GetBackendName
+  shared_ptr<Backend> m_backend;
+  string m_backend_name;
+  // The device the cluster was placed on by the encapsulation pass, empty
+  // for the device of the backend
+  string m_placed_device;
+  // The outputs only read by other clusters, which are shared with them on
+  // the GPU
+  std::vector<bool> m_shared_outputs;
+  // Signatures being compiled, in the background or by a step, and the
+  // number of scheduled compilations which have not finished yet. Both are
+  // guarded by m_exec_cache_lock_, m_compile_done_cv is notified when a
+  // compilation is done.
+  std::unordered_set<CompilationKey, CompilationKey::Hasher> m_compiling;
+  int m_pending_compiles = 0;
+  std::condition_variable m_compile_done_cv;
+  // The graph of the cluster shared by its kernels, and that graph
+  std::shared_ptr<const ClusterGraph> m_cluster_graph;
+  const Graph* m_graph = nullptr;
+  // The fingerprint of m_graph naming its blobs in the AOT bundle, computed
+  // on first use
+  std::once_flag m_graph_fingerprint_once;
+  uint64 m_graph_fingerprint = 0;
   int m_cluster_id;
-  int m_function_cache_depth_in_items = 16;
+  // Set once the cluster falls back as a whole, read on every step
+  const std::atomic<bool>* m_cluster_fallback = nullptr;
+  // The token the executables and failed signatures of this kernel are
+  // cached under, see NGraphClusterManager::NewCacheOwner
+  size_t m_cache_owner = 0;
   string m_name;
+  ClusterMetrics* m_metrics = nullptr;
   std::vector<bool> m_input_is_static;
-  std::list<std::string> m_lru;
-  std::unordered_map<std::string, std::shared_ptr<Executable>> m_ng_exec_map;
-  ngraph::ResultVector ng_result_list;
+  // Which of the static inputs are translated as constants, and which are
+  // read at run time because their value keeps changing
+  std::unique_ptr<StaticInputTracker> m_static_inputs;
+  // The inputs read from resource variables, and whether the executables
+  // convert them to constants (OPENVINO_TF_CONVERT_VARIABLES_TO_CONSTANTS)
+  std::vector<bool> m_input_is_variable;
+  bool m_has_variables = false;
+  bool m_variables_as_constants = false;
+  // Upload the variables to host tensors of the shared GPU context
+  bool m_upload_variables = false;
+  // Compute the outputs in the buffers of the dead inputs they may be
+  // forwarded from, see Builder::GetForwardableInputs
+  bool m_forward_inputs = true;
+  // The KV-caches held in the variables of the executables, with
+  // OPENVINO_TF_KV_CACHE, and the index in m_kv_cache of every input, -1
+  // for those which are not KV-caches. The steps of such a cluster hold
+  // m_kv_cache_lock_, one at a time.
+  std::vector<KVCacheInput> m_kv_cache;
+  std::vector<int> m_kv_cache_index;
+  std::mutex m_kv_cache_lock_;
+  // The cluster graph as a function, and its handle in m_fallback_flr.
+  // Guarded by m_fallback_lock_.
+  std::unique_ptr<FunctionLibraryDefinition> m_fallback_flib;
+  FunctionLibraryRuntime* m_fallback_flr = nullptr;
+  FunctionLibraryRuntime::Handle m_fallback_handle =
+      FunctionLibraryRuntime::kInvalidHandle;
+  bool m_fallback_function_failed = false;
   std::shared_ptr<tensorflow::Session> m_session;
   std::vector<std::string> m_session_input_names;
   std::vector<std::string> m_session_output_names;
 };
 
-NGraphEncapsulateOp::NGraphEncapsulateOp(OpKernelConstruction* ctx)
-    : OpKernel(ctx), m_graph(OpRegistry::Global()) {
-  OVTF_VLOG(1) << "Create Executor " << name();
-  m_name = name();
-
-  OP_REQUIRES_OK(ctx, ctx->GetAttr<int>("ovtf_cluster", &m_cluster_id));
-  std::ostringstream oss;
-  oss << "Encapsulate_" << m_cluster_id << ": " << name();
-
-  OVTF_VLOG(1) << "NGraphEncapsulateOp: " << m_cluster_id
-               << " Name: " << name();
-
-  GraphDef* graph_def = NGraphClusterManager::GetClusterGraph(m_cluster_id);
+// The graph of the cluster, parsed from the cluster manager or from the
+// function library unless another kernel of the cluster already did
+static Status GetClusterGraph(OpKernelConstruction* ctx, int cluster_id,
+                              std::shared_ptr<const ClusterGraph>& result) {
+  GraphDef* graph_def = NGraphClusterManager::GetClusterGraph(cluster_id);
+  const FunctionDef* fdef = nullptr;
+  string key;
   if (graph_def == nullptr) {
-    string flib_key = "ovtf_cluster_" + to_string(m_cluster_id);
+    string flib_key = "ovtf_cluster_" + to_string(cluster_id);
     // Read graphdef from function library
-    const FunctionLibraryDefinition flib =
+    if (ctx->function_library() != nullptr) {
+      fdef = ctx->function_library()->GetFunctionLibraryDefinition()->Find(
+          flib_key);
+    }
+    if (fdef == nullptr) {
+      return errors::Internal("Did not find graphdef for encapsulate ",
+                              flib_key,
+                              " in NGraphClusterManager or function library");
+    }
+    string serialized;
+    SerializeToStringDeterministic(*fdef, &serialized);
+    key = "function:" + to_string(Fingerprint64(serialized));
+  } else {
+    key = "cluster:" + to_string(NGraphClusterManager::Generation()) + ":" +
+          to_string(cluster_id);
+  }
+  result = NGraphClusterManager::GetParsedGraph(key);
+  if (result != nullptr) return Status::OK();
+
+  auto cluster_graph = std::make_shared<ClusterGraph>();
+  Graph& graph = cluster_graph->graph;
+  if (fdef != nullptr) {
+    const FunctionLibraryDefinition& flib =
         *ctx->function_library()->GetFunctionLibraryDefinition();
-    const FunctionDef* fdef = flib.Find(flib_key);
-    OP_REQUIRES(
-        ctx, fdef != nullptr,
-        errors::Internal("Did not find graphdef for encapsulate ", flib_key,
-                         " in NGraphClusterManager or function library"));
-    // TODO: how to convert from functiondef to graphdef. Anything easier?
     std::unique_ptr<FunctionBody> fnbody;
     const auto get_func_sig = [&flib](const string& op, const OpDef** sig) {
       return flib.LookUpOpDef(op, sig);
     };
-    Status status =
-        FunctionDefToBodyHelper(*fdef, {}, &flib, get_func_sig, &fnbody);
-    if (!status.ok()) {
-      OVTF_VLOG(2) << "FunctionDefToBodyHelper returned a not ok status.";
-    }
-    CopyGraph(*fnbody->graph, &m_graph);
+    TF_RETURN_IF_ERROR(
+        FunctionDefToBodyHelper(*fdef, {}, &flib, get_func_sig, &fnbody));
+    CopyGraph(*fnbody->graph, &graph);
+    TF_RETURN_IF_ERROR(
+        graph.AddFunctionLibrary(flib.ReachableDefinitions(*fdef).ToProto()));
   } else {
     GraphConstructorOptions opts;
     opts.allow_internal_ops = true;
-    OP_REQUIRES_OK(ctx, ConvertGraphDefToGraph(opts, *graph_def, &m_graph));
+    TF_RETURN_IF_ERROR(ConvertGraphDefToGraph(opts, *graph_def, &graph));
+    // The functions called by the functional control flow ops of the
+    // cluster, which are translated with them
+    if (ctx->function_library() != nullptr) {
+      const FunctionLibraryDefinition* flib =
+          ctx->function_library()->GetFunctionLibraryDefinition();
+      FunctionLibraryDefinition reachable =
+          flib->ReachableDefinitions(*graph_def);
+      TF_RETURN_IF_ERROR(graph.AddFunctionLibrary(reachable.ToProto()));
+    }
   }
 
   //
-  // Initialize the "m_input_is_static" vector as follows:
-  // (1) create m_input_is_static with n+1 elements, where n is the max arg
+  // Initialize the "input_is_static" vector as follows:
+  // (1) create input_is_static with n+1 elements, where n is the max arg
   //     index
-  // (2) for each _Arg node n, set m_input_is_static[n.index] to true if n
+  // (2) for each _Arg node n, set input_is_static[n.index] to true if n
   //     is driving any static input; else set it to false.
   //
 
@@ -124,26 +551,22 @@ NGraphEncapsulateOp::NGraphEncapsulateOp(OpKernelConstruction* ctx)
   int32 max_arg_index = -1;
   std::vector<const Node*> arg_nodes;
 
-  for (auto node : m_graph.nodes()) {
+  for (auto node : graph.nodes()) {
     if (node->type_string() == "_Arg") {
       arg_nodes.push_back(node);
 
       int32 index;
-      OP_REQUIRES_OK(ctx, GetNodeAttr(node->attrs(), "index", &index));
+      TF_RETURN_IF_ERROR(GetNodeAttr(node->attrs(), "index", &index));
       if (index > max_arg_index) max_arg_index = index;
     }
   }
 
   int size = max_arg_index + 1;
-  m_input_is_static.resize(size);
-
-  for (int i = 0; i < size; i++) {
-    m_input_is_static[i] = false;
-  }
+  cluster_graph->input_is_static.assign(size, false);
 
   for (auto node : arg_nodes) {
     int32 index;
-    OP_REQUIRES_OK(ctx, GetNodeAttr(node->attrs(), "index", &index));
+    TF_RETURN_IF_ERROR(GetNodeAttr(node->attrs(), "index", &index));
 
     bool is_static = false;
     for (auto edge : node->out_edges()) {
@@ -161,78 +584,589 @@ NGraphEncapsulateOp::NGraphEncapsulateOp(OpKernelConstruction* ctx)
       }
     }
     OVTF_VLOG(5) << "Marking arg " << index << " is_static: " << is_static;
-    m_input_is_static[index] = is_static;
+    cluster_graph->input_is_static[index] = is_static;
   }
+
+  cluster_graph->input_is_variable.assign(size, false);
+  for (auto node : arg_nodes) {
+    int32 index;
+    bool is_variable = false;
+    TF_RETURN_IF_ERROR(GetNodeAttr(node->attrs(), "index", &index));
+    if (TryGetNodeAttr(node->attrs(), "_is_variable", &is_variable) &&
+        is_variable) {
+      cluster_graph->input_is_variable[index] = true;
+      cluster_graph->has_variables = true;
+    }
+  }
+
+  result = NGraphClusterManager::SetParsedGraph(key, cluster_graph);
+  return Status::OK();
+}
+
+NGraphEncapsulateOp::NGraphEncapsulateOp(OpKernelConstruction* ctx)
+    : AsyncOpKernel(ctx) {
+  OVTF_VLOG(1) << "Create Executor " << name();
+  m_name = name();
+  m_async_execution = util::GetEnv("OPENVINO_TF_ASYNC_EXECUTION") == "1";
+  m_background_compilation =
+      util::GetEnv("OPENVINO_TF_BACKGROUND_COMPILATION") == "1";
+  m_dynamic_shapes = util::GetEnv("OPENVINO_TF_DYNAMIC_SHAPES") == "1";
+  m_reuse_translation = util::GetEnv("OPENVINO_TF_REUSE_TRANSLATION") != "0";
+  m_query_op_support = util::GetEnv("OPENVINO_TF_QUERY_OP_SUPPORT") != "0";
+  m_multi_req_execution = std::getenv("OPENVINO_TF_ENABLE_BATCHING") != nullptr;
+  if (m_multi_req_execution) {
+    OVTF_VLOG(2) << "Batching is enabled" << name();
+  }
+  m_shape_bucketing = ShapeBucketing::FromEnv();
+  string chunk_rows_env = util::GetEnv("OPENVINO_TF_BATCH_CHUNK_SIZE");
+  if (!chunk_rows_env.empty()) {
+    m_batch_chunk_rows = std::max<int64>(0, std::stoll(chunk_rows_env));
+  }
+  // The parameters of the graph's RewriterConfig override the api defaults
+  CompileProperties::Map compile_properties = CompileProperties::GetDefaults();
+  for (const auto& key : CompileProperties::Keys()) {
+    string value;
+    if (TryGetNodeAttr(ctx->def(), "_ovtf_" + key, &value) && !value.empty()) {
+      OP_REQUIRES_OK(ctx, CompileProperties::Validate(key, value));
+      compile_properties[key] = value;
+    }
+  }
+  m_compile_config = CompileProperties::ToConfig(compile_properties);
+  if (LayerProfile::Enabled()) {
+    m_compile_config[ov::enable_profiling.name()] = true;
+  }
+  // Running steps on TF is only possible with fallback enabled
+  m_auto_backend_selection =
+      util::GetEnv("OPENVINO_TF_AUTO_BACKEND_SELECTION") == "1" &&
+      NGraphClusterManager::IsClusterFallbackEnabled();
+  // A session configured with a backend of its own keeps it, whatever the
+  // backend set for the process
+  string session_backend;
+  if (TryGetNodeAttr(ctx->def(), "_ovtf_backend", &session_backend) &&
+      !session_backend.empty()) {
+    OP_REQUIRES_OK(ctx, BackendManager::GetBackend(session_backend, m_backend,
+                                                   m_backend_name));
+  } else {
+    OP_REQUIRES_OK(ctx, BackendManager::GetBackendName(m_backend_name));
+    m_backend = BackendManager::GetBackend();
+  }
+  TryGetNodeAttr(ctx->def(), "_ovtf_device", &m_placed_device);
+  const string& compile_device =
+      m_placed_device.empty() ? m_backend_name : m_placed_device;
+  auto tf_worker_threads = ctx->device()->tensorflow_cpu_worker_threads();
+  if (compile_device == "CPU" && tf_worker_threads != nullptr) {
+    CompileProperties::ApplyCpuThreading(
+        compile_properties, tf_worker_threads->num_threads, m_compile_config);
+  }
+  string warmup;
+  if (TryGetNodeAttr(ctx->def(), "_ovtf_warmup", &warmup)) {
+    m_warmup_compilation = warmup == "1";
+  }
+  // A pipeline stage releases the thread of its step while it runs, for the
+  // stages of the other steps in flight
+  string pipeline_stage;
+  if (TryGetNodeAttr(ctx->def(), "_ovtf_pipeline_stage", &pipeline_stage) &&
+      pipeline_stage == "1") {
+    m_async_execution = true;
+  }
+  std::vector<int32> shared_outputs;
+  if (TryGetNodeAttr(ctx->def(), "_ovtf_shared_outputs", &shared_outputs)) {
+    m_shared_outputs.assign(ctx->num_outputs(), false);
+    for (auto i : shared_outputs) {
+      if (i >= 0 && i < ctx->num_outputs()) m_shared_outputs[i] = true;
+    }
+  }
+  OP_REQUIRES_OK(ctx, ctx->GetAttr<int>("ovtf_cluster", &m_cluster_id));
+  m_cache_owner = NGraphClusterManager::NewCacheOwner(m_cluster_id);
+  m_cluster_fallback =
+      NGraphClusterManager::GetClusterFallbackFlag(m_cluster_id);
+  m_metrics = Metrics::GetClusterMetrics(m_cluster_id, m_name);
+  // A cluster which compiled for many input shapes in the earlier runs
+  GraphDef* cluster_graphdef = NGraphClusterManager::GetClusterGraph(
+      m_cluster_id);
+  if (!m_dynamic_shapes && cluster_graphdef != nullptr &&
+      util::GetEnv("OPENVINO_TF_DYNAMIC_SHAPES") != "0" &&
+      ClusterProfile::Loaded().Classify(ClusterProfile::ClusterNodes(
+          *cluster_graphdef)) == ClusterProfile::Verdict::kChurn) {
+    OVTF_VLOG(1) << "Compiling " << name()
+                 << " with dynamic shapes, it churned in the profile";
+    m_dynamic_shapes = true;
+  }
+  if (m_dynamic_shapes) {
+    string device = m_placed_device.empty() ? m_backend_name : m_placed_device;
+    // The VPU plugins only compile models with static shapes
+    if (device == "MYRIAD" || device == "HDDL") {
+      OVTF_VLOG(1) << "Dynamic shapes are not supported on " << device;
+      m_dynamic_shapes = false;
+    }
+  }
+
+  OVTF_VLOG(1) << "NGraphEncapsulateOp: " << m_cluster_id
+               << " Name: " << name();
+
+  OP_REQUIRES_OK(ctx, GetClusterGraph(ctx, m_cluster_id, m_cluster_graph));
+  m_graph = &m_cluster_graph->graph;
+  m_input_is_static = m_cluster_graph->input_is_static;
+  m_input_is_variable = m_cluster_graph->input_is_variable;
+  m_has_variables = m_cluster_graph->has_variables;
+  m_static_inputs.reset(new StaticInputTracker(
+      m_input_is_static, StaticInputTracker::LimitFromEnv()));
+  auto tiering_options = CompileTiering::Options::FromEnv();
+  if (tiering_options.Enabled()) {
+    m_tiering.reset(new CompileTiering(tiering_options));
+  }
+  m_variables_as_constants =
+      util::GetEnv("OPENVINO_TF_CONVERT_VARIABLES_TO_CONSTANTS") == "1";
+  m_upload_variables = util::GetEnv("OPENVINO_TF_GPU_SHARED_TENSORS") == "1";
+  m_forward_inputs = util::GetEnv("OPENVINO_TF_FORWARD_INPUTS") != "0";
+  if (util::GetEnv("OPENVINO_TF_KV_CACHE") == "1") {
+    // The CPU plugin is the only one running stateful models
+    if (compile_device.compare(0, 3, "CPU") == 0) {
+      m_kv_cache_index.assign(m_input_is_static.size(), -1);
+      for (const auto& cache : FindKVCacheInputs(*m_graph)) {
+        if (cache.input >= m_input_is_static.size() ||
+            m_input_is_static[cache.input]) {
+          continue;
+        }
+        m_kv_cache_index[cache.input] = m_kv_cache.size();
+        m_kv_cache.push_back(cache);
+      }
+    } else {
+      OVTF_VLOG(1) << "The KV-caches of " << name()
+                   << " are not held in variables on " << compile_device;
+    }
+  }
+  if (!m_kv_cache.empty()) {
+    // Every step reads the variables the previous one assigned, in full
+    OVTF_VLOG(1) << "Holding " << m_kv_cache.size() << " KV-caches of "
+                 << name() << " in variables";
+    m_async_execution = false;
+    m_shape_bucketing = ShapeBucketing();
+    m_batch_chunk_rows = 0;
+    m_reuse_translation = false;
+  }
+  ShareExecutables(ctx);
+}
+
+void NGraphEncapsulateOp::ShareExecutables(OpKernelConstruction* ctx) {
+  uint64 fingerprint = 0;
+  // The variables of the executables are those of the session
+  if (!m_has_variables && m_kv_cache.empty() &&
+      util::GetEnv("OPENVINO_TF_SHARE_IDENTICAL_CLUSTERS") != "0") {
+    // The attributes of the encapsulate op which the compilation depends on
+    std::map<string, string> attrs;
+    for (const auto& attr : ctx->def().attr()) {
+      if (attr.first == "ovtf_cluster" || attr.first == "ngraph_graph_id") {
+        continue;
+      }
+      attrs[attr.first] = attr.second.SerializeAsString();
+    }
+    std::stringstream context;
+    context << ctx->device_type().type_string() << ";" << m_backend_name
+            << ";" << m_placed_device;
+    for (const auto& attr : attrs) {
+      context << ";" << attr.first << "=" << attr.second;
+    }
+    // The compile properties, as in AOTBundle::EntryName, and the shapes
+    // the executables are compiled for
+    for (const auto& property : m_compile_config) {
+      context << ";" << property.first << "=";
+      try {
+        context << property.second.as<string>();
+      } catch (const std::exception&) {
+        // Properties which can not be printed only have their key taken in
+      }
+    }
+    context << ";dynamic_shapes=" << m_dynamic_shapes
+            << ";bucketing=" << m_shape_bucketing.DebugString();
+    GraphDef graph_def;
+    m_graph->ToGraphDef(&graph_def);
+    fingerprint =
+        NGraphClusterManager::CanonicalFingerprint(graph_def, context.str());
+  }
+  NGraphClusterManager::SetClusterFingerprint(m_cache_owner, fingerprint);
 }
 
 NGraphEncapsulateOp::~NGraphEncapsulateOp() {
-  std::ostringstream oss;
-  oss << "Destroy Encapsulate_" << m_cluster_id << ": " << name();
   OVTF_VLOG(2) << "~NGraphEncapsulateOp::" << name();
+  {
+    // Background compilations reference this kernel
+    std::unique_lock<std::mutex> lock(m_exec_cache_lock_);
+    m_compile_done_cv.wait(lock, [this] { return m_pending_compiles == 0; });
+  }
   NGraphClusterManager::SetMRUExecutable(m_cluster_id, nullptr);
-  m_ng_exec_map.clear();
+  NGraphClusterManager::ReleaseCacheOwner(m_cache_owner);
 }
 
 void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
   OVTF_VLOG(1) << "Compute using executor " << name();
-  std::ostringstream oss;
-  oss << "Execute: Encapsulate_" << m_cluster_id << ": " << name();
   OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute starting for cluster "
                << m_cluster_id;
 
-  if (NGraphClusterManager::CheckClusterFallback(m_cluster_id)) {
-    OP_REQUIRES_OK(ctx, Fallback(ctx));
+  if (NGraphClusterManager::CheckClusterFallback(m_cluster_fallback)) {
+    OP_REQUIRES_OK(ctx, RunOnTF(ctx, TFStep::kFallback));
     return;
   }
 
-  Timer compute_time;
-  std::lock_guard<std::mutex> lock(m_compute_lock_);
-  int time_func_create_or_lookup;
-  Timer function_lookup_or_create;
+  std::unique_lock<std::mutex> kv_cache_lock(m_kv_cache_lock_,
+                                             std::defer_lock);
+  if (!m_kv_cache.empty()) kv_cache_lock.lock();
+
+  ComputeState state;
+  state.cancellation = StepCancellation::Create(ctx->cancellation_manager());
+  StepCancellation::Scope cancellation_scope(state.cancellation);
+  // The cancellation manager of the step may be destroyed once it is done,
+  // while a background compilation still holds the cancellation
+  auto release_cancellation =
+      gtl::MakeCleanup([&state]() { state.cancellation->Release(); });
+  bool fallback = false;
+  OP_REQUIRES_OK(ctx, PrepareCompute(ctx, state, fallback));
+  if (fallback) {
+    OP_REQUIRES_OK(ctx, RunStepOnTF(ctx, state));
+    return;
+  }
+  if (state.outputs_set) return;
 
-  bool multi_req_execution = false;
-  if (std::getenv("OPENVINO_TF_ENABLE_BATCHING")) {
-    OVTF_VLOG(2) << "Batching is enabled" << name();
-    multi_req_execution = true;
+  // Execute the nGraph function.
+  OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute call starting for cluster "
+               << m_cluster_id;
+  state.execute_function.Reset();
+  try {
+    profiler::TraceMe trace([this] {
+      return profiler::TraceMeEncode("OVTF::Execute", {{"cluster", name()}});
+    });
+    if (state.chunk_rows > 0) {
+      state.ng_exec->CallChunked(state.ng_inputs, state.batched_inputs,
+                                 state.chunk_rows, state.ng_func_outputs);
+    } else {
+      state.ng_exec->Call(state.ng_inputs, state.ng_func_outputs,
+                          state.multi_req_execution);
+    }
+  } catch (...) {
+    OP_REQUIRES_OK(ctx,
+                   HandleCallError(ctx, state, std::current_exception()));
+    return;
+  }
+
+  OP_REQUIRES_OK(ctx, FinishCompute(ctx, state));
+}  // end compute
+
+void NGraphEncapsulateOp::ComputeAsync(OpKernelContext* ctx,
+                                       DoneCallback done) {
+  if (!m_async_execution) {
+    Compute(ctx);
+    done();
+    return;
+  }
+
+  OVTF_VLOG(1) << "ComputeAsync using executor " << name();
+  if (NGraphClusterManager::CheckClusterFallback(m_cluster_fallback)) {
+    OP_REQUIRES_OK_ASYNC(ctx, RunOnTF(ctx, TFStep::kFallback), done);
+    done();
+    return;
+  }
+
+  auto state = std::make_shared<ComputeState>();
+  state->cancellation = StepCancellation::Create(ctx->cancellation_manager());
+  StepCancellation::Scope cancellation_scope(state->cancellation);
+  // The cancellation manager of the step may be destroyed once it is done
+  done = [cancellation = state->cancellation, done]() {
+    cancellation->Release();
+    done();
+  };
+  bool fallback = false;
+  OP_REQUIRES_OK_ASYNC(ctx, PrepareCompute(ctx, *state, fallback), done);
+  if (fallback) {
+    OP_REQUIRES_OK_ASYNC(ctx, RunStepOnTF(ctx, *state), done);
+    done();
+    return;
+  }
+  if (state->outputs_set) {
+    done();
+    return;
   }
 
+  // A chunked call waits for its chunks on the TF thread
+  if (state->chunk_rows > 0) {
+    state->execute_function.Reset();
+    try {
+      profiler::TraceMe trace([this] {
+        return profiler::TraceMeEncode("OVTF::Execute", {{"cluster", name()}});
+      });
+      state->ng_exec->CallChunked(state->ng_inputs, state->batched_inputs,
+                                  state->chunk_rows, state->ng_func_outputs);
+    } catch (...) {
+      OP_REQUIRES_OK_ASYNC(
+          ctx, HandleCallError(ctx, *state, std::current_exception()), done);
+      done();
+      return;
+    }
+    OP_REQUIRES_OK_ASYNC(ctx, FinishCompute(ctx, *state), done);
+    done();
+    return;
+  }
+
+  // The TF thread is released here, the outputs are filled and done is
+  // called from the completion callback of the infer request
+  OVTF_VLOG(4) << "NGraphEncapsulateOp::ComputeAsync call starting for cluster "
+               << m_cluster_id;
+  state->execute_function.Reset();
+  state->execute_activity = profiler::TraceMe::ActivityStart([this] {
+    return profiler::TraceMeEncode("OVTF::Execute", {{"cluster", name()}});
+  });
+  state->ng_exec->CallAsync(
+      state->ng_inputs, state->ng_func_outputs,
+      [this, ctx, state, done](std::exception_ptr ex,
+                               std::vector<shared_ptr<ov::Tensor>>& outputs) {
+        profiler::TraceMe::ActivityEnd(state->execute_activity);
+        if (ex != nullptr) {
+          OP_REQUIRES_OK_ASYNC(ctx, HandleCallError(ctx, *state, ex), done);
+          done();
+          return;
+        }
+        state->ng_func_outputs = outputs;
+        OP_REQUIRES_OK_ASYNC(ctx, FinishCompute(ctx, *state), done);
+        done();
+      },
+      state->multi_req_execution);
+}
+
+Status NGraphEncapsulateOp::HandleCallError(OpKernelContext* ctx,
+                                            ComputeState& state,
+                                            std::exception_ptr ex) {
+  // The inference of a cancelled step was cancelled, or failed because of
+  // it, running the step on TF would be wasted too
+  if (ctx->cancellation_manager() != nullptr &&
+      ctx->cancellation_manager()->IsCancelled()) {
+    return errors::Cancelled("The step of cluster ", m_cluster_id,
+                             " was cancelled");
+  }
+  string status_string =
+      "Caught exception while executing cluster " + to_string(m_cluster_id);
+  try {
+    std::rethrow_exception(ex);
+  } catch (const std::exception& exp) {
+    status_string += ": " + string(exp.what());
+  } catch (...) {
+  }
+  if (NGraphClusterManager::IsClusterFallbackEnabled()) {
+    OVTF_VLOG(4) << status_string;
+    if (!state.inputs_forwarded) return Fallback(ctx, state);
+    // The inference may have written over the inputs TF would run the
+    // step on, only the next steps fall back
+    RecordFallback(state);
+  }
+  return errors::Internal(status_string);
+}
+
+// Whether every output of the executable of a chunk holds chunk_rows rows,
+// as the outputs of a cluster whose batch rows are independent do
+static bool RunsInChunks(const Executable& ng_exec, int64 chunk_rows) {
+  if (ng_exec.IsTrivial() || ng_exec.GetDevice() == "HDDL") return false;
+  for (const auto& shape : ng_exec.GetOutputShapes()) {
+    if (shape.empty() || shape[0] != chunk_rows ||
+        ov::shape_size(shape) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool NGraphEncapsulateOp::SplitBatch(
+    const std::vector<Tensor>& tf_input_tensors, ComputeState& state,
+    std::vector<Tensor>& chunk_tensors) {
+  if (m_batch_chunk_rows <= 0 || state.padding.IsPadded()) return false;
+  // The batch is dimension 0 of the inputs which are neither static nor
+  // variables, which must all agree on it
+  int64 batch = -1;
+  std::vector<bool> batched(tf_input_tensors.size(), false);
+  for (int i = 0; i < tf_input_tensors.size(); i++) {
+    const Tensor& tensor = tf_input_tensors[i];
+    if (tensor.dims() > 0 && tensor.NumElements() == 0) return false;
+    if ((i < m_input_is_static.size() && m_input_is_static[i]) ||
+        (i < m_input_is_variable.size() && m_input_is_variable[i])) {
+      continue;
+    }
+    if (tensor.dims() == 0 || !DataTypeCanUseMemcpy(tensor.dtype()) ||
+        (batch >= 0 && tensor.dim_size(0) != batch)) {
+      return false;
+    }
+    batch = tensor.dim_size(0);
+    batched[i] = true;
+  }
+  if (batch <= m_batch_chunk_rows) return false;
+
+  chunk_tensors = tf_input_tensors;
+  for (int i = 0; i < tf_input_tensors.size(); i++) {
+    if (batched[i]) {
+      chunk_tensors[i] = tf_input_tensors[i].Slice(0, m_batch_chunk_rows);
+    }
+  }
+  state.batch = batch;
+  state.chunk_rows = m_batch_chunk_rows;
+  state.batched_inputs = std::move(batched);
+  OVTF_VLOG(2) << "Running the batch of " << batch << " rows of " << name()
+               << " in chunks of " << state.chunk_rows;
+  return true;
+}
+
+Status NGraphEncapsulateOp::PrepareCompute(OpKernelContext* ctx,
+                                           ComputeState& state,
+                                           bool& fallback) {
+  Timer function_lookup_or_create;
+  profiler::TraceMe lookup_trace([this] {
+    return profiler::TraceMeEncode("OVTF::Lookup", {{"cluster", name()}});
+  });
+
+  state.multi_req_execution = m_multi_req_execution;
+  TF_RETURN_IF_ERROR(state.cancellation->Check());
+
   // TF input tensor
   std::vector<Tensor> tf_input_tensors;
-  std::shared_ptr<Executable> ng_exec;
-  int step_id;
+  std::shared_ptr<Executable>& ng_exec = state.ng_exec;
   {
     for (int i = 0; i < ctx->num_inputs(); i++) {
       tf_input_tensors.push_back(ctx->input(i));
     }
+    if (!m_padding_disabled) {
+      state.padding = m_shape_bucketing.PadInputs(
+          tf_input_tensors, m_input_is_static, m_input_is_variable);
+    }
+    if (state.padding.IsPadded()) {
+      // The engine reads the padded inputs until the call is done
+      state.padded_inputs = tf_input_tensors;
+      state.padded_outputs.resize(ctx->num_outputs());
+    }
 
-    step_id = ctx->step_id();
+    state.step_id = ctx->step_id();
 
     // Get ngraph executable and inputs information
-    Status getex_status = GetExecutable(tf_input_tensors, ng_exec);
-    NGraphClusterManager::SetMRUExecutable(m_cluster_id, ng_exec);
+    Status getex_status;
+    {
+      std::unique_lock<std::mutex> lock(m_exec_cache_lock_);
+      auto lookup = [this, &state, &ng_exec,
+                     &lock](const std::vector<Tensor>& inputs) {
+        // Running the step on TF is only possible with fallback enabled
+        if ((m_background_compilation || m_warmup_compilation ||
+             NGraphClusterManager::IsWarmingUp()) &&
+            NGraphClusterManager::IsClusterFallbackEnabled()) {
+          return GetExecutableOrCompileInBackground(
+              inputs, ng_exec, state.compile_pending, &state.cold_signature,
+              &state.lookup);
+        }
+        // The cold signatures run on TF, which needs the fallback
+        return GetExecutable(inputs, lock, ng_exec,
+                             NGraphClusterManager::IsClusterFallbackEnabled()
+                                 ? &state.cold_signature
+                                 : nullptr,
+                             &state.lookup);
+      };
+      // An oversized batch runs in chunks through the executable compiled
+      // for a chunk
+      std::vector<Tensor> chunk_tensors;
+      if (SplitBatch(tf_input_tensors, state, chunk_tensors)) {
+        getex_status = lookup(chunk_tensors);
+        if (ng_exec != nullptr && !RunsInChunks(*ng_exec, state.chunk_rows)) {
+          OVTF_VLOG(1) << "Running " << name() << " unchunked, its outputs "
+                       << "do not follow the batch of its inputs";
+          m_batch_chunk_rows = 0;
+          state.chunk_rows = 0;
+          ng_exec = nullptr;
+          getex_status = lookup(tf_input_tensors);
+        }
+      } else {
+        getex_status = lookup(tf_input_tensors);
+        if (ng_exec != nullptr &&
+            !state.padding.CanUnpad(ng_exec->GetPaddedOutputDims())) {
+          OVTF_VLOG(1) << "Running " << name() << " unpadded, its outputs "
+                       << "do not follow the padded inputs";
+          m_padding_disabled = true;
+          state.padding = ShapeBucketing::Padding();
+          state.padded_inputs.clear();
+          state.padded_outputs.clear();
+          for (int i = 0; i < ctx->num_inputs(); i++) {
+            tf_input_tensors[i] = ctx->input(i);
+          }
+          ng_exec = nullptr;
+          getex_status = lookup(tf_input_tensors);
+        }
+      }
+      state.cold = getex_status.ok() && ng_exec == nullptr &&
+                   !state.compile_pending && !state.lookup.fell_back;
+      if (ng_exec != nullptr) {
+        NGraphClusterManager::SetMRUExecutable(m_cluster_id, ng_exec);
+        if (ng_exec->IsTrivial() && !ng_exec->HasConstantOutputs()) {
+          Executable& exec = *ng_exec;
+          getex_status = exec.BuildConstantOutputs(
+              [this, ctx, &exec](std::vector<Tensor>& constant_outputs) {
+                return BuildConstantOutputs(ctx, exec, constant_outputs);
+              });
+        }
+      }
+    }
+    // A compilation was skipped or its result is not wanted anymore
+    if (errors::IsCancelled(getex_status)) return getex_status;
+    TF_RETURN_IF_ERROR(state.cancellation->Check());
+    if (getex_status.ok() && state.lookup.fell_back) {
+      OVTF_VLOG(2) << "Running " << name() << " on TF, its signature failed";
+      fallback = true;
+      return Status::OK();
+    }
+    if (state.cold) {
+      OVTF_VLOG(2) << "Running " << name() << " on TF, its signature is cold";
+      fallback = true;
+      return Status::OK();
+    }
+    if (state.compile_pending && getex_status.ok()) {
+      OVTF_VLOG(2) << "Running " << name()
+                   << " on TF while its executable is compiled";
+      fallback = true;
+      return Status::OK();
+    }
     if (getex_status != Status::OK()) {
       if (NGraphClusterManager::IsClusterFallbackEnabled()) {
-        OP_REQUIRES_OK(ctx, Fallback(ctx));
-        return;
+        fallback = true;
+        return Status::OK();
       } else {
-        OP_REQUIRES_OK(ctx, getex_status);
+        return getex_status;
       }
     }
 
-    OVTF_VLOG(1) << " Step_ID: " << step_id;
+    if (ng_exec->IsTrivial() && !state.padding.IsPadded()) {
+      TF_RETURN_IF_ERROR(SetTrivialOutputs(ctx, state));
+      if (state.outputs_set) return Status::OK();
+    }
+
+    BackendSelector* selector = ng_exec->GetBackendSelector();
+    if (selector != nullptr &&
+        selector->Next(state.timed_step) == BackendSelector::Path::kTF) {
+      state.tf_selected = true;
+      fallback = true;
+      return Status::OK();
+    }
+
+    KVCacheState* kv_cache = ng_exec->GetKVCacheState();
+    if (kv_cache != nullptr) {
+      TF_RETURN_IF_ERROR(SetKVCaches(tf_input_tensors, *ng_exec, *kv_cache));
+    }
+
+    OVTF_VLOG(1) << " Step_ID: " << state.step_id;
     OVTF_VLOG(4)
         << "NGraphEncapsulateOp::Compute got ngraph executable for cluster "
         << m_cluster_id;
 
-    time_func_create_or_lookup = function_lookup_or_create.ElapsedInMS();
+    state.time_func_create_or_lookup = function_lookup_or_create.ElapsedInMS();
   }
+  lookup_trace.Stop();
 
   OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute got graph for cluster "
                << m_cluster_id;
 
   Timer create_or_lookup_tensors;
-  vector<shared_ptr<ov::Tensor>> ng_inputs;
-  int ng_input_tensor_size_in_bytes = 0;
+  profiler::TraceMe setup_trace([this] {
+    return profiler::TraceMeEncode("OVTF::TensorSetup", {{"cluster", name()}});
+  });
+  vector<shared_ptr<ov::Tensor>>& ng_inputs = state.ng_inputs;
   {
     // Allocate tensors for input arguments.
     for (int i = 0; i < tf_input_tensors.size(); i++) {
@@ -240,6 +1174,17 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
       for (int j = 0; j < tf_input_tensors[i].shape().dims(); ++j) {
         ng_shape[j] = tf_input_tensors[i].shape().dim_size(j);
       }
+      // The past of a KV-cache is read from its variable, its input is only
+      // bound empty
+      if (ng_exec->GetKVCacheState() != nullptr &&
+          m_kv_cache_index[i] >= 0) {
+        ov::element::Type type;
+        TF_RETURN_IF_ERROR(util::TFDataTypeToNGraphElementType(
+            tf_input_tensors[i].dtype(), &type));
+        ng_shape[m_kv_cache[m_kv_cache_index[i]].Axis(ng_shape.size())] = 0;
+        ng_inputs.push_back(make_shared<IETensor>(type, ng_shape));
+        continue;
+      }
       auto check_ng_shape = [ng_shape]() {
         if (ng_shape.size() > 0) {
           for (auto dim : ng_shape) {
@@ -250,17 +1195,55 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
       };
       if (check_ng_shape()) continue;
       ov::element::Type ng_element_type;
-      OP_REQUIRES_OK(ctx, util::TFDataTypeToNGraphElementType(
-                              tf_input_tensors[i].dtype(), &ng_element_type));
+      TF_RETURN_IF_ERROR(util::TFDataTypeToNGraphElementType(
+          tf_input_tensors[i].dtype(), &ng_element_type));
+
+      // A variable keeps its tensor, and its binding, until it is written
+      if (m_input_is_variable[i] && !ng_exec->HasConstantVariables() &&
+          !state.padding.IsPadded()) {
+        ov::RemoteContext* context = nullptr;
+        if (m_upload_variables && ng_exec->GetDevice() == "GPU" &&
+            !ng_exec->IsReplicated()) {
+          context = Backend::GetGPUContext().get();
+        }
+        state.variable_inputs.emplace_back();
+        ng_inputs.push_back(ng_exec->GetVariableState().GetTensor(
+            i, tf_input_tensors[i], ng_element_type, ng_shape, context,
+            state.variable_inputs.back()));
+        continue;
+      }
 
-      auto backend = BackendManager::GetBackend();
 #if TF_VERSION < 2
       std::shared_ptr<ov::Tensor> ng_tensor =
           make_shared<IETensor>(ng_element_type, ng_shape,
                                 (void*)DMAHelper::base(&tf_input_tensors[i]));
 #else
-      std::shared_ptr<ov::Tensor> ng_tensor = make_shared<IETensor>(
-          ng_element_type, ng_shape, tf_input_tensors[i].data());
+      // An output of another cluster handed over in OpenVINO memory, e.g. a
+      // host tensor of the shared GPU context, is bound as it is
+      std::shared_ptr<ov::Tensor> ng_tensor;
+      auto ie_buffer = dynamic_cast<IETensorBuffer*>(
+          DMAHelper::buffer(&tf_input_tensors[i]));
+      if (ie_buffer != nullptr &&
+          ie_buffer->tensor()->data() == tf_input_tensors[i].data() &&
+          ie_buffer->tensor()->get_shape() == ng_shape &&
+          ie_buffer->tensor()->get_element_type() == ng_element_type) {
+        ng_tensor = ie_buffer->tensor();
+      } else {
+        auto ie_tensor = make_shared<IETensor>(ng_element_type, ng_shape,
+                                               tf_input_tensors[i].data());
+        // A feed allocated in USM host memory is read by the GPU of the
+        // shared context directly
+        USMHostAllocator* usm_allocator =
+            ng_exec->GetDevice() == "GPU" && !ng_exec->IsReplicated()
+                ? USMHostAllocator::Get()
+                : nullptr;
+        if (usm_allocator != nullptr) {
+          ov::Tensor usm_tensor = usm_allocator->WrapTensor(
+              tf_input_tensors[i].data(), ng_element_type, ng_shape);
+          if (usm_tensor) ie_tensor->set_device_tensor(usm_tensor);
+        }
+        ng_tensor = ie_tensor;
+      }
 #endif
       ng_inputs.push_back(ng_tensor);
     }
@@ -272,67 +1255,93 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
 
   // Allocate tensors for the output results.
 
-  auto results = ng_exec->GetResults();
-  std::string device;
-  Status exec_status = BackendManager::GetBackendName(device);
-  if (exec_status != Status::OK()) {
-    throw runtime_error(exec_status.error_message());
-  }
-  auto backend = BackendManager::GetBackend();
-  auto dev_type = backend->GetDeviceType();
-  std::string precision = dev_type.substr(dev_type.find("_") + 1);
-  std::vector<shared_ptr<ov::Tensor>> ng_func_outputs(results.size(), nullptr);
+  // The copies of the inputs are released, TF only forwards an input to an
+  // output when the step holds the last reference to its buffer
+  tf_input_tensors.clear();
+  const ov::ResultVector& results = ng_exec->GetResults();
+  const ov::ResultVector& ng_result_list = ng_exec->GetTranslatedResults();
+  // The device is the one the executable was compiled for, which saves
+  // locking the backend manager on every step
+  state.device = ng_exec->GetDevice();
+  const std::string& device = state.device;
+  const std::string& dev_type = ng_exec->GetDeviceType();
+  // Only GPU_FP16 converts the model, and its outputs, to fp16
+  const bool fp16_precision = Backend::IsGPUFP16(dev_type);
+  std::vector<shared_ptr<ov::Tensor>>& ng_func_outputs = state.ng_func_outputs;
+  ng_func_outputs.assign(results.size(), nullptr);
   std::vector<shared_ptr<ov::Tensor>> ng_outputs(ng_result_list.size(),
                                                  nullptr);
-  std::vector<int> dyn_shape_tensors;
-  std::vector<int> output_mappings(ng_result_list.size(), -1);
-  auto ng_output_shapes = ng_exec->GetOutputShapes();
+  std::vector<int>& dyn_shape_tensors = state.dyn_shape_tensors;
+  std::vector<int>& output_mappings = state.output_mappings;
+  output_mappings.assign(ng_result_list.size(), -1);
+  const auto& ng_output_shapes = ng_exec->GetOutputShapes();
   int j = 0;
   if (device != "HDDL") {
     for (auto i = 0; i < ng_result_list.size(); i++) {
       auto ng_element = ng_result_list[i];
       if (ng_element->get_output_partial_shape(0).is_dynamic()) {
-        OVTF_VLOG(4)
-            << "NGraphEncapsulateOp::Compute skipping output allocation for "
-               "dynamic tensor at index"
-            << i;
         dyn_shape_tensors.push_back(i);
         output_mappings[i] = j;
+        // A bounded output is allocated to its bound, the device writes
+        // into it and shrinks it to the shape it computed, and the TF output
+        // wraps it. The others are allocated by the engine.
+        const ov::Shape& bound = ng_exec->GetOutputBound(i);
+        if (!bound.empty() && !state.padding.IsPadded()) {
+          ng_func_outputs[j] =
+              make_shared<IETensor>(ng_element->get_element_type(), bound,
+                                    BufferPool::GetAllocator(device));
+        } else {
+          OVTF_VLOG(4)
+              << "NGraphEncapsulateOp::Compute skipping output allocation for "
+                 "dynamic tensor at index"
+              << i;
+        }
         j++;
         continue;
       }
 
-      // Create the TF output tensor
+      // Create the TF output tensor, of the whole batch for a chunked call
       auto ng_shape = ng_output_shapes[i];
+      if (state.chunk_rows > 0) ng_shape[0] = state.batch;
       TensorShape tf_shape;
       for (auto dim : ng_shape) {
         tf_shape.AddDim(dim);
       }
-      Tensor* output_tensor = nullptr;
-      OP_REQUIRES_OK(ctx, ctx->allocate_output(i, tf_shape, &output_tensor));
-
       // Make sure the nGraph-inferred element type agrees with what TensorFlow
       // expected
       ov::element::Type expected_elem_type;
       auto ng_element_type = ng_element->get_element_type();
-      if (ng_element_type == ov::element::Type_t::f16 && precision == "FP16")
+      if (ng_element_type == ov::element::Type_t::f16 && fp16_precision)
         ng_element_type = ov::element::Type_t::f32;
-      OP_REQUIRES_OK(ctx,
-                     util::TFDataTypeToNGraphElementType(
-                         ctx->expected_output_dtype(i), &expected_elem_type));
-      OP_REQUIRES(
-          ctx, ng_element_type == expected_elem_type,
-          errors::Internal("Element type inferred by nGraph does not match "
-                           "the element type expected by TensorFlow"));
+      TF_RETURN_IF_ERROR(util::TFDataTypeToNGraphElementType(
+          ctx->expected_output_dtype(i), &expected_elem_type));
+      if (ng_element_type != expected_elem_type) {
+        return errors::Internal(
+            "Element type inferred by nGraph does not match "
+            "the element type expected by TensorFlow");
+      }
 
+      std::shared_ptr<IETensor> shared_output;
+      if (device == "GPU" && i < m_shared_outputs.size() &&
+          m_shared_outputs[i] && !state.padding.IsPadded() &&
+          ov::shape_size(ng_shape) > 0) {
+        TF_RETURN_IF_ERROR(AllocateSharedOutput(ctx, i, ng_element_type,
+                                                ng_shape, shared_output));
+      }
+      if (shared_output != nullptr) {
+        ng_outputs[i] = shared_output;
+      } else {
+        Tensor* output_tensor = nullptr;
+        TF_RETURN_IF_ERROR(
+            AllocateOutput(ctx, state, i, tf_shape, &output_tensor));
 #if TF_VERSION < 2
-      ng_outputs[i] = make_shared<IETensor>(
-          ng_element_type, ng_shape, (void*)DMAHelper::base(output_tensor));
-
+        ng_outputs[i] = make_shared<IETensor>(
+            ng_element_type, ng_shape, (void*)DMAHelper::base(output_tensor));
 #else
-      ng_outputs[i] = make_shared<IETensor>(ng_element_type, ng_shape,
-                                            output_tensor->data());
+        ng_outputs[i] = make_shared<IETensor>(ng_element_type, ng_shape,
+                                              output_tensor->data());
 #endif
+      }
 
       auto check_ng_shape = [ng_shape]() {
         if (ng_shape.size() > 0) {
@@ -353,47 +1362,98 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
       << "NGraphEncapsulateOp::Compute allocated result tensors for cluster "
       << m_cluster_id;
 
-  int time_create_or_lookup_tensors = create_or_lookup_tensors.ElapsedInMS();
-  // Execute the nGraph function.
-  int time_execute_function;
-  {
-    Timer execute_function;
-    {
-      OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute call starting for cluster "
-                   << m_cluster_id;
-      try {
-        ng_exec->Call(ng_inputs, ng_func_outputs, multi_req_execution);
-      } catch (const std::exception& exp) {
-        string status_string = "Caught exception while executing cluster " +
-                               to_string(m_cluster_id) + ": " +
-                               string(exp.what());
-        if (NGraphClusterManager::IsClusterFallbackEnabled()) {
-          OVTF_VLOG(4) << status_string;
-          OP_REQUIRES_OK(ctx, Fallback(ctx));
-          return;
-        } else {
-          OP_REQUIRES(ctx, false, errors::Internal(status_string));
-        }
-      } catch (...) {
-        string status_string = "Caught exception while executing cluster " +
-                               to_string(m_cluster_id);
-        if (NGraphClusterManager::IsClusterFallbackEnabled()) {
-          OVTF_VLOG(4) << status_string;
-          OP_REQUIRES_OK(ctx, Fallback(ctx));
-          return;
-        } else {
-          OP_REQUIRES(ctx, false, errors::Internal(status_string));
-        }
+  state.time_create_or_lookup_tensors = create_or_lookup_tensors.ElapsedInMS();
+  return Status::OK();
+}
+
+Status NGraphEncapsulateOp::BuildConstantOutputs(
+    OpKernelContext* ctx, Executable& ng_exec,
+    std::vector<Tensor>& constant_outputs) {
+  constant_outputs.assign(ng_exec.GetResults().size(), Tensor());
+  for (int i = 0; i < constant_outputs.size(); i++) {
+    auto constant = ng_exec.GetTrivialConstant(i);
+    if (constant == nullptr) continue;
+    ov::element::Type expected_elem_type;
+    TF_RETURN_IF_ERROR(util::TFDataTypeToNGraphElementType(
+        ctx->expected_output_dtype(i), &expected_elem_type));
+    // Left to the executable if the types do not agree
+    if (constant->get_element_type() != expected_elem_type) continue;
+    TensorShape tf_shape;
+    for (auto dim : constant->get_shape()) {
+      tf_shape.AddDim(dim);
+    }
+    Tensor tensor(ctx->expected_output_dtype(i), tf_shape);
+    if (tensor.TotalBytes() != constant->get_byte_size()) continue;
+    std::copy((const uint8_t*)constant->get_data_ptr(),
+              (const uint8_t*)constant->get_data_ptr() + tensor.TotalBytes(),
+              (uint8_t*)tensor.data());
+    constant_outputs[i] = tensor;
+  }
+  return Status::OK();
+}
+
+Status NGraphEncapsulateOp::SetTrivialOutputs(OpKernelContext* ctx,
+                                              ComputeState& state) {
+  Executable& ng_exec = *state.ng_exec;
+  const ov::ResultVector& results = ng_exec.GetResults();
+  const std::vector<Tensor>& constant_outputs = ng_exec.GetConstantOutputs();
+  // Every output is checked before any is set, the executable handles the
+  // ones which are neither forwarded, shared nor empty
+  std::vector<int> input_indexes(results.size(), -1);
+  std::vector<TensorShape> empty_shapes(results.size());
+  for (int i = 0; i < results.size(); i++) {
+    auto pshape = results[i]->get_output_partial_shape(0);
+    auto shape = pshape.is_static() ? pshape.to_shape() : ov::Shape{};
+    if (count(shape.begin(), shape.end(), 0)) {
+      for (auto dim : shape) {
+        empty_shapes[i].AddDim(dim);
       }
+      continue;
     }
-    time_execute_function = execute_function.ElapsedInMS();
+    input_indexes[i] = ng_exec.GetTrivialInputIndex(i);
+    if (input_indexes[i] >= 0 && input_indexes[i] < ctx->num_inputs() &&
+        ctx->input(input_indexes[i]).dtype() == ctx->expected_output_dtype(i)) {
+      continue;
+    }
+    input_indexes[i] = -1;
+    if (!constant_outputs[i].IsInitialized()) return Status::OK();
   }
 
-  if (device != "HDDL") {
-    for (auto i : dyn_shape_tensors) {
-      OP_REQUIRES(ctx, output_mappings[i] != -1,
-                  errors::Internal("Mapping error while "
-                                   "reading dynamic output blob"));
+  for (int i = 0; i < results.size(); i++) {
+    if (input_indexes[i] >= 0) {
+      ctx->set_output(i, ctx->input(input_indexes[i]));
+    } else if (constant_outputs[i].IsInitialized()) {
+      ctx->set_output(i, constant_outputs[i]);
+    } else {
+      Tensor* output_tensor = nullptr;
+      TF_RETURN_IF_ERROR(
+          ctx->allocate_output(i, empty_shapes[i], &output_tensor));
+    }
+  }
+  state.outputs_set = true;
+  m_metrics->executions++;
+  return Status::OK();
+}
+
+Status NGraphEncapsulateOp::FinishCompute(OpKernelContext* ctx,
+                                          ComputeState& state) {
+  int time_execute_function = state.execute_function.ElapsedInMS();
+  profiler::TraceMe trace([this] {
+    return profiler::TraceMeEncode("OVTF::OutputCopy", {{"cluster", name()}});
+  });
+  auto& ng_func_outputs = state.ng_func_outputs;
+  auto& output_mappings = state.output_mappings;
+  const ov::ResultVector& ng_result_list =
+      state.ng_exec->GetTranslatedResults();
+  const auto& ng_output_shapes = state.ng_exec->GetOutputShapes();
+
+  if (state.device != "HDDL") {
+    for (auto i : state.dyn_shape_tensors) {
+      if (output_mappings[i] == -1) {
+        return errors::Internal(
+            "Mapping error while "
+            "reading dynamic output blob");
+      }
       auto ng_output = ng_func_outputs[output_mappings[i]];
       // Create the TF output tensor
       auto ng_shape = ng_output->get_shape();
@@ -402,29 +1462,12 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
         tf_shape.AddDim(dim);
       }
 
-      // TODO: Zero-copy is depreciated temporarily because of memory allocation
-      // alignment
-      // mismatch related to EIGEN_MAX_ALIGN_BYTES.
-      Tensor* output_tensor = nullptr;
-      OP_REQUIRES_OK(ctx, ctx->allocate_output(i, tf_shape, &output_tensor));
-
-      auto size = ng_output->get_byte_size();
-      auto ie_tensor = static_pointer_cast<IETensor>(ng_output);
-
-#if TF_VERSION < 2
-      std::copy((uint8_t*)(ng_output->data()),
-                ((uint8_t*)(ng_output->data())) + size,
-                (uint8_t**)DMAHelper::base(output_tensor));
-#else
-      std::copy((uint8_t*)(ng_output->data()),
-                ((uint8_t*)(ng_output->data())) + size,
-                (uint8_t*)(output_tensor->data()));
-#endif
+      TF_RETURN_IF_ERROR(SetOutput(ctx, state, i, tf_shape, ng_output));
     }
   } else {
-    auto out_shape_check = [ng_output_shapes](int i) {
+    auto out_shape_check = [&ng_output_shapes](int i) {
       if (ng_output_shapes[i].size() > 0) {
-        auto out_shape_list = ng_output_shapes[i];
+        const auto& out_shape_list = ng_output_shapes[i];
         for (auto dim : out_shape_list) {
           if (dim == 0) return true;
         }
@@ -438,20 +1481,21 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
         ov::element::Type expected_elem_type;
         auto ng_element = ng_result_list[i];
         auto ng_element_type = ng_element->get_element_type();
-        OP_REQUIRES_OK(ctx,
-                       util::TFDataTypeToNGraphElementType(
-                           ctx->expected_output_dtype(i), &expected_elem_type));
-        OP_REQUIRES(
-            ctx, ng_element_type == expected_elem_type,
-            errors::Internal("Element type inferred by nGraph does not match "
-                             "the element type expected by TensorFlow"));
+        TF_RETURN_IF_ERROR(util::TFDataTypeToNGraphElementType(
+            ctx->expected_output_dtype(i), &expected_elem_type));
+        if (ng_element_type != expected_elem_type) {
+          return errors::Internal(
+              "Element type inferred by nGraph does not match "
+              "the element type expected by TensorFlow");
+        }
         TensorShape tf_shape;
         for (auto dim : ng_shape) {
           tf_shape.AddDim(dim);
         }
 
         Tensor* output_tensor = nullptr;
-        OP_REQUIRES_OK(ctx, ctx->allocate_output(i, tf_shape, &output_tensor));
+        TF_RETURN_IF_ERROR(
+            AllocateOutput(ctx, state, i, tf_shape, &output_tensor));
       } else {
         auto ng_output = ng_func_outputs[j++];
 
@@ -462,184 +1506,983 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
         ov::element::Type expected_elem_type;
         auto ng_element = ng_result_list[i];
         auto ng_element_type = ng_element->get_element_type();
-        OP_REQUIRES_OK(ctx,
-                       util::TFDataTypeToNGraphElementType(
-                           ctx->expected_output_dtype(i), &expected_elem_type));
-        OP_REQUIRES(
-            ctx, ng_element_type == expected_elem_type,
-            errors::Internal("Element type inferred by nGraph does not match "
-                             "the element type expected by TensorFlow"));
+        TF_RETURN_IF_ERROR(util::TFDataTypeToNGraphElementType(
+            ctx->expected_output_dtype(i), &expected_elem_type));
+        if (ng_element_type != expected_elem_type) {
+          return errors::Internal(
+              "Element type inferred by nGraph does not match "
+              "the element type expected by TensorFlow");
+        }
         TensorShape tf_shape;
         for (auto dim : ng_shape) {
           tf_shape.AddDim(dim);
         }
 
-        Tensor* output_tensor = nullptr;
-        OP_REQUIRES_OK(ctx, ctx->allocate_output(i, tf_shape, &output_tensor));
-
-        auto size = ng_output->get_byte_size();
-        auto ie_tensor = static_pointer_cast<IETensor>(ng_output);
-
-#if TF_VERSION < 2
-        std::copy((uint8_t*)(ng_output->data()),
-                  ((uint8_t*)(ng_output->data())) + size,
-                  (uint8_t**)DMAHelper::base(output_tensor));
-#else
-        std::copy((uint8_t*)(ng_output->data()),
-                  ((uint8_t*)(ng_output->data())) + size,
-                  (uint8_t*)(output_tensor->data()));
-#endif
+        TF_RETURN_IF_ERROR(SetOutput(ctx, state, i, tf_shape, ng_output));
       }
     }
   }
 
-  long vm = 0, rss = 0;
-  util::MemoryProfile(vm, rss);
-  OVTF_VLOG(1) << "OPENVINO_TF_MEM_PROFILE:  OP_ID: " << m_cluster_id
-               << " Step_ID: " << step_id << " Cluster: " << name()
-               << " Input Tensors created: "
-               << ng_input_tensor_size_in_bytes / (1024 * 1024) << " MB"
-               << " Total process memory: " << rss / (1024 * 1024) << " GB";
+  if (state.padding.IsPadded()) {
+    for (int i = 0; i < state.padded_outputs.size(); i++) {
+      const Tensor& padded = state.padded_outputs[i];
+      Tensor* output_tensor = nullptr;
+      TF_RETURN_IF_ERROR(ctx->allocate_output(
+          i,
+          state.padding.UnpaddedShape(
+              padded.shape(), state.ng_exec->GetPaddedOutputDims(), i),
+          &output_tensor));
+      ShapeBucketing::CopyLeadingBlock(padded, output_tensor);
+      m_metrics->bytes_copied += output_tensor->TotalBytes();
+    }
+  }
+
+  m_metrics->executions++;
+  m_metrics->execute_latency.Record(state.execute_function.ElapsedInMicroSec());
+
+  // Reading the process memory is too slow to do on every step
+  if (OVTF_VLOG_IS_ON(1)) {
+    long vm = 0, rss = 0;
+    util::MemoryProfile(vm, rss);
+    OVTF_VLOG(1) << "OPENVINO_TF_MEM_PROFILE:  OP_ID: " << m_cluster_id
+                 << " Step_ID: " << state.step_id << " Cluster: " << name()
+                 << " Total process memory: " << rss / (1024 * 1024) << " GB";
+  }
 
   OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute call done for cluster "
                << m_cluster_id;
 
-  OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute done marking fresh for cluster "
-               << m_cluster_id;
   OVTF_VLOG(1) << "OPENVINO_TF_TIMING_PROFILE: OP_ID: " << m_cluster_id
-               << " Step_ID: " << step_id << " Cluster: " << name()
-               << " Time-Compute: " << compute_time.ElapsedInMS()
-               << " Function-Create-or-Lookup: " << time_func_create_or_lookup
-               << " Create-and-copy-tensors: " << time_create_or_lookup_tensors
+               << " Step_ID: " << state.step_id << " Cluster: " << name()
+               << " Time-Compute: " << state.compute_time.ElapsedInMS()
+               << " Function-Create-or-Lookup: "
+               << state.time_func_create_or_lookup
+               << " Create-and-copy-tensors: "
+               << state.time_create_or_lookup_tensors
                << " Execute: " << time_execute_function;
-}  // end compute
+  if (state.timed_step) {
+    state.ng_exec->GetBackendSelector()->Record(
+        BackendSelector::Path::kOpenVINO,
+        state.compute_time.ElapsedInMicroSec());
+  }
+  // The variables hold the outputs of this step
+  KVCacheState* kv_cache = state.ng_exec->GetKVCacheState();
+  if (kv_cache != nullptr) {
+    std::vector<Tensor> outputs(ctx->num_outputs());
+    for (int i = 0; i < ctx->num_outputs(); i++) {
+      Tensor* output = ctx->mutable_output(i);
+      if (output != nullptr) outputs[i] = *output;
+    }
+    kv_cache->EndStep(outputs);
+  }
+  return Status::OK();
+}
 
-// Computes signature and gets executable
-Status NGraphEncapsulateOp::GetExecutable(
-    const std::vector<Tensor>& tf_input_tensors,
-    std::shared_ptr<Executable>& ng_exec) {
-  auto backend = BackendManager::GetBackend();
+Status NGraphEncapsulateOp::AllocateOutput(OpKernelContext* ctx,
+                                           ComputeState& state, int i,
+                                           const TensorShape& shape,
+                                           Tensor** output_tensor) {
+  if (!state.padding.IsPadded()) {
+    const std::vector<int>& inputs = state.ng_exec->GetForwardableInputs(i);
+    if (!m_forward_inputs || inputs.empty()) {
+      return ctx->allocate_output(i, shape, output_tensor);
+    }
+    int forwarded = -1;
+    TF_RETURN_IF_ERROR(ctx->forward_input_or_allocate_output(
+        inputs, i, shape, output_tensor, &forwarded));
+    if (forwarded >= 0) {
+      OVTF_VLOG(4) << "Output " << i << " of " << name()
+                   << " is forwarded from input " << forwarded;
+      state.inputs_forwarded = true;
+      m_metrics->bytes_forwarded += (*output_tensor)->TotalBytes();
+    }
+    return Status::OK();
+  }
+  TF_RETURN_IF_ERROR(ctx->allocate_temp(ctx->expected_output_dtype(i), shape,
+                                        &state.padded_outputs[i]));
+  *output_tensor = &state.padded_outputs[i];
+  return Status::OK();
+}
 
-  // Compute Signature
-  std::vector<const Tensor*> static_input_map;
-  std::vector<TensorShape> input_shapes;
-  std::stringstream signature_ss;
+Status NGraphEncapsulateOp::AllocateSharedOutput(
+    OpKernelContext* ctx, int i, const ov::element::Type& type,
+    const ov::Shape& shape, std::shared_ptr<IETensor>& ng_output) {
+  ng_output = nullptr;
+#if TF_VERSION >= 2
+  auto gpu_context = Backend::GetGPUContext();
+  if (gpu_context == nullptr) return Status::OK();
+  std::shared_ptr<IETensor> tensor;
+  try {
+    tensor =
+        make_shared<IETensor>(gpu_context->create_host_tensor(type, shape));
+  } catch (const std::exception& e) {
+    OVTF_VLOG(2) << "Could not allocate shared output " << i << " of "
+                 << m_name << ": " << e.what();
+    return Status::OK();
+  }
+  if (!IETensorBuffer::CanWrap(*tensor)) return Status::OK();
+  TensorShape tf_shape;
+  for (auto dim : shape) {
+    tf_shape.AddDim(dim);
+  }
+  IETensorBuffer* buffer = new IETensorBuffer(tensor);
+  Tensor output_tensor(ctx->expected_output_dtype(i), tf_shape, buffer);
+  buffer->Unref();
+  ctx->set_output(i, output_tensor);
+  ng_output = tensor;
+#endif
+  return Status::OK();
+}
+
+Status NGraphEncapsulateOp::SetOutput(
+    OpKernelContext* ctx, ComputeState& state, int i, const TensorShape& shape,
+    const std::shared_ptr<ov::Tensor>& ng_output) {
+  auto size = ng_output->get_byte_size();
+#if TF_VERSION >= 2
+  auto ie_output = std::dynamic_pointer_cast<IETensor>(ng_output);
+  DataType dtype = ctx->expected_output_dtype(i);
+  if (ie_output != nullptr && IETensorBuffer::CanWrap(*ie_output) &&
+      DataTypeCanUseMemcpy(dtype) &&
+      size == shape.num_elements() * DataTypeSize(dtype)) {
+    IETensorBuffer* buffer = new IETensorBuffer(ie_output);
+    Tensor output_tensor(dtype, shape, buffer);
+    buffer->Unref();
+    if (state.padding.IsPadded()) {
+      state.padded_outputs[i] = output_tensor;
+    } else {
+      ctx->set_output(i, output_tensor);
+    }
+    return Status::OK();
+  }
+#endif
+
+  Tensor* output_tensor = nullptr;
+  TF_RETURN_IF_ERROR(AllocateOutput(ctx, state, i, shape, &output_tensor));
+#if TF_VERSION < 2
+  HostCopy::Copy(DMAHelper::base(output_tensor), ng_output->data(), size);
+#else
+  HostCopy::Copy(output_tensor->data(), ng_output->data(), size);
+#endif
+  m_metrics->bytes_copied += size;
+  return Status::OK();
+}
+
+Status NGraphEncapsulateOp::SetKVCaches(
+    const std::vector<Tensor>& tf_input_tensors, Executable& ng_exec,
+    KVCacheState& kv_cache) {
+  for (int i : kv_cache.BeginStep(tf_input_tensors)) {
+    const KVCacheInput& cache = kv_cache.Inputs()[i];
+    const Tensor& past = tf_input_tensors[cache.input];
+    ov::element::Type type;
+    TF_RETURN_IF_ERROR(
+        util::TFDataTypeToNGraphElementType(past.dtype(), &type));
+    ov::Shape shape;
+    for (auto dim : past.shape().dim_sizes()) shape.push_back(dim);
+    OVTF_VLOG(2) << "Setting KV-cache " << cache.input << " of " << m_name
+                 << " to a past of " << past.shape().DebugString();
+    try {
+      // The variable keeps a copy
+      ng_exec.SetState(
+          KVCacheState::VariableName(cache.input),
+          past.NumElements() == 0
+              ? ov::Tensor(type, shape)
+              : ov::Tensor(type, shape,
+                           const_cast<char*>(past.tensor_data().data())));
+    } catch (const std::exception& ex) {
+      return errors::Internal("Failed to set the KV-cache ", cache.input,
+                              " of ", m_name, ": ", ex.what());
+    }
+    m_metrics->bytes_copied += past.TotalBytes();
+  }
+  return Status::OK();
+}
+
+bool NGraphEncapsulateOp::UseDynamicShapes(
+    const std::vector<Tensor>& tf_input_tensors) {
+  if (!m_dynamic_shapes) return false;
+  // Inputs with a zero sized dimension are folded into constants during the
+  // translation, which needs the static shape
   for (int i = 0; i < tf_input_tensors.size(); i++) {
-    const Tensor& input_tensor = tf_input_tensors[i];
-    input_shapes.push_back(input_tensor.shape());
-    for (const auto& x : input_tensor.shape()) {
-      signature_ss << x.size << ",";
+    if (!m_input_is_static[i] && tf_input_tensors[i].NumElements() == 0 &&
+        (m_kv_cache.empty() || m_kv_cache_index[i] < 0)) {
+      return false;
     }
-    signature_ss << ";";
   }
-  signature_ss << "/";
+  return true;
+}
 
-  static_input_map.resize(tf_input_tensors.size());
+Status NGraphEncapsulateOp::ComputeSignature(
+    const std::vector<Tensor>& tf_input_tensors, bool dynamic_shapes,
+    const std::vector<bool>& input_is_static, CompilationKey& signature) {
   for (int i = 0; i < tf_input_tensors.size(); i++) {
-    if (m_input_is_static[i]) {
-      static_input_map[i] = &tf_input_tensors[i];
-      TF_RETURN_IF_ERROR(
-          util::TensorToStream(signature_ss, tf_input_tensors[i]));
-      signature_ss << ";";
+    const Tensor& input_tensor = tf_input_tensors[i];
+    if (!m_kv_cache.empty() && m_kv_cache_index[i] >= 0) {
+      const KVCacheInput& cache = m_kv_cache[m_kv_cache_index[i]];
+      signature.AddStatefulInput(input_tensor.dtype(), input_tensor.shape(),
+                                 cache.Axis(input_tensor.dims()));
+    } else if (dynamic_shapes && !input_is_static[i]) {
+      signature.AddDynamicInput(input_tensor.dtype(), input_tensor.dims());
+    } else {
+      signature.AddInput(input_tensor.dtype(), input_tensor.shape());
+    }
+  }
+  for (int i = 0; i < tf_input_tensors.size(); i++) {
+    if (input_is_static[i]) {
+      TF_RETURN_IF_ERROR(signature.AddStaticInput(i, tf_input_tensors[i]));
     }
   }
 
-  string signature = signature_ss.str();
-  OVTF_VLOG(5) << "Computed signature: " << signature;
-  auto it = m_ng_exec_map.find(signature);
+  OVTF_VLOG(5) << "Computed signature: " << signature.DebugString();
   OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute got inputs for cluster "
                << m_cluster_id;
+  return Status::OK();
+}
 
-  // Translate the TensorFlow graph to nGraph.
-  std::shared_ptr<ov::Model> ng_function;
-  if (it == m_ng_exec_map.end()) {
-    // Measure the current total memory usage
-    long vm = 0, rss = 0, vm0 = 0, rss0 = 0;
-    util::MemoryProfile(vm0, rss0);
+// The lookups of one step, whose signature changes when a static input turns
+// out to change, or when the static inputs or the dynamic shapes are given
+// up after a failed compilation, and which are attempted again once another
+// step compiled their signature
+static constexpr int kMaxLookupAttempts = 8;
 
-    ng_result_list.clear();
-    OVTF_VLOG(1) << "Compilation cache miss: " << m_name;
-    TF_RETURN_IF_ERROR(Builder::TranslateGraph(
-        input_shapes, static_input_map, &m_graph, m_name, ng_function,
-        ng_result_list, tf_input_tensors));
-    util::DumpNGGraph(ng_function, m_name);
+// Computes signature and gets executable
+Status NGraphEncapsulateOp::GetExecutable(
+    const std::vector<Tensor>& tf_input_tensors,
+    std::unique_lock<std::mutex>& exec_cache_lock,
+    std::shared_ptr<Executable>& ng_exec, CompilationKey* cold_signature,
+    SignatureLookup* lookup) {
+  for (int attempt = 0; attempt < kMaxLookupAttempts; attempt++) {
+    bool dynamic_shapes = UseDynamicShapes(tf_input_tensors);
+    auto input_is_static = m_static_inputs->StaticInputs();
+    CompilationKey signature;
+    TF_RETURN_IF_ERROR(ComputeSignature(tf_input_tensors, dynamic_shapes,
+                                        *input_is_static, signature));
+    if (SignatureFellBack(signature, lookup)) {
+      ng_exec = nullptr;
+      return Status::OK();
+    }
 
-    std::vector<ov::Shape> ng_output_shapes;
-    ng_output_shapes.resize(ng_result_list.size());
-    for (int i = 0; i < ng_result_list.size(); i++) {
-      if (ng_result_list[i]->is_dynamic()) {
-        ng_output_shapes[i] = ov::Shape{};
-      } else {
-        ng_output_shapes[i] = ng_result_list[i]->get_shape();
+    if (LookupExecutable(signature, ng_exec) &&
+        !ConstantVariablesWritten(tf_input_tensors, *ng_exec)) {
+      // Found the input signature in the cache, use the cached executable
+      return Status::OK();
+    }
+    ng_exec = nullptr;
+    if (m_static_inputs->RecordMiss(tf_input_tensors)) continue;
+    // A cancelled step waiting for the compilations of other steps does not
+    // start one
+    auto cancellation = StepCancellation::Current();
+    if (cancellation != nullptr) TF_RETURN_IF_ERROR(cancellation->Check());
+    // Another step compiles the signature, its executable or its failure is
+    // looked up again once it is done
+    if (m_compiling.count(signature)) {
+      OVTF_VLOG(2) << "Waiting for the compilation of " << m_name
+                   << " in progress";
+      m_compile_done_cv.wait(exec_cache_lock, [this, &signature]() {
+        return m_compiling.count(signature) == 0;
+      });
+      continue;
+    }
+    if (IsColdSignature(signature, cold_signature)) {
+      ng_exec = nullptr;
+      return Status::OK();
+    }
+
+    // The steps hitting the cache, and the misses of the other signatures,
+    // proceed while the signature compiles
+    m_compiling.insert(signature);
+    auto compiled = gtl::MakeCleanup([this, &signature]() {
+      m_compiling.erase(signature);
+      m_compile_done_cv.notify_all();
+    });
+    exec_cache_lock.unlock();
+    Status status = BuildExecutable(tf_input_tensors, dynamic_shapes,
+                                    *input_is_static, signature, ng_exec);
+    exec_cache_lock.lock();
+    // The executable may fit the memory budget of its device on a later step
+    if (errors::IsResourceExhausted(status)) return status;
+    if (!status.ok() && *input_is_static != m_input_is_static &&
+        m_static_inputs->Disable()) {
+      OVTF_VLOG(1) << "Cluster " << m_name
+                   << " can not read its static inputs at run time: "
+                   << status.error_message();
+      continue;
+    }
+    if (!status.ok() && dynamic_shapes) {
+      OVTF_VLOG(1) << "Cluster " << m_name
+                   << " does not support dynamic shapes, compiling per shape: "
+                   << status.error_message();
+      m_dynamic_shapes = false;
+      continue;
+    }
+    if (!status.ok()) {
+      // The steps waiting for the signature fall back without compiling it
+      // again
+      if (lookup != nullptr &&
+          NGraphClusterManager::IsClusterFallbackEnabled()) {
+        NGraphClusterManager::SetSignatureFallback(m_cache_owner, signature);
+        lookup->fell_back = true;
       }
+      return status;
+    }
+    InsertExecutable(signature, ng_exec);
+    return Status::OK();
+  }
+  ng_exec = nullptr;
+  return errors::Internal("Gave up looking up the executable of ", m_name,
+                          " after ", kMaxLookupAttempts, " attempts");
+}
+
+Status NGraphEncapsulateOp::BuildExecutable(
+    const std::vector<Tensor>& tf_input_tensors, bool dynamic_shapes,
+    const std::vector<bool>& input_is_static, const CompilationKey& signature,
+    std::shared_ptr<Executable>& ng_exec) {
+  CompileSlot slot;
+  Timer compile_time;
+  // Measure the current total memory usage
+  long vm = 0, rss = 0, vm0 = 0, rss0 = 0;
+  util::MemoryProfile(vm0, rss0);
+
+  std::vector<const Tensor*> static_input_map(tf_input_tensors.size(),
+                                              nullptr);
+  std::vector<TensorShape> input_shapes;
+  for (int i = 0; i < tf_input_tensors.size(); i++) {
+    input_shapes.push_back(tf_input_tensors[i].shape());
+    if (input_is_static[i]) {
+      static_input_map[i] = &tf_input_tensors[i];
     }
+  }
+
+  // Translate the TensorFlow graph to nGraph.
+  std::shared_ptr<ov::Model> ng_function;
+  ngraph::ResultVector ng_result_list;
+  OVTF_VLOG(1) << "Compilation cache miss: " << m_name;
+  // The translation depends on the device of the backend
+  BackendManager::ScopedBackend scoped_backend(m_backend, m_backend_name);
+  if (dynamic_shapes ||
+      !ReshapeTranslatedModel(tf_input_tensors, input_shapes,
+                              static_input_map, ng_function, ng_result_list)) {
+    TF_RETURN_IF_ERROR(Builder::TranslateGraph(
+        input_shapes, static_input_map, m_graph, m_name, ng_function,
+        ng_result_list, tf_input_tensors, dynamic_shapes, m_kv_cache));
+  }
+  util::DumpNGGraph(ng_function, m_name);
 
-    // Evict the cache if the number of elements exceeds the limit
-    std::shared_ptr<Executable> evicted_ng_exec;
-    const char* cache_depth_specified =
-        std::getenv("OPENVINO_TF_FUNCTION_CACHE_ITEM_DEPTH");
-    if (cache_depth_specified != nullptr) {
-      m_function_cache_depth_in_items =
-          (int)strtol(cache_depth_specified, NULL, 10);
+  std::vector<ov::Shape> ng_output_shapes;
+  ng_output_shapes.resize(ng_result_list.size());
+  for (int i = 0; i < ng_result_list.size(); i++) {
+    if (ng_result_list[i]->is_dynamic()) {
+      ng_output_shapes[i] = ov::Shape{};
+    } else {
+      ng_output_shapes[i] = ng_result_list[i]->get_shape();
     }
-    if (m_ng_exec_map.size() >= m_function_cache_depth_in_items) {
-      evicted_ng_exec = m_ng_exec_map[m_lru.back()];
-      m_ng_exec_map.erase(m_lru.back());
+  }
 
-      m_lru.pop_back();
-    }  // cache eviction if cache size greater than cache depth
+  // Before the compilation drops the unused parameters of the model
+  ShapeBucketing::OutputDims padded_output_dims;
+  if (m_shape_bucketing.IsEnabled()) {
+    padded_output_dims = m_shape_bucketing.FindOutputDims(
+        ng_function, ng_result_list, input_shapes,
+        ShapeBucketing::BucketedInputs(input_shapes, input_is_static,
+                                       m_input_is_variable));
+  }
 
+  auto backend = m_backend;
+  ng_exec = nullptr;
+  if (!m_placed_device.empty()) {
+    shared_ptr<Backend> placed_backend;
+    Status status =
+        BackendManager::GetPlacedBackend(m_placed_device, placed_backend);
+    if (status.ok()) {
+      try {
+        ng_exec = placed_backend->Compile(ng_function, m_compile_config);
+      } catch (const std::exception& ex) {
+        status = errors::Internal(ex.what());
+      }
+    }
+    if (!status.ok()) {
+      OVTF_VLOG(1) << "Failed to compile " << m_name << " on "
+                   << m_placed_device << ", compiling on the backend: "
+                   << status.error_message();
+    }
+  }
+  if (ng_exec == nullptr) {
+    if (m_query_op_support) {
+      TF_RETURN_IF_ERROR(CheckDeviceSupport(*backend, ng_function));
+    }
     try {
-      ng_exec = backend->Compile(ng_function);
+      ng_exec = backend->Compile(ng_function, m_compile_config);
     } catch (const std::exception& ex) {
       return errors::Internal("Failed to compile function " + m_name + ": ",
                               ex.what());
     }
+  }
+
+  // The weights are a lower bound of what the compiled model holds on to,
+  // on top of the input and output buffers of every infer request
+  Executable::MemoryUsage memory_usage;
+  for (const auto& node : ng_function->get_ops()) {
+    auto constant = ov::as_type_ptr<opset::Constant>(node);
+    if (constant != nullptr) {
+      memory_usage.compiled_bytes += constant->get_byte_size();
+    }
+  }
+  for (const auto& io : {ng_function->inputs(), ng_function->outputs()}) {
+    for (const auto& port : io) {
+      if (port.get_partial_shape().is_static()) {
+        memory_usage.io_bytes +=
+            ov::shape_size(port.get_shape()) * port.get_element_type().size();
+      }
+    }
+  }
+  const string& device = ng_exec->GetDevice();
+  TF_RETURN_IF_ERROR(NGraphClusterManager::ReserveDeviceMemory(
+      device, memory_usage.Total(), ng_exec.get()));
+  size_t device_bytes0 = 0, device_bytes = 0;
+  bool device_reported =
+      MemoryBudget::DeviceMemoryUsage(device, device_bytes0);
+
+  UseAOTBundle(signature, *ng_exec);
+  // The device compiles the model now rather than on the first call, which
+  // keeps the background compilations off the TF threads
+  try {
+    ng_exec->LoadNetwork();
+  } catch (const std::exception& ex) {
+    // The compilation, or the import of the AOT bundle, failed
+    NGraphClusterManager::ReleaseDeviceMemory(*ng_exec);
+    return errors::Internal("Failed to compile function " + m_name + ": ",
+                            ex.what());
+  }
+  if (m_variables_as_constants && m_has_variables) {
+    // The variables the constants were made from
+    ng_exec->SetHasConstantVariables(true);
+    ng_exec->GetVariableState().Update(tf_input_tensors, m_input_is_variable);
+  }
+  ng_exec->SetOutputShapes(ng_output_shapes);
+  ng_exec->SetTranslatedResults(ng_result_list);
+  ng_exec->SetPaddedOutputDims(std::move(padded_output_dims));
+  if (!m_kv_cache.empty()) {
+    ng_exec->SetKVCacheState(
+        std::unique_ptr<KVCacheState>(new KVCacheState(m_kv_cache)));
+  }
+  m_metrics->compiles++;
+  m_metrics->compile_micros += compile_time.ElapsedInMicroSec();
+
+  // Memory after
+  util::MemoryProfile(vm, rss);
+  auto delta_vm_mem = vm - vm0;
+  auto delta_res_mem = rss - rss0;
+  // The device and RSS deltas are skewed by concurrent compilations and
+  // include the buffers of the infer requests created by the loading
+  memory_usage.num_requests = ng_exec->GetNumRequests();
+  const size_t request_bytes =
+      memory_usage.io_bytes * memory_usage.num_requests;
+  size_t loaded_bytes = std::max<long>(delta_res_mem, 0) * 1024;
+  if (device_reported &&
+      MemoryBudget::DeviceMemoryUsage(device, device_bytes) &&
+      device_bytes > device_bytes0) {
+    loaded_bytes = device_bytes - device_bytes0;
+  }
+  if (loaded_bytes > request_bytes) {
+    memory_usage.compiled_bytes = std::max(memory_usage.compiled_bytes,
+                                           loaded_bytes - request_bytes);
+  }
+  ng_exec->SetMemoryUsage(memory_usage);
+  OVTF_VLOG(1) << "OPENVINO_TF_CACHE_PROFILE: OP_ID: " << m_cluster_id
+               << " Cluster: " << m_name << " Delta VM: " << delta_vm_mem
+               << " Delta RSS: " << delta_res_mem
+               << " KB Total RSS: " << rss / (1024 * 1024) << " GB "
+               << " VM: " << vm / (1024 * 1024) << " GB"
+               << " Executable: " << memory_usage.compiled_bytes
+               << " compiled bytes, " << memory_usage.num_requests
+               << " requests of " << memory_usage.io_bytes << " I/O bytes"
+               << endl;
+  return Status::OK();
+}
 
-    m_ng_exec_map[signature] = ng_exec;
-    ng_exec->SetOutputShapes(ng_output_shapes);
+Status NGraphEncapsulateOp::CheckDeviceSupport(
+    Backend& backend, const std::shared_ptr<ov::Model>& ng_function) {
+  std::map<std::shared_ptr<ov::Node>, std::vector<string>> unsupported;
+  Status status = backend.QueryUnsupportedOps(ng_function, unsupported);
+  if (!status.ok()) {
+    // The compilation reports the errors the query could not
+    OVTF_VLOG(1) << status.error_message();
+    return Status::OK();
+  }
+  if (unsupported.empty()) return Status::OK();
+
+  // The ops are named after the TF node they were translated from
+  std::map<string, const Node*> tf_nodes;
+  for (const Node* node : m_graph->nodes()) tf_nodes[node->name()] = node;
+  std::set<string> ops;
+  for (const auto& op : unsupported) {
+    string name = op.first->get_friendly_name();
+    auto tf_node = tf_nodes.find(name.substr(0, name.rfind('/')));
+    if (tf_node == tf_nodes.end()) {
+      ops.insert(name);
+      continue;
+    }
+    string tf_signature = OpSupport::TFSignature(tf_node->second);
+    for (const auto& device : op.second) {
+      OpSupport::SetTFUnsupported(device, tf_signature);
+    }
+    ops.insert(tf_node->first + " (" + tf_signature + ")");
+  }
+  string op_list;
+  for (const auto& op : ops) op_list += (op_list.empty() ? "" : ", ") + op;
+  return errors::Unimplemented("The device does not support the ops ",
+                               op_list, " of ", m_name);
+}
 
-    m_lru.push_front(signature);
+bool NGraphEncapsulateOp::ReshapeTranslatedModel(
+    const std::vector<Tensor>& tf_input_tensors,
+    const std::vector<TensorShape>& input_shapes,
+    const std::vector<const Tensor*>& static_inputs,
+    std::shared_ptr<ov::Model>& ng_function, ov::ResultVector& ng_result_list) {
+  // The variables converted to constants are not part of the signature
+  if (!m_reuse_translation || (m_variables_as_constants && m_has_variables)) {
+    return false;
+  }
+  // The translation drops the inputs with a zero dimension
+  for (const auto& shape : input_shapes) {
+    if (shape.num_elements() == 0 && shape.dims() > 0) return false;
+  }
+  std::vector<bool> input_is_static(static_inputs.size());
+  for (size_t i = 0; i < static_inputs.size(); i++) {
+    input_is_static[i] = static_inputs[i] != nullptr;
+  }
+  CompilationKey dynamic_signature;
+  if (!ComputeSignature(tf_input_tensors, true, input_is_static,
+                        dynamic_signature)
+           .ok()) {
+    return false;
+  }
 
-    // Memory after
-    util::MemoryProfile(vm, rss);
-    auto delta_vm_mem = vm - vm0;
-    auto delta_res_mem = rss - rss0;
-    OVTF_VLOG(1) << "OPENVINO_TF_CACHE_PROFILE: OP_ID: " << m_cluster_id
-                 << " Cache length: " << m_ng_exec_map.size()
-                 << " Cluster: " << m_name << " Delta VM: " << delta_vm_mem
-                 << " Delta RSS: " << delta_res_mem
-                 << " KB Total RSS: " << rss / (1024 * 1024) << " GB "
-                 << " VM: " << vm / (1024 * 1024) << " GB" << endl;
-  }  // end of input signature not found in m_ng_exec_map
-  else {
-    // Found the input signature in m_ng_exec_map, use the cached executable
-    // Update the m_lru
-    if (signature != m_lru.front()) {
-      m_lru.remove(signature);
-      m_lru.push_front(signature);
-    }
-    ng_exec = it->second;
+  std::shared_ptr<ov::Model> translated;
+  {
+    std::lock_guard<std::mutex> lock(m_translated_models_lock_);
+    auto it = m_translated_models.find(dynamic_signature);
+    if (it == m_translated_models.end()) {
+      ov::ResultVector translated_results;
+      Status status = Builder::TranslateGraph(
+          input_shapes, static_inputs, m_graph, m_name, translated,
+          translated_results, tf_input_tensors, true);
+      // Every input and result must be in the model to map it back
+      if (!status.ok() ||
+          translated->get_parameters().size() != input_shapes.size() ||
+          translated->get_results().size() != translated_results.size()) {
+        OVTF_VLOG(1) << "Cluster " << m_name
+                     << " can not be reshaped: " << status.error_message();
+        translated = nullptr;
+      }
+      // Bounded like the executables of the cluster
+      if (m_translated_models.size() >= 16) m_translated_models.clear();
+      it = m_translated_models.emplace(dynamic_signature, translated).first;
+    }
+    translated = it->second;
+  }
+  if (translated == nullptr) return false;
+
+  // The constants are shared with the translated model
+  auto reshaped = translated->clone();
+  std::map<ov::Output<ov::Node>, ov::PartialShape> shapes;
+  const auto& params = reshaped->get_parameters();
+  for (int i = 0; i < params.size(); i++) {
+    ov::Shape shape(input_shapes[i].dims());
+    for (int j = 0; j < input_shapes[i].dims(); j++) {
+      shape[j] = input_shapes[i].dim_size(j);
+    }
+    shapes[params[i]->output(0)] = shape;
+  }
+  try {
+    reshaped->reshape(shapes);
+  } catch (const std::exception& e) {
+    OVTF_VLOG(1) << "Failed to reshape " << m_name
+                 << ", translating it: " << e.what();
+    return false;
+  }
+  OVTF_VLOG(1) << "Reshaped the translated model of " << m_name;
+  ng_function = reshaped;
+  ng_result_list = reshaped->get_results();
+  return true;
+}
+
+bool NGraphEncapsulateOp::ConstantVariablesWritten(
+    const std::vector<Tensor>& tf_input_tensors, Executable& ng_exec) {
+  if (!ng_exec.HasConstantVariables() ||
+      !ng_exec.GetVariableState().Update(tf_input_tensors,
+                                         m_input_is_variable)) {
+    return false;
+  }
+  // The variables are the same for every signature
+  OVTF_VLOG(1) << "Variables of " << m_name
+               << " were written, recompiling the cluster";
+  NGraphClusterManager::EraseClusterExecutables(m_cache_owner);
+  return true;
+}
+
+string NGraphEncapsulateOp::ModelSettings() const {
+  std::stringstream settings;
+  settings << "pattern_fusion="
+           << (util::GetEnv("OPENVINO_TF_PATTERN_FUSION") != "0")
+           << ";dynamic_shapes=" << m_dynamic_shapes
+           << ";bucketing=" << m_shape_bucketing.DebugString();
+  // The input preprocessing is folded and the weights are compressed
+  // before the model is compiled or imported
+  settings << ";fold_preprocessing="
+           << (util::GetEnv("OPENVINO_TF_FOLD_PREPROCESSING") != "0")
+           << ";weight_compression="
+           << util::GetEnv("OPENVINO_TF_WEIGHT_COMPRESSION") << ","
+           << util::GetEnv("OPENVINO_TF_WEIGHT_COMPRESSION_MIN_KB");
+  return settings.str();
+}
+
+void NGraphEncapsulateOp::UseAOTBundle(const CompilationKey& signature,
+                                       Executable& ng_exec) {
+  AOTBundle::Mode mode = AOTBundle::GetMode();
+  // Trivial executables have no compiled model, and the VAD-M engine
+  // compiles its model for the batch size of every call
+  if (mode == AOTBundle::Mode::kDisabled || ng_exec.IsTrivial() ||
+      ng_exec.GetDevice() == "HDDL") {
+    return;
+  }
+  std::call_once(m_graph_fingerprint_once, [this]() {
+    GraphDef graph_def;
+    m_graph->ToGraphDef(&graph_def);
+    m_graph_fingerprint = AOTBundle::FingerprintGraph(graph_def);
+  });
+  string entry = AOTBundle::EntryName(m_graph_fingerprint, signature,
+                                      ng_exec.GetDeviceType(),
+                                      m_compile_config, ModelSettings());
+  if (mode == AOTBundle::Mode::kLoad) {
+    string path = AOTBundle::FindEntry(entry);
+    if (path.empty()) {
+      OVTF_VLOG(1) << "AOT bundle miss: " << m_name << " " << entry;
+    } else {
+      ng_exec.ImportCompiled(path);
+    }
+  } else {
+    Status status = AOTBundle::ExportEntry(entry, m_name, signature, ng_exec);
+    if (!status.ok()) {
+      OVTF_VLOG(0) << "Failed to add " << m_name
+                   << " to the AOT bundle: " << status.error_message();
+    }
+  }
+}
+
+void NGraphEncapsulateOp::InsertExecutable(
+    const CompilationKey& signature, std::shared_ptr<Executable> ng_exec) {
+  // Evict the cache if the number of elements exceeds the limit
+  size_t cache_depth = 16;
+  const char* cache_depth_specified =
+      std::getenv("OPENVINO_TF_FUNCTION_CACHE_ITEM_DEPTH");
+  if (cache_depth_specified != nullptr) {
+    cache_depth = (size_t)strtol(cache_depth_specified, NULL, 10);
+  }
+  if (m_auto_backend_selection && ng_exec->GetBackendSelector() == nullptr) {
+    ng_exec->SetBackendSelector(BackendSelector::FromEnv());
+  }
+  NGraphClusterManager::InsertExecutable(m_cache_owner, signature, ng_exec,
+                                         ng_exec->GetMemoryEstimate(),
+                                         cache_depth);
+  auto& cache = NGraphClusterManager::GetExecutableCache();
+  auto stats = cache.GetClusterStats(m_cache_owner);
+  OVTF_VLOG(1) << "OPENVINO_TF_CACHE_PROFILE: OP_ID: " << m_cluster_id
+               << " Cache length: " << stats.entries
+               << " Cache bytes: " << stats.bytes
+               << " Evictions: " << stats.evictions << " Cluster: " << m_name
+               << " Total cache bytes: " << cache.Bytes();
+}
+
+bool NGraphEncapsulateOp::LookupExecutable(
+    const CompilationKey& signature, std::shared_ptr<Executable>& ng_exec) {
+  if (NGraphClusterManager::LookupExecutable(m_cache_owner, signature,
+                                             ng_exec)) {
+    return true;
   }
+  if (!NGraphClusterManager::LookupSharedExecutable(m_cache_owner, signature,
+                                                    ng_exec)) {
+    return false;
+  }
+  OVTF_VLOG(1) << "Cluster " << m_name
+               << " shares the executable of an identical cluster";
+  InsertExecutable(signature, ng_exec);
+  return true;
+}
+
+Status NGraphEncapsulateOp::GetExecutableOrCompileInBackground(
+    const std::vector<Tensor>& tf_input_tensors,
+    std::shared_ptr<Executable>& ng_exec, bool& compile_pending,
+    CompilationKey* cold_signature, SignatureLookup* lookup) {
+  compile_pending = false;
+  bool dynamic_shapes;
+  std::shared_ptr<const std::vector<bool>> input_is_static;
+  CompilationKey signature;
+  for (int attempt = 0;; attempt++) {
+    if (attempt == kMaxLookupAttempts) {
+      return errors::Internal("Gave up looking up the executable of ", m_name,
+                              " after ", kMaxLookupAttempts, " attempts");
+    }
+    dynamic_shapes = UseDynamicShapes(tf_input_tensors);
+    input_is_static = m_static_inputs->StaticInputs();
+    signature = CompilationKey();
+    TF_RETURN_IF_ERROR(ComputeSignature(tf_input_tensors, dynamic_shapes,
+                                        *input_is_static, signature));
+    if (SignatureFellBack(signature, lookup)) {
+      ng_exec = nullptr;
+      return Status::OK();
+    }
+    if (LookupExecutable(signature, ng_exec) &&
+        !ConstantVariablesWritten(tf_input_tensors, *ng_exec)) {
+      return Status::OK();
+    }
+    ng_exec = nullptr;
+    if (!m_static_inputs->RecordMiss(tf_input_tensors)) break;
+  }
+  if (IsColdSignature(signature, cold_signature)) return Status::OK();
+
+  compile_pending = true;
+  if (m_compiling.count(signature)) {
+    OVTF_VLOG(2) << "Compilation already in progress for " << m_name;
+    return Status::OK();
+  }
+  OVTF_VLOG(1) << "Scheduling background compilation for " << m_name;
+  m_compiling.insert(signature);
+  m_pending_compiles++;
+  NGraphClusterManager::BackgroundCompileStarted();
+  thread::ThreadPool* pool = GetCompileThreadPool();
+  if (m_warmup_compilation || NGraphClusterManager::IsWarmingUp()) {
+    pool = GetWarmupThreadPool();
+  }
+  // TF Tensors are reference counted, the copies keep the static input
+  // values alive until the translation is done
+  auto cancellation = StepCancellation::Current();
+  pool->Schedule([this, signature, tf_input_tensors, dynamic_shapes,
+                  input_is_static, cancellation]() {
+    std::shared_ptr<Executable> bg_ng_exec;
+    // The compilation of a step cancelled while it was queued is dropped,
+    // the next step of the signature schedules it again
+    Status status = cancellation != nullptr ? cancellation->Check()
+                                            : Status::OK();
+    if (status.ok()) {
+      status = BuildExecutable(tf_input_tensors, dynamic_shapes,
+                               *input_is_static, signature, bg_ng_exec);
+    }
+    bool cancelled = errors::IsCancelled(status);
+    bool out_of_budget = errors::IsResourceExhausted(status);
+    bool runtime_inputs_failed = !status.ok() && !out_of_budget &&
+                                 !cancelled &&
+                                 *input_is_static != m_input_is_static &&
+                                 m_static_inputs->Disable();
+    if (cancelled) {
+      OVTF_VLOG(1) << "Background compilation of " << m_name
+                   << " dropped, its step was cancelled";
+    } else if (out_of_budget) {
+      // The next step schedules the compilation again
+      OVTF_VLOG(1) << "Background compilation of " << m_name
+                   << " postponed: " << status.error_message();
+    } else if (runtime_inputs_failed) {
+      // The next step schedules a compilation with constant static inputs
+      OVTF_VLOG(1) << "Cluster " << m_name
+                   << " can not read its static inputs at run time: "
+                   << status.error_message();
+    } else if (!status.ok() && dynamic_shapes) {
+      // The next step schedules a per-shape compilation
+      OVTF_VLOG(1) << "Cluster " << m_name
+                   << " does not support dynamic shapes, compiling per shape: "
+                   << status.error_message();
+    } else if (!status.ok()) {
+      OVTF_VLOG(1) << "Background compilation failed for " << m_name << ": "
+                   << status.error_message();
+      NGraphClusterManager::SetSignatureFallback(m_cache_owner, signature);
+    }
+    // This must be the last access to the kernel, the destructor waits for
+    // m_pending_compiles to reach zero
+    std::lock_guard<std::mutex> lock(m_exec_cache_lock_);
+    if (status.ok()) {
+      InsertExecutable(signature, bg_ng_exec);
+    } else if (dynamic_shapes && !runtime_inputs_failed && !out_of_budget &&
+               !cancelled) {
+      m_dynamic_shapes = false;
+    }
+    m_compiling.erase(signature);
+    m_pending_compiles--;
+    m_compile_done_cv.notify_all();
+    NGraphClusterManager::BackgroundCompileDone();
+  });
   return Status::OK();
 }
 
-Status NGraphEncapsulateOp::Fallback(OpKernelContext* ctx) {
-  OVTF_VLOG(1) << "Cluster " << name() << " fallback to native TF runtime ";
-  if (!NGraphClusterManager::CheckClusterFallback(m_cluster_id)) {
+bool NGraphEncapsulateOp::SignatureFellBack(const CompilationKey& signature,
+                                            SignatureLookup* lookup) {
+  if (lookup == nullptr) return false;
+  lookup->signature = signature;
+  lookup->computed = true;
+  lookup->fell_back =
+      NGraphClusterManager::CheckSignatureFallback(m_cache_owner, signature);
+  return lookup->fell_back;
+}
+
+bool NGraphEncapsulateOp::IsColdSignature(const CompilationKey& signature,
+                                          CompilationKey* cold_signature) {
+  // A warm-up compiles every signature it runs
+  if (m_tiering == nullptr || cold_signature == nullptr ||
+      m_warmup_compilation || NGraphClusterManager::IsWarmingUp()) {
+    return false;
+  }
+  if (m_tiering->RecordMiss(signature)) return false;
+  *cold_signature = signature;
+  return true;
+}
+
+Status NGraphEncapsulateOp::RunStepOnTF(OpKernelContext* ctx,
+                                        ComputeState& state) {
+  if (state.cold) {
+    Timer tf_time;
+    TF_RETURN_IF_ERROR(RunOnTF(ctx, TFStep::kChosen));
+    m_tiering->RecordTFTime(state.cold_signature, tf_time.ElapsedInMicroSec());
+    return Status::OK();
+  }
+  if (state.compile_pending) return RunOnTF(ctx, TFStep::kCompilePending);
+  if (state.lookup.fell_back) return RunOnTF(ctx, TFStep::kFallback);
+  if (!state.tf_selected) return Fallback(ctx, state);
+
+  TF_RETURN_IF_ERROR(RunOnTF(ctx, TFStep::kChosen));
+  if (state.timed_step) {
+    state.ng_exec->GetBackendSelector()->Record(
+        BackendSelector::Path::kTF, state.compute_time.ElapsedInMicroSec());
+  }
+  return Status::OK();
+}
+
+Status NGraphEncapsulateOp::Fallback(OpKernelContext* ctx,
+                                     ComputeState& state) {
+  RecordFallback(state);
+  return RunOnTF(ctx, TFStep::kFallback);
+}
+
+void NGraphEncapsulateOp::RecordFallback(ComputeState& state) {
+  if (state.lookup.computed) {
+    OVTF_VLOG(1) << "Signature " << state.lookup.signature.Hash()
+                 << " of cluster " << name()
+                 << " fallback to native TF runtime";
+    NGraphClusterManager::SetSignatureFallback(m_cache_owner,
+                                               state.lookup.signature);
+  } else {
+    OVTF_VLOG(1) << "Cluster " << name() << " fallback to native TF runtime ";
     NGraphClusterManager::SetClusterFallback(m_cluster_id, true);
-    GraphDef* graph_def = NGraphClusterManager::GetClusterGraph(m_cluster_id);
+  }
+}
+
+Status NGraphEncapsulateOp::RunOnTF(OpKernelContext* ctx, TFStep reason) {
+  profiler::TraceMe trace([this] {
+    return profiler::TraceMeEncode("OVTF::Fallback", {{"cluster", name()}});
+  });
+  if (reason == TFStep::kFallback) m_metrics->fallbacks++;
+  // The steps waiting for a compilation are kept apart, they say nothing
+  // about how the cluster fares on OpenVINO
+  LatencyHistogram& tf_latency = reason == TFStep::kCompilePending
+                                     ? m_metrics->compile_pending_latency
+                                     : m_metrics->tf_latency;
+  Timer tf_time;
+  FunctionLibraryRuntime::Handle handle;
+  Status status = GetFallbackFunction(ctx, &handle);
+  if (!status.ok()) {
+    OVTF_VLOG(2) << "Running " << name()
+                 << " in a session: " << status.error_message();
+    TF_RETURN_IF_ERROR(RunOnSession(ctx));
+    tf_latency.Record(tf_time.ElapsedInMicroSec());
+    return Status::OK();
+  }
+
+  FunctionLibraryRuntime::Options opts;
+  opts.step_id = ctx->step_id();
+  opts.rendezvous = ctx->rendezvous();
+  opts.cancellation_manager = ctx->cancellation_manager();
+  opts.step_container = ctx->step_container();
+  opts.stats_collector = ctx->stats_collector();
+  opts.collective_executor = ctx->collective_executor();
+  // The ops run on the calling thread, so that blocking it until the
+  // function is done can not starve the inter op thread pool
+  std::function<void(std::function<void()>)> inline_runner =
+      [](std::function<void()> fn) { fn(); };
+  opts.runner = &inline_runner;
+
+  std::vector<Tensor> args;
+  args.reserve(ctx->num_inputs());
+  for (int i = 0; i < ctx->num_inputs(); i++) {
+    args.push_back(ctx->input(i));
+  }
+  std::vector<Tensor> rets;
+  Notification done;
+  Status run_status;
+  ctx->function_library()->Run(opts, handle, args, &rets,
+                               [&run_status, &done](const Status& s) {
+                                 run_status = s;
+                                 done.Notify();
+                               });
+  done.WaitForNotification();
+  TF_RETURN_IF_ERROR(run_status);
+
+  TF_RETURN_IF_ERROR(SetTFOutputs(ctx, rets));
+  tf_latency.Record(tf_time.ElapsedInMicroSec());
+  return Status::OK();
+}
+
+Status NGraphEncapsulateOp::GetFallbackFunction(
+    OpKernelContext* ctx, FunctionLibraryRuntime::Handle* handle) {
+  FunctionLibraryRuntime* flr = ctx->function_library();
+  std::lock_guard<std::mutex> lock(m_fallback_lock_);
+  if (m_fallback_function_failed) {
+    return errors::Unavailable("Cluster function could not be instantiated");
+  }
+  if (flr == nullptr) {
+    return errors::Unavailable("No function library runtime");
+  }
+  if (m_fallback_flr != flr) {
+    string function_name = m_name + "_fallback";
+    Status status;
+    if (m_fallback_flib == nullptr) {
+      FunctionDef fdef;
+      status = GraphToFunctionDef(*m_graph, function_name, &fdef);
+      if (status.ok()) {
+        auto flib = std::unique_ptr<FunctionLibraryDefinition>(
+            new FunctionLibraryDefinition(m_graph->flib_def()));
+        status = flib->AddFunctionDef(fdef);
+        if (status.ok()) m_fallback_flib = std::move(flib);
+      }
+    }
+    if (status.ok()) {
+      FunctionLibraryRuntime::InstantiateOptions opts;
+      opts.lib_def = m_fallback_flib.get();
+      status = flr->Instantiate(function_name, AttrSlice(), opts,
+                                &m_fallback_handle);
+    }
+    if (!status.ok()) {
+      m_fallback_function_failed = true;
+      return status;
+    }
+    m_fallback_flr = flr;
+  }
+  *handle = m_fallback_handle;
+  return Status::OK();
+}
+
+Status NGraphEncapsulateOp::RunOnSession(OpKernelContext* ctx) {
+  std::unique_lock<std::mutex> fallback_lock(m_fallback_lock_);
+  if (m_session == nullptr) {
     SessionOptions options;
     std::shared_ptr<tensorflow::Session> session(
         tensorflow::NewSession(options));
-    Status session_create_status = session->Create(*graph_def);
+    // The graph holds the function library of the cluster
+    GraphDef session_graph_def;
+    m_graph->ToGraphDef(&session_graph_def);
+    Status session_create_status = session->Create(session_graph_def);
     if (!session_create_status.ok()) {
       return session_create_status;
     }
-    m_session = session;
 
     vector<Node*> ordered;
-    GetReversePostOrder(m_graph, &ordered, NodeComparatorName());
+    GetReversePostOrder(*m_graph, &ordered, NodeComparatorName());
 
     vector<const Node*> tf_params;
     vector<const Node*> tf_ret_vals;
@@ -689,7 +2532,10 @@ Status NGraphEncapsulateOp::Fallback(OpKernelContext* ctx) {
           output_edges[0]->src()->name() + ":" +
           std::to_string(output_edges[0]->src_output());
     }
+    // Publish the session only once the name tables are complete
+    m_session = session;
   }
+  fallback_lock.unlock();
 
   std::vector<std::pair<string, Tensor>> input_tensor_list(
       m_session_input_names.size());
@@ -706,20 +2552,31 @@ Status NGraphEncapsulateOp::Fallback(OpKernelContext* ctx) {
   if (run_status != Status::OK()) {
     return errors::Internal("Failed to run TF session for " + name());
   }
-  for (int i = 0; i < outputs.size(); i++) {
+  return SetTFOutputs(ctx, outputs);
+}
+
+Status NGraphEncapsulateOp::SetTFOutputs(OpKernelContext* ctx,
+                                         const std::vector<Tensor>& rets) {
+  for (int i = 0; i < rets.size(); i++) {
     Tensor* output_tensor = ctx->mutable_output(i);
     if (output_tensor == nullptr) {
-      ctx->set_output(i, outputs[i]);
-    } else {
-#if TF_VERSION < 2
-      std::memcpy((void*)(DMAHelper::base(output_tensor)),
-                  (void*)(DMAHelper::base(&(outputs[i]))),
-                  outputs[i].AllocatedBytes());
-#else
-      std::memcpy((void*)(output_tensor->data()), (void*)(outputs[i].data()),
-                  outputs[i].AllocatedBytes());
-#endif
+      ctx->set_output(i, rets[i]);
+      continue;
+    }
+    // Allocated by a failed attempt to run the executable, for the shape
+    // the executable inferred
+    if (output_tensor->dtype() != rets[i].dtype() ||
+        output_tensor->shape() != rets[i].shape()) {
+      return errors::Internal(
+          "Output ", i, " of cluster ", name(), " was allocated as ",
+          DataTypeString(output_tensor->dtype()), " ",
+          output_tensor->shape().DebugString(), " but TF computed ",
+          DataTypeString(rets[i].dtype()), " ", rets[i].shape().DebugString());
     }
+    auto src = rets[i].tensor_data();
+    HostCopy::Copy(const_cast<char*>(output_tensor->tensor_data().data()),
+                   src.data(), src.size());
+    m_metrics->bytes_copied += src.size();
   }
   return Status::OK();
 }
@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/tensor.pb.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/kv_cache.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+std::atomic<uint64> KVCacheState::s_generation{0};
+
+// The value of a scalar integer Const, false for the other nodes
+static bool ConstAxis(const Node* node, int& axis) {
+  if (node->type_string() != "Const") return false;
+  const TensorProto* proto;
+  Tensor value;
+  if (!GetNodeAttr(node->attrs(), "value", &proto).ok() ||
+      !value.FromProto(*proto) || value.NumElements() != 1) {
+    return false;
+  }
+  if (value.dtype() == DT_INT32) {
+    axis = value.flat<int32>()(0);
+  } else if (value.dtype() == DT_INT64) {
+    axis = value.flat<int64>()(0);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+vector<KVCacheInput> FindKVCacheInputs(const Graph& graph) {
+  vector<KVCacheInput> inputs;
+  for (const Node* node : graph.op_nodes()) {
+    if (!node->IsArg()) continue;
+    bool is_variable = false;
+    if (TryGetNodeAttr(node->attrs(), "_is_variable", &is_variable) &&
+        is_variable) {
+      continue;
+    }
+    const Node* concat = nullptr;
+    bool single_concat = true;
+    for (const Edge* edge : node->out_edges()) {
+      if (edge->IsControlEdge()) continue;
+      if (concat != nullptr || edge->dst()->type_string() != "ConcatV2" ||
+          edge->dst_input() != 0) {
+        single_concat = false;
+        break;
+      }
+      concat = edge->dst();
+    }
+    if (!single_concat || concat == nullptr) continue;
+
+    const Edge* axis_edge;
+    int axis;
+    if (!concat->input_edge(concat->num_inputs() - 1, &axis_edge).ok() ||
+        !ConstAxis(axis_edge->src(), axis)) {
+      continue;
+    }
+    int output = -1;
+    for (const Edge* edge : concat->out_edges()) {
+      if (!edge->IsControlEdge() && edge->dst()->IsRetval() &&
+          GetNodeAttr(edge->dst()->attrs(), "index", &output).ok()) {
+        break;
+      }
+    }
+    int input;
+    if (output < 0 || !GetNodeAttr(node->attrs(), "index", &input).ok()) {
+      continue;
+    }
+    OVTF_VLOG(2) << "Input " << input << " of " << concat->name()
+                 << " is a KV-cache fed back from output " << output;
+    inputs.push_back({input, output, axis});
+  }
+  return inputs;
+}
+
+string KVCacheState::VariableName(int input) {
+  return "kv_cache_" + to_string(input);
+}
+
+vector<int> KVCacheState::BeginStep(const vector<Tensor>& inputs) {
+  vector<int> stale;
+  uint64 generation = s_generation.load();
+  bool reset = generation != m_generation;
+  m_generation = generation;
+  for (int i = 0; i < m_inputs.size(); i++) {
+    const Tensor& input = inputs[m_inputs[i].input];
+    const Tensor& held = m_held[i];
+    // A buffer held is not reused for another tensor
+    if (reset || !held.IsInitialized() || held.dtype() != input.dtype() ||
+        held.shape() != input.shape() || !held.SharesBufferWith(input)) {
+      stale.push_back(i);
+    }
+    m_held[i] = Tensor();
+  }
+  return stale;
+}
+
+void KVCacheState::EndStep(const vector<Tensor>& outputs) {
+  for (int i = 0; i < m_inputs.size(); i++) {
+    m_held[i] = outputs[m_inputs[i].output];
+  }
+}
+
+void KVCacheState::Reset() { s_generation++; }
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
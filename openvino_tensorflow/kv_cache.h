@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_KV_CACHE_H_
+#define OPENVINO_TF_KV_CACHE_H_
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/graph/graph.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// A KV-cache of an autoregressive decoder cluster: input is the past keys
+// or values, which the cluster concatenates with those of the new tokens
+// along axis into output, fed back as input on the next step
+struct KVCacheInput {
+  int input;
+  int output;
+  int axis;
+
+  // axis in [0, rank)
+  int Axis(int rank) const { return axis < 0 ? axis + rank : axis; }
+};
+
+// The KV-cache inputs of a cluster graph, the _Arg read only as the first
+// input of a ConcatV2 along a constant axis, whose output is an _Retval
+std::vector<KVCacheInput> FindKVCacheInputs(const Graph& graph);
+
+// The KV-caches of an executable, held in the variables of its infer
+// request instead of being fed from TF on every step. The translation
+// replaces the past input of a cache with a ReadValue of its variable, and
+// assigns the concatenation to it, so that the executable neither binds
+// the past input nor compiles for its growing length.
+//
+// The variables hold the input of the next step as long as TF feeds back
+// the very output of the previous step, which is checked by buffer as in
+// VariableState. The others, the first step of a sequence among them, set
+// the variables from their TF inputs.
+class KVCacheState {
+ public:
+  explicit KVCacheState(std::vector<KVCacheInput> inputs)
+      : m_inputs(std::move(inputs)), m_held(m_inputs.size()) {}
+
+  const std::vector<KVCacheInput>& Inputs() const { return m_inputs; }
+
+  // The name of the variable of input
+  static std::string VariableName(int input);
+
+  // The indices in Inputs() of the caches whose variables do not hold the
+  // TF inputs of this step and have to be set from them: those which are
+  // not the outputs of the previous step, and all of them after a Reset.
+  // Forgets the outputs of the previous step, EndStep holds those of this
+  // one once it succeeded.
+  std::vector<int> BeginStep(const std::vector<Tensor>& inputs);
+  void EndStep(const std::vector<Tensor>& outputs);
+
+  // Makes every KV-cache set its variables from TF on its next step, e.g.
+  // before decoding a new sequence fed with a non empty past
+  static void Reset();
+
+ private:
+  std::vector<KVCacheInput> m_inputs;
+  // The outputs of the last step, which the variables hold
+  std::vector<Tensor> m_held;
+  uint64 m_generation = 0;
+  static std::atomic<uint64> s_generation;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_KV_CACHE_H_
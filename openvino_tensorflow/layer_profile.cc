@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+#include "tensorflow/core/profiler/lib/traceme.h"
+#include "tensorflow/core/profiler/lib/traceme_encode.h"
+
+#include "openvino_tensorflow/ovtf_version_utils.h"
+#if TF_VERSION_GEQ(2, 8)
+#include "tensorflow/core/profiler/backends/cpu/traceme_recorder.h"
+#else
+#include "tensorflow/core/profiler/internal/cpu/traceme_recorder.h"
+#endif
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/layer_profile.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+bool LayerProfile::Enabled() {
+  static const bool enabled =
+      util::GetEnv("OPENVINO_TF_PROFILE_LAYERS") == "1";
+  return enabled;
+}
+
+string LayerProfile::TFNodeName(const string& layer) {
+  size_t pos = layer.rfind('/');
+  if (pos == string::npos || pos == 0) return layer;
+  return layer.substr(0, pos);
+}
+
+vector<LayerProfile::Event> LayerProfile::Layout(
+    const vector<ov::ProfilingInfo>& info, int64_t start_ns, int64_t end_ns) {
+  vector<Event> events;
+  int64_t time_ns = start_ns;
+  for (const auto& layer : info) {
+    if (layer.status == ov::ProfilingInfo::Status::NOT_RUN) continue;
+    if (time_ns >= end_ns) break;
+    Event event;
+    event.tf_node = TFNodeName(layer.node_name);
+    event.layer = layer.node_name;
+    event.layer_type = layer.node_type;
+    event.exec_type = layer.exec_type;
+    event.start_ns = time_ns;
+    int64_t duration_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(layer.real_time)
+            .count();
+    time_ns = std::min(end_ns, time_ns + std::max<int64_t>(duration_ns, 0));
+    event.end_ns = time_ns;
+    events.push_back(std::move(event));
+  }
+  return events;
+}
+
+void LayerProfile::Record(const string& cluster, ov::InferRequest& request,
+                          int64_t start_ns, int64_t end_ns) {
+  bool tracing = profiler::TraceMe::Active();
+  if (!tracing && !OVTF_VLOG_IS_ON(2)) return;
+
+  vector<Event> events;
+  try {
+    events = Layout(request.get_profiling_info(), start_ns, end_ns);
+  } catch (const std::exception& e) {
+    OVTF_VLOG(2) << "No layer counters for " << cluster << ": " << e.what();
+    return;
+  }
+
+  if (tracing) {
+    for (auto& event : events) {
+      profiler::TraceMeRecorder::Event trace_event;
+      trace_event.name = profiler::TraceMeEncode(
+          event.tf_node, {{"cluster", cluster},
+                          {"layer", event.layer},
+                          {"layer_type", event.layer_type},
+                          {"exec_type", event.exec_type}});
+      trace_event.start_time = event.start_ns;
+      trace_event.end_time = event.end_ns;
+      profiler::TraceMeRecorder::Record(std::move(trace_event));
+    }
+  }
+
+  if (OVTF_VLOG_IS_ON(2)) {
+    // The time spent in every TF op of the cluster
+    map<string, int64_t> tf_node_ns;
+    for (const auto& event : events) {
+      tf_node_ns[event.tf_node] += event.end_ns - event.start_ns;
+    }
+    for (const auto& node : tf_node_ns) {
+      OVTF_VLOG(2) << "Layer profile " << cluster << ": " << node.first << " "
+                   << node.second / 1000 << " us";
+    }
+  }
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,57 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_LAYER_PROFILE_H_
+#define OPENVINO_TF_LAYER_PROFILE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "openvino/openvino.hpp"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Reports the per layer counters of the OpenVINO plugins to the TF profiler.
+//
+// Builder::SetTracingInfo names every OpenVINO op "<tf op>/<ov op>", which
+// the plugins keep as the name of the layers they execute, so every layer
+// is reported under the TF op it was translated from. The plugins only
+// report the duration of the layers, which are laid out one after the other
+// from the start of the inference.
+class LayerProfile {
+ public:
+  struct Event {
+    std::string tf_node;
+    std::string layer;
+    std::string layer_type;
+    std::string exec_type;
+    int64_t start_ns;
+    int64_t end_ns;
+  };
+
+  // Whether OPENVINO_TF_PROFILE_LAYERS enables the per layer counters
+  static bool Enabled();
+
+  // The TF op a layer was translated from, the layer name itself when it
+  // does not come from a translated op
+  static std::string TFNodeName(const std::string& layer);
+
+  // The events of the layers which ran, laid out from start_ns and clipped
+  // to end_ns
+  static std::vector<Event> Layout(const std::vector<ov::ProfilingInfo>& info,
+                                   int64_t start_ns, int64_t end_ns);
+
+  // Records the layers of a finished inference of cluster in the TF
+  // profiler, when it is tracing
+  static void Record(const std::string& cluster, ov::InferRequest& request,
+                     int64_t start_ns, int64_t end_ns);
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_LAYER_PROFILE_H_
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_LRU_CACHE_H_
+#define OPENVINO_TF_LRU_CACHE_H_
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// A fixed capacity least-recently-used cache. Lookups, insertions and
+// evictions are O(1): the entries live in a recency ordered list and the
+// map points at the list nodes. The cache is not thread safe.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LRUCache {
+ public:
+  explicit LRUCache(size_t capacity) : m_capacity(capacity) {}
+
+  // Returns true and sets value if key is cached. The entry becomes the
+  // most recently used one.
+  bool Lookup(const Key& key, Value& value) {
+    auto it = m_map.find(key);
+    if (it == m_map.end()) return false;
+    if (it->second != m_lru.begin()) {
+      m_lru.splice(m_lru.begin(), m_lru, it->second);
+    }
+    value = it->second->second;
+    return true;
+  }
+
+  // Inserts key as the most recently used entry, replacing any previous
+  // value for it. Entries evicted to respect the capacity are appended to
+  // evicted when it is not null.
+  void Insert(const Key& key, Value value,
+              std::vector<Value>* evicted = nullptr) {
+    auto it = m_map.find(key);
+    if (it != m_map.end()) {
+      it->second->second = std::move(value);
+      m_lru.splice(m_lru.begin(), m_lru, it->second);
+      return;
+    }
+    m_lru.emplace_front(key, std::move(value));
+    m_map[key] = m_lru.begin();
+    EvictToCapacity(evicted);
+  }
+
+  bool Erase(const Key& key) {
+    auto it = m_map.find(key);
+    if (it == m_map.end()) return false;
+    m_lru.erase(it->second);
+    m_map.erase(it);
+    return true;
+  }
+
+  void SetCapacity(size_t capacity, std::vector<Value>* evicted = nullptr) {
+    m_capacity = capacity;
+    EvictToCapacity(evicted);
+  }
+
+  size_t Capacity() const { return m_capacity; }
+  size_t Size() const { return m_map.size(); }
+
+  void Clear() {
+    m_map.clear();
+    m_lru.clear();
+  }
+
+  // Calls fn(key, value) for every entry, from the most to the least
+  // recently used
+  template <typename Fn>
+  void ForEach(Fn fn) const {
+    for (const auto& entry : m_lru) {
+      fn(entry.first, entry.second);
+    }
+  }
+
+ private:
+  using Entry = std::pair<Key, Value>;
+
+  void EvictToCapacity(std::vector<Value>* evicted) {
+    while (m_map.size() > m_capacity && !m_lru.empty()) {
+      auto& entry = m_lru.back();
+      if (evicted != nullptr) evicted->push_back(std::move(entry.second));
+      m_map.erase(entry.first);
+      m_lru.pop_back();
+    }
+  }
+
+  size_t m_capacity;
+  std::list<Entry> m_lru;
+  std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> m_map;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_LRU_CACHE_H_
@@ -4,15 +4,24 @@
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
 
+#include "tensorflow/core/common_runtime/function.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/function.h"
+#include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/graph/graph.h"
 
+#include "openvino/opsets/opset8.hpp"
+
 #include "api.h"
 #include "backend_manager.h"
 #include "openvino_tensorflow/default_opset.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
+#include "openvino_tensorflow/op_support.h"
 #include "openvino_tensorflow/ovtf_utils.h"
 #include "openvino_tensorflow/ovtf_version_utils.h"
 
+#include "ocm/include/ocm_nodes_checker.h"
+
 using namespace std;
 
 namespace tensorflow {
@@ -127,6 +136,8 @@ const std::map<std::string, SetAttributesFunction>& GetAttributeSetters() {
     set_attributes_map["ArgMax"] = SetStaticInputs({1});
     set_attributes_map["ArgMin"] = SetStaticInputs({1});
     set_attributes_map["BatchToSpaceND"] = SetStaticInputs({1});
+    set_attributes_map["CombinedNonMaxSuppression"] =
+        SetStaticInputs({2, 3, 4, 5});
     set_attributes_map["ConcatV2"] = SetStaticInputs({-1});
     set_attributes_map["Conv2DBackpropInput"] = SetStaticInputs({0});
     set_attributes_map["CropAndResize"] = SetStaticInputs({1, 2, 3});
@@ -139,10 +150,13 @@ const std::map<std::string, SetAttributesFunction>& GetAttributeSetters() {
     set_attributes_map["MirrorPad"] = SetStaticInputs({1});
     set_attributes_map["NonMaxSuppressionV2"] = SetStaticInputs({2});
     set_attributes_map["NonMaxSuppressionV3"] = SetStaticInputs({2});
+    set_attributes_map["NonMaxSuppressionV4"] = SetStaticInputs({2});
+    set_attributes_map["NonMaxSuppressionV5"] = SetStaticInputs({2});
     set_attributes_map["OneHot"] = SetStaticInputs({1});
     set_attributes_map["Pad"] = SetStaticInputs({1});
     set_attributes_map["PadV2"] = SetStaticInputs({1});
     set_attributes_map["Prod"] = SetStaticInputs({1});
+    set_attributes_map["QuantizeAndDequantizeV3"] = SetStaticInputs({3});
     set_attributes_map["Reshape"] = SetStaticInputs({1});
     set_attributes_map["ScatterNd"] = SetStaticInputs({2});
     set_attributes_map["Slice"] = SetStaticInputs({1, 2});
@@ -192,8 +206,27 @@ GetTFToNgOpMap() {
       {"BiasAdd",
        {constant, std::make_shared<opset::Add>(),
         std::make_shared<opset::Reshape>()}},
+      {"BlockLSTM",
+       {constant, std::make_shared<opset::LSTMSequence>(),
+        std::make_shared<opset::TensorIterator>(),
+        std::make_shared<opset::MatMul>(), std::make_shared<opset::Sigmoid>(),
+        std::make_shared<opset::Tanh>()}},
+      {"BlockLSTMV2",
+       {constant, std::make_shared<opset::LSTMSequence>(),
+        std::make_shared<opset::TensorIterator>(),
+        std::make_shared<opset::MatMul>(), std::make_shared<opset::Sigmoid>(),
+        std::make_shared<opset::Tanh>()}},
       {"Cast", {std::make_shared<opset::Convert>()}},
       {"Ceil", {std::make_shared<opset::Ceiling>()}},
+      {"CombinedNonMaxSuppression",
+       {constant, std::make_shared<opset::MulticlassNms>(),
+        std::make_shared<opset::Squeeze>(),
+        std::make_shared<opset::Transpose>(), std::make_shared<opset::Concat>(),
+        std::make_shared<opset::CumSum>(), std::make_shared<opset::ReduceSum>(),
+        std::make_shared<opset::Less>(), std::make_shared<opset::Select>(),
+        std::make_shared<opset::Gather>(),
+        std::make_shared<opset::VariadicSplit>(),
+        std::make_shared<opset::Clamp>(), std::make_shared<opset::Convert>()}},
       {"ConcatV2", {std::make_shared<opset::Concat>()}},
       {"Const", {constant}},
       {"Conv2D",
@@ -209,11 +242,23 @@ GetTFToNgOpMap() {
       {"Cosh", {std::make_shared<opset::Cosh>()}},
       {"Cumsum", {std::make_shared<opset::CumSum>()}},
       {"DepthToSpace", {std::make_shared<opset::DepthToSpace>()}},
+      {"Dequantize",
+       {constant, std::make_shared<opset::Convert>(),
+        std::make_shared<opset::Subtract>(),
+        std::make_shared<opset::Multiply>(), std::make_shared<opset::Add>(),
+        std::make_shared<opset::Maximum>(),
+        std::make_shared<opset::Divide>(), std::make_shared<opset::Reshape>(),
+        std::make_shared<opset::FakeQuantize>()}},
       {"DepthwiseConv2dNative",
        {std::make_shared<opset::GroupConvolution>(), constant}},
       {"Equal", {std::make_shared<opset::Equal>()}},
+      {"Erf", {std::make_shared<opset::Erf>()}},
       {"Exp", {std::make_shared<opset::Exp>()}},
       {"ExpandDims", {std::make_shared<opset::Unsqueeze>()}},
+      {"FakeQuantWithMinMaxArgs",
+       {constant, std::make_shared<opset::FakeQuantize>()}},
+      {"FakeQuantWithMinMaxVarsPerChannel",
+       {std::make_shared<opset::FakeQuantize>()}},
       {"Fill", {constant, std::make_shared<opset::Broadcast>()}},
       {"Floor", {std::make_shared<opset::Floor>()}},
       {"FloorDiv",
@@ -229,6 +274,10 @@ GetTFToNgOpMap() {
         std::make_shared<opset::Transpose>()}},
       {"Gather", {constant, std::make_shared<opset::Gather>()}},
       {"GatherV2", {constant, std::make_shared<opset::Gather>()}},
+      {"GRUBlockCell",
+       {constant, std::make_shared<opset::GRUCell>(),
+        std::make_shared<opset::MatMul>(), std::make_shared<opset::Sigmoid>(),
+        std::make_shared<opset::Tanh>()}},
       {"_FusedConv2D",
        {std::make_shared<opset::Convolution>(), constant,
         std::make_shared<opset::Minimum>(), std::make_shared<opset::Relu>(),
@@ -241,6 +290,7 @@ GetTFToNgOpMap() {
       {"Greater", {std::make_shared<opset::Greater>()}},
       {"GreaterEqual", {std::make_shared<opset::GreaterEqual>()}},
       {"Identity", {}},
+      {"If", {std::make_shared<ov::opset8::If>()}},
       {"IsFinite",
        {constant, std::make_shared<opset::NotEqual>(),
         std::make_shared<opset::Equal>(),
@@ -265,6 +315,10 @@ GetTFToNgOpMap() {
       {"LogicalNot", {std::make_shared<opset::LogicalNot>()}},
       {"LogicalOr", {std::make_shared<opset::LogicalOr>()}},
       {"LRN", {std::make_shared<opset::LRN>()}},
+      {"LSTMBlockCell",
+       {constant, std::make_shared<opset::LSTMCell>(),
+        std::make_shared<opset::MatMul>(), std::make_shared<opset::Sigmoid>(),
+        std::make_shared<opset::Tanh>()}},
       {"MatMul", {std::make_shared<opset::MatMul>()}},
       {"Max", {std::make_shared<opset::ReduceMax>(), constant}},
       {"Maximum", {std::make_shared<opset::Maximum>()}},
@@ -286,6 +340,18 @@ GetTFToNgOpMap() {
        {std::make_shared<opset::NonMaxSuppression>(), constant,
         std::make_shared<opset::Unsqueeze>(),
         std::make_shared<opset::StridedSlice>()}},
+      {"NonMaxSuppressionV4",
+       {std::make_shared<opset::NonMaxSuppression>(), constant,
+        std::make_shared<opset::Unsqueeze>(),
+        std::make_shared<opset::StridedSlice>(),
+        std::make_shared<opset::Concat>(), std::make_shared<opset::Gather>(),
+        std::make_shared<opset::Squeeze>()}},
+      {"NonMaxSuppressionV5",
+       {std::make_shared<opset::NonMaxSuppression>(), constant,
+        std::make_shared<opset::Unsqueeze>(),
+        std::make_shared<opset::StridedSlice>(),
+        std::make_shared<opset::Concat>(), std::make_shared<opset::Gather>(),
+        std::make_shared<opset::Squeeze>()}},
       {"OneHot", {std::make_shared<opset::OneHot>(), constant}},
       {"Pack",
        {constant, std::make_shared<opset::Concat>(),
@@ -294,6 +360,26 @@ GetTFToNgOpMap() {
       {"PadV2", {constant, std::make_shared<opset::Pad>()}},
       {"Pow", {std::make_shared<opset::Power>()}},
       {"Prod", {std::make_shared<opset::ReduceProd>(), constant}},
+      {"QuantizeAndDequantizeV2",
+       {constant, std::make_shared<opset::FakeQuantize>(),
+        std::make_shared<opset::ReduceMin>(),
+        std::make_shared<opset::ReduceMax>(),
+        std::make_shared<opset::Select>(), std::make_shared<opset::Divide>()}},
+      {"QuantizeAndDequantizeV3",
+       {constant, std::make_shared<opset::FakeQuantize>(),
+        std::make_shared<opset::ReduceMin>(),
+        std::make_shared<opset::ReduceMax>(),
+        std::make_shared<opset::Select>(), std::make_shared<opset::Divide>()}},
+      {"QuantizeAndDequantizeV4",
+       {constant, std::make_shared<opset::FakeQuantize>(),
+        std::make_shared<opset::ReduceMin>(),
+        std::make_shared<opset::ReduceMax>(),
+        std::make_shared<opset::Select>(), std::make_shared<opset::Divide>()}},
+      {"QuantizeV2",
+       {constant, std::make_shared<opset::FakeQuantize>(),
+        std::make_shared<opset::Convert>(), std::make_shared<opset::Maximum>(),
+        std::make_shared<opset::Minimum>(), std::make_shared<opset::Select>(),
+        std::make_shared<opset::Divide>()}},
       {"Range", {std::make_shared<opset::Range>()}},
       {"Rank", {constant}},
       {"RealDiv", {std::make_shared<opset::Divide>()}},
@@ -315,12 +401,59 @@ GetTFToNgOpMap() {
       {"Softmax", {std::make_shared<opset::Softmax>()}},
       {"Softplus", {std::make_shared<opset::SoftPlus>()}},
       {"SpaceToDepth", {std::make_shared<opset::SpaceToDepth>()}},
+      {"SparseSegmentMean",
+       {constant, std::make_shared<opset::EmbeddingSegmentsSum>(),
+        std::make_shared<opset::ReduceMax>(), std::make_shared<opset::Add>(),
+        std::make_shared<opset::Convert>(),
+        std::make_shared<opset::Broadcast>(),
+        std::make_shared<opset::ShapeOf>(), std::make_shared<opset::Maximum>(),
+        std::make_shared<opset::Reshape>(), std::make_shared<opset::Divide>()}},
+      {"SparseSegmentMeanWithNumSegments",
+       {constant, std::make_shared<opset::EmbeddingSegmentsSum>(),
+        std::make_shared<opset::ReduceMax>(), std::make_shared<opset::Add>(),
+        std::make_shared<opset::Convert>(),
+        std::make_shared<opset::Broadcast>(),
+        std::make_shared<opset::ShapeOf>(), std::make_shared<opset::Maximum>(),
+        std::make_shared<opset::Reshape>(), std::make_shared<opset::Divide>()}},
+      {"SparseSegmentSqrtN",
+       {constant, std::make_shared<opset::EmbeddingSegmentsSum>(),
+        std::make_shared<opset::ReduceMax>(), std::make_shared<opset::Add>(),
+        std::make_shared<opset::Convert>(),
+        std::make_shared<opset::Broadcast>(),
+        std::make_shared<opset::ShapeOf>(), std::make_shared<opset::Maximum>(),
+        std::make_shared<opset::Reshape>(), std::make_shared<opset::Divide>(),
+        std::make_shared<opset::Sqrt>()}},
+      {"SparseSegmentSqrtNWithNumSegments",
+       {constant, std::make_shared<opset::EmbeddingSegmentsSum>(),
+        std::make_shared<opset::ReduceMax>(), std::make_shared<opset::Add>(),
+        std::make_shared<opset::Convert>(),
+        std::make_shared<opset::Broadcast>(),
+        std::make_shared<opset::ShapeOf>(), std::make_shared<opset::Maximum>(),
+        std::make_shared<opset::Reshape>(), std::make_shared<opset::Divide>(),
+        std::make_shared<opset::Sqrt>()}},
+      {"SparseSegmentSum",
+       {constant, std::make_shared<opset::EmbeddingSegmentsSum>(),
+        std::make_shared<opset::ReduceMax>(), std::make_shared<opset::Add>(),
+        std::make_shared<opset::Convert>()}},
+      {"SparseSegmentSumWithNumSegments",
+       {constant, std::make_shared<opset::EmbeddingSegmentsSum>(),
+        std::make_shared<opset::ReduceMax>(), std::make_shared<opset::Add>(),
+        std::make_shared<opset::Convert>()}},
+      {"SparseTensorDenseMatMul",
+       {constant, std::make_shared<opset::Convert>(),
+        std::make_shared<opset::Gather>(), std::make_shared<opset::Transpose>(),
+        std::make_shared<opset::Multiply>(),
+        std::make_shared<opset::Unsqueeze>(),
+        std::make_shared<opset::ShapeOf>(), std::make_shared<opset::Range>(),
+        std::make_shared<opset::EmbeddingSegmentsSum>()}},
       {"Split", {std::make_shared<opset::Split>(), constant}},
       {"SplitV", {std::make_shared<opset::VariadicSplit>(), constant}},
       {"Sqrt", {std::make_shared<opset::Sqrt>()}},
       {"Square", {std::make_shared<opset::Multiply>()}},
       {"SquaredDifference", {std::make_shared<opset::SquaredDifference>()}},
       {"Squeeze", {std::make_shared<opset::Squeeze>(), constant}},
+      {"StatelessIf", {std::make_shared<ov::opset8::If>()}},
+      {"StatelessWhile", {constant, std::make_shared<opset::Loop>()}},
       {"StridedSlice", {constant, std::make_shared<opset::StridedSlice>()}},
       {"Sub", {std::make_shared<opset::Subtract>()}},
       {"Sum", {std::make_shared<opset::ReduceSum>(), constant}},
@@ -332,6 +465,7 @@ GetTFToNgOpMap() {
       {"Where",
        {std::make_shared<opset::NonZero>(),
         std::make_shared<opset::Transpose>()}},
+      {"While", {constant, std::make_shared<opset::Loop>()}},
       {"Xdivy",
        {constant, std::make_shared<opset::Divide>(),
         std::make_shared<opset::Equal>(), std::make_shared<opset::Select>()}},
@@ -393,5 +527,315 @@ Status GetStaticInputs(Graph* graph, std::vector<int32>* static_input_indexes) {
   return Status::OK();
 }
 
+// The attributes naming the functions called by the functional control flow
+// op n, null if n is not one
+static const std::vector<std::string>* GetFunctionAttrs(const Node* n) {
+  static const std::map<std::string, std::vector<std::string>> function_attrs{
+      {"If", {"then_branch", "else_branch"}},
+      {"StatelessIf", {"then_branch", "else_branch"}},
+      {"StatelessWhile", {"cond", "body"}},
+      {"While", {"cond", "body"}},
+  };
+  auto it = function_attrs.find(n->type_string());
+  return it == function_attrs.end() ? nullptr : &it->second;
+}
+
+static Status GetSupportedNodes(Graph* graph,
+                                const FunctionLibraryDefinition& flib,
+                                const std::string& ov_version,
+                                const std::set<std::string>& disabled_ops,
+                                std::vector<Node*>& supported_nodes);
+
+bool IsFunctionalControlFlow(const Node* n) {
+  return GetFunctionAttrs(n) != nullptr;
+}
+
+// The functional control flow op is translated whole, as an OpenVINO If or
+// Loop: every value it passes must be a tensor, and every op of the functions
+// it calls must be supported, with its static inputs computed by a constant
+// of the function
+bool FunctionalOpIsSupported(const Node* n,
+                             const FunctionLibraryDefinition& flib,
+                             const std::string& ov_version,
+                             const std::set<std::string>& disabled_ops) {
+  for (const auto& types : {n->input_types(), n->output_types()}) {
+    for (DataType dtype : types) {
+      ov::element::Type ng_et;
+      if (!util::TFDataTypeToNGraphElementType(dtype, &ng_et).ok()) {
+        OVTF_VLOG(1) << n->name() << " passes a value of type "
+                     << DataTypeString(dtype);
+        return false;
+      }
+    }
+  }
+
+  const auto& set_attributes_map = GetAttributeSetters();
+  for (const auto& attr : *GetFunctionAttrs(n)) {
+    NameAttrList func;
+    std::unique_ptr<FunctionBody> fbody;
+    Status status = GetNodeAttr(n->attrs(), attr, &func);
+    const FunctionDef* fdef = status.ok() ? flib.Find(func.name()) : nullptr;
+    if (fdef != nullptr) {
+      status = FunctionDefToBodyHelper(*fdef, AttrSlice(&func.attr()), &flib,
+                                       &fbody);
+    }
+    std::vector<Node*> supported_nodes;
+    if (fdef != nullptr && status.ok()) {
+      status = GetSupportedNodes(fbody->graph, flib, ov_version, disabled_ops,
+                                 supported_nodes);
+    }
+    if (fdef == nullptr || !status.ok()) {
+      OVTF_VLOG(1) << "Can not check the " << attr << " function of "
+                   << n->name() << ": " << status.error_message();
+      return false;
+    }
+
+    std::set<Node*> supported(supported_nodes.begin(), supported_nodes.end());
+    for (Node* node : fbody->graph->op_nodes()) {
+      if (node->IsArg() || node->IsRetval() || node->IsNoOp()) continue;
+      if (supported.count(node) == 0) {
+        OVTF_VLOG(1) << "The " << attr << " function of " << n->name()
+                     << " calls the unsupported op " << node->name() << " ("
+                     << node->type_string() << ")";
+        return false;
+      }
+      auto it = set_attributes_map.find(node->type_string());
+      if (it == set_attributes_map.end()) continue;
+      std::vector<int32> static_inputs;
+      if (it->second(node).ok()) GetStaticInputs(node, &static_inputs);
+      for (int32 index : static_inputs) {
+        Node* input;
+        if (!node->input_node(index, &input).ok() ||
+            input->type_string() != "Const") {
+          OVTF_VLOG(1) << "The " << attr << " function of " << n->name()
+                       << " computes the static input " << index << " of "
+                       << node->name();
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+static bool HasFloatType(const Node* n, const char* attr) {
+  DataType dtype;
+  if (!GetNodeAttr(n->attrs(), attr, &dtype).ok()) return false;
+  return dtype == DT_FLOAT || dtype == DT_HALF;
+}
+
+// The quantization ops of 8 bit integers, in the modes the builder
+// translates
+static bool QuantizationOpIsSupported(const Node* n) {
+  DataType dtype;
+  std::string mode;
+  if (!GetNodeAttr(n->attrs(), "T", &dtype).ok() ||
+      !GetNodeAttr(n->attrs(), "mode", &mode).ok()) {
+    return false;
+  }
+  if (n->type_string() == "Dequantize") {
+    DataType output_dtype;
+    if (!GetNodeAttr(n->attrs(), "dtype", &output_dtype).ok() ||
+        output_dtype != DT_FLOAT) {
+      return false;
+    }
+  }
+  return (dtype == DT_QINT8 || dtype == DT_QUINT8) &&
+         (mode == "MIN_COMBINED" || mode == "SCALED");
+}
+
+// The products of the sparse matrices the builder translates, those which
+// are not transposed
+static bool SparseMatMulIsSupported(const Node* n) {
+  bool adjoint_a;
+  return HasFloatType(n, "T") &&
+         GetNodeAttr(n->attrs(), "adjoint_a", &adjoint_a).ok() && !adjoint_a;
+}
+
+// The value of input index of n if it is a scalar integer Const
+static bool GetConstScalar(const Node* n, int index, int64& value) {
+  const Node* input;
+  const TensorProto* proto;
+  Tensor tensor;
+  if (!n->input_node(index, &input).ok() || input->type_string() != "Const" ||
+      !GetNodeAttr(input->attrs(), "value", &proto).ok() ||
+      !tensor.FromProto(*proto) || tensor.NumElements() != 1) {
+    return false;
+  }
+  if (tensor.dtype() == DT_INT32) {
+    value = tensor.flat<int32>()(0);
+    return true;
+  }
+  if (tensor.dtype() == DT_INT64) {
+    value = tensor.flat<int64>()(0);
+    return true;
+  }
+  return false;
+}
+
+// The CombinedNonMaxSuppression the builder translates, whose limit of
+// boxes per class does not bind since it is not below their total. The
+// sizes fed at run time are checked by the translation.
+static bool CombinedNMSIsSupported(const Node* n) {
+  int64 per_class, total;
+  if (!GetConstScalar(n, 2, per_class) || !GetConstScalar(n, 3, total)) {
+    return true;
+  }
+  return per_class >= total;
+}
+
+// The ops the builder translates which the op capability manager does not
+// know: the fused recurrent ops, translated into the OpenVINO sequence and
+// cell ops, the quantization ops, translated into FakeQuantize, the sparse
+// embedding ops, translated into EmbeddingSegmentsSum, and the batched and
+// padded NMS of the detection heads
+static const std::map<std::string, std::function<bool(const Node*)>>&
+BuilderOnlyOps() {
+  static const auto* ops = []() {
+    auto float_op = [](const Node* n) { return HasFloatType(n, "T"); };
+    // Their op defs only take float inputs
+    auto float_input = [](const Node*) { return true; };
+    auto* ops = new std::map<std::string, std::function<bool(const Node*)>>{
+        {"BlockLSTM", float_op},
+        {"BlockLSTMV2", float_op},
+        {"CombinedNonMaxSuppression", CombinedNMSIsSupported},
+        {"Dequantize", QuantizationOpIsSupported},
+        {"FakeQuantWithMinMaxArgs", float_input},
+        {"FakeQuantWithMinMaxVarsPerChannel", float_input},
+        {"GRUBlockCell", float_op},
+        {"LSTMBlockCell", float_op},
+        {"NonMaxSuppressionV4", float_op},
+        {"NonMaxSuppressionV5", float_op},
+        {"QuantizeAndDequantizeV2", float_op},
+        {"QuantizeAndDequantizeV3", float_op},
+        {"QuantizeAndDequantizeV4", float_op},
+        {"QuantizeV2", QuantizationOpIsSupported},
+        {"SparseSegmentMean", float_op},
+        {"SparseSegmentMeanWithNumSegments", float_op},
+        {"SparseSegmentSqrtN", float_op},
+        {"SparseSegmentSqrtNWithNumSegments", float_op},
+        {"SparseSegmentSum", float_op},
+        {"SparseSegmentSumWithNumSegments", float_op},
+        {"SparseTensorDenseMatMul", SparseMatMulIsSupported}};
+    return ops;
+  }();
+  return *ops;
+}
+
+Status GetNodesSupportedByBackend(Graph* graph, const std::string& ov_version,
+                                  const std::set<std::string>& disabled_ops,
+                                  std::vector<Node*>& supported_nodes) {
+  return GetSupportedNodes(graph, graph->flib_def(), ov_version, disabled_ops,
+                           supported_nodes);
+}
+
+static Status GetSupportedNodes(Graph* graph,
+                                const FunctionLibraryDefinition& flib,
+                                const std::string& ov_version,
+                                const std::set<std::string>& disabled_ops,
+                                std::vector<Node*>& supported_nodes) {
+  std::vector<std::string> devices;
+  bool require_all = true;
+  TF_RETURN_IF_ERROR(BackendManager::GetBackendDevices(devices, require_all));
+
+  // The signatures repeat across graphs and retraces, so the decisions of
+  // the op capability manager are cached by them. It only runs when the
+  // graph holds a signature it did not decide on yet.
+  std::vector<std::pair<Node*, uint64>> signatures;
+  for (Node* node : graph->op_nodes()) {
+    signatures.emplace_back(node, OpSupport::NodeSignature(node));
+  }
+  std::string disabled;
+  for (const auto& op : disabled_ops) disabled += op + ",";
+
+  // The number of devices supporting each node
+  std::map<Node*, int> support_count;
+  for (const auto& device : devices) {
+    std::string context = device + ";" + ov_version + ";" + disabled;
+    std::vector<Node*> marked;
+    bool known = true;
+    for (const auto& node : signatures) {
+      bool supported = false;
+      if (!OpSupport::LookupNodeSupport(context, node.second, supported)) {
+        known = false;
+        break;
+      }
+      if (supported) marked.push_back(node.first);
+    }
+    if (!known) {
+      ocm::Framework_Names fName = ocm::Framework_Names::TF;
+      ocm::FrameworkNodesChecker FC(fName, device.c_str(), ov_version, graph);
+      FC.SetDisabledOps(disabled_ops);
+      marked.clear();
+      for (auto void_node : FC.MarkSupportedNodes()) {
+        marked.push_back((Node*)void_node);
+      }
+      // A signature is supported if all of its nodes are
+      std::set<Node*> marked_set(marked.begin(), marked.end());
+      std::map<uint64, bool> decisions;
+      for (const auto& node : signatures) {
+        bool supported = marked_set.count(node.first) > 0;
+        auto it = decisions.find(node.second);
+        if (it == decisions.end()) {
+          decisions[node.second] = supported;
+        } else {
+          it->second = it->second && supported;
+        }
+      }
+      for (const auto& decision : decisions) {
+        OpSupport::SetNodeSupport(context, decision.first, decision.second);
+      }
+    }
+    for (Node* node : marked) {
+      // The ops the device reported it does not support when it was queried
+      // for the clusters compiled so far
+      if (OpSupport::IsTFUnsupported(device, OpSupport::TFSignature(node))) {
+        OVTF_VLOG(1) << device << " does not support " << node->name();
+        continue;
+      }
+      support_count[node]++;
+    }
+  }
+
+  // Keep the graph order, the attribute setters do not depend on it but
+  // the placement log does
+  supported_nodes.clear();
+  for (Node* node : graph->nodes()) {
+    // The functional control flow ops are not known to the op capability
+    // manager, they are supported when the functions they call are. Neither
+    // are some of the ops the builder translates.
+    bool functional = IsFunctionalControlFlow(node);
+    auto builder_op = BuilderOnlyOps().find(node->type_string());
+    if ((functional || builder_op != BuilderOnlyOps().end()) &&
+        !support_count.count(node)) {
+      bool unsupported =
+          disabled_ops.count(node->type_string()) > 0 ||
+          std::any_of(devices.begin(), devices.end(),
+                      [node](const std::string& device) {
+                        return OpSupport::IsTFUnsupported(
+                            device, OpSupport::TFSignature(node));
+                      });
+      if (!unsupported &&
+          (functional ? FunctionalOpIsSupported(node, flib, ov_version,
+                                                disabled_ops)
+                      : builder_op->second(node))) {
+        supported_nodes.push_back(node);
+      }
+      continue;
+    }
+    auto it = support_count.find(node);
+    if (it == support_count.end()) continue;
+    if (!require_all || it->second == devices.size()) {
+      supported_nodes.push_back(node);
+    }
+  }
+  if (devices.size() > 1) {
+    OVTF_VLOG(1) << supported_nodes.size() << " nodes supported by "
+                 << (require_all ? "all" : "any") << " of " << devices.size()
+                 << " devices";
+  }
+  return Status::OK();
+}
+
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -8,6 +8,7 @@
 #ifndef OPENVINO_TF_MARK_FOR_CLUSTERING_H_
 #define OPENVINO_TF_MARK_FOR_CLUSTERING_H_
 
+#include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/graph/graph.h"
 
 #include "openvino_tensorflow/backend.h"
@@ -38,6 +39,25 @@ const std::map<std::string, SetAttributesFunction>& GetAttributeSetters();
 const std::map<std::string, std::set<std::shared_ptr<ov::Node>>>&
 GetTFToNgOpMap();
 
+// Returns the nodes of the graph the op capability manager reports as
+// supported by the backend. With several devices, as for MULTI, HETERO and
+// AUTO, every device is checked and the results are combined as required
+// by the backend.
+Status GetNodesSupportedByBackend(Graph* graph, const std::string& ov_version,
+                                  const std::set<std::string>& disabled_ops,
+                                  std::vector<Node*>& supported_nodes);
+
+// Whether n is a functional control flow op: If, While or their stateless
+// versions
+bool IsFunctionalControlFlow(const Node* n);
+
+// Whether the functional control flow op n can be translated whole, together
+// with the functions of flib it calls
+bool FunctionalOpIsSupported(const Node* n,
+                             const FunctionLibraryDefinition& flib,
+                             const std::string& ov_version,
+                             const std::set<std::string>& disabled_ops);
+
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
 
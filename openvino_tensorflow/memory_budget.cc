@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <sstream>
+
+#include "openvino/runtime/intel_gpu/properties.hpp"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/backend.h"
+#include "openvino_tensorflow/memory_budget.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+std::map<std::string, size_t> MemoryBudget::s_budgets;
+bool MemoryBudget::s_configured = false;
+std::mutex MemoryBudget::s_mutex;
+
+void MemoryBudget::Configure() {
+  if (s_configured) return;
+  s_configured = true;
+  stringstream ss(util::GetEnv("OPENVINO_TF_MEMORY_BUDGET_MB"));
+  string budget;
+  while (getline(ss, budget, ',')) {
+    if (budget.empty()) continue;
+    size_t colon = budget.find(':');
+    size_t mb = 0;
+    try {
+      if (colon != string::npos) mb = std::stoull(budget.substr(colon + 1));
+    } catch (const std::exception&) {
+      colon = string::npos;
+    }
+    if (colon == string::npos || colon == 0) {
+      OVTF_VLOG(0) << "Ignoring the memory budget '" << budget
+                   << "', expected device:MB";
+      continue;
+    }
+    s_budgets[budget.substr(0, colon)] = mb * 1024 * 1024;
+  }
+}
+
+void MemoryBudget::Set(const std::string& device, size_t bytes) {
+  lock_guard<mutex> lock(s_mutex);
+  Configure();
+  if (bytes == 0) {
+    s_budgets.erase(device);
+  } else {
+    s_budgets[device] = bytes;
+  }
+  OVTF_VLOG(1) << "Memory budget of " << device << ": " << bytes << " bytes";
+}
+
+size_t MemoryBudget::Get(const std::string& device) {
+  lock_guard<mutex> lock(s_mutex);
+  Configure();
+  auto it = s_budgets.find(device);
+  if (it == s_budgets.end()) {
+    it = s_budgets.find(device.substr(0, device.find('.')));
+  }
+  return it == s_budgets.end() ? 0 : it->second;
+}
+
+void MemoryBudget::Clear() {
+  lock_guard<mutex> lock(s_mutex);
+  s_configured = true;
+  s_budgets.clear();
+}
+
+bool MemoryBudget::DeviceMemoryUsage(const std::string& device,
+                                     size_t& bytes) {
+  if (device.compare(0, 3, "GPU") != 0) return false;
+  try {
+    auto statistics = Backend::GetGlobalContext().ie_core.get_property(
+        device, ov::intel_gpu::memory_statistics);
+    bytes = 0;
+    for (const auto& it : statistics) bytes += it.second;
+    return true;
+  } catch (const std::exception& e) {
+    OVTF_VLOG(2) << "No memory statistics for " << device << ": " << e.what();
+    return false;
+  }
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_MEMORY_BUDGET_H_
+#define OPENVINO_TF_MEMORY_BUDGET_H_
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// The memory budgets of the devices the executables are compiled for. The
+// executable cache evicts the executables of a device before a new one is
+// compiled for it, so that they stay within its budget, and the compilation
+// is refused when the new executable does not fit on its own.
+//
+// The budgets are read from OPENVINO_TF_MEMORY_BUDGET_MB, a comma separated
+// list of <device>:<MB>, and set with api::SetMemoryBudget.
+class MemoryBudget {
+ public:
+  // Sets the budget of device, "GPU" or "GPU.1" for instance. A budget of
+  // 0 removes it.
+  static void Set(const std::string& device, size_t bytes);
+  // The budget of device, or of its device type when "GPU.1" has none of
+  // its own. 0 when the device has no budget.
+  static size_t Get(const std::string& device);
+  static void Clear();
+
+  // The memory the plugin reports to be allocated on device, false if it
+  // does not report it. Only the GPU plugin does.
+  static bool DeviceMemoryUsage(const std::string& device, size_t& bytes);
+
+ private:
+  // Reads OPENVINO_TF_MEMORY_BUDGET_MB once. Requires s_mutex.
+  static void Configure();
+
+  static std::map<std::string, size_t> s_budgets;
+  static bool s_configured;
+  static std::mutex s_mutex;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_MEMORY_BUDGET_H_
@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include "openvino_tensorflow/buffer_pool.h"
+#include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/metrics.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+LatencyHistogram::LatencyHistogram() { Reset(); }
+
+int LatencyHistogram::BucketIndex(int64_t micros) {
+  if (micros < 4) return std::max<int64_t>(micros, 0);
+  int msb = 0;
+  for (uint64_t v = micros; v > 1; v >>= 1) msb++;
+  int sub = (micros >> (msb - 2)) & 3;
+  return std::min(4 * (msb - 1) + sub, kNumBuckets - 1);
+}
+
+int64_t LatencyHistogram::BucketUpperBound(int index) {
+  if (index < 4) return index;
+  int msb = index / 4 + 1;
+  int64_t lower = static_cast<int64_t>(4 + index % 4) << (msb - 2);
+  return lower + (int64_t(1) << (msb - 2)) - 1;
+}
+
+void LatencyHistogram::Record(int64_t micros) {
+  m_buckets[BucketIndex(micros)].fetch_add(1, memory_order_relaxed);
+  m_count.fetch_add(1, memory_order_relaxed);
+  m_sum.fetch_add(micros, memory_order_relaxed);
+}
+
+int64_t LatencyHistogram::Percentile(double q) const {
+  int64_t count = Count();
+  if (count == 0) return 0;
+  int64_t target =
+      std::max<int64_t>(1, static_cast<int64_t>(std::ceil(q * count)));
+  int64_t seen = 0;
+  for (int i = 0; i < kNumBuckets; i++) {
+    seen += m_buckets[i].load(memory_order_relaxed);
+    if (seen >= target) return BucketUpperBound(i);
+  }
+  // Records racing with the read are not all visible yet
+  return BucketUpperBound(kNumBuckets - 1);
+}
+
+void LatencyHistogram::Reset() {
+  for (auto& bucket : m_buckets) bucket.store(0, memory_order_relaxed);
+  m_count.store(0, memory_order_relaxed);
+  m_sum.store(0, memory_order_relaxed);
+}
+
+void ClusterMetrics::Reset() {
+  compiles = 0;
+  compile_micros = 0;
+  executions = 0;
+  bytes_copied = 0;
+  bytes_forwarded = 0;
+  fallbacks = 0;
+  execute_latency.Reset();
+  tf_latency.Reset();
+  compile_pending_latency.Reset();
+}
+
+std::mutex Metrics::s_mutex;
+std::map<size_t, std::unique_ptr<ClusterMetrics>> Metrics::s_clusters;
+
+ClusterMetrics* Metrics::GetClusterMetrics(size_t cluster,
+                                           const string& name) {
+  lock_guard<mutex> lock(s_mutex);
+  auto& metrics = s_clusters[cluster];
+  if (metrics == nullptr) metrics.reset(new ClusterMetrics());
+  metrics->name = name;
+  return metrics.get();
+}
+
+string Metrics::ToJson() {
+  ostringstream out;
+  out << "{\"clusters\": [";
+  lock_guard<mutex> lock(s_mutex);
+  bool first = true;
+  for (const auto& it : s_clusters) {
+    const ClusterMetrics& m = *it.second;
+    auto cache_stats = NGraphClusterManager::GetClusterStats(it.first);
+    int64_t executions = m.executions.load(memory_order_relaxed);
+    int64_t latency_count = m.execute_latency.Count();
+    if (!first) out << ", ";
+    first = false;
+    out << "{\"cluster_id\": " << it.first << ", \"name\": ";
+    util::AppendJsonString(out, m.name);
+    out << ", \"compiles\": " << m.compiles.load(memory_order_relaxed)
+        << ", \"compile_time_us\": "
+        << m.compile_micros.load(memory_order_relaxed)
+        << ", \"cache_hits\": " << cache_stats.hits
+        << ", \"cache_misses\": " << cache_stats.misses
+        << ", \"cache_entries\": " << cache_stats.entries
+        << ", \"cache_bytes\": " << cache_stats.bytes
+        << ", \"cache_evictions\": " << cache_stats.evictions
+        << ", \"executions\": " << executions << ", \"execute_mean_us\": "
+        << (latency_count ? m.execute_latency.Sum() / latency_count : 0)
+        << ", \"execute_p50_us\": " << m.execute_latency.Percentile(0.5)
+        << ", \"execute_p99_us\": " << m.execute_latency.Percentile(0.99)
+        << ", \"bytes_copied\": " << m.bytes_copied.load(memory_order_relaxed)
+        << ", \"bytes_forwarded\": "
+        << m.bytes_forwarded.load(memory_order_relaxed)
+        << ", \"fallbacks\": " << m.fallbacks.load(memory_order_relaxed)
+        << ", \"tf_steps\": " << m.tf_latency.Count()
+        << ", \"tf_p50_us\": " << m.tf_latency.Percentile(0.5)
+        << ", \"compile_pending_steps\": "
+        << m.compile_pending_latency.Count()
+        << ", \"compile_pending_p50_us\": "
+        << m.compile_pending_latency.Percentile(0.5)
+        << "}";
+  }
+  auto pool_stats = BufferPool::GetStats();
+  int64_t pool_requests = pool_stats.hits + pool_stats.misses;
+  out << "], \"buffer_pool\": {\"hits\": " << pool_stats.hits
+      << ", \"misses\": " << pool_stats.misses << ", \"hit_rate\": "
+      << (pool_requests ? double(pool_stats.hits) / pool_requests : 0.0)
+      << ", \"pooled_bytes\": " << pool_stats.pooled_bytes << "}}";
+  return out.str();
+}
+
+void Metrics::ForEachCluster(
+    const std::function<void(size_t, const ClusterMetrics&)>& fn) {
+  lock_guard<mutex> lock(s_mutex);
+  for (const auto& it : s_clusters) fn(it.first, *it.second);
+}
+
+void Metrics::Reset() {
+  lock_guard<mutex> lock(s_mutex);
+  for (auto& it : s_clusters) it.second->Reset();
+  BufferPool::ResetStats();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_METRICS_H_
+#define OPENVINO_TF_METRICS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// A histogram of latencies in microseconds. The buckets grow
+// exponentially with four buckets per power of two, so the percentiles are
+// within 25% of the recorded values. Recording is lock free.
+class LatencyHistogram {
+ public:
+  static constexpr int kNumBuckets = 160;
+
+  LatencyHistogram();
+
+  void Record(int64_t micros);
+  // The upper bound of the bucket holding the q-th quantile, 0 when empty
+  int64_t Percentile(double q) const;
+  int64_t Count() const { return m_count.load(std::memory_order_relaxed); }
+  int64_t Sum() const { return m_sum.load(std::memory_order_relaxed); }
+  void Reset();
+
+  static int BucketIndex(int64_t micros);
+  static int64_t BucketUpperBound(int index);
+
+ private:
+  std::atomic<int64_t> m_buckets[kNumBuckets];
+  std::atomic<int64_t> m_count;
+  std::atomic<int64_t> m_sum;
+};
+
+// The counters of one cluster. The kernel of the cluster updates them on
+// every step without taking a lock.
+struct ClusterMetrics {
+  std::string name;
+  std::atomic<int64_t> compiles{0};
+  std::atomic<int64_t> compile_micros{0};
+  std::atomic<int64_t> executions{0};
+  std::atomic<int64_t> bytes_copied{0};
+  // The output bytes computed in the buffers of forwarded inputs
+  std::atomic<int64_t> bytes_forwarded{0};
+  // The steps run on TF because the cluster or their signature failed
+  std::atomic<int64_t> fallbacks{0};
+  LatencyHistogram execute_latency;
+  // The latency of the steps run on TF, but for the compile pending ones
+  LatencyHistogram tf_latency;
+  // The latency of the steps run on TF while their signature compiles
+  LatencyHistogram compile_pending_latency;
+
+  void Reset();
+};
+
+// The process wide registry of the cluster metrics
+class Metrics {
+ public:
+  // Returns the metrics of a cluster, registering them on first use. The
+  // returned pointer stays valid for the lifetime of the process.
+  static ClusterMetrics* GetClusterMetrics(size_t cluster,
+                                           const std::string& name);
+  // All the cluster metrics, together with the executable cache statistics
+  // of every cluster, as a JSON document
+  static std::string ToJson();
+  static void Reset();
+  // Calls fn with every registered cluster, under the registry lock
+  static void ForEachCluster(
+      const std::function<void(size_t, const ClusterMetrics&)>& fn);
+
+ private:
+  static std::mutex s_mutex;
+  static std::map<size_t, std::unique_ptr<ClusterMetrics>> s_clusters;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_METRICS_H_
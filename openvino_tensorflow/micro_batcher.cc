@@ -0,0 +1,224 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/host_copy.h"
+#include "openvino_tensorflow/ie_tensor.h"
+#include "openvino_tensorflow/micro_batcher.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/step_cancellation.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+MicroBatcher::Options MicroBatcher::Options::FromEnv() {
+  Options options;
+  string max_batch = util::GetEnv("OPENVINO_TF_MICRO_BATCH_MAX_SIZE");
+  if (!max_batch.empty()) options.max_batch = std::stoul(max_batch);
+  string max_wait = util::GetEnv("OPENVINO_TF_MICRO_BATCH_TIMEOUT_US");
+  if (!max_wait.empty()) options.max_wait_us = std::stoll(max_wait);
+  string max_queue = util::GetEnv("OPENVINO_TF_MICRO_BATCH_QUEUE_SIZE");
+  if (!max_queue.empty()) options.max_queue = std::stoul(max_queue);
+  return options;
+}
+
+MicroBatcher::MicroBatcher(RunFunction run, const Options& options)
+    : m_run(run), m_options(options) {}
+
+bool MicroBatcher::IsEnabled() {
+  return util::GetEnv("OPENVINO_TF_MICRO_BATCHING") == "1";
+}
+
+size_t MicroBatcher::BatchSize(const vector<shared_ptr<ov::Tensor>>& inputs) {
+  size_t rows = 0;
+  for (const auto& input : inputs) {
+    if (input == nullptr) continue;
+    const ov::Shape& shape = input->get_shape();
+    if (shape.empty() || shape[0] == 0) return 0;
+    if (rows == 0) rows = shape[0];
+    if (shape[0] != rows) return 0;
+  }
+  return rows;
+}
+
+bool MicroBatcher::Compatible(const Call& a, const Call& b) {
+  if (a.inputs->size() != b.inputs->size() ||
+      a.outputs->size() != b.outputs->size()) {
+    return false;
+  }
+  for (int i = 0; i < a.inputs->size(); i++) {
+    const auto& x = (*a.inputs)[i];
+    const auto& y = (*b.inputs)[i];
+    if ((x == nullptr) != (y == nullptr)) return false;
+    if (x == nullptr) continue;
+    if (x->get_element_type() != y->get_element_type()) return false;
+    const ov::Shape& x_shape = x->get_shape();
+    const ov::Shape& y_shape = y->get_shape();
+    if (x_shape.size() != y_shape.size() ||
+        !std::equal(x_shape.begin() + 1, x_shape.end(), y_shape.begin() + 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t MicroBatcher::QueuedRows() {
+  size_t rows = 0;
+  for (const Call* call : m_queue) rows += call->rows;
+  return rows;
+}
+
+vector<MicroBatcher::Call*> MicroBatcher::TakeBatch() {
+  vector<Call*> batch{m_queue.front()};
+  m_queue.pop_front();
+  size_t rows = batch[0]->rows;
+  for (auto it = m_queue.begin(); it != m_queue.end();) {
+    if (rows + (*it)->rows <= m_options.max_batch &&
+        Compatible(*batch[0], **it)) {
+      rows += (*it)->rows;
+      batch.push_back(*it);
+      it = m_queue.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return batch;
+}
+
+void MicroBatcher::Run(const vector<shared_ptr<ov::Tensor>>& inputs,
+                       vector<shared_ptr<ov::Tensor>>& outputs) {
+  size_t rows = BatchSize(inputs);
+  bool batchable = rows > 0 && rows < m_options.max_batch;
+  for (const auto& output : outputs) {
+    batchable &= output == nullptr;
+  }
+  if (!batchable) {
+    m_run(inputs, outputs);
+    return;
+  }
+
+  Call call;
+  call.inputs = &inputs;
+  call.outputs = &outputs;
+  call.rows = rows;
+
+  // A call of a cancelled step leaves the queue before it is batched
+  StepCancellation::Registration cancellation([this, &call]() {
+    lock_guard<mutex> lock(m_mutex);
+    auto queued = std::find(m_queue.begin(), m_queue.end(), &call);
+    if (queued == m_queue.end()) return;
+    m_queue.erase(queued);
+    call.ex = std::make_exception_ptr(StepCancellation::Cancelled());
+    call.done = true;
+    m_cv.notify_all();
+  });
+  if (cancellation.cancelled()) throw StepCancellation::Cancelled();
+
+  unique_lock<mutex> lock(m_mutex);
+  if (m_queue.size() >= m_options.max_queue) {
+    lock.unlock();
+    m_run(inputs, outputs);
+    return;
+  }
+  m_queue.push_back(&call);
+  m_cv.notify_all();
+
+  while (!call.done) {
+    if (m_leader_active) {
+      m_cv.wait(lock);
+      continue;
+    }
+    m_leader_active = true;
+    auto deadline = chrono::steady_clock::now() +
+                    chrono::microseconds(m_options.max_wait_us);
+    m_cv.wait_until(lock, deadline, [this] {
+      return m_queue.empty() || QueuedRows() >= m_options.max_batch;
+    });
+    // The queued calls were cancelled
+    if (m_queue.empty()) {
+      m_leader_active = false;
+      m_cv.notify_all();
+      continue;
+    }
+    vector<Call*> batch = TakeBatch();
+    lock.unlock();
+    RunBatch(batch);
+    lock.lock();
+    for (Call* batched : batch) batched->done = true;
+    m_leader_active = false;
+    m_cv.notify_all();
+  }
+  if (call.ex != nullptr) std::rethrow_exception(call.ex);
+}
+
+void MicroBatcher::RunBatch(const vector<Call*>& batch) {
+  if (batch.size() == 1) {
+    try {
+      m_run(*batch[0]->inputs, *batch[0]->outputs);
+    } catch (...) {
+      batch[0]->ex = std::current_exception();
+    }
+    return;
+  }
+
+  size_t rows = 0;
+  for (const Call* call : batch) rows += call->rows;
+  OVTF_VLOG(4) << "MicroBatcher: running " << batch.size() << " calls with "
+               << rows << " rows";
+
+  try {
+    const auto& first_inputs = *batch[0]->inputs;
+    vector<shared_ptr<ov::Tensor>> inputs(first_inputs.size(), nullptr);
+    for (int i = 0; i < first_inputs.size(); i++) {
+      if (first_inputs[i] == nullptr) continue;
+      ov::Shape shape = first_inputs[i]->get_shape();
+      shape[0] = rows;
+      auto input =
+          make_shared<IETensor>(first_inputs[i]->get_element_type(), shape);
+      uint8_t* dst = static_cast<uint8_t*>(input->data());
+      for (const Call* call : batch) {
+        const auto& src = (*call->inputs)[i];
+        HostCopy::Copy(dst, src->data(), src->get_byte_size());
+        dst += src->get_byte_size();
+      }
+      inputs[i] = input;
+    }
+
+    vector<shared_ptr<ov::Tensor>> outputs(batch[0]->outputs->size(),
+                                           nullptr);
+    m_run(inputs, outputs);
+
+    for (int i = 0; i < outputs.size(); i++) {
+      ov::Shape shape = outputs[i]->get_shape();
+      if (shape.empty() || shape[0] != rows) {
+        throw runtime_error("Output " + to_string(i) +
+                            " is not batched along dimension 0");
+      }
+      size_t row_bytes = outputs[i]->get_byte_size() / rows;
+      const uint8_t* src = static_cast<const uint8_t*>(outputs[i]->data());
+      for (Call* call : batch) {
+        shape[0] = call->rows;
+        auto output =
+            make_shared<IETensor>(outputs[i]->get_element_type(), shape);
+        HostCopy::Copy(output->data(), src, call->rows * row_bytes);
+        src += call->rows * row_bytes;
+        (*call->outputs)[i] = output;
+      }
+    }
+  } catch (...) {
+    for (Call* call : batch) call->ex = std::current_exception();
+  }
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
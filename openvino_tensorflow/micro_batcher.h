@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_MICRO_BATCHER_H_
+#define OPENVINO_TF_MICRO_BATCHER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "openvino/openvino.hpp"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Coalesces concurrent calls of a model with a dynamic batch dimension into
+// a single call. Calls whose inputs have the same element types and the
+// same shapes apart from dimension 0 are concatenated along dimension 0,
+// run together, and the outputs are split back to each caller.
+//
+// There is no scheduler thread: the first waiting caller leads, waits up to
+// max_wait_us for more calls to arrive or for max_batch rows to be queued,
+// runs the batch and hands the leadership to the next waiting caller.
+class MicroBatcher {
+ public:
+  using RunFunction =
+      std::function<void(const std::vector<std::shared_ptr<ov::Tensor>>&,
+                         std::vector<std::shared_ptr<ov::Tensor>>&)>;
+
+  struct Options {
+    // The number of rows of a coalesced call
+    size_t max_batch = 8;
+    int64_t max_wait_us = 500;
+    // Calls beyond this many waiting ones run on their own
+    size_t max_queue = 64;
+
+    // Reads OPENVINO_TF_MICRO_BATCH_MAX_SIZE,
+    // OPENVINO_TF_MICRO_BATCH_TIMEOUT_US and
+    // OPENVINO_TF_MICRO_BATCH_QUEUE_SIZE
+    static Options FromEnv();
+  };
+
+  MicroBatcher(RunFunction run, const Options& options);
+
+  // Whether OPENVINO_TF_MICRO_BATCHING is set to 1
+  static bool IsEnabled();
+
+  // Runs the call, possibly together with concurrent ones, and blocks until
+  // its outputs are set. Outputs which are not null on entry, inputs which
+  // disagree on dimension 0, or calls of max_batch rows or more are run on
+  // their own. Rethrows the exception of the run function.
+  void Run(const std::vector<std::shared_ptr<ov::Tensor>>& inputs,
+           std::vector<std::shared_ptr<ov::Tensor>>& outputs);
+
+  // The rows shared by the inputs along dimension 0, 0 if they can not be
+  // batched
+  static size_t BatchSize(
+      const std::vector<std::shared_ptr<ov::Tensor>>& inputs);
+
+ private:
+  struct Call {
+    const std::vector<std::shared_ptr<ov::Tensor>>* inputs;
+    std::vector<std::shared_ptr<ov::Tensor>>* outputs;
+    size_t rows;
+    bool done = false;
+    std::exception_ptr ex = nullptr;
+  };
+
+  // Whether two calls can be concatenated
+  static bool Compatible(const Call& a, const Call& b);
+  // Removes the first queued call and the compatible ones which fit next to
+  // it from the queue, with m_mutex held
+  std::vector<Call*> TakeBatch();
+  size_t QueuedRows();
+  // Runs the calls as one and sets their outputs or exceptions
+  void RunBatch(const std::vector<Call*>& batch);
+
+  RunFunction m_run;
+  Options m_options;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<Call*> m_queue;
+  bool m_leader_active = false;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_MICRO_BATCHER_H_
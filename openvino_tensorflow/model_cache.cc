@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef _WIN32
+#include <dirent.h>
+#endif
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/model_cache.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// 1GB unless OPENVINO_TF_MODEL_CACHE_SIZE_MB says otherwise
+static const uint64_t kDefaultCacheBudgetMB = 1024;
+
+// Whether name is one of the files the plugins write to ov::cache_dir: the
+// compiled blobs, and the kernel binaries of the GPU plugin
+static bool IsCacheFile(const string& name) {
+  for (const string& suffix : {".blob", ".cl_cache"}) {
+    if (name.size() > suffix.size() &&
+        name.compare(name.size() - suffix.size(), suffix.size(), suffix) ==
+            0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string ModelCache::s_cache_dir;
+uint64_t ModelCache::s_budget_bytes = kDefaultCacheBudgetMB * 1024 * 1024;
+std::mutex ModelCache::s_mutex;
+
+void ModelCache::Configure(ov::Core& core) {
+  string cache_dir = util::GetEnv("OPENVINO_TF_MODEL_CACHE_DIR");
+  if (cache_dir.empty()) return;
+
+  struct stat st;
+  if (stat(cache_dir.c_str(), &st) != 0 || !(st.st_mode & S_IFDIR)) {
+    OVTF_VLOG(0) << "Model cache directory \"" << cache_dir
+                 << "\" does not exist, the model cache is disabled";
+    return;
+  }
+
+  string budget_env = util::GetEnv("OPENVINO_TF_MODEL_CACHE_SIZE_MB");
+  {
+    lock_guard<mutex> lock(s_mutex);
+    s_cache_dir = cache_dir;
+    if (!budget_env.empty()) {
+      s_budget_bytes = std::stoull(budget_env) * 1024 * 1024;
+    }
+  }
+  try {
+    core.set_property(ov::cache_dir(cache_dir));
+  } catch (const std::exception& e) {
+    OVTF_VLOG(0) << "Failed to enable the model cache: " << e.what();
+    lock_guard<mutex> lock(s_mutex);
+    s_cache_dir = "";
+    return;
+  }
+  OVTF_VLOG(1) << "Model cache enabled in " << cache_dir << " with a budget of "
+               << s_budget_bytes / (1024 * 1024) << " MB";
+  EvictIfNeeded();
+}
+
+bool ModelCache::IsEnabled() {
+  lock_guard<mutex> lock(s_mutex);
+  return !s_cache_dir.empty();
+}
+
+std::string ModelCache::GetCacheDir() {
+  lock_guard<mutex> lock(s_mutex);
+  return s_cache_dir;
+}
+
+void ModelCache::EvictIfNeeded() {
+  lock_guard<mutex> lock(s_mutex);
+  if (s_cache_dir.empty()) return;
+  uint64_t size = EvictToBudget(s_cache_dir, s_budget_bytes);
+  OVTF_VLOG(2) << "Model cache size: " << size << " bytes";
+}
+
+uint64_t ModelCache::EvictToBudget(const std::string& dir,
+                                   uint64_t budget_bytes) {
+  struct CacheFile {
+    string path;
+    uint64_t size;
+    time_t used;
+  };
+  vector<CacheFile> files;
+  uint64_t total_size = 0;
+#ifndef _WIN32
+  DIR* dp = opendir(dir.c_str());
+  if (dp == nullptr) return 0;
+  struct dirent* entry;
+  while ((entry = readdir(dp)) != nullptr) {
+    // The other files of a shared directory are neither counted nor removed
+    if (!IsCacheFile(entry->d_name)) continue;
+    string path = dir + "/" + entry->d_name;
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) continue;
+    // A blob is read, which updates its access time, each time a model is
+    // loaded from it
+    files.push_back({path, static_cast<uint64_t>(st.st_size),
+                     std::max(st.st_atime, st.st_mtime)});
+    total_size += st.st_size;
+  }
+  closedir(dp);
+#else
+  OVTF_VLOG(1) << "Model cache eviction is not supported on Windows";
+  return 0;
+#endif
+
+  if (total_size <= budget_bytes) return total_size;
+
+  // Least recently used first
+  sort(files.begin(), files.end(),
+       [](const CacheFile& a, const CacheFile& b) { return a.used < b.used; });
+  for (const auto& file : files) {
+    if (total_size <= budget_bytes) break;
+    if (std::remove(file.path.c_str()) == 0) {
+      OVTF_VLOG(1) << "Model cache evicted " << file.path;
+      total_size -= file.size;
+    }
+  }
+  return total_size;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_MODEL_CACHE_H_
+#define OPENVINO_TF_MODEL_CACHE_H_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "openvino/openvino.hpp"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Persistent on-disk cache of compiled models. The blobs are written by the
+// OpenVINO plugins through the ov::cache_dir property; their key covers the
+// model, the device, its configuration and the OpenVINO version, so a warm
+// restart loads the compiled blob instead of calling the plugin compiler.
+// The directory is kept under a size budget by evicting the least recently
+// used blobs.
+class ModelCache {
+ public:
+  // Reads OPENVINO_TF_MODEL_CACHE_DIR and OPENVINO_TF_MODEL_CACHE_SIZE_MB and
+  // enables the cache on core if a directory is set
+  static void Configure(ov::Core& core);
+
+  static bool IsEnabled();
+  static std::string GetCacheDir();
+
+  // Removes the least recently used blobs of the cache directory until it
+  // fits the size budget. Called after each compilation.
+  static void EvictIfNeeded();
+
+  // Removes the least recently read or written blobs of dir, the *.blob
+  // and *.cl_cache files the plugins write, until their total size is at
+  // most budget_bytes. The other files of dir are left alone. Returns the
+  // number of bytes of the blobs left in dir.
+  static uint64_t EvictToBudget(const std::string& dir, uint64_t budget_bytes);
+
+ private:
+  static std::string s_cache_dir;
+  static uint64_t s_budget_bytes;
+  static std::mutex s_mutex;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_MODEL_CACHE_H_
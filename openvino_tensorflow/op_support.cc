@@ -0,0 +1,256 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <sstream>
+
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
+#include "tensorflow/core/platform/fingerprint.h"
+
+#include "openvino/op/util/op_types.hpp"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/op_support.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+std::mutex OpSupport::s_mutex;
+map<string, unordered_map<string, bool>> OpSupport::s_supported;
+map<string, set<string>> OpSupport::s_tf_unsupported;
+uint64_t OpSupport::s_tf_unsupported_generation = 0;
+map<string, unordered_map<uint64, bool>> OpSupport::s_node_support;
+
+// The node decisions cached for a context before they are forgotten
+static const size_t kMaxNodeSupportEntries = 1 << 20;
+// The constants whose value is part of the signatures of their consumers
+static const size_t kMaxConstSignatureBytes = 1024;
+
+static void AppendPort(stringstream& ss, const ov::element::Type& type,
+                       const ov::PartialShape& shape) {
+  ss << type.get_type_name() << "/";
+  if (shape.rank().is_static()) {
+    ss << shape.rank().get_length();
+  } else {
+    ss << "?";
+  }
+}
+
+string OpSupport::Signature(const ov::Node& node) {
+  stringstream ss;
+  ss << node.get_type_info().name << "-" << node.get_type_info().get_version()
+     << "(";
+  for (size_t i = 0; i < node.get_input_size(); i++) {
+    if (i > 0) ss << ",";
+    AppendPort(ss, node.get_input_element_type(i),
+               node.get_input_partial_shape(i));
+  }
+  ss << ")->(";
+  for (size_t i = 0; i < node.get_output_size(); i++) {
+    if (i > 0) ss << ",";
+    AppendPort(ss, node.get_output_element_type(i),
+               node.get_output_partial_shape(i));
+  }
+  ss << ")";
+  return ss.str();
+}
+
+string OpSupport::TFSignature(const Node* node) {
+  // The attributes sorted by name
+  map<string, string> type_attrs;
+  for (const auto& attr : node->def().attr()) {
+    if (attr.second.value_case() == AttrValue::kType) {
+      type_attrs[attr.first] = DataTypeString(attr.second.type());
+    } else if (attr.second.value_case() == AttrValue::kList &&
+               attr.second.list().type_size() > 0) {
+      string types;
+      for (int i = 0; i < attr.second.list().type_size(); i++) {
+        if (i > 0) types += ",";
+        types += DataTypeString(
+            static_cast<DataType>(attr.second.list().type(i)));
+      }
+      type_attrs[attr.first] = "[" + types + "]";
+    }
+  }
+  string signature = node->type_string();
+  for (const auto& attr : type_attrs) {
+    signature += " " + attr.first + "=" + attr.second;
+  }
+  return signature;
+}
+
+uint64 OpSupport::NodeSignature(const Node* node) {
+  // The attributes sorted by name, without the internal ones
+  map<string, const AttrValue*> attrs;
+  for (const auto& attr : node->def().attr()) {
+    if (attr.first.empty() || attr.first[0] == '_') continue;
+    attrs[attr.first] = &attr.second;
+  }
+  string serialized;
+  stringstream ss;
+  ss << node->type_string();
+  for (const auto& attr : attrs) {
+    SerializeToStringDeterministic(*attr.second, &serialized);
+    ss << ";" << attr.first << "=" << Fingerprint64(serialized);
+  }
+  const AttrValue* shapes = node->attrs().Find("_output_shapes");
+  if (shapes != nullptr) {
+    SerializeToStringDeterministic(*shapes, &serialized);
+    ss << ";shapes=" << Fingerprint64(serialized);
+  }
+
+  vector<const Edge*> inputs(node->num_inputs(), nullptr);
+  for (const Edge* edge : node->in_edges()) {
+    if (!edge->IsControlEdge()) inputs[edge->dst_input()] = edge;
+  }
+  for (size_t i = 0; i < inputs.size(); i++) {
+    ss << ";in" << i << "=" << DataTypeString(node->input_type(i));
+    if (inputs[i] == nullptr) continue;
+    const Node* src = inputs[i]->src();
+    const AttrValue* src_shapes = src->attrs().Find("_output_shapes");
+    if (src_shapes != nullptr &&
+        src_shapes->list().shape_size() > inputs[i]->src_output()) {
+      SerializeToStringDeterministic(
+          src_shapes->list().shape(inputs[i]->src_output()), &serialized);
+      ss << "/" << Fingerprint64(serialized);
+    }
+    if (src->type_string() == "Const") {
+      ss << "/const";
+      const AttrValue* value = src->attrs().Find("value");
+      if (value != nullptr &&
+          value->tensor().ByteSizeLong() <= kMaxConstSignatureBytes) {
+        SerializeToStringDeterministic(value->tensor(), &serialized);
+        ss << "=" << Fingerprint64(serialized);
+      }
+    }
+  }
+  return Fingerprint64(ss.str());
+}
+
+bool OpSupport::LookupNodeSupport(const string& context, uint64 signature,
+                                  bool& supported) {
+  lock_guard<mutex> lock(s_mutex);
+  auto context_it = s_node_support.find(context);
+  if (context_it == s_node_support.end()) return false;
+  auto it = context_it->second.find(signature);
+  if (it == context_it->second.end()) return false;
+  supported = it->second;
+  return true;
+}
+
+void OpSupport::SetNodeSupport(const string& context, uint64 signature,
+                               bool supported) {
+  lock_guard<mutex> lock(s_mutex);
+  auto& decisions = s_node_support[context];
+  if (decisions.size() >= kMaxNodeSupportEntries) decisions.clear();
+  decisions[signature] = supported;
+}
+
+Status OpSupport::QueryModel(ov::Core& core,
+                             const shared_ptr<ov::Model>& model,
+                             const string& device,
+                             vector<shared_ptr<ov::Node>>& unsupported) {
+  unsupported.clear();
+  // The parameters, constants and results are supported by every device
+  vector<pair<shared_ptr<ov::Node>, string>> ops;
+  for (const auto& node : model->get_ops()) {
+    if (ov::op::util::is_parameter(node) || ov::op::util::is_constant(node) ||
+        ov::op::util::is_output(node)) {
+      continue;
+    }
+    ops.emplace_back(node, Signature(*node));
+  }
+
+  bool known = true;
+  {
+    lock_guard<mutex> lock(s_mutex);
+    const auto& supported = s_supported[device];
+    for (const auto& op : ops) {
+      auto it = supported.find(op.second);
+      if (it == supported.end()) {
+        known = false;
+        break;
+      }
+      if (!it->second) unsupported.push_back(op.first);
+    }
+  }
+  if (known) return Status::OK();
+
+  ov::SupportedOpsMap query;
+  try {
+    query = core.query_model(model, device);
+  } catch (const std::exception& e) {
+    unsupported.clear();
+    return errors::Internal("Failed to query ", device, " for the ops of ",
+                            model->get_friendly_name(), ": ", e.what());
+  }
+
+  lock_guard<mutex> lock(s_mutex);
+  auto& supported = s_supported[device];
+  unsupported.clear();
+  for (const auto& op : ops) {
+    bool is_supported = query.count(op.first->get_friendly_name()) > 0;
+    auto it = supported.find(op.second);
+    if (it == supported.end()) {
+      supported[op.second] = is_supported;
+    } else {
+      it->second = it->second && is_supported;
+    }
+    if (!is_supported) {
+      OVTF_VLOG(1) << device << " does not support "
+                   << op.first->get_friendly_name() << " (" << op.second
+                   << ")";
+      unsupported.push_back(op.first);
+    }
+  }
+  return Status::OK();
+}
+
+bool OpSupport::IsKnown(const string& device, const string& signature,
+                        bool& supported) {
+  lock_guard<mutex> lock(s_mutex);
+  auto device_it = s_supported.find(device);
+  if (device_it == s_supported.end()) return false;
+  auto it = device_it->second.find(signature);
+  if (it == device_it->second.end()) return false;
+  supported = it->second;
+  return true;
+}
+
+void OpSupport::SetTFUnsupported(const string& device,
+                                 const string& tf_signature) {
+  lock_guard<mutex> lock(s_mutex);
+  if (s_tf_unsupported[device].insert(tf_signature).second) {
+    s_tf_unsupported_generation++;
+  }
+}
+
+bool OpSupport::IsTFUnsupported(const string& device,
+                                const string& tf_signature) {
+  lock_guard<mutex> lock(s_mutex);
+  auto it = s_tf_unsupported.find(device);
+  return it != s_tf_unsupported.end() && it->second.count(tf_signature) > 0;
+}
+
+uint64_t OpSupport::TFUnsupportedGeneration() {
+  lock_guard<mutex> lock(s_mutex);
+  return s_tf_unsupported_generation;
+}
+
+void OpSupport::Clear() {
+  lock_guard<mutex> lock(s_mutex);
+  s_supported.clear();
+  s_tf_unsupported.clear();
+  s_tf_unsupported_generation++;
+  s_node_support.clear();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
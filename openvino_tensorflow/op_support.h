@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_OP_SUPPORT_H_
+#define OPENVINO_TF_OP_SUPPORT_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/core/status.h"
+
+#include "openvino/openvino.hpp"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Caches which ops the devices really support, as reported by
+// ov::Core::query_model, instead of assuming they support every op of the
+// opsets the translation emits.
+//
+// The support of an OpenVINO op is cached by its signature, so that a device
+// is only queried for the models holding an op signature it was not queried
+// for yet. The TF ops translated to unsupported OpenVINO ops are recorded by
+// their own signature, which the marking phase leaves out of the clusters of
+// the device.
+class OpSupport {
+ public:
+  // The type, version and input and output element types and ranks of node
+  static std::string Signature(const ov::Node& node);
+  // The type and type attributes of a TF node
+  static std::string TFSignature(const Node* node);
+  // The fingerprint of what the op capability manager decides the support
+  // of a TF node on: its type, attributes and known output shapes, and the
+  // dtypes, known shapes and constness of its inputs
+  static uint64 NodeSignature(const Node* node);
+
+  // The ops of model which device does not support. The device is queried
+  // only when the support of one of the signatures is not known yet; a
+  // signature is unsupported once one of its ops was reported unsupported.
+  static Status QueryModel(ov::Core& core,
+                           const std::shared_ptr<ov::Model>& model,
+                           const std::string& device,
+                           std::vector<std::shared_ptr<ov::Node>>& unsupported);
+  // Whether the support of an op signature by device is known, and if so
+  // whether it is supported
+  static bool IsKnown(const std::string& device, const std::string& signature,
+                      bool& supported);
+
+  // Records that the TF op signature translates to ops device does not
+  // support
+  static void SetTFUnsupported(const std::string& device,
+                               const std::string& tf_signature);
+  static bool IsTFUnsupported(const std::string& device,
+                              const std::string& tf_signature);
+  // Changes whenever a TF op signature is recorded as unsupported, or the
+  // cache is cleared, and so whenever the marking could change
+  static uint64_t TFUnsupportedGeneration();
+
+  // The support decisions of the op capability manager, by context (device,
+  // OpenVINO version and disabled ops) and node signature
+  static bool LookupNodeSupport(const std::string& context, uint64 signature,
+                                bool& supported);
+  static void SetNodeSupport(const std::string& context, uint64 signature,
+                             bool supported);
+
+  // Forgets everything which was cached
+  static void Clear();
+
+ private:
+  static std::mutex s_mutex;
+  // The support of the op signatures, by device
+  static std::map<std::string, std::unordered_map<std::string, bool>>
+      s_supported;
+  // The unsupported TF op signatures, by device
+  static std::map<std::string, std::set<std::string>> s_tf_unsupported;
+  static uint64_t s_tf_unsupported_generation;
+  // The op capability manager decisions, by context and node signature
+  static std::map<std::string, std::unordered_map<uint64, bool>>
+      s_node_support;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_OP_SUPPORT_H_
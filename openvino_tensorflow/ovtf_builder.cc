@@ -4,12 +4,24 @@
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
 
+#include <limits>
+#include <map>
+#include <numeric>
+#include <sstream>
+
+#include "tensorflow/core/common_runtime/function.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/tensor_shape.pb.h"
 #include "tensorflow/core/graph/algorithm.h"
 #include "tensorflow/core/graph/edgeset.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/profiler/lib/traceme.h"
+#include "tensorflow/core/profiler/lib/traceme_encode.h"
 
+#include "ngraph/op/util/op_types.hpp"
+#include "openvino/op/util/variable.hpp"
 #include "openvino/opsets/opset8.hpp"
 #include "openvino/pass/constant_folding.hpp"
 
@@ -20,7 +32,11 @@
 #include "openvino_tensorflow/layout_conversions.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
 #include "openvino_tensorflow/ovtf_builder.h"
+#include "openvino_tensorflow/ovtf_timer.h"
 #include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/pass/graph_simplification.h"
+#include "openvino_tensorflow/pass/layout_planning.h"
+#include "openvino_tensorflow/pass/narrow_index_types.h"
 #include "openvino_tensorflow/pass/transpose_sinking.h"
 
 using tensorflow::int32;
@@ -96,6 +112,127 @@ void Builder::SetTracingInfo(const std::string& op_name,
   }
 }
 
+// The rt_info key of the output bounds, kept as a string so that the
+// dumped models serialize it
+static const char* const kOutputBoundKey = "ovtf_output_bound";
+
+void Builder::SetOutputBound(const ov::Output<ov::Node>& output,
+                             const ov::Shape& bound) {
+  std::string value;
+  for (auto dim : bound) {
+    if (!value.empty()) value += ",";
+    value += std::to_string(dim);
+  }
+  output.get_node()->get_rt_info()[kOutputBoundKey] = value;
+}
+
+bool Builder::GetOutputBound(const std::shared_ptr<ov::Node>& node,
+                             ov::Shape& bound) {
+  const auto& rt_info = node->get_rt_info();
+  auto it = rt_info.find(kOutputBoundKey);
+  if (it == rt_info.end() || !it->second.is<std::string>()) return false;
+  bound.clear();
+  std::stringstream ss(it->second.as<std::string>());
+  std::string dim;
+  while (std::getline(ss, dim, ',')) {
+    bound.push_back(std::stoull(dim));
+  }
+  return true;
+}
+
+// The rt_info key of the inputs a result may be computed in place of,
+// the comma separated indices of their TF inputs
+static const char* const kForwardableInputsKey = "ovtf_forwardable_inputs";
+
+bool Builder::GetForwardableInputs(const std::shared_ptr<ov::Node>& node,
+                                   std::vector<int>& inputs) {
+  const auto& rt_info = node->get_rt_info();
+  auto it = rt_info.find(kForwardableInputsKey);
+  if (it == rt_info.end() || !it->second.is<std::string>()) return false;
+  inputs.clear();
+  std::stringstream ss(it->second.as<std::string>());
+  std::string index;
+  while (std::getline(ss, index, ',')) {
+    inputs.push_back(std::stoi(index));
+  }
+  return true;
+}
+
+// Whether every element of the output of node only depends on the elements
+// at its position of the inputs of the shape of the output
+static bool IsElementwise(const std::shared_ptr<ov::Node>& node) {
+  return ngraph::op::is_unary_elementwise_arithmetic(node) ||
+         ngraph::op::is_binary_elementwise_arithmetic(node) ||
+         ov::is_type<opset::Clamp>(node) || ov::is_type<opset::Elu>(node) ||
+         ov::is_type<opset::Gelu>(node) || ov::is_type<opset::HSigmoid>(node) ||
+         ov::is_type<opset::HSwish>(node) || ov::is_type<opset::Mish>(node) ||
+         ov::is_type<opset::SoftPlus>(node) || ov::is_type<opset::Swish>(node);
+}
+
+// Records on every result the parameters its TF output can be written over
+// in place of allocating it: those of its type read only by a chain of
+// elementwise ops ending in the result, whose other inputs are constants or
+// parameters. The device may then place every tensor of the chain in the
+// buffer of the parameter, each element of which is read before it is
+// written. A result fed by another op, e.g. the MatMul of a residual block,
+// is not recorded, the device could write it there before the chain reads
+// the parameter. The shapes may be dynamic, TF only forwards an input of
+// the shape of the output.
+static void RecordForwardableInputs(
+    const ov::ResultVector& ng_result_list,
+    const ov::ParameterVector& ng_parameter_list) {
+  std::map<const ov::Node*, int> param_indexes;
+  for (int i = 0; i < ng_parameter_list.size(); i++) {
+    param_indexes[ng_parameter_list[i].get()] = i;
+  }
+  for (const auto& result : ng_result_list) {
+    if (result == nullptr) continue;
+    const ov::PartialShape& shape = result->get_output_partial_shape(0);
+    const ov::element::Type& type = result->get_element_type();
+    std::vector<int> inputs;
+    auto node = result->input_value(0).get_node_shared_ptr();
+    bool chain = IsElementwise(node);
+    while (chain) {
+      if (node->get_output_size() != 1 ||
+          node->get_output_target_inputs(0).size() != 1 ||
+          !node->get_output_partial_shape(0).compatible(shape)) {
+        chain = false;
+        break;
+      }
+      std::shared_ptr<ov::Node> next;
+      for (const auto& input : node->input_values()) {
+        auto src = input.get_node_shared_ptr();
+        if (ov::op::util::is_constant(src)) continue;
+        auto param = param_indexes.find(src.get());
+        if (param != param_indexes.end()) {
+          if (input.get_partial_shape().compatible(shape) &&
+              input.get_element_type() == type &&
+              src->get_output_target_inputs(0).size() == 1) {
+            inputs.push_back(param->second);
+          }
+          continue;
+        }
+        if (next != nullptr || !IsElementwise(src)) {
+          chain = false;
+          break;
+        }
+        next = src;
+      }
+      if (!chain || next == nullptr) break;
+      node = next;
+    }
+    if (!chain || inputs.empty()) continue;
+    std::string value;
+    for (int input : inputs) {
+      if (!value.empty()) value += ",";
+      value += std::to_string(input);
+    }
+    result->get_rt_info()[kForwardableInputsKey] = value;
+    OVTF_VLOG(2) << "Result " << result->get_friendly_name()
+                 << " can be computed in place of inputs " << value;
+  }
+}
+
 template <class TOpType, class... TArg>
 ov::Output<ov::Node> ConstructNgNode(const std::string& op_name,
                                      TArg&&... Args) {
@@ -296,6 +433,23 @@ static Status GetStaticInputVector(
   return Status::OK();
 }
 
+// Whether input input_index of op is a cluster input which the kernel reads
+// at run time, because its value keeps changing, although the op expects a
+// static value
+static bool IsRuntimeInput(const Node* op, int64 input_index,
+                           const std::vector<const Tensor*>& static_input_map) {
+  Node* input_node;
+  if (!op->input_node(input_index, &input_node).ok() || !input_node->IsArg()) {
+    return false;
+  }
+  int arg_index;
+  if (!GetNodeAttr(input_node->attrs(), "index", &arg_index).ok()) {
+    return false;
+  }
+  return arg_index >= 0 && arg_index < static_input_map.size() &&
+         static_input_map[arg_index] == nullptr;
+}
+
 static Status GetStaticInputNode(
     const Node* op, int64 input_index,
     const std::vector<const Tensor*>& static_input_map, DataType dt,
@@ -461,10 +615,33 @@ static Status ValuesFromConstNode(const NodeDef& node,
   return Status::OK();
 }
 
+// Builds a Constant over the buffer of tensor instead of a copy of it. The
+// Constant holds a reference to the buffer, which TF does not write while it
+// is shared, or to the buffer of an earlier constant with the same contents.
+// Returns false if the layout of the tensor elements is not the one of et.
+static bool MakeSharedConstant(const string& op_name, const Tensor& tensor,
+                               ov::element::Type et, const ov::Shape& shape,
+                               ov::Output<ov::Node>& ng_node) {
+  if (!DataTypeCanUseMemcpy(tensor.dtype()) ||
+      DataTypeSize(tensor.dtype()) != static_cast<int>(et.size()) ||
+      tensor.TotalBytes() != ov::shape_size(shape) * et.size() ||
+      tensor.TotalBytes() == 0) {
+    return false;
+  }
+  auto buffer = Backend::GetGlobalContext().weights_cache.Get(tensor);
+  ng_node = ConstructNgNode<opset::Constant>(op_name, et, shape, buffer);
+  return true;
+}
+
 template <typename T>
 static Status MakeConstOpForParam(const Tensor& tensor, string prov_tag,
                                   ov::element::Type ng_et, ov::Shape ng_shape,
                                   ov::Output<ov::Node>& ng_node) {
+  if (tensor.dtype() == DataTypeToEnum<T>::value &&
+      MakeSharedConstant(prov_tag, tensor, ng_et, ng_shape, ng_node)) {
+    return Status::OK();
+  }
+
   vector<T> const_values;
 
   TensorDataToVector(tensor, &const_values);
@@ -478,6 +655,18 @@ static Status MakeConstOpForParam(const Tensor& tensor, string prov_tag,
 template <typename T, typename VecT = T>
 static Status MakeConstOp(const Node* op, ov::element::Type et,
                           ov::Output<ov::Node>& ng_node) {
+  // The value is decoded once into a TF tensor, which the Constant shares
+  Tensor tensor;
+  if (tensor.FromProto(op->def().attr().at("value").tensor()) &&
+      tensor.dtype() == DataTypeToEnum<T>::value) {
+    ov::Shape ng_shape;
+    TF_RETURN_IF_ERROR(
+        util::TFTensorShapeToNGraphShape(tensor.shape(), &ng_shape));
+    if (MakeSharedConstant(op->name(), tensor, et, ng_shape, ng_node)) {
+      return Status::OK();
+    }
+  }
+
   vector<VecT> const_values;
   TensorShapeProto shape_proto;
 
@@ -899,6 +1088,301 @@ static Status TranslateBiasAddOp(
   return Status::OK();
 }
 
+// The fused recurrent ops of TF are translated into the OpenVINO sequence
+// and cell ops when only the states are read, as in inference graphs. The
+// other outputs are the gate activations, which the OpenVINO ops do not
+// return. Then, or with peepholes or a clipped cell state, which OpenVINO
+// lacks, a cell is built from its equations and BlockLSTM runs it in a
+// TensorIterator.
+
+// The attributes of the LSTM ops. BlockLSTMV2 orders the gates of its
+// weights i, f, c, o and has no forget bias, the other ops order them i, c,
+// f, o.
+struct LSTMAttrs {
+  bool ifco_layout = false;
+  float forget_bias = 0.0f;
+  float cell_clip = 0.0f;
+  bool use_peephole = false;
+
+  int ForgetGate() const { return ifco_layout ? 1 : 2; }
+  int CellGate() const { return ifco_layout ? 2 : 1; }
+  // Whether the OpenVINO LSTM ops compute the same states
+  bool FitsOpenVINO() const { return !use_peephole && cell_clip <= 0.0f; }
+};
+
+static Status GetLSTMAttrs(const Node* op, LSTMAttrs& attrs) {
+  attrs.ifco_layout = op->type_string() == "BlockLSTMV2";
+  if (!attrs.ifco_layout) {
+    TF_RETURN_IF_ERROR(
+        GetNodeAttr(op->attrs(), "forget_bias", &attrs.forget_bias));
+  }
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "cell_clip", &attrs.cell_clip));
+  TF_RETURN_IF_ERROR(
+      GetNodeAttr(op->attrs(), "use_peephole", &attrs.use_peephole));
+  return Status::OK();
+}
+
+// Whether no other output of op than the given ones is read
+static bool ReadsOnlyOutputs(const Node* op, const std::set<int>& outputs) {
+  for (const Edge* edge : op->out_edges()) {
+    if (!edge->IsControlEdge() && outputs.count(edge->src_output()) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The cell size of recurrent weights [input + cell, gates * cell]
+static Status GetCellSize(const Node* op, const ov::Output<ov::Node>& weights,
+                          int64_t gates, int64_t& cell_size) {
+  auto shape = weights.get_partial_shape();
+  if (shape.rank().is_dynamic() || shape.rank().get_length() != 2 ||
+      shape[1].is_dynamic()) {
+    return errors::InvalidArgument("The weights of ", op->name(),
+                                   " must have a static shape");
+  }
+  cell_size = shape[1].get_length() / gates;
+  return Status::OK();
+}
+
+// Splits TF weights [input + cell, gates * cell] into the OpenVINO W
+// [gates * cell, input] and R [gates * cell, cell]
+static void SplitRecurrentWeights(const string& op_name,
+                                  const ov::Output<ov::Node>& weights,
+                                  int64_t cell_size, ov::Output<ov::Node>& ng_w,
+                                  ov::Output<ov::Node>& ng_r) {
+  auto order = make_shared<opset::Constant>(ov::element::i64, ov::Shape{2},
+                                            std::vector<int64>{1, 0});
+  auto transposed = ConstructNgNode<opset::Transpose>(op_name, weights, order);
+  auto axis = make_shared<opset::Constant>(ov::element::i64, ov::Shape{}, 1);
+  auto lengths = make_shared<opset::Constant>(
+      ov::element::i64, ov::Shape{2}, std::vector<int64>{-1, cell_size});
+  auto split = ConstructNgNode<opset::VariadicSplit>(op_name, transposed,
+                                                     axis, lengths);
+  ng_w = split.get_node()->output(0);
+  ng_r = split.get_node()->output(1);
+}
+
+// Reorders the gates of a TF LSTM weight or bias along axis into the f, i,
+// c, o order of OpenVINO
+static ov::Output<ov::Node> ToOpenVINOGates(const string& op_name,
+                                            const LSTMAttrs& attrs,
+                                            const ov::Output<ov::Node>& value,
+                                            int64_t axis) {
+  auto ng_axis =
+      make_shared<opset::Constant>(ov::element::i64, ov::Shape{}, axis);
+  auto split = ConstructNgNode<opset::Split>(op_name, value, ng_axis, 4);
+  auto gates = split.get_node()->outputs();
+  return ConstructNgNode<opset::Concat>(
+      op_name,
+      ov::OutputVector{gates[attrs.ForgetGate()], gates[0],
+                       gates[attrs.CellGate()], gates[3]},
+      axis);
+}
+
+// The W, R and B of the OpenVINO LSTM ops from the TF weights and bias,
+// with the forget bias added
+static Status ToOpenVINOLSTMWeights(const Node* op, const LSTMAttrs& attrs,
+                                    const ov::Output<ov::Node>& w,
+                                    const ov::Output<ov::Node>& b,
+                                    ov::Output<ov::Node>& ng_w,
+                                    ov::Output<ov::Node>& ng_r,
+                                    ov::Output<ov::Node>& ng_b,
+                                    int64_t& cell_size) {
+  TF_RETURN_IF_ERROR(GetCellSize(op, w, 4, cell_size));
+  SplitRecurrentWeights(op->name(), ToOpenVINOGates(op->name(), attrs, w, 1),
+                        cell_size, ng_w, ng_r);
+  ng_b = ToOpenVINOGates(op->name(), attrs, b, 0);
+  if (attrs.forget_bias != 0.0f) {
+    // The forget gate comes first
+    std::vector<float> forget_bias(4 * cell_size, 0.0f);
+    std::fill(forget_bias.begin(), forget_bias.begin() + cell_size,
+              attrs.forget_bias);
+    auto ng_forget_bias = ConstructNgNode<opset::Constant>(
+        op->name(), b.get_element_type(), ov::Shape{forget_bias.size()},
+        forget_bias);
+    ng_b = ConstructNgNode<opset::Add>(op->name(), ng_b, ng_forget_bias);
+  }
+  return Status::OK();
+}
+
+// The outputs i, cs, f, o, ci, co and h of a TF LSTM cell, from its
+// equations
+static ov::OutputVector ComputeLSTMCell(
+    const string& op_name, const LSTMAttrs& attrs,
+    const ov::Output<ov::Node>& x, const ov::Output<ov::Node>& cs_prev,
+    const ov::Output<ov::Node>& h_prev, const ov::Output<ov::Node>& w,
+    const ov::Output<ov::Node>& wci, const ov::Output<ov::Node>& wcf,
+    const ov::Output<ov::Node>& wco, const ov::Output<ov::Node>& b) {
+  auto xh = ConstructNgNode<opset::Concat>(op_name,
+                                           ov::OutputVector{x, h_prev}, 1);
+  auto gates = ConstructNgNode<opset::Add>(
+      op_name, ConstructNgNode<opset::MatMul>(op_name, xh, w), b);
+  auto axis = make_shared<opset::Constant>(ov::element::i64, ov::Shape{}, 1);
+  auto split = ConstructNgNode<opset::Split>(op_name, gates, axis, 4);
+  auto outputs = split.get_node()->outputs();
+  ov::Output<ov::Node> i = outputs[0];
+  ov::Output<ov::Node> ci = outputs[attrs.CellGate()];
+  ov::Output<ov::Node> f = outputs[attrs.ForgetGate()];
+  ov::Output<ov::Node> o = outputs[3];
+
+  if (attrs.use_peephole) {
+    i = ConstructNgNode<opset::Add>(
+        op_name, i, ConstructNgNode<opset::Multiply>(op_name, cs_prev, wci));
+    f = ConstructNgNode<opset::Add>(
+        op_name, f, ConstructNgNode<opset::Multiply>(op_name, cs_prev, wcf));
+  }
+  if (attrs.forget_bias != 0.0f) {
+    auto forget_bias = ConstructNgNode<opset::Constant>(
+        op_name, x.get_element_type(), ov::Shape{},
+        std::vector<float>{attrs.forget_bias});
+    f = ConstructNgNode<opset::Add>(op_name, f, forget_bias);
+  }
+  i = ConstructNgNode<opset::Sigmoid>(op_name, i);
+  f = ConstructNgNode<opset::Sigmoid>(op_name, f);
+  ci = ConstructNgNode<opset::Tanh>(op_name, ci);
+
+  ov::Output<ov::Node> cs = ConstructNgNode<opset::Add>(
+      op_name, ConstructNgNode<opset::Multiply>(op_name, ci, i),
+      ConstructNgNode<opset::Multiply>(op_name, cs_prev, f));
+  if (attrs.cell_clip > 0.0f) {
+    cs = ConstructNgNode<opset::Clamp>(op_name, cs, -attrs.cell_clip,
+                                       attrs.cell_clip);
+  }
+  if (attrs.use_peephole) {
+    o = ConstructNgNode<opset::Add>(
+        op_name, o, ConstructNgNode<opset::Multiply>(op_name, cs, wco));
+  }
+  o = ConstructNgNode<opset::Sigmoid>(op_name, o);
+  auto co = ConstructNgNode<opset::Tanh>(op_name, cs);
+  auto h = ConstructNgNode<opset::Multiply>(op_name, co, o);
+  return {i, cs, f, o, ci, co, h};
+}
+
+static Status TranslateBlockLSTMOp(const Node* op,
+                                   const std::vector<const Tensor*>&,
+                                   Builder::OpMap& ng_op_map) {
+  ov::Output<ov::Node> seq_len_max, x, cs_prev, h_prev, w, wci, wcf, wco, b;
+  TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, seq_len_max, x, cs_prev,
+                                   h_prev, w, wci, wcf, wco, b));
+  LSTMAttrs attrs;
+  TF_RETURN_IF_ERROR(GetLSTMAttrs(op, attrs));
+
+  auto axis_0 = make_shared<opset::Constant>(ov::element::i64, ov::Shape{1}, 0);
+  auto axis_1 = make_shared<opset::Constant>(ov::element::i64, ov::Shape{1}, 1);
+  auto x_shape = ConstructNgNode<opset::ShapeOf>(op->name(), x);
+  ov::OutputVector outputs;
+  if (attrs.FitsOpenVINO() && ReadsOnlyOutputs(op, {6})) {
+    ov::Output<ov::Node> ng_w, ng_r, ng_b;
+    int64_t cell_size;
+    TF_RETURN_IF_ERROR(
+        ToOpenVINOLSTMWeights(op, attrs, w, b, ng_w, ng_r, ng_b, cell_size));
+    // The sequence is batch major, with a single direction
+    auto swap_time_batch = make_shared<opset::Constant>(
+        ov::element::i64, ov::Shape{3}, std::vector<int64>{1, 0, 2});
+    auto ng_x =
+        ConstructNgNode<opset::Transpose>(op->name(), x, swap_time_batch);
+    auto ng_h = ConstructNgNode<opset::Unsqueeze>(op->name(), h_prev, axis_1);
+    auto ng_cs = ConstructNgNode<opset::Unsqueeze>(op->name(), cs_prev, axis_1);
+    // Every sequence of the batch runs seq_len_max steps, the outputs of
+    // the steps past it are zero like the ones of TF
+    auto batch = ConstructNgNode<opset::Gather>(op->name(), x_shape, axis_1,
+                                                axis_0);
+    auto lengths = ConstructNgNode<opset::Broadcast>(
+        op->name(),
+        ConstructNgNode<opset::Convert>(op->name(), seq_len_max,
+                                        ov::element::i32),
+        batch);
+    auto sequence = make_shared<opset::LSTMSequence>(
+        ng_x, ng_h, ng_cs, lengths,
+        ConstructNgNode<opset::Unsqueeze>(op->name(), ng_w, axis_0),
+        ConstructNgNode<opset::Unsqueeze>(op->name(), ng_r, axis_0),
+        ConstructNgNode<opset::Unsqueeze>(op->name(), ng_b, axis_0),
+        cell_size, ov::op::RecurrentSequenceDirection::FORWARD);
+    Builder::SetTracingInfo(op->name(), sequence);
+    auto h = ConstructNgNode<opset::Transpose>(
+        op->name(),
+        ConstructNgNode<opset::Squeeze>(op->name(), sequence->output(0),
+                                        axis_1),
+        swap_time_batch);
+    // Only h is read
+    outputs.assign(7, h);
+  } else {
+    // The cell runs once per step, on the slice of x of the step
+    auto step_shape = x.get_partial_shape();
+    if (step_shape.rank().is_static()) step_shape[0] = 1;
+    auto x_param =
+        make_shared<opset::Parameter>(x.get_element_type(), step_shape);
+    ov::ParameterVector body_params{x_param};
+    for (const auto& input : {cs_prev, h_prev, w, wci, wcf, wco, b}) {
+      body_params.push_back(make_shared<opset::Parameter>(
+          input.get_element_type(), input.get_partial_shape()));
+    }
+    // The body has constants of its own
+    auto step_axis =
+        make_shared<opset::Constant>(ov::element::i64, ov::Shape{1}, 0);
+    auto cell = ComputeLSTMCell(
+        op->name(), attrs,
+        ConstructNgNode<opset::Squeeze>(op->name(), x_param, step_axis),
+        body_params[1], body_params[2], body_params[3], body_params[4],
+        body_params[5], body_params[6], body_params[7]);
+    ov::ResultVector body_results;
+    for (const auto& output : cell) {
+      body_results.push_back(make_shared<opset::Result>(
+          ConstructNgNode<opset::Unsqueeze>(op->name(), output, step_axis)));
+    }
+    auto cs_result = make_shared<opset::Result>(cell[1]);
+    auto h_result = make_shared<opset::Result>(cell[6]);
+    body_results.push_back(cs_result);
+    body_results.push_back(h_result);
+
+    auto iterator = make_shared<opset::TensorIterator>();
+    iterator->set_function(make_shared<ov::Model>(body_results, body_params,
+                                                  op->name() + "/body"));
+    iterator->set_sliced_input(x_param, x, 0, 1, 1, -1, 0);
+    iterator->set_merged_input(body_params[1], cs_prev, cs_result);
+    iterator->set_merged_input(body_params[2], h_prev, h_result);
+    ov::OutputVector invariants{w, wci, wcf, wco, b};
+    for (size_t i = 0; i < invariants.size(); i++) {
+      iterator->set_invariant_input(body_params[3 + i], invariants[i]);
+    }
+    ov::OutputVector concatenated;
+    for (size_t i = 0; i < cell.size(); i++) {
+      concatenated.push_back(iterator->get_concatenated_slices(
+          body_results[i], 0, 1, 1, -1, 0));
+    }
+    iterator->validate_and_infer_types();
+    Builder::SetTracingInfo(op->name(), iterator);
+
+    // The outputs of the steps past seq_len_max are zero
+    auto zero = make_shared<opset::Constant>(ov::element::i64, ov::Shape{}, 0);
+    auto one = make_shared<opset::Constant>(ov::element::i64, ov::Shape{}, 1);
+    auto time = ConstructNgNode<opset::Gather>(op->name(), x_shape, zero, zero);
+    auto steps = ConstructNgNode<opset::Range>(op->name(), zero, time, one,
+                                               ov::element::i64);
+    auto running = ConstructNgNode<opset::Less>(
+        op->name(), steps,
+        ConstructNgNode<opset::Convert>(op->name(), seq_len_max,
+                                        ov::element::i64));
+    auto mask_shape = make_shared<opset::Constant>(
+        ov::element::i64, ov::Shape{3}, std::vector<int64>{-1, 1, 1});
+    auto mask = ConstructNgNode<opset::Reshape>(
+        op->name(),
+        ConstructNgNode<opset::Convert>(op->name(), running,
+                                        x.get_element_type()),
+        mask_shape, false);
+    for (const auto& output : concatenated) {
+      outputs.push_back(
+          ConstructNgNode<opset::Multiply>(op->name(), output, mask));
+    }
+  }
+
+  for (const auto& output : outputs) {
+    SaveNgOp(ng_op_map, op->name(), output);
+  }
+  return Status::OK();
+}
+
 static Status TranslateCastOp(const Node* op, const std::vector<const Tensor*>&,
                               Builder::OpMap& ng_op_map) {
   ov::Output<ov::Node> ng_input;
@@ -1612,14 +2096,12 @@ static Status TranslateExpandDimsOp(
   return Status::OK();
 }
 
-static Status TranslateFakeQuantWithMinMaxVarsOp(
-    const Node* op, const std::vector<const Tensor*>& static_input_map,
-    Builder::OpMap& ng_op_map) {
-  ov::Output<ov::Node> ng_input, ng_min, ng_max;
-  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 0, ng_input));
-  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 1, ng_min));
-  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 2, ng_max));
-
+// The fake quantization of ng_input to the range [ng_min, ng_max], scalars
+// or, per channel, vectors along the last axis
+static Status TranslateFakeQuant(const Node* op, ov::Output<ov::Node> ng_input,
+                                 ov::Output<ov::Node> ng_min,
+                                 ov::Output<ov::Node> ng_max,
+                                 bool per_channel, Builder::OpMap& ng_op_map) {
   bool narrow_range = false;
   TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "narrow_range", &narrow_range));
   int64 num_bits;
@@ -1678,14 +2160,339 @@ static Status TranslateFakeQuantWithMinMaxVarsOp(
   auto max_adj =
       ConstructNgNode<opset::Add>(op->name() + "/max_adj", maximum, adjustment);
 
-  auto ng_input_shape = ng_input.get_shape();
-  if (ng_input_shape.size() == 4) Transpose<0, 3, 1, 2>(ng_input);
+  // The ranges of the channels broadcast along the last axis
+  bool transpose = ng_input.get_shape().size() == 4 && !per_channel;
+  if (transpose) Transpose<0, 3, 1, 2>(ng_input);
   auto ng_output = ConstructNgNode<opset::FakeQuantize>(
       op->name(), ng_input, min_adj, max_adj, min_adj, max_adj, levels);
-  if (ng_input_shape.size() == 4) Transpose<0, 2, 3, 1>(ng_output);
+  if (transpose) Transpose<0, 2, 3, 1>(ng_output);
+
+  SaveNgOp(ng_op_map, op->name(), ng_output);
+
+  return Status::OK();
+}
+
+static Status TranslateFakeQuantWithMinMaxVarsOp(
+    const Node* op, const std::vector<const Tensor*>& static_input_map,
+    Builder::OpMap& ng_op_map) {
+  ov::Output<ov::Node> ng_input, ng_min, ng_max;
+  TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_input, ng_min, ng_max));
+  return TranslateFakeQuant(
+      op, ng_input, ng_min, ng_max,
+      op->type_string() == "FakeQuantWithMinMaxVarsPerChannel", ng_op_map);
+}
+
+static Status TranslateFakeQuantWithMinMaxArgsOp(
+    const Node* op, const std::vector<const Tensor*>& static_input_map,
+    Builder::OpMap& ng_op_map) {
+  ov::Output<ov::Node> ng_input;
+  TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_input));
+  float min, max;
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "min", &min));
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "max", &max));
+  auto ng_min = ConstructNgNode<opset::Constant>(
+      op->name(), ov::element::f32, ov::Shape{}, std::vector<float>{min});
+  auto ng_max = ConstructNgNode<opset::Constant>(
+      op->name(), ov::element::f32, ov::Shape{}, std::vector<float>{max});
+  return TranslateFakeQuant(op, ng_input, ng_min, ng_max, false, ng_op_map);
+}
+
+// The TF quantization ops are translated into FakeQuantize, which the low
+// precision transformations of OpenVINO run as int8 kernels, or into the
+// Convert, Subtract and Multiply of the dequantization of int8 weights.
+
+// The integers of a quantized type
+static Status GetQuantizedRange(const Node* op, DataType dtype,
+                                int64_t& lowest, int64_t& highest) {
+  switch (dtype) {
+    case DT_QINT8:
+      lowest = -128;
+      highest = 127;
+      return Status::OK();
+    case DT_QUINT8:
+      lowest = 0;
+      highest = 255;
+      return Status::OK();
+    default:
+      return errors::Unimplemented(op->name(), " quantizes to ",
+                                   DataTypeString(dtype));
+  }
+}
+
+static ov::Output<ov::Node> FloatConstant(const string& op_name,
+                                          double value) {
+  return ConstructNgNode<opset::Constant>(op_name, ov::element::f32,
+                                          ov::Shape{},
+                                          std::vector<float>{(float)value});
+}
+
+// Reshapes a range of the quantization ops, a scalar or a vector along axis
+// of the input, so that it broadcasts to the input. An axis of -1 quantizes
+// the whole tensor.
+static Status BroadcastRange(const Node* op, int64_t axis,
+                             const ov::Output<ov::Node>& ng_input,
+                             ov::Output<ov::Node>& range) {
+  if (axis == -1) return Status::OK();
+  auto rank = ng_input.get_partial_shape().rank();
+  if (rank.is_dynamic() || axis < 0 || axis >= rank.get_length()) {
+    return errors::InvalidArgument("Invalid quantization axis ", axis,
+                                   " of ", op->name());
+  }
+  std::vector<int64> shape(rank.get_length(), 1);
+  shape[axis] = -1;
+  auto ng_shape = ConstructNgNode<opset::Constant>(
+      op->name(), ov::element::i64, ov::Shape{shape.size()}, shape);
+  range = ConstructNgNode<opset::Reshape>(op->name(), range, ng_shape, false);
+  return Status::OK();
+}
+
+// The range of the SCALED mode, on which the integers q_min to q_max are the
+// multiples of a single scale: the smaller of the scales fitting either side
+// of [low, high]
+static void ScaledRange(const string& op_name, int64_t q_min, int64_t q_max,
+                        ov::Output<ov::Node>& low, ov::Output<ov::Node>& high) {
+  auto zero = FloatConstant(op_name, 0.0);
+  auto no_scale = FloatConstant(op_name, std::numeric_limits<float>::max());
+  auto side_scale = [&](const ov::Output<ov::Node>& bound, int64_t q) {
+    auto ng_q = FloatConstant(op_name, q);
+    auto has_sign = ConstructNgNode<opset::Greater>(
+        op_name, ConstructNgNode<opset::Multiply>(op_name, bound, ng_q), zero);
+    return ConstructNgNode<opset::Select>(
+        op_name, has_sign, ConstructNgNode<opset::Divide>(op_name, ng_q, bound),
+        no_scale);
+  };
+  auto scale = ConstructNgNode<opset::Minimum>(op_name, side_scale(low, q_min),
+                                               side_scale(high, q_max));
+  low = ConstructNgNode<opset::Divide>(op_name, FloatConstant(op_name, q_min),
+                                       scale);
+  high = ConstructNgNode<opset::Divide>(op_name, FloatConstant(op_name, q_max),
+                                        scale);
+}
+
+// QuantizeAndDequantize rounds its input to the integers of num_bits bits
+// and scales them back
+static Status TranslateQuantizeAndDequantizeOp(
+    const Node* op, const std::vector<const Tensor*>& static_input_map,
+    Builder::OpMap& ng_op_map) {
+  ov::Output<ov::Node> ng_input, ng_min, ng_max;
+  TF_RETURN_IF_ERROR(ValidateInputCountMin(op, 3));
+  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 0, ng_input));
+  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 1, ng_min));
+  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 2, ng_max));
+
+  bool signed_input, range_given, narrow_range;
+  int64 axis;
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "signed_input", &signed_input));
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "range_given", &range_given));
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "narrow_range", &narrow_range));
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "axis", &axis));
+  int64 num_bits;
+  if (op->type_string() == "QuantizeAndDequantizeV3") {
+    std::vector<int64> num_bits_vec;
+    TF_RETURN_IF_ERROR(
+        GetStaticInputVector(op, 3, static_input_map, &num_bits_vec));
+    if (num_bits_vec.size() != 1) {
+      return errors::InvalidArgument("num_bits of ", op->name(),
+                                     " must be a scalar");
+    }
+    num_bits = num_bits_vec[0];
+  } else {
+    TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "num_bits", &num_bits));
+  }
+  if (num_bits < 1 || num_bits > 16) {
+    return errors::InvalidArgument("Invalid num_bits ", num_bits, " of ",
+                                   op->name());
+  }
+
+  if (!range_given) {
+    // The range of the input, per slice along axis
+    auto rank = ng_input.get_partial_shape().rank();
+    if (rank.is_dynamic()) {
+      return errors::InvalidArgument("The input of ", op->name(),
+                                     " must have a static rank");
+    }
+    std::vector<int64> reduced;
+    for (int64 i = 0; i < rank.get_length(); i++) {
+      if (i != axis) reduced.push_back(i);
+    }
+    auto ng_axes = ConstructNgNode<opset::Constant>(
+        op->name(), ov::element::i64, ov::Shape{reduced.size()}, reduced);
+    bool keep_dims = axis != -1;
+    ng_min = ConstructNgNode<opset::ReduceMin>(op->name(), ng_input, ng_axes,
+                                               keep_dims);
+    ng_max = ConstructNgNode<opset::ReduceMax>(op->name(), ng_input, ng_axes,
+                                               keep_dims);
+  } else {
+    TF_RETURN_IF_ERROR(BroadcastRange(op, axis, ng_input, ng_min));
+    TF_RETURN_IF_ERROR(BroadcastRange(op, axis, ng_input, ng_max));
+  }
 
+  int64_t q_min = 0, q_max = (int64_t{1} << num_bits) - 1;
+  if (signed_input) {
+    q_min = -(int64_t{1} << (num_bits - 1)) + (narrow_range ? 1 : 0);
+    q_max = (int64_t{1} << (num_bits - 1)) - 1;
+  }
+  ScaledRange(op->name(), q_min, q_max, ng_min, ng_max);
+  auto ng_output = ConstructNgNode<opset::FakeQuantize>(
+      op->name(), ng_input, ng_min, ng_max, ng_min, ng_max,
+      q_max - q_min + 1);
   SaveNgOp(ng_op_map, op->name(), ng_output);
+  return Status::OK();
+}
+
+// The range QuantizeV2 quantizes to, which contains zero and is not too
+// narrow, as computed by TF
+static void QuantizeV2Range(const Node* op, float ensure_minimum_range,
+                            ov::Output<ov::Node>& ng_min,
+                            ov::Output<ov::Node>& ng_max) {
+  auto zero = FloatConstant(op->name(), 0.0);
+  auto epsilon = ConstructNgNode<opset::Multiply>(
+      op->name(),
+      ConstructNgNode<opset::Maximum>(
+          op->name(), FloatConstant(op->name(), 1.0),
+          ConstructNgNode<opset::Maximum>(
+              op->name(), ConstructNgNode<opset::Abs>(op->name(), ng_min),
+              ConstructNgNode<opset::Abs>(op->name(), ng_max))),
+      FloatConstant(op->name(), ensure_minimum_range));
+  ng_min = ConstructNgNode<opset::Minimum>(op->name(), ng_min, zero);
+  ng_max = ConstructNgNode<opset::Maximum>(
+      op->name(),
+      ConstructNgNode<opset::Maximum>(
+          op->name(), ng_max,
+          ConstructNgNode<opset::Add>(op->name(), ng_min, epsilon)),
+      zero);
+}
+
+static Status TranslateQuantizeV2Op(const Node* op,
+                                    const std::vector<const Tensor*>&,
+                                    Builder::OpMap& ng_op_map) {
+  ov::Output<ov::Node> ng_input, ng_min, ng_max;
+  TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_input, ng_min, ng_max));
+
+  DataType dtype;
+  string mode;
+  bool narrow_range;
+  int64 axis;
+  float ensure_minimum_range;
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "T", &dtype));
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "mode", &mode));
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "narrow_range", &narrow_range));
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "axis", &axis));
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "ensure_minimum_range",
+                                 &ensure_minimum_range));
+  int64_t lowest, highest;
+  TF_RETURN_IF_ERROR(GetQuantizedRange(op, dtype, lowest, highest));
+  ov::element::Type ng_et;
+  TF_RETURN_IF_ERROR(util::TFDataTypeToNGraphElementType(dtype, &ng_et));
+
+  TF_RETURN_IF_ERROR(BroadcastRange(op, axis, ng_input, ng_min));
+  TF_RETURN_IF_ERROR(BroadcastRange(op, axis, ng_input, ng_max));
+  QuantizeV2Range(op, ensure_minimum_range, ng_min, ng_max);
+  int64_t q_min = lowest;
+  if (mode == "SCALED") {
+    q_min += narrow_range ? 1 : 0;
+    ScaledRange(op->name(), q_min, highest, ng_min, ng_max);
+  } else if (mode != "MIN_COMBINED") {
+    return errors::Unimplemented("Quantization mode ", mode, " of ",
+                                 op->name());
+  }
+
+  // The integers, rounded by a FakeQuantize with the range of the output
+  auto ng_quantized = ConstructNgNode<opset::FakeQuantize>(
+      op->name(), ng_input, ng_min, ng_max, FloatConstant(op->name(), q_min),
+      FloatConstant(op->name(), highest), highest - q_min + 1);
+  SaveNgOp(ng_op_map, op->name(),
+           ConstructNgNode<opset::Convert>(op->name(), ng_quantized, ng_et));
+  SaveNgOp(ng_op_map, op->name(), ng_min);
+  SaveNgOp(ng_op_map, op->name(), ng_max);
+  return Status::OK();
+}
+
+// The QuantizeV2 whose outputs all feed op, which quantized in the same way
+static const Node* GetQuantizingOp(const Node* op, const string& mode,
+                                   bool narrow_range) {
+  const Node* quantize = nullptr;
+  for (const Edge* edge : op->in_edges()) {
+    if (edge->IsControlEdge()) continue;
+    if (edge->src()->type_string() != "QuantizeV2" ||
+        edge->src_output() != edge->dst_input() ||
+        (quantize != nullptr && edge->src() != quantize)) {
+      return nullptr;
+    }
+    quantize = edge->src();
+  }
+  string quantize_mode;
+  bool quantize_narrow_range;
+  if (quantize == nullptr ||
+      !GetNodeAttr(quantize->attrs(), "mode", &quantize_mode).ok() ||
+      !GetNodeAttr(quantize->attrs(), "narrow_range", &quantize_narrow_range)
+           .ok() ||
+      quantize_mode != mode || quantize_narrow_range != narrow_range) {
+    return nullptr;
+  }
+  return quantize;
+}
+
+static Status TranslateDequantizeOp(const Node* op,
+                                    const std::vector<const Tensor*>&,
+                                    Builder::OpMap& ng_op_map) {
+  ov::Output<ov::Node> ng_input, ng_min, ng_max;
+  TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_input, ng_min, ng_max));
+
+  DataType dtype;
+  string mode;
+  bool narrow_range;
+  int64 axis;
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "T", &dtype));
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "mode", &mode));
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "narrow_range", &narrow_range));
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "axis", &axis));
+  int64_t lowest, highest;
+  TF_RETURN_IF_ERROR(GetQuantizedRange(op, dtype, lowest, highest));
+  if (mode != "SCALED" && mode != "MIN_COMBINED") {
+    return errors::Unimplemented("Quantization mode ", mode, " of ",
+                                 op->name());
+  }
+  TF_RETURN_IF_ERROR(BroadcastRange(op, axis, ng_input, ng_min));
+  TF_RETURN_IF_ERROR(BroadcastRange(op, axis, ng_input, ng_max));
+
+  int64_t q_min = lowest + (mode == "SCALED" && narrow_range ? 1 : 0);
+  const Node* quantize = GetQuantizingOp(op, mode, narrow_range);
+  if (quantize != nullptr) {
+    // A quantization followed by its dequantization is a FakeQuantize of
+    // the float input, on the range the integers stand for
+    ov::Output<ov::Node> ng_float;
+    TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, quantize, 0, ng_float));
+    auto ng_output = ConstructNgNode<opset::FakeQuantize>(
+        op->name(), ng_float, ng_min, ng_max, ng_min, ng_max,
+        highest - q_min + 1);
+    SaveNgOp(ng_op_map, op->name(), ng_output);
+    return Status::OK();
+  }
 
+  // The dequantization of integers, such as int8 weights
+  auto ng_output = ConstructNgNode<opset::Convert>(op->name(), ng_input,
+                                                   ov::element::f32);
+  if (mode == "MIN_COMBINED") {
+    auto range = ConstructNgNode<opset::Subtract>(op->name(), ng_max, ng_min);
+    auto scale = ConstructNgNode<opset::Divide>(
+        op->name(), range, FloatConstant(op->name(), highest - lowest));
+    ng_output = ConstructNgNode<opset::Subtract>(
+        op->name(), ng_output, FloatConstant(op->name(), lowest));
+    ng_output = ConstructNgNode<opset::Multiply>(op->name(), ng_output, scale);
+    ng_output = ConstructNgNode<opset::Add>(op->name(), ng_output, ng_min);
+  } else {
+    ov::Output<ov::Node> scale = ConstructNgNode<opset::Divide>(
+        op->name(), ng_max, FloatConstant(op->name(), highest));
+    if (lowest != 0) {
+      scale = ConstructNgNode<opset::Maximum>(
+          op->name(), scale,
+          ConstructNgNode<opset::Divide>(op->name(), ng_min,
+                                         FloatConstant(op->name(), q_min)));
+    }
+    ng_output = ConstructNgNode<opset::Multiply>(op->name(), ng_output, scale);
+  }
+  SaveNgOp(ng_op_map, op->name(), ng_output);
   return Status::OK();
 }
 
@@ -1828,6 +2635,74 @@ static Status TranslateFusedMatMulOp(const Node* op,
 
 // See .../tensorflow/include/tensorflow/cc/ops/array_ops.h
 // and .../openvino/ngraph/core/include/ngraph/op/gather.hpp
+static Status TranslateGRUBlockCellOp(const Node* op,
+                                      const std::vector<const Tensor*>&,
+                                      Builder::OpMap& ng_op_map) {
+  ov::Output<ov::Node> x, h_prev, w_ru, w_c, b_ru, b_c;
+  TF_RETURN_IF_ERROR(
+      GetInputNodes(ng_op_map, op, x, h_prev, w_ru, w_c, b_ru, b_c));
+
+  auto axis_0 = make_shared<opset::Constant>(ov::element::i64, ov::Shape{}, 0);
+  auto axis_1 = make_shared<opset::Constant>(ov::element::i64, ov::Shape{}, 1);
+  ov::OutputVector outputs;
+  if (ReadsOnlyOutputs(op, {3})) {
+    int64_t cell_size;
+    TF_RETURN_IF_ERROR(GetCellSize(op, w_c, 1, cell_size));
+    // OpenVINO orders the gates z, the TF u, then r and h
+    auto ru = ConstructNgNode<opset::Split>(op->name(), w_ru, axis_1, 2);
+    auto weights = ConstructNgNode<opset::Concat>(
+        op->name(),
+        ov::OutputVector{ru.get_node()->output(1), ru.get_node()->output(0),
+                         w_c},
+        1);
+    ov::Output<ov::Node> ng_w, ng_r;
+    SplitRecurrentWeights(op->name(), weights, cell_size, ng_w, ng_r);
+    auto b_split = ConstructNgNode<opset::Split>(op->name(), b_ru, axis_0, 2);
+    auto ng_b = ConstructNgNode<opset::Concat>(
+        op->name(),
+        ov::OutputVector{b_split.get_node()->output(1),
+                         b_split.get_node()->output(0), b_c},
+        0);
+    auto cell = ConstructNgNode<opset::GRUCell>(op->name(), x, h_prev, ng_w,
+                                                ng_r, ng_b, cell_size);
+    // Only h is read
+    outputs.assign(4, cell);
+  } else {
+    auto xh = ConstructNgNode<opset::Concat>(
+        op->name(), ov::OutputVector{x, h_prev}, 1);
+    auto gates = ConstructNgNode<opset::Sigmoid>(
+        op->name(),
+        ConstructNgNode<opset::Add>(
+            op->name(), ConstructNgNode<opset::MatMul>(op->name(), xh, w_ru),
+            b_ru));
+    auto split = ConstructNgNode<opset::Split>(op->name(), gates, axis_1, 2);
+    auto r = split.get_node()->output(0);
+    auto u = split.get_node()->output(1);
+    auto xrh = ConstructNgNode<opset::Concat>(
+        op->name(),
+        ov::OutputVector{
+            x, ConstructNgNode<opset::Multiply>(op->name(), r, h_prev)},
+        1);
+    auto c = ConstructNgNode<opset::Tanh>(
+        op->name(),
+        ConstructNgNode<opset::Add>(
+            op->name(), ConstructNgNode<opset::MatMul>(op->name(), xrh, w_c),
+            b_c));
+    // h = u * h_prev + (1 - u) * c
+    auto h = ConstructNgNode<opset::Add>(
+        op->name(), c,
+        ConstructNgNode<opset::Multiply>(
+            op->name(), u,
+            ConstructNgNode<opset::Subtract>(op->name(), h_prev, c)));
+    outputs = {r, u, c, h};
+  }
+
+  for (const auto& output : outputs) {
+    SaveNgOp(ng_op_map, op->name(), output);
+  }
+  return Status::OK();
+}
+
 static Status TranslateGatherOp(
     const Node* op, const std::vector<const Tensor*>& static_input_map,
     Builder::OpMap& ng_op_map) {
@@ -1874,11 +2749,19 @@ static Status TranslateGatherV2Op(
                                    "), but got ", tf_axis[0]);
   }
 
+  // The ResourceGathers split into a ReadVariableOp and a GatherV2 keep
+  // their batch dimensions
+  int64 batch_dims = 0;
+  if (TryGetNodeAttr(op->attrs(), "batch_dims", &batch_dims) &&
+      batch_dims < 0) {
+    batch_dims += ng_input_coords.get_partial_shape().rank().get_length();
+  }
+
   auto ng_axis = ConstructNgNode<opset::Constant>(
       op->name(), ov::element::i64, ov::Shape{tf_axis.size()}, tf_axis);
 
-  auto gather_op = ConstructNgNode<opset::Gather>(op->name(), ng_input,
-                                                  ng_input_coords, ng_axis);
+  auto gather_op = ConstructNgNode<opset::Gather>(
+      op->name(), ng_input, ng_input_coords, ng_axis, batch_dims);
 
   SaveNgOp(ng_op_map, op->name(), gather_op);
   return Status::OK();
@@ -2348,6 +3231,38 @@ static Status TranslateL2LossOp(const Node* op,
   return Status::OK();
 }
 
+static Status TranslateLSTMBlockCellOp(const Node* op,
+                                       const std::vector<const Tensor*>&,
+                                       Builder::OpMap& ng_op_map) {
+  ov::Output<ov::Node> x, cs_prev, h_prev, w, wci, wcf, wco, b;
+  TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, x, cs_prev, h_prev, w, wci,
+                                   wcf, wco, b));
+  LSTMAttrs attrs;
+  TF_RETURN_IF_ERROR(GetLSTMAttrs(op, attrs));
+
+  ov::OutputVector outputs;
+  if (attrs.FitsOpenVINO() && ReadsOnlyOutputs(op, {1, 6})) {
+    ov::Output<ov::Node> ng_w, ng_r, ng_b;
+    int64_t cell_size;
+    TF_RETURN_IF_ERROR(
+        ToOpenVINOLSTMWeights(op, attrs, w, b, ng_w, ng_r, ng_b, cell_size));
+    auto cell = make_shared<opset::LSTMCell>(x, h_prev, cs_prev, ng_w, ng_r,
+                                             ng_b, cell_size);
+    Builder::SetTracingInfo(op->name(), cell);
+    // Only cs and h are read
+    outputs.assign(7, cell->output(0));
+    outputs[1] = cell->output(1);
+  } else {
+    outputs = ComputeLSTMCell(op->name(), attrs, x, cs_prev, h_prev, w, wci,
+                              wcf, wco, b);
+  }
+
+  for (const auto& output : outputs) {
+    SaveNgOp(ng_op_map, op->name(), output);
+  }
+  return Status::OK();
+}
+
 static Status TranslateLog1pOp(
     const Node* op, const std::vector<const Tensor*>& static_input_map,
     Builder::OpMap& ng_op_map) {
@@ -2502,6 +3417,18 @@ static Status TranslateMaxPoolOp(const Node* op,
   return Status::OK();
 }
 
+// At most max_output_size boxes are selected, and no more than there are
+static ov::Shape NonMaxSuppressionBound(const ov::Output<ov::Node>& ng_boxes,
+                                        int max_output_size) {
+  size_t bound = std::max(max_output_size, 0);
+  const auto& boxes_shape = ng_boxes.get_partial_shape();
+  if (boxes_shape.rank().is_static() && boxes_shape.rank().get_length() > 0 &&
+      boxes_shape[0].is_static()) {
+    bound = std::min<size_t>(bound, boxes_shape[0].get_length());
+  }
+  return ov::Shape{bound};
+}
+
 static Status TranslateNonMaxSuppressionV2Op(
     const Node* op, const std::vector<const Tensor*>& static_input_map,
     Builder::OpMap& ng_op_map) {
@@ -2553,6 +3480,8 @@ static Status TranslateNonMaxSuppressionV2Op(
       std::vector<int64_t>{0, 1});
 
   Builder::SetTracingInfo(op->name(), ng_nmsv_slice);
+  Builder::SetOutputBound(ng_nmsv_slice,
+                          NonMaxSuppressionBound(ng_boxes, max_output_size[0]));
   SaveNgOp(ng_op_map, op->name(), ng_nmsv_slice);
   return Status::OK();
 }
@@ -2610,35 +3539,288 @@ static Status TranslateNonMaxSuppressionV3Op(
       std::vector<int64_t>{0, 1});
 
   Builder::SetTracingInfo(op->name(), ng_nmsv_slice);
+  Builder::SetOutputBound(ng_nmsv_slice,
+                          NonMaxSuppressionBound(ng_boxes, max_output_size[0]));
   SaveNgOp(ng_op_map, op->name(), ng_nmsv_slice);
   return Status::OK();
 }
 
-static Status TranslateReduceOp(
+// NonMaxSuppressionV4 and V5, which may pad the selected indices with zeros
+// up to max_output_size, and return the number of valid ones. V5 also
+// returns the scores of the selected boxes, decayed by soft NMS.
+static Status TranslateNonMaxSuppressionPaddedOp(
     const Node* op, const std::vector<const Tensor*>& static_input_map,
-    Builder::OpMap& ng_op_map,
-    std::function<ov::Output<ov::Node>(ov::Output<ov::Node>,
-                                       ov::Output<ov::Node>, const bool)>
-        create_ng_node) {
-  ov::Output<ov::Node> ng_input;
-  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 0, ng_input));
-  bool tf_keep_dims;
-  if (GetNodeAttr(op->attrs(), "keep_dims", &tf_keep_dims) != Status::OK()) {
-    tf_keep_dims = false;
+    Builder::OpMap& ng_op_map, bool with_scores) {
+  ov::Output<ov::Node> ng_boxes, ng_scores, ng_iou_threshold,
+      ng_score_threshold, ng_soft_nms_sigma;
+  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 0, ng_boxes));
+  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 1, ng_scores));
+  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 3, ng_iou_threshold));
+  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 4, ng_score_threshold));
+  if (with_scores) {
+    TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 5, ng_soft_nms_sigma));
+  } else {
+    ng_soft_nms_sigma = ConstructNgNode<opset::Constant>(
+        op->name(), ng_scores.get_element_type(), ov::Shape{}, 0);
   }
+  bool pad_to_max_output_size;
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "pad_to_max_output_size",
+                                 &pad_to_max_output_size));
 
-  std::vector<int64> axes;
-  TF_RETURN_IF_ERROR(GetStaticInputVector(op, 1, static_input_map, &axes));
+  std::vector<int> max_output_size;
+  TF_RETURN_IF_ERROR(
+      GetStaticInputVector(op, 2, static_input_map, &max_output_size));
+  if (max_output_size.size() != 1) {
+    return errors::InvalidArgument(
+        "NonMaxSuppression Op: max_output_size of nms must be scalar ",
+        max_output_size.size());
+  }
+  int64 max_output = std::max(max_output_size[0], 0);
 
-  size_t input_rank = ng_input.get_partial_shape().rank().get_length();
+  // A batch of one image with one class
+  auto ng_axis = ConstructNgNode<opset::Constant>(
+      op->name(), ov::element::i64, ov::Shape{1}, std::vector<int64>({0}));
+  auto ng_boxes_unsqueezed =
+      ConstructNgNode<opset::Unsqueeze>(op->name(), ng_boxes, ng_axis);
+  auto ng_scores_unsqueezed = ConstructNgNode<opset::Unsqueeze>(
+      op->name(),
+      ConstructNgNode<opset::Unsqueeze>(op->name(), ng_scores, ng_axis),
+      ng_axis);
+  auto ng_max_output_size = ConstructNgNode<opset::Constant>(
+      op->name(), ov::element::i64, ov::Shape{}, max_output);
+  auto ng_nms = std::make_shared<opset::NonMaxSuppression>(
+      ng_boxes_unsqueezed, ng_scores_unsqueezed, ng_max_output_size,
+      ng_iou_threshold, ng_score_threshold, ng_soft_nms_sigma,
+      opset::NonMaxSuppression::BoxEncodingType::CORNER, false,
+      ov::element::Type_t::i32);
+  Builder::SetTracingInfo(op->name(), ng_nms->output(0));
 
-  TF_RETURN_IF_ERROR(CheckAxisDimInRange(axes, input_rank));
+  // The last column of the selected triplets, the box or its score
+  auto begin = ConstructNgNode<opset::Constant>(
+      op->name(), ov::element::i64, ov::Shape{2}, std::vector<int64>({0, 2}));
+  auto end = ConstructNgNode<opset::Constant>(
+      op->name(), ov::element::i64, ov::Shape{2},
+      std::vector<int64>({max_output, 3}));
+  auto last_column = [&](const ov::Output<ov::Node>& selected) {
+    ov::Output<ov::Node> column = ConstructNgNode<opset::StridedSlice>(
+        op->name(), selected, begin, end, std::vector<int64_t>{0, 0},
+        std::vector<int64_t>{0, 0}, std::vector<int64_t>{0, 0},
+        std::vector<int64_t>{0, 1});
+    if (!pad_to_max_output_size) {
+      Builder::SetOutputBound(column,
+                              NonMaxSuppressionBound(ng_boxes, max_output));
+      return column;
+    }
+    // Gathering max_output entries of the column followed by as many zeros
+    // gives the static shape
+    auto zeros = ConstructNgNode<opset::Constant>(
+        op->name(), column.get_element_type(), ov::Shape{size_t(max_output)},
+        0);
+    auto padded = ConstructNgNode<opset::Concat>(
+        op->name(), ov::OutputVector{column, zeros}, 0);
+    std::vector<int64> slots(max_output);
+    std::iota(slots.begin(), slots.end(), 0);
+    auto ng_slots = ConstructNgNode<opset::Constant>(
+        op->name(), ov::element::i64, ov::Shape{slots.size()}, slots);
+    return ConstructNgNode<opset::Gather>(op->name(), padded, ng_slots,
+                                          ng_axis);
+  };
 
-  std::vector<size_t> ng_reduction_axes_vect(axes.size());
-  std::transform(
-      axes.begin(), axes.end(), ng_reduction_axes_vect.begin(),
-      [input_rank](int idx) { return idx + (idx < 0 ? (int)input_rank : 0); });
-  auto ng_reduction_axes = ConstructNgNode<opset::Constant>(
+  SaveNgOp(ng_op_map, op->name(), last_column(ng_nms->output(0)));
+  if (with_scores) {
+    SaveNgOp(ng_op_map, op->name(), last_column(ng_nms->output(1)));
+  }
+  SaveNgOp(ng_op_map, op->name(),
+           ConstructNgNode<opset::Squeeze>(op->name(), ng_nms->output(2),
+                                           ng_axis));
+  return Status::OK();
+}
+
+static Status TranslateNonMaxSuppressionV4Op(
+    const Node* op, const std::vector<const Tensor*>& static_input_map,
+    Builder::OpMap& ng_op_map) {
+  return TranslateNonMaxSuppressionPaddedOp(op, static_input_map, ng_op_map,
+                                            false);
+}
+
+static Status TranslateNonMaxSuppressionV5Op(
+    const Node* op, const std::vector<const Tensor*>& static_input_map,
+    Builder::OpMap& ng_op_map) {
+  return TranslateNonMaxSuppressionPaddedOp(op, static_input_map, ng_op_map,
+                                            true);
+}
+
+// The NMS of the batched detection heads, over every class of every image,
+// into a MulticlassNms. Its selections of all the images are packed into
+// rows, which are gathered into the max_detections padded rows per image
+// of TF, with static shapes. MulticlassNms limits the boxes per image, not
+// per class, which is only translated when the limit per class can not
+// bind, as with the default configs of the TF Object Detection API. The
+// boxes must be shared by the classes.
+static Status TranslateCombinedNonMaxSuppressionOp(
+    const Node* op, const std::vector<const Tensor*>& static_input_map,
+    Builder::OpMap& ng_op_map) {
+  ov::Output<ov::Node> ng_boxes, ng_scores;
+  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 0, ng_boxes));
+  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 1, ng_scores));
+  std::vector<int> max_output_size_per_class, max_total_size;
+  std::vector<float> iou_threshold, score_threshold;
+  TF_RETURN_IF_ERROR(GetStaticInputVector(op, 2, static_input_map,
+                                          &max_output_size_per_class));
+  TF_RETURN_IF_ERROR(
+      GetStaticInputVector(op, 3, static_input_map, &max_total_size));
+  TF_RETURN_IF_ERROR(
+      GetStaticInputVector(op, 4, static_input_map, &iou_threshold));
+  TF_RETURN_IF_ERROR(
+      GetStaticInputVector(op, 5, static_input_map, &score_threshold));
+  if (max_output_size_per_class.size() != 1 || max_total_size.size() != 1 ||
+      iou_threshold.size() != 1 || score_threshold.size() != 1) {
+    return errors::InvalidArgument(
+        "CombinedNonMaxSuppression Op: the sizes and the thresholds must be "
+        "scalars");
+  }
+  bool pad_per_class, clip_boxes;
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "pad_per_class", &pad_per_class));
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "clip_boxes", &clip_boxes));
+
+  const auto& boxes_shape = ng_boxes.get_partial_shape();
+  const auto& scores_shape = ng_scores.get_partial_shape();
+  if (boxes_shape.rank().is_dynamic() || boxes_shape.rank().get_length() != 4 ||
+      boxes_shape[2] != 1 || scores_shape.rank().is_dynamic() ||
+      scores_shape.rank().get_length() != 3) {
+    return errors::Unimplemented(
+        "CombinedNonMaxSuppression Op: only translated for boxes shared by "
+        "the classes, ",
+        op->name(), " has boxes of shape ", boxes_shape.to_string());
+  }
+  int64 per_class = std::max(max_output_size_per_class[0], 0);
+  int64 max_detections = std::max(max_total_size[0], 0);
+  if (pad_per_class) {
+    if (scores_shape[2].is_dynamic()) {
+      return errors::Unimplemented(
+          "CombinedNonMaxSuppression Op: the classes of ", op->name(),
+          " padded per class are unknown");
+    }
+    max_detections = std::min<int64>(
+        max_detections, per_class * scores_shape[2].get_length());
+  }
+  if (per_class < max_detections) {
+    return errors::Unimplemented(
+        "CombinedNonMaxSuppression Op: ", op->name(), " selects at most ",
+        per_class, " boxes per class, fewer than its ", max_detections,
+        " detections");
+  }
+
+  // [batch, boxes, 4] and [batch, classes, boxes]
+  auto ng_boxes_shared = ConstructNgNode<opset::Squeeze>(
+      op->name(), ng_boxes,
+      ConstructNgNode<opset::Constant>(op->name(), ov::element::i64,
+                                       ov::Shape{1}, std::vector<int64>{2}));
+  auto ng_scores_by_class = ConstructNgNode<opset::Transpose>(
+      op->name(), ng_scores,
+      ConstructNgNode<opset::Constant>(op->name(), ov::element::i64,
+                                       ov::Shape{3},
+                                       std::vector<int64>{0, 2, 1}));
+  opset::MulticlassNms::Attributes attrs;
+  attrs.sort_result_type = opset::MulticlassNms::SortResultType::SCORE;
+  attrs.sort_result_across_batch = false;
+  attrs.output_type = ov::element::i64;
+  attrs.iou_threshold = iou_threshold[0];
+  attrs.score_threshold = score_threshold[0];
+  attrs.nms_top_k = -1;
+  attrs.keep_top_k = max_detections;
+  attrs.background_class = -1;
+  attrs.normalized = true;
+  auto ng_nms = std::make_shared<opset::MulticlassNms>(
+      ng_boxes_shared, ng_scores_by_class, attrs);
+  Builder::SetTracingInfo(op->name(), ng_nms->output(0));
+
+  // The rows of image b start after those of the images before it, the row
+  // of zeros appended after the rows of all the images pads the images with
+  // fewer detections
+  auto zero = ConstructNgNode<opset::Constant>(op->name(), ov::element::i64,
+                                               ov::Shape{}, 0);
+  auto one = ConstructNgNode<opset::Constant>(
+      op->name(), ov::element::i64, ov::Shape{1}, std::vector<int64>{1});
+  auto ng_num = ng_nms->output(2);
+  auto rows = ConstructNgNode<opset::Concat>(
+      op->name(),
+      ov::OutputVector{ng_nms->output(0),
+                       ConstructNgNode<opset::Constant>(
+                           op->name(), ng_boxes.get_element_type(),
+                           ov::Shape{1, 6}, 0)},
+      0);
+  auto first = ConstructNgNode<opset::Unsqueeze>(
+      op->name(),
+      ConstructNgNode<opset::CumSum>(op->name(), ng_num, zero, true, false),
+      one);
+  auto padding_row =
+      ConstructNgNode<opset::ReduceSum>(op->name(), ng_num, zero, false);
+  std::vector<int64> slots(max_detections);
+  std::iota(slots.begin(), slots.end(), 0);
+  auto ng_slots = ConstructNgNode<opset::Constant>(
+      op->name(), ov::element::i64, ov::Shape{1, slots.size()}, slots);
+  auto valid = ConstructNgNode<opset::Less>(
+      op->name(), ng_slots,
+      ConstructNgNode<opset::Unsqueeze>(op->name(), ng_num, one));
+  auto index = ConstructNgNode<opset::Select>(
+      op->name(), valid,
+      ConstructNgNode<opset::Add>(op->name(), first, ng_slots), padding_row);
+  // [batch, max_detections, 6] of the class, the score and the box
+  auto detections =
+      ConstructNgNode<opset::Gather>(op->name(), rows, index, zero);
+  auto lengths = ConstructNgNode<opset::Constant>(
+      op->name(), ov::element::i64, ov::Shape{3}, std::vector<int64>{1, 1, 4});
+  auto split = ConstructNgNode<opset::VariadicSplit>(
+      op->name(), detections,
+      ConstructNgNode<opset::Constant>(op->name(), ov::element::i64,
+                                       ov::Shape{}, 2),
+      lengths);
+  auto last_axis = ConstructNgNode<opset::Constant>(
+      op->name(), ov::element::i64, ov::Shape{1}, std::vector<int64>{2});
+
+  ov::Output<ov::Node> nmsed_boxes = split.get_node()->output(2);
+  if (clip_boxes) {
+    nmsed_boxes = ConstructNgNode<opset::Clamp>(op->name(), nmsed_boxes, 0, 1);
+  }
+  SaveNgOp(ng_op_map, op->name(), nmsed_boxes);
+  SaveNgOp(ng_op_map, op->name(),
+           ConstructNgNode<opset::Squeeze>(
+               op->name(), split.get_node()->output(1), last_axis));
+  SaveNgOp(ng_op_map, op->name(),
+           ConstructNgNode<opset::Squeeze>(
+               op->name(), split.get_node()->output(0), last_axis));
+  SaveNgOp(ng_op_map, op->name(),
+           ConstructNgNode<opset::Convert>(op->name(), ng_num,
+                                           ov::element::i32));
+  return Status::OK();
+}
+
+static Status TranslateReduceOp(
+    const Node* op, const std::vector<const Tensor*>& static_input_map,
+    Builder::OpMap& ng_op_map,
+    std::function<ov::Output<ov::Node>(ov::Output<ov::Node>,
+                                       ov::Output<ov::Node>, const bool)>
+        create_ng_node) {
+  ov::Output<ov::Node> ng_input;
+  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 0, ng_input));
+  bool tf_keep_dims;
+  if (GetNodeAttr(op->attrs(), "keep_dims", &tf_keep_dims) != Status::OK()) {
+    tf_keep_dims = false;
+  }
+
+  std::vector<int64> axes;
+  TF_RETURN_IF_ERROR(GetStaticInputVector(op, 1, static_input_map, &axes));
+
+  size_t input_rank = ng_input.get_partial_shape().rank().get_length();
+
+  TF_RETURN_IF_ERROR(CheckAxisDimInRange(axes, input_rank));
+
+  std::vector<size_t> ng_reduction_axes_vect(axes.size());
+  std::transform(
+      axes.begin(), axes.end(), ng_reduction_axes_vect.begin(),
+      [input_rank](int idx) { return idx + (idx < 0 ? (int)input_rank : 0); });
+  auto ng_reduction_axes = ConstructNgNode<opset::Constant>(
       op->name(), ov::element::i64, ov::Shape{ng_reduction_axes_vect.size()},
       ng_reduction_axes_vect);
 
@@ -2762,6 +3944,27 @@ static Status TranslatePadOp(const Node* op,
     }
   }
 
+  // The paddings are computed at run time, split the [rank, 2] tensor into
+  // pads_begin and pads_end
+  if (IsRuntimeInput(op, 1, static_input_map)) {
+    auto ng_paddings = ConstructNgNode<opset::Convert>(
+        op->name(), ng_paddings_op, ov::element::i64);
+    auto split_axis =
+        make_shared<opset::Constant>(ov::element::i64, ov::Shape{}, 1);
+    auto ng_split =
+        ConstructNgNode<opset::Split>(op->name(), ng_paddings, split_axis, 2);
+    auto squeeze_axis =
+        make_shared<opset::Constant>(ov::element::i64, ov::Shape{1}, 1);
+    auto pads_begin_node = ConstructNgNode<opset::Squeeze>(
+        op->name(), ng_split.get_node()->outputs()[0], squeeze_axis);
+    auto pads_end_node = ConstructNgNode<opset::Squeeze>(
+        op->name(), ng_split.get_node()->outputs()[1], squeeze_axis);
+    SaveNgOp(ng_op_map, op->name(),
+             ConstructNgNode<opset::Pad>(op->name(), ng_input, pads_begin_node,
+                                         pads_end_node, pad_val_op, pad_mode));
+    return Status::OK();
+  }
+
   // Set pads_begin & pads_end (from the pad_val_op)
   std::vector<int64> paddings;
   TF_RETURN_IF_ERROR(GetStaticInputVector(op, 1, static_input_map, &paddings));
@@ -2881,6 +4084,15 @@ static Status TranslateReshapeOp(
   ov::Output<ov::Node> ng_input, ng_shape_op;
   TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_input, ng_shape_op));
 
+  // The shape is computed at run time, -1 is inferred the same way
+  if (IsRuntimeInput(op, 1, static_input_map)) {
+    auto ng_shape = ConstructNgNode<opset::Convert>(op->name(), ng_shape_op,
+                                                    ov::element::i64);
+    SaveNgOp(ng_op_map, op->name(), ConstructNgNode<opset::Reshape>(
+                                        op->name(), ng_input, ng_shape, false));
+    return Status::OK();
+  }
+
   OVTF_VLOG(3) << "Input shape: " << ngraph::join(ng_input.get_shape());
 
   std::vector<int64> shape;
@@ -3206,6 +4418,142 @@ static Status TranslateSpaceToDepthOp(const Node* op,
   return Status::OK();
 }
 
+// SparseSegmentSum, SparseSegmentMean and SparseSegmentSqrtN, with or
+// without num_segments, sum the rows of the table picked by the indices into
+// the rows named by segment_ids
+static Status TranslateSparseSegmentOp(
+    const Node* op, const std::vector<const Tensor*>& static_input_map,
+    Builder::OpMap& ng_op_map) {
+  ov::Output<ov::Node> ng_data, ng_indices, ng_segment_ids;
+  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 0, ng_data));
+  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 1, ng_indices));
+  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 2, ng_segment_ids));
+  if (ng_data.get_partial_shape().rank().is_dynamic()) {
+    return errors::Unimplemented("The rank of the data of ", op->name(),
+                                 " is dynamic");
+  }
+  const int64 data_rank = ng_data.get_partial_shape().rank().get_length();
+
+  // The indices, the segment ids and their count share a type
+  auto index_type = ng_indices.get_element_type();
+  if (ng_segment_ids.get_element_type() != index_type) {
+    index_type = ov::element::i64;
+    ng_indices =
+        ConstructNgNode<opset::Convert>(op->name(), ng_indices, index_type);
+    ng_segment_ids =
+        ConstructNgNode<opset::Convert>(op->name(), ng_segment_ids, index_type);
+  }
+  ov::Output<ov::Node> ng_num_segments;
+  if (op->num_inputs() > 3) {
+    TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 3, ng_num_segments));
+    ng_num_segments = ConstructNgNode<opset::Convert>(
+        op->name(), ng_num_segments, index_type);
+  } else {
+    // The segment ids are sorted, the last one names the last segment
+    auto ng_axis = ConstructNgNode<opset::Constant>(
+        op->name(), ov::element::i64, ov::Shape{}, 0);
+    ng_num_segments = ConstructNgNode<opset::Add>(
+        op->name(),
+        ConstructNgNode<opset::ReduceMax>(op->name(), ng_segment_ids, ng_axis,
+                                          false),
+        ConstructNgNode<opset::Constant>(op->name(), index_type, ov::Shape{},
+                                         1));
+  }
+
+  ov::Output<ov::Node> ng_result = ConstructNgNode<opset::EmbeddingSegmentsSum>(
+      op->name(), ng_data, ng_indices, ng_segment_ids, ng_num_segments);
+  if (op->type_string().find("Sum") == string::npos) {
+    // The sizes of the segments, from a table of a single row of ones. The
+    // empty segments are divided by one to stay zero
+    auto ng_ones = ConstructNgNode<opset::Constant>(
+        op->name(), ng_data.get_element_type(), ov::Shape{1, 1}, 1);
+    auto ng_first_row = ConstructNgNode<opset::Broadcast>(
+        op->name(),
+        ConstructNgNode<opset::Constant>(op->name(), index_type, ov::Shape{},
+                                         0),
+        ConstructNgNode<opset::ShapeOf>(op->name(), ng_indices));
+    ov::Output<ov::Node> ng_counts = ConstructNgNode<opset::Maximum>(
+        op->name(),
+        ConstructNgNode<opset::EmbeddingSegmentsSum>(
+            op->name(), ng_ones, ng_first_row, ng_segment_ids,
+            ng_num_segments),
+        ConstructNgNode<opset::Constant>(
+            op->name(), ng_data.get_element_type(), ov::Shape{}, 1));
+    if (op->type_string().find("SqrtN") != string::npos) {
+      ng_counts = ConstructNgNode<opset::Sqrt>(op->name(), ng_counts);
+    }
+    std::vector<int64> counts_shape(data_rank, 1);
+    counts_shape[0] = -1;
+    ng_counts = ConstructNgNode<opset::Reshape>(
+        op->name(), ng_counts,
+        ConstructNgNode<opset::Constant>(op->name(), ov::element::i64,
+                                         ov::Shape{counts_shape.size()},
+                                         counts_shape),
+        false);
+    ng_result =
+        ConstructNgNode<opset::Divide>(op->name(), ng_result, ng_counts);
+  }
+  SaveNgOp(ng_op_map, op->name(), ng_result);
+  return Status::OK();
+}
+
+// The product of a sparse matrix, given by the coordinates and the values of
+// its nonzeros, and a dense one. Each nonzero scales the row of b its column
+// picks, and the scaled rows are summed into the row of the nonzero. Only
+// adjoint_a=false is marked for clustering
+static Status TranslateSparseTensorDenseMatMulOp(
+    const Node* op, const std::vector<const Tensor*>& static_input_map,
+    Builder::OpMap& ng_op_map) {
+  ov::Output<ov::Node> ng_a_indices, ng_a_values, ng_a_shape, ng_b;
+  TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_a_indices, ng_a_values,
+                                   ng_a_shape, ng_b));
+  bool adjoint_a, adjoint_b;
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "adjoint_a", &adjoint_a));
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "adjoint_b", &adjoint_b));
+  if (adjoint_a) {
+    return errors::Unimplemented("adjoint_a is not supported for ",
+                                 op->name());
+  }
+
+  ng_a_indices = ConstructNgNode<opset::Convert>(op->name(), ng_a_indices,
+                                                 ov::element::i64);
+  auto ng_zero = ConstructNgNode<opset::Constant>(op->name(), ov::element::i64,
+                                                  ov::Shape{}, 0);
+  auto ng_one = ConstructNgNode<opset::Constant>(op->name(), ov::element::i64,
+                                                 ov::Shape{}, 1);
+  auto ng_rows =
+      ConstructNgNode<opset::Gather>(op->name(), ng_a_indices, ng_zero, ng_one);
+  auto ng_cols =
+      ConstructNgNode<opset::Gather>(op->name(), ng_a_indices, ng_one, ng_one);
+  if (adjoint_b) {
+    ng_b = ConstructNgNode<opset::Transpose>(
+        op->name(), ng_b,
+        ConstructNgNode<opset::Constant>(op->name(), ov::element::i64,
+                                         ov::Shape{2},
+                                         std::vector<int64>{1, 0}));
+  }
+  auto ng_weighted = ConstructNgNode<opset::Multiply>(
+      op->name(),
+      ConstructNgNode<opset::Gather>(op->name(), ng_b, ng_cols, ng_zero),
+      ConstructNgNode<opset::Unsqueeze>(op->name(), ng_a_values, ng_one));
+
+  // Every scaled row is its own segment element
+  auto ng_nonzeros = ConstructNgNode<opset::Gather>(
+      op->name(), ConstructNgNode<opset::ShapeOf>(op->name(), ng_a_indices),
+      ng_zero, ng_zero);
+  auto ng_range = ConstructNgNode<opset::Range>(
+      op->name(), ng_zero, ng_nonzeros, ng_one, ov::element::i64);
+  auto ng_num_rows = ConstructNgNode<opset::Gather>(
+      op->name(),
+      ConstructNgNode<opset::Convert>(op->name(), ng_a_shape,
+                                      ov::element::i64),
+      ng_zero, ng_zero);
+  auto ng_result = ConstructNgNode<opset::EmbeddingSegmentsSum>(
+      op->name(), ng_weighted, ng_range, ng_rows, ng_num_rows);
+  SaveNgOp(ng_op_map, op->name(), ng_result);
+  return Status::OK();
+}
+
 static Status TranslateSplitOp(
     const Node* op, const std::vector<const Tensor*>& static_input_map,
     Builder::OpMap& ng_op_map) {
@@ -3415,6 +4763,15 @@ static Status TranslateTileOp(
   ov::Output<ov::Node> ng_input, ng_multiples;
   TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_input, ng_multiples));
 
+  // The multiples are computed at run time
+  if (IsRuntimeInput(op, 1, static_input_map)) {
+    auto ng_repeats = ConstructNgNode<opset::Convert>(
+        op->name(), ng_multiples, ov::element::i64);
+    SaveNgOp(ng_op_map, op->name(),
+             ConstructNgNode<opset::Tile>(op->name(), ng_input, ng_repeats));
+    return Status::OK();
+  }
+
   std::vector<int64> multiples;
   TF_RETURN_IF_ERROR(GetStaticInputVector(op, 1, static_input_map, &multiples));
 
@@ -3565,8 +4922,15 @@ static Status TranslateWhereOp(
   auto non_zero = ConstructNgNode<opset::NonZero>(op->name(), ng_cond);
   auto transpose_order = ConstructNgNode<opset::Constant>(
       op->name(), ov::element::i64, ov::Shape{2}, std::vector<int64_t>({1, 0}));
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<opset::Transpose>(
-                                      op->name(), non_zero, transpose_order));
+  auto ng_where =
+      ConstructNgNode<opset::Transpose>(op->name(), non_zero, transpose_order);
+  // Every element of the condition may be true
+  if (ng_cond.get_partial_shape().is_static()) {
+    const ov::Shape& cond_shape = ng_cond.get_shape();
+    Builder::SetOutputBound(
+        ng_where, ov::Shape{ov::shape_size(cond_shape), cond_shape.size()});
+  }
+  SaveNgOp(ng_op_map, op->name(), ng_where);
   return Status::OK();
 }
 
@@ -3607,8 +4971,11 @@ const static std::map<
         {"AvgPool3D", TranslateAvgPoolOp<3>},
         {"BatchToSpaceND", TranslateBatchNDAndSpaceNDOp},
         {"BiasAdd", TranslateBiasAddOp},
+        {"BlockLSTM", TranslateBlockLSTMOp},
+        {"BlockLSTMV2", TranslateBlockLSTMOp},
         {"Cast", TranslateCastOp},
         {"Ceil", TranslateUnaryOp<opset::Ceiling>},
+        {"CombinedNonMaxSuppression", TranslateCombinedNonMaxSuppressionOp},
         {"ConcatV2", TranslateConcatV2Op},
         {"Const", TranslateConstOp},
         {"Conv2D", TranslateConv2DOp},
@@ -3620,12 +4987,17 @@ const static std::map<
         {"CropAndResize", TranslateCropAndResizeOp},
         {"Cumsum", TranslateCumsumOp},
         {"DepthToSpace", TranslateDepthToSpaceOp},
+        {"Dequantize", TranslateDequantizeOp},
         {"DepthwiseConv2dNative", TranslateDepthwiseConv2dNativeOp},
         {"Elu", TranslateEluOp},
         {"Equal", TranslateBinaryOp<opset::Equal>},
+        {"Erf", TranslateUnaryOp<opset::Erf>},
         {"Exp", TranslateUnaryOp<opset::Exp>},
         {"ExpandDims", TranslateExpandDimsOp},
+        {"FakeQuantWithMinMaxArgs", TranslateFakeQuantWithMinMaxArgsOp},
         {"FakeQuantWithMinMaxVars", TranslateFakeQuantWithMinMaxVarsOp},
+        {"FakeQuantWithMinMaxVarsPerChannel",
+         TranslateFakeQuantWithMinMaxVarsOp},
         {"Fill", TranslateFillOp},
         {"Floor", TranslateUnaryOp<opset::Floor>},
         {"FloorDiv", TranslateFloorDivOp},
@@ -3636,6 +5008,7 @@ const static std::map<
         {"Gather", TranslateGatherOp},
         {"GatherV2", TranslateGatherV2Op},
         {"GatherNd", TranslateGatherNdOp},
+        {"GRUBlockCell", TranslateGRUBlockCellOp},
         {"_FusedBatchNormEx", TranslateFusedBatchNormOp},
         {"_FusedConv2D", TranslateFusedConv2DOp},
         {"_FusedDepthwiseConv2dNative", TranslateFusedDepthwiseConv2dNativeOp},
@@ -3655,6 +5028,7 @@ const static std::map<
         {"LogicalNot", TranslateUnaryOp<opset::LogicalNot>},
         {"LogicalOr", TranslateBinaryOp<opset::LogicalOr>},
         {"LRN", TranslateLRNOp},
+        {"LSTMBlockCell", TranslateLSTMBlockCellOp},
         {"MatMul", TranslateMatMulOp},
         {"Max", TranslateDirectReduceOp<opset::ReduceMax>},
         {"Maximum", TranslateBinaryOp<opset::Maximum>},
@@ -3662,6 +5036,8 @@ const static std::map<
         {"MaxPool3D", TranslateMaxPoolOp<3>},
         {"NonMaxSuppressionV2", TranslateNonMaxSuppressionV2Op},
         {"NonMaxSuppressionV3", TranslateNonMaxSuppressionV3Op},
+        {"NonMaxSuppressionV4", TranslateNonMaxSuppressionV4Op},
+        {"NonMaxSuppressionV5", TranslateNonMaxSuppressionV5Op},
         {"Mean", TranslateDirectReduceOp<opset::ReduceMean>},
         {"Min", TranslateDirectReduceOp<opset::ReduceMin>},
         {"Minimum", TranslateBinaryOp<opset::Minimum>},
@@ -3683,6 +5059,10 @@ const static std::map<
         // PreventGradient is just Identity in dataflow terms, so reuse that.
         {"PreventGradient", TranslateIdentityOp},
         {"Prod", TranslateDirectReduceOp<opset::ReduceProd>},
+        {"QuantizeAndDequantizeV2", TranslateQuantizeAndDequantizeOp},
+        {"QuantizeAndDequantizeV3", TranslateQuantizeAndDequantizeOp},
+        {"QuantizeAndDequantizeV4", TranslateQuantizeAndDequantizeOp},
+        {"QuantizeV2", TranslateQuantizeV2Op},
         {"Range", TranslateRangeOp},
         {"Rank", TranslateRankOp},
         {"RealDiv", TranslateBinaryOp<opset::Divide>},
@@ -3711,6 +5091,13 @@ const static std::map<
         {"Softplus", TranslateSoftPlusOp},
         {"SpaceToBatchND", TranslateBatchNDAndSpaceNDOp},
         {"SpaceToDepth", TranslateSpaceToDepthOp},
+        {"SparseSegmentMean", TranslateSparseSegmentOp},
+        {"SparseSegmentMeanWithNumSegments", TranslateSparseSegmentOp},
+        {"SparseSegmentSqrtN", TranslateSparseSegmentOp},
+        {"SparseSegmentSqrtNWithNumSegments", TranslateSparseSegmentOp},
+        {"SparseSegmentSum", TranslateSparseSegmentOp},
+        {"SparseSegmentSumWithNumSegments", TranslateSparseSegmentOp},
+        {"SparseTensorDenseMatMul", TranslateSparseTensorDenseMatMulOp},
         {"Split", TranslateSplitOp},
         {"SplitV", TranslateSplitVOp},
         {"Sqrt", TranslateUnaryOp<opset::Sqrt>},
@@ -3730,6 +5117,877 @@ const static std::map<
         {"Xdivy", TranslateXdivyOp},
         {"ZerosLike", TranslateZerosLikeOp}};
 
+//
+// Pattern fusion: the subgraphs of the common activations and
+// normalizations are translated to the fused OpenVINO op instead of one op
+// per TF op, which leaves the plugins a single primitive to execute.
+//
+
+// An output of a TF node
+using PatternOutput = std::pair<const Node*, int>;
+
+// A matched subgraph, translated in place of its root
+struct FusedPattern {
+  const char* name = nullptr;
+  // The other ops of the pattern, which are not translated
+  std::vector<const Node*> nodes;
+  std::function<Status(Builder::OpMap&)> translate;
+};
+
+static bool GetPatternInput(const Node* op, int index, PatternOutput& input) {
+  const Edge* edge;
+  if (index >= op->num_inputs() || !op->input_edge(index, &edge).ok()) {
+    return false;
+  }
+  input = {edge->src(), edge->src_output()};
+  return true;
+}
+
+static bool IsPatternOp(const PatternOutput& output,
+                        std::initializer_list<const char*> types) {
+  if (output.second != 0) return false;
+  for (auto type : types) {
+    if (output.first->type_string() == type) return true;
+  }
+  return false;
+}
+
+static bool GetScalarConst(const PatternOutput& output, double& value) {
+  const Node* node = output.first;
+  if (node->type_string() != "Const") return false;
+  Tensor tensor;
+  if (!tensor.FromProto(node->def().attr().at("value").tensor()) ||
+      tensor.NumElements() != 1) {
+    return false;
+  }
+  switch (tensor.dtype()) {
+    case DT_FLOAT:
+      value = tensor.flat<float>()(0);
+      return true;
+    case DT_DOUBLE:
+      value = tensor.flat<double>()(0);
+      return true;
+    case DT_HALF:
+      value = static_cast<float>(tensor.flat<Eigen::half>()(0));
+      return true;
+    case DT_BFLOAT16:
+      value = static_cast<float>(tensor.flat<bfloat16>()(0));
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Whether output is a scalar constant equal to value, up to the precision
+// of the half types
+static bool IsScalarConst(const PatternOutput& output, double value) {
+  double actual;
+  return GetScalarConst(output, actual) &&
+         std::abs(actual - value) <= 1e-3 * std::abs(value);
+}
+
+// The operands of a binary op, also swapped if the op is commutative
+static std::vector<std::pair<PatternOutput, PatternOutput>> GetPatternOperands(
+    const Node* op) {
+  std::vector<std::pair<PatternOutput, PatternOutput>> operands;
+  PatternOutput lhs, rhs;
+  if (op->num_inputs() != 2 || !GetPatternInput(op, 0, lhs) ||
+      !GetPatternInput(op, 1, rhs)) {
+    return operands;
+  }
+  operands.emplace_back(lhs, rhs);
+  const string& type = op->type_string();
+  if (type == "Add" || type == "AddV2" || type == "Mul" ||
+      type == "SquaredDifference") {
+    operands.emplace_back(rhs, lhs);
+  }
+  return operands;
+}
+
+static Status GetPatternInputNode(const Builder::OpMap& ng_op_map,
+                                  const PatternOutput& input,
+                                  ov::Output<ov::Node>& result) {
+  auto it = ng_op_map.find(input.first->name());
+  if (it == ng_op_map.end() ||
+      it->second.size() <= static_cast<size_t>(input.second)) {
+    return errors::NotFound("OpenVINO op not found for ", input.first->name(),
+                            ":", input.second);
+  }
+  result = it->second[input.second];
+  return Status::OK();
+}
+
+// Matches sqrt(2 / pi) * (x + 0.044715 * x^3)
+static bool MatchGeluTanhArgument(const PatternOutput& arg, PatternOutput& x,
+                                  std::vector<const Node*>& nodes) {
+  if (!IsPatternOp(arg, {"Mul"})) return false;
+  for (const auto& factors : GetPatternOperands(arg.first)) {
+    if (!IsScalarConst(factors.second, std::sqrt(2.0 / 3.14159265358979)) ||
+        !IsPatternOp(factors.first, {"Add", "AddV2"})) {
+      continue;
+    }
+    for (const auto& terms : GetPatternOperands(factors.first.first)) {
+      if (!IsPatternOp(terms.second, {"Mul"})) continue;
+      for (const auto& cubic : GetPatternOperands(terms.second.first)) {
+        PatternOutput base, exponent;
+        if (IsScalarConst(cubic.second, 0.044715) &&
+            IsPatternOp(cubic.first, {"Pow"}) &&
+            GetPatternInput(cubic.first.first, 0, base) &&
+            GetPatternInput(cubic.first.first, 1, exponent) &&
+            base == terms.first && IsScalarConst(exponent, 3.0)) {
+          x = base;
+          nodes.insert(nodes.end(),
+                       {arg.first, factors.first.first, terms.second.first,
+                        cubic.first.first});
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+// Matches 1 + erf(x / sqrt(2)), or its approximation
+// 1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)), the cumulative distribution
+// of the normal distribution at x up to the factor 0.5
+static bool MatchGeluCdf(const PatternOutput& cdf, PatternOutput& x,
+                         ov::op::GeluApproximationMode& mode,
+                         std::vector<const Node*>& nodes) {
+  if (!IsPatternOp(cdf, {"Add", "AddV2"})) return false;
+  for (const auto& terms : GetPatternOperands(cdf.first)) {
+    PatternOutput arg;
+    if (!IsScalarConst(terms.second, 1.0) ||
+        !IsPatternOp(terms.first, {"Erf", "Tanh"}) ||
+        !GetPatternInput(terms.first.first, 0, arg)) {
+      continue;
+    }
+    std::vector<const Node*> matched{cdf.first, terms.first.first};
+    bool found = false;
+    if (terms.first.first->type_string() == "Tanh") {
+      mode = ov::op::GeluApproximationMode::TANH;
+      found = MatchGeluTanhArgument(arg, x, matched);
+    } else if (IsPatternOp(arg, {"RealDiv"})) {
+      mode = ov::op::GeluApproximationMode::ERF;
+      PatternOutput divisor;
+      found = GetPatternInput(arg.first, 0, x) &&
+              GetPatternInput(arg.first, 1, divisor) &&
+              IsScalarConst(divisor, std::sqrt(2.0));
+      matched.push_back(arg.first);
+    } else if (IsPatternOp(arg, {"Mul"})) {
+      mode = ov::op::GeluApproximationMode::ERF;
+      for (const auto& factors : GetPatternOperands(arg.first)) {
+        if (IsScalarConst(factors.second, std::sqrt(0.5))) {
+          x = factors.first;
+          found = true;
+          break;
+        }
+      }
+      matched.push_back(arg.first);
+    }
+    if (found) {
+      nodes.insert(nodes.end(), matched.begin(), matched.end());
+      return true;
+    }
+  }
+  return false;
+}
+
+// Matches x * 0.5 * cdf(x), with any association of the products
+static bool MatchGelu(const Node* op, const std::vector<const Tensor*>&,
+                      FusedPattern& pattern) {
+  if (op->type_string() != "Mul") return false;
+  for (const auto& operands : GetPatternOperands(op)) {
+    const PatternOutput& lhs = operands.first;
+    const PatternOutput& rhs = operands.second;
+    if (!IsPatternOp(lhs, {"Mul"})) continue;
+    for (const auto& factors : GetPatternOperands(lhs.first)) {
+      // The (x, cdf) candidates of (x * 0.5) * cdf(x), (cdf(x) * 0.5) * x
+      // and (x * cdf(x)) * 0.5
+      std::vector<std::pair<PatternOutput, PatternOutput>> candidates;
+      if (IsScalarConst(factors.second, 0.5)) {
+        candidates.emplace_back(factors.first, rhs);
+        candidates.emplace_back(rhs, factors.first);
+      } else if (IsScalarConst(rhs, 0.5)) {
+        candidates.emplace_back(factors.first, factors.second);
+      }
+      for (const auto& candidate : candidates) {
+        PatternOutput x = candidate.first, cdf_x;
+        ov::op::GeluApproximationMode mode;
+        std::vector<const Node*> nodes{lhs.first};
+        if (!MatchGeluCdf(candidate.second, cdf_x, mode, nodes) || cdf_x != x) {
+          continue;
+        }
+        pattern.name = "Gelu";
+        pattern.nodes = nodes;
+        pattern.translate = [op, x, mode](Builder::OpMap& ng_op_map) {
+          ov::Output<ov::Node> ng_x;
+          TF_RETURN_IF_ERROR(GetPatternInputNode(ng_op_map, x, ng_x));
+          SaveNgOp(ng_op_map, op->name(),
+                   ConstructNgNode<opset::Gelu>(op->name(), ng_x, mode));
+          return Status::OK();
+        };
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Matches x * sigmoid(x), or x * sigmoid(beta * x)
+static bool MatchSwish(const Node* op, const std::vector<const Tensor*>&,
+                       FusedPattern& pattern) {
+  if (op->type_string() != "Mul") return false;
+  for (const auto& operands : GetPatternOperands(op)) {
+    const PatternOutput& x = operands.first;
+    PatternOutput arg;
+    if (!IsPatternOp(operands.second, {"Sigmoid"}) ||
+        !GetPatternInput(operands.second.first, 0, arg)) {
+      continue;
+    }
+    std::vector<const Node*> nodes{operands.second.first};
+    double beta = 1.0;
+    bool found = arg == x;
+    if (!found && IsPatternOp(arg, {"Mul"})) {
+      for (const auto& factors : GetPatternOperands(arg.first)) {
+        if (factors.first == x && GetScalarConst(factors.second, beta)) {
+          nodes.push_back(arg.first);
+          found = true;
+          break;
+        }
+      }
+    }
+    if (!found) continue;
+    pattern.name = "Swish";
+    pattern.nodes = nodes;
+    pattern.translate = [op, x, beta](Builder::OpMap& ng_op_map) {
+      ov::Output<ov::Node> ng_x;
+      TF_RETURN_IF_ERROR(GetPatternInputNode(ng_op_map, x, ng_x));
+      if (beta == 1.0) {
+        SaveNgOp(ng_op_map, op->name(),
+                 ConstructNgNode<opset::Swish>(op->name(), ng_x));
+      } else {
+        auto ng_beta = ConstructNgNode<opset::Constant>(
+            op->name(), ng_x.get_element_type(), ov::Shape{},
+            std::vector<double>{beta});
+        SaveNgOp(ng_op_map, op->name(),
+                 ConstructNgNode<opset::Swish>(op->name(), ng_x, ng_beta));
+      }
+      return Status::OK();
+    };
+    return true;
+  }
+  return false;
+}
+
+// Matches mean(input, axes) keeping the reduced dimensions, with static axes
+static bool MatchMean(const PatternOutput& mean, PatternOutput& input,
+                      std::vector<int64>& axes,
+                      const std::vector<const Tensor*>& static_input_map) {
+  bool keep_dims;
+  PatternOutput axes_input;
+  Tensor axes_tensor;
+  return IsPatternOp(mean, {"Mean"}) &&
+         GetNodeAttr(mean.first->attrs(), "keep_dims", &keep_dims) ==
+             Status::OK() &&
+         keep_dims && GetPatternInput(mean.first, 0, input) &&
+         GetPatternInput(mean.first, 1, axes_input) &&
+         GetStaticNodeTensor(axes_input.first, static_input_map, &axes_tensor)
+             .ok() &&
+         TensorDataToVector(axes_tensor, &axes).ok();
+}
+
+// Matches rsqrt(var + eps), or sqrt(var + eps) for type Sqrt, var being
+// mean((x - mean)^2) over the axes of the mean
+static bool MatchDeviation(const PatternOutput& output, const char* type,
+                           const PatternOutput& x, const PatternOutput& mean,
+                           const std::vector<int64>& axes,
+                           const std::vector<const Tensor*>& static_input_map,
+                           double& eps, std::vector<const Node*>& nodes) {
+  PatternOutput sum;
+  if (!IsPatternOp(output, {type}) || !GetPatternInput(output.first, 0, sum) ||
+      !IsPatternOp(sum, {"Add", "AddV2"})) {
+    return false;
+  }
+  for (const auto& terms : GetPatternOperands(sum.first)) {
+    PatternOutput squares;
+    std::vector<int64> var_axes;
+    if (!GetScalarConst(terms.second, eps) ||
+        !MatchMean(terms.first, squares, var_axes, static_input_map) ||
+        var_axes != axes || !IsPatternOp(squares, {"SquaredDifference"})) {
+      continue;
+    }
+    for (const auto& diff : GetPatternOperands(squares.first)) {
+      if (diff.first != x) continue;
+      // tf.nn.moments stops the gradient of the mean
+      PatternOutput centre = diff.second;
+      std::vector<const Node*> matched{output.first, sum.first,
+                                       terms.first.first, squares.first};
+      if (IsPatternOp(centre, {"StopGradient", "Identity"})) {
+        matched.push_back(centre.first);
+        if (!GetPatternInput(centre.first, 0, centre)) continue;
+      }
+      if (centre != mean) continue;
+      nodes.insert(nodes.end(), matched.begin(), matched.end());
+      return true;
+    }
+  }
+  return false;
+}
+
+// Matches the layer normalizations over the static axes of the means,
+//   (x - mean) * rsqrt(var + eps), (x - mean) / sqrt(var + eps), and the
+//   x * m + (beta - mean * m) of tf.nn.batch_normalization with
+//   m = rsqrt(var + eps) * gamma, gamma and beta being optional
+static bool MatchMVN(const Node* op,
+                     const std::vector<const Tensor*>& static_input_map,
+                     FusedPattern& pattern) {
+  PatternOutput x, mean, mean_x, gamma, beta;
+  std::vector<int64> axes;
+  double eps;
+  std::vector<const Node*> nodes;
+  bool found = false;
+  const string& type = op->type_string();
+  if (type == "Mul" || type == "RealDiv") {
+    for (const auto& operands : GetPatternOperands(op)) {
+      nodes.clear();
+      const PatternOutput& centred = operands.first;
+      found = IsPatternOp(centred, {"Sub"}) &&
+              GetPatternInput(centred.first, 0, x) &&
+              GetPatternInput(centred.first, 1, mean) &&
+              MatchMean(mean, mean_x, axes, static_input_map) && mean_x == x &&
+              MatchDeviation(operands.second,
+                             type == "Mul" ? "Rsqrt" : "Sqrt", x, mean, axes,
+                             static_input_map, eps, nodes);
+      if (found) {
+        nodes.insert(nodes.end(), {centred.first, mean.first});
+        break;
+      }
+    }
+  } else if (type == "Add" || type == "AddV2") {
+    for (const auto& operands : GetPatternOperands(op)) {
+      const PatternOutput& scaled = operands.first;
+      const PatternOutput& shift = operands.second;
+      PatternOutput shifted_mean;
+      beta = PatternOutput();
+      if (!IsPatternOp(scaled, {"Mul"})) continue;
+      if (IsPatternOp(shift, {"Sub"})) {
+        if (!GetPatternInput(shift.first, 0, beta) ||
+            !GetPatternInput(shift.first, 1, shifted_mean)) {
+          continue;
+        }
+      } else if (!IsPatternOp(shift, {"Neg"}) ||
+                 !GetPatternInput(shift.first, 0, shifted_mean)) {
+        continue;
+      }
+      if (!IsPatternOp(shifted_mean, {"Mul"})) continue;
+      for (const auto& factors : GetPatternOperands(scaled.first)) {
+        const PatternOutput& multiplier = factors.second;
+        x = factors.first;
+        for (const auto& mean_factors :
+             GetPatternOperands(shifted_mean.first)) {
+          mean = mean_factors.first;
+          if (mean_factors.second != multiplier ||
+              !MatchMean(mean, mean_x, axes, static_input_map) ||
+              mean_x != x) {
+            continue;
+          }
+          // The multiplier is rsqrt(var + eps) or rsqrt(var + eps) * gamma
+          nodes = {scaled.first, shift.first, shifted_mean.first, mean.first};
+          gamma = PatternOutput();
+          found = MatchDeviation(multiplier, "Rsqrt", x, mean, axes,
+                                 static_input_map, eps, nodes);
+          if (!found && IsPatternOp(multiplier, {"Mul"})) {
+            for (const auto& scale : GetPatternOperands(multiplier.first)) {
+              if (MatchDeviation(scale.first, "Rsqrt", x, mean, axes,
+                                 static_input_map, eps, nodes)) {
+                nodes.push_back(multiplier.first);
+                gamma = scale.second;
+                found = true;
+                break;
+              }
+            }
+          }
+          if (found) break;
+        }
+        if (found) break;
+      }
+      if (found) break;
+    }
+  }
+  if (!found) return false;
+
+  pattern.name = "MVN";
+  pattern.nodes = nodes;
+  pattern.translate = [op, x, axes, eps, gamma,
+                       beta](Builder::OpMap& ng_op_map) {
+    ov::Output<ov::Node> ng_x;
+    TF_RETURN_IF_ERROR(GetPatternInputNode(ng_op_map, x, ng_x));
+    auto ng_axes = ConstructNgNode<opset::Constant>(
+        op->name(), ov::element::i64, ov::Shape{axes.size()}, axes);
+    auto ng_mvn = ConstructNgNode<opset::MVN>(
+        op->name(), ng_x, ng_axes, true, static_cast<float>(eps),
+        ov::op::MVNEpsMode::INSIDE_SQRT);
+    if (gamma.first != nullptr) {
+      ov::Output<ov::Node> ng_gamma;
+      TF_RETURN_IF_ERROR(GetPatternInputNode(ng_op_map, gamma, ng_gamma));
+      ng_mvn = ConstructNgNode<opset::Multiply>(op->name(), ng_mvn, ng_gamma);
+    }
+    if (beta.first != nullptr) {
+      ov::Output<ov::Node> ng_beta;
+      TF_RETURN_IF_ERROR(GetPatternInputNode(ng_op_map, beta, ng_beta));
+      ng_mvn = ConstructNgNode<opset::Add>(op->name(), ng_mvn, ng_beta);
+    }
+    SaveNgOp(ng_op_map, op->name(), ng_mvn);
+    return Status::OK();
+  };
+  return true;
+}
+
+// Matches matmul(a, b) + bias, the bias being a constant vector, which is
+// translated without the reshape of the bias a BiasAdd may need so that the
+// plugins fuse the bias into the matmul
+static bool MatchMatMulBias(const Node* op, const std::vector<const Tensor*>&,
+                            FusedPattern& pattern) {
+  const string& type = op->type_string();
+  if (type != "BiasAdd" && type != "Add" && type != "AddV2") return false;
+  for (const auto& operands : GetPatternOperands(op)) {
+    const PatternOutput& matmul = operands.first;
+    const PatternOutput& bias = operands.second;
+    if (!IsPatternOp(matmul, {"MatMul"}) ||
+        bias.first->type_string() != "Const" ||
+        bias.first->def().attr().at("value").tensor().tensor_shape()
+                .dim_size() != 1) {
+      continue;
+    }
+    PatternOutput lhs, rhs;
+    bool transpose_a, transpose_b;
+    if (!GetPatternInput(matmul.first, 0, lhs) ||
+        !GetPatternInput(matmul.first, 1, rhs) ||
+        GetNodeAttr(matmul.first->attrs(), "transpose_a", &transpose_a) !=
+            Status::OK() ||
+        GetNodeAttr(matmul.first->attrs(), "transpose_b", &transpose_b) !=
+            Status::OK()) {
+      continue;
+    }
+    pattern.name = "MatMul+bias";
+    pattern.nodes = {matmul.first};
+    pattern.translate = [op, lhs, rhs, bias, transpose_a,
+                         transpose_b](Builder::OpMap& ng_op_map) {
+      ov::Output<ov::Node> ng_lhs, ng_rhs, ng_bias;
+      TF_RETURN_IF_ERROR(GetPatternInputNode(ng_op_map, lhs, ng_lhs));
+      TF_RETURN_IF_ERROR(GetPatternInputNode(ng_op_map, rhs, ng_rhs));
+      TF_RETURN_IF_ERROR(GetPatternInputNode(ng_op_map, bias, ng_bias));
+      auto ng_matmul = ConstructNgNode<opset::MatMul>(
+          op->name(), ng_lhs, ng_rhs, transpose_a, transpose_b);
+      SaveNgOp(ng_op_map, op->name(),
+               ConstructNgNode<opset::Add>(op->name(), ng_matmul, ng_bias));
+      return Status::OK();
+    };
+    return true;
+  }
+  return false;
+}
+
+// Finds the fused patterns of the ops, by root. The other ops of the
+// patterns are added to fused_ops. A pattern is only fused when none of its
+// ops but the root is used outside of it.
+static void FindFusedPatterns(
+    const vector<const Node*>& tf_ops,
+    const std::vector<const Tensor*>& static_input_map,
+    std::map<const Node*, FusedPattern>& patterns,
+    std::set<const Node*>& fused_ops) {
+  using Matcher = bool (*)(const Node*, const std::vector<const Tensor*>&,
+                           FusedPattern&);
+  static const Matcher matchers[] = {MatchGelu, MatchSwish, MatchMVN,
+                                     MatchMatMulBias};
+  std::set<const Node*> claimed;
+  // From the outputs, which matches the largest patterns first
+  for (auto it = tf_ops.rbegin(); it != tf_ops.rend(); ++it) {
+    const Node* op = *it;
+    if (claimed.count(op)) continue;
+    for (auto matcher : matchers) {
+      FusedPattern pattern;
+      if (!matcher(op, static_input_map, pattern)) continue;
+      std::set<const Node*> members(pattern.nodes.begin(),
+                                    pattern.nodes.end());
+      members.insert(op);
+      bool fusible = true;
+      for (auto node : pattern.nodes) {
+        if (claimed.count(node)) fusible = false;
+        for (auto edge : node->out_edges()) {
+          if (!edge->IsControlEdge() && !members.count(edge->dst())) {
+            fusible = false;
+          }
+        }
+      }
+      if (!fusible) continue;
+      OVTF_VLOG(2) << "Fusing " << pattern.name << " pattern of "
+                   << members.size() << " ops at " << op->name();
+      claimed.insert(members.begin(), members.end());
+      fused_ops.insert(pattern.nodes.begin(), pattern.nodes.end());
+      patterns.emplace(op, std::move(pattern));
+      break;
+    }
+  }
+}
+
+static Status TranslateOps(const vector<const Node*>& tf_ops,
+                           const std::vector<const Tensor*>& static_input_map,
+                           const FunctionLibraryDefinition& flib,
+                           Builder::OpMap& ng_op_map);
+
+// Translates the function func of flib, called with arguments of the given
+// shapes, to one parameter per argument and the outputs feeding its results
+static Status TranslateFunction(const FunctionLibraryDefinition& flib,
+                                const NameAttrList& func,
+                                const std::vector<ov::PartialShape>& shapes,
+                                ov::ParameterVector& ng_params,
+                                ov::OutputVector& ng_results) {
+  const FunctionDef* fdef = flib.Find(func.name());
+  if (fdef == nullptr) {
+    return errors::InvalidArgument("Function ", func.name(),
+                                   " not found in the function library");
+  }
+  std::unique_ptr<FunctionBody> fbody;
+  TF_RETURN_IF_ERROR(
+      FunctionDefToBodyHelper(*fdef, AttrSlice(&func.attr()), &flib, &fbody));
+  if (fbody->arg_nodes.size() != shapes.size()) {
+    return errors::InvalidArgument("Function ", func.name(), " takes ",
+                                   fbody->arg_nodes.size(),
+                                   " arguments, called with ", shapes.size());
+  }
+
+  Builder::OpMap ng_op_map;
+  ng_params.clear();
+  for (size_t i = 0; i < fbody->arg_nodes.size(); i++) {
+    ov::element::Type ng_et;
+    TF_RETURN_IF_ERROR(
+        util::TFDataTypeToNGraphElementType(fbody->arg_types[i], &ng_et));
+    auto ng_param = ConstructNgNode<opset::Parameter>(
+        fbody->arg_nodes[i]->name(), ng_et, shapes[i]);
+    SaveNgOp(ng_op_map, fbody->arg_nodes[i]->name(), ng_param);
+    ng_params.push_back(
+        ov::as_type_ptr<opset::Parameter>(ng_param.get_node_shared_ptr()));
+  }
+
+  vector<Node*> ordered;
+  GetReversePostOrder(*fbody->graph, &ordered, NodeComparatorName());
+  vector<const Node*> tf_ops;
+  for (const auto n : ordered) {
+    if (n->IsSink() || n->IsSource() || n->IsArg() || n->IsRetval()) {
+      continue;
+    }
+    if (n->IsControlFlow()) {
+      return errors::Unimplemented(
+          "Encountered a control flow op in the openvino_tensorflow: ",
+          n->DebugString());
+    }
+    tf_ops.push_back(n);
+  }
+  // The arguments of a function are never static
+  std::vector<const Tensor*> static_input_map(shapes.size(), nullptr);
+  TF_RETURN_IF_ERROR(TranslateOps(tf_ops, static_input_map, flib, ng_op_map));
+
+  ng_results.resize(fbody->ret_nodes.size());
+  for (size_t i = 0; i < fbody->ret_nodes.size(); i++) {
+    TF_RETURN_IF_ERROR(
+        GetInputNode(ng_op_map, fbody->ret_nodes[i], 0, ng_results[i]));
+  }
+  return Status::OK();
+}
+
+// Feeds the users of the parameters of a translated function with args
+// instead, inlining the function where the args are computed
+static void InlineFunction(const ov::ParameterVector& ng_params,
+                           const ov::OutputVector& args) {
+  for (size_t i = 0; i < ng_params.size(); i++) {
+    ng_params[i]->output(0).replace(args[i]);
+  }
+}
+
+// The boolean value of the scalar predicate of the functional control flow
+// ops, a numerical value being true when not zero
+static Status PredicateToBool(const Node* op, ov::Output<ov::Node>& ng_pred) {
+  const auto& shape = ng_pred.get_partial_shape();
+  if (shape.rank().is_dynamic() || shape.rank().get_length() != 0) {
+    return errors::Unimplemented("The predicate of ", op->name(),
+                                 " must be a scalar, got ", shape);
+  }
+  if (ng_pred.get_element_type() != ov::element::boolean) {
+    auto ng_zero = ConstructNgNode<opset::Constant>(
+        op->name(), ng_pred.get_element_type(), ov::Shape{},
+        std::vector<int64>{0});
+    ng_pred = ConstructNgNode<opset::NotEqual>(op->name(), ng_pred, ng_zero);
+  }
+  return Status::OK();
+}
+
+// The shape of a value which can take both shapes a and b
+static ov::PartialShape GeneralizeShape(const ov::PartialShape& a,
+                                        const ov::PartialShape& b) {
+  if (a.rank().is_dynamic() || b.rank().is_dynamic() ||
+      a.rank().get_length() != b.rank().get_length()) {
+    return ov::PartialShape::dynamic();
+  }
+  std::vector<ov::Dimension> dims;
+  for (int64 i = 0; i < a.rank().get_length(); i++) {
+    dims.push_back(a[i] == b[i] ? a[i] : ov::Dimension::dynamic());
+  }
+  return ov::PartialShape(dims);
+}
+
+static Status TranslateIfOp(const Node* op,
+                            const FunctionLibraryDefinition& flib,
+                            Builder::OpMap& ng_op_map) {
+  TF_RETURN_IF_ERROR(ValidateInputCountMin(op, 1));
+  NameAttrList then_func, else_func;
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "then_branch", &then_func));
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "else_branch", &else_func));
+
+  ov::Output<ov::Node> ng_cond;
+  TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 0, ng_cond));
+  TF_RETURN_IF_ERROR(PredicateToBool(op, ng_cond));
+
+  ov::OutputVector ng_inputs(op->num_inputs() - 1);
+  std::vector<ov::PartialShape> shapes;
+  for (size_t i = 0; i < ng_inputs.size(); i++) {
+    TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, i + 1, ng_inputs[i]));
+    shapes.push_back(ng_inputs[i].get_partial_shape());
+  }
+
+  ov::ParameterVector then_params, else_params;
+  ov::OutputVector then_outputs, else_outputs;
+  TF_RETURN_IF_ERROR(
+      TranslateFunction(flib, then_func, shapes, then_params, then_outputs));
+  TF_RETURN_IF_ERROR(
+      TranslateFunction(flib, else_func, shapes, else_params, else_outputs));
+  if (then_outputs.size() != op->num_outputs() ||
+      else_outputs.size() != op->num_outputs()) {
+    return errors::InvalidArgument("The branches of ", op->name(),
+                                   " do not return ", op->num_outputs(),
+                                   " values");
+  }
+
+  ov::ResultVector then_results, else_results;
+  for (size_t i = 0; i < then_outputs.size(); i++) {
+    then_results.push_back(make_shared<opset::Result>(then_outputs[i]));
+    else_results.push_back(make_shared<opset::Result>(else_outputs[i]));
+  }
+  auto ng_if = make_shared<ov::opset8::If>(ng_cond);
+  ng_if->set_then_body(
+      make_shared<ov::Model>(then_results, then_params, op->name() + "/then"));
+  ng_if->set_else_body(
+      make_shared<ov::Model>(else_results, else_params, op->name() + "/else"));
+  for (size_t i = 0; i < ng_inputs.size(); i++) {
+    ng_if->set_input(ng_inputs[i], then_params[i], else_params[i]);
+  }
+  ov::OutputVector ng_outputs;
+  for (size_t i = 0; i < then_results.size(); i++) {
+    ng_outputs.push_back(ng_if->set_output(then_results[i], else_results[i]));
+  }
+  ng_if->validate_and_infer_types();
+  Builder::SetTracingInfo(op->name(), ng_if);
+  for (const auto& ng_output : ng_outputs) {
+    SaveNgOp(ng_op_map, op->name(), ng_output);
+  }
+  return Status::OK();
+}
+
+static Status TranslateWhileOp(const Node* op,
+                               const FunctionLibraryDefinition& flib,
+                               Builder::OpMap& ng_op_map) {
+  NameAttrList cond_func, body_func;
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "cond", &cond_func));
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "body", &body_func));
+
+  ov::OutputVector ng_inputs(op->num_inputs());
+  std::vector<ov::PartialShape> input_shapes;
+  for (int i = 0; i < op->num_inputs(); i++) {
+    TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, i, ng_inputs[i]));
+    input_shapes.push_back(ng_inputs[i].get_partial_shape());
+  }
+
+  // The loop variables may change their shape between iterations, so the
+  // body is translated again with the shapes it produced generalized, until
+  // it produces the shapes it takes
+  std::vector<ov::PartialShape> shapes = input_shapes;
+  ov::ParameterVector body_params;
+  ov::OutputVector body_outputs;
+  bool invariant = false;
+  while (!invariant) {
+    TF_RETURN_IF_ERROR(
+        TranslateFunction(flib, body_func, shapes, body_params, body_outputs));
+    if (body_outputs.size() != shapes.size()) {
+      return errors::InvalidArgument("The body of ", op->name(), " returns ",
+                                     body_outputs.size(), " values for ",
+                                     shapes.size(), " loop variables");
+    }
+    invariant = true;
+    for (size_t i = 0; i < shapes.size(); i++) {
+      auto shape =
+          GeneralizeShape(shapes[i], body_outputs[i].get_partial_shape());
+      if (shape != shapes[i]) {
+        shapes[i] = shape;
+        invariant = false;
+      }
+    }
+  }
+
+  // The condition is evaluated on the inputs for the first iteration, then
+  // by the body on the values it computed for the next one
+  ov::ParameterVector cond_params;
+  ov::OutputVector cond_outputs;
+  TF_RETURN_IF_ERROR(TranslateFunction(flib, cond_func, input_shapes,
+                                       cond_params, cond_outputs));
+  if (cond_outputs.size() != 1) {
+    return errors::InvalidArgument("The condition of ", op->name(),
+                                   " must return a single value");
+  }
+  InlineFunction(cond_params, ng_inputs);
+  ov::Output<ov::Node> ng_first_cond = cond_outputs[0];
+  TF_RETURN_IF_ERROR(PredicateToBool(op, ng_first_cond));
+
+  TF_RETURN_IF_ERROR(
+      TranslateFunction(flib, cond_func, shapes, cond_params, cond_outputs));
+  InlineFunction(cond_params, body_outputs);
+  ov::Output<ov::Node> ng_body_cond = cond_outputs[0];
+  TF_RETURN_IF_ERROR(PredicateToBool(op, ng_body_cond));
+
+  ov::ResultVector body_results;
+  for (const auto& body_output : body_outputs) {
+    body_results.push_back(make_shared<opset::Result>(body_output));
+  }
+  body_results.push_back(make_shared<opset::Result>(ng_body_cond));
+
+  // The loop runs until the condition is false, without a trip count
+  auto ng_trip_count = ConstructNgNode<opset::Constant>(
+      op->name(), ov::element::i64, ov::Shape{}, std::vector<int64>{-1});
+  auto ng_loop = make_shared<opset::Loop>(ng_trip_count, ng_first_cond);
+  ng_loop->set_function(
+      make_shared<ov::Model>(body_results, body_params, op->name() + "/body"));
+  ng_loop->set_special_body_ports(
+      {-1, static_cast<int64_t>(body_outputs.size())});
+  for (size_t i = 0; i < body_params.size(); i++) {
+    ng_loop->set_merged_input(body_params[i], ng_inputs[i], body_results[i]);
+  }
+  ov::OutputVector ng_outputs;
+  for (size_t i = 0; i < body_outputs.size(); i++) {
+    ng_outputs.push_back(ng_loop->get_iter_value(body_results[i], -1));
+  }
+  ng_loop->validate_and_infer_types();
+  Builder::SetTracingInfo(op->name(), ng_loop);
+  for (const auto& ng_output : ng_outputs) {
+    SaveNgOp(ng_op_map, op->name(), ng_output);
+  }
+  return Status::OK();
+}
+
+// The functional control flow ops, translated with the functions they call
+using FunctionalTranslator = Status (*)(const Node*,
+                                        const FunctionLibraryDefinition&,
+                                        Builder::OpMap&);
+const static std::map<const string, FunctionalTranslator> FUNCTIONAL_OP_MAP{
+    {"If", TranslateIfOp},
+    {"StatelessIf", TranslateIfOp},
+    {"StatelessWhile", TranslateWhileOp},
+    {"While", TranslateWhileOp},
+};
+
+// Translates the ops, in topological order, into ng_op_map
+static Status TranslateOps(const vector<const Node*>& tf_ops,
+                           const std::vector<const Tensor*>& static_input_map,
+                           const FunctionLibraryDefinition& flib,
+                           Builder::OpMap& ng_op_map) {
+  //
+  // Find the subgraphs translated to a single fused op, which can be turned
+  // off with OPENVINO_TF_PATTERN_FUSION=0.
+  //
+  std::map<const Node*, FusedPattern> fused_patterns;
+  std::set<const Node*> fused_ops;
+  if (util::GetEnv("OPENVINO_TF_PATTERN_FUSION") != "0") {
+    FindFusedPatterns(tf_ops, static_input_map, fused_patterns, fused_ops);
+  }
+
+  for (auto op : tf_ops) {
+    // Translated with the root of its pattern
+    if (fused_ops.count(op)) continue;
+
+    OVTF_VLOG(2) << "Constructing op " << op->name() << " which is "
+                 << op->type_string();
+
+    auto fused_pattern = fused_patterns.find(op);
+    if (fused_pattern != fused_patterns.end()) {
+      try {
+        TF_RETURN_IF_ERROR(fused_pattern->second.translate(ng_op_map));
+      } catch (const std::exception& e) {
+        return errors::Internal("Unhandled exception in ",
+                                fused_pattern->second.name,
+                                " pattern handler: ", op->name(), "\n",
+                                "what(): ", e.what());
+      }
+      continue;
+    }
+
+    auto functional_op = FUNCTIONAL_OP_MAP.find(op->type_string());
+    if (functional_op != FUNCTIONAL_OP_MAP.end()) {
+      try {
+        TF_RETURN_IF_ERROR(functional_op->second(op, flib, ng_op_map));
+      } catch (const std::exception& e) {
+        return errors::Internal("Unhandled exception in op handler: ",
+                                op->name(), " (", op->type_string(), ")\n",
+                                op->def().DebugString(), "\n", "what(): ",
+                                e.what());
+      }
+      continue;
+    }
+
+    const function<Status(const Node*, const std::vector<const Tensor*>&,
+                          Builder::OpMap&)>* op_fun;
+
+    try {
+      op_fun = &(TRANSLATE_OP_MAP.at(op->type_string()));
+    } catch (const std::out_of_range&) {
+      // -----------------------------
+      // Catch-all for unsupported ops
+      // -----------------------------
+      OVTF_VLOG(3) << "No translation handler registered for op: " << op->name()
+                   << " (" << op->type_string() << ")";
+      OVTF_VLOG(3) << op->def().DebugString();
+      return errors::InvalidArgument(
+          "No translation handler registered for op: ", op->name(), " (",
+          op->type_string(), ")\n", op->def().DebugString());
+    }
+
+    try {
+      TF_RETURN_IF_ERROR((*op_fun)(op, static_input_map, ng_op_map));
+    } catch (const std::exception& e) {
+      return errors::Internal("Unhandled exception in op handler: ", op->name(),
+                              " (", op->type_string(), ")\n",
+                              op->def().DebugString(), "\n", "what(): ",
+                              e.what());
+    }
+  }
+  return Status::OK();
+}
+
+// Runs a pass on the translated model, timed in the trace and the log
+template <typename T>
+static void RunPass(const shared_ptr<ov::Model>& ng_function,
+                    const char* pass_name) {
+  profiler::TraceMe trace([&] {
+    return profiler::TraceMeEncode(
+        "OVTF::Pass",
+        {{"pass", pass_name}, {"cluster", ng_function->get_friendly_name()}});
+  });
+  Timer timer;
+  ov::pass::Manager passes;
+  passes.register_pass<T>();
+  passes.run_passes(ng_function);
+  OVTF_VLOG(2) << "Pass " << pass_name << " on "
+               << ng_function->get_friendly_name() << " took "
+               << timer.ElapsedInMicroSec() << " us";
+}
+
 Status Builder::TranslateGraph(
     const std::vector<TensorShape>& inputs,
     const std::vector<const Tensor*>& static_input_map,
@@ -3747,7 +6005,8 @@ Status Builder::TranslateGraph(
     const std::vector<const Tensor*>& static_input_map,
     const Graph* input_graph, const string name,
     shared_ptr<ov::Model>& ng_function, ov::ResultVector& ng_result_list,
-    const std::vector<Tensor>& tf_input_tensors) {
+    const std::vector<Tensor>& tf_input_tensors, bool dynamic_shapes,
+    const std::vector<KVCacheInput>& kv_cache) {
   //
   // We will visit ops in topological order.
   //
@@ -3809,6 +6068,12 @@ Status Builder::TranslateGraph(
     }
   }
 
+  // The stateful axis of every input, -1 for those which are not KV-caches
+  std::vector<int> stateful_axes(inputs.size(), -1);
+  for (const auto& cache : kv_cache) {
+    stateful_axes[cache.input] = cache.Axis(inputs[cache.input].dims());
+  }
+
   for (auto parm : tf_params) {
     DataType dtype;
     if (GetNodeAttr(parm->attrs(), "T", &dtype) != Status::OK()) {
@@ -3826,10 +6091,33 @@ Status Builder::TranslateGraph(
     TF_RETURN_IF_ERROR(
         util::TFTensorShapeToNGraphShape(inputs[index], &ng_shape));
 
+    bool is_variable = false;
+    if (convert_var_const && !tf_input_tensors.empty()) {
+      try {
+        GetNodeAttr(parm->attrs(), "_is_variable", &is_variable);
+      } catch (const std::exception&) {
+        OVTF_VLOG(1) << "Parameter " << parm->name() << " is not a variable";
+      }
+    }
+
+    // In dynamic shape mode only the rank of the non-static inputs is fixed,
+    // so that one model serves every shape of that rank
+    bool dynamic_param =
+        dynamic_shapes && static_input_map[index] == nullptr && !is_variable;
+    ov::PartialShape ng_param_shape =
+        dynamic_param ? ov::PartialShape::dynamic(ng_shape.size())
+                      : ov::PartialShape(ng_shape);
+    // A KV-cache only has a dynamic length, which starts at 0
+    if (stateful_axes[index] >= 0) {
+      dynamic_param = true;
+      ng_param_shape = ov::PartialShape(ng_shape);
+      ng_param_shape[stateful_axes[index]] = ov::Dimension::dynamic();
+    }
+
     string prov_tag;
     GetNodeAttr(parm->attrs(), "_prov_tag", &prov_tag);
     auto ng_param =
-        ConstructNgNode<opset::Parameter>(prov_tag, ng_et, ng_shape);
+        ConstructNgNode<opset::Parameter>(prov_tag, ng_et, ng_param_shape);
 
     auto ng_shape_check = [ng_shape]() {
       if (ng_shape.size() > 0) {
@@ -3840,16 +6128,7 @@ Status Builder::TranslateGraph(
       return false;
     };
 
-    bool is_variable = false;
-    if (convert_var_const && !tf_input_tensors.empty()) {
-      try {
-        GetNodeAttr(parm->attrs(), "_is_variable", &is_variable);
-      } catch (const std::exception&) {
-        OVTF_VLOG(1) << "Parameter " << parm->name() << " is not a variable";
-      }
-    }
-
-    if (ng_shape_check()) {
+    if (!dynamic_param && ng_shape_check()) {
       std::vector<std::string> constant_values(ov::shape_size(ng_shape), "0");
       auto ng_const_input = ConstructNgNode<opset::Constant>(
           prov_tag, ng_et, ng_shape, constant_values);
@@ -3920,36 +6199,8 @@ Status Builder::TranslateGraph(
   //
   // Now create the OpenVINO ops from TensorFlow ops.
   //
-  for (auto op : tf_ops) {
-    OVTF_VLOG(2) << "Constructing op " << op->name() << " which is "
-                 << op->type_string();
-
-    const function<Status(const Node*, const std::vector<const Tensor*>&,
-                          Builder::OpMap&)>* op_fun;
-
-    try {
-      op_fun = &(TRANSLATE_OP_MAP.at(op->type_string()));
-    } catch (const std::out_of_range&) {
-      // -----------------------------
-      // Catch-all for unsupported ops
-      // -----------------------------
-      OVTF_VLOG(3) << "No translation handler registered for op: " << op->name()
-                   << " (" << op->type_string() << ")";
-      OVTF_VLOG(3) << op->def().DebugString();
-      return errors::InvalidArgument(
-          "No translation handler registered for op: ", op->name(), " (",
-          op->type_string(), ")\n", op->def().DebugString());
-    }
-
-    try {
-      TF_RETURN_IF_ERROR((*op_fun)(op, static_input_map, ng_op_map));
-    } catch (const std::exception& e) {
-      return errors::Internal("Unhandled exception in op handler: ", op->name(),
-                              " (", op->type_string(), ")\n",
-                              op->def().DebugString(), "\n", "what(): ",
-                              e.what());
-    }
-  }
+  TF_RETURN_IF_ERROR(TranslateOps(tf_ops, static_input_map,
+                                  input_graph->flib_def(), ng_op_map));
 
   //
   // Populate the result list.
@@ -3975,9 +6226,38 @@ Status Builder::TranslateGraph(
     auto ng_result = ConstructNgNode<opset::Result>(n->name(), result);
     ng_result_list[index] =
         ov::as_type_ptr<opset::Result>(ng_result.get_node_shared_ptr());
+    // The passes below may replace the node of the output, not the result
+    ov::Shape bound;
+    if (GetOutputBound(result.get_node_shared_ptr(), bound)) {
+      SetOutputBound(ng_result, bound);
+    }
+  }
+
+  // The past of a KV-cache is read from its variable, which the
+  // concatenation is assigned to. Its parameter is only the initial value
+  // of the variable, which keeps the length of the past dynamic, and is
+  // bound empty.
+  ov::SinkVector ng_sinks;
+  for (const auto& cache : kv_cache) {
+    auto param = ng_parameter_list[cache.input];
+    auto result = ng_result_list[cache.output];
+    auto variable = make_shared<ov::op::util::Variable>(
+        ov::op::util::VariableInfo{param->get_partial_shape(),
+                                   param->get_element_type(),
+                                   KVCacheState::VariableName(cache.input)});
+    auto consumers = param->output(0).get_target_inputs();
+    auto read = make_shared<opset::ReadValue>(param, variable);
+    read->set_friendly_name(param->get_friendly_name() + "/ReadValue");
+    for (auto consumer : consumers) {
+      consumer.replace_source_output(read->output(0));
+    }
+    auto assign =
+        make_shared<opset::Assign>(result->input_value(0), variable);
+    assign->set_friendly_name(result->get_friendly_name() + "/Assign");
+    ng_sinks.push_back(assign);
   }
 
-  auto param_dim_check = [ng_parameter_list](int i) {
+  auto param_dim_check = [&ng_parameter_list](int i) {
     auto param_shape_list = ng_parameter_list[i]->get_shape();
     for (auto dim : param_shape_list) {
       if (dim == 0) return true;
@@ -3986,7 +6266,9 @@ Status Builder::TranslateGraph(
   };
 
   for (int i = 0; i < ng_parameter_list.size(); i++) {
-    if (!(ng_parameter_list[i]->get_shape().size() > 0 && param_dim_check(i))) {
+    // Parameters with dynamic dimensions never have a zero sized dimension
+    if (ng_parameter_list[i]->get_partial_shape().is_dynamic() ||
+        !(ng_parameter_list[i]->get_shape().size() > 0 && param_dim_check(i))) {
       ng_func_parameter_list.push_back(ng_parameter_list[i]);
     }
   }
@@ -4010,7 +6292,7 @@ Status Builder::TranslateGraph(
   // Create the OpenVINO Model.
   //
   try {
-    ng_function = make_shared<ov::Model>(ng_func_result_list,
+    ng_function = make_shared<ov::Model>(ng_func_result_list, ng_sinks,
                                          ng_func_parameter_list, name);
   } catch (const std::exception& exp) {
     return errors::Internal("Failed to create OpenVINO Model for " + name +
@@ -4021,14 +6303,34 @@ Status Builder::TranslateGraph(
   // Apply additional passes on the OpenVINO Model here.
   //
   {
-    ov::pass::Manager passes;
-    if (util::GetEnv("OPENVINO_TF_CONSTANT_FOLDING") == "1") {
-      passes.register_pass<ov::pass::ConstantFolding>();
+    // The simplifications first, so that the layout passes see the folded
+    // shapes
+    string constant_folding = util::GetEnv("OPENVINO_TF_CONSTANT_FOLDING");
+    bool simplification =
+        util::GetEnv("OPENVINO_TF_GRAPH_SIMPLIFICATION") != "0";
+    if (simplification) {
+      RunPass<pass::FoldStaticShapes>(ng_function, "FoldStaticShapes");
+    }
+    if (constant_folding == "1") {
+      RunPass<ov::pass::ConstantFolding>(ng_function, "ConstantFolding");
+    } else if (constant_folding != "0") {
+      RunPass<pass::BoundedConstantFolding>(ng_function,
+                                            "BoundedConstantFolding");
+    }
+    if (simplification) {
+      RunPass<pass::EliminateCommonSubexpressions>(
+          ng_function, "EliminateCommonSubexpressions");
+      RunPass<pass::CollapseReshapes>(ng_function, "CollapseReshapes");
+    }
+    if (util::GetEnv("OPENVINO_TF_NARROW_INDEX_TYPES") != "0") {
+      RunPass<pass::NarrowIndexTypes>(ng_function, "NarrowIndexTypes");
     }
     if (util::GetEnv("OPENVINO_TF_TRANSPOSE_SINKING") != "0") {
-      passes.register_pass<pass::TransposeSinking>();
+      RunPass<pass::TransposeSinking>(ng_function, "TransposeSinking");
+    }
+    if (util::GetEnv("OPENVINO_TF_LAYOUT_PLANNING") != "0") {
+      RunPass<pass::LayoutPlanning>(ng_function, "LayoutPlanning");
     }
-    passes.run_passes(ng_function);
   }
   OVTF_VLOG(5) << "Done with passes";
   //
@@ -4039,6 +6341,8 @@ Status Builder::TranslateGraph(
     result->set_needs_default_layout(true);
   }
   NGRAPH_SUPPRESS_DEPRECATED_END
+  // After the passes, which may move ops in and out of the chains
+  RecordForwardableInputs(ng_result_list, ng_parameter_list);
   return Status::OK();
 }
 
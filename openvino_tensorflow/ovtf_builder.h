@@ -14,6 +14,8 @@
 
 #include "openvino/core/validation_util.hpp"
 
+#include "openvino_tensorflow/kv_cache.h"
+
 namespace tensorflow {
 namespace openvino_tensorflow {
 
@@ -29,7 +31,9 @@ class Builder {
       const std::vector<const Tensor*>& static_input_map, const Graph* tf_graph,
       const string name, std::shared_ptr<ov::Model>& ng_function,
       ov::ResultVector& ng_func_result_list,
-      const std::vector<Tensor>& tf_input_tensors);
+      const std::vector<Tensor>& tf_input_tensors,
+      bool dynamic_shapes = false,
+      const std::vector<KVCacheInput>& kv_cache = {});
 
   using OpMap =
       std::unordered_map<std::string, std::vector<ov::Output<ov::Node>>>;
@@ -70,6 +74,23 @@ class Builder {
   // 3. Prints a log if OPENVINO_TF_LOG_PLACEMENT=1
   static void SetTracingInfo(const std::string& op_name,
                              const ov::Output<ov::Node> ng_node);
+
+  // Records the upper bound of the dynamic shape of a translated output,
+  // like the at most max_output_size indices of NonMaxSuppression, as known
+  // at translation time. The bound is carried over to the result the output
+  // feeds, so that the result can be allocated to it before the inference.
+  static void SetOutputBound(const ov::Output<ov::Node>& output,
+                             const ov::Shape& bound);
+  // The bound recorded for node, false if there is none
+  static bool GetOutputBound(const std::shared_ptr<ov::Node>& node,
+                             ov::Shape& bound);
+
+  // The TF inputs the TF output of the translated result node may be
+  // forwarded from, the device computing it in their buffer. False if the
+  // result is computed from another op than a chain of elementwise ops
+  // only reading them.
+  static bool GetForwardableInputs(const std::shared_ptr<ov::Node>& node,
+                                   std::vector<int>& inputs);
 };
 
 }  // namespace openvino_tensorflow
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -23,6 +24,9 @@
 #include "openvino_tensorflow/version.h"
 #ifdef _WIN32
 #include <windows.h>
+#elif defined(__linux__)
+#include <dirent.h>
+#include <sched.h>
 #endif
 
 using namespace std;
@@ -278,6 +282,97 @@ string GetEnv(const std::string& env) {
 
 void SetEnv(const char* env, const char* val) { setenv(env, val, 1); }
 
+void AppendJsonString(std::ostream& out, const string& str) {
+  out << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out << ' ';
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+// Parses a sysfs CPU list such as "0-13,28-41"
+static vector<int> ParseCPUList(const string& list) {
+  vector<int> cpus;
+  stringstream ss(list);
+  string range;
+  while (getline(ss, range, ',')) {
+    size_t dash = range.find('-');
+    try {
+      int first = std::stoi(range.substr(0, dash));
+      int last =
+          dash == string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int cpu = first; cpu <= last; cpu++) cpus.push_back(cpu);
+    } catch (const std::exception&) {
+      continue;
+    }
+  }
+  return cpus;
+}
+
+const std::vector<std::vector<int>>& NUMANodeCPUs() {
+  static const vector<vector<int>> nodes = []() {
+    vector<vector<int>> cpus;
+#ifdef __linux__
+    const string root = "/sys/devices/system/node/";
+    DIR* dir = opendir(root.c_str());
+    if (dir != nullptr) {
+      struct dirent* entry;
+      while ((entry = readdir(dir)) != nullptr) {
+        string name = entry->d_name;
+        if (name.compare(0, 4, "node") != 0 || name.size() == 4 ||
+            !std::all_of(name.begin() + 4, name.end(), ::isdigit)) {
+          continue;
+        }
+        size_t node = std::stoul(name.substr(4));
+        if (node >= cpus.size()) cpus.resize(node + 1);
+        std::ifstream list(root + name + "/cpulist");
+        string line;
+        getline(list, line);
+        cpus[node] = ParseCPUList(line);
+      }
+      closedir(dir);
+    }
+#endif
+    if (cpus.empty()) cpus.resize(1);
+    return cpus;
+  }();
+  return nodes;
+}
+
+int CurrentNUMANode() {
+#ifdef __linux__
+  const auto& nodes = NUMANodeCPUs();
+  if (nodes.size() < 2) return 0;
+  int cpu = sched_getcpu();
+  for (int node = 0; node < nodes.size(); node++) {
+    if (std::find(nodes[node].begin(), nodes[node].end(), cpu) !=
+        nodes[node].end()) {
+      return node;
+    }
+  }
+#endif
+  return 0;
+}
+
+bool BindThreadToNUMANode(int node) {
+#ifdef __linux__
+  const auto& nodes = NUMANodeCPUs();
+  if (node < 0 || node >= nodes.size() || nodes[node].empty()) return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : nodes[node]) CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
 }  // namespace util
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
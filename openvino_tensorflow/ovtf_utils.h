@@ -11,6 +11,7 @@
 #include <fstream>
 #include <ostream>
 #include <sstream>
+#include <vector>
 
 #include "tensorflow/core/common_runtime/dma_helper.h"
 #include "tensorflow/core/common_runtime/optimization_registry.h"
@@ -65,6 +66,18 @@ string GetEnv(const std::string& env);
 // Set the environment variable env with val
 void SetEnv(const char* env, const char* val);
 
+// Writes str to out as a JSON string, the control characters replaced with
+// spaces
+void AppendJsonString(std::ostream& out, const string& str);
+
+// The CPUs of every NUMA node, read once from sysfs. A single node with no
+// CPUs listed when the topology is not known.
+const std::vector<std::vector<int>>& NUMANodeCPUs();
+// The NUMA node of the CPU the calling thread runs on, 0 if it is not known
+int CurrentNUMANode();
+// Restricts the calling thread to the CPUs of node, false if it can not be
+bool BindThreadToNUMANode(int node);
+
 }  // namespace util
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -0,0 +1,306 @@
+/*****************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+*****************************************************************************/
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ngraph/ngraph.hpp"
+#include "openvino/core/attribute_visitor.hpp"
+#include "openvino/op/util/multi_subgraph_base.hpp"
+#include "openvino/op/util/op_types.hpp"
+#include "openvino/opsets/opset8.hpp"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/pass/graph_simplification.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace pass {
+
+constexpr size_t BoundedConstantFolding::kDefaultMaxBytes;
+constexpr size_t EliminateCommonSubexpressions::kMaxConstantBytes;
+
+static void ReplaceWithConstant(const shared_ptr<ov::Node>& node,
+                                const shared_ptr<opset::Constant>& constant) {
+  constant->set_friendly_name(node->get_friendly_name());
+  ov::replace_node(node, constant);
+}
+
+static bool IsShapeOf(const ov::Node* node) {
+  return ov::is_type<ov::op::v0::ShapeOf>(node) ||
+         ov::is_type<ov::op::v3::ShapeOf>(node);
+}
+
+// The constant of the dimensions of the shape read by a Gather with
+// constant indices along axis 0, null when one of them is not static
+static shared_ptr<opset::Constant> GatheredDimensions(
+    const shared_ptr<opset::Gather>& gather) {
+  auto shape_of = gather->get_input_node_ptr(0);
+  auto indices = ov::as_type_ptr<opset::Constant>(
+      gather->get_input_node_shared_ptr(1));
+  auto axis = ov::as_type_ptr<opset::Constant>(
+      gather->get_input_node_shared_ptr(2));
+  if (!IsShapeOf(shape_of) || !indices || !axis ||
+      gather->get_batch_dims() != 0 ||
+      axis->cast_vector<int64_t>() != vector<int64_t>{0} ||
+      gather->get_output_partial_shape(0).is_dynamic()) {
+    return nullptr;
+  }
+  const auto& shape = shape_of->get_input_partial_shape(0);
+  if (shape.rank().is_dynamic()) return nullptr;
+  const int64_t rank = shape.rank().get_length();
+  vector<int64_t> dims;
+  for (int64_t index : indices->cast_vector<int64_t>()) {
+    if (index < 0) index += rank;
+    if (index < 0 || index >= rank || shape[index].is_dynamic()) {
+      return nullptr;
+    }
+    dims.push_back(shape[index].get_length());
+  }
+  return make_shared<opset::Constant>(gather->get_output_element_type(0),
+                                      gather->get_output_shape(0), dims);
+}
+
+bool FoldStaticShapes::run_on_function(shared_ptr<ov::Model> f) {
+  m_folded_ops = 0;
+  for (const auto& node : f->get_ordered_ops()) {
+    shared_ptr<opset::Constant> constant;
+    if (IsShapeOf(node.get())) {
+      const auto& shape = node->get_input_partial_shape(0);
+      if (shape.is_dynamic()) continue;
+      vector<int64_t> dims;
+      for (size_t dim : shape.to_shape()) dims.push_back(dim);
+      constant = make_shared<opset::Constant>(
+          node->get_output_element_type(0), ov::Shape{dims.size()}, dims);
+    } else if (auto gather = ov::as_type_ptr<opset::Gather>(node)) {
+      constant = GatheredDimensions(gather);
+    }
+    if (!constant) continue;
+    ReplaceWithConstant(node, constant);
+    m_folded_ops++;
+  }
+  return m_folded_ops > 0;
+}
+
+bool BoundedConstantFolding::run_on_function(shared_ptr<ov::Model> f) {
+  m_folded_ops = 0;
+  for (const auto& node : f->get_ordered_ops()) {
+    // The random ops draw new values on every inference
+    if (node->get_input_size() == 0 || ov::op::util::is_constant(node) ||
+        ov::is_type<ov::opset8::RandomUniform>(node)) {
+      continue;
+    }
+    bool constant_inputs = true;
+    for (const auto& input : node->input_values()) {
+      constant_inputs &= ov::op::util::is_constant(input.get_node());
+    }
+    if (!constant_inputs) continue;
+    size_t bytes = 0;
+    bool static_outputs = true;
+    for (const auto& output : node->outputs()) {
+      if (output.get_partial_shape().is_dynamic() ||
+          output.get_element_type().is_dynamic()) {
+        static_outputs = false;
+        break;
+      }
+      bytes += ov::shape_size(output.get_shape()) *
+               output.get_element_type().size();
+    }
+    if (!static_outputs || bytes > m_max_bytes) continue;
+
+    ov::OutputVector folded(node->get_output_size());
+    if (!node->constant_fold(folded, node->input_values())) continue;
+    for (size_t i = 0; i < folded.size(); i++) {
+      folded[i].get_node()->set_friendly_name(
+          folded.size() == 1 ? node->get_friendly_name()
+                             : node->get_friendly_name() + "." + to_string(i));
+      node->output(i).replace(folded[i]);
+    }
+    m_folded_ops++;
+  }
+  OVTF_VLOG(2) << "Folded " << m_folded_ops << " ops of "
+               << f->get_friendly_name() << " into constants";
+  return m_folded_ops > 0;
+}
+
+// Writes the attributes an op visits into a string, the op can not be
+// compared when one of them is of a type it does not read
+class AttributeSignature : public ov::AttributeVisitor {
+ public:
+  using ov::AttributeVisitor::on_adapter;
+
+  void on_adapter(const string& name, ov::ValueAccessor<void>&) override {
+    m_known = false;
+  }
+  void on_adapter(const string& name, ov::ValueAccessor<void*>&) override {
+    m_known = false;
+  }
+  void on_adapter(const string& name,
+                  ov::ValueAccessor<string>& adapter) override {
+    m_out << name << "=" << adapter.get().size() << ":" << adapter.get()
+          << ";";
+  }
+  void on_adapter(const string& name,
+                  ov::ValueAccessor<bool>& adapter) override {
+    m_out << name << "=" << adapter.get() << ";";
+  }
+  void on_adapter(const string& name,
+                  ov::ValueAccessor<int64_t>& adapter) override {
+    m_out << name << "=" << adapter.get() << ";";
+  }
+  void on_adapter(const string& name,
+                  ov::ValueAccessor<double>& adapter) override {
+    m_out.precision(17);
+    m_out << name << "=" << adapter.get() << ";";
+  }
+  void on_adapter(const string& name,
+                  ov::ValueAccessor<vector<int32_t>>& adapter) override {
+    AddVector(name, adapter.get());
+  }
+  void on_adapter(const string& name,
+                  ov::ValueAccessor<vector<int64_t>>& adapter) override {
+    AddVector(name, adapter.get());
+  }
+  void on_adapter(const string& name,
+                  ov::ValueAccessor<vector<uint64_t>>& adapter) override {
+    AddVector(name, adapter.get());
+  }
+  void on_adapter(const string& name,
+                  ov::ValueAccessor<vector<float>>& adapter) override {
+    m_out.precision(9);
+    AddVector(name, adapter.get());
+  }
+  void on_adapter(const string& name,
+                  ov::ValueAccessor<vector<string>>& adapter) override {
+    m_out << name << "=[";
+    for (const auto& value : adapter.get()) {
+      m_out << value.size() << ":" << value << ",";
+    }
+    m_out << "];";
+  }
+
+  bool IsKnown() const { return m_known; }
+  string Get() const { return m_out.str(); }
+
+ private:
+  template <typename T>
+  void AddVector(const string& name, const vector<T>& values) {
+    m_out << name << "=[";
+    for (const auto& value : values) m_out << value << ",";
+    m_out << "];";
+  }
+
+  ostringstream m_out;
+  bool m_known = true;
+};
+
+// The key of what node computes, false when it can not be compared with
+// the other ops
+static bool Signature(const shared_ptr<ov::Node>& node, string& signature) {
+  if (ov::op::util::is_parameter(node) || ov::op::util::is_output(node) ||
+      ov::op::util::is_sink(node) ||
+      ov::is_type<ov::op::util::MultiSubGraphOp>(node) ||
+      ov::is_type<ov::opset8::RandomUniform>(node) ||
+      ov::is_type<opset::ReadValue>(node)) {
+    return false;
+  }
+  const auto& type_info = node->get_type_info();
+  ostringstream out;
+  out << type_info.name << "/"
+      << (type_info.version_id ? type_info.version_id : "") << "(";
+  for (const auto& input : node->input_values()) {
+    out << static_cast<const void*>(input.get_node()) << ":"
+        << input.get_index() << ",";
+  }
+  out << ")";
+  if (auto constant = ov::as_type_ptr<opset::Constant>(node)) {
+    size_t bytes = constant->get_byte_size();
+    if (bytes > EliminateCommonSubexpressions::kMaxConstantBytes) {
+      return false;
+    }
+    out << constant->get_element_type() << constant->get_shape();
+    signature = out.str();
+    signature.append(static_cast<const char*>(constant->get_data_ptr()),
+                     bytes);
+    return true;
+  }
+  AttributeSignature attributes;
+  if (!node->visit_attributes(attributes) || !attributes.IsKnown()) {
+    return false;
+  }
+  signature = out.str() + attributes.Get();
+  return true;
+}
+
+bool EliminateCommonSubexpressions::run_on_function(shared_ptr<ov::Model> f) {
+  m_eliminated_ops = 0;
+  map<string, shared_ptr<ov::Node>> computed;
+  // In topological order, the inputs of an op are already replaced with
+  // the first op computing them
+  for (const auto& node : f->get_ordered_ops()) {
+    string signature;
+    if (!Signature(node, signature)) continue;
+    auto it = computed.emplace(signature, node);
+    if (it.second) continue;
+    const auto& first = it.first->second;
+    for (size_t i = 0; i < node->get_output_size(); i++) {
+      node->output(i).replace(first->output(i));
+    }
+    m_eliminated_ops++;
+  }
+  OVTF_VLOG(2) << "Eliminated " << m_eliminated_ops << " ops of "
+               << f->get_friendly_name() << " computed twice";
+  return m_eliminated_ops > 0;
+}
+
+static bool IsReshape(const ov::Node* node) {
+  return ov::is_type<opset::Reshape>(node) ||
+         ov::is_type<opset::Squeeze>(node) ||
+         ov::is_type<opset::Unsqueeze>(node);
+}
+
+bool CollapseReshapes::run_on_function(shared_ptr<ov::Model> f) {
+  m_collapsed_chains = 0;
+  m_removed_chains = 0;
+  for (const auto& node : f->get_ordered_ops()) {
+    if (!IsReshape(node.get()) ||
+        node->get_output_partial_shape(0).is_dynamic()) {
+      continue;
+    }
+    // The reshapes before it are already collapsed into one
+    auto source = node->input_value(0);
+    while (IsReshape(source.get_node())) {
+      source = source.get_node()->input_value(0);
+    }
+    const auto& shape = node->get_output_shape(0);
+    if (source.get_partial_shape().is_static() &&
+        source.get_shape() == shape) {
+      node->output(0).replace(source);
+      m_removed_chains++;
+      continue;
+    }
+    if (source == node->input_value(0)) continue;
+    vector<int64_t> dims(shape.begin(), shape.end());
+    auto reshape = make_shared<opset::Reshape>(
+        source,
+        make_shared<opset::Constant>(ov::element::i64,
+                                     ov::Shape{dims.size()}, dims),
+        false);
+    reshape->set_friendly_name(node->get_friendly_name());
+    ov::replace_node(node, reshape);
+    m_collapsed_chains++;
+  }
+  return m_collapsed_chains + m_removed_chains > 0;
+}
+
+}  // namespace pass
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,91 @@
+/*****************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+*****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/pass.hpp"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace pass {
+
+// The simplifications run on every translated model before the layout
+// passes. They only rewrite what the translation of TF ops leaves behind,
+// the shape arithmetic, the repeated constants and subexpressions and the
+// chains of reshapes, and never grow the model.
+
+// Replaces the ShapeOf of a static shape, and the Gather of the static
+// dimensions of a shape, with a constant
+class FoldStaticShapes : public ngraph::pass::FunctionPass {
+ public:
+  bool run_on_function(std::shared_ptr<ov::Model> function) override;
+
+  // The ShapeOf and Gather replaced in the last run
+  size_t GetFoldedOps() const { return m_folded_ops; }
+
+ private:
+  size_t m_folded_ops = 0;
+};
+
+// Folds the ops whose inputs are all constants into a constant, when their
+// outputs take at most max_bytes. Unlike the folding of OpenVINO, it does
+// not make a copy of large weights, e.g. for the Transpose or the Convert
+// of the kernel of a convolution, which the plugins fuse when they compile
+// the model.
+class BoundedConstantFolding : public ngraph::pass::FunctionPass {
+ public:
+  explicit BoundedConstantFolding(size_t max_bytes = kDefaultMaxBytes)
+      : m_max_bytes(max_bytes) {}
+  bool run_on_function(std::shared_ptr<ov::Model> function) override;
+
+  size_t GetFoldedOps() const { return m_folded_ops; }
+
+  static constexpr size_t kDefaultMaxBytes = 1 << 20;
+
+ private:
+  size_t m_max_bytes;
+  size_t m_folded_ops = 0;
+};
+
+// Replaces the ops which compute the same as an earlier op, the same type
+// with the same attributes reading the same inputs, with the earlier op.
+// The constants of up to kMaxConstantBytes are compared by value. The ops
+// with attributes it can not compare, those with a body, and the random
+// and stateful ops are kept.
+class EliminateCommonSubexpressions : public ngraph::pass::FunctionPass {
+ public:
+  bool run_on_function(std::shared_ptr<ov::Model> function) override;
+
+  size_t GetEliminatedOps() const { return m_eliminated_ops; }
+
+  static constexpr size_t kMaxConstantBytes = 4096;
+
+ private:
+  size_t m_eliminated_ops = 0;
+};
+
+// Replaces a chain of Reshape, Squeeze and Unsqueeze of a static shape
+// with a single Reshape of the input of the chain, or with that input when
+// the chain does not change its shape
+class CollapseReshapes : public ngraph::pass::FunctionPass {
+ public:
+  bool run_on_function(std::shared_ptr<ov::Model> function) override;
+
+  // The chains replaced with a Reshape, and the chains removed
+  size_t GetCollapsedChains() const { return m_collapsed_chains; }
+  size_t GetRemovedChains() const { return m_removed_chains; }
+
+ private:
+  size_t m_collapsed_chains = 0;
+  size_t m_removed_chains = 0;
+};
+
+}  // namespace pass
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,234 @@
+/*****************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+*****************************************************************************/
+
+#include <vector>
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/op/util/op_types.hpp"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/pass/layout_planning.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace pass {
+
+// Bounds the rounds over the model, each of which strictly reduces the
+// number of Transposes
+static const int kMaxRounds = 16;
+// The ops looked ahead of an input to find whether the Transposes moved to
+// it can be moved further up
+static const int kMaxLookahead = 8;
+
+static bool GetTransposeOrder(const shared_ptr<ov::Node>& node,
+                              ngraph::AxisVector& order) {
+  auto transpose = ngraph::as_type_ptr<opset::Transpose>(node);
+  if (transpose == nullptr) return false;
+  auto constant = ngraph::as_type_ptr<opset::Constant>(
+      transpose->input_value(1).get_node_shared_ptr());
+  if (constant == nullptr) return false;
+  order = constant->get_axis_vector_val();
+  return true;
+}
+
+static bool IsIdentity(const ngraph::AxisVector& order) {
+  for (size_t i = 0; i < order.size(); i++) {
+    if (order[i] != i) return false;
+  }
+  return true;
+}
+
+static ov::Output<ov::Node> MakeTranspose(ov::Output<ov::Node> arg,
+                                          const ngraph::AxisVector& order) {
+  auto ng_order = make_shared<opset::Constant>(
+      ov::element::u64, ov::Shape{order.size()}, order);
+  auto transpose = make_shared<opset::Transpose>(arg, ng_order);
+  // The Transposes of constants are folded right away
+  ov::OutputVector folded(1);
+  if (ngraph::op::is_constant(arg.get_node()) &&
+      transpose->constant_fold(folded, transpose->input_values())) {
+    return folded[0];
+  }
+  return transpose;
+}
+
+// Replaces transpose(transpose(x, inner), outer) by x, or by a single
+// Transpose of x
+static bool CombineTransposes(const shared_ptr<ov::Node>& node) {
+  ngraph::AxisVector outer, inner;
+  if (!GetTransposeOrder(node, outer) ||
+      !GetTransposeOrder(node->get_input_node_shared_ptr(0), inner) ||
+      inner.size() != outer.size()) {
+    return false;
+  }
+  ngraph::AxisVector combined(outer.size());
+  for (size_t i = 0; i < outer.size(); i++) combined[i] = inner[outer[i]];
+  auto source = node->get_input_node_shared_ptr(0)->input_value(0);
+  OVTF_VLOG(4) << "Combining " << node->get_name() << " with "
+               << node->get_input_node_shared_ptr(0)->get_name();
+  node->output(0).replace(IsIdentity(combined) ? source
+                                               : MakeTranspose(source,
+                                                               combined));
+  return true;
+}
+
+static bool IsLayoutAgnostic(const shared_ptr<ov::Node>& node) {
+  return ngraph::op::is_unary_elementwise_arithmetic(node) ||
+         ngraph::op::is_binary_elementwise_arithmetic(node) ||
+         ngraph::op::is_binary_elementwise_comparison(node) ||
+         ngraph::op::is_binary_elementwise_logical(node) ||
+         ngraph::is_type<opset::Convert>(node) ||
+         ngraph::is_type<opset::Clamp>(node) ||
+         ngraph::is_type<opset::Concat>(node);
+}
+
+// The number of Transposes left once a Transpose is added after output, 0
+// if it can be folded into a constant, combined with the Transpose feeding
+// it, or moved further up through the inputs of a layout agnostic op which
+// output only feeds it, looking up to depth ops ahead
+static size_t GetTransposeCost(const ov::Output<ov::Node>& output,
+                               int depth) {
+  auto node = output.get_node_shared_ptr();
+  auto rank = output.get_partial_shape().rank();
+  if (rank.is_static() && rank.get_length() == 0) return 0;
+  if (ngraph::op::is_constant(node)) return 0;
+  if (output.get_target_inputs().size() != 1) return 1;
+  ngraph::AxisVector order;
+  if (GetTransposeOrder(node, order)) return 0;
+  if (depth == 0 || !IsLayoutAgnostic(node) || node->get_output_size() != 1 ||
+      rank.is_dynamic()) {
+    return 1;
+  }
+  for (const auto& input : node->input_values()) {
+    auto input_rank = input.get_partial_shape().rank();
+    if (input_rank.is_dynamic() ||
+        (input_rank.get_length() != 0 &&
+         input_rank.get_length() != rank.get_length()) ||
+        GetTransposeCost(input, depth - 1) > 0) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Moves the Transposes, of the same order, every user of the node is fed
+// through to the inputs of the node, if fewer are left on the inputs than
+// are removed. The Transposes of the constants are folded and the ones
+// added after a Transpose are combined with it later.
+static bool MoveTransposesToInputs(const shared_ptr<ov::Node>& node) {
+  if (!IsLayoutAgnostic(node) || node->get_output_size() != 1) return false;
+  auto rank = node->get_output_partial_shape(0).rank();
+  if (rank.is_dynamic()) return false;
+
+  ngraph::AxisVector order;
+  vector<ov::Input<ov::Node>> users;
+  for (const auto& input : node->output(0).get_target_inputs()) {
+    ngraph::AxisVector user_order;
+    if (input.get_index() != 0 ||
+        !GetTransposeOrder(input.get_node()->shared_from_this(),
+                           user_order) ||
+        (!users.empty() && user_order != order)) {
+      return false;
+    }
+    order = user_order;
+    users.push_back(input);
+  }
+  if (users.empty() ||
+      static_cast<int64_t>(order.size()) != rank.get_length()) {
+    return false;
+  }
+
+  size_t added = 0;
+  for (const auto& input : node->input_values()) {
+    auto input_rank = input.get_partial_shape().rank();
+    if (input_rank.is_dynamic()) return false;
+    // The scalars broadcast to any layout, the lower ranks would need to be
+    // unsqueezed first
+    if (input_rank.get_length() == 0) continue;
+    if (input_rank.get_length() != rank.get_length()) return false;
+    added += GetTransposeCost(input, kMaxLookahead);
+  }
+  if (added >= users.size()) return false;
+
+  ov::OutputVector new_inputs;
+  for (const auto& input : node->input_values()) {
+    if (input.get_partial_shape().rank().get_length() == 0) {
+      new_inputs.push_back(input);
+    } else {
+      new_inputs.push_back(MakeTranspose(input, order));
+    }
+  }
+  shared_ptr<ov::Node> new_node;
+  if (auto concat = ngraph::as_type_ptr<opset::Concat>(node)) {
+    // The concatenation axis in the order of the users
+    size_t axis = concat->get_concatenation_axis();
+    int64_t new_axis = 0;
+    while (order[new_axis] != axis) new_axis++;
+    new_node = make_shared<opset::Concat>(new_inputs, new_axis);
+  } else {
+    new_node = node->clone_with_new_inputs(new_inputs);
+  }
+  new_node->set_friendly_name(node->get_friendly_name());
+  ngraph::copy_runtime_info(node, new_node);
+  OVTF_VLOG(4) << "Moving " << users.size() << " Transposes of "
+               << node->get_name() << " to its inputs, adding " << added;
+  for (const auto& user : users) {
+    user.get_node()->output(0).replace(new_node->output(0));
+  }
+  return true;
+}
+
+size_t LayoutPlanning::CountTransposes(const shared_ptr<ov::Model>& function) {
+  size_t count = 0;
+  for (const auto& node : function->get_ops()) {
+    if (!ngraph::is_type<opset::Transpose>(node)) continue;
+    ngraph::AxisVector order;
+    if (!GetTransposeOrder(node, order) || !IsIdentity(order)) count++;
+  }
+  return count;
+}
+
+bool LayoutPlanning::run_on_function(shared_ptr<ov::Model> f) {
+  m_transposes_before = CountTransposes(f);
+  bool changed = true;
+  for (int round = 0; changed && round < kMaxRounds; round++) {
+    changed = false;
+    // From the results, so that the Transposes move up in a single round
+    auto ops = f->get_ordered_ops();
+    for (auto it = ops.rbegin(); it != ops.rend(); ++it) {
+      const auto& node = *it;
+      // Replaced in this round
+      if (node->get_users().empty()) continue;
+      if (CombineTransposes(node) || MoveTransposesToInputs(node)) {
+        changed = true;
+      }
+    }
+  }
+
+  bool removed = false;
+  for (const auto& node : f->get_ordered_ops()) {
+    ngraph::AxisVector order;
+    if (GetTransposeOrder(node, order) && IsIdentity(order) &&
+        !node->get_users().empty()) {
+      node->output(0).replace(node->input_value(0));
+      removed = true;
+    }
+  }
+  f->validate_nodes_and_infer_types();
+
+  m_transposes_after = CountTransposes(f);
+  OVTF_VLOG(1) << "Layout planning of " << f->get_friendly_name() << ": "
+               << m_transposes_before << " Transposes before, "
+               << m_transposes_after << " after";
+  return removed || m_transposes_after != m_transposes_before;
+}
+
+}  // namespace pass
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,41 @@
+/*****************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+*****************************************************************************/
+
+#pragma once
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/pass.hpp"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace pass {
+
+// Plans the layouts of the whole model once TransposeSinking moved the
+// Transposes down to the ops it can not sink them through. The Transposes
+// in front of a layout agnostic op (elementwise ops and Concat) are moved
+// to its inputs when this removes more Transposes than it adds, after which
+// chains of Transposes are combined and the identities removed. What is
+// left converts the layouts at the boundaries of the cluster and around the
+// layout specific ops only.
+class LayoutPlanning : public ngraph::pass::FunctionPass {
+ public:
+  bool run_on_function(std::shared_ptr<ov::Model> function) override;
+
+  // The number of Transposes of the model which are not identities
+  static size_t CountTransposes(const std::shared_ptr<ov::Model>& function);
+
+  // The number of Transposes before and after the last run
+  size_t GetTransposesBefore() const { return m_transposes_before; }
+  size_t GetTransposesAfter() const { return m_transposes_after; }
+
+ private:
+  size_t m_transposes_before = 0;
+  size_t m_transposes_after = 0;
+};
+
+}  // namespace pass
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,334 @@
+/*****************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+*****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "ngraph/ngraph.hpp"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/pass/narrow_index_types.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace pass {
+
+// The bounds of the values of an output. Doubles represent every bound
+// that fits in i32 exactly, and order the larger ones correctly.
+struct Interval {
+  double lo;
+  double hi;
+};
+
+static const double kInt32Min = numeric_limits<int32_t>::min();
+static const double kInt32Max = numeric_limits<int32_t>::max();
+static const Interval kUnbounded{-HUGE_VAL, HUGE_VAL};
+
+static bool FitsInt32(const Interval& interval) {
+  return interval.lo >= kInt32Min && interval.hi <= kInt32Max;
+}
+
+static Interval Union(const Interval& a, const Interval& b) {
+  return {min(a.lo, b.lo), max(a.hi, b.hi)};
+}
+
+// The bounds of the values of an output of type
+static Interval TypeInterval(const ov::element::Type& type) {
+  switch (type) {
+    case ov::element::Type_t::boolean:
+      return {0, 1};
+    case ov::element::Type_t::i8:
+      return {numeric_limits<int8_t>::min(), numeric_limits<int8_t>::max()};
+    case ov::element::Type_t::u8:
+      return {0, numeric_limits<uint8_t>::max()};
+    case ov::element::Type_t::i16:
+      return {numeric_limits<int16_t>::min(), numeric_limits<int16_t>::max()};
+    case ov::element::Type_t::u16:
+      return {0, numeric_limits<uint16_t>::max()};
+    case ov::element::Type_t::i32:
+      return {kInt32Min, kInt32Max};
+    case ov::element::Type_t::u32:
+      return {0, numeric_limits<uint32_t>::max()};
+    default:
+      return kUnbounded;
+  }
+}
+
+// The inputs of node its values are computed from, which are narrowed
+// along with it. False if node is not narrowed.
+static bool GetDataInputs(const ov::Node* node, vector<size_t>& inputs) {
+  inputs.clear();
+  if (ov::is_type<opset::Constant>(node) || ov::is_type<opset::ShapeOf>(node) ||
+      ov::is_type<opset::Range>(node)) {
+    return true;
+  }
+  if (ov::is_type<opset::Add>(node) || ov::is_type<opset::Subtract>(node) ||
+      ov::is_type<opset::Multiply>(node) || ov::is_type<opset::Divide>(node) ||
+      ov::is_type<opset::FloorMod>(node) || ov::is_type<opset::Mod>(node) ||
+      ov::is_type<opset::Maximum>(node) || ov::is_type<opset::Minimum>(node)) {
+    inputs = {0, 1};
+    return true;
+  }
+  if (ov::is_type<opset::Select>(node)) {
+    inputs = {1, 2};
+    return true;
+  }
+  if (ov::is_type<opset::Concat>(node)) {
+    for (size_t i = 0; i < node->get_input_size(); i++) inputs.push_back(i);
+    return true;
+  }
+  if (ov::is_type<opset::Convert>(node)) {
+    // A Convert from a narrower type is where the narrowing starts
+    if (node->get_input_element_type(0) == ov::element::i64) inputs = {0};
+    return true;
+  }
+  if (ov::is_type<opset::Negative>(node) || ov::is_type<opset::Abs>(node) ||
+      ov::is_type<opset::Gather>(node) || ov::is_type<opset::Reshape>(node) ||
+      ov::is_type<opset::Squeeze>(node) ||
+      ov::is_type<opset::Unsqueeze>(node) ||
+      ov::is_type<opset::StridedSlice>(node) ||
+      ov::is_type<opset::Broadcast>(node) || ov::is_type<opset::Tile>(node) ||
+      ov::is_type<opset::Transpose>(node) ||
+      ov::is_type<opset::ReduceMin>(node) ||
+      ov::is_type<opset::ReduceMax>(node) ||
+      ov::is_type<opset::ReduceSum>(node) ||
+      ov::is_type<opset::ReduceProd>(node)) {
+    inputs = {0};
+    return true;
+  }
+  return false;
+}
+
+// Whether input index of node, an index or a shape, reads i32 as well as
+// i64 whatever the type of its other inputs
+static bool AcceptsInt32(const ov::Node* node, size_t index) {
+  if (ov::is_type<opset::Gather>(node) || ov::is_type<opset::Broadcast>(node) ||
+      ov::is_type<opset::VariadicSplit>(node)) {
+    return index == 1 || index == 2;
+  }
+  if (ov::is_type<opset::StridedSlice>(node)) {
+    return index >= 1 && index <= 3;
+  }
+  if (ov::is_type<opset::Range>(node)) return true;
+  if (ov::is_type<opset::Reshape>(node) || ov::is_type<opset::Squeeze>(node) ||
+      ov::is_type<opset::Unsqueeze>(node) || ov::is_type<opset::Tile>(node) ||
+      ov::is_type<opset::Transpose>(node) || ov::is_type<opset::TopK>(node) ||
+      ov::is_type<opset::Split>(node) || ov::is_type<opset::ReduceMin>(node) ||
+      ov::is_type<opset::ReduceMax>(node) ||
+      ov::is_type<opset::ReduceSum>(node) ||
+      ov::is_type<opset::ReduceProd>(node) ||
+      ov::is_type<opset::ReduceMean>(node)) {
+    return index == 1;
+  }
+  return false;
+}
+
+// The number of input elements reduced into each output element, 0 if it
+// is not static
+static double ReducedElements(const shared_ptr<ov::Node>& node) {
+  const auto& input = node->get_input_partial_shape(0);
+  const auto& output = node->get_output_partial_shape(0);
+  if (input.is_dynamic() || output.is_dynamic()) return 0;
+  size_t output_size = ov::shape_size(output.to_shape());
+  if (output_size == 0) return 0;
+  return static_cast<double>(ov::shape_size(input.to_shape()) / output_size);
+}
+
+// The interval of the output of node from the intervals of its inputs
+static Interval ComputeInterval(const shared_ptr<ov::Node>& node,
+                                const vector<Interval>& in) {
+  if (auto constant = ov::as_type_ptr<opset::Constant>(node)) {
+    auto values = constant->cast_vector<int64_t>();
+    if (values.empty()) return {0, 0};
+    auto bounds = minmax_element(values.begin(), values.end());
+    return {static_cast<double>(*bounds.first),
+            static_cast<double>(*bounds.second)};
+  }
+  if (ov::is_type<opset::ShapeOf>(node)) {
+    // A dimension of 2^31 elements or more is assumed not to occur
+    const auto& shape = node->get_input_partial_shape(0);
+    if (shape.rank().is_dynamic()) return {0, kInt32Max};
+    double hi = 0;
+    for (const auto& dim : shape) {
+      hi = max(hi, dim.get_max_length() < 0
+                       ? kInt32Max
+                       : static_cast<double>(dim.get_max_length()));
+    }
+    return {0, hi};
+  }
+  if (ov::is_type<opset::Range>(node)) return Union(in[0], in[1]);
+  if (ov::is_type<opset::Add>(node)) {
+    return {in[0].lo + in[1].lo, in[0].hi + in[1].hi};
+  }
+  if (ov::is_type<opset::Subtract>(node)) {
+    return {in[0].lo - in[1].hi, in[0].hi - in[1].lo};
+  }
+  if (ov::is_type<opset::Multiply>(node) || ov::is_type<opset::Divide>(node)) {
+    const bool divide = ov::is_type<opset::Divide>(node);
+    if (divide && in[1].lo <= 0 && in[1].hi >= 0) return kUnbounded;
+    double corners[4];
+    int k = 0;
+    for (double a : {in[0].lo, in[0].hi}) {
+      for (double b : {in[1].lo, in[1].hi}) {
+        corners[k++] = divide ? a / b : a * b;
+      }
+    }
+    Interval interval{*min_element(corners, corners + 4),
+                      *max_element(corners, corners + 4)};
+    // NaNs of infinite bounds
+    if (std::isnan(interval.lo) || std::isnan(interval.hi)) return kUnbounded;
+    return {floor(interval.lo), ceil(interval.hi)};
+  }
+  if (ov::is_type<opset::FloorMod>(node) || ov::is_type<opset::Mod>(node)) {
+    // The remainder is smaller than the divisor, and than the dividend for
+    // Mod which takes its sign
+    double m = max(fabs(in[1].lo), fabs(in[1].hi));
+    if (ov::is_type<opset::Mod>(node)) {
+      m = min(m, max(fabs(in[0].lo), fabs(in[0].hi)));
+    }
+    return {-m, m};
+  }
+  if (ov::is_type<opset::Maximum>(node)) {
+    return {max(in[0].lo, in[1].lo), max(in[0].hi, in[1].hi)};
+  }
+  if (ov::is_type<opset::Minimum>(node)) {
+    return {min(in[0].lo, in[1].lo), min(in[0].hi, in[1].hi)};
+  }
+  if (ov::is_type<opset::Negative>(node)) return {-in[0].hi, -in[0].lo};
+  if (ov::is_type<opset::Abs>(node)) {
+    double m = max(fabs(in[0].lo), fabs(in[0].hi));
+    return {in[0].lo >= 0 ? in[0].lo : 0, m};
+  }
+  if (ov::is_type<opset::ReduceSum>(node)) {
+    double n = ReducedElements(node);
+    if (n == 0) return kUnbounded;
+    return {min(0.0, n * in[0].lo), max(0.0, n * in[0].hi)};
+  }
+  if (ov::is_type<opset::ReduceProd>(node)) {
+    double n = ReducedElements(node);
+    if (n == 0) return kUnbounded;
+    double m = pow(max(fabs(in[0].lo), fabs(in[0].hi)), n);
+    return {in[0].lo >= 0 ? min(1.0, pow(in[0].lo, n)) : -m, max(1.0, m)};
+  }
+  // Concat, Select, Convert and the ops moving the values of input 0
+  Interval interval = in[0];
+  for (size_t i = 1; i < in.size(); i++) interval = Union(interval, in[i]);
+  return interval;
+}
+
+bool NarrowIndexTypes::run_on_function(shared_ptr<ov::Model> f) {
+  m_narrowed_ops = 0;
+  m_converts = 0;
+  map<const ov::Node*, Interval> intervals;
+  set<const ov::Node*> narrowed;
+  vector<shared_ptr<ov::Node>> order;
+  auto input_interval = [&](const ov::Input<ov::Node>& input) {
+    auto it = intervals.find(input.get_source_output().get_node());
+    return it == intervals.end() ? TypeInterval(input.get_element_type())
+                                 : it->second;
+  };
+
+  for (const auto& node : f->get_ordered_ops()) {
+    vector<size_t> data_inputs;
+    if (node->get_output_size() != 1 ||
+        node->get_output_element_type(0) != ov::element::i64 ||
+        !GetDataInputs(node.get(), data_inputs)) {
+      continue;
+    }
+    bool inputs_narrowed = true;
+    for (size_t i : data_inputs) {
+      inputs_narrowed &=
+          narrowed.count(node->get_input_node_ptr(i)) > 0 &&
+          node->input_value(i).get_index() == 0;
+    }
+    if (!inputs_narrowed) continue;
+
+    vector<Interval> in;
+    if (ov::is_type<opset::Range>(node) || ov::is_type<opset::Convert>(node)) {
+      for (const auto& input : node->inputs()) {
+        in.push_back(input_interval(input));
+      }
+    } else {
+      for (size_t i : data_inputs) {
+        in.push_back(input_interval(node->input(i)));
+      }
+    }
+    Interval interval = ComputeInterval(node, in);
+    if (!FitsInt32(interval)) continue;
+    intervals[node.get()] = interval;
+    narrowed.insert(node.get());
+    order.push_back(node);
+  }
+  if (order.empty()) return false;
+
+  // Whether input reads the narrowed output of its source as it is
+  auto reads_int32 = [&](const ov::Input<ov::Node>& input) {
+    const ov::Node* node = input.get_node();
+    if (AcceptsInt32(node, input.get_index())) return true;
+    if (narrowed.count(node) == 0) return false;
+    vector<size_t> data_inputs;
+    GetDataInputs(node, data_inputs);
+    return find(data_inputs.begin(), data_inputs.end(), input.get_index()) !=
+           data_inputs.end();
+  };
+
+  for (const auto& node : order) {
+    // The i32 output replacing the output of node
+    ov::Output<ov::Node> output = node->output(0);
+    if (auto constant = ov::as_type_ptr<opset::Constant>(node)) {
+      auto narrow = make_shared<opset::Constant>(
+          ov::element::i32, constant->get_shape(),
+          constant->cast_vector<int32_t>());
+      narrow->set_friendly_name(constant->get_friendly_name());
+      output = narrow;
+    } else if (ov::is_type<opset::Range>(node)) {
+      auto narrow = make_shared<opset::Range>(
+          node->input_value(0), node->input_value(1), node->input_value(2),
+          ov::element::i32);
+      narrow->set_friendly_name(node->get_friendly_name());
+      output = narrow;
+    }
+
+    shared_ptr<opset::Convert> convert;
+    for (auto input : node->output(0).get_target_inputs()) {
+      if (reads_int32(input)) {
+        if (output != node->output(0)) input.replace_source_output(output);
+        continue;
+      }
+      // The constant stays for the consumers of i64
+      if (ov::is_type<opset::Constant>(node)) continue;
+      if (convert == nullptr) {
+        convert = make_shared<opset::Convert>(output, ov::element::i64);
+        m_converts++;
+      }
+      input.replace_source_output(convert);
+    }
+
+    if (auto shape_of = ov::as_type_ptr<opset::ShapeOf>(node)) {
+      shape_of->set_output_type(ov::element::i32);
+    } else if (auto cast = ov::as_type_ptr<opset::Convert>(node)) {
+      cast->set_destination_type(ov::element::i32);
+    }
+    m_narrowed_ops++;
+  }
+  f->validate_nodes_and_infer_types();
+
+  OVTF_VLOG(1) << "Narrowed " << m_narrowed_ops << " ops of "
+               << f->get_friendly_name() << " to i32, with " << m_converts
+               << " Converts back to i64";
+  return true;
+}
+
+}  // namespace pass
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
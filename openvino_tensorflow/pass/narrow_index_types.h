@@ -0,0 +1,40 @@
+/*****************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+*****************************************************************************/
+
+#pragma once
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/pass.hpp"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace pass {
+
+// Narrows the i64 shape and index arithmetic of the model to i32 where the
+// values provably fit. The values of the constants, of ShapeOf (assuming
+// dimensions below 2^31), of the converts from narrower types and of Range
+// are propagated as intervals through the arithmetic, Concat, Gather,
+// Reshape, slicing and reductions, and the ops whose interval fits in i32
+// compute in i32. Their consumers which still read i64, such as the
+// results of the model, read it through a Convert, so the types at the
+// boundaries of the cluster are unchanged.
+class NarrowIndexTypes : public ngraph::pass::FunctionPass {
+ public:
+  bool run_on_function(std::shared_ptr<ov::Model> function) override;
+
+  // The number of ops narrowed, and the Converts back to i64 added, in the
+  // last run
+  size_t GetNarrowedOps() const { return m_narrowed_ops; }
+  size_t GetConverts() const { return m_converts; }
+
+ private:
+  size_t m_narrowed_ops = 0;
+  size_t m_converts = 0;
+};
+
+}  // namespace pass
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
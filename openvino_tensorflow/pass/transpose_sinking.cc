@@ -413,6 +413,293 @@ static void sink_concat(shared_ptr<opset::Concat> n, TransposeMap& reorders,
   write_transposemap(reorders, new_concat, new_transpose);
 }
 
+// The label of the shape the input of a pending transpose of the given
+// order has, on which the op an input is sunk through is rebuilt
+static shared_ptr<ngraph::pattern::op::Label> make_input_label(
+    shared_ptr<opset::Transpose> arg_transpose,
+    const ngraph::AxisVector& order) {
+  auto input_shape = apply_permutation(arg_transpose->get_shape(),
+                                       permutation_to_default_order(order));
+  return make_shared<ngraph::pattern::op::Label>(
+      arg_transpose->get_element_type(), input_shape);
+}
+
+static ngraph::AxisVector get_transpose_order(
+    shared_ptr<opset::Transpose> transpose) {
+  return ngraph::as_type_ptr<opset::Constant>(
+             transpose->input_value(1).get_node_shared_ptr())
+      ->get_axis_vector_val();
+}
+
+// The constant axes of input index of n, normalized to the given rank.
+// Returns false if the axes are not constant.
+static bool get_constant_axes(shared_ptr<ov::Node> n, size_t index,
+                              size_t rank, vector<int64_t>& axes) {
+  auto constant = ngraph::as_type_ptr<opset::Constant>(
+      n->input_value(index).get_node_shared_ptr());
+  if (constant == nullptr) return false;
+  axes = constant->cast_vector<int64_t>();
+  for (auto& axis : axes) {
+    if (axis < 0) axis += rank;
+    if (axis < 0 || axis >= static_cast<int64_t>(rank)) return false;
+  }
+  return true;
+}
+
+// The pending order of the output of an op removing the axes of its input,
+// in the order of the transposed input, when it is run on the input before
+// the transpose of the given order
+static ngraph::AxisVector remove_axes_order(const ngraph::AxisVector& order,
+                                            const set<int64_t>& axes) {
+  vector<size_t> kept;
+  for (size_t i = 0; i < order.size(); i++) {
+    if (!axes.count(i)) kept.push_back(order[i]);
+  }
+  vector<size_t> sorted_kept = kept;
+  sort(sorted_kept.begin(), sorted_kept.end());
+  ngraph::AxisVector output_order(kept.size());
+  for (size_t i = 0; i < kept.size(); i++) {
+    output_order[i] =
+        find(sorted_kept.begin(), sorted_kept.end(), kept[i]) -
+        sorted_kept.begin();
+  }
+  return output_order;
+}
+
+// Rebuilds n on the input before its pending transpose, the other inputs
+// of n being replaced by new_inputs, and propagates the given orders of the
+// outputs
+static void replace_sunk_node(shared_ptr<ov::Node> n,
+                              shared_ptr<ov::Node> new_node,
+                              const vector<ngraph::AxisVector>& orders,
+                              TransposeMap& reorders) {
+  // put back the original argument
+  new_node->input(0).replace_source_output(n->input_value(0));
+  OVTF_VLOG(4) << "Replacing " << n->get_name() << " with "
+               << new_node->get_name();
+  ngraph::replace_node(n, new_node);
+  for (size_t i = 0; i < new_node->get_output_size(); i++) {
+    auto new_transpose = make_transpose(new_node->output(i), orders.at(i));
+    OVTF_VLOG(4) << "Propagating " << describe<opset::Transpose>(new_transpose)
+                 << " for " << n->get_name();
+    write_transposemap(reorders, new_node->output(i), new_transpose);
+  }
+}
+
+// Reductions over constant axes, the axes being those of the input before
+// the transpose
+static void sink_reduction(shared_ptr<ov::Node> n, bool keep_dims,
+                           TransposeMap& reorders,
+                           set<shared_ptr<ov::Node>>& transposes_to_delete) {
+  auto arg_transpose = read_transposemap(reorders, n->input_value(0));
+  auto order = get_transpose_order(arg_transpose);
+  vector<int64_t> axes;
+  if (order == ngraph::get_default_order(order.size()) ||
+      !get_constant_axes(n, 1, order.size(), axes)) {
+    materialize_shapes(n, reorders, transposes_to_delete);
+    return;
+  }
+  vector<int64_t> new_axes;
+  for (auto axis : axes) new_axes.push_back(order[axis]);
+  auto new_axes_const = make_shared<opset::Constant>(
+      ov::element::i64, ov::Shape{new_axes.size()}, new_axes);
+  auto new_node = n->clone_with_new_inputs(
+      {make_input_label(arg_transpose, order), new_axes_const});
+  auto output_order =
+      keep_dims ? order
+                : remove_axes_order(order, set<int64_t>(axes.begin(),
+                                                        axes.end()));
+  replace_sunk_node(n, new_node, {output_order}, reorders);
+}
+
+static void sink_squeeze(shared_ptr<opset::Squeeze> n,
+                         TransposeMap& reorders,
+                         set<shared_ptr<ov::Node>>& transposes_to_delete) {
+  auto arg_transpose = read_transposemap(reorders, n->input_value(0));
+  auto order = get_transpose_order(arg_transpose);
+  vector<int64_t> axes;
+  // Without axes every dimension of 1 is squeezed, whatever its position
+  if (order == ngraph::get_default_order(order.size()) ||
+      n->get_input_size() < 2 ||
+      !get_constant_axes(n, 1, order.size(), axes)) {
+    materialize_shapes(n, reorders, transposes_to_delete);
+    return;
+  }
+  vector<int64_t> new_axes;
+  for (auto axis : axes) new_axes.push_back(order[axis]);
+  auto new_node = make_shared<opset::Squeeze>(
+      make_input_label(arg_transpose, order),
+      make_shared<opset::Constant>(ov::element::i64,
+                                   ov::Shape{new_axes.size()}, new_axes));
+  replace_sunk_node(
+      n, new_node,
+      {remove_axes_order(order, set<int64_t>(axes.begin(), axes.end()))},
+      reorders);
+}
+
+static void sink_unsqueeze(shared_ptr<opset::Unsqueeze> n,
+                           TransposeMap& reorders,
+                           set<shared_ptr<ov::Node>>& transposes_to_delete) {
+  auto arg_transpose = read_transposemap(reorders, n->input_value(0));
+  auto order = get_transpose_order(arg_transpose);
+  size_t output_rank = n->get_output_shape(0).size();
+  vector<int64_t> axes;
+  if (order == ngraph::get_default_order(order.size()) ||
+      !get_constant_axes(n, 1, output_rank, axes)) {
+    materialize_shapes(n, reorders, transposes_to_delete);
+    return;
+  }
+  // The new dimensions are inserted at the same positions, between the
+  // input dimensions before the transpose
+  set<int64_t> new_dims(axes.begin(), axes.end());
+  vector<size_t> input_positions;
+  for (size_t i = 0; i < output_rank; i++) {
+    if (!new_dims.count(i)) input_positions.push_back(i);
+  }
+  ngraph::AxisVector output_order(output_rank);
+  for (size_t i = 0; i < output_rank; i++) output_order[i] = i;
+  for (size_t i = 0; i < order.size(); i++) {
+    output_order[input_positions[i]] = input_positions[order[i]];
+  }
+  auto new_node = make_shared<opset::Unsqueeze>(
+      make_input_label(arg_transpose, order),
+      make_shared<opset::Constant>(ov::element::i64, ov::Shape{axes.size()},
+                                   axes));
+  replace_sunk_node(n, new_node, {output_order}, reorders);
+}
+
+// Split and VariadicSplit along a constant axis
+static void sink_split(shared_ptr<ov::Node> n, TransposeMap& reorders,
+                       set<shared_ptr<ov::Node>>& transposes_to_delete) {
+  auto arg_transpose = read_transposemap(reorders, n->input_value(0));
+  auto order = get_transpose_order(arg_transpose);
+  vector<int64_t> axes;
+  if (order == ngraph::get_default_order(order.size()) ||
+      !get_constant_axes(n, 1, order.size(), axes) || axes.size() != 1) {
+    materialize_shapes(n, reorders, transposes_to_delete);
+    return;
+  }
+  auto new_axis = make_shared<opset::Constant>(
+      ov::element::i64, ov::Shape{}, static_cast<int64_t>(order[axes[0]]));
+  ov::OutputVector new_inputs{make_input_label(arg_transpose, order),
+                              new_axis};
+  for (size_t i = 2; i < n->get_input_size(); i++) {
+    new_inputs.push_back(n->input_value(i));
+  }
+  auto new_node = n->clone_with_new_inputs(new_inputs);
+  replace_sunk_node(
+      n, new_node, vector<ngraph::AxisVector>(n->get_output_size(), order),
+      reorders);
+}
+
+// StridedSlice with constant bounds which keeps the rank of its input
+static void sink_strided_slice(
+    shared_ptr<opset::StridedSlice> n, TransposeMap& reorders,
+    set<shared_ptr<ov::Node>>& transposes_to_delete) {
+  auto arg_transpose = read_transposemap(reorders, n->input_value(0));
+  auto order = get_transpose_order(arg_transpose);
+  size_t rank = order.size();
+  auto has_bit = [](const vector<int64_t>& mask) {
+    return find(mask.begin(), mask.end(), 1) != mask.end();
+  };
+  vector<shared_ptr<opset::Constant>> bounds;
+  for (size_t i = 1; i < 4; i++) {
+    bounds.push_back(ngraph::as_type_ptr<opset::Constant>(
+        n->input_value(i).get_node_shared_ptr()));
+  }
+  if (order == ngraph::get_default_order(rank) || !bounds[0] ||
+      !bounds[1] || !bounds[2] || has_bit(n->get_new_axis_mask()) ||
+      has_bit(n->get_shrink_axis_mask()) || has_bit(n->get_ellipsis_mask())) {
+    materialize_shapes(n, reorders, transposes_to_delete);
+    return;
+  }
+  // The bounds of every dimension, the missing ones spanning the whole
+  // dimension
+  vector<int64_t> begin = bounds[0]->cast_vector<int64_t>();
+  vector<int64_t> end = bounds[1]->cast_vector<int64_t>();
+  vector<int64_t> strides = bounds[2]->cast_vector<int64_t>();
+  vector<int64_t> begin_mask = n->get_begin_mask();
+  vector<int64_t> end_mask = n->get_end_mask();
+  if (begin.size() > rank || end.size() != begin.size() ||
+      strides.size() != begin.size()) {
+    materialize_shapes(n, reorders, transposes_to_delete);
+    return;
+  }
+  begin.resize(rank, 0);
+  end.resize(rank, 0);
+  strides.resize(rank, 1);
+  begin_mask.resize(begin.size(), 0);
+  end_mask.resize(end.size(), 0);
+  for (size_t i = bounds[0]->cast_vector<int64_t>().size(); i < rank; i++) {
+    begin_mask[i] = 1;
+    end_mask[i] = 1;
+  }
+  vector<int64_t> new_begin(rank), new_end(rank), new_strides(rank),
+      new_begin_mask(rank), new_end_mask(rank);
+  for (size_t i = 0; i < rank; i++) {
+    new_begin[order[i]] = begin[i];
+    new_end[order[i]] = end[i];
+    new_strides[order[i]] = strides[i];
+    new_begin_mask[order[i]] = begin_mask[i];
+    new_end_mask[order[i]] = end_mask[i];
+  }
+  auto make_bounds = [rank](const vector<int64_t>& values) {
+    return make_shared<opset::Constant>(ov::element::i64, ov::Shape{rank},
+                                        values);
+  };
+  auto new_node = make_shared<opset::StridedSlice>(
+      make_input_label(arg_transpose, order), make_bounds(new_begin),
+      make_bounds(new_end), make_bounds(new_strides), new_begin_mask,
+      new_end_mask);
+  replace_sunk_node(n, new_node, {order}, reorders);
+}
+
+// MatMul absorbs the pending transposes of its inputs which only swap their
+// last two dimensions into its transpose_a and transpose_b attributes, the
+// other pending transposes are materialized
+static void sink_matmul(shared_ptr<opset::MatMul> n, TransposeMap& reorders,
+                        set<shared_ptr<ov::Node>>& transposes_to_delete) {
+  bool transpose_args[2] = {n->get_transpose_a(), n->get_transpose_b()};
+  ov::OutputVector new_args;
+  vector<bool> absorbed(2, false);
+  for (size_t i = 0; i < 2; i++) {
+    auto arg = n->input_value(i);
+    auto arg_transpose = read_transposemap(reorders, arg);
+    auto order = get_transpose_order(arg_transpose);
+    auto swap_order = ngraph::get_default_order(order.size());
+    if (order.size() >= 2) {
+      swap(swap_order[order.size() - 2], swap_order[order.size() - 1]);
+    }
+    if (order.size() >= 2 && order == swap_order) {
+      transpose_args[i] = !transpose_args[i];
+      new_args.push_back(make_input_label(arg_transpose, order));
+      absorbed[i] = true;
+    } else {
+      mark_transpose_for_deletion(arg_transpose, transposes_to_delete);
+      if (order != ngraph::get_default_order(order.size())) {
+        insert_transpose(n, arg_transpose, i);
+      }
+      new_args.push_back(make_shared<ngraph::pattern::op::Label>(
+          arg_transpose->get_element_type(), arg_transpose->get_shape()));
+    }
+  }
+  if (!absorbed[0] && !absorbed[1]) {
+    write_transposemap(reorders, n, create_default_transpose(n));
+    return;
+  }
+  auto new_node = make_shared<opset::MatMul>(new_args[0], new_args[1],
+                                             transpose_args[0],
+                                             transpose_args[1]);
+  // put back the original arguments
+  for (size_t i = 0; i < 2; i++) {
+    new_node->input(i).replace_source_output(n->input_value(i));
+  }
+  OVTF_VLOG(4) << "Replacing " << n->get_name() << " with "
+               << new_node->get_name();
+  ngraph::replace_node(n, new_node);
+  write_transposemap(reorders, new_node, create_default_transpose(new_node));
+}
+
 // The goal of TransposeSinking is to remove
 // round-trip transposes(i.e. nhwc->nchw(nchw-only-op)->nhwc)
 // around nchw-only-op (e.g.Convolution, Batchnorm, Avg/MaxPool)
@@ -430,6 +717,14 @@ bool TransposeSinking::run_on_function(shared_ptr<ov::Model> f) {
   if (util::DumpAllGraphs()) {
     util::DumpNGGraph(f, f->get_friendly_name() + "_before_TS");
   }
+  auto count_transposes = [&f]() {
+    auto ops = f->get_ops();
+    return count_if(ops.begin(), ops.end(),
+                    [](const shared_ptr<ov::Node>& n) {
+                      return ngraph::is_type<opset::Transpose>(n);
+                    });
+  };
+  auto transposes_before = count_transposes();
 
   // STEP 1 : Sink or Swim transposes away for op clusters
   try {
@@ -449,6 +744,25 @@ bool TransposeSinking::run_on_function(shared_ptr<ov::Model> f) {
         sink_pad(pad, reorders, transposes_to_delete);
       } else if (auto concat = ngraph::as_type_ptr<opset::Concat>(n)) {
         sink_concat(concat, reorders, transposes_to_delete);
+      } else if (auto reduction = ngraph::as_type_ptr<
+                     ov::op::util::ArithmeticReductionKeepDims>(n)) {
+        sink_reduction(n, reduction->get_keep_dims(), reorders,
+                       transposes_to_delete);
+      } else if (auto reduction = ngraph::as_type_ptr<
+                     ov::op::util::LogicalReductionKeepDims>(n)) {
+        sink_reduction(n, reduction->get_keep_dims(), reorders,
+                       transposes_to_delete);
+      } else if (auto squeeze = ngraph::as_type_ptr<opset::Squeeze>(n)) {
+        sink_squeeze(squeeze, reorders, transposes_to_delete);
+      } else if (auto unsqueeze = ngraph::as_type_ptr<opset::Unsqueeze>(n)) {
+        sink_unsqueeze(unsqueeze, reorders, transposes_to_delete);
+      } else if (ngraph::is_type<opset::Split>(n) ||
+                 ngraph::is_type<opset::VariadicSplit>(n)) {
+        sink_split(n, reorders, transposes_to_delete);
+      } else if (auto slice = ngraph::as_type_ptr<opset::StridedSlice>(n)) {
+        sink_strided_slice(slice, reorders, transposes_to_delete);
+      } else if (auto matmul = ngraph::as_type_ptr<opset::MatMul>(n)) {
+        sink_matmul(matmul, reorders, transposes_to_delete);
       } else {
         materialize_shapes(n, reorders, transposes_to_delete);
       }
@@ -485,6 +799,11 @@ bool TransposeSinking::run_on_function(shared_ptr<ov::Model> f) {
                  orig_result_out_shape[r->get_name()]);
   }
 
+  OVTF_VLOG(1) << "TransposeSinking eliminated "
+               << transposes_before - count_transposes() << " of "
+               << transposes_before << " Transposes of "
+               << f->get_friendly_name();
+
   if (util::DumpAllGraphs()) {
     util::DumpNGGraph(f, f->get_friendly_name() + "_after_TS");
   }
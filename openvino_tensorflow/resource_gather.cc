@@ -0,0 +1,217 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <vector>
+
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/assign_clusters.h"
+#include "openvino_tensorflow/resource_gather.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Set on the GatherV2 of a split ResourceGather
+static const char* const kSplitGatherAttr = "_ovtf_split_resource_gather";
+
+static Status SplitResourceGather(Graph* graph, Node* gather) {
+  DataType dtype, tindices;
+  TF_RETURN_IF_ERROR(GetNodeAttr(gather->attrs(), "dtype", &dtype));
+  TF_RETURN_IF_ERROR(GetNodeAttr(gather->attrs(), "Tindices", &tindices));
+  int batch_dims = 0;
+  TryGetNodeAttr(gather->attrs(), "batch_dims", &batch_dims);
+  const Edge* resource;
+  const Edge* indices;
+  TF_RETURN_IF_ERROR(gather->input_edge(0, &resource));
+  TF_RETURN_IF_ERROR(gather->input_edge(1, &indices));
+
+  // The edges of the gather, which is removed before its replacement takes
+  // its name
+  const string name = gather->name();
+  const string requested_device = gather->requested_device();
+  const string assigned_device = gather->assigned_device_name();
+  vector<Node*> control_inputs;
+  vector<const Edge*> out_edges;
+  for (const Edge* edge : gather->in_edges()) {
+    if (edge->IsControlEdge()) control_inputs.push_back(edge->src());
+  }
+  for (const Edge* edge : gather->out_edges()) out_edges.push_back(edge);
+  vector<pair<Node*, int>> consumers;
+  vector<Node*> control_outputs;
+  for (const Edge* edge : out_edges) {
+    if (edge->IsControlEdge()) {
+      control_outputs.push_back(edge->dst());
+    } else {
+      consumers.emplace_back(edge->dst(), edge->dst_input());
+    }
+  }
+  Node* resource_src = resource->src();
+  int resource_output = resource->src_output();
+  Node* indices_src = indices->src();
+  int indices_output = indices->src_output();
+
+  Node* read;
+  TF_RETURN_IF_ERROR(
+      NodeBuilder(graph->NewName(name + "/ReadVariableOp"), "ReadVariableOp")
+          .Input(resource_src, resource_output)
+          .Attr("dtype", dtype)
+          .ControlInputs(control_inputs)
+          .Device(requested_device)
+          .Finalize(graph, &read));
+  read->set_assigned_device_name(assigned_device);
+
+  // ResourceGather gathers along the axis following the batch dimensions
+  Tensor axis_value(DT_INT32, TensorShape({}));
+  axis_value.scalar<int32>()() = batch_dims;
+  Node* axis;
+  TF_RETURN_IF_ERROR(NodeBuilder(graph->NewName(name + "/axis"), "Const")
+                         .Attr("dtype", DT_INT32)
+                         .Attr("value", axis_value)
+                         .ControlInput(read)
+                         .Device(requested_device)
+                         .Finalize(graph, &axis));
+  axis->set_assigned_device_name(assigned_device);
+
+  graph->RemoveNode(gather);
+  Node* gather_v2;
+  TF_RETURN_IF_ERROR(NodeBuilder(name, "GatherV2")
+                         .Input(read, 0)
+                         .Input(indices_src, indices_output)
+                         .Input(axis, 0)
+                         .Attr("Tparams", dtype)
+                         .Attr("Tindices", tindices)
+                         .Attr("Taxis", DT_INT32)
+                         .Attr("batch_dims", batch_dims)
+                         .Device(requested_device)
+                         .Finalize(graph, &gather_v2));
+  gather_v2->set_assigned_device_name(assigned_device);
+  gather_v2->AddAttr(kSplitGatherAttr, true);
+  for (const auto& consumer : consumers) {
+    graph->AddEdge(gather_v2, 0, consumer.first, consumer.second);
+  }
+  for (Node* dst : control_outputs) graph->AddControlEdge(gather_v2, dst);
+  return Status::OK();
+}
+
+static bool IsClustered(const Node* node) {
+  int cluster;
+  return GetNodeCluster(node, &cluster).ok();
+}
+
+// Replaces the GatherV2 of a split gather, its ReadVariableOp and its axis
+// with a ResourceGather again. Leaves them alone if any of them is
+// clustered or used elsewhere.
+static Status MergeResourceGather(Graph* graph, Node* gather_v2) {
+  const Edge* params;
+  const Edge* indices;
+  const Edge* axis_edge;
+  TF_RETURN_IF_ERROR(gather_v2->input_edge(0, &params));
+  TF_RETURN_IF_ERROR(gather_v2->input_edge(1, &indices));
+  TF_RETURN_IF_ERROR(gather_v2->input_edge(2, &axis_edge));
+  Node* read = params->src();
+  Node* axis = axis_edge->src();
+  if (read->type_string() != "ReadVariableOp" ||
+      axis->type_string() != "Const" || IsClustered(read) ||
+      IsClustered(axis) || axis->out_edges().size() != 1) {
+    return Status::OK();
+  }
+  // The axis has a control edge from the read
+  for (const Edge* edge : read->out_edges()) {
+    if (edge->dst() != gather_v2 && edge->dst() != axis) return Status::OK();
+  }
+  const Edge* resource;
+  TF_RETURN_IF_ERROR(read->input_edge(0, &resource));
+
+  DataType dtype, tindices;
+  TF_RETURN_IF_ERROR(GetNodeAttr(gather_v2->attrs(), "Tparams", &dtype));
+  TF_RETURN_IF_ERROR(GetNodeAttr(gather_v2->attrs(), "Tindices", &tindices));
+  int batch_dims = 0;
+  TryGetNodeAttr(gather_v2->attrs(), "batch_dims", &batch_dims);
+  const string name = gather_v2->name();
+  const string requested_device = gather_v2->requested_device();
+  const string assigned_device = gather_v2->assigned_device_name();
+  // The control inputs of the gather were moved to the read
+  vector<Node*> control_inputs;
+  for (const Edge* edge : read->in_edges()) {
+    if (edge->IsControlEdge()) control_inputs.push_back(edge->src());
+  }
+  vector<pair<Node*, int>> consumers;
+  vector<Node*> control_outputs;
+  for (const Edge* edge : gather_v2->out_edges()) {
+    if (edge->IsControlEdge()) {
+      control_outputs.push_back(edge->dst());
+    } else {
+      consumers.emplace_back(edge->dst(), edge->dst_input());
+    }
+  }
+  Node* resource_src = resource->src();
+  int resource_output = resource->src_output();
+  Node* indices_src = indices->src();
+  int indices_output = indices->src_output();
+
+  graph->RemoveNode(gather_v2);
+  graph->RemoveNode(axis);
+  graph->RemoveNode(read);
+  Node* gather;
+  TF_RETURN_IF_ERROR(NodeBuilder(name, "ResourceGather")
+                         .Input(resource_src, resource_output)
+                         .Input(indices_src, indices_output)
+                         .Attr("dtype", dtype)
+                         .Attr("Tindices", tindices)
+                         .Attr("batch_dims", batch_dims)
+                         .ControlInputs(control_inputs)
+                         .Device(requested_device)
+                         .Finalize(graph, &gather));
+  gather->set_assigned_device_name(assigned_device);
+  for (const auto& consumer : consumers) {
+    graph->AddEdge(gather, 0, consumer.first, consumer.second);
+  }
+  for (Node* dst : control_outputs) graph->AddControlEdge(gather, dst);
+  return Status::OK();
+}
+
+Status SplitResourceGathers(Graph* graph,
+                            const std::set<std::string>& disabled_ops) {
+  if (disabled_ops.count("ResourceGather") ||
+      disabled_ops.count("GatherV2")) {
+    return Status::OK();
+  }
+  vector<Node*> gathers;
+  for (Node* node : graph->op_nodes()) {
+    if (node->type_string() == "ResourceGather") gathers.push_back(node);
+  }
+  for (Node* gather : gathers) {
+    OVTF_VLOG(2) << "Splitting " << gather->name()
+                 << " into a ReadVariableOp and a GatherV2";
+    TF_RETURN_IF_ERROR(SplitResourceGather(graph, gather));
+  }
+  return Status::OK();
+}
+
+Status MergeResourceGathers(Graph* graph) {
+  vector<Node*> gathers;
+  for (Node* node : graph->op_nodes()) {
+    if (node->type_string() == "GatherV2" &&
+        node->attrs().Find(kSplitGatherAttr) != nullptr &&
+        !IsClustered(node)) {
+      gathers.push_back(node);
+    }
+  }
+  for (Node* gather : gathers) {
+    OVTF_VLOG(2) << "Merging " << gather->name()
+                 << " back into a ResourceGather, it is not clustered";
+    TF_RETURN_IF_ERROR(MergeResourceGather(graph, gather));
+  }
+  return Status::OK();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
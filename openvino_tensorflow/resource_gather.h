@@ -0,0 +1,40 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_RESOURCE_GATHER_H_
+#define OPENVINO_TF_RESOURCE_GATHER_H_
+
+#include <set>
+#include <string>
+
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Replaces the ResourceGather ops, the embedding lookups of the tables held
+// in resource variables, with a ReadVariableOp of the table feeding a
+// GatherV2 of the same name. The clusters can not read resource handles,
+// but the lookup can then be clustered with the layers it feeds: the
+// ReadVariableOp stays on TF and the table becomes a variable input of the
+// cluster, bound without a copy until it is written.
+//
+// ReadVariableOp shares the buffer of the variable, the whole table is
+// only copied if the variable is in copy-on-read mode, which the sparse
+// updates of training set. The ops of disabled_ops are left alone.
+Status SplitResourceGathers(Graph* graph,
+                            const std::set<std::string>& disabled_ops);
+
+// Merges the split gathers which were not clustered back into a
+// ResourceGather, since their ReadVariableOp would copy the whole table on
+// every step in copy-on-read mode. Runs once the clusters are assigned and
+// deassigned.
+Status MergeResourceGathers(Graph* graph);
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_RESOURCE_GATHER_H_
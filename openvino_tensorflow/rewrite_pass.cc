@@ -17,12 +17,12 @@
 #include "openvino_tensorflow/assign_clusters.h"
 #include "openvino_tensorflow/backend_manager.h"
 #include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/cluster_topology.h"
 #include "openvino_tensorflow/deassign_clusters.h"
 #include "openvino_tensorflow/encapsulate_clusters.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
 #include "openvino_tensorflow/ovtf_utils.h"
-
-#include "ocm/include/ocm_nodes_checker.h"
+#include "openvino_tensorflow/resource_gather.h"
 
 using namespace std;
 
@@ -146,15 +146,11 @@ class NGraphEncapsulationPass : public NGraphRewritePass {
     if (exec_status != Status::OK()) {
       throw runtime_error(exec_status.error_message());
     }
-    const char* device_id(device.c_str());
     std::string ov_version;
 
 #if defined(OPENVINO_2022_1)
     ov_version = "2022.1.0";
 #endif
-    ocm::Framework_Names fName = ocm::Framework_Names::TF;
-    ocm::FrameworkNodesChecker FC(fName, device_id, ov_version,
-                                  options.graph->get());
     std::set<std::string> disabled_ops_set = api::GetDisabledOps();
     if (device == "HDDL" && std::getenv("OPENVINO_TF_ENABLE_BATCHING")) {
       std::vector<std::string> batched_disabled_ops = {"Shape"};
@@ -171,16 +167,20 @@ class NGraphEncapsulationPass : public NGraphRewritePass {
       OVTF_VLOG(2) << "Disabled OP - " << *itr << std::endl;
     }
 
-    FC.SetDisabledOps(disabled_ops_set);
-    std::vector<void*> nodes_list = FC.MarkSupportedNodes();
+    // Embedding lookups of resource variables become clusterable gathers
+    TF_RETURN_IF_ERROR(
+        SplitResourceGathers(options.graph->get(), disabled_ops_set));
+
+    std::vector<Node*> nodes_list;
+    TF_RETURN_IF_ERROR(GetNodesSupportedByBackend(
+        options.graph->get(), ov_version, disabled_ops_set, nodes_list));
 
     // cast back the nodes in the TF format and mark the nodes for clustering
     // (moved out from MarkForClustering function)
     const std::map<std::string, SetAttributesFunction>& set_attributes_map =
         GetAttributeSetters();
-    for (auto void_node : nodes_list) {
+    for (auto node : nodes_list) {
       // TODO(amprocte): move attr name to a constant
-      tensorflow::Node* node = (tensorflow::Node*)void_node;
       node->AddAttr("_ovtf_marked_for_clustering", true);
       auto it = set_attributes_map.find(node->type_string());
       if (it != set_attributes_map.end()) {
@@ -196,7 +196,11 @@ class NGraphEncapsulationPass : public NGraphRewritePass {
 
     // 3. Deassign trivial clusters then, if requested, dump the graphs.
     TF_RETURN_IF_ERROR(DeassignClusters(graph));
+    TF_RETURN_IF_ERROR(MergeResourceGathers(graph));
     util::DumpTFGraph(graph, idx, "declustered");
+    if (util::GetEnv("OPENVINO_TF_CLUSTER_TOPOLOGY") != "0") {
+      ClusterTopology::Record(graph, idx, device);
+    }
 
     // 4. Encapsulate clusters then, if requested, dump the graphs.
     std::unordered_map<std::string, std::string> config_map;
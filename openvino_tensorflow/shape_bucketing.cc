@@ -0,0 +1,260 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <sstream>
+
+#include "tensorflow/core/framework/types.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/shape_bucketing.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+TensorShape ShapeBucketing::Padding::UnpaddedShape(
+    const TensorShape& padded_shape, const OutputDims& dims, int i) const {
+  TensorShape shape = padded_shape;
+  if (padded_batch != batch && i < dims.batch.size() && dims.batch[i] &&
+      shape.dims() > 0) {
+    shape.set_dim(0, batch);
+  }
+  if (padded_sequence != sequence && i < dims.sequence.size() &&
+      dims.sequence[i] && shape.dims() > 1) {
+    shape.set_dim(1, sequence);
+  }
+  return shape;
+}
+
+ShapeBucketing::ShapeBucketing(std::vector<int64> batch_buckets,
+                               int64 sequence_bucket_size)
+    : m_batch_buckets(std::move(batch_buckets)),
+      m_sequence_bucket_size(sequence_bucket_size) {}
+
+ShapeBucketing ShapeBucketing::FromEnv() {
+  std::vector<int64> batch_buckets;
+  std::stringstream buckets_env(util::GetEnv("OPENVINO_TF_BATCH_BUCKETS"));
+  string bucket;
+  while (std::getline(buckets_env, bucket, ',')) {
+    if (!bucket.empty()) batch_buckets.push_back(std::stoll(bucket));
+  }
+  std::sort(batch_buckets.begin(), batch_buckets.end());
+
+  int64 sequence_bucket_size = 0;
+  string sequence_env = util::GetEnv("OPENVINO_TF_SEQUENCE_BUCKET_SIZE");
+  if (!sequence_env.empty()) {
+    sequence_bucket_size = std::max<int64>(0, std::stoll(sequence_env));
+  }
+  return ShapeBucketing(batch_buckets, sequence_bucket_size);
+}
+
+std::vector<bool> ShapeBucketing::BucketedInputs(
+    const std::vector<TensorShape>& input_shapes,
+    const std::vector<bool>& input_is_static,
+    const std::vector<bool>& input_is_variable) {
+  std::vector<bool> bucketed(input_shapes.size());
+  for (int i = 0; i < input_shapes.size(); i++) {
+    bucketed[i] = input_shapes[i].dims() > 0 &&
+                  !(i < input_is_static.size() && input_is_static[i]) &&
+                  !(i < input_is_variable.size() && input_is_variable[i]);
+  }
+  return bucketed;
+}
+
+std::string ShapeBucketing::DebugString() const {
+  std::stringstream ss;
+  for (auto bucket : m_batch_buckets) {
+    ss << bucket << ",";
+  }
+  ss << "seq=" << m_sequence_bucket_size;
+  return ss.str();
+}
+
+ShapeBucketing::Padding ShapeBucketing::PadInputs(
+    std::vector<Tensor>& inputs, const std::vector<bool>& input_is_static,
+    const std::vector<bool>& input_is_variable) const {
+  Padding padding;
+  if (!IsEnabled()) return padding;
+
+  std::vector<TensorShape> input_shapes;
+  for (const auto& input : inputs) {
+    input_shapes.push_back(input.shape());
+  }
+  std::vector<bool> bucketed =
+      BucketedInputs(input_shapes, input_is_static, input_is_variable);
+  bool same_sequence = true;
+  for (int i = 0; i < inputs.size(); i++) {
+    if (!bucketed[i]) continue;
+    if (!DataTypeCanUseMemcpy(inputs[i].dtype())) return Padding();
+    if (padding.batch < 0) {
+      padding.batch = inputs[i].dim_size(0);
+    } else if (inputs[i].dim_size(0) != padding.batch) {
+      OVTF_VLOG(2) << "Not padding inputs of different batch sizes";
+      return Padding();
+    }
+    if (inputs[i].dims() > 1) {
+      if (padding.sequence < 0) {
+        padding.sequence = inputs[i].dim_size(1);
+      } else if (inputs[i].dim_size(1) != padding.sequence) {
+        same_sequence = false;
+      }
+    }
+  }
+  if (!same_sequence) padding.sequence = -1;
+  padding.padded_batch = padding.batch;
+  padding.padded_sequence = padding.sequence;
+
+  if (padding.batch > 0) {
+    // Batches larger than the largest bucket run unpadded
+    auto it = std::lower_bound(m_batch_buckets.begin(), m_batch_buckets.end(),
+                               padding.batch);
+    if (it != m_batch_buckets.end()) padding.padded_batch = *it;
+  }
+  if (padding.sequence > 0 && m_sequence_bucket_size > 0) {
+    padding.padded_sequence =
+        (padding.sequence + m_sequence_bucket_size - 1) /
+        m_sequence_bucket_size * m_sequence_bucket_size;
+  }
+  if (!padding.IsPadded()) return padding;
+
+  OVTF_VLOG(2) << "Padding batch " << padding.batch << " to "
+               << padding.padded_batch << ", sequence " << padding.sequence
+               << " to " << padding.padded_sequence;
+  for (int i = 0; i < inputs.size(); i++) {
+    if (!bucketed[i]) continue;
+    TensorShape shape = inputs[i].shape();
+    shape.set_dim(0, padding.padded_batch);
+    if (shape.dims() > 1 && padding.padded_sequence != padding.sequence) {
+      shape.set_dim(1, padding.padded_sequence);
+    }
+    if (shape == inputs[i].shape()) continue;
+
+    Tensor padded(inputs[i].dtype(), shape);
+    auto data = padded.tensor_data();
+    std::memset(const_cast<char*>(data.data()), 0, data.size());
+    CopyLeadingBlock(inputs[i], &padded);
+    inputs[i] = padded;
+  }
+  return padding;
+}
+
+ShapeBucketing::OutputDims ShapeBucketing::FindOutputDims(
+    const std::shared_ptr<ov::Model>& model, const ov::ResultVector& results,
+    const std::vector<TensorShape>& input_shapes,
+    const std::vector<bool>& input_is_bucketed) const {
+  OutputDims dims;
+  if (!IsEnabled() || model->get_parameters().size() != input_shapes.size()) {
+    return dims;
+  }
+  // The results of the copies are in the order of those of the model
+  std::vector<int> result_index;
+  const auto& model_results = model->get_results();
+  for (const auto& result : results) {
+    auto it = std::find(model_results.begin(), model_results.end(), result);
+    if (it == model_results.end()) return dims;
+    result_index.push_back(it - model_results.begin());
+  }
+
+  // Output shapes of a copy with dimension dim of the bucketed inputs
+  // doubled, or of none if dim is negative. The size is that of the
+  // dimension, which the bucketed inputs must share.
+  auto reshaped_shapes = [&](int dim, std::vector<ov::Shape>& shapes,
+                             int64& size) {
+    auto reshaped = model->clone();
+    std::map<ov::Output<ov::Node>, ov::PartialShape> param_shapes;
+    const auto& params = reshaped->get_parameters();
+    size = -1;
+    for (int i = 0; i < params.size(); i++) {
+      ov::Shape shape(input_shapes[i].dims());
+      for (int j = 0; j < input_shapes[i].dims(); j++) {
+        shape[j] = input_shapes[i].dim_size(j);
+      }
+      if (dim >= 0 && input_is_bucketed[i] && dim < shape.size()) {
+        if (size >= 0 && shape[dim] != size) return false;
+        size = shape[dim];
+        shape[dim] *= 2;
+      }
+      param_shapes[params[i]->output(0)] = shape;
+    }
+    if (dim >= 0 && size <= 0) return false;
+    try {
+      reshaped->reshape(param_shapes);
+    } catch (const std::exception& e) {
+      OVTF_VLOG(2) << "Failed to reshape for the padded outputs: "
+                   << e.what();
+      return false;
+    }
+    const auto& reshaped_results = reshaped->get_results();
+    for (int i : result_index) {
+      if (reshaped_results[i]->is_dynamic()) return false;
+      shapes.push_back(reshaped_results[i]->get_shape());
+    }
+    return true;
+  };
+  // Whether every output either keeps its shape, or has dimension dim
+  // doubled from the size of the inputs
+  auto follows = [](int dim, int64 size, const std::vector<ov::Shape>& base,
+                    const std::vector<ov::Shape>& doubled,
+                    std::vector<bool>& output_follows) {
+    output_follows.assign(base.size(), false);
+    for (int i = 0; i < base.size(); i++) {
+      if (base[i].size() != doubled[i].size()) return false;
+      for (int j = 0; j < base[i].size(); j++) {
+        if (base[i][j] == doubled[i][j]) continue;
+        if (j != dim || base[i][j] != size || doubled[i][j] != 2 * size) {
+          return false;
+        }
+        output_follows[i] = true;
+      }
+    }
+    return true;
+  };
+
+  std::vector<ov::Shape> base;
+  int64 size;
+  if (!reshaped_shapes(-1, base, size)) return dims;
+  std::vector<ov::Shape> doubled;
+  if (!m_batch_buckets.empty() && reshaped_shapes(0, doubled, size)) {
+    dims.batch_known = follows(0, size, base, doubled, dims.batch);
+  }
+  doubled.clear();
+  if (m_sequence_bucket_size > 0 && reshaped_shapes(1, doubled, size)) {
+    dims.sequence_known = follows(1, size, base, doubled, dims.sequence);
+  }
+  return dims;
+}
+
+void ShapeBucketing::CopyLeadingBlock(const Tensor& src, Tensor* dst) {
+  // Both tensors are handled as [d0, d1, inner]
+  const TensorShape& src_shape = src.shape();
+  const TensorShape& dst_shape = dst->shape();
+  int rank = src_shape.dims();
+  int64 src_d0 = rank > 0 ? src_shape.dim_size(0) : 1;
+  int64 dst_d0 = rank > 0 ? dst_shape.dim_size(0) : 1;
+  int64 src_d1 = rank > 1 ? src_shape.dim_size(1) : 1;
+  int64 dst_d1 = rank > 1 ? dst_shape.dim_size(1) : 1;
+  int64 inner = DataTypeSize(src.dtype());
+  for (int i = 2; i < rank; i++) {
+    inner *= src_shape.dim_size(i);
+  }
+
+  int64 rows = std::min(src_d0, dst_d0);
+  int64 row_bytes = std::min(src_d1, dst_d1) * inner;
+  const char* src_data = src.tensor_data().data();
+  char* dst_data = const_cast<char*>(dst->tensor_data().data());
+  for (int64 r = 0; r < rows; r++) {
+    std::memcpy(dst_data + r * dst_d1 * inner, src_data + r * src_d1 * inner,
+                row_bytes);
+  }
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
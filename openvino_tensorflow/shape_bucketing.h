@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_SHAPE_BUCKETING_H_
+#define OPENVINO_TF_SHAPE_BUCKETING_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "openvino/openvino.hpp"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Pads the batch (first) and sequence (second) dimensions of the cluster
+// inputs up to a fixed set of buckets, so that ragged request sizes map to a
+// bounded number of compiled executables. The inputs are zero padded and the
+// outputs are sliced back to the actual sizes, which is only correct for
+// clusters whose batch rows and sequence positions are independent. The
+// static and the variable inputs are never padded.
+class ShapeBucketing {
+ public:
+  // The outputs of an executable which follow the batch, or the sequence,
+  // of its padded inputs, found from the translated model
+  struct OutputDims {
+    // Whether the outputs following the dimension are known, the calls
+    // padding it can not be sliced back otherwise
+    bool batch_known = false;
+    bool sequence_known = false;
+    // Per output, whether its first (second) dimension is the batch
+    // (sequence)
+    std::vector<bool> batch;
+    std::vector<bool> sequence;
+  };
+
+  // The padding applied to one call
+  struct Padding {
+    int64 batch = -1;
+    int64 padded_batch = -1;
+    int64 sequence = -1;
+    int64 padded_sequence = -1;
+
+    bool IsPadded() const {
+      return padded_batch != batch || padded_sequence != sequence;
+    }
+    // Whether the outputs of the call can be sliced back
+    bool CanUnpad(const OutputDims& dims) const {
+      return (padded_batch == batch || dims.batch_known) &&
+             (padded_sequence == sequence || dims.sequence_known);
+    }
+    // Shape of output i computed from the padded inputs, without padding
+    TensorShape UnpaddedShape(const TensorShape& padded_shape,
+                              const OutputDims& dims, int i) const;
+  };
+
+  // Bucketing disabled
+  ShapeBucketing() {}
+  // batch_buckets must be sorted. A sequence_bucket_size of 0 disables
+  // padding of the sequence dimension.
+  ShapeBucketing(std::vector<int64> batch_buckets, int64 sequence_bucket_size);
+
+  // Reads OPENVINO_TF_BATCH_BUCKETS and OPENVINO_TF_SEQUENCE_BUCKET_SIZE
+  static ShapeBucketing FromEnv();
+
+  bool IsEnabled() const {
+    return !m_batch_buckets.empty() || m_sequence_bucket_size > 0;
+  }
+  // The batch buckets and the sequence bucket size
+  std::string DebugString() const;
+
+  // Whether every input is padded, which excludes the static and the
+  // variable inputs and the scalars
+  static std::vector<bool> BucketedInputs(
+      const std::vector<TensorShape>& input_shapes,
+      const std::vector<bool>& input_is_static,
+      const std::vector<bool>& input_is_variable);
+
+  // Replaces the bucketed inputs with padded copies. Returns the padding
+  // applied, which is not padded if the inputs need none or can not be
+  // bucketed. The bucketed inputs must share their batch, and their
+  // sequence for it to be padded.
+  Padding PadInputs(std::vector<Tensor>& inputs,
+                    const std::vector<bool>& input_is_static,
+                    const std::vector<bool>& input_is_variable) const;
+
+  // Finds the outputs of the translated model which follow the batch and
+  // the sequence of its bucketed inputs, by reshaping copies of it with
+  // either dimension doubled. The parameters of the model are the inputs
+  // of the cluster, with shapes input_shapes, and results are its outputs.
+  // A dimension is unknown if the model does not reshape, or if an output
+  // changes in any other way than the same dimension doubled.
+  OutputDims FindOutputDims(const std::shared_ptr<ov::Model>& model,
+                            const ov::ResultVector& results,
+                            const std::vector<TensorShape>& input_shapes,
+                            const std::vector<bool>& input_is_bucketed) const;
+
+  // Copies the overlapping part of the first two dimensions of src into dst.
+  // The remaining dimensions and the dtypes must match.
+  static void CopyLeadingBlock(const Tensor& src, Tensor* dst);
+
+ private:
+  std::vector<int64> m_batch_buckets;
+  int64 m_sequence_bucket_size = 0;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_SHAPE_BUCKETING_H_
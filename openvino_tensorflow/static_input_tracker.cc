@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/platform/fingerprint.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/static_input_tracker.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+StaticInputTracker::StaticInputTracker(const vector<bool>& input_is_static,
+                                       size_t limit)
+    : m_limit(limit),
+      m_input_is_static(input_is_static),
+      m_static_inputs(make_shared<const vector<bool>>(input_is_static)),
+      m_values(input_is_static.size()) {}
+
+size_t StaticInputTracker::LimitFromEnv() {
+  string limit = util::GetEnv("OPENVINO_TF_STATIC_INPUT_VALUE_LIMIT");
+  return limit.empty() ? 8 : std::stoull(limit);
+}
+
+shared_ptr<const vector<bool>> StaticInputTracker::StaticInputs() const {
+  lock_guard<mutex> lock(m_mutex);
+  return m_static_inputs;
+}
+
+bool StaticInputTracker::RecordMiss(const vector<Tensor>& inputs) {
+  lock_guard<mutex> lock(m_mutex);
+  if (m_limit == 0) return false;
+  vector<bool> static_inputs = *m_static_inputs;
+  bool changed = false;
+  for (size_t i = 0; i < inputs.size() && i < static_inputs.size(); i++) {
+    if (!static_inputs[i] || !DataTypeCanUseMemcpy(inputs[i].dtype())) {
+      continue;
+    }
+    uint64 value = FingerprintCat64(
+        Fingerprint64(inputs[i].shape().DebugString()),
+        Fingerprint64(inputs[i].tensor_data()));
+    m_values[i].insert(value);
+    if (m_values[i].size() > m_limit) {
+      OVTF_VLOG(1) << "Static input " << i << " had " << m_values[i].size()
+                   << " values, reading it at run time";
+      static_inputs[i] = false;
+      m_values[i].clear();
+      changed = true;
+    }
+  }
+  if (changed) {
+    m_static_inputs = make_shared<const vector<bool>>(static_inputs);
+  }
+  return changed;
+}
+
+bool StaticInputTracker::Disable() {
+  lock_guard<mutex> lock(m_mutex);
+  m_limit = 0;
+  if (*m_static_inputs == m_input_is_static) {
+    return false;
+  }
+  m_static_inputs = make_shared<const vector<bool>>(m_input_is_static);
+  return true;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
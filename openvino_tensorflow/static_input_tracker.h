@@ -0,0 +1,59 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_STATIC_INPUT_TRACKER_H_
+#define OPENVINO_TF_STATIC_INPUT_TRACKER_H_
+
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "tensorflow/core/framework/tensor.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Detects the static inputs of a cluster whose value keeps changing, such as
+// a shape computed every step and fed to a Reshape. Every new value of a
+// static input is a cache miss and a compilation, so once an input has
+// missed with more distinct values than the limit, the cluster is
+// translated to read it at run time instead. The tracker is thread safe.
+class StaticInputTracker {
+ public:
+  // input_is_static are the inputs of the cluster read as constants by the
+  // translation. A limit of 0 disables the tracking.
+  StaticInputTracker(const std::vector<bool>& input_is_static, size_t limit);
+
+  // Reads OPENVINO_TF_STATIC_INPUT_VALUE_LIMIT
+  static size_t LimitFromEnv();
+
+  // The inputs which are currently translated as constants. The snapshot
+  // stays valid while the tracker changes.
+  std::shared_ptr<const std::vector<bool>> StaticInputs() const;
+
+  // Records the values of the static inputs of a cache miss. Returns true if
+  // one of them is read at run time from now on, which changes the
+  // signature of the miss.
+  bool RecordMiss(const std::vector<Tensor>& inputs);
+
+  // Translates every static input as a constant again and stops tracking,
+  // once reading an input at run time failed. Returns false if no input
+  // was read at run time.
+  bool Disable();
+
+ private:
+  mutable std::mutex m_mutex;
+  size_t m_limit = 0;
+  std::vector<bool> m_input_is_static;
+  std::shared_ptr<const std::vector<bool>> m_static_inputs;
+  // The fingerprints of the values seen by every static input
+  std::vector<std::unordered_set<uint64>> m_values;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_STATIC_INPUT_TRACKER_H_
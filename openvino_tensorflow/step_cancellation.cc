@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "tensorflow/core/lib/core/errors.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/step_cancellation.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+shared_ptr<StepCancellation> StepCancellation::Create(
+    CancellationManager* manager) {
+  shared_ptr<StepCancellation> cancellation(new StepCancellation());
+  if (manager == nullptr) return cancellation;
+  if (manager->IsCancelled()) {
+    cancellation->m_cancelled = true;
+    return cancellation;
+  }
+  CancellationToken token = manager->get_cancellation_token();
+  // The manager may call back while the cancellation is released
+  weak_ptr<StepCancellation> weak = cancellation;
+  bool registered = manager->RegisterCallback(token, [weak]() {
+    if (auto cancellation = weak.lock()) cancellation->Cancel();
+  });
+  if (registered) {
+    cancellation->m_manager = manager;
+    cancellation->m_token = token;
+  } else {
+    cancellation->m_cancelled = true;
+  }
+  return cancellation;
+}
+
+StepCancellation::~StepCancellation() { Release(); }
+
+bool StepCancellation::IsCancelled() {
+  lock_guard<recursive_mutex> lock(m_mutex);
+  return m_cancelled;
+}
+
+Status StepCancellation::Check() {
+  if (IsCancelled()) return errors::Cancelled("The step was cancelled");
+  return Status::OK();
+}
+
+void StepCancellation::Release() {
+  CancellationManager* manager = nullptr;
+  {
+    lock_guard<recursive_mutex> lock(m_mutex);
+    std::swap(manager, m_manager);
+  }
+  // Does not wait for a cancellation in progress, which may be the caller
+  if (manager != nullptr) manager->TryDeregisterCallback(m_token);
+}
+
+void StepCancellation::Cancel() {
+  lock_guard<recursive_mutex> lock(m_mutex);
+  if (m_cancelled) return;
+  m_cancelled = true;
+  OVTF_VLOG(2) << "StepCancellation: cancelling " << m_callbacks.size()
+               << " calls";
+  // A callback may deregister another one
+  auto callbacks = m_callbacks;
+  for (auto& it : callbacks) {
+    if (m_callbacks.count(it.first)) it.second();
+  }
+  m_callbacks.clear();
+}
+
+int StepCancellation::Register(std::function<void()> cancel) {
+  lock_guard<recursive_mutex> lock(m_mutex);
+  if (m_cancelled) return -1;
+  m_callbacks[m_next_id] = std::move(cancel);
+  return m_next_id++;
+}
+
+void StepCancellation::Deregister(int id) {
+  lock_guard<recursive_mutex> lock(m_mutex);
+  m_callbacks.erase(id);
+}
+
+shared_ptr<StepCancellation>& StepCancellation::CurrentRef() {
+  static thread_local shared_ptr<StepCancellation> current;
+  return current;
+}
+
+shared_ptr<StepCancellation> StepCancellation::Current() {
+  return CurrentRef();
+}
+
+StepCancellation::Scope::Scope(shared_ptr<StepCancellation> cancellation)
+    : m_previous(std::move(CurrentRef())) {
+  CurrentRef() = std::move(cancellation);
+}
+
+StepCancellation::Scope::~Scope() { CurrentRef() = std::move(m_previous); }
+
+StepCancellation::Registration::Registration(std::function<void()> cancel)
+    : Registration(Current(), std::move(cancel)) {}
+
+StepCancellation::Registration::Registration(
+    shared_ptr<StepCancellation> cancellation, std::function<void()> cancel)
+    : m_cancellation(std::move(cancellation)) {
+  if (m_cancellation == nullptr) return;
+  m_id = m_cancellation->Register(std::move(cancel));
+  m_cancelled = m_id < 0;
+}
+
+StepCancellation::Registration::~Registration() {
+  if (m_id >= 0) m_cancellation->Deregister(m_id);
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_STEP_CANCELLATION_H_
+#define OPENVINO_TF_STEP_CANCELLATION_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include "tensorflow/core/framework/cancellation.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// The cancellation of the TF step a cluster runs for, e.g. when the client
+// of a server timed out. It is registered with the cancellation manager of
+// the kernel context, and forwards the cancellation to the work done for
+// the step: the infer requests in flight are cancelled, and the queued
+// micro batching calls and background compilations are dropped.
+//
+// The engines find the cancellation of the step of the calling thread with
+// Current(), which the kernel sets with a Scope.
+class StepCancellation {
+ public:
+  // Thrown by the calls which were cancelled
+  class Cancelled : public std::runtime_error {
+   public:
+    Cancelled() : std::runtime_error("The step was cancelled") {}
+  };
+
+  // Registers with manager, which may be null when the step can not be
+  // cancelled
+  static std::shared_ptr<StepCancellation> Create(CancellationManager* manager);
+  ~StepCancellation();
+
+  bool IsCancelled();
+  // Cancelled when the step was cancelled, OK otherwise
+  Status Check();
+  // Deregisters from the cancellation manager, which may be destroyed once
+  // the kernel is done. The step can not be cancelled anymore afterwards.
+  void Release();
+
+  // The cancellation of the step the calling thread runs, null outside of
+  // a Scope
+  static std::shared_ptr<StepCancellation> Current();
+
+  // Makes cancellation the one of the calling thread while in scope
+  class Scope {
+   public:
+    explicit Scope(std::shared_ptr<StepCancellation> cancellation);
+    ~Scope();
+
+   private:
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    std::shared_ptr<StepCancellation> m_previous;
+  };
+
+  // Calls cancel when the step is cancelled while in scope. Once the
+  // registration is destroyed cancel is not called anymore, nor running.
+  class Registration {
+   public:
+    // With the cancellation of the calling thread
+    explicit Registration(std::function<void()> cancel);
+    Registration(std::shared_ptr<StepCancellation> cancellation,
+                 std::function<void()> cancel);
+    ~Registration();
+    // The step was already cancelled, cancel is not called
+    bool cancelled() const { return m_cancelled; }
+
+   private:
+    Registration(const Registration&) = delete;
+    Registration& operator=(const Registration&) = delete;
+    std::shared_ptr<StepCancellation> m_cancellation;
+    int m_id = -1;
+    bool m_cancelled = false;
+  };
+
+ private:
+  StepCancellation() = default;
+  // Called by the cancellation manager
+  void Cancel();
+  // Returns the id of the callback, -1 if the step is already cancelled
+  int Register(std::function<void()> cancel);
+  void Deregister(int id);
+
+  static std::shared_ptr<StepCancellation>& CurrentRef();
+
+  CancellationManager* m_manager = nullptr;
+  CancellationToken m_token;
+  // The callbacks run with the mutex held, so that a deregistered callback
+  // is not running. It is recursive for the callbacks which complete an
+  // inference, and deregister, from the cancelling thread.
+  std::recursive_mutex m_mutex;
+  bool m_cancelled = false;
+  int m_next_id = 0;
+  std::map<int, std::function<void()>> m_callbacks;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_STEP_CANCELLATION_H_
@@ -207,6 +207,15 @@ class SymbolPredicate : public Predicate {
                       TensorId::Hasher{}(tensor_id)));
   }
 };
+// Hashes and compares the predicates structurally
+struct PredicatePtrHash {
+  size_t operator()(const Predicate* pred) const { return pred->hash(); }
+};
+struct PredicatePtrEq {
+  bool operator()(const Predicate* a, const Predicate* b) const {
+    return a == b || *a == *b;
+  }
+};
 // Creates and owns Predicate instances.  Simplifies predicates as it creates
 // them.
 class PredicateFactory {
@@ -235,14 +244,6 @@ class PredicateFactory {
     return predicate_storage_.back().get();
   }
   Predicate* MakeAndOrImpl(gtl::ArraySlice<Predicate*> operands, bool is_and);
-  struct PredicatePtrHash {
-    size_t operator()(const Predicate* pred) const { return pred->hash(); }
-  };
-  struct PredicatePtrEq {
-    size_t operator()(const Predicate* a, const Predicate* b) const {
-      return *a == *b;
-    }
-  };
   using PredicateSet =
       gtl::FlatSet<Predicate*, PredicatePtrHash, PredicatePtrEq>;
   std::vector<std::unique_ptr<Predicate>> predicate_storage_;
@@ -297,11 +298,17 @@ Predicate* PredicateFactory::MakeAndOrImpl(gtl::ArraySlice<Predicate*> operands,
 class DeadnessAnalysisImpl : public DeadnessAnalysis {
  public:
   explicit DeadnessAnalysisImpl(const Graph* graph)
-      : graph_(*graph), vlog_(VLOG_IS_ON(2)) {}
+      : graph_(*graph), vlog_(VLOG_IS_ON(2)) {
+    // The control flow ops have no predicate of their own
+    interned_predicates_.push_back(nullptr);
+    CHECK_EQ(Intern(predicate_factory_.MakeTrue()), kTruePredId);
+  }
   Status Populate();
   bool HasInputsWithMismatchingDeadness(const Node& node) override;
   void Print() const override;
   Status GetNodePredicate(const Node& node, string& pred_string) override;
+  Status GetNodePredicateId(const Node& node, int& pred_id) override;
+  string GetPredicateString(int pred_id) const override;
 
  private:
   enum class EdgeKind { kDataAndControl, kDataOnly, kControlOnly };
@@ -319,9 +326,16 @@ class DeadnessAnalysisImpl : public DeadnessAnalysis {
   Status HandleMerge(Node* n);
   Status HandleRecv(Node* n);
   Status HandleGeneric(Node* n);
+  // The id of pred, equal predicates getting the same id
+  int Intern(Predicate* pred);
   const Graph& graph_;
   gtl::FlatMap<TensorId, Predicate*, TensorId::Hasher> predicate_map_;
   PredicateFactory predicate_factory_;
+  // The interned predicates and their ids, as handed out by
+  // GetNodePredicateId
+  gtl::FlatMap<Predicate*, int, PredicatePtrHash, PredicatePtrEq>
+      predicate_ids_;
+  std::vector<Predicate*> interned_predicates_;
   bool vlog_;
 };
 TensorId InputEdgeToTensorId(const Edge* e) {
@@ -458,10 +472,18 @@ bool DeadnessAnalysisImpl::HasInputsWithMismatchingDeadness(const Node& node) {
   return false;
 }
 
-Status DeadnessAnalysisImpl::GetNodePredicate(const Node& node,
-                                              string& pred_string) {
+int DeadnessAnalysisImpl::Intern(Predicate* pred) {
+  auto it = predicate_ids_.insert({pred, interned_predicates_.size()});
+  if (it.second) {
+    interned_predicates_.push_back(pred);
+  }
+  return it.first->second;
+}
+
+Status DeadnessAnalysisImpl::GetNodePredicateId(const Node& node,
+                                                int& pred_id) {
   if (node.IsSource() || node.IsSink() || node.IsControlFlow()) {
-    DeadnessAnalysis::GetControlFlowPredString(pred_string);
+    pred_id = kControlFlowPredId;
     return Status::OK();
   }
 
@@ -471,7 +493,7 @@ Status DeadnessAnalysisImpl::GetNodePredicate(const Node& node,
     CHECK(it != predicate_map_.end()) << edge->DebugString();
 
     // This node is not control flow but has different output predicates
-    if (pred != nullptr && *pred != *it->second) {
+    if (pred != nullptr && pred != it->second && *pred != *it->second) {
       return errors::Internal(node.name(), "[", node.type_string(), "]",
                               " is a non control flow op. But its outputs have "
                               "different predicates");
@@ -479,13 +501,34 @@ Status DeadnessAnalysisImpl::GetNodePredicate(const Node& node,
     pred = it->second;
   }
 
-  // All outputs have the same predicate
-  if (pred != nullptr) {
-    pred_string = pred->ToString();
+  // A node without outgoing edges is alive iff its control output is
+  if (pred == nullptr) {
+    auto it = predicate_map_.find(TensorId(node.name(), Graph::kControlSlot));
+    CHECK(it != predicate_map_.end()) << node.name();
+    pred = it->second;
   }
+
+  // All outputs have the same predicate
+  pred_id = Intern(pred);
+  return Status::OK();
+}
+
+Status DeadnessAnalysisImpl::GetNodePredicate(const Node& node,
+                                              string& pred_string) {
+  int pred_id;
+  TF_RETURN_IF_ERROR(GetNodePredicateId(node, pred_id));
+  pred_string = GetPredicateString(pred_id);
   return Status::OK();
 }
 
+string DeadnessAnalysisImpl::GetPredicateString(int pred_id) const {
+  CHECK(pred_id >= 0 && pred_id < interned_predicates_.size()) << pred_id;
+  if (pred_id == kControlFlowPredId) {
+    return CONTROL_FLOW_PRED_STRING;
+  }
+  return interned_predicates_[pred_id]->ToString();
+}
+
 void DeadnessAnalysisImpl::Print() const {
   std::vector<TensorId> tensor_ids;
   for (const auto& kv_pair : predicate_map_) {
@@ -514,6 +557,9 @@ DeadnessAnalysis::~DeadnessAnalysis() {}
   return Status::OK();
 }
 
+/*static*/ constexpr int DeadnessAnalysis::kControlFlowPredId;
+/*static*/ constexpr int DeadnessAnalysis::kTruePredId;
+
 /*static*/ const std::string DeadnessAnalysis::CONTROL_FLOW_PRED_STRING =
     "#control_flow";
 // Same as the True predicate used in AndPredicate
@@ -85,6 +85,19 @@ class DeadnessAnalysis {
   // assigned a placeholder predicate string (CONTROL_FLOW_PRED_STRING) .
   virtual Status GetNodePredicate(const Node& node, string& pred_string) = 0;
 
+  // Same as GetNodePredicate, but hands out the interned id of the predicate,
+  // so that the predicates can be compared without rendering them. Equal
+  // predicates get the same id, which is stable for the lifetime of the
+  // analysis. The control flow ops get kControlFlowPredId and the nodes
+  // which are always alive kTruePredId.
+  virtual Status GetNodePredicateId(const Node& node, int& pred_id) = 0;
+
+  // The string of an interned predicate, for logging
+  virtual string GetPredicateString(int pred_id) const = 0;
+
+  static constexpr int kControlFlowPredId = 0;
+  static constexpr int kTruePredId = 1;
+
   inline static bool IsControlFlowPredString(const string& predicate) {
     return CONTROL_FLOW_PRED_STRING == predicate;
   }
@@ -0,0 +1,122 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "openvino/runtime/intel_gpu/ocl/ocl.hpp"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/backend.h"
+#include "openvino_tensorflow/usm_host_allocator.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Below this size the copy of an input costs less than mapping its memory
+static const size_t kMinUSMBytes = 64 * 1024;
+static const size_t kMaxFreeBytes = 256 * 1024 * 1024;
+
+USMHostAllocator* USMHostAllocator::Get() {
+  static once_flag once;
+  static USMHostAllocator* allocator = nullptr;
+  // Like the allocators of TF it lives until the process exits, the tensors
+  // it allocated may outlive any owner
+  call_once(once, []() {
+    auto context = Backend::GetGPUContext();
+    if (context != nullptr) allocator = new USMHostAllocator(context);
+  });
+  return allocator;
+}
+
+USMHostAllocator::USMHostAllocator(shared_ptr<ov::RemoteContext> context)
+    : m_context(std::move(context)), m_max_free_bytes(kMaxFreeBytes) {}
+
+USMHostAllocator::~USMHostAllocator() {}
+
+void* USMHostAllocator::AllocateRaw(size_t alignment, size_t num_bytes) {
+  if (num_bytes < kMinUSMBytes) {
+    return cpu_allocator()->AllocateRaw(alignment, num_bytes);
+  }
+  {
+    // The smallest released allocation which is not twice as large
+    lock_guard<mutex> lock(m_mutex);
+    auto it = m_free.lower_bound(num_bytes);
+    if (it != m_free.end() && it->first <= 2 * num_bytes) {
+      void* ptr = it->second.as<ov::intel_gpu::ocl::USMTensor>().get();
+      if (reinterpret_cast<uintptr_t>(ptr) % alignment == 0) {
+        m_free_bytes -= it->first;
+        m_in_use.emplace(ptr, std::move(it->second));
+        m_free.erase(it);
+        return ptr;
+      }
+    }
+  }
+
+  try {
+    auto context = m_context->as<ov::intel_gpu::ocl::ClContext>();
+    ov::Tensor tensor =
+        context.create_usm_host_tensor(ov::element::u8, ov::Shape{num_bytes});
+    void* ptr = tensor.as<ov::intel_gpu::ocl::USMTensor>().get();
+    if (reinterpret_cast<uintptr_t>(ptr) % alignment == 0) {
+      lock_guard<mutex> lock(m_mutex);
+      m_in_use.emplace(ptr, std::move(tensor));
+      return ptr;
+    }
+    OVTF_VLOG(2) << "USM host memory is not aligned to " << alignment;
+  } catch (const std::exception& e) {
+    OVTF_VLOG(1) << "Failed to allocate " << num_bytes
+                 << " bytes of USM host memory: " << e.what();
+  }
+  return cpu_allocator()->AllocateRaw(alignment, num_bytes);
+}
+
+void USMHostAllocator::DeallocateRaw(void* ptr) {
+  unique_lock<mutex> lock(m_mutex);
+  auto it = m_in_use.find(ptr);
+  if (it == m_in_use.end()) {
+    lock.unlock();
+    cpu_allocator()->DeallocateRaw(ptr);
+    return;
+  }
+  ov::Tensor tensor = std::move(it->second);
+  m_in_use.erase(it);
+  size_t bytes = tensor.get_byte_size();
+  if (m_free_bytes + bytes <= m_max_free_bytes) {
+    m_free_bytes += bytes;
+    m_free.emplace(bytes, std::move(tensor));
+    return;
+  }
+  // The memory is released with the tensor, outside the lock
+  lock.unlock();
+}
+
+ov::Tensor USMHostAllocator::WrapTensor(void* data,
+                                        const ov::element::Type& element_type,
+                                        const ov::Shape& shape) {
+  const size_t bytes = ov::shape_size(shape) * element_type.size();
+  {
+    // The allocation containing data, which points into it for a slice
+    lock_guard<mutex> lock(m_mutex);
+    auto it = m_in_use.upper_bound(data);
+    if (it == m_in_use.begin()) return ov::Tensor();
+    --it;
+    const uint8_t* base = static_cast<const uint8_t*>(it->first);
+    if (static_cast<const uint8_t*>(data) + bytes >
+        base + it->second.get_byte_size()) {
+      return ov::Tensor();
+    }
+  }
+  try {
+    auto context = m_context->as<ov::intel_gpu::ocl::ClContext>();
+    return context.create_tensor(element_type, shape, data);
+  } catch (const std::exception& e) {
+    OVTF_VLOG(2) << "Failed to wrap USM host memory: " << e.what();
+    return ov::Tensor();
+  }
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_USM_HOST_ALLOCATOR_H_
+#define OPENVINO_TF_USM_HOST_ALLOCATOR_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "tensorflow/core/framework/allocator.h"
+
+#include "openvino/openvino.hpp"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// A TF allocator handing out USM host memory of the default GPU context.
+// The GPU clusters bind the inputs allocated with it as USM tensors of the
+// context, which the device reads directly instead of copying them to a
+// buffer of its own first.
+//
+// TF allocates the tensors of its ops with the allocators it registered
+// at startup, so the allocator is meant for the tensors the application
+// feeds to the session, see api::GetUSMHostAllocator. Small allocations,
+// which are cheaper to copy than to map, come from the CPU allocator.
+class USMHostAllocator : public Allocator {
+ public:
+  // The allocator of the default GPU context, nullptr without a GPU
+  static USMHostAllocator* Get();
+
+  ~USMHostAllocator() override;
+
+  std::string Name() override { return "ovtf_usm_host"; }
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override;
+  void DeallocateRaw(void* ptr) override;
+
+  // A tensor of the GPU context sharing the memory at data, an empty tensor
+  // if data was not allocated by the allocator
+  ov::Tensor WrapTensor(void* data, const ov::element::Type& element_type,
+                        const ov::Shape& shape);
+
+ private:
+  explicit USMHostAllocator(std::shared_ptr<ov::RemoteContext> context);
+
+  std::shared_ptr<ov::RemoteContext> m_context;
+  std::mutex m_mutex;
+  // The allocations in use by their address, and the released ones by
+  // their size, which are reused up to m_max_free_bytes
+  std::map<const void*, ov::Tensor> m_in_use;
+  std::multimap<size_t, ov::Tensor> m_free;
+  size_t m_free_bytes = 0;
+  size_t m_max_free_bytes;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_USM_HOST_ALLOCATOR_H_
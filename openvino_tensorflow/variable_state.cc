@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <cstring>
+
+#include "tensorflow/core/framework/types.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/ie_tensor.h"
+#include "openvino_tensorflow/variable_state.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+bool VariableState::SameValue(const Tensor& a, const Tensor& b) {
+  if (a.dtype() != b.dtype() || a.shape() != b.shape()) return false;
+  if (a.NumElements() == 0) return true;
+  const auto data_a = a.tensor_data();
+  const auto data_b = b.tensor_data();
+  if (data_a.data() == data_b.data()) return true;
+  // The other types are only compared by buffer
+  return DataTypeCanUseMemcpy(a.dtype()) &&
+         memcmp(data_a.data(), data_b.data(), data_a.size()) == 0;
+}
+
+bool VariableState::HoldLocked(int i, const Tensor& input) {
+  if (i >= m_variables.size()) m_variables.resize(i + 1);
+  Variable& variable = m_variables[i];
+  if (variable.held && SameValue(variable.tensor, input)) return false;
+
+  bool written = variable.held;
+  variable.held = true;
+  variable.tensor = input;
+  variable.bound = nullptr;
+  return written;
+}
+
+bool VariableState::Update(const vector<Tensor>& inputs,
+                           const vector<bool>& is_variable) {
+  lock_guard<mutex> lock(m_mutex);
+  bool written = false;
+  for (int i = 0; i < inputs.size(); i++) {
+    if (i < is_variable.size() && is_variable[i]) {
+      written = HoldLocked(i, inputs[i]) || written;
+    }
+  }
+  return written;
+}
+
+shared_ptr<ov::Tensor> VariableState::GetTensor(int i, const Tensor& input,
+                                                const ov::element::Type& type,
+                                                const ov::Shape& shape,
+                                                ov::RemoteContext* context,
+                                                Tensor& held) {
+  lock_guard<mutex> lock(m_mutex);
+  HoldLocked(i, input);
+  Variable& variable = m_variables[i];
+  held = variable.tensor;
+  if (variable.bound != nullptr) return variable.bound;
+
+  const auto data = variable.tensor.tensor_data();
+  if (context != nullptr && DataTypeCanUseMemcpy(input.dtype())) {
+    try {
+      auto tensor =
+          make_shared<IETensor>(context->create_host_tensor(type, shape));
+      if (tensor->get_byte_size() == data.size()) {
+        memcpy(tensor->data(), data.data(), data.size());
+        variable.bound = tensor;
+        return variable.bound;
+      }
+    } catch (const std::exception& e) {
+      OVTF_VLOG(2) << "Could not upload variable input " << i << ": "
+                   << e.what();
+    }
+  }
+  variable.bound =
+      make_shared<IETensor>(type, shape, const_cast<char*>(data.data()));
+  return variable.bound;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
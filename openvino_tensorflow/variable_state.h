@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_VARIABLE_STATE_H_
+#define OPENVINO_TF_VARIABLE_STATE_H_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "openvino/openvino.hpp"
+#include "tensorflow/core/framework/tensor.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// The variables read by an executable. Holding a reference to the TF buffer
+// of a variable makes TF write the variable to a new buffer instead of
+// updating it in place, so a held variable is unchanged for as long as its
+// input is the held buffer. A variable read into a new buffer holding the
+// same value, e.g. in copy-on-read mode, is unchanged as well.
+//
+// This lets the variables baked into a model as constants be checked for
+// writes with a pointer comparison, and the variables bound as inputs keep
+// one tensor, and its binding, until they are written.
+class VariableState {
+ public:
+  // Holds the inputs flagged in is_variable. Returns true if one of the
+  // variables was written since it was held.
+  bool Update(const std::vector<Tensor>& inputs,
+              const std::vector<bool>& is_variable);
+
+  // The tensor binding variable input i, which is only recreated when the
+  // variable is written. With a context, the variable is uploaded to a host
+  // tensor of the context, otherwise the TF buffer is wrapped. held is set
+  // to the TF tensor the returned tensor reads, which must be kept alive
+  // until the call using it is done.
+  std::shared_ptr<ov::Tensor> GetTensor(int i, const Tensor& input,
+                                        const ov::element::Type& type,
+                                        const ov::Shape& shape,
+                                        ov::RemoteContext* context,
+                                        Tensor& held);
+
+  // Whether two tensors hold the same value
+  static bool SameValue(const Tensor& a, const Tensor& b);
+
+ private:
+  struct Variable {
+    bool held = false;
+    Tensor tensor;
+    std::shared_ptr<ov::Tensor> bound;
+  };
+
+  // Holds input i, returns true if the variable held before was written.
+  // The caller holds m_mutex.
+  bool HoldLocked(int i, const Tensor& input);
+
+  std::mutex m_mutex;
+  std::vector<Variable> m_variables;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_VARIABLE_STATE_H_
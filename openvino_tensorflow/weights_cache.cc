@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <cstring>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/dma_helper.h"
+#include "tensorflow/core/platform/hash.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/weights_cache.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+constexpr size_t WeightsCache::kMinBytes;
+
+shared_ptr<WeightsCache::Buffer> WeightsCache::Get(const Tensor& tensor) {
+  char* data = static_cast<char*>(DMAHelper::base(&tensor));
+  size_t size = tensor.TotalBytes();
+  if (size < kMinBytes) {
+    return make_shared<Buffer>(data, size, tensor);
+  }
+
+  uint64 hash = Hash64(data, size, tensor.dtype());
+  vector<shared_ptr<Buffer>> candidates;
+  {
+    lock_guard<mutex> lock(m_mutex);
+    auto range = m_buffers.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      auto buffer = it->second.buffer.lock();
+      if (buffer && it->second.dtype == tensor.dtype() &&
+          buffer->size() == size) {
+        candidates.push_back(buffer);
+      }
+    }
+  }
+  // The contents are compared without holding the lock
+  for (const auto& buffer : candidates) {
+    if (memcmp(buffer->get_ptr(), data, size) == 0) {
+      lock_guard<mutex> lock(m_mutex);
+      m_shared_bytes += size;
+      OVTF_VLOG(2) << "Sharing a constant buffer of " << size << " bytes";
+      return buffer;
+    }
+  }
+
+  auto buffer = make_shared<Buffer>(data, size, tensor);
+  lock_guard<mutex> lock(m_mutex);
+  // The released buffers are purged whenever the cache doubled in size
+  if (m_buffers.size() >= 2 * m_purged_size) {
+    for (auto it = m_buffers.begin(); it != m_buffers.end();) {
+      it = it->second.buffer.expired() ? m_buffers.erase(it) : next(it);
+    }
+    m_purged_size = max<size_t>(m_buffers.size(), 16);
+  }
+  m_buffers.emplace(hash, Entry{tensor.dtype(), buffer});
+  return buffer;
+}
+
+size_t WeightsCache::GetSharedBytes() {
+  lock_guard<mutex> lock(m_mutex);
+  return m_shared_bytes;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_WEIGHTS_CACHE_H_
+#define OPENVINO_TF_WEIGHTS_CACHE_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "tensorflow/core/framework/tensor.h"
+
+#include "ngraph/runtime/shared_buffer.hpp"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Shares the buffers of the constants with the same contents, so that the
+// models translated for the shape specializations of a cluster, or for
+// clusters holding the same weights, hold a single copy of every weight.
+// The plugins which use the constant buffers of a model in place then share
+// them between the compiled models too.
+//
+// The cache only holds weak references: a buffer is released once no
+// Constant uses it anymore.
+class WeightsCache {
+ public:
+  using Buffer = ngraph::runtime::SharedBuffer<Tensor>;
+
+  // The buffers smaller than this are not shared
+  static constexpr size_t kMinBytes = 4096;
+
+  // A buffer holding the contents of tensor, the one of a live constant with
+  // the same element type and contents if there is one, else one sharing
+  // the buffer of tensor
+  std::shared_ptr<Buffer> Get(const Tensor& tensor);
+
+  // The number of bytes which were not allocated again thanks to the cache
+  size_t GetSharedBytes();
+
+ private:
+  struct Entry {
+    DataType dtype;
+    std::weak_ptr<Buffer> buffer;
+  };
+
+  std::mutex m_mutex;
+  // The buffers, by hash of their contents
+  std::unordered_multimap<uint64, Entry> m_buffers;
+  // The number of buffers at the last purge of the released ones
+  size_t m_purged_size = 0;
+  size_t m_shared_bytes = 0;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_WEIGHTS_CACHE_H_
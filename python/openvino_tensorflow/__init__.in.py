@@ -14,6 +14,7 @@ import sys
 import ast
 import time
 import getpass
+import json
 from platform import system
 
 import numpy as np
@@ -44,7 +45,13 @@ __all__ = [
     'is_grappler_enabled', 'update_config',
     'set_disabled_ops', 'get_disabled_ops',
     'enable_dynamic_fallback', 'disable_dynamic_fallback',
-    'export_ir',
+    'export_ir', 'get_cluster_stats', 'reset_cluster_stats',
+    'get_cluster_topology', 'clear_cluster_topology', 'reset_kv_cache',
+    'set_performance_hint', 'set_num_streams', 'set_inference_num_threads',
+    'set_inference_precision', 'set_num_requests', 'set_cpu_affinity',
+    'set_cpu_threading', 'set_model_priority', 'clear_compile_properties',
+    'set_cluster_placement', 'set_aot_bundle', 'warmup', 'set_memory_budget',
+    'save_cluster_profile', 'set_pipeline_stages',
 ]
 
 if system() == 'Darwin':
@@ -137,6 +144,27 @@ if ovtf_classic_loaded:
     openvino_tensorflow_lib.freeClusterInfo.restype = ctypes.c_void_p
     openvino_tensorflow_lib.freeErrMsg.argtypes = []
     openvino_tensorflow_lib.freeErrMsg.restype = ctypes.c_void_p
+    openvino_tensorflow_lib.set_compile_property.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p)]
+    openvino_tensorflow_lib.set_compile_property.restype = ctypes.c_bool
+    openvino_tensorflow_lib.set_cluster_placement.argtypes = [ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p)]
+    openvino_tensorflow_lib.set_cluster_placement.restype = ctypes.c_bool
+    openvino_tensorflow_lib.set_pipeline_stages.argtypes = [ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p)]
+    openvino_tensorflow_lib.set_pipeline_stages.restype = ctypes.c_bool
+    openvino_tensorflow_lib.set_aot_bundle.argtypes = [ctypes.c_char_p, ctypes.c_bool, ctypes.POINTER(ctypes.c_char_p)]
+    openvino_tensorflow_lib.set_aot_bundle.restype = ctypes.c_bool
+    openvino_tensorflow_lib.start_warmup.argtypes = []
+    openvino_tensorflow_lib.finish_warmup.argtypes = []
+    openvino_tensorflow_lib.get_cluster_stats.argtypes = [ctypes.POINTER(ctypes.c_char_p)]
+    openvino_tensorflow_lib.freeClusterStats.argtypes = []
+    openvino_tensorflow_lib.freeClusterStats.restype = ctypes.c_void_p
+    openvino_tensorflow_lib.get_cluster_topology.argtypes = [ctypes.POINTER(ctypes.c_char_p)]
+    openvino_tensorflow_lib.freeClusterTopology.argtypes = []
+    openvino_tensorflow_lib.freeClusterTopology.restype = ctypes.c_void_p
+    openvino_tensorflow_lib.clear_cluster_topology.argtypes = []
+    openvino_tensorflow_lib.reset_kv_cache.argtypes = []
+    openvino_tensorflow_lib.set_memory_budget.argtypes = [ctypes.c_char_p, ctypes.c_size_t]
+    openvino_tensorflow_lib.save_cluster_profile.argtypes = [ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p)]
+    openvino_tensorflow_lib.save_cluster_profile.restype = ctypes.c_bool
 
     def enable():
         openvino_tensorflow_lib.enable()
@@ -194,7 +222,9 @@ if ovtf_classic_loaded:
     def is_grappler_enabled():
         return openvino_tensorflow_lib.is_grappler_enabled()
 
-    def update_config(config, backend_name = "CPU", device_id = ""):
+    def update_config(config, backend_name = "", device_id = ""):
+        # A backend_name runs the graphs of the session on that backend
+        # instead of the one set with set_backend
         #updating session config if grappler is enabled
         if(openvino_tensorflow_lib.is_grappler_enabled()):
             opt_name = 'ovtf-optimizer'
@@ -211,6 +241,8 @@ if ovtf_classic_loaded:
             ovtf_optimizer = rewriter_options.custom_optimizers.add()
             ovtf_optimizer.name = opt_name
             ovtf_optimizer.parameter_map["device_id"].s = device_id.encode()
+            if backend_name:
+                ovtf_optimizer.parameter_map["backend"].s = backend_name.encode()
             config.MergeFrom(tf.compat.v1.ConfigProto(graph_options=tf.compat.v1.GraphOptions(rewrite_options=rewriter_options)))
             # For reference, if we want to provide configuration support(backend parameters)
             # in a python script using the ovtf-optimizer
@@ -249,6 +281,141 @@ if ovtf_classic_loaded:
 
         return cluster_string
 
+    def _set_compile_property(key, value):
+        err_msg = ctypes.c_char_p()
+        if not openvino_tensorflow_lib.set_compile_property(key.encode("utf-8"), str(value).encode("utf-8"), ctypes.byref(err_msg)):
+            err_string = err_msg.value.decode("utf-8")
+            openvino_tensorflow_lib.freeErrMsg()
+            raise ValueError(err_string)
+
+    def set_performance_hint(mode):
+        _set_compile_property("performance_mode", mode)
+
+    def set_num_streams(num_streams):
+        _set_compile_property("num_streams", num_streams)
+
+    def set_inference_num_threads(num_threads):
+        _set_compile_property("inference_num_threads", num_threads)
+
+    def set_inference_precision(precision):
+        _set_compile_property("inference_precision", precision)
+
+    def set_num_requests(num_requests):
+        _set_compile_property("num_requests", num_requests)
+
+    def set_cpu_affinity(affinity):
+        _set_compile_property("affinity", affinity)
+
+    def set_cpu_threading(threading):
+        _set_compile_property("cpu_threading", threading)
+
+    def set_model_priority(priority):
+        _set_compile_property("model_priority", priority)
+
+    def clear_compile_properties():
+        openvino_tensorflow_lib.clear_compile_properties()
+
+    def set_cluster_placement(rules):
+        err_msg = ctypes.c_char_p()
+        if not openvino_tensorflow_lib.set_cluster_placement(rules.encode("utf-8"), ctypes.byref(err_msg)):
+            err_string = err_msg.value.decode("utf-8")
+            openvino_tensorflow_lib.freeErrMsg()
+            raise ValueError(err_string)
+
+    def set_pipeline_stages(stages):
+        err_msg = ctypes.c_char_p()
+        if not openvino_tensorflow_lib.set_pipeline_stages(stages.encode("utf-8"), ctypes.byref(err_msg)):
+            err_string = err_msg.value.decode("utf-8")
+            openvino_tensorflow_lib.freeErrMsg()
+            raise ValueError(err_string)
+
+    def set_aot_bundle(bundle_dir, export=False):
+        err_msg = ctypes.c_char_p()
+        if not openvino_tensorflow_lib.set_aot_bundle(bundle_dir.encode("utf-8"), export, ctypes.byref(err_msg)):
+            err_string = err_msg.value.decode("utf-8")
+            openvino_tensorflow_lib.freeErrMsg()
+            raise ValueError(err_string)
+
+    def warmup(model_fn, signatures):
+        # Each signature is a list of inputs, or a dict of named inputs, for
+        # model_fn. A tf.TensorSpec input is replaced with zeros.
+        def make_input(value):
+            if isinstance(value, tf.TensorSpec):
+                return tf.zeros(value.shape, value.dtype)
+            return value
+
+        before = {c["cluster_id"]: c for c in get_cluster_stats()["clusters"]}
+        openvino_tensorflow_lib.start_warmup()
+        try:
+            for signature in signatures:
+                if isinstance(signature, dict):
+                    model_fn(**{k: make_input(v) for k, v in signature.items()})
+                else:
+                    model_fn(*[make_input(v) for v in signature])
+        finally:
+            openvino_tensorflow_lib.finish_warmup()
+
+        # The compile time of every cluster compiled during the warm-up
+        report = []
+        for cluster in get_cluster_stats()["clusters"]:
+            previous = before.get(cluster["cluster_id"], {})
+            compiles = cluster["compiles"] - previous.get("compiles", 0)
+            if compiles > 0:
+                report.append({
+                    "cluster_id": cluster["cluster_id"],
+                    "name": cluster["name"],
+                    "compiles": compiles,
+                    "compile_time_us": cluster["compile_time_us"] -
+                                       previous.get("compile_time_us", 0)
+                })
+        return report
+
+    def get_cluster_stats():
+        stats = ctypes.c_char_p()
+        openvino_tensorflow_lib.get_cluster_stats(ctypes.byref(stats))
+        stats_string = stats.value.decode("utf-8")
+        openvino_tensorflow_lib.freeClusterStats()
+
+        return json.loads(stats_string)
+
+    def reset_cluster_stats():
+        openvino_tensorflow_lib.reset_cluster_stats()
+
+    def get_cluster_topology():
+        # The clusters of the last rewritten graphs, with the tensors
+        # crossing their borders and the bytes they move per step
+        topology = ctypes.c_char_p()
+        openvino_tensorflow_lib.get_cluster_topology(ctypes.byref(topology))
+        topology_string = topology.value.decode("utf-8")
+        openvino_tensorflow_lib.freeClusterTopology()
+
+        return json.loads(topology_string)
+
+    def clear_cluster_topology():
+        openvino_tensorflow_lib.clear_cluster_topology()
+
+    def reset_kv_cache():
+        # The next step of every decoder sets its KV-caches from the past fed
+        # to it, e.g. to start a new sequence from a precomputed prompt
+        openvino_tensorflow_lib.reset_kv_cache()
+
+    def set_memory_budget(device, megabytes):
+        # The least recently used executables of device, e.g. "GPU" or
+        # "GPU.1", are evicted to fit a new one, a budget of 0 removes it
+        if megabytes < 0:
+            raise ValueError("The memory budget must not be negative")
+        openvino_tensorflow_lib.set_memory_budget(
+            device.encode("utf-8"), int(megabytes * 1024 * 1024))
+
+    def save_cluster_profile(path=""):
+        # Merges the metrics of the clusters into the profile at path, which
+        # steers the clustering of the next runs loading it
+        err_msg = ctypes.c_char_p()
+        if not openvino_tensorflow_lib.save_cluster_profile(path.encode("utf-8"), ctypes.byref(err_msg)):
+            err_string = err_msg.value.decode("utf-8")
+            openvino_tensorflow_lib.freeErrMsg()
+            raise ValueError(err_string)
+
     __version__ = \
     "OpenVINO integration with TensorFlow version: " + str(openvino_tensorflow_lib.version()) + "\n" + \
     "OpenVINO version used for this build: " + str(openvino_tensorflow_lib.openvino_version()) + "\n" + \
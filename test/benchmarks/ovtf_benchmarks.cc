@@ -0,0 +1,471 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+// Microbenchmarks of the bridge overhead, on synthetic graphs:
+//   BM_Session*              a step of a trivial (Identity) and a tiny (Add
+//                            and Relu) cluster, on OpenVINO and on native TF
+//                            for reference; the difference is the overhead
+//                            of NGraphEncapsulateOp::Compute
+//   BM_ExecutableMiss        a step whose input shape was never seen, which
+//                            translates and compiles the cluster again
+//   BM_CompilationKey        the signature and the executable cache lookup
+//                            of a step
+//   BM_TranslateGraph        Builder::TranslateGraph, per op count
+//   BM_AssignClusters        AssignClusters and DeassignClusters, per graph
+//   BM_DeassignClusters      size
+//   BM_TransposeSinking      the TransposeSinking pass, per op count
+//   BM_MultiTower            a step of independent towers, one cluster
+//                            each, with and without async kernels, with the
+//                            inferences of the device serialized and with its
+//                            default concurrency; the difference is the
+//                            overlap of the clusters on the device
+//   BM_MatMulInt8            a step of a stack of MatMul ops in float and
+//                            with their inputs and weights quantized to 8
+//                            bits, which the low precision transformations
+//                            of OpenVINO run as int8 kernels
+//
+// Run with --benchmark_out=<file> --benchmark_out_format=json to keep the
+// results, which tools/compare.py of Google Benchmark compares between two
+// releases.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "tensorflow/cc/client/client_session.h"
+#include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "openvino/openvino.hpp"
+
+#include "openvino_tensorflow/assign_clusters.h"
+#include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/compilation_key.h"
+#include "openvino_tensorflow/deassign_clusters.h"
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/device_scheduler.h"
+#include "openvino_tensorflow/ovtf_builder.h"
+#include "openvino_tensorflow/pass/transpose_sinking.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+// A session running a single cluster on a [1, 64] float input
+class StepRunner {
+ public:
+  StepRunner(bool trivial, bool on_openvino) : m_scope(Scope::NewRootScope()) {
+    if (on_openvino) {
+      ActivateNGraph();
+    } else {
+      DeactivateNGraph();
+    }
+    m_input = ops::Placeholder(m_scope, DT_FLOAT);
+    if (trivial) {
+      m_output = ops::Identity(m_scope, m_input);
+    } else {
+      auto add = ops::Add(m_scope, m_input, ops::Const(m_scope, 1.0f));
+      m_output = ops::Relu(m_scope, add);
+    }
+    m_session.reset(new ClientSession(m_scope, GetSessionOptions()));
+  }
+
+  ~StepRunner() {
+    m_session.reset();
+    ActivateNGraph();
+  }
+
+  Status Run(const Tensor& input) {
+    return m_session->Run({{m_input, input}}, {m_output}, &m_outputs);
+  }
+
+ private:
+  Scope m_scope;
+  Output m_input;
+  Output m_output;
+  std::unique_ptr<ClientSession> m_session;
+  vector<Tensor> m_outputs;
+};
+
+static Tensor Input(int64 width) {
+  Tensor input(DT_FLOAT, TensorShape({1, width}));
+  input.flat<float>().setRandom();
+  return input;
+}
+
+static void RunSteps(benchmark::State& state, bool trivial, bool on_openvino) {
+  StepRunner runner(trivial, on_openvino);
+  Tensor input = Input(64);
+  // The first step rewrites the graph and compiles the cluster
+  Status status = runner.Run(input);
+  if (!status.ok()) {
+    state.SkipWithError(status.error_message().c_str());
+    return;
+  }
+  for (auto _ : state) {
+    status = runner.Run(input);
+    if (!status.ok()) {
+      state.SkipWithError(status.error_message().c_str());
+      break;
+    }
+  }
+}
+
+static void BM_SessionTrivialOpenVINO(benchmark::State& state) {
+  RunSteps(state, true, true);
+}
+static void BM_SessionTrivialTF(benchmark::State& state) {
+  RunSteps(state, true, false);
+}
+static void BM_SessionTinyOpenVINO(benchmark::State& state) {
+  RunSteps(state, false, true);
+}
+static void BM_SessionTinyTF(benchmark::State& state) {
+  RunSteps(state, false, false);
+}
+BENCHMARK(BM_SessionTrivialOpenVINO);
+BENCHMARK(BM_SessionTrivialTF);
+BENCHMARK(BM_SessionTinyOpenVINO);
+BENCHMARK(BM_SessionTinyTF);
+
+static void BM_ExecutableMiss(benchmark::State& state) {
+  StepRunner runner(false, true);
+  int64 width = 1;
+  for (auto _ : state) {
+    Status status = runner.Run(Input(width++));
+    if (!status.ok()) {
+      state.SkipWithError(status.error_message().c_str());
+      break;
+    }
+  }
+}
+BENCHMARK(BM_ExecutableMiss)->Unit(benchmark::kMillisecond)->Iterations(32);
+
+static void BM_CompilationKey(benchmark::State& state) {
+  const int num_inputs = state.range(0);
+  NGraphClusterManager::EvictAllClusters();
+  size_t owner =
+      NGraphClusterManager::NewCacheOwner(NGraphClusterManager::NewCluster());
+  std::shared_ptr<Executable> ng_exec;
+  for (auto _ : state) {
+    CompilationKey key;
+    for (int i = 0; i < num_inputs; i++) {
+      key.AddInput(DT_FLOAT, TensorShape({1, 224, 224, 3}));
+    }
+    benchmark::DoNotOptimize(
+        NGraphClusterManager::LookupExecutable(owner, key, ng_exec));
+  }
+  NGraphClusterManager::ReleaseCacheOwner(owner);
+  NGraphClusterManager::EvictAllClusters();
+}
+BENCHMARK(BM_CompilationKey)->Arg(1)->Arg(8)->Arg(64);
+
+// A cluster graph of num_ops ops, alternating Add and Relu
+static Status BuildClusterGraph(int num_ops, Graph* graph) {
+  Node* arg;
+  TF_RETURN_IF_ERROR(NodeBuilder("arg", "_Arg")
+                         .Attr("T", DT_FLOAT)
+                         .Attr("index", 0)
+                         .Finalize(graph, &arg));
+  Node* last = arg;
+  for (int i = 0; i < num_ops; i++) {
+    if (i % 2 == 0) {
+      TF_RETURN_IF_ERROR(NodeBuilder("add_" + to_string(i), "Add")
+                             .Input(last, 0)
+                             .Input(arg, 0)
+                             .Attr("T", DT_FLOAT)
+                             .Finalize(graph, &last));
+    } else {
+      TF_RETURN_IF_ERROR(NodeBuilder("relu_" + to_string(i), "Relu")
+                             .Input(last, 0)
+                             .Attr("T", DT_FLOAT)
+                             .Finalize(graph, &last));
+    }
+  }
+  Node* retval;
+  return NodeBuilder("retval", "_Retval")
+      .Input(last, 0)
+      .Attr("T", DT_FLOAT)
+      .Attr("index", 0)
+      .Finalize(graph, &retval);
+}
+
+static void BM_TranslateGraph(benchmark::State& state) {
+  const int num_ops = state.range(0);
+  Graph graph(OpRegistry::Global());
+  Status status = BuildClusterGraph(num_ops, &graph);
+  if (!status.ok()) {
+    state.SkipWithError(status.error_message().c_str());
+    return;
+  }
+  vector<TensorShape> inputs = {TensorShape({1, 64})};
+  vector<const Tensor*> static_input_map = {nullptr};
+  for (auto _ : state) {
+    std::shared_ptr<ov::Model> ng_function;
+    status = Builder::TranslateGraph(inputs, static_input_map, &graph,
+                                     "benchmark", ng_function);
+    if (!status.ok()) {
+      state.SkipWithError(status.error_message().c_str());
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_ops);
+}
+BENCHMARK(BM_TranslateGraph)->RangeMultiplier(10)->Range(10, 10000);
+
+// Lanes of Add ops marked for clustering, each Add also reading the previous
+// op of the next lane. One op out of 16 is not marked, which splits the
+// graph into many clusters.
+static Status BuildMarkedGraph(int num_nodes, Graph* graph) {
+  const int num_lanes = 64;
+  const int unmarked_period = 16;
+  Tensor value(DT_FLOAT, TensorShape{16});
+  value.flat<float>().setZero();
+
+  vector<Node*> lanes(num_lanes);
+  for (int i = 0; i < num_lanes; i++) {
+    TF_RETURN_IF_ERROR(NodeBuilder("const_" + to_string(i), "Const")
+                           .Attr("dtype", DT_FLOAT)
+                           .Attr("value", value)
+                           .Attr("_ovtf_marked_for_clustering", true)
+                           .Finalize(graph, &lanes[i]));
+  }
+  for (int i = num_lanes; i < num_nodes; i++) {
+    int lane = i % num_lanes;
+    Node* add;
+    TF_RETURN_IF_ERROR(
+        NodeBuilder("add_" + to_string(i), "Add")
+            .Input(lanes[lane], 0)
+            .Input(lanes[(lane + 1) % num_lanes], 0)
+            .Attr("T", DT_FLOAT)
+            .Attr("_ovtf_marked_for_clustering", i % unmarked_period != 0)
+            .Finalize(graph, &add));
+    lanes[lane] = add;
+  }
+  return Status::OK();
+}
+
+static void BM_AssignClusters(benchmark::State& state) {
+  const int num_nodes = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    NGraphClusterManager::EvictAllClusters();
+    std::unique_ptr<Graph> graph(new Graph(OpRegistry::Global()));
+    Status status = BuildMarkedGraph(num_nodes, graph.get());
+    state.ResumeTiming();
+    if (status.ok()) status = AssignClusters(graph.get());
+    if (!status.ok()) {
+      state.SkipWithError(status.error_message().c_str());
+      break;
+    }
+    state.PauseTiming();
+    graph.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * num_nodes);
+  NGraphClusterManager::EvictAllClusters();
+}
+BENCHMARK(BM_AssignClusters)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_DeassignClusters(benchmark::State& state) {
+  const int num_nodes = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    NGraphClusterManager::EvictAllClusters();
+    std::unique_ptr<Graph> graph(new Graph(OpRegistry::Global()));
+    Status status = BuildMarkedGraph(num_nodes, graph.get());
+    if (status.ok()) status = AssignClusters(graph.get());
+    state.ResumeTiming();
+    if (status.ok()) status = DeassignClusters(graph.get());
+    if (!status.ok()) {
+      state.SkipWithError(status.error_message().c_str());
+      break;
+    }
+    state.PauseTiming();
+    graph.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * num_nodes);
+  NGraphClusterManager::EvictAllClusters();
+}
+BENCHMARK(BM_DeassignClusters)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000)
+    ->Unit(benchmark::kMillisecond);
+
+// A model of num_ops elementwise ops on an NCHW input, each wrapped in a
+// pair of transposes to and from NHWC, as the translation of NHWC ops
+// produces them
+static std::shared_ptr<ov::Model> BuildTransposeModel(int num_ops) {
+  auto param = make_shared<opset::Parameter>(ov::element::f32,
+                                             ov::Shape{1, 16, 32, 32});
+  auto to_nhwc = make_shared<opset::Constant>(ov::element::i64, ov::Shape{4},
+                                              vector<int64_t>{0, 2, 3, 1});
+  auto to_nchw = make_shared<opset::Constant>(ov::element::i64, ov::Shape{4},
+                                              vector<int64_t>{0, 3, 1, 2});
+  ov::Output<ov::Node> last = param;
+  for (int i = 0; i < num_ops; i++) {
+    auto nhwc = make_shared<opset::Transpose>(last, to_nhwc);
+    auto relu = make_shared<opset::Relu>(nhwc);
+    last = make_shared<opset::Transpose>(relu, to_nchw);
+  }
+  auto result = make_shared<opset::Result>(last);
+  return make_shared<ov::Model>(ov::ResultVector{result},
+                                ov::ParameterVector{param});
+}
+
+static void BM_TransposeSinking(benchmark::State& state) {
+  const int num_ops = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto model = BuildTransposeModel(num_ops);
+    state.ResumeTiming();
+    pass::TransposeSinking().run_on_function(model);
+    state.PauseTiming();
+    model.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * num_ops);
+}
+BENCHMARK(BM_TransposeSinking)->RangeMultiplier(10)->Range(10, 1000);
+
+// A session running num_towers independent towers of MatMul and Tanh ops
+// on a shared [16, 256] float input. The input is not clustered, so every
+// tower is a cluster of its own.
+class TowersRunner {
+ public:
+  TowersRunner(int num_towers, bool async) : m_scope(Scope::NewRootScope()) {
+    ActivateNGraph();
+    // Read by the kernels when they are created
+    setenv("OPENVINO_TF_ASYNC_EXECUTION", async ? "1" : "0", true);
+    m_input = ops::Placeholder(m_scope, DT_FLOAT);
+    Tensor weights(DT_FLOAT, TensorShape({256, 256}));
+    weights.flat<float>().setRandom();
+    for (int t = 0; t < num_towers; t++) {
+      Output last = m_input;
+      for (int i = 0; i < 8; i++) {
+        last = ops::Tanh(m_scope, ops::MatMul(m_scope, last,
+                                              ops::Const(m_scope, weights)));
+      }
+      m_outputs.push_back(last);
+    }
+    m_session.reset(new ClientSession(m_scope, GetSessionOptions()));
+  }
+
+  ~TowersRunner() {
+    m_session.reset();
+    unsetenv("OPENVINO_TF_ASYNC_EXECUTION");
+  }
+
+  Status Run(const Tensor& input) {
+    return m_session->Run({{m_input, input}}, m_outputs, &m_results);
+  }
+
+ private:
+  Scope m_scope;
+  Output m_input;
+  vector<Output> m_outputs;
+  std::unique_ptr<ClientSession> m_session;
+  vector<Tensor> m_results;
+};
+
+// Arguments: the number of towers, whether the kernels are asynchronous and
+// whether the inferences of the CPU are serialized
+static void BM_MultiTower(benchmark::State& state) {
+  DeviceScheduler::Clear();
+  if (state.range(2)) DeviceScheduler::SetConcurrency("CPU", 1);
+  {
+    TowersRunner runner(state.range(0), state.range(1));
+    Tensor input(DT_FLOAT, TensorShape({16, 256}));
+    input.flat<float>().setRandom();
+    // The first step rewrites the graph and compiles the clusters
+    Status status = runner.Run(input);
+    for (auto _ : state) {
+      if (!status.ok()) break;
+      status = runner.Run(input);
+    }
+    if (!status.ok()) state.SkipWithError(status.error_message().c_str());
+  }
+  DeviceScheduler::Clear();
+}
+BENCHMARK(BM_MultiTower)
+    ->ArgNames({"towers", "async", "serialized"})
+    ->ArgsProduct({{1, 4}, {0, 1}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// A session running a stack of MatMul and Relu ops on a [64, 512] float
+// input, with the FakeQuant ops of a quantization aware trained model or in
+// float
+class MatMulRunner {
+ public:
+  MatMulRunner(bool quantized) : m_scope(Scope::NewRootScope()) {
+    ActivateNGraph();
+    m_input = ops::Placeholder(m_scope, DT_FLOAT);
+    Tensor weights(DT_FLOAT, TensorShape({512, 512}));
+    weights.flat<float>().setRandom();
+    Output last = m_input;
+    for (int i = 0; i < 8; i++) {
+      Output w = ops::Const(m_scope, weights);
+      if (quantized) {
+        auto input_range = ops::FakeQuantWithMinMaxArgs::Min(-4.0f).Max(4.0f);
+        auto weight_range =
+            ops::FakeQuantWithMinMaxArgs::Min(-1.0f).Max(1.0f).NarrowRange(
+                true);
+        last = ops::FakeQuantWithMinMaxArgs(m_scope, last, input_range);
+        w = ops::FakeQuantWithMinMaxArgs(m_scope, w, weight_range);
+      }
+      last = ops::Relu(m_scope, ops::MatMul(m_scope, last, w));
+    }
+    m_output = last;
+    m_session.reset(new ClientSession(m_scope, GetSessionOptions()));
+  }
+
+  Status Run(const Tensor& input) {
+    return m_session->Run({{m_input, input}}, {m_output}, &m_outputs);
+  }
+
+ private:
+  Scope m_scope;
+  Output m_input;
+  Output m_output;
+  std::unique_ptr<ClientSession> m_session;
+  vector<Tensor> m_outputs;
+};
+
+// Argument: whether the MatMul ops are quantized
+static void BM_MatMulInt8(benchmark::State& state) {
+  MatMulRunner runner(state.range(0));
+  Tensor input(DT_FLOAT, TensorShape({64, 512}));
+  input.flat<float>().setRandom();
+  // The first step rewrites the graph and compiles the cluster
+  Status status = runner.Run(input);
+  for (auto _ : state) {
+    if (!status.ok()) break;
+    status = runner.Run(input);
+  }
+  if (!status.ok()) state.SkipWithError(status.error_message().c_str());
+}
+BENCHMARK(BM_MatMulInt8)
+    ->ArgName("quantized")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+BENCHMARK_MAIN();
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+// Times AssignClusters on synthetic graphs of 10k, 100k and 1M nodes, or of
+// the sizes given on the command line.
+//
+// The graphs are lanes of Add ops, each Add also reading the previous op of
+// the next lane, so that the lanes are interleaved. One op out of 16 is not
+// marked for clustering, which splits the graph into many clusters and
+// leaves many edges which can not be contracted.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "openvino_tensorflow/assign_clusters.h"
+#include "openvino_tensorflow/cluster_manager.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static Status BuildSyntheticGraph(int num_nodes, Graph* graph) {
+  const int num_lanes = 64;
+  const int unmarked_period = 16;
+  Tensor value(DT_FLOAT, TensorShape{16});
+  value.flat<float>().setZero();
+
+  vector<Node*> lanes(num_lanes);
+  for (int i = 0; i < num_lanes; i++) {
+    TF_RETURN_IF_ERROR(NodeBuilder("const_" + to_string(i), "Const")
+                           .Attr("dtype", DT_FLOAT)
+                           .Attr("value", value)
+                           .Attr("_ovtf_marked_for_clustering", true)
+                           .Finalize(graph, &lanes[i]));
+  }
+  for (int i = num_lanes; i < num_nodes; i++) {
+    int lane = i % num_lanes;
+    Node* add;
+    TF_RETURN_IF_ERROR(
+        NodeBuilder("add_" + to_string(i), "Add")
+            .Input(lanes[lane], 0)
+            .Input(lanes[(lane + 1) % num_lanes], 0)
+            .Attr("T", DT_FLOAT)
+            .Attr("_ovtf_marked_for_clustering", i % unmarked_period != 0)
+            .Finalize(graph, &add));
+    lanes[lane] = add;
+  }
+  return Status::OK();
+}
+
+static int Run(const vector<int>& sizes) {
+  for (int num_nodes : sizes) {
+    Graph graph(OpRegistry::Global());
+    Status status = BuildSyntheticGraph(num_nodes, &graph);
+    if (!status.ok()) {
+      cerr << "Failed to build the graph: " << status.error_message() << endl;
+      return 1;
+    }
+    NGraphClusterManager::EvictAllClusters();
+
+    auto start = chrono::steady_clock::now();
+    status = AssignClusters(&graph);
+    auto end = chrono::steady_clock::now();
+    if (!status.ok()) {
+      cerr << "AssignClusters failed: " << status.error_message() << endl;
+      return 1;
+    }
+    cout << "AssignClusters: " << num_nodes << " nodes, "
+         << graph.num_edges() << " edges, "
+         << NGraphClusterManager::NumberOfClusters() << " clusters: "
+         << chrono::duration<double, milli>(end - start).count() << " ms"
+         << endl;
+  }
+  NGraphClusterManager::EvictAllClusters();
+  return 0;
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+int main(int argc, char** argv) {
+  std::vector<int> sizes;
+  for (int i = 1; i < argc; i++) {
+    sizes.push_back(std::atoi(argv[i]));
+  }
+  if (sizes.empty()) {
+    sizes = {10000, 100000, 1000000};
+  }
+  return tensorflow::openvino_tensorflow::testing::Run(sizes);
+}
@@ -85,6 +85,35 @@ TEST(BackendManager, GetBackendName) {
   RestoreEnv(env_map);
 }
 
+// Test the backends of the sessions configured with their own backend
+TEST(BackendManager, ScopedBackend) {
+  auto env_map = StoreEnv({"OPENVINO_TF_BACKEND"});
+  UnsetBackendUsingEnvVar();
+  ASSERT_OK(BackendManager::SetBackend("CPU"));
+  auto global_backend = BackendManager::GetBackend();
+
+  shared_ptr<Backend> backend, same_backend;
+  string device, same_device;
+  ASSERT_OK(BackendManager::GetBackend("CPU", backend, device));
+  ASSERT_EQ(device, "CPU");
+  ASSERT_NE(backend, global_backend);
+  ASSERT_OK(BackendManager::GetBackend("CPU", same_backend, same_device));
+  ASSERT_EQ(same_backend, backend);
+  ASSERT_NOT_OK(BackendManager::GetBackend("DUMMY", backend, device));
+
+  {
+    BackendManager::ScopedBackend scope(same_backend, "SESSION");
+    ASSERT_EQ(BackendManager::GetBackend(), same_backend);
+    ASSERT_OK(BackendManager::GetBackendName(device));
+    ASSERT_EQ(device, "SESSION");
+  }
+  ASSERT_EQ(BackendManager::GetBackend(), global_backend);
+  ASSERT_OK(BackendManager::GetBackendName(device));
+  ASSERT_EQ(device, "CPU");
+
+  RestoreEnv(env_map);
+}
+
 }  // namespace testing
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
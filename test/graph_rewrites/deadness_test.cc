@@ -28,6 +28,7 @@
 #include "openvino_tensorflow/assign_clusters.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
 #include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/tf_deadness_analysis.h"
 #include "test/test_utilities.h"
 
 #if !defined(OPENVINO_TF_DISABLE_DEADNESS_CHECK)
@@ -430,6 +431,46 @@ TEST(DeadnessCheck, DTestG5) {
   ASSERT_NE(A_cluster, N5_Add_cluster);
 }
 
+// The nodes with equal predicates share the interned predicate id, which
+// renders to the same string as GetNodePredicate
+TEST(DeadnessCheck, PredicateIds) {
+  Scope root = Scope::NewRootScope();
+
+  auto A = ops::Placeholder(root.WithOpName("A"), DataType::DT_FLOAT);
+  auto B = ops::Placeholder(root.WithOpName("B"), DataType::DT_FLOAT);
+  auto pred = ops::Placeholder(root.WithOpName("predS"), DataType::DT_BOOL);
+
+  auto S = ops::Switch(root.WithOpName("S"), A, pred);
+  auto P = ops::Add(root.WithOpName("P"), A, B);
+  auto T1 = ops::Sub(root.WithOpName("T1"), S.output_true, B);
+  auto T2 = ops::Mul(root.WithOpName("T2"), S.output_true, T1);
+  auto F = ops::Add(root.WithOpName("F"), S.output_false, B);
+
+  Graph graph(OpRegistry::Global());
+  TF_CHECK_OK(root.ToGraph(&graph));
+
+  std::unique_ptr<DeadnessAnalysis> deadness;
+  ASSERT_OK(DeadnessAnalysis::Run(graph, &deadness));
+
+  std::map<std::string, int> ids;
+  for (auto node : graph.op_nodes()) {
+    int pred_id;
+    ASSERT_OK(deadness->GetNodePredicateId(*node, pred_id));
+    string pred_string;
+    ASSERT_OK(deadness->GetNodePredicate(*node, pred_string));
+    ASSERT_EQ(deadness->GetPredicateString(pred_id), pred_string);
+    ids[node->name()] = pred_id;
+  }
+
+  ASSERT_EQ(ids["S"], DeadnessAnalysis::kControlFlowPredId);
+  ASSERT_EQ(ids["P"], DeadnessAnalysis::kTruePredId);
+  ASSERT_EQ(ids["T1"], ids["T2"]);
+  ASSERT_NE(ids["T1"], ids["F"]);
+  ASSERT_NE(ids["T1"], DeadnessAnalysis::kTruePredId);
+  ASSERT_TRUE(DeadnessAnalysis::IsTruePredString(
+      deadness->GetPredicateString(ids["P"])));
+}
+
 }  // namespace testing
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -4,7 +4,13 @@
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
 
 #include "logging/tf_graph_writer.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
@@ -45,6 +51,81 @@ void OpExecuter::RunTest(float rtol, float atol) {
   }
 
   Compare(tf_outputs, ngraph_outputs, rtol, atol);
+
+  // Performance mode
+  const char* iterations_char_ptr =
+      std::getenv("OPENVINO_TF_UTEST_PERF_ITERATIONS");
+  if (iterations_char_ptr == nullptr) return;
+  int iterations = std::max(1, std::atoi(iterations_char_ptr));
+  int warmup = 5;
+  const char* warmup_char_ptr = std::getenv("OPENVINO_TF_UTEST_PERF_WARMUP");
+  if (warmup_char_ptr != nullptr) {
+    warmup = std::max(0, std::atoi(warmup_char_ptr));
+  }
+  double tf_micros = MeasureLatency(false, iterations, warmup);
+  double ngraph_micros = MeasureLatency(true, iterations, warmup);
+  if (tf_micros >= 0 && ngraph_micros >= 0) {
+    ReportLatency(tf_micros, ngraph_micros);
+  }
+}
+
+double OpExecuter::MeasureLatency(bool on_ngraph, int iterations,
+                                  int warmup) {
+  if (on_ngraph) {
+    ActivateNGraph();
+  } else {
+    DeactivateNGraph();
+  }
+  // The same options on both sides, so that TF does not fold the op away
+  ClientSession session(tf_scope_, GetSessionOptions());
+  vector<Tensor> outputs;
+  vector<double> latencies;
+  Status status;
+  for (int i = 0; i < warmup + iterations && status.ok(); i++) {
+    auto start = std::chrono::steady_clock::now();
+    status = session.Run(sess_run_fetchoutputs_, &outputs);
+    auto end = std::chrono::steady_clock::now();
+    if (i >= warmup) {
+      latencies.push_back(
+          std::chrono::duration<double, std::micro>(end - start).count());
+    }
+  }
+  ActivateNGraph();
+  if (!status.ok()) {
+    ADD_FAILURE() << "Failed to time " << test_op_type_ << " on "
+                  << (on_ngraph ? "nGraph" : "TF") << ": "
+                  << status.error_message();
+    return -1;
+  }
+  std::nth_element(latencies.begin(),
+                   latencies.begin() + latencies.size() / 2, latencies.end());
+  return latencies[latencies.size() / 2];
+}
+
+void OpExecuter::ReportLatency(double tf_micros, double ngraph_micros) {
+  const auto* test_info =
+      ::testing::UnitTest::GetInstance()->current_test_info();
+  string test_name =
+      test_info == nullptr
+          ? test_op_type_
+          : string(test_info->test_case_name()) + "." + test_info->name();
+  double speedup = ngraph_micros > 0 ? tf_micros / ngraph_micros : 0;
+  std::cout << "[   PERF   ] " << test_name << " (" << test_op_type_
+            << "): TF " << std::fixed << std::setprecision(1) << tf_micros
+            << " us, OpenVINO " << ngraph_micros << " us, speedup "
+            << std::setprecision(2) << speedup << std::endl;
+
+  const char* report = std::getenv("OPENVINO_TF_UTEST_PERF_REPORT");
+  if (report == nullptr) return;
+  std::ifstream existing(report);
+  bool write_header = !existing.good() || existing.peek() == EOF;
+  existing.close();
+  std::ofstream csv(report, std::ios::app);
+  if (write_header) {
+    csv << "test,op,tf_us,openvino_us,speedup" << std::endl;
+  }
+  csv << test_name << "," << test_op_type_ << "," << tf_micros << ","
+      << ngraph_micros << "," << speedup << std::endl;
 }
 
 // Uses tf_scope to execute on TF
@@ -65,11 +65,22 @@ class OpExecuter {
   // Returns outputs
   void ExecuteOnTF(vector<Tensor>& outputs);
 
-  // Executes on NGraph backend, then executes on TF, and compares the results
+  // Executes on NGraph backend, then executes on TF, and compares the results.
+  // When OPENVINO_TF_UTEST_PERF_ITERATIONS is set, also times the op on both
+  // and reports the latencies.
   void RunTest(float rtol = static_cast<float>(1e-05),
                float atol = static_cast<float>(1e-08));
 
+  // The median latency of the fetch ops in microseconds, over iterations
+  // runs of a single session after warmup runs, on nGraph or on TF. Negative
+  // if the session fails.
+  double MeasureLatency(bool on_ngraph, int iterations, int warmup);
+
  private:
+  // Prints the latencies of the op on TF and nGraph, and appends them to the
+  // CSV file OPENVINO_TF_UTEST_PERF_REPORT if it is set
+  void ReportLatency(double tf_micros, double ngraph_micros);
+
   Scope tf_scope_;
   const string test_op_type_;
   const std::vector<Output> sess_run_fetchoutputs_;
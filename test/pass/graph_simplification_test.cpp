@@ -0,0 +1,133 @@
+/*****************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+*****************************************************************************/
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/pass/graph_simplification.h"
+
+using namespace std;
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static shared_ptr<opset::Constant> MakeIndices(const vector<int64_t>& values) {
+  return make_shared<opset::Constant>(ov::element::i64,
+                                      ov::Shape{values.size()}, values);
+}
+
+// The static dimensions of a dynamic shape are constants
+TEST(GraphSimplification, FoldStaticShapes) {
+  auto x = make_shared<opset::Parameter>(ov::element::f32,
+                                         ov::PartialShape{-1, 4, 5});
+  auto shape = make_shared<opset::ShapeOf>(x, ov::element::i64);
+  auto dims = make_shared<opset::Gather>(shape, MakeIndices({1, -1}),
+                                         MakeIndices({0}));
+  auto batch = make_shared<opset::Gather>(shape, MakeIndices({0}),
+                                          MakeIndices({0}));
+  auto y = make_shared<opset::Parameter>(ov::element::f32, ov::Shape{2, 3});
+  auto static_shape = make_shared<opset::ShapeOf>(y, ov::element::i32);
+  auto func = make_shared<ov::Model>(
+      ov::OutputVector{dims, batch, static_shape},
+      ov::ParameterVector{x, y});
+
+  pass::FoldStaticShapes pass;
+  ASSERT_TRUE(pass.run_on_function(func));
+  ASSERT_EQ(pass.GetFoldedOps(), 2);
+  auto results = func->get_results();
+  auto folded_dims = ov::as_type_ptr<opset::Constant>(
+      results[0]->get_input_node_shared_ptr(0));
+  ASSERT_TRUE(folded_dims);
+  ASSERT_EQ(folded_dims->cast_vector<int64_t>(), (vector<int64_t>{4, 5}));
+  // The batch dimension is dynamic
+  ASSERT_TRUE(ov::is_type<opset::Gather>(results[1]->get_input_node_ptr(0)));
+  auto folded_shape = ov::as_type_ptr<opset::Constant>(
+      results[2]->get_input_node_shared_ptr(0));
+  ASSERT_TRUE(folded_shape);
+  ASSERT_EQ(folded_shape->get_element_type(), ov::element::i32);
+  ASSERT_EQ(folded_shape->cast_vector<int64_t>(), (vector<int64_t>{2, 3}));
+}
+
+// Large outputs are left to the plugins
+TEST(GraphSimplification, BoundedConstantFolding) {
+  auto small = make_shared<opset::Add>(MakeIndices({1, 2}), MakeIndices({3}));
+  auto weights = make_shared<opset::Constant>(ov::element::f32,
+                                              ov::Shape{64, 64}, 1.0f);
+  auto transposed =
+      make_shared<opset::Transpose>(weights, MakeIndices({1, 0}));
+  auto func = make_shared<ov::Model>(ov::OutputVector{small, transposed},
+                                     ov::ParameterVector{});
+
+  pass::BoundedConstantFolding pass(1024);
+  ASSERT_TRUE(pass.run_on_function(func));
+  ASSERT_EQ(pass.GetFoldedOps(), 1);
+  auto results = func->get_results();
+  auto folded = ov::as_type_ptr<opset::Constant>(
+      results[0]->get_input_node_shared_ptr(0));
+  ASSERT_TRUE(folded);
+  ASSERT_EQ(folded->cast_vector<int64_t>(), (vector<int64_t>{4, 5}));
+  ASSERT_TRUE(
+      ov::is_type<opset::Transpose>(results[1]->get_input_node_ptr(0)));
+}
+
+TEST(GraphSimplification, EliminateCommonSubexpressions) {
+  auto x = make_shared<opset::Parameter>(ov::element::f32, ov::Shape{2, 3});
+  // The same constant twice, and an op repeated on it
+  auto first = make_shared<opset::Multiply>(
+      x, make_shared<opset::Constant>(ov::element::f32, ov::Shape{}, 2.0f));
+  auto second = make_shared<opset::Multiply>(
+      x, make_shared<opset::Constant>(ov::element::f32, ov::Shape{}, 2.0f));
+  // A different attribute
+  auto softmax_0 = make_shared<opset::Softmax>(first, 0);
+  auto softmax_1 = make_shared<opset::Softmax>(second, 1);
+  auto func = make_shared<ov::Model>(
+      ov::OutputVector{first, second, softmax_0, softmax_1},
+      ov::ParameterVector{x});
+
+  pass::EliminateCommonSubexpressions pass;
+  ASSERT_TRUE(pass.run_on_function(func));
+  // The constant and the Multiply
+  ASSERT_EQ(pass.GetEliminatedOps(), 2);
+  auto results = func->get_results();
+  auto product = results[0]->get_input_node_ptr(0);
+  ASSERT_EQ(results[1]->get_input_node_ptr(0), product);
+  ASSERT_EQ(softmax_0->get_input_node_ptr(0), product);
+  ASSERT_EQ(softmax_1->get_input_node_ptr(0), product);
+  ASSERT_NE(results[2]->get_input_node_ptr(0),
+            results[3]->get_input_node_ptr(0));
+}
+
+TEST(GraphSimplification, CollapseReshapes) {
+  auto x = make_shared<opset::Parameter>(ov::element::f32, ov::Shape{2, 6});
+  auto reshape = make_shared<opset::Reshape>(x, MakeIndices({2, 3, 2}), false);
+  auto unsqueeze = make_shared<opset::Unsqueeze>(reshape, MakeIndices({0}));
+  auto squeeze = make_shared<opset::Squeeze>(unsqueeze, MakeIndices({0}));
+  auto flat = make_shared<opset::Reshape>(squeeze, MakeIndices({12}), false);
+  auto back = make_shared<opset::Reshape>(flat, MakeIndices({2, 6}), false);
+  auto func = make_shared<ov::Model>(ov::OutputVector{unsqueeze, back},
+                                     ov::ParameterVector{x});
+
+  pass::CollapseReshapes pass;
+  ASSERT_TRUE(pass.run_on_function(func));
+  auto results = func->get_results();
+  // A single Reshape of x
+  auto collapsed = results[0]->get_input_node_shared_ptr(0);
+  ASSERT_TRUE(ov::is_type<opset::Reshape>(collapsed));
+  ASSERT_EQ(collapsed->get_input_node_ptr(0), x.get());
+  ASSERT_EQ(collapsed->get_output_shape(0), (ov::Shape{1, 2, 3, 2}));
+  // The chain back to the shape of x is removed
+  ASSERT_EQ(results[1]->get_input_node_ptr(0), x.get());
+  ASSERT_GE(pass.GetRemovedChains(), 1);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,113 @@
+/*****************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+*****************************************************************************/
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/manager.hpp"
+
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/pass/layout_planning.h"
+
+using namespace std;
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static shared_ptr<opset::Transpose> MakeTranspose(
+    ov::Output<ov::Node> arg, const vector<uint64_t>& order) {
+  auto ng_order = make_shared<opset::Constant>(ov::element::u64,
+                                               ov::Shape{order.size()}, order);
+  return make_shared<opset::Transpose>(arg, ng_order);
+}
+
+static size_t RunLayoutPlanning(shared_ptr<ov::Model> func) {
+  auto pass = make_shared<pass::LayoutPlanning>();
+  pass->run_on_function(func);
+  EXPECT_EQ(pass->GetTransposesAfter(),
+            pass::LayoutPlanning::CountTransposes(func));
+  return pass->GetTransposesAfter();
+}
+
+//   X1 (NCHW)  X2 (NCHW)
+//      |          |
+//  Transpose  Transpose
+//       \        /
+//     Concat (NHWC)
+//          |
+//        Relu
+//          |
+//      Transpose
+//          |
+//     Result (NCHW)
+TEST(LayoutPlanning, Branches) {
+  ov::Shape shape_nchw{1, 2, 3, 3};
+  auto x1 = make_shared<opset::Parameter>(ov::element::f32, shape_nchw);
+  auto x2 = make_shared<opset::Parameter>(ov::element::f32, shape_nchw);
+  auto concat = make_shared<opset::Concat>(
+      ov::OutputVector{MakeTranspose(x1, {0, 2, 3, 1}),
+                       MakeTranspose(x2, {0, 2, 3, 1})},
+      3);
+  auto relu = make_shared<opset::Relu>(concat);
+  auto out = MakeTranspose(relu, {0, 3, 1, 2});
+  auto func = make_shared<ov::Model>(ov::OutputVector{out},
+                                     ov::ParameterVector{x1, x2});
+  ASSERT_EQ(pass::LayoutPlanning::CountTransposes(func), 3);
+
+  ASSERT_EQ(RunLayoutPlanning(func), 0);
+  auto result = func->get_results().at(0);
+  ASSERT_EQ(result->get_shape(), (ov::Shape{1, 4, 3, 3}));
+  auto new_relu = ngraph::as_type_ptr<opset::Relu>(
+      result->get_input_node_shared_ptr(0));
+  ASSERT_TRUE(new_relu);
+  auto new_concat = ngraph::as_type_ptr<opset::Concat>(
+      new_relu->get_input_node_shared_ptr(0));
+  ASSERT_TRUE(new_concat);
+  ASSERT_EQ(new_concat->get_concatenation_axis(), 1);
+}
+
+// The Transpose of a constant input is folded
+TEST(LayoutPlanning, ConstantInput) {
+  auto x = make_shared<opset::Parameter>(ov::element::f32, ov::Shape{1, 2, 3});
+  auto bias = make_shared<opset::Constant>(ov::element::f32, ov::Shape{1, 3, 2},
+                                           vector<float>{1, 2, 3, 4, 5, 6});
+  auto add = make_shared<opset::Add>(MakeTranspose(x, {0, 2, 1}), bias);
+  auto out = MakeTranspose(add, {0, 2, 1});
+  auto func =
+      make_shared<ov::Model>(ov::OutputVector{out}, ov::ParameterVector{x});
+
+  ASSERT_EQ(RunLayoutPlanning(func), 0);
+  auto new_add = ngraph::as_type_ptr<opset::Add>(
+      func->get_results().at(0)->get_input_node_shared_ptr(0));
+  ASSERT_TRUE(new_add);
+  ASSERT_EQ(new_add->input_value(0), x->output(0));
+  auto new_bias = ngraph::as_type_ptr<opset::Constant>(
+      new_add->get_input_node_shared_ptr(1));
+  ASSERT_TRUE(new_bias);
+  ASSERT_EQ(new_bias->get_shape(), (ov::Shape{1, 2, 3}));
+  ASSERT_EQ(new_bias->cast_vector<float>(),
+            (vector<float>{1, 3, 5, 2, 4, 6}));
+}
+
+// Moving the Transpose would add as many as it removes
+TEST(LayoutPlanning, NoGain) {
+  auto x1 = make_shared<opset::Parameter>(ov::element::f32, ov::Shape{2, 3});
+  auto x2 = make_shared<opset::Parameter>(ov::element::f32, ov::Shape{2, 3});
+  auto add = make_shared<opset::Add>(x1, x2);
+  auto out = MakeTranspose(add, {1, 0});
+  auto func = make_shared<ov::Model>(ov::OutputVector{out},
+                                     ov::ParameterVector{x1, x2});
+
+  ASSERT_EQ(RunLayoutPlanning(func), 1);
+  ASSERT_EQ(func->get_results().at(0)->get_input_node_shared_ptr(0), out);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
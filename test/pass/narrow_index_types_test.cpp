@@ -0,0 +1,83 @@
+/*****************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+*****************************************************************************/
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/pass/narrow_index_types.h"
+
+using namespace std;
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static shared_ptr<opset::Constant> MakeIndices(const vector<int64_t>& values) {
+  return make_shared<opset::Constant>(ov::element::i64,
+                                      ov::Shape{values.size()}, values);
+}
+
+//      X
+//      |
+//   ShapeOf
+//      |
+//   Gather(1)
+//      |
+//  Multiply(2) --> Reshape(X) --> Result
+//      |
+//    Result
+TEST(NarrowIndexTypes, ShapeArithmetic) {
+  // The bounds of the batch dimension bound the size
+  auto x = make_shared<opset::Parameter>(
+      ov::element::f32, ov::PartialShape{ov::Dimension(1, 64), 4});
+  auto shape = make_shared<opset::ShapeOf>(x, ov::element::i64);
+  auto dim = make_shared<opset::Gather>(shape, MakeIndices({1}),
+                                        MakeIndices({0}));
+  auto size = make_shared<opset::Multiply>(dim, MakeIndices({2}));
+  auto reshape = make_shared<opset::Reshape>(
+      x, make_shared<opset::Concat>(ov::OutputVector{MakeIndices({-1}), size},
+                                    0),
+      false);
+  auto func = make_shared<ov::Model>(ov::OutputVector{reshape, size},
+                                     ov::ParameterVector{x});
+
+  pass::NarrowIndexTypes pass;
+  ASSERT_TRUE(pass.run_on_function(func));
+  ASSERT_EQ(shape->get_output_element_type(0), ov::element::i32);
+  ASSERT_EQ(size->get_output_element_type(0), ov::element::i32);
+  // The shape of the Reshape is read in i32, the result in i64
+  auto new_concat = reshape->get_input_node_shared_ptr(1);
+  ASSERT_EQ(new_concat->get_output_element_type(0), ov::element::i32);
+  auto result = func->get_results().at(1);
+  ASSERT_EQ(result->get_input_element_type(0), ov::element::i64);
+  ASSERT_TRUE(ov::is_type<opset::Convert>(result->get_input_node_ptr(0)));
+  ASSERT_EQ(pass.GetConverts(), 1);
+}
+
+// The inputs of the cluster and the products that may overflow stay i64
+TEST(NarrowIndexTypes, UnboundedValues) {
+  auto x = make_shared<opset::Parameter>(ov::element::i64, ov::Shape{1});
+  auto add = make_shared<opset::Add>(x, MakeIndices({1}));
+  auto product = make_shared<opset::Multiply>(MakeIndices({1 << 20}),
+                                              MakeIndices({1 << 12}));
+  auto func = make_shared<ov::Model>(ov::OutputVector{add, product},
+                                     ov::ParameterVector{x});
+
+  pass::NarrowIndexTypes pass;
+  pass.run_on_function(func);
+  ASSERT_EQ(pass.GetConverts(), 0);
+  ASSERT_EQ(add->get_output_element_type(0), ov::element::i64);
+  ASSERT_EQ(product->get_output_element_type(0), ov::element::i64);
+  ASSERT_EQ(product->get_input_element_type(0), ov::element::i64);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
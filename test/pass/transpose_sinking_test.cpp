@@ -69,7 +69,7 @@ TEST(TransposeSinking, PassProperty) {
 
 TEST(TransposeSinking, EdgeSplitting) {
   // checks if Transpose is pushed through opset::Abs, but stopped by
-  // ReduceSum
+  // Softmax
   ov::Shape shape_nhwc{16, 28, 28, 1};
   ov::Shape shape_nchw{16, 1, 28, 28};
 
@@ -80,11 +80,9 @@ TEST(TransposeSinking, EdgeSplitting) {
   auto absn = make_shared<opset::Abs>(transpose);
   auto absn2 = make_shared<opset::Abs>(absn);
 
-  auto axes = make_shared<opset::Constant>(ov::element::i64, ov::Shape{4},
-                                           vector<int64_t>{0, 1, 2, 3});
-  auto sum = make_shared<opset::ReduceSum>(transpose, axes, true);
+  auto softmax = make_shared<opset::Softmax>(transpose, 1);
 
-  auto func = make_shared<ov::Model>(ov::OutputVector{absn2, sum},
+  auto func = make_shared<ov::Model>(ov::OutputVector{absn2, softmax},
                                      ngraph::ParameterVector{a});
   size_t before_count = count_ops_of_type<opset::Transpose>(func);
 
@@ -95,13 +93,126 @@ TEST(TransposeSinking, EdgeSplitting) {
   ASSERT_EQ(before_count, 1);
   size_t after_count = count_ops_of_type<opset::Transpose>(func);
   ASSERT_EQ(after_count, 2);
-  ASSERT_EQ(func->get_results().at(1)->input_value(0), sum);
+  ASSERT_EQ(func->get_results().at(1)->input_value(0), softmax);
   auto new_transpose = ngraph::as_type_ptr<opset::Transpose>(
       func->get_results().at(0)->input_value(0).get_node_shared_ptr());
   ASSERT_TRUE(new_transpose);
   ASSERT_EQ(new_transpose->get_output_shape(0), shape_nchw);
 }
 
+// The number of Transposes TransposeSinking eliminates from func
+static int EliminatedTransposes(shared_ptr<ov::Model> func) {
+  int before_count = count_ops_of_type<opset::Transpose>(func);
+  ngraph::pass::Manager pass_manager;
+  pass_manager.register_pass<pass::TransposeSinking>();
+  pass_manager.run_passes(func);
+  return before_count - count_ops_of_type<opset::Transpose>(func);
+}
+
+static shared_ptr<opset::Constant> MakeAxes(vector<int64_t> axes) {
+  return make_shared<opset::Constant>(ov::element::i64,
+                                      ov::Shape{axes.size()}, axes);
+}
+
+TEST(TransposeSinking, ReduceMeanHead) {
+  // NHWC -> NCHW -> spatial mean, the mean is taken over H and W instead
+  auto a = make_shared<opset::Parameter>(ov::element::f32,
+                                         ov::Shape{2, 8, 8, 16});
+  auto transpose = make_shared<opset::Transpose>(a, MakeAxes({0, 3, 1, 2}));
+  auto mean = make_shared<opset::ReduceMean>(transpose, MakeAxes({-2, -1}));
+  auto func = make_shared<ov::Model>(ov::OutputVector{mean},
+                                     ngraph::ParameterVector{a});
+
+  ASSERT_EQ(EliminatedTransposes(func), 1);
+  ASSERT_EQ(count_ops_of_type<opset::Transpose>(func), 0);
+  ASSERT_EQ(func->get_results().at(0)->get_shape(), (ov::Shape{2, 16}));
+}
+
+TEST(TransposeSinking, ReduceKeepDims) {
+  auto a = make_shared<opset::Parameter>(ov::element::f32,
+                                         ov::Shape{2, 8, 8, 16});
+  auto transpose = make_shared<opset::Transpose>(a, MakeAxes({0, 3, 1, 2}));
+  auto sum = make_shared<opset::ReduceSum>(transpose, MakeAxes({1}), true);
+  auto transpose_back =
+      make_shared<opset::Transpose>(sum, MakeAxes({0, 2, 3, 1}));
+  auto func = make_shared<ov::Model>(ov::OutputVector{transpose_back},
+                                     ngraph::ParameterVector{a});
+
+  ASSERT_EQ(EliminatedTransposes(func), 2);
+  ASSERT_EQ(func->get_results().at(0)->get_shape(), (ov::Shape{2, 8, 8, 1}));
+}
+
+TEST(TransposeSinking, Split) {
+  auto a = make_shared<opset::Parameter>(ov::element::f32,
+                                         ov::Shape{1, 4, 4, 6});
+  auto transpose = make_shared<opset::Transpose>(a, MakeAxes({0, 3, 1, 2}));
+  auto axis = make_shared<opset::Constant>(ov::element::i64, ov::Shape{},
+                                           vector<int64_t>{1});
+  auto split = make_shared<opset::Split>(transpose, axis, 2);
+  ov::OutputVector outputs;
+  for (size_t i = 0; i < 2; i++) {
+    outputs.push_back(make_shared<opset::Transpose>(split->output(i),
+                                                    MakeAxes({0, 2, 3, 1})));
+  }
+  auto func = make_shared<ov::Model>(outputs, ngraph::ParameterVector{a});
+
+  ASSERT_EQ(EliminatedTransposes(func), 3);
+  for (const auto& result : func->get_results()) {
+    ASSERT_EQ(result->get_shape(), (ov::Shape{1, 4, 4, 3}));
+  }
+}
+
+TEST(TransposeSinking, StridedSlice) {
+  auto a = make_shared<opset::Parameter>(ov::element::f32,
+                                         ov::Shape{1, 8, 8, 6});
+  auto transpose = make_shared<opset::Transpose>(a, MakeAxes({0, 3, 1, 2}));
+  // [:, 2:4] of the NCHW tensor, the H and W dimensions being implicit
+  auto slice = make_shared<opset::StridedSlice>(
+      transpose, MakeAxes({0, 2}), MakeAxes({0, 4}), MakeAxes({1, 1}),
+      vector<int64_t>{1, 0}, vector<int64_t>{1, 0});
+  auto transpose_back =
+      make_shared<opset::Transpose>(slice, MakeAxes({0, 2, 3, 1}));
+  auto func = make_shared<ov::Model>(ov::OutputVector{transpose_back},
+                                     ngraph::ParameterVector{a});
+
+  ASSERT_EQ(EliminatedTransposes(func), 2);
+  ASSERT_EQ(func->get_results().at(0)->get_shape(), (ov::Shape{1, 8, 8, 2}));
+}
+
+TEST(TransposeSinking, SqueezeUnsqueeze) {
+  auto a = make_shared<opset::Parameter>(ov::element::f32,
+                                         ov::Shape{1, 1, 8, 16});
+  auto transpose = make_shared<opset::Transpose>(a, MakeAxes({0, 3, 1, 2}));
+  auto squeeze = make_shared<opset::Squeeze>(transpose, MakeAxes({2}));
+  auto relu = make_shared<opset::Relu>(squeeze);
+  auto unsqueeze = make_shared<opset::Unsqueeze>(relu, MakeAxes({2}));
+  auto transpose_back =
+      make_shared<opset::Transpose>(unsqueeze, MakeAxes({0, 2, 3, 1}));
+  auto func = make_shared<ov::Model>(ov::OutputVector{transpose_back},
+                                     ngraph::ParameterVector{a});
+
+  // The squeezed dimension is not restored at its position, which takes a
+  // single Transpose
+  ASSERT_EQ(EliminatedTransposes(func), 1);
+  ASSERT_EQ(func->get_results().at(0)->get_shape(), (ov::Shape{1, 1, 8, 16}));
+}
+
+TEST(TransposeSinking, MatMul) {
+  auto a = make_shared<opset::Parameter>(ov::element::f32, ov::Shape{2, 8, 4});
+  auto b = make_shared<opset::Parameter>(ov::element::f32, ov::Shape{2, 8, 3});
+  auto transpose = make_shared<opset::Transpose>(a, MakeAxes({0, 2, 1}));
+  auto matmul = make_shared<opset::MatMul>(transpose, b);
+  auto func = make_shared<ov::Model>(ov::OutputVector{matmul},
+                                     ngraph::ParameterVector{a, b});
+
+  ASSERT_EQ(EliminatedTransposes(func), 1);
+  auto new_matmul = ngraph::as_type_ptr<opset::MatMul>(
+      func->get_results().at(0)->input_value(0).get_node_shared_ptr());
+  ASSERT_TRUE(new_matmul);
+  ASSERT_TRUE(new_matmul->get_transpose_a());
+  ASSERT_EQ(new_matmul->get_output_shape(0), (ov::Shape{2, 4, 3}));
+}
+
 //            X (NHWC)
 //            |
 //         Transpose
@@ -650,6 +761,23 @@ TEST(TransposeSinking, MultiUser) {
   opexecuter.RunTest();
 }
 
+TEST(TransposeSinking, ReductionsAndSlices) {
+  Scope root = Scope::NewRootScope();
+  Tensor input(DT_FLOAT, TensorShape({2, 4, 4, 6}));
+  AssignInputValuesRandom(input);
+
+  auto input_transpose = ops::Transpose(root, input, {0, 3, 1, 2});
+  auto split = ops::Split(root, 1, input_transpose, 2);
+  auto slice = ops::StridedSlice(root, split[0], {0, 1}, {0, 3}, {1, 1},
+                                 ops::StridedSlice::BeginMask(1).EndMask(1));
+  auto mean = ops::Mean(root, slice, {2, 3}, ops::Mean::KeepDims(true));
+  auto add = ops::Add(root, slice, mean);
+  auto output_transpose = ops::Transpose(root, add, {0, 2, 3, 1});
+
+  OpExecuter opexecuter(root, "ReductionsAndSlices", {output_transpose});
+  opexecuter.RunTest();
+}
+
 }  // namespace testing
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -11,6 +11,7 @@ from __future__ import division
 from __future__ import print_function
 
 import pytest
+import numpy as np
 
 import tensorflow as tf
 tf.compat.v1.disable_eager_execution()
@@ -42,3 +43,22 @@ class TestCastOperations(NgraphTest):
         if not (self.with_ngraph(run_test) == self.without_ngraph(run_test)
                ).all():
             raise AssertionError
+
+    def test_cast_normalize_nhwc(self):
+        # The normalization of a uint8 image is folded into the
+        # preprocessing of the cluster input
+        test_input = np.random.randint(0, 256, (1, 4, 4, 3)).astype(np.uint8)
+        val = tf.compat.v1.placeholder(tf.uint8, shape=(1, 4, 4, 3))
+        mean = tf.constant([123.7, 116.3, 103.5], dtype=tf.float32)
+        out = (tf.cast(val, dtype=tf.float32) - mean) * (1 / 58.4)
+        out = tf.nn.relu(out)
+
+        def run_test(sess):
+            return sess.run(out, feed_dict={val: test_input})
+
+        if not np.allclose(
+                self.with_ngraph(run_test),
+                self.without_ngraph(run_test),
+                rtol=1e-5,
+                atol=1e-5):
+            raise AssertionError
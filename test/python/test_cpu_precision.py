@@ -0,0 +1,65 @@
+# ==============================================================================
+# Copyright (C) 2021-2022 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Openvino Tensorflow CPU_BF16 and CPU_FP16 backend accuracy test
+
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import pytest
+import numpy as np
+
+import tensorflow as tf
+tf.compat.v1.disable_eager_execution()
+from common import NgraphTest
+import openvino_tensorflow
+
+np.random.seed(5)
+
+
+class TestCPUPrecision(NgraphTest):
+
+    def build_graph(self):
+        inp = tf.compat.v1.placeholder(tf.float32, (1, 16, 16, 8), name='inp')
+        filters = tf.constant(
+            np.random.rand(3, 3, 8, 16).astype(np.float32) - 0.5)
+        weights = tf.constant(
+            np.random.rand(14 * 14 * 16, 10).astype(np.float32) - 0.5)
+        conv = tf.nn.relu(
+            tf.nn.conv2d(inp, filters, [1, 1, 1, 1], "VALID"))
+        logits = tf.matmul(tf.reshape(conv, (1, -1)), weights)
+        return inp, tf.nn.softmax(logits)
+
+    @pytest.mark.parametrize("precision", ["CPU_BF16", "CPU_FP16"])
+    def test_cpu_precision(self, precision):
+        env_var_map = self.store_env_variables(["OPENVINO_TF_BACKEND"])
+        self.unset_env_variable("OPENVINO_TF_BACKEND")
+        current_backend = openvino_tensorflow.get_backend()
+
+        inp, out = self.build_graph()
+        inp_val = np.random.rand(1, 16, 16, 8).astype(np.float32)
+
+        def run_test(sess):
+            return sess.run(out, feed_dict={inp: inp_val})
+
+        try:
+            openvino_tensorflow.set_backend('CPU')
+            fp32_val = self.with_ngraph(run_test)
+            try:
+                openvino_tensorflow.set_backend(precision)
+            except Exception:
+                pytest.skip(precision + " is not supported by this CPU")
+            low_val = self.with_ngraph(run_test)
+        finally:
+            openvino_tensorflow.set_backend(current_backend)
+            self.restore_env_variables(env_var_map)
+
+        # The TF outputs stay fp32, the inference runs in lower precision
+        if low_val.dtype != np.float32:
+            raise AssertionError
+        if not np.allclose(low_val, fp32_val, rtol=5e-2, atol=1e-2):
+            raise AssertionError
@@ -0,0 +1,90 @@
+# ==============================================================================
+# Copyright (C) 2021-2022 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Openvino Tensorflow embedding and sparse ops test
+
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import pytest
+import numpy as np
+
+import tensorflow as tf
+tf.compat.v1.disable_eager_execution()
+from common import NgraphTest
+
+np.random.seed(5)
+
+ROWS, DIM = 10, 4
+
+
+class TestEmbeddingOps(NgraphTest):
+
+    def run_and_compare(self, out, feed_dict, init=None):
+
+        def sess_fn(sess):
+            if init is not None:
+                sess.run(init)
+            return sess.run(out, feed_dict=feed_dict)
+
+        expected = self.without_ngraph(sess_fn)
+        result = self.with_ngraph(sess_fn)
+        for res, exp in zip(result, expected):
+            assert np.allclose(res, exp, rtol=1e-5, atol=1e-5)
+
+    @pytest.mark.parametrize(
+        "op", [tf.raw_ops.SparseSegmentSum, tf.raw_ops.SparseSegmentMean,
+               tf.raw_ops.SparseSegmentSqrtN])
+    def test_sparse_segment(self, op):
+        data = tf.compat.v1.placeholder(tf.float32, (ROWS, DIM))
+        # Segment 2 is empty
+        indices = tf.constant([0, 3, 3, 7, 9, 1], tf.int32)
+        segment_ids = tf.constant([0, 0, 1, 1, 3, 3], tf.int64)
+        out = op(data=data, indices=indices, segment_ids=segment_ids)
+        data_val = np.random.randn(ROWS, DIM).astype(np.float32)
+        self.run_and_compare((out,), {data: data_val})
+
+    @pytest.mark.parametrize("op", [
+        tf.raw_ops.SparseSegmentSumWithNumSegments,
+        tf.raw_ops.SparseSegmentMeanWithNumSegments,
+        tf.raw_ops.SparseSegmentSqrtNWithNumSegments
+    ])
+    def test_sparse_segment_with_num_segments(self, op):
+        data = tf.compat.v1.placeholder(tf.float32, (ROWS, DIM, 2))
+        out = op(data=data,
+                 indices=tf.constant([2, 4, 6, 8], tf.int64),
+                 segment_ids=tf.constant([0, 1, 1, 2], tf.int64),
+                 num_segments=tf.constant(5, tf.int32))
+        data_val = np.random.randn(ROWS, DIM, 2).astype(np.float32)
+        self.run_and_compare((out,), {data: data_val})
+
+    @pytest.mark.parametrize("adjoint_b", [False, True])
+    def test_sparse_tensor_dense_matmul(self, adjoint_b):
+        b = tf.compat.v1.placeholder(tf.float32,
+                                     (DIM, ROWS) if adjoint_b else (ROWS, DIM))
+        a = tf.sparse.SparseTensor(
+            indices=[[0, 1], [0, 4], [2, 0], [2, 9], [3, 3]],
+            values=tf.constant([1.0, -2.0, 0.5, 3.0, 1.5]),
+            dense_shape=[5, ROWS])
+        out = tf.sparse.sparse_dense_matmul(a, b, adjoint_b=adjoint_b)
+        b_val = np.random.randn(*b.shape).astype(np.float32)
+        self.run_and_compare((out,), {b: b_val})
+
+    # The lookup of a table held in a resource variable, runs as a gather of
+    # the variable read along with the layer it feeds
+    def test_resource_gather(self):
+        ids = tf.compat.v1.placeholder(tf.int32, (6,))
+        table = tf.compat.v1.get_variable(
+            "table",
+            initializer=np.random.randn(ROWS, DIM).astype(np.float32),
+            use_resource=True)
+        weights = tf.constant(np.random.randn(DIM, 3).astype(np.float32))
+        embeddings = tf.nn.embedding_lookup(table, ids)
+        out = tf.nn.relu(tf.matmul(embeddings, weights))
+        ids_val = np.array([0, 2, 2, 5, 9, 1], np.int32)
+        self.run_and_compare((out,), {ids: ids_val},
+                             init=tf.compat.v1.global_variables_initializer())
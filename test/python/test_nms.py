@@ -3,7 +3,7 @@
 
 # SPDX-License-Identifier: Apache-2.0
 # ==============================================================================
-"""Openvino Tensorflow NMSV2 operation test
+"""Openvino Tensorflow NMS operation tests
 
 """
 
@@ -77,3 +77,134 @@ class TestNMSOperations(NgraphTest):
         if not np.allclose(
                 self.without_ngraph(run_test), self.with_ngraph(run_test)):
             raise AssertionError
+
+    def test_NMSV3_fewer_than_max(self):
+        # The output is allocated to max_output_size boxes, and shrunk to the
+        # boxes selected by every step
+        boxes = tf.compat.v1.placeholder(tf.float32, shape=(6, 4))
+        scores = tf.compat.v1.placeholder(tf.float32, shape=(6))
+
+        boxes_np = [[0, 0, 1, 1], [0, 0.1, 1, 1.1], [0, -0.1, 1, 0.9],
+                    [0, 10, 1, 11], [0, 10.1, 1, 11.1], [0, 100, 1, 101]]
+        scores_steps = [[0.9, 0.75, 0.6, 0.95, 0.5, 0.3],
+                        [0.9, 0.75, 0.6, 0.95, 0.5, 0.1]]
+
+        nmsv3 = tf.raw_ops.NonMaxSuppressionV3(
+            boxes=boxes,
+            scores=scores,
+            max_output_size=5,
+            iou_threshold=0.5,
+            score_threshold=0.2)
+
+        def run_test(sess):
+            return [
+                sess.run(nmsv3, feed_dict={
+                    boxes: boxes_np,
+                    scores: scores_np
+                }) for scores_np in scores_steps
+            ]
+
+        expected = self.without_ngraph(run_test)
+        actual = self.with_ngraph(run_test)
+        for expected_step, actual_step in zip(expected, actual):
+            if expected_step.shape != actual_step.shape:
+                raise AssertionError
+            if not np.array_equal(expected_step, actual_step):
+                raise AssertionError
+
+    def test_NMSV4_padded(self):
+        boxes = tf.compat.v1.placeholder(tf.float32, shape=(6, 4))
+        scores = tf.compat.v1.placeholder(tf.float32, shape=(6))
+
+        boxes_np = [[0, 0, 1, 1], [0, 0.1, 1, 1.1], [0, -0.1, 1, 0.9],
+                    [0, 10, 1, 11], [0, 10.1, 1, 11.1], [0, 100, 1, 101]]
+        scores_np = [0.9, 0.75, 0.6, 0.95, 0.5, 0.3]
+
+        nmsv4 = tf.raw_ops.NonMaxSuppressionV4(
+            boxes=boxes,
+            scores=scores,
+            max_output_size=5,
+            iou_threshold=0.5,
+            score_threshold=0.2,
+            pad_to_max_output_size=True)
+
+        def run_test(sess):
+            return sess.run(
+                nmsv4, feed_dict={
+                    boxes: boxes_np,
+                    scores: scores_np
+                })
+
+        expected = self.without_ngraph(run_test)
+        actual = self.with_ngraph(run_test)
+        for expected_output, actual_output in zip(expected, actual):
+            if not np.array_equal(expected_output, actual_output):
+                raise AssertionError
+
+    def test_NMSV5(self):
+        boxes = tf.compat.v1.placeholder(tf.float32, shape=(6, 4))
+        scores = tf.compat.v1.placeholder(tf.float32, shape=(6))
+
+        boxes_np = [[0, 0, 1, 1], [0, 0.1, 1, 1.1], [0, -0.1, 1, 0.9],
+                    [0, 10, 1, 11], [0, 10.1, 1, 11.1], [0, 100, 1, 101]]
+        scores_np = [0.9, 0.75, 0.6, 0.95, 0.5, 0.3]
+
+        nmsv5 = tf.raw_ops.NonMaxSuppressionV5(
+            boxes=boxes,
+            scores=scores,
+            max_output_size=3,
+            iou_threshold=0.5,
+            score_threshold=0.0,
+            soft_nms_sigma=0.0)
+
+        def run_test(sess):
+            return sess.run(
+                nmsv5, feed_dict={
+                    boxes: boxes_np,
+                    scores: scores_np
+                })
+
+        expected = self.without_ngraph(run_test)
+        actual = self.with_ngraph(run_test)
+        for expected_output, actual_output in zip(expected, actual):
+            if not np.allclose(expected_output, actual_output):
+                raise AssertionError
+
+    def test_CombinedNMS(self):
+        # Two images with two classes, the second image has fewer
+        # detections than max_total_size
+        boxes = tf.compat.v1.placeholder(tf.float32, shape=(2, 4, 1, 4))
+        scores = tf.compat.v1.placeholder(tf.float32, shape=(2, 4, 2))
+
+        boxes_np = [[[[0, 0, 0.4, 0.4]], [[0, 0.05, 0.4, 0.45]],
+                     [[0.5, 0.5, 0.9, 0.9]], [[0.6, 0, 1, 0.4]]],
+                    [[[0, 0, 0.5, 0.5]], [[0.5, 0.5, 1, 1]],
+                     [[0, 0.5, 0.5, 1]], [[0.5, 0, 1, 0.5]]]]
+        scores_np = [[[0.9, 0.1], [0.8, 0.2], [0.3, 0.7], [0.05, 0.6]],
+                     [[0.95, 0.01], [0.02, 0.85], [0.01, 0.02],
+                      [0.03, 0.01]]]
+
+        nms = tf.raw_ops.CombinedNonMaxSuppression(
+            boxes=boxes,
+            scores=scores,
+            max_output_size_per_class=5,
+            max_total_size=5,
+            iou_threshold=0.5,
+            score_threshold=0.1,
+            pad_per_class=False,
+            clip_boxes=True)
+
+        def run_test(sess):
+            return sess.run(
+                nms, feed_dict={
+                    boxes: boxes_np,
+                    scores: scores_np
+                })
+
+        expected = self.without_ngraph(run_test)
+        actual = self.with_ngraph(run_test)
+        for expected_output, actual_output in zip(expected, actual):
+            if expected_output.shape != actual_output.shape:
+                raise AssertionError
+            if not np.allclose(expected_output, actual_output):
+                raise AssertionError
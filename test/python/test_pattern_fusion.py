@@ -0,0 +1,68 @@
+# ==============================================================================
+# Copyright (C) 2021-2022 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Openvino Tensorflow pattern fusion test
+
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import pytest
+import numpy as np
+
+import tensorflow as tf
+tf.compat.v1.disable_eager_execution()
+from common import NgraphTest
+
+np.random.seed(5)
+
+
+class TestPatternFusion(NgraphTest):
+
+    def run_fused_and_unfused(self, out, inp, inp_val):
+        env_var_map = self.store_env_variables(["OPENVINO_TF_PATTERN_FUSION"])
+        sess_fn = lambda sess: sess.run(out, feed_dict={inp: inp_val})
+        expected = self.without_ngraph(sess_fn)
+        for fusion in ("1", "0"):
+            self.set_env_variable("OPENVINO_TF_PATTERN_FUSION", fusion)
+            assert np.allclose(
+                self.with_ngraph(sess_fn), expected, rtol=1e-4, atol=1e-5)
+        self.restore_env_variables(env_var_map)
+
+    def test_gelu(self):
+        inp = tf.compat.v1.placeholder(tf.float32, (4, 16))
+        erf = inp * 0.5 * (1.0 + tf.math.erf(inp / np.sqrt(2.0)))
+        cdf = 0.5 * (1.0 + tf.tanh(
+            np.sqrt(2.0 / np.pi) * (inp + 0.044715 * tf.pow(inp, 3))))
+        out = (erf, inp * cdf)
+        inp_val = np.random.randn(4, 16).astype(np.float32)
+        self.run_fused_and_unfused(out, inp, inp_val)
+
+    def test_swish(self):
+        inp = tf.compat.v1.placeholder(tf.float32, (4, 16))
+        out = (inp * tf.sigmoid(inp), inp * tf.sigmoid(1.5 * inp))
+        inp_val = np.random.randn(4, 16).astype(np.float32)
+        self.run_fused_and_unfused(out, inp, inp_val)
+
+    def test_layer_norm(self):
+        inp = tf.compat.v1.placeholder(tf.float32, (2, 8, 32))
+        gamma = tf.constant(np.random.rand(32).astype(np.float32))
+        beta = tf.constant(np.random.rand(32).astype(np.float32))
+        mean, var = tf.nn.moments(inp, axes=[-1], keepdims=True)
+        normalized = tf.nn.batch_normalization(inp, mean, var, beta, gamma,
+                                               1e-6)
+        explicit = (inp - mean) * tf.math.rsqrt(var + 1e-5)
+        out = (normalized, explicit)
+        inp_val = np.random.randn(2, 8, 32).astype(np.float32)
+        self.run_fused_and_unfused(out, inp, inp_val)
+
+    def test_matmul_bias(self):
+        inp = tf.compat.v1.placeholder(tf.float32, (4, 16))
+        weights = tf.constant(np.random.rand(16, 8).astype(np.float32))
+        bias = tf.constant(np.random.rand(8).astype(np.float32))
+        out = tf.nn.relu(tf.nn.bias_add(tf.matmul(inp, weights), bias))
+        inp_val = np.random.randn(4, 16).astype(np.float32)
+        self.run_fused_and_unfused(out, inp, inp_val)
@@ -0,0 +1,96 @@
+# ==============================================================================
+# Copyright (C) 2021-2022 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Openvino Tensorflow quantization ops test
+
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import pytest
+import numpy as np
+
+import tensorflow as tf
+tf.compat.v1.disable_eager_execution()
+from common import NgraphTest
+
+np.random.seed(5)
+
+
+class TestQuantization(NgraphTest):
+
+    def run_and_compare(self, out, inp, inp_val, atol=1e-5):
+        sess_fn = lambda sess: sess.run(out, feed_dict={inp: inp_val})
+        expected = self.without_ngraph(sess_fn)
+        result = self.with_ngraph(sess_fn)
+        for res, exp in zip(result, expected):
+            assert np.allclose(res, exp, rtol=1e-4, atol=atol)
+
+    @pytest.mark.parametrize("per_channel", [False, True])
+    def test_fake_quant(self, per_channel):
+        x = tf.compat.v1.placeholder(tf.float32, (2, 5, 5, 3))
+        if per_channel:
+            out = tf.raw_ops.FakeQuantWithMinMaxVarsPerChannel(
+                inputs=x,
+                min=tf.constant([-1.0, -2.0, -0.5]),
+                max=tf.constant([1.0, 0.5, 2.0]),
+                num_bits=8)
+        else:
+            out = tf.raw_ops.FakeQuantWithMinMaxArgs(
+                inputs=x, min=-1.5, max=2.0, num_bits=8, narrow_range=True)
+        x_val = np.random.randn(2, 5, 5, 3).astype(np.float32)
+        self.run_and_compare((out,), x, x_val)
+
+    @pytest.mark.parametrize(("signed_input", "range_given", "axis"),
+                             [(True, True, -1), (False, True, -1),
+                              (True, False, -1), (True, False, 1)])
+    def test_quantize_and_dequantize(self, signed_input, range_given, axis):
+        x = tf.compat.v1.placeholder(tf.float32, (4, 3))
+        shape = (3,) if axis == 1 else ()
+        out = tf.raw_ops.QuantizeAndDequantizeV2(
+            input=x,
+            input_min=tf.constant(np.full(shape, -2.0, np.float32)),
+            input_max=tf.constant(np.full(shape, 1.5, np.float32)),
+            signed_input=signed_input,
+            num_bits=8,
+            range_given=range_given,
+            axis=axis)
+        x_val = np.random.randn(4, 3).astype(np.float32)
+        self.run_and_compare((out,), x, x_val)
+
+    # A quantization followed by its dequantization runs as a FakeQuantize
+    @pytest.mark.parametrize(("mode", "T"), [("MIN_COMBINED", tf.quint8),
+                                             ("SCALED", tf.qint8)])
+    def test_quantize_dequantize(self, mode, T):
+        x = tf.compat.v1.placeholder(tf.float32, (4, 6))
+        quantized = tf.raw_ops.QuantizeV2(
+            input=x,
+            min_range=tf.constant(-1.0),
+            max_range=tf.constant(2.0),
+            T=T,
+            mode=mode)
+        out = tf.raw_ops.Dequantize(
+            input=quantized.output,
+            min_range=quantized.output_min,
+            max_range=quantized.output_max,
+            mode=mode)
+        x_val = np.random.randn(4, 6).astype(np.float32)
+        self.run_and_compare((out, quantized.output_min, quantized.output_max),
+                             x, x_val)
+
+    # The int8 weights of a MatMul, dequantized on OpenVINO
+    @pytest.mark.parametrize("mode", ["MIN_COMBINED", "SCALED"])
+    def test_int8_weights(self, mode):
+        x = tf.compat.v1.placeholder(tf.float32, (2, 16))
+        weights = np.random.randint(-128, 128, (16, 8)).astype(np.int8)
+        dequantized = tf.raw_ops.Dequantize(
+            input=tf.constant(weights, tf.qint8),
+            min_range=tf.constant(-0.5),
+            max_range=tf.constant(0.5),
+            mode=mode)
+        out = tf.matmul(x, dequantized)
+        x_val = np.random.randn(2, 16).astype(np.float32)
+        self.run_and_compare((out,), x, x_val, atol=1e-4)
@@ -0,0 +1,110 @@
+# ==============================================================================
+# Copyright (C) 2021-2022 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Openvino Tensorflow fused LSTM and GRU ops test
+
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import pytest
+import numpy as np
+
+import tensorflow as tf
+tf.compat.v1.disable_eager_execution()
+from common import NgraphTest
+
+np.random.seed(5)
+
+TIME, BATCH, INPUT, CELL = 6, 2, 3, 4
+
+
+def const(*shape):
+    return tf.constant(np.random.randn(*shape).astype(np.float32) * 0.5)
+
+
+class TestRNNOps(NgraphTest):
+
+    def run_and_compare(self, out, inp, inp_val):
+        sess_fn = lambda sess: sess.run(out, feed_dict={inp: inp_val})
+        expected = self.without_ngraph(sess_fn)
+        result = self.with_ngraph(sess_fn)
+        for res, exp in zip(result, expected):
+            assert np.allclose(res, exp, rtol=1e-4, atol=1e-5)
+
+    def lstm_inputs(self):
+        return dict(
+            cs_prev=const(BATCH, CELL),
+            h_prev=const(BATCH, CELL),
+            w=const(INPUT + CELL, 4 * CELL),
+            wci=const(CELL),
+            wcf=const(CELL),
+            wco=const(CELL),
+            b=const(4 * CELL))
+
+    # Only h is read, which runs as an LSTMSequence
+    @pytest.mark.parametrize("v2", [False, True])
+    def test_block_lstm_sequence(self, v2):
+        x = tf.compat.v1.placeholder(tf.float32, (TIME, BATCH, INPUT))
+        seq_len_max = tf.constant(TIME - 2, tf.int64)
+        if v2:
+            outputs = tf.raw_ops.BlockLSTMV2(
+                seq_len_max=seq_len_max,
+                x=x,
+                **self.lstm_inputs(),
+                cell_clip=0.0,
+                use_peephole=False)
+        else:
+            outputs = tf.raw_ops.BlockLSTM(
+                seq_len_max=seq_len_max,
+                x=x,
+                **self.lstm_inputs(),
+                forget_bias=1.0,
+                cell_clip=-1.0,
+                use_peephole=False)
+        x_val = np.random.randn(TIME, BATCH, INPUT).astype(np.float32)
+        self.run_and_compare((outputs.h,), x, x_val)
+
+    # Peepholes, a clipped cell state and the gates read run as a
+    # TensorIterator
+    def test_block_lstm_gates(self):
+        x = tf.compat.v1.placeholder(tf.float32, (TIME, BATCH, INPUT))
+        outputs = tf.raw_ops.BlockLSTM(
+            seq_len_max=tf.constant(TIME - 1, tf.int64),
+            x=x,
+            **self.lstm_inputs(),
+            forget_bias=1.0,
+            cell_clip=0.5,
+            use_peephole=True)
+        x_val = np.random.randn(TIME, BATCH, INPUT).astype(np.float32)
+        self.run_and_compare(tuple(outputs), x, x_val)
+
+    @pytest.mark.parametrize("use_peephole", [False, True])
+    def test_lstm_block_cell(self, use_peephole):
+        x = tf.compat.v1.placeholder(tf.float32, (BATCH, INPUT))
+        outputs = tf.raw_ops.LSTMBlockCell(
+            x=x,
+            **self.lstm_inputs(),
+            forget_bias=1.0,
+            cell_clip=-1.0,
+            use_peephole=use_peephole)
+        x_val = np.random.randn(BATCH, INPUT).astype(np.float32)
+        self.run_and_compare((outputs.cs, outputs.h), x, x_val)
+        self.run_and_compare(tuple(outputs), x, x_val)
+
+    def test_gru_block_cell(self):
+        x = tf.compat.v1.placeholder(tf.float32, (BATCH, INPUT))
+        outputs = tf.raw_ops.GRUBlockCell(
+            x=x,
+            h_prev=const(BATCH, CELL),
+            w_ru=const(INPUT + CELL, 2 * CELL),
+            w_c=const(INPUT + CELL, CELL),
+            b_ru=const(2 * CELL),
+            b_c=const(CELL))
+        x_val = np.random.randn(BATCH, INPUT).astype(np.float32)
+        # Only h is read, which runs as a GRUCell
+        self.run_and_compare((outputs.h,), x, x_val)
+        self.run_and_compare(tuple(outputs), x, x_val)
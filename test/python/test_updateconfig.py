@@ -47,3 +47,18 @@ class TestUpdateConfig(NgraphTest):
         if not count_ng_optimizers(config) == count_ng_optimizers(
                 config_new_1) == count_ng_optimizers(config_new_2) == 1:
             raise AssertionError
+
+    @pytest.mark.skipif(
+        not openvino_tensorflow.is_grappler_enabled(),
+        reason='Only for Grappler')
+    def test_update_config_sets_backend(self):
+        config = openvino_tensorflow.update_config(
+            tf.compat.v1.ConfigProto(), backend_name="CPU")
+        custom_opts = config.graph_options.rewrite_options.custom_optimizers
+        if not custom_opts[0].parameter_map["backend"].s == b'CPU':
+            raise AssertionError
+        # Without a backend the session follows set_backend
+        config = openvino_tensorflow.update_config(tf.compat.v1.ConfigProto())
+        custom_opts = config.graph_options.rewrite_options.custom_optimizers
+        if "backend" in custom_opts[0].parameter_map:
+            raise AssertionError
@@ -0,0 +1,58 @@
+# ==============================================================================
+# Copyright (C) 2021-2022 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Openvino Tensorflow warm-up compilation test
+
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import pytest
+import numpy as np
+
+import tensorflow as tf
+tf.compat.v1.disable_eager_execution()
+from common import NgraphTest
+import openvino_tensorflow
+
+np.random.seed(5)
+
+
+class TestWarmup(NgraphTest):
+
+    def test_warmup(self):
+        env_var_map = self.store_env_variables(
+            ["OPENVINO_TF_MIN_NONTRIVIAL_NODES"])
+        self.set_env_variable("OPENVINO_TF_MIN_NONTRIVIAL_NODES", "1")
+
+        inp = tf.compat.v1.placeholder(tf.float32, (None, 8), name='inp')
+        weights = tf.constant(np.random.rand(8, 4).astype(np.float32))
+        out = tf.nn.softmax(tf.nn.relu(tf.matmul(inp, weights)))
+        inp_vals = [
+            np.random.rand(batch, 8).astype(np.float32) for batch in (1, 4)
+        ]
+
+        def run_test(sess):
+            report = openvino_tensorflow.warmup(
+                lambda x: sess.run(out, feed_dict={inp: x}),
+                [[val] for val in inp_vals])
+            # Every signature was compiled before serving
+            compiles = sum(cluster["compiles"] for cluster in report)
+            if compiles < len(inp_vals):
+                raise AssertionError
+            if any(cluster["compile_time_us"] <= 0 for cluster in report):
+                raise AssertionError
+            return [sess.run(out, feed_dict={inp: x}) for x in inp_vals]
+
+        try:
+            ovtf_vals = self.with_ngraph(run_test)
+        finally:
+            self.restore_env_variables(env_var_map)
+        tf_vals = self.without_ngraph(
+            lambda sess: [sess.run(out, feed_dict={inp: x}) for x in inp_vals])
+        for ovtf_val, tf_val in zip(ovtf_vals, tf_vals):
+            if not np.allclose(ovtf_val, tf_val, rtol=1e-4, atol=1e-5):
+                raise AssertionError
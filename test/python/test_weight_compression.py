@@ -0,0 +1,61 @@
+# ==============================================================================
+# Copyright (C) 2021-2022 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Openvino Tensorflow FP16 and INT8 weight compression accuracy test
+
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import pytest
+import numpy as np
+
+import tensorflow as tf
+tf.compat.v1.disable_eager_execution()
+from common import NgraphTest
+
+np.random.seed(5)
+
+
+class TestWeightCompression(NgraphTest):
+
+    def build_graph(self):
+        inp = tf.compat.v1.placeholder(tf.float32, (1, 16, 16, 8), name='inp')
+        filters = tf.constant(
+            np.random.rand(3, 3, 8, 16).astype(np.float32) - 0.5)
+        weights = tf.constant(
+            np.random.rand(14 * 14 * 16, 10).astype(np.float32) - 0.5)
+        conv = tf.nn.relu(
+            tf.nn.conv2d(inp, filters, [1, 1, 1, 1], "VALID"))
+        logits = tf.matmul(tf.reshape(conv, (1, -1)), weights)
+        return inp, tf.nn.softmax(logits)
+
+    @pytest.mark.parametrize("mode", ["FP16", "INT8"])
+    def test_weight_compression(self, mode):
+        env_var_map = self.store_env_variables([
+            "OPENVINO_TF_WEIGHT_COMPRESSION",
+            "OPENVINO_TF_WEIGHT_COMPRESSION_MIN_KB"
+        ])
+        inp, out = self.build_graph()
+        inp_val = np.random.rand(1, 16, 16, 8).astype(np.float32)
+
+        def run_test(sess):
+            return sess.run(out, feed_dict={inp: inp_val})
+
+        try:
+            # Both the filters and the weights are compressed
+            self.set_env_variable("OPENVINO_TF_WEIGHT_COMPRESSION", mode)
+            self.set_env_variable("OPENVINO_TF_WEIGHT_COMPRESSION_MIN_KB", "1")
+            compressed_val = self.with_ngraph(run_test)
+        finally:
+            self.restore_env_variables(env_var_map)
+
+        if not np.allclose(
+                compressed_val,
+                self.without_ngraph(run_test),
+                rtol=5e-2,
+                atol=1e-2):
+            raise AssertionError
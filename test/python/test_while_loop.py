@@ -3,7 +3,7 @@
 
 # SPDX-License-Identifier: Apache-2.0
 # ==============================================================================
-"""Openvino Tensorflow log operation test
+"""Openvino Tensorflow while loop and conditional test
 
 """
 from __future__ import absolute_import
@@ -36,3 +36,47 @@ class TestWhileLoop(NgraphTest):
             result = self.with_ngraph(sess_fn)
             if not result[0] == [10]:
                 raise AssertionError
+
+    def test_functional_while_loop(self):
+        # A decoding style loop, with a loop variable growing every iteration
+        tf.compat.v1.enable_control_flow_v2()
+        inp = tf.compat.v1.placeholder(tf.float32, (1, 4))
+        weights = tf.constant(np.random.rand(4, 4).astype(np.float32))
+
+        def body(i, state, history):
+            state = tf.tanh(tf.matmul(state, weights))
+            return i + 1, state, tf.concat([history, state], axis=0)
+
+        _, state, history = tf.while_loop(
+            lambda i, state, history: i < 5,
+            body, [tf.constant(0), inp, inp],
+            shape_invariants=[
+                tf.TensorShape([]),
+                tf.TensorShape([1, 4]),
+                tf.TensorShape([None, 4])
+            ])
+        inp_val = np.random.rand(1, 4).astype(np.float32)
+        sess_fn = lambda sess: sess.run((state, history),
+                                        feed_dict={inp: inp_val})
+        expected = self.without_ngraph(sess_fn)
+        result = self.with_ngraph(sess_fn)
+        tf.compat.v1.disable_control_flow_v2()
+        for res, exp in zip(result, expected):
+            assert np.allclose(res, exp, rtol=1e-4, atol=1e-5)
+
+    def test_functional_cond(self):
+        tf.compat.v1.enable_control_flow_v2()
+        inp = tf.compat.v1.placeholder(tf.float32, (2, 3))
+        pred = tf.compat.v1.placeholder(tf.bool, ())
+        out = tf.cond(pred, lambda: tf.nn.relu(inp) * 2.0,
+                      lambda: tf.abs(inp) - 1.0)
+        inp_val = np.random.randn(2, 3).astype(np.float32)
+        for pred_val in (True, False):
+            sess_fn = lambda sess: sess.run(
+                out, feed_dict={
+                    inp: inp_val,
+                    pred: pred_val
+                })
+            assert np.allclose(
+                self.with_ngraph(sess_fn), self.without_ngraph(sess_fn))
+        tf.compat.v1.disable_control_flow_v2()
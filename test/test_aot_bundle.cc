@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+
+#include "openvino_tensorflow/aot_bundle.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static GraphDef MakeGraph(const string& op) {
+  GraphDef graph;
+  NodeDef* arg = graph.add_node();
+  arg->set_name("arg");
+  arg->set_op("_Arg");
+  (*arg->mutable_attr())["index"].set_i(0);
+  NodeDef* node = graph.add_node();
+  node->set_name("node");
+  node->set_op(op);
+  node->add_input("arg");
+  return graph;
+}
+
+TEST(AOTBundle, GraphFingerprint) {
+  GraphDef graph = MakeGraph("Relu");
+  uint64 fingerprint = AOTBundle::FingerprintGraph(graph);
+  ASSERT_EQ(fingerprint, AOTBundle::FingerprintGraph(MakeGraph("Relu")));
+  ASSERT_NE(fingerprint, AOTBundle::FingerprintGraph(MakeGraph("Tanh")));
+
+  // The cluster index and the devices do not change the fingerprint
+  GraphDef clustered = MakeGraph("Relu");
+  for (auto& node : *clustered.mutable_node()) {
+    (*node.mutable_attr())["_ovtf_cluster"].set_i(7);
+    node.set_device("/job:localhost/replica:0/task:0/device:CPU:0");
+  }
+  ASSERT_EQ(fingerprint, AOTBundle::FingerprintGraph(clustered));
+
+  // Any other attribute does
+  GraphDef attributed = MakeGraph("Relu");
+  (*attributed.mutable_node(1)->mutable_attr())["T"].set_type(DT_FLOAT);
+  ASSERT_NE(fingerprint, AOTBundle::FingerprintGraph(attributed));
+}
+
+TEST(AOTBundle, EntryName) {
+  CompilationKey k1, k2;
+  k1.AddInput(DT_FLOAT, TensorShape({1, 3}));
+  k2.AddInput(DT_FLOAT, TensorShape({8, 3}));
+  string entry = AOTBundle::EntryName(42, k1, "CPU", {}, "");
+
+  ASSERT_EQ(entry, AOTBundle::EntryName(42, k1, "CPU", {}, ""));
+  ASSERT_NE(entry, AOTBundle::EntryName(43, k1, "CPU", {}, ""));
+  ASSERT_NE(entry, AOTBundle::EntryName(42, k2, "CPU", {}, ""));
+  ASSERT_NE(entry, AOTBundle::EntryName(42, k1, "GPU", {}, ""));
+  ASSERT_NE(entry, AOTBundle::EntryName(
+                       42, k1, "CPU", {{"PERFORMANCE_HINT", "LATENCY"}}, ""));
+  ASSERT_NE(entry,
+            AOTBundle::EntryName(42, k1, "CPU", {}, "dynamic_shapes=1"));
+  ASSERT_EQ(entry.substr(0, 3), "2a-");
+}
+
+TEST(AOTBundle, Configure) {
+  ASSERT_FALSE(AOTBundle::Configure("/path/does/not/exist", false).ok());
+
+  ASSERT_TRUE(AOTBundle::Configure("/tmp", true).ok());
+  ASSERT_EQ(AOTBundle::GetMode(), AOTBundle::Mode::kExport);
+  // Only a bundle being loaded is looked up
+  ASSERT_EQ(AOTBundle::FindEntry("missing.blob"), "");
+
+  ASSERT_TRUE(AOTBundle::Configure("/tmp", false).ok());
+  ASSERT_EQ(AOTBundle::GetMode(), AOTBundle::Mode::kLoad);
+  ASSERT_EQ(AOTBundle::FindEntry("missing.blob"), "");
+
+  ASSERT_TRUE(AOTBundle::Configure("", false).ok());
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,35 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/backend.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+TEST(Backend, AvailableDevices) {
+  // The devices of a plugin are found without listing the others
+  auto cpus = Backend::GetAvailableDevices("CPU");
+  ASSERT_EQ(cpus, vector<string>{"CPU"});
+  ASSERT_TRUE(Backend::GetAvailableDevices("NO_SUCH_DEVICE").empty());
+  ASSERT_THROW(Backend("NO_SUCH_DEVICE"), std::runtime_error);
+
+  // Named as in the list of all the devices
+  auto all = Backend::GetAllAvailableDevices();
+  ASSERT_NE(find(all.begin(), all.end(), "CPU"), all.end());
+  for (const auto& gpu : Backend::GetAvailableDevices("GPU")) {
+    ASSERT_NE(find(all.begin(), all.end(), gpu), all.end()) << gpu;
+  }
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
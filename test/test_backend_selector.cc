@@ -0,0 +1,58 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/backend_selector.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+using Path = BackendSelector::Path;
+
+TEST(BackendSelector, PicksFasterPath) {
+  BackendSelector selector(2, 5);
+  bool timed;
+  // One warm-up and two timed steps on each path
+  for (int i = 0; i < 6; i++) {
+    ASSERT_TRUE(selector.IsTrialing());
+    Path path = selector.Next(timed);
+    ASSERT_EQ(timed, i >= 2);
+    if (timed) selector.Record(path, path == Path::kTF ? 10 : 100);
+  }
+  ASSERT_FALSE(selector.IsTrialing());
+  ASSERT_EQ(selector.Preferred(), Path::kTF);
+
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(selector.Next(timed), Path::kTF);
+    ASSERT_FALSE(timed);
+  }
+
+  // The re-evaluation times both paths again, without warm-up
+  selector.Next(timed);
+  ASSERT_TRUE(selector.IsTrialing());
+  ASSERT_TRUE(timed);
+}
+
+TEST(BackendSelector, NeverReevaluates) {
+  BackendSelector selector(1, 0);
+  bool timed;
+  for (int i = 0; i < 4; i++) {
+    Path path = selector.Next(timed);
+    if (timed) selector.Record(path, path == Path::kTF ? 100 : 10);
+  }
+  ASSERT_EQ(selector.Preferred(), Path::kOpenVINO);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(selector.Next(timed), Path::kOpenVINO);
+  }
+  ASSERT_FALSE(selector.IsTrialing());
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
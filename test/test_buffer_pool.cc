@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/buffer_pool.h"
+#include "openvino_tensorflow/ie_tensor.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+TEST(BufferPool, SizeClasses) {
+  ASSERT_EQ(BufferPool::SizeClass(100), 0);
+  ASSERT_EQ(BufferPool::SizeClass(4096), 4096);
+  ASSERT_EQ(BufferPool::SizeClass(4097), 8192);
+  ASSERT_EQ(BufferPool::SizeClass(1000000), 1 << 20);
+}
+
+TEST(BufferPool, ReusesReleasedBuffers) {
+  BufferPool::Clear();
+  auto allocator = BufferPool::GetAllocator("CPU");
+  void* data = nullptr;
+  {
+    IETensor tensor(ov::element::f32, ov::Shape{64, 64}, allocator);
+    data = tensor.data();
+    ASSERT_TRUE(tensor.owns_memory());
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(data) % 64, 0);
+  }
+  ASSERT_EQ(BufferPool::GetStats().pooled_bytes, 64 * 64 * 4);
+
+  // A tensor of the same size class gets the released buffer
+  {
+    IETensor tensor(ov::element::u8, ov::Shape{10000}, allocator);
+    ASSERT_EQ(tensor.data(), data);
+    ASSERT_EQ(BufferPool::GetStats().pooled_bytes, 0);
+  }
+  auto stats = BufferPool::GetStats();
+  ASSERT_EQ(stats.hits, 1);
+  ASSERT_EQ(stats.misses, 1);
+
+  // The buffers of another device are not shared
+  {
+    IETensor tensor(ov::element::f32, ov::Shape{64, 64},
+                    BufferPool::GetAllocator("GPU"));
+    ASSERT_NE(tensor.data(), data);
+  }
+  ASSERT_EQ(BufferPool::GetStats().misses, 2);
+  BufferPool::Clear();
+}
+
+TEST(BufferPool, SmallTensorsAreNotPooled) {
+  BufferPool::Clear();
+  {
+    IETensor tensor(ov::element::f32, ov::Shape{4},
+                    BufferPool::GetAllocator("CPU"));
+  }
+  auto stats = BufferPool::GetStats();
+  ASSERT_EQ(stats.hits + stats.misses, 0);
+  ASSERT_EQ(stats.pooled_bytes, 0);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/core/graph/graph.h"
+
+#include "openvino_tensorflow/cluster_cost.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+// The nodes of graph other than the placeholders and the source and sink
+static set<Node*> ClusterNodes(Graph& graph) {
+  set<Node*> nodes;
+  for (auto node : graph.op_nodes()) {
+    if (node->type_string() != "Placeholder") nodes.insert(node);
+  }
+  return nodes;
+}
+
+TEST(ClusterCost, LargeMatMulWins) {
+  Scope root = Scope::NewRootScope();
+  auto a = ops::Placeholder(root, DT_FLOAT,
+                            ops::Placeholder::Shape({256, 512}));
+  auto b = ops::Placeholder(root, DT_FLOAT,
+                            ops::Placeholder::Shape({512, 128}));
+  auto matmul = ops::MatMul(root, a, b);
+  Graph graph(OpRegistry::Global());
+  ASSERT_OK(root.ToGraph(&graph));
+
+  ClusterCostModel model(&graph, "CPU");
+  ASSERT_EQ(model.NodeFlops(matmul.node()), 2.0 * 256 * 512 * 128);
+  ClusterCost cost = model.Estimate(ClusterNodes(graph));
+  ASSERT_EQ(cost.num_ops, 1);
+  // The two inputs and the output
+  ASSERT_EQ(cost.num_boundary_tensors, 3);
+  ASSERT_EQ(cost.boundary_bytes, 4.0 * (256 * 512 + 512 * 128 + 256 * 128));
+  ASSERT_TRUE(cost.Wins());
+}
+
+TEST(ClusterCost, TinyElementwiseLoses) {
+  // Many tiny ops, each fed from outside the cluster
+  Scope root = Scope::NewRootScope();
+  Output sum = ops::Placeholder(root, DT_FLOAT, ops::Placeholder::Shape({4}));
+  for (int i = 0; i < 40; i++) {
+    auto input =
+        ops::Placeholder(root, DT_FLOAT, ops::Placeholder::Shape({4}));
+    sum = ops::Add(root, sum, input);
+  }
+  Graph graph(OpRegistry::Global());
+  ASSERT_OK(root.ToGraph(&graph));
+
+  ClusterCostModel model(&graph, "CPU");
+  ClusterCost cost = model.Estimate(ClusterNodes(graph));
+  ASSERT_EQ(cost.num_ops, 40);
+  ASSERT_EQ(cost.flops, 40 * 4);
+  ASSERT_FALSE(cost.Wins());
+}
+
+TEST(ClusterCost, ConvolutionFlops) {
+  Scope root = Scope::NewRootScope();
+  auto input = ops::Placeholder(root, DT_FLOAT,
+                                ops::Placeholder::Shape({1, 32, 32, 8}));
+  auto filter = ops::Placeholder(root, DT_FLOAT,
+                                 ops::Placeholder::Shape({3, 3, 8, 16}));
+  auto conv = ops::Conv2D(root, input, filter, {1, 1, 1, 1}, "SAME");
+  Graph graph(OpRegistry::Global());
+  ASSERT_OK(root.ToGraph(&graph));
+
+  ClusterCostModel model(&graph, "CPU");
+  ASSERT_EQ(model.NodeFlops(conv.node()), 2.0 * 32 * 32 * 16 * 3 * 3 * 8);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/cluster_placement.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+TEST(ClusterPlacement, ParseRules) {
+  ClusterPlacement::Rules rules;
+  ASSERT_TRUE(
+      ClusterPlacement::ParseRules("TopKV2:CPU,,GatherV2:CPU", rules).ok());
+  ASSERT_EQ(rules.size(), 2);
+  ASSERT_EQ(rules[0].first, "TopKV2");
+  ASSERT_EQ(rules[0].second, "CPU");
+
+  ASSERT_FALSE(ClusterPlacement::ParseRules("TopKV2", rules).ok());
+  ASSERT_FALSE(ClusterPlacement::ParseRules(":CPU", rules).ok());
+  ASSERT_FALSE(ClusterPlacement::ParseRules("TopKV2:VAD-M", rules).ok());
+}
+
+TEST(ClusterPlacement, RulesVoteByMatches) {
+  ClusterPlacement::Rules rules{{"TopKV2", "CPU"},
+                                {"Conv2D", "GPU"},
+                                {"GatherV2", "CPU"}};
+  ASSERT_EQ(ClusterPlacement::ChooseDevice({"Conv2D", "TopKV2", "GatherV2"},
+                                           "GPU", rules, false),
+            "CPU");
+  // The device of the backend is reported as empty
+  ASSERT_EQ(ClusterPlacement::ChooseDevice({"Conv2D", "Conv2D", "TopKV2"},
+                                           "GPU", rules, false),
+            "");
+  // Ties go to the device of the first rule
+  ASSERT_EQ(ClusterPlacement::ChooseDevice({"Conv2D", "TopKV2"}, "MYRIAD",
+                                           rules, false),
+            "CPU");
+  ASSERT_EQ(
+      ClusterPlacement::ChooseDevice({"Conv2D"}, "MYRIAD", rules, false),
+      "GPU");
+  ASSERT_EQ(
+      ClusterPlacement::ChooseDevice({"Add", "Relu"}, "GPU", rules, false), "");
+  ASSERT_EQ(ClusterPlacement::ChooseDevice({"TopKV2"}, "HDDL", rules, false),
+            "");
+}
+
+TEST(ClusterPlacement, CostModel) {
+  ClusterPlacement::Rules no_rules;
+  vector<string> backbone{"_Arg", "Conv2D", "BiasAdd", "Relu", "Conv2D",
+                          "_Retval"};
+  vector<string> post_processing{"_Arg",   "GatherV2",
+                                 "TopKV2", "NonMaxSuppressionV5",
+                                 "Cast",  "_Retval"};
+  vector<string> small{"_Arg", "Const", "Add", "Mul", "_Retval"};
+  ASSERT_EQ(ClusterPlacement::ChooseDevice(backbone, "GPU", no_rules, true),
+            "");
+  ASSERT_EQ(
+      ClusterPlacement::ChooseDevice(post_processing, "GPU", no_rules, true),
+      "CPU");
+  ASSERT_EQ(ClusterPlacement::ChooseDevice(small, "GPU", no_rules, true),
+            "CPU");
+  // The cost model only moves clusters off the GPU
+  ASSERT_EQ(ClusterPlacement::ChooseDevice(small, "MYRIAD", no_rules, true),
+            "");
+  ASSERT_EQ(ClusterPlacement::ChooseDevice(small, "GPU", no_rules, false), "");
+  // Rules come first
+  ClusterPlacement::Rules rules{{"Conv2D", "CPU"}};
+  ASSERT_EQ(ClusterPlacement::ChooseDevice(backbone, "GPU", rules, true),
+            "CPU");
+}
+
+TEST(ClusterPlacement, ParseStages) {
+  vector<string> stages;
+  ASSERT_TRUE(ClusterPlacement::ParseStages("GPU,,CPU", stages).ok());
+  ASSERT_EQ(stages, vector<string>({"GPU", "CPU"}));
+  ASSERT_TRUE(ClusterPlacement::ParseStages("", stages).ok());
+  ASSERT_TRUE(stages.empty());
+  ASSERT_FALSE(ClusterPlacement::ParseStages("GPU,HDDL", stages).ok());
+}
+
+TEST(ClusterPlacement, AssignStages) {
+  // Dense ops dominate the compute
+  ASSERT_GT(ClusterPlacement::EstimateCompute({"Conv2D", "Relu"}),
+            ClusterPlacement::EstimateCompute({"Add", "Mul", "Relu"}));
+  ASSERT_EQ(ClusterPlacement::EstimateCompute({"_Arg", "Const", "_Retval"}),
+            0);
+
+  // A big backbone and a small head
+  ASSERT_EQ(ClusterPlacement::AssignStages({100, 10}, 2), vector<int>({0, 1}));
+  // Consecutive clusters of about the same compute
+  ASSERT_EQ(ClusterPlacement::AssignStages({10, 10, 10, 10}, 2),
+            vector<int>({0, 0, 1, 1}));
+  ASSERT_EQ(ClusterPlacement::AssignStages({10, 10, 10}, 3),
+            vector<int>({0, 1, 2}));
+  ASSERT_EQ(ClusterPlacement::AssignStages({10, 10}, 1), vector<int>({0, 0}));
+  ASSERT_EQ(ClusterPlacement::AssignStages({0, 0}, 2), vector<int>({0, 0}));
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
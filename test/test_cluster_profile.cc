@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <cstdio>
+#include <ctime>
+
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/cluster_profile.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static ClusterProfile::Entry MakeEntry(vector<string> nodes,
+                                       int64_t executions, int64_t ov_micros,
+                                       int64_t tf_steps, int64_t tf_micros,
+                                       int64_t compiles,
+                                       int64_t failures = 0) {
+  ClusterProfile::Entry entry;
+  entry.nodes = nodes;
+  entry.executions = executions;
+  entry.ov_micros = ov_micros;
+  entry.tf_steps = tf_steps;
+  entry.tf_micros = tf_micros;
+  entry.failures = failures;
+  entry.compiles = compiles;
+  entry.updated = time(nullptr);
+  return entry;
+}
+
+TEST(ClusterProfile, Verdicts) {
+  using Verdict = ClusterProfile::Verdict;
+  // Faster on OpenVINO than on TF
+  ASSERT_EQ(MakeEntry({"a"}, 100, 50, 10, 80, 1).GetVerdict(), Verdict::kWon);
+  ASSERT_EQ(MakeEntry({"a"}, 100, 90, 10, 80, 1).GetVerdict(),
+            Verdict::kLost);
+  // Never ran on OpenVINO, failing every step
+  ASSERT_EQ(MakeEntry({"a"}, 0, 0, 10, 80, 0, 10).GetVerdict(),
+            Verdict::kLost);
+  // Never ran on OpenVINO, its steps waited for a compilation or were cold
+  ASSERT_EQ(MakeEntry({"a"}, 0, 0, 10, 80, 0).GetVerdict(),
+            Verdict::kUnknown);
+  // Too few failures to tell
+  ASSERT_EQ(MakeEntry({"a"}, 0, 0, 1, 80, 0, 1).GetVerdict(),
+            Verdict::kUnknown);
+  // A compilation every other step
+  ASSERT_EQ(MakeEntry({"a"}, 20, 50, 0, 0, 10).GetVerdict(), Verdict::kChurn);
+  // Not enough steps on TF to compare
+  ASSERT_EQ(MakeEntry({"a"}, 100, 50, 1, 80, 1).GetVerdict(),
+            Verdict::kUnknown);
+}
+
+TEST(ClusterProfile, ClassifiesByNodeOverlap) {
+  using Verdict = ClusterProfile::Verdict;
+  ClusterProfile profile;
+  ASSERT_EQ(profile.Classify({"a"}), Verdict::kUnknown);
+  profile.Add(MakeEntry({"c", "b", "a"}, 100, 90, 10, 80, 1));
+  profile.Add(MakeEntry({"x", "y"}, 100, 50, 10, 80, 1));
+
+  ASSERT_EQ(profile.Classify({"a", "b", "c"}), Verdict::kLost);
+  // Most of the nodes of the lost cluster, together with new ones
+  ASSERT_EQ(profile.Classify({"a", "b", "new"}), Verdict::kLost);
+  ASSERT_EQ(profile.Classify({"y", "x", "z"}), Verdict::kWon);
+  // Only a third of the lost cluster
+  ASSERT_EQ(profile.Classify({"a", "new"}), Verdict::kUnknown);
+  ASSERT_EQ(profile.Classify({"new"}), Verdict::kUnknown);
+
+  // A newer entry with the same nodes replaces the older one
+  ClusterProfile newer;
+  newer.Add(MakeEntry({"a", "b", "c"}, 100, 50, 10, 80, 1));
+  profile.Merge(newer);
+  ASSERT_EQ(profile.entries().size(), 2);
+  ASSERT_EQ(profile.Classify({"a", "b", "c"}), Verdict::kWon);
+}
+
+TEST(ClusterProfile, LostEntriesExpire) {
+  using Verdict = ClusterProfile::Verdict;
+  ClusterProfile profile;
+  profile.SetLostExpiry(3600);
+  auto fresh = MakeEntry({"a"}, 100, 90, 10, 80, 1);
+  auto stale = MakeEntry({"b"}, 0, 0, 10, 80, 0, 10);
+  stale.updated -= 7200;
+  auto stale_won = MakeEntry({"c"}, 100, 50, 10, 80, 1);
+  stale_won.updated -= 7200;
+  profile.Add(fresh);
+  profile.Add(stale);
+  profile.Add(stale_won);
+
+  ASSERT_EQ(profile.Classify({"a"}), Verdict::kLost);
+  ASSERT_EQ(profile.Classify({"b"}), Verdict::kUnknown);
+  ASSERT_EQ(profile.Classify({"c"}), Verdict::kWon);
+  profile.SetLostExpiry(0);
+  ASSERT_EQ(profile.Classify({"b"}), Verdict::kLost);
+}
+
+TEST(ClusterProfile, SavesAndLoads) {
+  ClusterProfile profile;
+  profile.Add(MakeEntry({"model/conv", "model/relu"}, 100, 50, 10, 80, 2));
+  profile.Add(MakeEntry({"model/dense"}, 0, 0, 10, 80, 0, 10));
+
+  ClusterProfile parsed;
+  ASSERT_TRUE(ClusterProfile::Parse(profile.Serialize(), &parsed).ok());
+  ASSERT_EQ(parsed.entries().size(), 2);
+  const auto& entry = parsed.entries()[0];
+  ASSERT_EQ(entry.nodes, vector<string>({"model/conv", "model/relu"}));
+  ASSERT_EQ(entry.executions, 100);
+  ASSERT_EQ(entry.ov_micros, 50);
+  ASSERT_EQ(entry.tf_steps, 10);
+  ASSERT_EQ(entry.tf_micros, 80);
+  ASSERT_EQ(entry.compiles, 2);
+  ASSERT_EQ(entry.failures, 0);
+  ASSERT_EQ(entry.updated, profile.entries()[0].updated);
+  ASSERT_EQ(parsed.entries()[1].failures, 10);
+  ASSERT_FALSE(ClusterProfile::Parse("1 2 x", &parsed).ok());
+
+  string path = ::testing::TempDir() + "/ovtf_cluster_profile.txt";
+  ASSERT_TRUE(profile.Save(path).ok());
+  ClusterProfile loaded;
+  ASSERT_TRUE(loaded.Load(path).ok());
+  ASSERT_EQ(loaded.Serialize(), profile.Serialize());
+  remove(path.c_str());
+
+  // A missing profile is empty
+  ASSERT_TRUE(loaded.Load(path).ok());
+  ASSERT_TRUE(loaded.empty());
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/core/graph/graph.h"
+
+#include "openvino_tensorflow/cluster_topology.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static bool Contains(const string& report, const string& text) {
+  return report.find(text) != string::npos;
+}
+
+TEST(ClusterTopology, BoundaryTensors) {
+  Scope root = Scope::NewRootScope();
+  auto a = ops::Placeholder(root.WithOpName("a"), DT_FLOAT,
+                            ops::Placeholder::Shape({-1, 16}));
+  auto b = ops::Placeholder(root.WithOpName("b"), DT_FLOAT,
+                            ops::Placeholder::Shape({16, 8}));
+  auto matmul = ops::MatMul(root.WithOpName("matmul"), a, b);
+  auto relu = ops::Relu(root.WithOpName("relu"), matmul);
+  auto tanh = ops::Tanh(root.WithOpName("tanh"), relu);
+  auto neg = ops::Neg(root.WithOpName("neg"), tanh);
+  Graph graph(OpRegistry::Global());
+  ASSERT_OK(root.ToGraph(&graph));
+  matmul.node()->AddAttr("_ovtf_cluster", 0);
+  relu.node()->AddAttr("_ovtf_cluster", 0);
+  tanh.node()->AddAttr("_ovtf_cluster", 1);
+
+  string report = ClusterTopology::BuildReport(&graph, 3, "CPU");
+  ASSERT_TRUE(Contains(report, "\"graph_id\": 3, \"device\": \"CPU\""));
+  ASSERT_TRUE(Contains(report,
+                       "{\"cluster_id\": 0, \"num_nodes\": 2, \"ops\": "
+                       "{\"MatMul\": 1, \"Relu\": 1}"));
+  // The batch of a is unknown and counted as 1
+  ASSERT_TRUE(Contains(report,
+                       "{\"src\": \"a:0\", \"src_cluster\": -1, "
+                       "\"dst_cluster\": 0, \"consumers\": [\"matmul\"], "
+                       "\"dtype\": \"float\", \"shape\": \"[?,16]\", "
+                       "\"shape_known\": false, \"bytes\": 64}"));
+  ASSERT_TRUE(Contains(report,
+                       "{\"src\": \"relu:0\", \"src_cluster\": 0, "
+                       "\"dst_cluster\": 1, \"consumers\": [\"tanh\"]"));
+  ASSERT_TRUE(Contains(report,
+                       "\"host_to_device_bytes\": 576, "
+                       "\"device_to_host_bytes\": 32, "
+                       "\"device_to_device_bytes\": 32"));
+  ASSERT_TRUE(Contains(report, "\"boundary_tensors\": 4"));
+}
+
+TEST(ClusterTopology, KeepsTheLastReports) {
+  Scope root = Scope::NewRootScope();
+  ops::Placeholder(root, DT_FLOAT, ops::Placeholder::Shape({2}));
+  Graph graph(OpRegistry::Global());
+  ASSERT_OK(root.ToGraph(&graph));
+
+  ClusterTopology::Clear();
+  ASSERT_EQ(ClusterTopology::GetReports(), "{\"graphs\": []}");
+  for (size_t i = 0; i <= ClusterTopology::kMaxReports; i++) {
+    ClusterTopology::Record(&graph, i, "CPU");
+  }
+  string reports = ClusterTopology::GetReports();
+  ASSERT_FALSE(Contains(reports, "\"graph_id\": 0,"));
+  ASSERT_TRUE(Contains(reports, "\"graph_id\": 1,"));
+  ASSERT_TRUE(Contains(
+      reports, "\"graph_id\": " + to_string(ClusterTopology::kMaxReports)));
+  ClusterTopology::Clear();
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
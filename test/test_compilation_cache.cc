@@ -0,0 +1,413 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+
+#include "openvino/opsets/opset7.hpp"
+
+#include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/compilation_key.h"
+#include "openvino_tensorflow/executable_cache.h"
+#include "openvino_tensorflow/lru_cache.h"
+#include "openvino_tensorflow/memory_budget.h"
+#include "openvino_tensorflow/model_cache.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+TEST(CompilationKey, ShapesAndTypes) {
+  CompilationKey k1, k2, k3, k4;
+  k1.AddInput(DT_FLOAT, TensorShape({2, 3}));
+  k2.AddInput(DT_FLOAT, TensorShape({2, 3}));
+  k3.AddInput(DT_FLOAT, TensorShape({3, 2}));
+  k4.AddInput(DT_INT32, TensorShape({2, 3}));
+
+  ASSERT_EQ(k1, k2);
+  ASSERT_EQ(k1.Hash(), k2.Hash());
+  ASSERT_NE(k1, k3);
+  ASSERT_NE(k1, k4);
+
+  // Rank is part of the key, so {6} followed by {} is not {6, ...}
+  CompilationKey k5, k6;
+  k5.AddInput(DT_FLOAT, TensorShape({6}));
+  k5.AddInput(DT_FLOAT, TensorShape({}));
+  k6.AddInput(DT_FLOAT, TensorShape({6, 1}));
+  ASSERT_NE(k5, k6);
+}
+
+TEST(CompilationKey, DynamicInputs) {
+  CompilationKey k1, k2, k3, k4;
+  k1.AddDynamicInput(DT_FLOAT, 2);
+  k2.AddDynamicInput(DT_FLOAT, 2);
+  k3.AddDynamicInput(DT_FLOAT, 3);
+  k4.AddInput(DT_FLOAT, TensorShape({2, 3}));
+
+  ASSERT_EQ(k1, k2);
+  ASSERT_NE(k1, k3);
+  // A dynamic key never matches a static shape of the same rank
+  ASSERT_NE(k1, k4);
+}
+
+TEST(CompilationKey, StaticInputs) {
+  Tensor t1(DT_INT32, TensorShape({3}));
+  Tensor t2(DT_INT32, TensorShape({3}));
+  AssignInputValues<int>(t1, vector<int>{1, 2, 3});
+  AssignInputValues<int>(t2, vector<int>{1, 2, 4});
+
+  CompilationKey k1, k2, k3;
+  for (auto k : {&k1, &k2, &k3}) {
+    k->AddInput(DT_INT32, TensorShape({3}));
+  }
+  ASSERT_OK(k1.AddStaticInput(0, t1));
+  ASSERT_OK(k2.AddStaticInput(0, t1));
+  ASSERT_OK(k3.AddStaticInput(0, t2));
+  ASSERT_EQ(k1, k2);
+  ASSERT_NE(k1, k3);
+
+  Tensor str(DT_STRING, TensorShape({1}));
+  CompilationKey k4;
+  ASSERT_NE(k4.AddStaticInput(0, str), Status::OK());
+}
+
+TEST(LRUCache, EvictsLeastRecentlyUsed) {
+  LRUCache<string, int> cache(2);
+  vector<int> evicted;
+  cache.Insert("a", 1, &evicted);
+  cache.Insert("b", 2, &evicted);
+  ASSERT_TRUE(evicted.empty());
+
+  // Touch "a" so "b" becomes the eviction candidate
+  int value = 0;
+  ASSERT_TRUE(cache.Lookup("a", value));
+  ASSERT_EQ(value, 1);
+
+  cache.Insert("c", 3, &evicted);
+  ASSERT_EQ(evicted, vector<int>{2});
+  ASSERT_FALSE(cache.Lookup("b", value));
+  ASSERT_TRUE(cache.Lookup("c", value));
+  ASSERT_EQ(cache.Size(), 2);
+
+  cache.SetCapacity(1, &evicted);
+  ASSERT_EQ(evicted, (vector<int>{2, 1}));
+  ASSERT_TRUE(cache.Lookup("c", value));
+  ASSERT_EQ(value, 3);
+}
+
+TEST(LRUCache, InsertReplacesValue) {
+  LRUCache<string, int> cache(2);
+  cache.Insert("a", 1);
+  cache.Insert("a", 5);
+  int value = 0;
+  ASSERT_TRUE(cache.Lookup("a", value));
+  ASSERT_EQ(value, 5);
+  ASSERT_EQ(cache.Size(), 1);
+  ASSERT_TRUE(cache.Erase("a"));
+  ASSERT_FALSE(cache.Lookup("a", value));
+}
+
+TEST(ExecutableCache, EvictsAcrossClusters) {
+  auto key = [](int64 dim) {
+    CompilationKey k;
+    k.AddInput(DT_FLOAT, TensorShape({dim}));
+    return k;
+  };
+  // The cache never dereferences the executables
+  std::shared_ptr<Executable> exec;
+  std::vector<std::shared_ptr<Executable>> evicted;
+  ExecutableCache cache(300);
+
+  cache.Insert(0, key(1), exec, 100, 16, &evicted);
+  cache.Insert(1, key(1), exec, 100, 16, &evicted);
+  cache.Insert(0, key(2), exec, 100, 16, &evicted);
+  ASSERT_TRUE(cache.Lookup(0, key(1), exec));
+  ASSERT_FALSE(cache.Lookup(1, key(2), exec));
+
+  // Over budget, the least recently used entry of any cluster goes
+  cache.Insert(1, key(2), exec, 100, 16, &evicted);
+  ASSERT_EQ(evicted.size(), 1u);
+  ASSERT_FALSE(cache.Lookup(1, key(1), exec));
+  ASSERT_EQ(cache.Bytes(), 300u);
+  ASSERT_EQ(cache.GetClusterStats(1).evictions, 1u);
+  ASSERT_EQ(cache.GetClusterStats(1).misses, 2u);
+
+  // Over the item limit of cluster 0, its oldest entry goes
+  cache.Insert(0, key(3), exec, 10, 2, &evicted);
+  ASSERT_FALSE(cache.Lookup(0, key(2), exec));
+  ASSERT_TRUE(cache.Lookup(0, key(1), exec));
+  ASSERT_EQ(cache.GetClusterStats(0).entries, 2u);
+  ASSERT_EQ(cache.GetClusterStats(0).evictions, 1u);
+
+  cache.EraseCluster(0, &evicted);
+  ASSERT_EQ(cache.Size(), 1u);
+  ASSERT_EQ(cache.Bytes(), 100u);
+}
+
+TEST(ExecutableCache, FailedSignatures) {
+  auto key = [](int64 dim) {
+    CompilationKey k;
+    k.AddInput(DT_FLOAT, TensorShape({dim}));
+    return k;
+  };
+  std::shared_ptr<Executable> exec;
+  std::vector<std::shared_ptr<Executable>> evicted;
+  ExecutableCache cache;
+
+  // A failed signature loses its executable, the others keep theirs
+  cache.Insert(0, key(1), exec, 100, 16, &evicted);
+  cache.Insert(0, key(2), exec, 100, 16, &evicted);
+  ASSERT_EQ(cache.RecordFailure(0, key(1), 0, 0, &evicted), 1u);
+  ASSERT_FALSE(cache.Lookup(0, key(1), exec));
+  ASSERT_TRUE(cache.Lookup(0, key(2), exec));
+  ASSERT_TRUE(cache.IsFailed(0, key(1), 1000000000));
+  ASSERT_FALSE(cache.IsFailed(0, key(2), 0));
+  ASSERT_FALSE(cache.IsFailed(1, key(1), 0));
+  ASSERT_EQ(cache.Bytes(), 100u);
+
+  // Retried after the backoff, doubled by every failure
+  ASSERT_EQ(cache.RecordFailure(0, key(2), 0, 100, &evicted), 2u);
+  ASSERT_TRUE(cache.IsFailed(0, key(2), 99));
+  ASSERT_FALSE(cache.IsFailed(0, key(2), 100));
+  cache.RecordFailure(0, key(2), 100, 100, &evicted);
+  ASSERT_TRUE(cache.IsFailed(0, key(2), 299));
+  ASSERT_FALSE(cache.IsFailed(0, key(2), 300));
+
+  // Compiled again, the signature is forgotten
+  cache.Insert(0, key(2), exec, 100, 16, &evicted);
+  ASSERT_FALSE(cache.IsFailed(0, key(2), 0));
+  ASSERT_EQ(cache.GetClusterStats(0).failures, 1u);
+  cache.EraseCluster(0, &evicted);
+  ASSERT_FALSE(cache.IsFailed(0, key(1), 0));
+}
+
+// A trivial executable, which is not compiled, for device
+static std::shared_ptr<Executable> MakeExecutable(const string& device) {
+  auto param = make_shared<ov::opset7::Parameter>(ov::element::f32,
+                                                  ov::Shape{2});
+  auto model = make_shared<ov::Model>(param->outputs(),
+                                      ov::ParameterVector{param});
+  return make_shared<Executable>(model, device, device);
+}
+
+TEST(ExecutableCache, EvictsDevice) {
+  auto key = [](int64 dim) {
+    CompilationKey k;
+    k.AddInput(DT_FLOAT, TensorShape({dim}));
+    return k;
+  };
+  auto cpu = MakeExecutable("CPU");
+  auto gpu = MakeExecutable("GPU");
+  std::vector<std::shared_ptr<Executable>> evicted;
+  ExecutableCache cache;
+
+  cache.Insert(0, key(1), gpu, 100, 16, &evicted);
+  cache.Insert(0, key(2), cpu, 100, 16, &evicted);
+  cache.Insert(1, key(1), gpu, 100, 16, &evicted);
+  cache.Insert(1, key(2), gpu, 100, 16, &evicted);
+  ASSERT_EQ(cache.DeviceBytes("GPU"), 300u);
+  ASSERT_EQ(cache.DeviceBytes("CPU"), 100u);
+
+  // Only the least recently used executables of the device go
+  std::shared_ptr<Executable> exec;
+  ASSERT_TRUE(cache.Lookup(0, key(1), exec));
+  ASSERT_EQ(cache.EvictDevice("GPU", 150, &evicted), 100u);
+  ASSERT_EQ(evicted.size(), 2u);
+  ASSERT_TRUE(cache.Lookup(0, key(1), exec));
+  ASSERT_TRUE(cache.Lookup(0, key(2), exec));
+  ASSERT_FALSE(cache.Lookup(1, key(1), exec));
+  ASSERT_FALSE(cache.Lookup(1, key(2), exec));
+  ASSERT_EQ(cache.GetClusterStats(1).evictions, 2u);
+}
+
+TEST(MemoryBudget, Devices) {
+  MemoryBudget::Clear();
+  ASSERT_EQ(MemoryBudget::Get("GPU"), 0u);
+  MemoryBudget::Set("GPU", 1000);
+  MemoryBudget::Set("GPU.1", 500);
+  ASSERT_EQ(MemoryBudget::Get("GPU"), 1000u);
+  ASSERT_EQ(MemoryBudget::Get("GPU.0"), 1000u);
+  ASSERT_EQ(MemoryBudget::Get("GPU.1"), 500u);
+  ASSERT_EQ(MemoryBudget::Get("CPU"), 0u);
+  MemoryBudget::Set("GPU", 0);
+  ASSERT_EQ(MemoryBudget::Get("GPU.0"), 0u);
+  MemoryBudget::Clear();
+}
+
+TEST(NGraphClusterManager, ReserveDeviceMemory) {
+  MemoryBudget::Clear();
+  auto& cache = NGraphClusterManager::GetExecutableCache();
+  cache.Clear();
+  CompilationKey key;
+  key.AddInput(DT_FLOAT, TensorShape({1}));
+  cache.Insert(0, key, MakeExecutable("CPU"), 600, 16, nullptr);
+  // Without a budget nothing is evicted
+  ASSERT_OK(NGraphClusterManager::ReserveDeviceMemory("CPU", 1000));
+  ASSERT_EQ(cache.Size(), 1u);
+
+  MemoryBudget::Set("CPU", 1000);
+  ASSERT_OK(NGraphClusterManager::ReserveDeviceMemory("CPU", 400));
+  ASSERT_EQ(cache.Size(), 1u);
+  ASSERT_OK(NGraphClusterManager::ReserveDeviceMemory("CPU", 500));
+  ASSERT_EQ(cache.Size(), 0u);
+  ASSERT_TRUE(errors::IsResourceExhausted(
+      NGraphClusterManager::ReserveDeviceMemory("CPU", 1001)));
+  MemoryBudget::Clear();
+  cache.Clear();
+}
+
+TEST(NGraphClusterManager, ReservesForConcurrentCompilations) {
+  MemoryBudget::Clear();
+  auto& cache = NGraphClusterManager::GetExecutableCache();
+  cache.Clear();
+  CompilationKey key;
+  key.AddInput(DT_FLOAT, TensorShape({1}));
+  MemoryBudget::Set("CPU", 1000);
+  auto first = MakeExecutable("CPU");
+  auto second = MakeExecutable("CPU");
+  ASSERT_OK(NGraphClusterManager::ReserveDeviceMemory("CPU", 600, first.get()));
+  ASSERT_EQ(cache.ReservedBytes("CPU"), 600u);
+  // The first compilation has not inserted its executable yet
+  ASSERT_TRUE(errors::IsResourceExhausted(
+      NGraphClusterManager::ReserveDeviceMemory("CPU", 600, second.get())));
+
+  // A failed compilation releases its reservation
+  NGraphClusterManager::ReleaseDeviceMemory(*first);
+  ASSERT_EQ(cache.ReservedBytes("CPU"), 0u);
+  ASSERT_OK(
+      NGraphClusterManager::ReserveDeviceMemory("CPU", 600, second.get()));
+
+  // The cache entry takes the reservation over
+  cache.Insert(0, key, second, 600, 16, nullptr);
+  ASSERT_EQ(cache.ReservedBytes("CPU"), 0u);
+  ASSERT_EQ(cache.DeviceBytes("CPU"), 600u);
+  MemoryBudget::Clear();
+  cache.Clear();
+}
+
+TEST(NGraphClusterManager, CanonicalFingerprint) {
+  auto cluster = [](const string& prefix, const string& op) {
+    GraphDef graph;
+    NodeDef* arg = graph.add_node();
+    arg->set_name(prefix + "/arg");
+    arg->set_op("_Arg");
+    arg->set_device("/device:CPU:0");
+    NodeDef* node = graph.add_node();
+    node->set_name(prefix + "/op");
+    node->set_op(op);
+    node->add_input(prefix + "/arg");
+    node->add_input("^" + prefix + "/arg");
+    NodeDef* ret = graph.add_node();
+    ret->set_name(prefix + "/ret");
+    ret->set_op("_Retval");
+    ret->add_input(prefix + "/op:0");
+    return graph;
+  };
+
+  // The towers of a model only differ by the names of their nodes
+  GraphDef tower_0 = cluster("tower_0", "Relu");
+  GraphDef tower_1 = cluster("tower_1", "Relu");
+  tower_1.mutable_node(0)->set_device("/device:CPU:1");
+  ASSERT_EQ(NGraphClusterManager::CanonicalFingerprint(tower_0, "CPU"),
+            NGraphClusterManager::CanonicalFingerprint(tower_1, "CPU"));
+  ASSERT_NE(NGraphClusterManager::CanonicalFingerprint(tower_0, "CPU"),
+            NGraphClusterManager::CanonicalFingerprint(tower_0, "GPU"));
+  ASSERT_NE(NGraphClusterManager::CanonicalFingerprint(tower_0, "CPU"),
+            NGraphClusterManager::CanonicalFingerprint(
+                cluster("tower_0", "Tanh"), "CPU"));
+}
+
+TEST(NGraphClusterManager, ParsedGraphs) {
+  auto first = std::make_shared<const ClusterGraph>();
+  auto second = std::make_shared<const ClusterGraph>();
+  ASSERT_EQ(NGraphClusterManager::GetParsedGraph("test:0"), nullptr);
+
+  // The graph set first is shared by the later kernels
+  ASSERT_EQ(NGraphClusterManager::SetParsedGraph("test:0", first), first);
+  ASSERT_EQ(NGraphClusterManager::SetParsedGraph("test:0", second), first);
+  ASSERT_EQ(NGraphClusterManager::GetParsedGraph("test:0"), first);
+
+  // Until no kernel holds it anymore
+  first.reset();
+  ASSERT_EQ(NGraphClusterManager::GetParsedGraph("test:0"), nullptr);
+  ASSERT_EQ(NGraphClusterManager::SetParsedGraph("test:0", second), second);
+}
+
+TEST(NGraphClusterManager, CacheOwners) {
+  NGraphClusterManager::GetExecutableCache().Clear();
+  CompilationKey key;
+  key.AddInput(DT_FLOAT, TensorShape({1}));
+  // Two kernels of the same cluster id
+  size_t first = NGraphClusterManager::NewCacheOwner(7);
+  size_t second = NGraphClusterManager::NewCacheOwner(7);
+  ASSERT_NE(first, second);
+  auto executable = MakeExecutable("CPU");
+  NGraphClusterManager::InsertExecutable(first, key, executable, 100, 16);
+
+  std::shared_ptr<Executable> found;
+  ASSERT_TRUE(NGraphClusterManager::LookupExecutable(first, key, found));
+  ASSERT_EQ(found, executable);
+  ASSERT_FALSE(NGraphClusterManager::LookupExecutable(second, key, found));
+  ASSERT_EQ(NGraphClusterManager::GetClusterStats(7).entries, 1u);
+
+  // Releasing a kernel only erases its own entries
+  NGraphClusterManager::InsertExecutable(second, key, MakeExecutable("CPU"),
+                                         100, 16);
+  NGraphClusterManager::ReleaseCacheOwner(first);
+  ASSERT_FALSE(NGraphClusterManager::LookupExecutable(first, key, found));
+  ASSERT_TRUE(NGraphClusterManager::LookupExecutable(second, key, found));
+  NGraphClusterManager::ReleaseCacheOwner(second);
+  ASSERT_EQ(NGraphClusterManager::GetExecutableCache().Size(), 0u);
+}
+
+#ifndef _WIN32
+TEST(ModelCache, EvictsLeastRecentlyUsedBlobs) {
+  char dir_template[] = "/tmp/ovtf_model_cache_XXXXXX";
+  ASSERT_NE(mkdtemp(dir_template), nullptr);
+  string dir(dir_template);
+
+  auto write_file = [&](const string& name, time_t atime, time_t mtime) {
+    string path = dir + "/" + name;
+    ofstream(path) << string(100, 'x');
+    struct timespec times[2] = {{atime, 0}, {mtime, 0}};
+    ASSERT_EQ(utimensat(AT_FDCWD, path.c_str(), times, 0), 0);
+  };
+  // b was written first but loaded last
+  write_file("a.blob", 2000, 2000);
+  write_file("b.blob", 4000, 1000);
+  write_file("c.cl_cache", 3000, 3000);
+  // Not written by the plugins
+  write_file("notes.txt", 500, 500);
+
+  ASSERT_EQ(ModelCache::EvictToBudget(dir, 300), 300u);
+  ASSERT_EQ(ModelCache::EvictToBudget(dir, 250), 200u);
+  ASSERT_EQ(access((dir + "/a.blob").c_str(), F_OK), -1);
+  ASSERT_EQ(access((dir + "/b.blob").c_str(), F_OK), 0);
+  ASSERT_EQ(access((dir + "/c.cl_cache").c_str(), F_OK), 0);
+
+  ASSERT_EQ(ModelCache::EvictToBudget(dir, 0), 0u);
+  ASSERT_EQ(access((dir + "/notes.txt").c_str(), F_OK), 0);
+  ASSERT_EQ(remove((dir + "/notes.txt").c_str()), 0);
+  ASSERT_EQ(rmdir(dir.c_str()), 0);
+}
+#endif
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/compile_properties.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+TEST(CompileProperties, CooperativeCpuThreading) {
+  CompileProperties::Map properties{{"cpu_threading", "COOPERATIVE"}};
+  ASSERT_OK(CompileProperties::Validate("cpu_threading", "COOPERATIVE"));
+  ASSERT_OK(CompileProperties::Validate("affinity", "NONE"));
+  ASSERT_NE(CompileProperties::Validate("affinity", "ALL"), Status::OK());
+
+  ov::AnyMap config = CompileProperties::ToConfig(properties);
+  ASSERT_TRUE(config.empty());
+  CompileProperties::ApplyCpuThreading(properties, 6, config);
+  ASSERT_EQ(config[ov::inference_num_threads.name()].as<string>(), "6");
+  ASSERT_EQ(config[ov::num_streams.name()].as<string>(), "1");
+  ASSERT_EQ(config[ov::affinity.name()].as<string>(), "NONE");
+
+  // The properties set explicitly are kept
+  properties["num_streams"] = "2";
+  properties["affinity"] = "CORE";
+  config = CompileProperties::ToConfig(properties);
+  CompileProperties::ApplyCpuThreading(properties, 6, config);
+  ASSERT_EQ(config[ov::num_streams.name()].as<string>(), "2");
+  ASSERT_EQ(config[ov::affinity.name()].as<string>(), "CORE");
+
+  // Nothing changes by default
+  config.clear();
+  CompileProperties::ApplyCpuThreading({}, 6, config);
+  ASSERT_TRUE(config.empty());
+}
+
+TEST(CompileProperties, ModelPriority) {
+  ASSERT_OK(CompileProperties::Validate("model_priority", "HIGH"));
+  ASSERT_NE(CompileProperties::Validate("model_priority", "URGENT"),
+            Status::OK());
+  ov::AnyMap config = CompileProperties::ToConfig({{"model_priority", "LOW"}});
+  ASSERT_EQ(config[ov::hint::model_priority.name()].as<string>(), "LOW");
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/framework/tensor_shape.h"
+
+#include "openvino_tensorflow/compile_tiering.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static CompilationKey Signature(int64 batch) {
+  CompilationKey signature;
+  signature.AddInput(DT_FLOAT, TensorShape({batch, 3}));
+  return signature;
+}
+
+TEST(CompileTiering, CompilesAfterMinSteps) {
+  CompileTiering::Options options;
+  options.min_steps = 3;
+  CompileTiering tiering(options);
+  ASSERT_FALSE(tiering.RecordMiss(Signature(1)));
+  ASSERT_FALSE(tiering.RecordMiss(Signature(2)));
+  ASSERT_FALSE(tiering.RecordMiss(Signature(1)));
+  ASSERT_TRUE(tiering.RecordMiss(Signature(1)));
+  // A compiled signature stays hot once its executable is evicted
+  ASSERT_TRUE(tiering.RecordMiss(Signature(1)));
+  ASSERT_FALSE(tiering.RecordMiss(Signature(2)));
+}
+
+TEST(CompileTiering, CompilesAfterMinTFTime) {
+  CompileTiering::Options options;
+  options.min_tf_micros = 1000;
+  CompileTiering tiering(options);
+  ASSERT_FALSE(tiering.RecordMiss(Signature(1)));
+  tiering.RecordTFTime(Signature(1), 600);
+  ASSERT_FALSE(tiering.RecordMiss(Signature(1)));
+  tiering.RecordTFTime(Signature(1), 600);
+  ASSERT_TRUE(tiering.RecordMiss(Signature(1)));
+}
+
+TEST(CompileTiering, DropsLeastRecentlySeenCounters) {
+  CompileTiering::Options options;
+  options.min_steps = 2;
+  options.max_signatures = 2;
+  CompileTiering tiering(options);
+  ASSERT_FALSE(tiering.RecordMiss(Signature(1)));
+  ASSERT_FALSE(tiering.RecordMiss(Signature(2)));
+  ASSERT_FALSE(tiering.RecordMiss(Signature(3)));
+  ASSERT_EQ(tiering.Size(), 2);
+  // The first signature starts over
+  ASSERT_FALSE(tiering.RecordMiss(Signature(1)));
+  ASSERT_TRUE(tiering.RecordMiss(Signature(1)));
+}
+
+TEST(CompileTiering, DisabledByDefault) {
+  CompileTiering::Options options;
+  ASSERT_FALSE(options.Enabled());
+  CompileTiering tiering(options);
+  ASSERT_TRUE(tiering.RecordMiss(Signature(1)));
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,153 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/device_scheduler.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+TEST(DeviceScheduler, QueuesBeyondConcurrency) {
+  DeviceScheduler::Clear();
+  DeviceScheduler::SetConcurrency("TEST", 2);
+  vector<int> started;
+  for (int i = 0; i < 4; i++) {
+    DeviceScheduler::Submit("TEST", [&started, i]() { started.push_back(i); });
+  }
+  ASSERT_EQ(started, (vector<int>{0, 1}));
+  ASSERT_EQ(DeviceScheduler::InFlight("TEST"), 2);
+  ASSERT_EQ(DeviceScheduler::Waiting("TEST"), 2);
+
+  // Each completion starts the oldest waiting inference
+  DeviceScheduler::Complete("TEST");
+  ASSERT_EQ(started, (vector<int>{0, 1, 2}));
+  DeviceScheduler::SetConcurrency("TEST", 4);
+  ASSERT_EQ(started, (vector<int>{0, 1, 2, 3}));
+  ASSERT_EQ(DeviceScheduler::InFlight("TEST"), 3);
+  for (int i = 0; i < 3; i++) DeviceScheduler::Complete("TEST");
+  ASSERT_EQ(DeviceScheduler::InFlight("TEST"), 0);
+  DeviceScheduler::Clear();
+}
+
+TEST(DeviceScheduler, ReportedRequestsRaiseTheDefault) {
+  DeviceScheduler::Clear();
+  ASSERT_EQ(DeviceScheduler::GetConcurrency("TEST"), 2);
+  DeviceScheduler::ReportOptimalRequests("TEST", 4);
+  DeviceScheduler::ReportOptimalRequests("TEST", 1);
+  ASSERT_EQ(DeviceScheduler::GetConcurrency("TEST"), 4);
+
+  // Unless the concurrency was set
+  DeviceScheduler::SetConcurrency("TEST", 1);
+  DeviceScheduler::ReportOptimalRequests("TEST", 8);
+  ASSERT_EQ(DeviceScheduler::GetConcurrency("TEST"), 1);
+  DeviceScheduler::Clear();
+}
+
+TEST(DeviceScheduler, BoundsSynchronousInferences) {
+  DeviceScheduler::Clear();
+  DeviceScheduler::SetConcurrency("TEST", 2);
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  vector<thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 50; i++) {
+        DeviceScheduler::Slot slot("TEST");
+        int now = ++running;
+        int max = max_running;
+        while (now > max && !max_running.compare_exchange_weak(max, now)) {
+        }
+        std::this_thread::yield();
+        running--;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  ASSERT_LE(max_running, 2);
+  ASSERT_EQ(DeviceScheduler::InFlight("TEST"), 0);
+  DeviceScheduler::Clear();
+}
+
+TEST(DeviceScheduler, UnboundedConcurrency) {
+  DeviceScheduler::Clear();
+  DeviceScheduler::SetConcurrency("TEST", 0);
+  int started = 0;
+  for (int i = 0; i < 16; i++) {
+    DeviceScheduler::Submit("TEST", [&started]() { started++; });
+  }
+  ASSERT_EQ(started, 16);
+  for (int i = 0; i < 16; i++) DeviceScheduler::Complete("TEST");
+  DeviceScheduler::Clear();
+}
+
+TEST(DeviceScheduler, StartsByPriority) {
+  DeviceScheduler::Clear();
+  DeviceScheduler::SetConcurrency("TEST", 1);
+  using Priority = DeviceScheduler::Priority;
+  vector<int> started;
+  // The first one starts, the others wait for it
+  for (auto priority : {Priority::MEDIUM, Priority::LOW, Priority::MEDIUM,
+                        Priority::HIGH}) {
+    int i = started.size() + DeviceScheduler::Waiting("TEST");
+    DeviceScheduler::Submit("TEST", [&started, i]() { started.push_back(i); },
+                            priority);
+  }
+  ASSERT_EQ(started, (vector<int>{0}));
+  DeviceScheduler::Complete("TEST", Priority::MEDIUM);
+  ASSERT_EQ(started, (vector<int>{0, 3}));
+  DeviceScheduler::Complete("TEST", Priority::HIGH);
+  ASSERT_EQ(started, (vector<int>{0, 3, 2}));
+  DeviceScheduler::Complete("TEST", Priority::MEDIUM);
+  ASSERT_EQ(started, (vector<int>{0, 3, 2, 1}));
+  DeviceScheduler::Complete("TEST", Priority::LOW);
+  ASSERT_EQ(DeviceScheduler::InFlight("TEST"), 0);
+  DeviceScheduler::Clear();
+}
+
+TEST(DeviceScheduler, BoundsLowPriorityInferences) {
+  DeviceScheduler::Clear();
+  DeviceScheduler::SetConcurrency("TEST", 4);
+  ASSERT_EQ(DeviceScheduler::GetLowPriorityConcurrency("TEST"), 2);
+  using Priority = DeviceScheduler::Priority;
+  int low_started = 0;
+  for (int i = 0; i < 3; i++) {
+    DeviceScheduler::Submit("TEST", [&low_started]() { low_started++; },
+                            Priority::LOW);
+  }
+  ASSERT_EQ(low_started, 2);
+  ASSERT_EQ(DeviceScheduler::LowPriorityInFlight("TEST"), 2);
+
+  // The higher priority inferences still have room
+  int high_started = 0;
+  for (int i = 0; i < 2; i++) {
+    DeviceScheduler::Submit("TEST", [&high_started]() { high_started++; },
+                            Priority::HIGH);
+  }
+  ASSERT_EQ(high_started, 2);
+  ASSERT_EQ(DeviceScheduler::InFlight("TEST"), 4);
+
+  // A completed low priority inference makes room for the last one
+  DeviceScheduler::Complete("TEST", Priority::HIGH);
+  ASSERT_EQ(low_started, 2);
+  DeviceScheduler::Complete("TEST", Priority::LOW);
+  ASSERT_EQ(low_started, 3);
+  DeviceScheduler::Complete("TEST", Priority::HIGH);
+  for (int i = 0; i < 2; i++) DeviceScheduler::Complete("TEST", Priority::LOW);
+  ASSERT_EQ(DeviceScheduler::InFlight("TEST"), 0);
+  ASSERT_EQ(DeviceScheduler::LowPriorityInFlight("TEST"), 0);
+  DeviceScheduler::Clear();
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
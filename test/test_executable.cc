@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "openvino/opsets/opset7.hpp"
+
+#include "openvino_tensorflow/executable.h"
+#include "openvino_tensorflow/ie_tensor.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+// Adds a bias of 3 values to a batch of chunk_rows rows, on the CPU
+static shared_ptr<Executable> MakeAddExecutable(size_t chunk_rows) {
+  auto x = make_shared<ov::opset7::Parameter>(ov::element::f32,
+                                              ov::Shape{chunk_rows, 3});
+  auto bias =
+      make_shared<ov::opset7::Parameter>(ov::element::f32, ov::Shape{3});
+  auto add = make_shared<ov::opset7::Add>(x, bias);
+  auto model =
+      make_shared<ov::Model>(add->outputs(), ov::ParameterVector{x, bias});
+  return make_shared<Executable>(model, "CPU", "CPU");
+}
+
+TEST(Executable, CallChunked) {
+  auto exec = MakeAddExecutable(4);
+  // Two full chunks and a padded one
+  const size_t batch = 10;
+  auto x = make_shared<IETensor>(ov::element::f32, ov::Shape{batch, 3});
+  auto bias = make_shared<IETensor>(ov::element::f32, ov::Shape{3});
+  for (size_t i = 0; i < batch * 3; i++) x->data<float>()[i] = i;
+  for (size_t i = 0; i < 3; i++) bias->data<float>()[i] = 100 * (i + 1);
+  vector<shared_ptr<ov::Tensor>> outputs{
+      make_shared<IETensor>(ov::element::f32, ov::Shape{batch, 3})};
+
+  exec->CallChunked({x, bias}, {true, false}, 4, outputs);
+  const float* result = outputs[0]->data<float>();
+  for (size_t i = 0; i < batch * 3; i++) {
+    ASSERT_EQ(result[i], static_cast<float>(i + 100 * (i % 3 + 1)))
+        << "element " << i;
+  }
+
+  // The outputs must hold the whole batch
+  vector<shared_ptr<ov::Tensor>> short_outputs{
+      make_shared<IETensor>(ov::element::f32, ov::Shape{4, 3})};
+  ASSERT_THROW(exec->CallChunked({x, bias}, {true, false}, 4, short_outputs),
+               std::runtime_error);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,51 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/host_copy.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static void CheckCopy(size_t bytes, size_t dst_offset, size_t src_offset) {
+  vector<uint8_t> src(bytes + src_offset);
+  for (size_t i = 0; i < src.size(); i++) src[i] = uint8_t(i * 7 + 3);
+  vector<uint8_t> dst(bytes + dst_offset + 1, 0);
+  HostCopy::Copy(dst.data() + dst_offset, src.data() + src_offset, bytes);
+  for (size_t i = 0; i < bytes; i++) {
+    ASSERT_EQ(dst[dst_offset + i], src[src_offset + i]) << "at " << i;
+  }
+  // The bytes around the copy are not written
+  ASSERT_EQ(dst[dst_offset + bytes], 0);
+  if (dst_offset > 0) ASSERT_EQ(dst[dst_offset - 1], 0);
+}
+
+TEST(HostCopy, SmallCopies) {
+  CheckCopy(0, 0, 0);
+  CheckCopy(1, 3, 0);
+  CheckCopy(4096, 0, 0);
+}
+
+// Split in blocks across the copy threads
+TEST(HostCopy, ParallelCopies) {
+  CheckCopy(size_t(4) << 20, 0, 0);
+  CheckCopy((size_t(9) << 20) + 13, 5, 11);
+}
+
+// Written with non-temporal stores
+TEST(HostCopy, StreamingCopies) {
+  CheckCopy((size_t(32) << 20) + 3, 1, 7);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "openvino_tensorflow/kv_cache.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+namespace testing {
+
+static Node* AddArg(Graph& graph, int index) {
+  Node* node;
+  TF_CHECK_OK(NodeBuilder("arg" + to_string(index), "_Arg")
+                  .Attr("T", DT_FLOAT)
+                  .Attr("index", index)
+                  .Finalize(&graph, &node));
+  return node;
+}
+
+static Node* AddRetval(Graph& graph, Node* input, int index) {
+  Node* node;
+  TF_CHECK_OK(NodeBuilder("retval" + to_string(index), "_Retval")
+                  .Input(input)
+                  .Attr("T", DT_FLOAT)
+                  .Attr("index", index)
+                  .Finalize(&graph, &node));
+  return node;
+}
+
+static Node* AddAxis(Graph& graph, int axis) {
+  Tensor value(DT_INT32, TensorShape({}));
+  value.scalar<int32>()() = axis;
+  Node* node;
+  TF_CHECK_OK(NodeBuilder("axis" + to_string(graph.num_node_ids()), "Const")
+                  .Attr("dtype", DT_INT32)
+                  .Attr("value", value)
+                  .Finalize(&graph, &node));
+  return node;
+}
+
+static Node* AddConcat(Graph& graph, Node* a, Node* b, Node* axis) {
+  Node* node;
+  TF_CHECK_OK(NodeBuilder("concat" + to_string(graph.num_node_ids()),
+                          "ConcatV2")
+                  .Input(vector<NodeBuilder::NodeOut>{a, b})
+                  .Input(axis)
+                  .Finalize(&graph, &node));
+  return node;
+}
+
+TEST(KVCache, FindsPastFedBack) {
+  Graph graph(OpRegistry::Global());
+  // The past keys and the new ones, concatenated along the sequence
+  Node* past = AddArg(graph, 0);
+  Node* keys = AddArg(graph, 1);
+  AddRetval(graph, AddConcat(graph, past, keys, AddAxis(graph, -2)), 0);
+  // The new tokens first, and a past read by another op too
+  Node* other = AddArg(graph, 2);
+  AddRetval(graph, AddConcat(graph, keys, other, AddAxis(graph, 1)), 1);
+  Node* shared = AddArg(graph, 3);
+  Node* concat = AddConcat(graph, shared, keys, AddAxis(graph, 2));
+  AddRetval(graph, concat, 2);
+  AddRetval(graph, shared, 3);
+
+  auto inputs = FindKVCacheInputs(graph);
+  ASSERT_EQ(inputs.size(), 1);
+  ASSERT_EQ(inputs[0].input, 0);
+  ASSERT_EQ(inputs[0].output, 0);
+  ASSERT_EQ(inputs[0].Axis(4), 2);
+}
+
+TEST(KVCache, HoldsTheOutputsFedBack) {
+  KVCacheState state({{0, 1, 2}});
+  Tensor empty(DT_FLOAT, TensorShape({1, 8, 0, 64}));
+  Tensor keys(DT_FLOAT, TensorShape({1, 8, 1, 64}));
+  // The first step sets the variable
+  ASSERT_EQ(state.BeginStep({empty, keys}), vector<int>{0});
+  Tensor present(DT_FLOAT, TensorShape({1, 8, 1, 64}));
+  state.EndStep({Tensor(), present});
+
+  // The output fed back is held by the variable, a copy of it is not
+  ASSERT_TRUE(state.BeginStep({present, keys}).empty());
+  state.EndStep({Tensor(), present});
+  Tensor copy(DT_FLOAT, present.shape());
+  ASSERT_EQ(state.BeginStep({copy, keys}), vector<int>{0});
+
+  // A failed step holds nothing, and a reset sets the variables again
+  ASSERT_EQ(state.BeginStep({present, keys}), vector<int>{0});
+  state.EndStep({Tensor(), present});
+  KVCacheState::Reset();
+  ASSERT_EQ(state.BeginStep({present, keys}), vector<int>{0});
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
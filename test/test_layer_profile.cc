@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <chrono>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/layer_profile.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static ov::ProfilingInfo Layer(const string& name, int64_t micros,
+                               ov::ProfilingInfo::Status status =
+                                   ov::ProfilingInfo::Status::EXECUTED) {
+  ov::ProfilingInfo info;
+  info.status = status;
+  info.real_time = std::chrono::microseconds(micros);
+  info.cpu_time = info.real_time;
+  info.node_name = name;
+  info.exec_type = "jit_avx2_FP32";
+  info.node_type = "Convolution";
+  return info;
+}
+
+TEST(LayerProfile, TFNodeName) {
+  ASSERT_EQ(LayerProfile::TFNodeName("model/conv1/Conv2D/Convolution_12"),
+            "model/conv1/Conv2D");
+  ASSERT_EQ(LayerProfile::TFNodeName("Relu"), "Relu");
+  ASSERT_EQ(LayerProfile::TFNodeName("/Relu"), "/Relu");
+}
+
+TEST(LayerProfile, Layout) {
+  vector<ov::ProfilingInfo> info = {
+      Layer("conv/Conv2D/Convolution_1", 10),
+      Layer("relu/Relu/Relu_2", 5, ov::ProfilingInfo::Status::NOT_RUN),
+      Layer("add/Add/Add_3", 20), Layer("out/Identity/Result_4", 1)};
+  auto events = LayerProfile::Layout(info, 1000, 26000);
+
+  // The layers which did not run are left out, and the layers are clipped
+  // to the end of the inference
+  ASSERT_EQ(events.size(), 2);
+  ASSERT_EQ(events[0].tf_node, "conv/Conv2D");
+  ASSERT_EQ(events[0].layer, "conv/Conv2D/Convolution_1");
+  ASSERT_EQ(events[0].start_ns, 1000);
+  ASSERT_EQ(events[0].end_ns, 11000);
+  ASSERT_EQ(events[1].tf_node, "add/Add");
+  ASSERT_EQ(events[1].start_ns, 11000);
+  ASSERT_EQ(events[1].end_ns, 26000);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
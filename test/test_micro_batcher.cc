@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/ie_tensor.h"
+#include "openvino_tensorflow/micro_batcher.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+// Doubles the single input and counts the calls
+static MicroBatcher::RunFunction Doubler(std::atomic<int>& calls) {
+  return [&calls](const vector<shared_ptr<ov::Tensor>>& inputs,
+                  vector<shared_ptr<ov::Tensor>>& outputs) {
+    calls++;
+    auto output = make_shared<IETensor>(inputs[0]->get_element_type(),
+                                        inputs[0]->get_shape());
+    const float* src = inputs[0]->data<float>();
+    float* dst = output->data<float>();
+    for (size_t i = 0; i < inputs[0]->get_size(); i++) dst[i] = 2 * src[i];
+    outputs[0] = output;
+  };
+}
+
+TEST(MicroBatcher, CoalescesConcurrentCalls) {
+  std::atomic<int> calls{0};
+  MicroBatcher::Options options;
+  options.max_batch = 4;
+  // Long enough for all the callers to queue up
+  options.max_wait_us = 2000000;
+  MicroBatcher batcher(Doubler(calls), options);
+
+  vector<thread> callers;
+  vector<vector<float>> results(4);
+  for (int t = 0; t < 4; t++) {
+    callers.emplace_back([&batcher, &results, t]() {
+      auto input = make_shared<IETensor>(ov::element::f32, ov::Shape{1, 3});
+      for (int i = 0; i < 3; i++) input->data<float>()[i] = t * 10 + i;
+      vector<shared_ptr<ov::Tensor>> outputs(1, nullptr);
+      batcher.Run({input}, outputs);
+      ASSERT_EQ(outputs[0]->get_shape(), (ov::Shape{1, 3}));
+      const float* out = outputs[0]->data<float>();
+      results[t].assign(out, out + 3);
+    });
+  }
+  for (auto& caller : callers) caller.join();
+
+  ASSERT_EQ(calls, 1);
+  for (int t = 0; t < 4; t++) {
+    for (int i = 0; i < 3; i++) {
+      ASSERT_EQ(results[t][i], 2 * (t * 10 + i));
+    }
+  }
+}
+
+TEST(MicroBatcher, RunsIncompatibleCallsAlone) {
+  std::atomic<int> calls{0};
+  MicroBatcher::Options options;
+  options.max_batch = 4;
+  options.max_wait_us = 0;
+  MicroBatcher batcher(Doubler(calls), options);
+
+  // A full batch is not queued
+  auto full = make_shared<IETensor>(ov::element::f32, ov::Shape{4, 2});
+  vector<shared_ptr<ov::Tensor>> outputs(1, nullptr);
+  batcher.Run({full}, outputs);
+  ASSERT_EQ(calls, 1);
+
+  // Inputs which disagree on the batch dimension
+  ASSERT_EQ(MicroBatcher::BatchSize(
+                {make_shared<IETensor>(ov::element::f32, ov::Shape{2, 2}),
+                 make_shared<IETensor>(ov::element::f32, ov::Shape{3})}),
+            0);
+  ASSERT_EQ(MicroBatcher::BatchSize(
+                {make_shared<IETensor>(ov::element::f32, ov::Shape{2, 2}),
+                 nullptr}),
+            2);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "openvino/opsets/opset7.hpp"
+
+#include "openvino_tensorflow/op_support.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static shared_ptr<ov::Model> MakeReluModel(ov::element::Type type,
+                                           const ov::Shape& shape) {
+  auto param = make_shared<ov::opset7::Parameter>(type, shape);
+  auto relu = make_shared<ov::opset7::Relu>(param);
+  return make_shared<ov::Model>(relu, ov::ParameterVector{param});
+}
+
+TEST(OpSupport, Signature) {
+  auto model = MakeReluModel(ov::element::f32, {2, 3});
+  auto relu = model->get_results()[0]->get_input_node_shared_ptr(0);
+  string signature = OpSupport::Signature(*relu);
+  ASSERT_NE(signature.find("Relu"), string::npos);
+
+  // Same element types and ranks, same signature
+  auto same = MakeReluModel(ov::element::f32, {4, 5});
+  ASSERT_EQ(signature, OpSupport::Signature(
+                           *same->get_results()[0]->get_input_node_ptr(0)));
+  auto other_rank = MakeReluModel(ov::element::f32, {4, 5, 6});
+  ASSERT_NE(signature,
+            OpSupport::Signature(
+                *other_rank->get_results()[0]->get_input_node_ptr(0)));
+  auto other_type = MakeReluModel(ov::element::i32, {2, 3});
+  ASSERT_NE(signature,
+            OpSupport::Signature(
+                *other_type->get_results()[0]->get_input_node_ptr(0)));
+}
+
+TEST(OpSupport, TFSignature) {
+  Graph graph(OpRegistry::Global());
+  Node* arg_float;
+  Node* arg_int;
+  ASSERT_OK(NodeBuilder("arg_float", "_Arg")
+                .Attr("T", DT_FLOAT)
+                .Attr("index", 0)
+                .Finalize(&graph, &arg_float));
+  ASSERT_OK(NodeBuilder("arg_int", "_Arg")
+                .Attr("T", DT_INT32)
+                .Attr("index", 1)
+                .Finalize(&graph, &arg_int));
+  ASSERT_EQ(OpSupport::TFSignature(arg_float), "_Arg T=float");
+  ASSERT_NE(OpSupport::TFSignature(arg_float),
+            OpSupport::TFSignature(arg_int));
+}
+
+TEST(OpSupport, QueryModel) {
+  OpSupport::Clear();
+  ov::Core core;
+  auto model = MakeReluModel(ov::element::f32, {2, 3});
+  auto relu = model->get_results()[0]->get_input_node_shared_ptr(0);
+  string signature = OpSupport::Signature(*relu);
+  bool supported = false;
+  ASSERT_FALSE(OpSupport::IsKnown("CPU", signature, supported));
+
+  vector<shared_ptr<ov::Node>> unsupported;
+  ASSERT_OK(OpSupport::QueryModel(core, model, "CPU", unsupported));
+  ASSERT_TRUE(unsupported.empty());
+  ASSERT_TRUE(OpSupport::IsKnown("CPU", signature, supported));
+  ASSERT_TRUE(supported);
+  OpSupport::Clear();
+}
+
+TEST(OpSupport, TFUnsupported) {
+  OpSupport::Clear();
+  OpSupport::SetTFUnsupported("GPU", "Erf T=float");
+  ASSERT_TRUE(OpSupport::IsTFUnsupported("GPU", "Erf T=float"));
+  ASSERT_FALSE(OpSupport::IsTFUnsupported("CPU", "Erf T=float"));
+  ASSERT_FALSE(OpSupport::IsTFUnsupported("GPU", "Erf T=half"));
+  OpSupport::Clear();
+  ASSERT_FALSE(OpSupport::IsTFUnsupported("GPU", "Erf T=float"));
+}
+
+TEST(OpSupport, NodeSignature) {
+  Graph graph(OpRegistry::Global());
+  auto relu = [&graph](const string& name, DataType type, Node** node) {
+    Node* arg;
+    ASSERT_OK(NodeBuilder(name + "_arg", "_Arg")
+                  .Attr("T", type)
+                  .Attr("index", 0)
+                  .Finalize(&graph, &arg));
+    ASSERT_OK(NodeBuilder(name, "Relu")
+                  .Input(arg)
+                  .Attr("T", type)
+                  .Attr("_ovtf_marked_for_clustering", true)
+                  .Finalize(&graph, node));
+  };
+  Node* relu_0;
+  Node* relu_1;
+  Node* relu_int;
+  relu("relu_0", DT_FLOAT, &relu_0);
+  relu("relu_1", DT_FLOAT, &relu_1);
+  relu("relu_int", DT_INT32, &relu_int);
+  relu_1->ClearAttr("_ovtf_marked_for_clustering");
+
+  // The names and internal attributes do not matter
+  ASSERT_EQ(OpSupport::NodeSignature(relu_0), OpSupport::NodeSignature(relu_1));
+  ASSERT_NE(OpSupport::NodeSignature(relu_0),
+            OpSupport::NodeSignature(relu_int));
+
+  OpSupport::Clear();
+  bool supported = false;
+  uint64 signature = OpSupport::NodeSignature(relu_0);
+  ASSERT_FALSE(OpSupport::LookupNodeSupport("CPU", signature, supported));
+  OpSupport::SetNodeSupport("CPU", signature, true);
+  ASSERT_TRUE(OpSupport::LookupNodeSupport("CPU", signature, supported));
+  ASSERT_TRUE(supported);
+  ASSERT_FALSE(OpSupport::LookupNodeSupport("GPU", signature, supported));
+  OpSupport::Clear();
+  ASSERT_FALSE(OpSupport::LookupNodeSupport("CPU", signature, supported));
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -3,7 +3,9 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
+#include <algorithm>
 #include <regex>
+#include <set>
 #include "gtest/gtest.h"
 
 #include "tensorflow/cc/ops/standard_ops.h"
@@ -18,6 +20,7 @@
 #include "tensorflow/core/graph/graph_constructor.h"
 #endif
 #include "tensorflow/core/graph/graph_def_builder.h"
+#include "tensorflow/core/graph/node_builder.h"
 #include "tensorflow/core/platform/env.h"
 
 #include "openvino_tensorflow/backend_manager.h"
@@ -313,6 +316,130 @@ TEST_F(NGraphExecTest, NGraphPassConstantFolding2) {
   unsetenv("OPENVINO_TF_CONSTANT_FOLDING");
 }
 
+TEST_F(NGraphExecTest, ConstantValues) {
+  // The Constants share the buffers of the decoded TF tensors, whether the
+  // values are stored in the tensor content or as a repeated value
+  Scope root = Scope::NewRootScope();
+  Graph* pgraph = root.graph();
+  Tensor weights(DT_FLOAT, TensorShape({2, 3}));
+  AssignInputValues<float>(weights, {1.5f, -2.f, 3.f, 0.25f, 5.f, 6.f});
+  auto a = ops::Const(root, weights);
+  auto b = ops::Const(root, 2.f, TensorShape({2, 3}));
+  auto mul = ops::Mul(root, a, b);
+  auto pgraph_new = attach_retval_node(root, pgraph, mul.node());
+
+  setenv("OPENVINO_TF_CONSTANT_FOLDING", "0", true);
+  std::vector<TensorShape> tf_input_shapes;
+  shared_ptr<ov::Model> func;
+  ASSERT_OK(TranslateTFGraphNoStatic(tf_input_shapes, *pgraph_new, func));
+  unsetenv("OPENVINO_TF_CONSTANT_FOLDING");
+
+  vector<vector<float>> values;
+  for (const auto& node : func->get_ordered_ops()) {
+    if (auto constant = ngraph::as_type_ptr<opset::Constant>(node)) {
+      ASSERT_EQ(constant->get_shape(), (ov::Shape{2, 3}));
+      values.push_back(constant->cast_vector<float>());
+    }
+  }
+  ASSERT_EQ(values.size(), 2);
+  sort(values.begin(), values.end());
+  ASSERT_EQ(values[0], (vector<float>{1.5f, -2.f, 3.f, 0.25f, 5.f, 6.f}));
+  ASSERT_EQ(values[1], vector<float>(6, 2.f));
+}
+
+TEST_F(NGraphExecTest, SharedWeights) {
+  // The translations of a cluster share the buffers of its weights
+  Scope root = Scope::NewRootScope();
+  Graph* pgraph = root.graph();
+  Tensor weights(DT_FLOAT, TensorShape({64, 64}));
+  AssignInputValuesRandom(weights);
+  auto a = ops::Const(root, weights);
+  auto b = ops::Const(root, weights);
+  auto add = ops::Add(root, a, b);
+  auto pgraph_new = attach_retval_node(root, pgraph, add.node());
+
+  auto& weights_cache = Backend::GetGlobalContext().weights_cache;
+  size_t shared_bytes = weights_cache.GetSharedBytes();
+  setenv("OPENVINO_TF_CONSTANT_FOLDING", "0", true);
+  // The buffers are released with the last model using them
+  vector<shared_ptr<ov::Model>> funcs(2);
+  std::set<const void*> buffers;
+  for (auto& func : funcs) {
+    std::vector<TensorShape> tf_input_shapes;
+    ASSERT_OK(TranslateTFGraphNoStatic(tf_input_shapes, *pgraph_new, func));
+    for (const auto& node : func->get_ops()) {
+      if (auto constant = ngraph::as_type_ptr<opset::Constant>(node)) {
+        buffers.insert(constant->get_data_ptr());
+      }
+    }
+  }
+  unsetenv("OPENVINO_TF_CONSTANT_FOLDING");
+
+  // The two constants of the two translations have the same contents
+  ASSERT_EQ(buffers.size(), 1);
+  ASSERT_EQ(weights_cache.GetSharedBytes() - shared_bytes,
+            3 * weights.TotalBytes());
+}
+
+static Node* AddOp(Graph& graph, const string& op,
+                   const vector<Node*>& inputs) {
+  NodeBuilder builder(op + to_string(graph.num_node_ids()), op);
+  for (Node* input : inputs) builder.Input(input);
+  Node* node;
+  TF_CHECK_OK(builder.Finalize(&graph, &node));
+  return node;
+}
+
+static Node* AddArg(Graph& graph, int index) {
+  Node* node;
+  TF_CHECK_OK(NodeBuilder("arg" + to_string(index), "_Arg")
+                  .Attr("T", DT_FLOAT)
+                  .Attr("index", index)
+                  .Finalize(&graph, &node));
+  return node;
+}
+
+static void AddRetval(Graph& graph, Node* input, int index) {
+  Node* node;
+  TF_CHECK_OK(NodeBuilder("retval" + to_string(index), "_Retval")
+                  .Input(input)
+                  .Attr("T", DT_FLOAT)
+                  .Attr("index", index)
+                  .Finalize(&graph, &node));
+}
+
+TEST_F(NGraphExecTest, ForwardableInputs) {
+  Graph graph(OpRegistry::Global());
+  // An activation tail, and a sum of two inputs read only by it
+  AddRetval(graph,
+            AddOp(graph, "Tanh", {AddOp(graph, "Relu", {AddArg(graph, 0)})}),
+            0);
+  AddRetval(graph, AddOp(graph, "Add", {AddArg(graph, 1), AddArg(graph, 2)}),
+            1);
+  // An input read by two results
+  Node* shared = AddArg(graph, 3);
+  AddRetval(graph, AddOp(graph, "Neg", {shared}), 2);
+  AddRetval(graph, AddOp(graph, "Sigmoid", {shared}), 3);
+  // A residual sum, whose MatMul could be computed over the input
+  Node* matmul = AddOp(graph, "MatMul", {AddArg(graph, 4), AddArg(graph, 5)});
+  AddRetval(graph, AddOp(graph, "Add", {matmul, AddArg(graph, 6)}), 4);
+
+  vector<TensorShape> tf_input_shapes(7, TensorShape({2, 3}));
+  tf_input_shapes[5] = TensorShape({3, 3});
+  shared_ptr<ov::Model> func;
+  ASSERT_OK(TranslateTFGraphNoStatic(tf_input_shapes, graph, func));
+  auto results = func->get_results();
+  ASSERT_EQ(results.size(), 5);
+  vector<int> inputs;
+  ASSERT_TRUE(Builder::GetForwardableInputs(results[0], inputs));
+  ASSERT_EQ(inputs, vector<int>{0});
+  ASSERT_TRUE(Builder::GetForwardableInputs(results[1], inputs));
+  ASSERT_EQ(inputs, (vector<int>{1, 2}));
+  for (int i = 2; i < results.size(); i++) {
+    ASSERT_FALSE(Builder::GetForwardableInputs(results[i], inputs));
+  }
+}
+
 }  // namespace testing
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/framework/tensor.h"
+
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/shape_bucketing.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+TEST(ShapeBucketing, PadsBatchAndSequence) {
+  ShapeBucketing bucketing({1, 2, 4, 8}, 4);
+
+  Tensor ids(DT_INT32, TensorShape({3, 5}));
+  auto ids_val = ids.matrix<int32>();
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 5; j++) {
+      ids_val(i, j) = i * 10 + j + 1;
+    }
+  }
+  Tensor scale(DT_FLOAT, TensorShape({}));
+  scale.scalar<float>()() = 2.0f;
+  vector<Tensor> inputs = {ids, scale};
+
+  auto padding = bucketing.PadInputs(inputs, {false, false}, {false, false});
+  ASSERT_TRUE(padding.IsPadded());
+  ASSERT_EQ(inputs[0].shape(), TensorShape({4, 8}));
+  ASSERT_EQ(inputs[1].shape(), TensorShape({}));
+
+  auto padded_val = inputs[0].matrix<int32>();
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 8; j++) {
+      int32 expected = (i < 3 && j < 5) ? ids_val(i, j) : 0;
+      ASSERT_EQ(padded_val(i, j), expected);
+    }
+  }
+
+  // Only the outputs which follow the padded inputs are sliced back, even
+  // if another one has the size of the padding
+  ShapeBucketing::OutputDims dims;
+  dims.batch_known = dims.sequence_known = true;
+  dims.batch = {true, true, false};
+  dims.sequence = {true, false, false};
+  ASSERT_TRUE(padding.CanUnpad(dims));
+  ASSERT_EQ(padding.UnpaddedShape(TensorShape({4, 8, 16}), dims, 0),
+            TensorShape({3, 5, 16}));
+  ASSERT_EQ(padding.UnpaddedShape(TensorShape({4, 8}), dims, 1),
+            TensorShape({3, 8}));
+  ASSERT_EQ(padding.UnpaddedShape(TensorShape({4}), dims, 2),
+            TensorShape({4}));
+  dims.sequence_known = false;
+  ASSERT_FALSE(padding.CanUnpad(dims));
+
+  Tensor sliced(DT_INT32, TensorShape({3, 5}));
+  ShapeBucketing::CopyLeadingBlock(inputs[0], &sliced);
+  Compare(vector<Tensor>{sliced}, vector<Tensor>{ids});
+}
+
+TEST(ShapeBucketing, SkipsStaticAndLargeInputs) {
+  ShapeBucketing bucketing({1, 2, 4}, 0);
+
+  // Static inputs keep their shape, they are part of the compilation key,
+  // and so do the variables
+  vector<Tensor> inputs = {Tensor(DT_FLOAT, TensorShape({3, 2})),
+                           Tensor(DT_INT32, TensorShape({3})),
+                           Tensor(DT_FLOAT, TensorShape({3, 3}))};
+  auto padding =
+      bucketing.PadInputs(inputs, {false, true, false}, {false, false, true});
+  ASSERT_TRUE(padding.IsPadded());
+  ASSERT_EQ(inputs[0].shape(), TensorShape({4, 2}));
+  ASSERT_EQ(inputs[1].shape(), TensorShape({3}));
+  ASSERT_EQ(inputs[2].shape(), TensorShape({3, 3}));
+
+  // Batches larger than the largest bucket are not padded
+  vector<Tensor> large_inputs = {Tensor(DT_FLOAT, TensorShape({5, 2}))};
+  ASSERT_FALSE(bucketing.PadInputs(large_inputs, {false}, {false}).IsPadded());
+  ASSERT_EQ(large_inputs[0].shape(), TensorShape({5, 2}));
+
+  // Nor are inputs which do not share their batch
+  vector<Tensor> ragged_inputs = {Tensor(DT_FLOAT, TensorShape({3, 2})),
+                                  Tensor(DT_FLOAT, TensorShape({2, 2}))};
+  ASSERT_FALSE(bucketing.PadInputs(ragged_inputs, {false, false},
+                                   {false, false})
+                   .IsPadded());
+
+  ASSERT_FALSE(ShapeBucketing().IsEnabled());
+}
+
+TEST(ShapeBucketing, FindsPaddedOutputs) {
+  ShapeBucketing bucketing({4}, 4);
+
+  // The product follows the batch and the sequence of the ids, the sum
+  // over the batch only the sequence, as its leading dimension
+  auto ids = make_shared<opset::Parameter>(ov::element::f32, ov::Shape{4, 8});
+  auto scale = make_shared<opset::Parameter>(ov::element::f32, ov::Shape{});
+  auto product = make_shared<opset::Multiply>(ids, scale);
+  auto axis = opset::Constant::create(ov::element::i64, ov::Shape{1}, {0});
+  auto sum = make_shared<opset::ReduceSum>(ids, axis);
+  ov::ResultVector results = {make_shared<opset::Result>(product),
+                              make_shared<opset::Result>(sum)};
+  auto model = make_shared<ov::Model>(results,
+                                      ov::ParameterVector{ids, scale});
+
+  vector<TensorShape> input_shapes = {TensorShape({4, 8}), TensorShape({})};
+  auto dims = bucketing.FindOutputDims(
+      model, results, input_shapes,
+      ShapeBucketing::BucketedInputs(input_shapes, {false, false},
+                                     {false, false}));
+  ASSERT_TRUE(dims.batch_known);
+  ASSERT_EQ(dims.batch, vector<bool>({true, false}));
+  // The sequence moves to the leading dimension of the sum
+  ASSERT_FALSE(dims.sequence_known);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,60 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/framework/tensor.h"
+
+#include "openvino_tensorflow/static_input_tracker.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static vector<Tensor> Inputs(int32 shape_value) {
+  Tensor data(DT_FLOAT, TensorShape({2, 3}));
+  Tensor shape(DT_INT32, TensorShape({1}));
+  shape.flat<int32>()(0) = shape_value;
+  return {data, shape};
+}
+
+TEST(StaticInputTracker, ReadsChangingInputsAtRunTime) {
+  StaticInputTracker tracker({false, true}, 2);
+  auto initial = tracker.StaticInputs();
+  ASSERT_EQ(*initial, vector<bool>({false, true}));
+
+  // The values seen again do not count
+  ASSERT_FALSE(tracker.RecordMiss(Inputs(6)));
+  ASSERT_FALSE(tracker.RecordMiss(Inputs(6)));
+  ASSERT_FALSE(tracker.RecordMiss(Inputs(3)));
+  ASSERT_TRUE(tracker.RecordMiss(Inputs(2)));
+  ASSERT_EQ(*tracker.StaticInputs(), vector<bool>({false, false}));
+  // The earlier snapshot is unchanged
+  ASSERT_EQ(*initial, vector<bool>({false, true}));
+  ASSERT_FALSE(tracker.RecordMiss(Inputs(1)));
+
+  // Once reading it at run time failed, the input is static for good
+  ASSERT_TRUE(tracker.Disable());
+  ASSERT_EQ(*tracker.StaticInputs(), vector<bool>({false, true}));
+  ASSERT_FALSE(tracker.Disable());
+  for (int32 i = 10; i < 20; i++) ASSERT_FALSE(tracker.RecordMiss(Inputs(i)));
+}
+
+TEST(StaticInputTracker, ZeroLimitDisables) {
+  StaticInputTracker tracker({true}, 0);
+  for (int32 i = 0; i < 10; i++) {
+    ASSERT_FALSE(tracker.RecordMiss({Inputs(i)[1]}));
+  }
+  ASSERT_EQ(*tracker.StaticInputs(), vector<bool>({true}));
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/framework/cancellation.h"
+#include "tensorflow/core/lib/core/errors.h"
+
+#include "openvino_tensorflow/step_cancellation.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+TEST(StepCancellation, ForwardsTheCancellation) {
+  CancellationManager manager;
+  auto cancellation = StepCancellation::Create(&manager);
+  StepCancellation::Scope scope(cancellation);
+  ASSERT_EQ(StepCancellation::Current(), cancellation);
+
+  int cancelled = 0;
+  int deregistered = 0;
+  {
+    StepCancellation::Registration registration(
+        [&deregistered]() { deregistered++; });
+    ASSERT_FALSE(registration.cancelled());
+  }
+  StepCancellation::Registration registration(
+      [&cancelled]() { cancelled++; });
+  ASSERT_TRUE(cancellation->Check().ok());
+
+  manager.StartCancel();
+  ASSERT_EQ(cancelled, 1);
+  ASSERT_EQ(deregistered, 0);
+  ASSERT_TRUE(errors::IsCancelled(cancellation->Check()));
+
+  // The calls registered afterwards do not start
+  StepCancellation::Registration late([]() {});
+  ASSERT_TRUE(late.cancelled());
+}
+
+TEST(StepCancellation, ReleasedCancellationIsNotCancelled) {
+  CancellationManager manager;
+  auto cancellation = StepCancellation::Create(&manager);
+  cancellation->Release();
+  manager.StartCancel();
+  ASSERT_FALSE(cancellation->IsCancelled());
+
+  // Without a step, or out of scope, the registrations do nothing
+  ASSERT_EQ(StepCancellation::Current(), nullptr);
+  StepCancellation::Registration registration([]() {});
+  ASSERT_FALSE(registration.cancelled());
+  ASSERT_FALSE(StepCancellation::Create(nullptr)->IsCancelled());
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
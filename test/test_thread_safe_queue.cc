@@ -3,9 +3,12 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
+#include <atomic>
 #include <cstdlib>
+#include <iostream>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
@@ -108,6 +111,136 @@ TEST(ThreadSafeQueue, Simple) {
 
   thread0.join();
 }
+
+TEST(ThreadSafeQueue, Terminate) {
+  benchmark::ThreadSafeQueue<int> queue(2);
+  ASSERT_TRUE(queue.Add(1));
+  ASSERT_TRUE(queue.Add(2));
+
+  // The producer blocks on the full queue until an item is taken
+  atomic<bool> added{false};
+  std::thread producer([&]() { added = queue.Add(3); });
+  absl::SleepFor(absl::Milliseconds(10));
+  ASSERT_FALSE(added);
+  int item = 0;
+  ASSERT_TRUE(queue.GetNextAvailable(&item));
+  ASSERT_EQ(item, 1);
+  producer.join();
+  ASSERT_TRUE(added);
+
+  // The consumers get the remaining items, and are not blocked after that
+  std::thread consumer([&]() {
+    vector<int> items;
+    int next;
+    while (queue.GetNextAvailable(&next)) items.push_back(next);
+    ASSERT_EQ(items, vector<int>({2, 3}));
+  });
+  absl::SleepFor(absl::Milliseconds(10));
+  queue.Terminate();
+  consumer.join();
+  ASSERT_FALSE(queue.Add(4));
+  ASSERT_EQ(queue.GetNextAvailable(), 0);
+}
+
+TEST(ThreadSafeQueue, TryVariants) {
+  benchmark::ThreadSafeQueue<unique_ptr<int>> queue(1);
+  unique_ptr<int> item(new int(1));
+  ASSERT_TRUE(queue.TryAdd(item));
+  ASSERT_EQ(item, nullptr);
+
+  // The item is kept by the caller when the queue is full
+  item.reset(new int(2));
+  ASSERT_FALSE(queue.TryAdd(item));
+  ASSERT_NE(item, nullptr);
+  ASSERT_EQ(queue.Size(), 1);
+
+  unique_ptr<int> next;
+  ASSERT_TRUE(queue.TryGetNext(&next));
+  ASSERT_EQ(*next, 1);
+  ASSERT_FALSE(queue.TryGetNext(&next));
+  queue.Terminate();
+  ASSERT_FALSE(queue.TryAdd(item));
+}
+
+TEST(ThreadSafeQueue, PopBatch) {
+  benchmark::ThreadSafeQueue<int> queue;
+  for (int i = 0; i < 5; i++) queue.Add(i);
+
+  // A full batch is returned without waiting for the timeout
+  vector<int> batch;
+  auto start = absl::Now();
+  ASSERT_TRUE(queue.PopBatch(3, absl::Seconds(10), &batch));
+  ASSERT_LT(absl::Now() - start, absl::Seconds(1));
+  ASSERT_EQ(batch, vector<int>({0, 1, 2}));
+
+  // A partial batch once the timeout elapsed
+  batch.clear();
+  ASSERT_TRUE(queue.PopBatch(3, absl::Milliseconds(10), &batch));
+  ASSERT_EQ(batch, vector<int>({3, 4}));
+
+  // The items added while waiting join the batch
+  batch.clear();
+  std::thread producer([&]() {
+    queue.Add(5);
+    absl::SleepFor(absl::Milliseconds(5));
+    queue.Add(6);
+  });
+  ASSERT_TRUE(queue.PopBatch(2, absl::Seconds(10), &batch));
+  producer.join();
+  ASSERT_EQ(batch, vector<int>({5, 6}));
+
+  // The waiting consumers return once terminated
+  batch.clear();
+  std::thread consumer(
+      [&]() { ASSERT_FALSE(queue.PopBatch(2, absl::Seconds(10), &batch)); });
+  absl::SleepFor(absl::Milliseconds(10));
+  queue.Terminate();
+  consumer.join();
+  ASSERT_TRUE(batch.empty());
+}
+
+// Measures the throughput of a small bounded queue under contention, with
+// single and batch consumers, and checks that every item is delivered once
+TEST(ThreadSafeQueue, Contention) {
+  const int kItems = 200000;
+  for (const int threads : {1, 4}) {
+    for (const size_t batch_size : {size_t(1), size_t(16)}) {
+      benchmark::ThreadSafeQueue<int> queue(64);
+      atomic<int64_t> sum{0};
+      atomic<int> count{0};
+      vector<std::thread> producers, consumers;
+      auto start = absl::Now();
+      for (int t = 0; t < threads; t++) {
+        producers.emplace_back([&, t]() {
+          for (int i = t; i < kItems; i += threads) queue.Add(i);
+        });
+        consumers.emplace_back([&]() {
+          vector<int> batch;
+          int item;
+          while (batch_size > 1
+                     ? queue.PopBatch(batch_size, absl::Microseconds(100),
+                                      &batch)
+                     : queue.GetNextAvailable(&item)) {
+            if (batch_size == 1) batch.push_back(item);
+            for (int value : batch) sum += value;
+            count += batch.size();
+            batch.clear();
+          }
+        });
+      }
+      for (auto& producer : producers) producer.join();
+      queue.Terminate();
+      for (auto& consumer : consumers) consumer.join();
+      double seconds = absl::ToDoubleSeconds(absl::Now() - start);
+
+      cout << threads << " producers and consumers, batches of "
+           << batch_size << ": " << static_cast<int64_t>(kItems / seconds)
+           << " items/s" << endl;
+      ASSERT_EQ(count, kItems);
+      ASSERT_EQ(sum, int64_t(kItems) * (kItems - 1) / 2);
+    }
+  }
+}
 }
 
 }  // namespace openvino_tensorflow
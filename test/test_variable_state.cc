@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/framework/tensor.h"
+
+#include "openvino_tensorflow/variable_state.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static Tensor MakeTensor(float value) {
+  Tensor tensor(DT_FLOAT, TensorShape({4}));
+  tensor.flat<float>().setConstant(value);
+  return tensor;
+}
+
+TEST(VariableState, SameValue) {
+  Tensor a = MakeTensor(1.0f);
+  ASSERT_TRUE(VariableState::SameValue(a, a));
+  ASSERT_TRUE(VariableState::SameValue(a, MakeTensor(1.0f)));
+  ASSERT_FALSE(VariableState::SameValue(a, MakeTensor(2.0f)));
+  ASSERT_FALSE(
+      VariableState::SameValue(a, Tensor(DT_FLOAT, TensorShape({2, 2}))));
+}
+
+TEST(VariableState, UpdateDetectsWrites) {
+  VariableState state;
+  vector<bool> is_variable{false, true};
+  Tensor input = MakeTensor(0.0f);
+  Tensor variable = MakeTensor(1.0f);
+
+  // Nothing was held before
+  ASSERT_FALSE(state.Update({input, variable}, is_variable));
+  ASSERT_FALSE(state.Update({MakeTensor(5.0f), variable}, is_variable));
+  // A new buffer with the same value is the same variable
+  ASSERT_FALSE(state.Update({input, MakeTensor(1.0f)}, is_variable));
+  ASSERT_TRUE(state.Update({input, MakeTensor(2.0f)}, is_variable));
+  ASSERT_FALSE(state.Update({input, MakeTensor(2.0f)}, is_variable));
+}
+
+TEST(VariableState, TensorKeptUntilWritten) {
+  VariableState state;
+  Tensor variable = MakeTensor(1.0f);
+  Tensor held;
+  auto tensor = state.GetTensor(0, variable, ov::element::f32, ov::Shape{4},
+                                nullptr, held);
+  ASSERT_EQ(tensor->data(), variable.data());
+  ASSERT_EQ(held.data(), variable.data());
+
+  // The held buffer is still bound for a copy of the same value
+  Tensor copy = MakeTensor(1.0f);
+  ASSERT_EQ(state.GetTensor(0, copy, ov::element::f32, ov::Shape{4}, nullptr,
+                            held),
+            tensor);
+  ASSERT_EQ(held.data(), variable.data());
+
+  Tensor written = MakeTensor(3.0f);
+  auto rebound = state.GetTensor(0, written, ov::element::f32, ov::Shape{4},
+                                 nullptr, held);
+  ASSERT_NE(rebound, tensor);
+  ASSERT_EQ(rebound->data(), written.data());
+  ASSERT_EQ(held.data(), written.data());
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
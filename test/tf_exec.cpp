@@ -35,18 +35,16 @@ namespace tensorflow {
 namespace openvino_tensorflow {
 namespace testing {
 
-TEST(TFExec, SingleGraphOn2Threads) {
-  string graph_name = "test_axpy.pbtxt";
-  unique_ptr<Session> session;
-  ASSERT_OK(CreateSession(graph_name, session));
-
-  auto worker = [&session](size_t thread_id) {
+// Runs the axpy graph from num_threads threads sharing a single session
+static void RunAxpyOnThreads(unique_ptr<Session>& session, int num_threads,
+                             int num_iterations) {
+  auto worker = [&session, num_iterations](size_t thread_id) {
     string inp_tensor_name_0{"x"};
     string inp_tensor_name_1{"y"};
     string out_tensor_name{"add"};
     std::vector<Tensor> out_tensor_vals;
 
-    for (int i = 0; i < 10; i++) {
+    for (int i = 0; i < num_iterations; i++) {
       Tensor inp_tensor_val(tensorflow::DT_FLOAT,
                             tensorflow::TensorShape({2, 3}));
       vector<float> in_vals(6, float(i));
@@ -67,11 +65,40 @@ TEST(TFExec, SingleGraphOn2Threads) {
     }
   };
 
-  std::thread thread0(worker, 0);
-  std::thread thread1(worker, 1);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back(worker, t);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+TEST(TFExec, SingleGraphOn2Threads) {
+  string graph_name = "test_axpy.pbtxt";
+  unique_ptr<Session> session;
+  ASSERT_OK(CreateSession(graph_name, session));
+  RunAxpyOnThreads(session, 2, 10);
+}
+
+// Many threads running the same cluster concurrently, each one has to get
+// its own infer request and must see its own results
+TEST(TFExec, SingleGraphOn16Threads) {
+  string graph_name = "test_axpy.pbtxt";
+  unique_ptr<Session> session;
+  ASSERT_OK(CreateSession(graph_name, session));
+  RunAxpyOnThreads(session, 16, 25);
+}
 
-  thread0.join();
-  thread1.join();
+// Same as above, with the clusters run through the AsyncOpKernel path
+TEST(TFExec, SingleGraphOn16ThreadsAsync) {
+  auto env_map = StoreEnv({"OPENVINO_TF_ASYNC_EXECUTION"});
+  SetEnvVariable("OPENVINO_TF_ASYNC_EXECUTION", "1");
+  string graph_name = "test_axpy.pbtxt";
+  unique_ptr<Session> session;
+  ASSERT_OK(CreateSession(graph_name, session));
+  RunAxpyOnThreads(session, 16, 25);
+  RestoreEnv(env_map);
 }
 
 TEST(TFExec, hello_world) {
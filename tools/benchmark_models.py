@@ -0,0 +1,343 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021-2022 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Benchmarks the SavedModels of a model zoo under TensorFlow and
+openvino_tensorflow.
+
+Every model runs for every device, batch size and concurrency level under
+openvino_tensorflow, and once per batch size and concurrency level under
+native TensorFlow. Each run is a separate process, which reports the
+throughput, the p50 and p99 latencies, the time to the first result, the
+compile time and the executable cache hit ratio of the clusters, and its
+peak RSS. The report is written as JSON along with a comparison table, and
+is compared against the report of a previous release with --baseline.
+
+The models are listed in a JSON file:
+    [{"name": "resnet50", "saved_model": "models/resnet50",
+      "signature_key": "serving_default",
+      "inputs": {"input_1": [-1, 224, 224, 3]}}]
+where -1 is replaced with the batch size. "signature_key" defaults to
+serving_default, and "inputs" to the input signature of the model with its
+unknown first dimension replaced with the batch size.
+
+Example:
+    python3 benchmark_models.py --models models.json --devices CPU,GPU \\
+        --batch_sizes 1,8 --concurrency 1,4 --output report.json \\
+        --baseline last_release.json
+"""
+
+import argparse
+import json
+import os
+import resource
+import subprocess
+import sys
+import threading
+import time
+
+import numpy as np
+
+TF_MODE = "tensorflow"
+OVTF_MODE = "openvino_tensorflow"
+
+# The metrics compared between the runs, and whether a higher value is better
+METRICS = [("throughput", True), ("p50_ms", False), ("p99_ms", False),
+           ("first_inference_ms", False), ("compile_ms", False),
+           ("cache_hit_ratio", True), ("peak_rss_mb", False)]
+
+
+def parse_list(value, convert=str):
+    return [convert(item) for item in value.split(',') if item]
+
+
+def load_models(path):
+    with open(path) as models_file:
+        models = json.load(models_file)
+    for model in models:
+        if "name" not in model or "saved_model" not in model:
+            raise ValueError("Every model needs a name and a saved_model, "
+                             "got {}".format(model))
+    return models
+
+
+def random_input(tf, dtype, shape):
+    if dtype.is_floating:
+        return tf.constant(np.random.rand(*shape).astype(dtype.as_numpy_dtype))
+    if dtype.is_integer:
+        return tf.constant(
+            np.random.randint(0, 2, size=shape).astype(dtype.as_numpy_dtype))
+    if dtype.is_bool:
+        return tf.constant(np.random.rand(*shape) > 0.5)
+    raise ValueError("Unsupported input type {}".format(dtype))
+
+
+def make_inputs(tf, model, input_specs, batch_size):
+    shapes = model.get("inputs", {})
+    inputs = {}
+    for name, spec in input_specs.items():
+        if name in shapes:
+            shape = [batch_size if d == -1 else d for d in shapes[name]]
+        else:
+            shape = spec.shape.as_list()
+            if shape and shape[0] is None:
+                shape[0] = batch_size
+            if any(d is None for d in shape):
+                raise ValueError(
+                    "The input {} of {} has the shape {}, list its shape in "
+                    "\"inputs\"".format(name, model["name"], spec.shape))
+        inputs[name] = random_input(tf, spec.dtype, shape)
+    return inputs
+
+
+def cluster_summary(openvino_tensorflow):
+    compile_us, hits, misses = 0, 0, 0
+    for cluster in openvino_tensorflow.get_cluster_stats()["clusters"]:
+        compile_us += cluster["compile_time_us"]
+        hits += cluster["cache_hits"]
+        misses += cluster["cache_misses"]
+    return {
+        "compile_ms": compile_us / 1000.0,
+        "cache_hit_ratio": float(hits) / (hits + misses)
+                           if hits + misses else None
+    }
+
+
+def run_one(config):
+    """Runs one model configuration in this process, returns its metrics"""
+    import tensorflow as tf
+    import openvino_tensorflow
+    if config["mode"] == OVTF_MODE:
+        openvino_tensorflow.set_backend(config["device"])
+        openvino_tensorflow.enable()
+    else:
+        openvino_tensorflow.disable()
+
+    model = config["model"]
+    loaded = tf.saved_model.load(model["saved_model"])
+    infer = loaded.signatures[model.get("signature_key", "serving_default")]
+    inputs = make_inputs(tf, model, infer.structured_input_signature[1],
+                         config["batch_size"])
+
+    start = time.time()
+    infer(**inputs)
+    first_inference_ms = (time.time() - start) * 1000.0
+    for _ in range(config["warmup"]):
+        infer(**inputs)
+
+    # Every thread runs its share of the iterations back to back
+    latencies = []
+    latencies_lock = threading.Lock()
+    concurrency = config["concurrency"]
+    iterations = max(config["iterations"] // concurrency, 1)
+
+    def worker():
+        own = []
+        for _ in range(iterations):
+            call_start = time.time()
+            infer(**inputs)
+            own.append((time.time() - call_start) * 1000.0)
+        with latencies_lock:
+            latencies.extend(own)
+
+    threads = [threading.Thread(target=worker) for _ in range(concurrency)]
+    start = time.time()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    elapsed = time.time() - start
+
+    result = {
+        "throughput": len(latencies) * config["batch_size"] / elapsed,
+        "p50_ms": float(np.percentile(latencies, 50)),
+        "p99_ms": float(np.percentile(latencies, 99)),
+        "first_inference_ms": first_inference_ms,
+        "compile_ms": None,
+        "cache_hit_ratio": None,
+        # ru_maxrss is in kilobytes on Linux
+        "peak_rss_mb": resource.getrusage(resource.RUSAGE_SELF).ru_maxrss /
+                       1024.0
+    }
+    if config["mode"] == OVTF_MODE:
+        summary = cluster_summary(openvino_tensorflow)
+        result["compile_ms"] = summary["compile_ms"]
+        result["cache_hit_ratio"] = summary["cache_hit_ratio"]
+    return result
+
+
+def run_in_subprocess(config, timeout):
+    # A process per run keeps the peak RSS, the compiled clusters and the
+    # backend of a run from leaking into the next one
+    command = [sys.executable, os.path.abspath(__file__), "--run_one",
+               json.dumps(config)]
+    try:
+        output = subprocess.run(command,
+                                stdout=subprocess.PIPE,
+                                stderr=subprocess.PIPE,
+                                timeout=timeout,
+                                universal_newlines=True)
+    except subprocess.TimeoutExpired:
+        return {"error": "timed out after {} s".format(timeout)}
+    for line in reversed(output.stdout.splitlines()):
+        if line.startswith("RESULT "):
+            return json.loads(line[len("RESULT "):])
+    return {"error": output.stderr.strip().splitlines()[-1]
+            if output.stderr.strip() else "exit code {}".format(
+                output.returncode)}
+
+
+def run_key(run):
+    return (run["model"], run["mode"], run["device"], run["batch_size"],
+            run["concurrency"])
+
+
+def format_value(value):
+    if value is None:
+        return "-"
+    return "{:.2f}".format(value)
+
+
+def format_change(value, previous, higher_is_better):
+    if value is None or not previous:
+        return ""
+    change = (value - previous) / previous * 100.0
+    better = change > 0 if higher_is_better else change < 0
+    return " ({:+.1f}%{})".format(change, "" if better or change == 0 else
+                                 " worse")
+
+
+def comparison_table(runs, baseline_runs):
+    # A row per run, with the speedup of openvino_tensorflow over
+    # TensorFlow and the change of every metric from the baseline
+    tf_runs = {(r["model"], r["batch_size"], r["concurrency"]): r
+               for r in runs if r["mode"] == TF_MODE}
+    baseline = {run_key(r): r for r in baseline_runs}
+    header = ["model", "mode", "device", "batch", "threads"] + \
+             [name for name, _ in METRICS] + ["speedup"]
+    rows = [header]
+    for run in runs:
+        row = [run["model"], run["mode"], run["device"],
+               str(run["batch_size"]), str(run["concurrency"])]
+        if "error" in run:
+            rows.append(row + ["error: " + run["error"]])
+            continue
+        previous = baseline.get(run_key(run), {})
+        for name, higher_is_better in METRICS:
+            row.append(format_value(run.get(name)) + format_change(
+                run.get(name), previous.get(name), higher_is_better))
+        native = tf_runs.get(
+            (run["model"], run["batch_size"], run["concurrency"]), {})
+        speedup = ""
+        if run["mode"] == OVTF_MODE and native.get("throughput"):
+            speedup = "{:.2f}x".format(run["throughput"] /
+                                       native["throughput"])
+        rows.append(row + [speedup])
+    widths = [max(len(row[i]) for row in rows if i < len(row))
+              for i in range(len(header))]
+    return "\n".join("  ".join(cell.ljust(widths[i]) if i < len(widths) else
+                               cell for i, cell in enumerate(row))
+                     for row in rows)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument('--models', help="JSON file listing the models")
+    parser.add_argument(
+        '--devices',
+        default='CPU',
+        help="Comma separated openvino_tensorflow backends")
+    parser.add_argument(
+        '--batch_sizes', default='1', help="Comma separated batch sizes")
+    parser.add_argument(
+        '--concurrency',
+        default='1',
+        help="Comma separated numbers of threads running the model")
+    parser.add_argument(
+        '--iterations',
+        type=int,
+        default=100,
+        help="Timed inferences of every run, shared by its threads")
+    parser.add_argument(
+        '--warmup',
+        type=int,
+        default=5,
+        help="Untimed inferences after the first one")
+    parser.add_argument(
+        '--timeout', type=int, default=3600, help="Seconds allowed per run")
+    parser.add_argument(
+        '--skip_tensorflow',
+        action='store_true',
+        help="Only run the models under openvino_tensorflow")
+    parser.add_argument(
+        '--output', default='benchmark_report.json', help="Report file")
+    parser.add_argument(
+        '--baseline', help="Report of a previous release to compare with")
+    parser.add_argument('--run_one', help=argparse.SUPPRESS)
+    arguments = parser.parse_args()
+
+    if arguments.run_one:
+        result = run_one(json.loads(arguments.run_one))
+        print("RESULT " + json.dumps(result))
+        return
+    if not arguments.models:
+        parser.error("--models is required")
+
+    models = load_models(arguments.models)
+    modes = [(OVTF_MODE, device) for device in parse_list(arguments.devices)]
+    if not arguments.skip_tensorflow:
+        modes.insert(0, (TF_MODE, "TF"))
+    runs = []
+    for model in models:
+        for mode, device in modes:
+            for batch_size in parse_list(arguments.batch_sizes, int):
+                for concurrency in parse_list(arguments.concurrency, int):
+                    config = {
+                        "model": model,
+                        "mode": mode,
+                        "device": device,
+                        "batch_size": batch_size,
+                        "concurrency": concurrency,
+                        "iterations": arguments.iterations,
+                        "warmup": arguments.warmup
+                    }
+                    print("Running {} with {} on {}, batch {}, {} threads".
+                          format(model["name"], mode, device, batch_size,
+                                 concurrency))
+                    run = {
+                        "model": model["name"],
+                        "mode": mode,
+                        "device": device,
+                        "batch_size": batch_size,
+                        "concurrency": concurrency
+                    }
+                    run.update(run_in_subprocess(config, arguments.timeout))
+                    runs.append(run)
+
+    baseline_runs = []
+    if arguments.baseline:
+        with open(arguments.baseline) as baseline_file:
+            baseline_runs = json.load(baseline_file)["runs"]
+    import tensorflow as tf
+    report = {"tensorflow_version": tf.__version__, "runs": runs}
+    try:
+        import openvino_tensorflow
+        report["openvino_tensorflow_version"] = openvino_tensorflow.__version__
+    except ImportError:
+        pass
+    with open(arguments.output, 'w') as output_file:
+        json.dump(report, output_file, indent=2)
+
+    table = comparison_table(runs, baseline_runs)
+    with open(os.path.splitext(arguments.output)[0] + ".txt",
+              'w') as table_file:
+        table_file.write(table + "\n")
+    print(table)
+    print("Report written to " + os.path.abspath(arguments.output))
+
+
+if __name__ == '__main__':
+    main()
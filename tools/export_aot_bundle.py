@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021-2022 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Precompiles the clusters of a SavedModel into an AOT bundle.
+
+The model is run once for every input signature with openvino_tensorflow
+exporting its compiled clusters to the bundle. Serving processes load the
+bundle with OPENVINO_TF_AOT_BUNDLE=<bundle dir>, or with
+openvino_tensorflow.set_aot_bundle(<bundle dir>), and do not compile the
+clusters found in it. The bundle must be loaded with the same version of
+openvino_tensorflow and OpenVINO, and the same backend, as it was exported
+with.
+
+Example:
+    python3 export_aot_bundle.py --saved_model resnet50 --device CPU \\
+        --output_dir bundle --signature "input_1=1,224,224,3" \\
+        --signature "input_1=8,224,224,3"
+"""
+
+import argparse
+import os
+
+import numpy as np
+import tensorflow as tf
+import openvino_tensorflow
+
+
+def parse_signature(signature, input_specs):
+    # "name=dim,dim;name=dim,dim" to {name: shape}
+    shapes = {}
+    for item in signature.split(';'):
+        if not item:
+            continue
+        name, _, dims = item.partition('=')
+        if name not in input_specs:
+            raise ValueError("Unknown input '{}', the inputs are {}".format(
+                name, sorted(input_specs)))
+        shapes[name] = [int(d) for d in dims.split(',') if d]
+    missing = set(input_specs) - set(shapes)
+    if missing:
+        raise ValueError("Signature '{}' has no shape for {}".format(
+            signature, sorted(missing)))
+    return shapes
+
+
+def random_input(spec, shape):
+    dtype = spec.dtype.as_numpy_dtype
+    if spec.dtype.is_floating:
+        return tf.constant(np.random.rand(*shape).astype(dtype))
+    if spec.dtype.is_integer:
+        return tf.constant(np.random.randint(0, 2, size=shape).astype(dtype))
+    if spec.dtype.is_bool:
+        return tf.constant(np.random.rand(*shape) > 0.5)
+    raise ValueError("Unsupported input type {}".format(spec.dtype))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        '--saved_model', required=True, help="SavedModel directory")
+    parser.add_argument(
+        '--device', default='CPU', help="Backend to compile the clusters for")
+    parser.add_argument(
+        '--output_dir', required=True, help="Directory of the bundle")
+    parser.add_argument(
+        '--signature_key',
+        default='serving_default',
+        help="SavedModel signature to run")
+    parser.add_argument(
+        '--signature',
+        action='append',
+        required=True,
+        help="Input shapes to compile for, as \"name=dim,dim;name=dim,dim\".\n"
+        "Repeat for every input signature.")
+    arguments = parser.parse_args()
+
+    if not os.path.isdir(arguments.output_dir):
+        os.makedirs(arguments.output_dir)
+
+    openvino_tensorflow.set_backend(arguments.device)
+    openvino_tensorflow.set_aot_bundle(arguments.output_dir, export=True)
+
+    model = tf.saved_model.load(arguments.saved_model)
+    infer = model.signatures[arguments.signature_key]
+    input_specs = infer.structured_input_signature[1]
+    for signature in arguments.signature:
+        shapes = parse_signature(signature, input_specs)
+        inputs = {
+            name: random_input(spec, shapes[name])
+            for name, spec in input_specs.items()
+        }
+        infer(**inputs)
+        print("Compiled " + signature)
+
+    openvino_tensorflow.set_aot_bundle("")
+    print("Bundle written to " + os.path.abspath(arguments.output_dir))
+
+
+if __name__ == '__main__':
+    main()